@@ -0,0 +1,62 @@
+dnl -*- shell-script -*-
+dnl
+dnl Copyright (c) 2026      Nanook Consulting  All rights reserved.
+dnl $COPYRIGHT$
+dnl
+dnl Additional copyrights may follow
+dnl
+dnl $HEADER$
+dnl
+
+# Look for the fast codecs src/util/prte_compress.c can offer next to PMIx's
+# own deflate: LZ4 and zstd.  Both are optional and used when found; each
+# --with-X=no leaves it out, and an explicit --with-X that cannot be satisfied
+# is an error.  The result is PRTE_HAVE_LZ4 / PRTE_HAVE_ZSTD (0 or 1), and the
+# libraries go into the core library's flags like hwloc's do.
+
+# _PRTE_CHECK_CODEC(name, header, library, function, define)
+# --------------------------------------------------------
+AC_DEFUN([_PRTE_CHECK_CODEC],[
+
+    PRTE_VAR_SCOPE_PUSH([prte_check_$1_happy])
+
+    AC_ARG_WITH([$1],
+                [AS_HELP_STRING([--with-$1(=DIR)],
+                                [Use $1 for control-plane compression (default: if found), optionally adding DIR/include, DIR/lib, and DIR/lib64 to the search path for headers and libraries])])
+    AC_ARG_WITH([$1-libdir],
+                [AS_HELP_STRING([--with-$1-libdir=DIR],
+                                [Search for $1 libraries in DIR])])
+
+    prte_check_$1_happy=no
+    AS_IF([test "$with_$1" != "no"],
+          [OAC_CHECK_PACKAGE([$1],
+                             [prte_$1],
+                             [$2],
+                             [$3],
+                             [$4],
+                             [prte_check_$1_happy=yes],
+                             [prte_check_$1_happy=no])])
+
+    AS_IF([test "$prte_check_$1_happy" = "yes"],
+          [PRTE_FLAGS_APPEND_UNIQ([PRTE_FINAL_CPPFLAGS], [$prte_$1_CPPFLAGS])
+           PRTE_FLAGS_APPEND_UNIQ([PRTE_FINAL_LDFLAGS], [$prte_$1_LDFLAGS])
+           PRTE_FLAGS_APPEND_UNIQ([PRTE_FINAL_LIBS], [$prte_$1_LIBS])
+           prte_have_$1=1],
+          [AS_IF([test -n "$with_$1" && test "$with_$1" != "no"],
+                 [AC_MSG_ERROR([$1 support requested but not found.  Aborting])])
+           prte_have_$1=0])
+
+    AC_DEFINE_UNQUOTED([$5], [$prte_have_$1],
+                       [Whether $1 is available for control-plane compression])
+
+    PRTE_SUMMARY_ADD([External Packages], [$1], [], [$prte_check_$1_happy])
+
+    PRTE_VAR_SCOPE_POP
+])
+
+# PRTE_CHECK_COMPRESS
+# --------------------------------------------------------
+AC_DEFUN([PRTE_CHECK_COMPRESS],[
+    _PRTE_CHECK_CODEC([lz4], [lz4.h], [lz4], [LZ4_compress_default], [PRTE_HAVE_LZ4])
+    _PRTE_CHECK_CODEC([zstd], [zstd.h], [zstd], [ZSTD_compress_usingCDict], [PRTE_HAVE_ZSTD])
+])
@@ -29,6 +29,8 @@ AC_DEFUN([PRTE_CONFIG_FILES],[
         test/Makefile
         test/attachtest/Makefile
         test/topologies/Makefile
+        test/bench/Makefile
+        test/emulate/Makefile
         test/offline/Makefile
         test/unit/Makefile
         test/unit/rmaps/Makefile
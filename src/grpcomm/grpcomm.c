@@ -29,6 +29,7 @@
 #include "src/prted/pmix/pmix_server_internal.h"
 #include "src/mca/errmgr/errmgr.h"
 #include "src/rml/rml.h"
+#include "src/mca/rmaps/rmaps_types.h"
 #include "src/mca/state/state.h"
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
@@ -82,6 +83,15 @@ void prte_grpcomm_register(void)
                                "grpcomm_base_verbose 1.",
                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                &prte_grpcomm_globals.enable_timing);
+
+    prte_grpcomm_globals.fence_subtree = true;
+    pmix_mca_base_var_register("prte", "grpcomm", NULL, "fence_subtree",
+                               "Complete a fence whose participating daemons all "
+                               "lie under one daemon of the routing tree at that "
+                               "daemon, releasing it into that subtree only, "
+                               "rather than at the master with a DVM-wide release",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_grpcomm_globals.fence_subtree);
 }
 
 /**
@@ -110,6 +120,9 @@ int prte_grpcomm_init(void)
     /* setup recv for barrier release */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_FENCE_RELEASE,
                   PRTE_RML_PERSISTENT, prte_grpcomm_fence_release, NULL);
+    /* ...and for one answered below the master, which we may have to relay */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_FENCE_SUBTREE,
+                  PRTE_RML_PERSISTENT, prte_grpcomm_fence_subtree_release, NULL);
     /* ...and for a fence's lateral allgather, which arrives from exchange
      * partners rather than from a routing-tree child */
 
@@ -137,6 +150,7 @@ void prte_grpcomm_finalize(void)
     prte_rml_lateral_set_lost_callback(NULL);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_FENCE);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_FENCE_RELEASE);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_FENCE_SUBTREE);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_GROUP);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_GROUP_RELEASE);
     return;
@@ -224,6 +238,187 @@ bool prte_grpcomm_procs_lost(const pmix_proc_t *procs, size_t nprocs)
     return false;
 }
 
+void prte_grpcomm_dmns_init(prte_grpcomm_dmns_t *r, bool tolerate)
+{
+    PMIX_CONSTRUCT(&r->dmns, pmix_bitmap_t);
+    pmix_bitmap_init(&r->dmns, (0 < prte_process_info.num_daemons) ?
+                               (int) prte_process_info.num_daemons : 1);
+    r->tolerate = tolerate;
+    r->stop = false;
+    r->jobs = NULL;
+    r->njobs = 0;
+}
+
+/* OR src into dest, growing dest to fit */
+static void dmns_merge(pmix_bitmap_t *dest, pmix_bitmap_t *src)
+{
+    int i, top;
+
+    top = pmix_bitmap_size(src) - 1;
+    if (pmix_bitmap_size(dest) <= top) {
+        pmix_bitmap_set_bit(dest, top);
+        pmix_bitmap_clear_bit(dest, top);
+    }
+    for (i = 0; i < src->array_size; i++) {
+        dest->bitmap[i] |= src->bitmap[i];
+    }
+}
+
+/* The daemons hosting the whole job, from the map's cache if that is still
+ * good.  NULL if a node has no daemon: that is an error unless tolerated,
+ * and a set with holes in it is not one to cache either way. */
+static pmix_bitmap_t *job_daemons(prte_grpcomm_dmns_t *r, prte_job_map_t *map, int *rc)
+{
+    pmix_bitmap_t *bm;
+    prte_node_t *node;
+    int32_t nnodes;
+    int i;
+
+    *rc = PRTE_SUCCESS;
+    nnodes = map->nodes->size - map->nodes->number_free;
+    if (NULL != map->daemons && map->daemons_nnodes == nnodes) {
+        return map->daemons;
+    }
+    prte_job_map_daemons_stale(map);
+
+    bm = PMIX_NEW(pmix_bitmap_t);
+    pmix_bitmap_init(bm, pmix_bitmap_size(&r->dmns));
+    for (i = 0; i < map->nodes->size; i++) {
+        if (NULL == (node = pmix_pointer_array_get_item(map->nodes, i))) {
+            continue;
+        }
+        if (NULL == node->daemon) {
+            PMIX_RELEASE(bm);
+            if (!r->tolerate) {
+                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+                *rc = PRTE_ERR_NOT_FOUND;
+            }
+            return NULL;
+        }
+        pmix_bitmap_set_bit(bm, node->daemon->name.rank);
+    }
+    map->daemons = bm;
+    map->daemons_nnodes = nnodes;
+    return bm;
+}
+
+int prte_grpcomm_dmns_add(prte_grpcomm_dmns_t *r, const pmix_nspace_t nspace,
+                          pmix_rank_t first, uint32_t len)
+{
+    prte_job_t *jdata = NULL, **tmp;
+    prte_job_map_t *map;
+    prte_node_t *node;
+    prte_proc_t *proc;
+    pmix_bitmap_t *bm;
+    uint32_t k;
+    size_t n;
+    int i, rc;
+
+    if (r->stop) {
+        return PRTE_SUCCESS;
+    }
+    for (n = 0; n < r->njobs; n++) {
+        if (PMIX_CHECK_NSPACE(r->jobs[n]->nspace, nspace)) {
+            jdata = r->jobs[n];
+            break;
+        }
+    }
+    if (NULL == jdata) {
+        if (NULL == (jdata = prte_get_job_data_object(nspace))) {
+            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+            return PRTE_ERR_NOT_FOUND;
+        }
+        tmp = (prte_job_t **) realloc(r->jobs, (r->njobs + 1) * sizeof(prte_job_t *));
+        if (NULL == tmp) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        r->jobs = tmp;
+        r->jobs[r->njobs++] = jdata;
+    }
+
+    map = (prte_job_map_t *) jdata->map;
+    if (NULL == map || 0 == map->num_nodes) {
+        /* we haven't generated a job map yet - if we are the HNP,
+         * then we should only involve ourselves. Otherwise, we have
+         * no choice but to abort to avoid hangs */
+        if (PRTE_PROC_IS_MASTER) {
+            r->stop = true;
+            return PRTE_SUCCESS;
+        }
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    if (PMIX_RANK_WILDCARD == first) {
+        PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
+                             "%s grpcomm:create_dmns called for all procs in job %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(nspace)));
+        /* all daemons hosting this jobid are participating */
+        bm = job_daemons(r, map, &rc);
+        if (NULL != bm) {
+            dmns_merge(&r->dmns, bm);
+            return PRTE_SUCCESS;
+        }
+        if (PRTE_SUCCESS != rc) {
+            return rc;
+        }
+        /* tolerated holes in the map - take the daemons that are there */
+        for (i = 0; i < map->nodes->size; i++) {
+            node = pmix_pointer_array_get_item(map->nodes, i);
+            if (NULL != node && NULL != node->daemon) {
+                pmix_bitmap_set_bit(&r->dmns, node->daemon->name.rank);
+            }
+        }
+        return PRTE_SUCCESS;
+    }
+
+    /* lookup the daemon for each proc and add it to the set */
+    for (k = 0; k < len; k++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, first + k);
+        if (NULL == proc || NULL == proc->node || NULL == proc->node->daemon) {
+            if (r->tolerate) {
+                continue;
+            }
+            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+            return PRTE_ERR_NOT_FOUND;
+        }
+        pmix_bitmap_set_bit(&r->dmns, proc->node->daemon->name.rank);
+    }
+    return PRTE_SUCCESS;
+}
+
+void prte_grpcomm_dmns_finish(prte_grpcomm_dmns_t *r, pmix_rank_t **dmns, size_t *ndmns)
+{
+    pmix_rank_t *dns = NULL;
+    size_t nds = 0, nset = 0;
+    uint64_t word;
+    int i, b;
+
+    /* a word at a time - most of a large DVM is not in any one collective */
+    for (i = 0; i < r->dmns.array_size; i++) {
+        for (word = r->dmns.bitmap[i]; 0 != word; word &= word - 1) {
+            nset++;
+        }
+    }
+    if (0 < nset) {
+        dns = (pmix_rank_t *) malloc(nset * sizeof(pmix_rank_t));
+        for (i = 0; NULL != dns && i < r->dmns.array_size; i++) {
+            word = r->dmns.bitmap[i];
+            for (b = 0; 0 != word; b++, word >>= 1) {
+                if (word & 1) {
+                    dns[nds++] = (pmix_rank_t) (64 * i + b);
+                }
+            }
+        }
+    }
+    PMIX_DESTRUCT(&r->dmns);
+    free(r->jobs);
+    r->jobs = NULL;
+    r->njobs = 0;
+    *dmns = dns;
+    *ndmns = nds;
+}
+
 /* The master's issued-epoch counter: the number it has handed out, which is
  * not the same as the number it has applied.  See prte_grpcomm_issue_epoch()
  * in grpcomm.h for why the two are separate. */
@@ -123,6 +123,17 @@ PRTE_EXPORT int prte_grpcomm_xcast(prte_rml_tag_t tag, pmix_data_buffer_t *msg);
 PRTE_EXPORT int prte_grpcomm_xcast_nb(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
                                       prte_grpcomm_xcast_complete_fn_t cbfunc, void *cbdata);
 
+/* As xcast_nb, but only for the daemons whose ranks are set in "dests": the
+ * broadcast is forwarded into just the child subtrees holding one of them, and
+ * the completion callback waits for just those subtrees.  Daemons on the way
+ * to a destination receive the message too - a handler must ignore what is
+ * not meant for it, as it already must for a full xcast.  The bitmap is
+ * copied; NULL dests is a full xcast. */
+PRTE_EXPORT int prte_grpcomm_xcast_pruned(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
+                                          const pmix_bitmap_t *dests,
+                                          prte_grpcomm_xcast_complete_fn_t cbfunc,
+                                          void *cbdata);
+
 /* Non-blocking allgather/barrier across the daemons hosting procs.  A barrier
  * supplies no data.  cbfunc is invoked with the gathered buffer on completion.
  * Returns PRTE_SUCCESS once the request has been queued. */
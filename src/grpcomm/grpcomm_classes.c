@@ -55,6 +55,8 @@ PMIX_CLASS_INSTANCE(prte_pmix_grp_caddy_t,
 
 static void scon(prte_grpcomm_fence_signature_t *p)
 {
+    prte_grpcomm_procset_init(&p->procs);
+    p->compact = false;
     p->signature = NULL;
     p->sz = 0;
 }
@@ -65,6 +67,7 @@ static void sdes(prte_grpcomm_fence_signature_t *p)
     if (NULL != p->signature) {
         PMIX_PROC_FREE(p->signature, p->sz);
     }
+    prte_grpcomm_procset_free(&p->procs);
 }
 PMIX_CLASS_INSTANCE(prte_grpcomm_fence_signature_t,
                     pmix_object_t,
@@ -111,7 +114,7 @@ static void ccon(prte_grpcomm_fence_t *p)
 {
     p->sig = NULL;
     p->status = PMIX_SUCCESS;
-    PMIX_DATA_BUFFER_CONSTRUCT(&p->bucket);
+    p->bucket = PMIX_NEW(prte_rml_payload_t);
     p->dmns = NULL;
     p->ndmns = 0;
     p->nexpected = 0;
@@ -121,6 +124,7 @@ static void ccon(prte_grpcomm_fence_t *p)
     p->self_reported = false;
     p->converged = false;
     p->aborting = false;
+    p->subtree_root = false;
     p->my_contribution = NULL;
     p->timeout = 0;
     p->tev_active = false;
@@ -140,7 +144,9 @@ static void cdes(prte_grpcomm_fence_t *p)
     if (NULL != p->my_contribution) {
         PMIX_DATA_BUFFER_RELEASE(p->my_contribution);
     }
-    PMIX_DATA_BUFFER_DESTRUCT(&p->bucket);
+    if (NULL != p->bucket) {
+        PMIX_RELEASE(p->bucket);
+    }
     if (NULL != p->dmns) {
         free(p->dmns);
     }
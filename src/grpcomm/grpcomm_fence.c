@@ -48,13 +48,17 @@ static int fence_sig_pack(pmix_data_buffer_t *bkt,
                           prte_grpcomm_fence_signature_t *sig);
 static int fence_sig_unpack(pmix_data_buffer_t *buffer,
                             prte_grpcomm_fence_signature_t **sig);
+static int fence_sig_compact(prte_grpcomm_fence_signature_t *sig);
+static bool fence_sig_lost(prte_grpcomm_fence_signature_t *sig);
 static void check_complete(prte_grpcomm_fence_t *coll);
 static void relcb(void *cbdata);
 static void abort_fence_op(prte_grpcomm_fence_t *coll, pmix_status_t st);
 static int pack_epoch_frame(pmix_data_buffer_t *framed, pmix_data_buffer_t *body);
+static int release_fence(prte_grpcomm_fence_t *coll, pmix_data_buffer_t *reply);
+static void subtree_forward(prte_grpcomm_fence_t *coll, pmix_data_buffer_t *msg);
 
 
-/* The rollup: gather to the controller, which broadcasts the answer back. */
+/* The rollup: gather to the daemon that answers, which releases it back down. */
 static bool tree_gather_converged(prte_grpcomm_fence_t *coll);
 static int  tree_gather_contribute(prte_grpcomm_fence_t *coll,
                                    pmix_data_buffer_t *payload);
@@ -71,16 +75,25 @@ static void tree_gather_answer(prte_grpcomm_fence_t *coll);
  * count is the opposite statement, "no daemons at all", and falls through to
  * the general case, which reads it as zero.
  *
- * Called again on every recovery, because both terms move: a failure can
+ * This is also where we learn whether the fence is ours to answer: if we are
+ * the lowest common ancestor of the participants, every contribution reaches
+ * us and none need go further, so we answer it instead of the master.  The
+ * daemon job's fences span the DVM and stay with the master.
+ *
+ * Called again on every recovery, because all of it moves: a failure can
  * take our children and can take participants. */
 static void set_nexpected(prte_grpcomm_fence_t *coll)
 {
     size_t n;
 
+    coll->subtree_root = false;
     if (NULL == coll->dmns && 0 < coll->ndmns) {
         coll->nexpected = prte_rml_base.n_children + 1;
         return;
     }
+    if (prte_grpcomm_globals.fence_subtree && !PRTE_PROC_IS_MASTER) {
+        coll->subtree_root = prte_rml_is_subtree_root(coll->dmns, coll->ndmns);
+    }
 
     coll->nexpected = prte_rml_get_num_contributors(coll->dmns, coll->ndmns);
 
@@ -148,14 +161,111 @@ static int pack_epoch_frame(pmix_data_buffer_t *framed, pmix_data_buffer_t *body
     return PRTE_SUCCESS;
 }
 
+/* Whether this daemon answers the fence: the master answers every fence that
+ * no daemon below it does. */
+static bool answers_here(prte_grpcomm_fence_t *coll)
+{
+    return PRTE_PROC_IS_MASTER || coll->subtree_root;
+}
+
+/* Send the answer to a fence this daemon answers.  The master broadcasts it
+ * - into just the branches holding a participant, when it knows which
+ * daemons those are; a subtree root passes it down those branches itself and
+ * delivers it to itself the way the broadcast would.  Either way the buffer
+ * is copied, not consumed. */
+static int release_fence(prte_grpcomm_fence_t *coll, pmix_data_buffer_t *reply)
+{
+    pmix_data_buffer_t *mine;
+    pmix_bitmap_t dests;
+    pmix_status_t prc;
+    size_t n;
+    int rc;
+
+    if (!coll->subtree_root) {
+        if (NULL == coll->dmns) {
+            return prte_grpcomm_release_bcast(PRTE_RML_TAG_FENCE_RELEASE, reply);
+        }
+        PMIX_CONSTRUCT(&dests, pmix_bitmap_t);
+        pmix_bitmap_init(&dests, prte_process_info.num_daemons);
+        for (n = 0; n < coll->ndmns; n++) {
+            pmix_bitmap_set_bit(&dests, coll->dmns[n]);
+        }
+        rc = prte_grpcomm_xcast_pruned(PRTE_RML_TAG_FENCE_RELEASE, reply, &dests, NULL, NULL);
+        PMIX_DESTRUCT(&dests);
+        return rc;
+    }
+
+    subtree_forward(coll, reply);
+    /* through the RML rather than a direct call: the release retires the
+     * tracker, and our caller is still holding it */
+    PMIX_DATA_BUFFER_CREATE(mine);
+    prc = PMIx_Data_copy_payload(mine, reply);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        PMIX_DATA_BUFFER_RELEASE(mine);
+        return prte_pmix_convert_status(prc);
+    }
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_NAME->rank, mine, PRTE_RML_TAG_FENCE_RELEASE);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(mine);
+    }
+    return rc;
+}
+
+/* Pass a subtree release on to each of our children whose subtree holds a
+ * living participant - the rest have no tracker for it and nothing to do. */
+static void subtree_forward(prte_grpcomm_fence_t *coll, pmix_data_buffer_t *msg)
+{
+    pmix_rank_t *children = (pmix_rank_t *) prte_rml_base.children.array;
+    pmix_data_buffer_t *fwd;
+    pmix_bitmap_t sent;
+    pmix_status_t prc;
+    size_t n;
+    int rc, slot;
+
+    PMIX_CONSTRUCT(&sent, pmix_bitmap_t);
+    pmix_bitmap_init(&sent, prte_rml_base.children.size);
+    for (n = 0; n < coll->ndmns; n++) {
+        if (coll->dmns[n] == PRTE_PROC_MY_NAME->rank ||
+            pmix_bitmap_is_set_bit(&prte_rml_base.failed_dmns, coll->dmns[n])) {
+            continue;
+        }
+        slot = prte_rml_get_subtree_index(coll->dmns[n]);
+        if (0 > slot || PMIX_RANK_INVALID == children[slot] ||
+            pmix_bitmap_is_set_bit(&sent, slot)) {
+            continue;
+        }
+        pmix_bitmap_set_bit(&sent, slot);
+
+        PMIX_DATA_BUFFER_CREATE(fwd);
+        prc = PMIx_Data_copy_payload(fwd, msg);
+        if (PMIX_SUCCESS != prc) {
+            PMIX_ERROR_LOG(prc);
+            PMIX_DATA_BUFFER_RELEASE(fwd);
+            continue;
+        }
+        PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_globals.output,
+                             "%s grpcomm fence subtree release to %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_VPID_PRINT(children[slot])));
+        PRTE_RML_SEND(rc, children[slot], fwd, PRTE_RML_TAG_FENCE_SUBTREE);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(fwd);
+        }
+    }
+    PMIX_DESTRUCT(&sent);
+}
+
 /* End an in-flight fence that cannot complete correctly, without taking
- * anything else down with it. It broadcasts a release carrying the signature
- * and a status but no gathered data, which the normal release path hands to
- * each daemon's local participants.
+ * anything else down with it. It releases the fence with the signature and a
+ * status but no gathered data, which the normal release path hands to each
+ * daemon's local participants.
  *
- * The controller calls this - it is the daemon every rollup reaches, so it is
- * the one that can tell a fence that will never converge from one that merely
- * has not yet. */
+ * The daemon answering the fence calls this - the one every rollup reaches,
+ * so the one that can tell a fence that will never converge from one that
+ * merely has not yet. */
 static void abort_fence_op(prte_grpcomm_fence_t *coll, pmix_status_t st)
 {
     pmix_data_buffer_t *reply;
@@ -174,14 +284,13 @@ static void abort_fence_op(prte_grpcomm_fence_t *coll, pmix_status_t st)
         PMIX_DATA_BUFFER_RELEASE(reply);
         return;
     }
-    /* xcast copies the payload, so the buffer is still ours to free */
-    (void) prte_grpcomm_release_bcast(PRTE_RML_TAG_FENCE_RELEASE, reply);
+    (void) release_fence(coll, reply);
     PMIX_DATA_BUFFER_RELEASE(reply);
     /* the tracker goes when that release comes back around */
     coll->aborting = true;
 }
 
-/* The controller's guard timer for a fence a participant put a deadline on.
+/* The answering daemon's guard timer for a fence a participant put a deadline on.
  * Firing it completes every participant with PMIX_ERR_TIMEOUT rather than
  * leaving them blocked in PMIx_Fence forever.
  *
@@ -224,12 +333,12 @@ void prte_grpcomm_fence_restart(void)
          * release lands. Re-running the rollup here would answer it a
          * second time - a second release broadcast, a second context id
          * consumed, and a second registration of the same group on every
-         * daemon. Note this is a test only the controller can apply:
+         * daemon. Note this is a test only the answering daemon can apply:
          * "converged" on any other daemon means it rolled its aggregate up
          * to its parent, and re-sending that aggregate is precisely what
          * recovery is for, since the failure may have been what swallowed
          * it. */
-        if (PRTE_PROC_IS_MASTER && coll->converged) {
+        if (answers_here(coll) && coll->converged) {
             continue;
         }
         /* A restart: the rollup's shape is the routing tree's, and the tree
@@ -238,12 +347,12 @@ void prte_grpcomm_fence_restart(void)
         coll->self_reported = false;
         coll->nreported = 0;
         coll->converged = false;
-        PMIX_DATA_BUFFER_DESTRUCT(&coll->bucket);
-        PMIX_DATA_BUFFER_CONSTRUCT(&coll->bucket);
+        PMIX_RELEASE(coll->bucket);
+        coll->bucket = PMIX_NEW(prte_rml_payload_t);
 
-        /* recompute what the repaired tree owes us - dmns stays the full
-         * pre-fault set, and get_num_contributors() already skips the daemons
-         * now known to have failed */
+        /* recompute what the repaired tree owes us, and whether we still
+         * answer - dmns stays the full pre-fault set, and the rml already
+         * skips the daemons now known to have failed */
         set_nexpected(coll);
 
         PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
@@ -301,10 +410,10 @@ void prte_grpcomm_fence_fault_handler(const prte_rml_recovery_status_t* status)
          * reshapes the tree as a death does, but it rides a forward-first
          * broadcast, so it cannot give the parent-before-child ordering a
          * restart depends on - end the fences instead. */
-        if (PRTE_PROC_IS_MASTER && 0 == status->failed_ranks.size) {
+        if (0 == status->failed_ranks.size) {
             PMIX_LIST_FOREACH_SAFE(coll, nxt, &prte_grpcomm_globals.fence_ops,
                                    prte_grpcomm_fence_t) {
-                if (!coll->aborting && !coll->converged) {
+                if (answers_here(coll) && !coll->aborting && !coll->converged) {
                     abort_fence_op(coll, PMIX_ERR_LOST_CONNECTION);
                 }
             }
@@ -312,16 +421,19 @@ void prte_grpcomm_fence_fault_handler(const prte_rml_recovery_status_t* status)
         return;
     }
 
-        if (!PRTE_PROC_IS_MASTER) {
-        return;
-    }
+    /* each fence is ended by the daemon that answers it - the master, or
+     * the root of the subtree it completes in, as decided under the tree
+     * this failure has just reshaped the moment before */
     PMIX_LIST_FOREACH_SAFE(coll, nxt, &prte_grpcomm_globals.fence_ops,
                            prte_grpcomm_fence_t) {
+        if (!answers_here(coll)) {
+            continue;
+        }
         /* already answered, or already being torn down */
         if (coll->aborting || coll->converged) {
             continue;
         }
-        if (!prte_grpcomm_procs_lost(coll->sig->signature, coll->sig->sz)) {
+        if (!fence_sig_lost(coll->sig)) {
             /* only the paths between us changed - the restart driven by the
              * component's epoch advance re-converges this one */
             continue;
@@ -353,13 +465,16 @@ static void fence(int sd, short args, void *cbdata)
                          "%s grpcomm: fence",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
 
-    /* compute the signature of this collective */
+    /* compute the signature of this collective - straight to the compact
+     * form, as nothing here needs the participants as an array */
     PMIX_CONSTRUCT(&sig, prte_grpcomm_fence_signature_t);
-    sig.sz = cd->nprocs;
-    if (0 < sig.sz) {
-        PMIX_PROC_CREATE(sig.signature, sig.sz);
-        memcpy(sig.signature, cd->procs, sig.sz * sizeof(pmix_proc_t));
+    rc = prte_grpcomm_procset_load(&sig.procs, cd->procs, cd->nprocs, true);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        st = prte_pmix_convert_rc(rc);
+        goto done;
     }
+    sig.compact = true;
 
     /* retrieve an existing tracker, create it if not
      * already found. The fence module is responsible
@@ -626,11 +741,11 @@ void prte_grpcomm_fence_recv(int status, pmix_proc_t *sender,
         }
     }
 
-    /* Arm the deadline, if a participant asked for one.  Only the controller
-     * does: it is the one daemon every contribution reaches, so it is the only
-     * one that can tell a fence that will never converge from one that simply
-     * has not yet. */
-    if (!coll->tev_active && 0 < coll->timeout && PRTE_PROC_IS_MASTER) {
+    /* Arm the deadline, if a participant asked for one.  Only the daemon
+     * answering the fence does: it is the one every contribution reaches, so
+     * it is the only one that can tell a fence that will never converge from
+     * one that simply has not yet. */
+    if (!coll->tev_active && 0 < coll->timeout && answers_here(coll)) {
         prte_event_evtimer_set(prte_event_base, &coll->tev, fence_timeout, coll);
         tv.tv_sec = coll->timeout;
         tv.tv_usec = 0;
@@ -666,8 +781,8 @@ void prte_grpcomm_fence_recv(int status, pmix_proc_t *sender,
 }
 
 /* Test whether this fence's rollup is complete and, if so, answer it: the
- * controller broadcasts the release, everyone else rolls their bucket up to
- * their parent. Factored out of fence_recv() because a contribution arriving
+ * answering daemon releases it, everyone else rolls their bucket up to their
+ * parent. Factored out of fence_recv() because a contribution arriving
  * is no longer the only thing that can complete a fence - a fault can lower
  * what we are waiting for, and the tracker has to be re-tested with no
  * message in hand.
@@ -703,7 +818,9 @@ static bool tree_gather_converged(prte_grpcomm_fence_t *coll)
 }
 
 /* The rollup's bucket is an append: order is whatever the merges happened to
- * reach us in, which is why the result is not reproducible across daemons. */
+ * reach us in, which is why the result is not reproducible across daemons.
+ * What is appended is the message itself - the rest of it, after the header
+ * we have read - taken from the RML rather than copied out of it. */
 static int tree_gather_contribute(prte_grpcomm_fence_t *coll,
                                   pmix_data_buffer_t *payload)
 {
@@ -712,33 +829,44 @@ static int tree_gather_contribute(prte_grpcomm_fence_t *coll,
     if (NULL == payload) {
         return PRTE_SUCCESS;
     }
-    rc = PMIx_Data_copy_payload(&coll->bucket, payload);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
+    rc = prte_rml_payload_take(coll->bucket, payload);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
     }
-    return PRTE_SUCCESS;
+    return rc;
 }
 
-/* MOVEMENT: roll the contributions up the routing tree to the controller,
- * which broadcasts the gathered result back down.
+/* MOVEMENT: roll the contributions up the routing tree to the daemon that
+ * answers - the lowest common ancestor of the participants, or the master -
+ * which sends the gathered result back down.
  *
  * Right for a barrier, where there is nothing to gather and the cost is the
  * depth of the tree in each direction. Its weakness is the release: the
- * controller alone holds the answer, so it must fan the whole payload back out
- * over the tree, and for a full modex that fanout is essentially the entire
- * cost of the collective. */
+ * answering daemon alone holds the answer, so it must fan the whole payload
+ * back out, and for a full modex that fanout is essentially the entire cost
+ * of the collective. A subtree root at least fans it out only as far as its
+ * participants; the master's broadcast reaches every daemon in the DVM. */
 static void tree_gather_answer(prte_grpcomm_fence_t *coll)
 {
-    pmix_data_buffer_t *reply, *framed;
+    pmix_data_buffer_t *reply;
+    prte_rml_payload_t *rollup;
     pmix_info_t *info = NULL;
     size_t ninfo = 0;
     int rc;
 
-    if (PRTE_PROC_IS_MASTER) {
+    if (answers_here(coll)) {
         PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
-                             "%s grpcomm fence HNP reports complete",
-                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+                             "%s grpcomm fence %s reports complete",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             coll->subtree_root ? "subtree root" : "HNP"));
+        /* the rollup skips failed daemons, so it can complete without a
+         * participant that went with one - which is not a success */
+        if (PMIX_SUCCESS == coll->status &&
+            fence_sig_lost(coll->sig)) {
+            coll->status = PMIX_ERR_LOST_CONNECTION;
+            PMIX_RELEASE(coll->bucket);
+            coll->bucket = PMIX_NEW(prte_rml_payload_t);
+        }
         PMIX_DATA_BUFFER_CREATE(reply);
         rc = fence_sig_pack(reply, coll->sig);
         if (PMIX_SUCCESS != rc) {
@@ -752,14 +880,15 @@ static void tree_gather_answer(prte_grpcomm_fence_t *coll)
             PMIX_DATA_BUFFER_RELEASE(reply);
             return;
         }
-        rc = PMIx_Data_copy_payload(reply, &coll->bucket);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
+        /* the one copy the rollup makes: the release is a broadcast of a
+         * single buffer */
+        rc = prte_rml_payload_flatten(coll->bucket, reply);
+        if (PRTE_SUCCESS != rc) {
             PMIX_DATA_BUFFER_RELEASE(reply);
             return;
         }
-        /* xcast copies the payload, so the buffer is still ours to free */
-        (void) prte_grpcomm_release_bcast(PRTE_RML_TAG_FENCE_RELEASE, reply);
+        /* the release copies the payload, so the buffer is still ours */
+        (void) release_fence(coll, reply);
         PMIX_DATA_BUFFER_RELEASE(reply);
         return;
     }
@@ -769,7 +898,17 @@ static void tree_gather_answer(prte_grpcomm_fence_t *coll)
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          PRTE_NAME_PRINT(PRTE_PROC_MY_PARENT)));
 
+    /* The message is a header of our own - the epoch stamp that lets a
+     * parent which has already recovered past it tell it is stale, the
+     * signature and the directives - ahead of the bucket's contributions,
+     * which go up in the buffers they arrived in. */
     PMIX_DATA_BUFFER_CREATE(reply);
+    rc = PMIx_Data_pack(NULL, reply, &prte_grpcomm_globals.recovery_epoch, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+        return;
+    }
     rc = fence_sig_pack(reply, coll->sig);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
@@ -812,27 +951,17 @@ static void tree_gather_answer(prte_grpcomm_fence_t *coll)
         }
     }
 
-    rc = PMIx_Data_copy_payload(reply, &coll->bucket);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
-        return;
-    }
-
-    /* stamp it with the epoch it belongs to, so a parent that has already
-     * recovered past it can tell it is stale */
-    PMIX_DATA_BUFFER_CREATE(framed);
-    rc = pack_epoch_frame(framed, reply);
-    PMIX_DATA_BUFFER_RELEASE(reply);
-    if (PRTE_SUCCESS != rc) {
-        PMIX_DATA_BUFFER_RELEASE(framed);
-        return;
-    }
-    PRTE_RML_SEND(rc, PRTE_PROC_MY_PARENT->rank, framed, PRTE_RML_TAG_FENCE);
+    /* the bucket goes with the send and the tracker starts a fresh one -
+     * a restart regathers from scratch anyway */
+    rollup = coll->bucket;
+    coll->bucket = PMIX_NEW(prte_rml_payload_t);
+    rollup->dbuf = reply;
+    PRTE_RML_SEND_PAYLOAD_CB(rc, PRTE_PROC_MY_PARENT->rank, rollup, PRTE_RML_TAG_FENCE,
+                             NULL, NULL);
     if (PRTE_SUCCESS != rc) {
         PRTE_ERROR_LOG(rc);
-        PMIX_DATA_BUFFER_RELEASE(framed);
     }
+    PMIX_RELEASE(rollup);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -923,21 +1052,63 @@ void prte_grpcomm_fence_release(int status, pmix_proc_t *sender,
     PMIX_RELEASE(sig);
 }
 
+/* A fence answered below the master arrives here instead of through the
+ * xcast: pass it on down the branches of our subtree that hold participants,
+ * then deliver it here as the xcast would have.  Every daemon on the way
+ * down relayed the rollup on the way up, so it has the tracker that says
+ * which branches those are. */
+void prte_grpcomm_fence_subtree_release(int status, pmix_proc_t *sender,
+                                        pmix_data_buffer_t *buffer,
+                                        prte_rml_tag_t tag, void *cbdata)
+{
+    pmix_data_buffer_t peek;
+    prte_grpcomm_fence_signature_t *sig = NULL;
+    prte_grpcomm_fence_t *coll;
+    pmix_status_t prc;
+    int rc;
+
+    /* read the signature off a copy - what we forward is the whole message */
+    PMIX_DATA_BUFFER_CONSTRUCT(&peek);
+    prc = PMIx_Data_copy_payload(&peek, buffer);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        PMIX_DATA_BUFFER_DESTRUCT(&peek);
+        return;
+    }
+    rc = fence_sig_unpack(&peek, &sig);
+    PMIX_DATA_BUFFER_DESTRUCT(&peek);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        return;
+    }
+    coll = get_tracker(sig, false);
+    PMIX_RELEASE(sig);
+    if (NULL != coll) {
+        subtree_forward(coll, buffer);
+    }
+
+    prte_grpcomm_fence_release(status, sender, buffer, tag, cbdata);
+}
+
 static prte_grpcomm_fence_t* get_tracker(prte_grpcomm_fence_signature_t *sig, bool create)
 {
     prte_grpcomm_fence_t *coll;
     int rc;
 
-    /* search the existing tracker list to see if this already exists */
+    if (PRTE_SUCCESS != (rc = fence_sig_compact(sig))) {
+        PRTE_ERROR_LOG(rc);
+        return NULL;
+    }
+
+    /* search the existing tracker list to see if this already exists - the
+     * hash turns away all but a true match without touching the runs */
     PMIX_LIST_FOREACH(coll, &prte_grpcomm_globals.fence_ops, prte_grpcomm_fence_t) {
-        if (sig->sz == coll->sig->sz) {
-            // must match proc signature
-            if (0 == memcmp(sig->signature, coll->sig->signature, sig->sz * sizeof(pmix_proc_t))) {
-                PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
-                                     "%s grpcomm:base:returning existing collective",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-                return coll;
-            }
+        if (PRTE_SUCCESS == fence_sig_compact(coll->sig) &&
+            prte_grpcomm_procset_equal(&sig->procs, &coll->sig->procs)) {
+            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
+                                 "%s grpcomm:base:returning existing collective",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+            return coll;
         }
     }
     /* if we get here, then this is a new collective - so create
@@ -950,13 +1121,15 @@ static prte_grpcomm_fence_t* get_tracker(prte_grpcomm_fence_signature_t *sig, bo
         return NULL;
     }
     coll = PMIX_NEW(prte_grpcomm_fence_t);
-    // we have to know the participating procs
+    // we have to know the participating procs - the compact form is enough,
+    // the array is only built if a failure makes us look for lost ones
     coll->sig = PMIX_NEW(prte_grpcomm_fence_signature_t);
-    coll->sig->sz = sig->sz;
-    if (0 < coll->sig->sz) {
-        PMIX_PROC_CREATE(coll->sig->signature, coll->sig->sz);
-        memcpy(coll->sig->signature, sig->signature, coll->sig->sz * sizeof(pmix_proc_t));
+    if (PRTE_SUCCESS != (rc = prte_grpcomm_procset_copy(&coll->sig->procs, &sig->procs))) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_RELEASE(coll);
+        return NULL;
     }
+    coll->sig->compact = true;
     pmix_list_append(&prte_grpcomm_globals.fence_ops, &coll->super);
 
     /* now get the daemons involved */
@@ -989,18 +1162,10 @@ prte_grpcomm_fence_t *prte_grpcomm_fence_get_tracker(prte_grpcomm_fence_signatur
 static int create_dmns(prte_grpcomm_fence_signature_t *sig,
                        pmix_rank_t **dmns, size_t *ndmns)
 {
-    size_t n;
-    prte_job_t *jdata;
-    prte_proc_t *proc;
-    prte_node_t *node;
-    prte_job_map_t *map;
-    int i;
-    pmix_list_t ds;
-    prte_namelist_t *nm;
-    pmix_rank_t vpid;
-    bool found;
-    size_t nds = 0;
-    pmix_rank_t *dns = NULL;
+    const prte_grpcomm_procset_t *set = &sig->procs;
+    const uint32_t *run;
+    uint32_t r, k;
+    prte_grpcomm_dmns_t res;
     int rc = PRTE_SUCCESS;
     /* Once the DVM has known failures, a participant we cannot resolve is
      * most likely one whose node is being torn down. Refusing to resolve the
@@ -1011,198 +1176,121 @@ static int create_dmns(prte_grpcomm_fence_signature_t *sig,
     bool tolerate = !pmix_bitmap_is_clear(&prte_rml_base.failed_dmns);
 
     PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
-                         "%s grpcomm:fence:create_dmns called with %s signature size %" PRIsize_t "",
-                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                         (NULL == sig->signature) ? "NULL" : "NON-NULL", sig->sz));
+                         "%s grpcomm:fence:create_dmns called with signature size %" PRIsize_t
+                         " in %u runs",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), set->nprocs, set->nruns));
 
     /* A signature has to name somebody. This is not reachable from a local
      * client - the PMIx server hands us the participants it aggregated - but
      * the signature also arrives off the wire, where a truncated message
-     * unpacks to an empty one. The test below would then read signature[0]
-     * of an array that is NULL; and an entry with no nspace is worse than
+     * unpacks to an empty one. The test below would then read the first run
+     * of a set that has none; and an nspace that is empty is worse than
      * that, because PMIX_CHECK_NSPACE answers "yes" for an empty nspace
      * against anything, so it would be taken for a fence over the daemon job
      * and sized to expect the whole DVM. Refuse it: the caller drops the
      * message, which is the right answer for one we cannot read. */
-    if (0 == sig->sz || NULL == sig->signature ||
-        PMIX_NSPACE_INVALID(sig->signature[0].nspace)) {
+    if (0 == set->nprocs || 0 == set->nruns) {
         *dmns = NULL;
         *ndmns = 0;
         return PRTE_ERR_BAD_PARAM;
     }
+    for (k = 0; k < set->nns; k++) {
+        if (PMIX_NSPACE_INVALID(set->nspaces[k])) {
+            *dmns = NULL;
+            *ndmns = 0;
+            return PRTE_ERR_BAD_PARAM;
+        }
+    }
 
-    /* if the target jobid is our own,
+    /* if the daemon job is taking part,
      * then all daemons are participating */
-    if (PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, sig->signature[0].nspace)) {
-        *ndmns = prte_process_info.num_daemons;
-        *dmns = NULL;
-        return PRTE_SUCCESS;
+    for (k = 0; k < set->nns; k++) {
+        if (PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, set->nspaces[k])) {
+            *ndmns = prte_process_info.num_daemons;
+            *dmns = NULL;
+            return PRTE_SUCCESS;
+        }
     }
 
-    PMIX_CONSTRUCT(&ds, pmix_list_t);
-    for (n = 0; n < sig->sz; n++) {
-        if (NULL == (jdata = prte_get_job_data_object(sig->signature[n].nspace))) {
-            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-            rc = PRTE_ERR_NOT_FOUND;
-            break;
-        }
-        map = (prte_job_map_t*)jdata->map;
-        if (NULL == map || 0 == map->num_nodes) {
-            /* we haven't generated a job map yet - if we are the HNP,
-             * then we should only involve ourselves. Otherwise, we have
-             * no choice but to abort to avoid hangs */
-            if (PRTE_PROC_IS_MASTER) {
-                rc = PRTE_SUCCESS;
-                break;
-            }
-            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-            rc = PRTE_ERR_NOT_FOUND;
+    /* one bit per daemon however many participants it hosts, and one
+     * job lookup per nspace however many runs name it */
+    prte_grpcomm_dmns_init(&res, tolerate);
+    for (r = 0; r < set->nruns && !res.stop; r++) {
+        run = &set->runs[3 * r];
+        rc = prte_grpcomm_dmns_add(&res, set->nspaces[run[0]], run[1], run[2]);
+        if (PRTE_SUCCESS != rc) {
             break;
         }
-        if (PMIX_RANK_WILDCARD == sig->signature[n].rank) {
-            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
-                                 "%s grpcomm:fence::create_dmns called for all procs in job %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_JOBID_PRINT(sig->signature[0].nspace)));
-            /* all daemons hosting this jobid are participating */
-            for (i = 0; i < map->nodes->size; i++) {
-                if (NULL == (node = pmix_pointer_array_get_item(map->nodes, i))) {
-                    continue;
-                }
-                if (NULL == node->daemon) {
-                    if (tolerate) {
-                        continue;
-                    }
-                    PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                    rc = PRTE_ERR_NOT_FOUND;
-                    goto done;
-                }
-                found = false;
-                PMIX_LIST_FOREACH(nm, &ds, prte_namelist_t)
-                {
-                    if (nm->name.rank == node->daemon->name.rank) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_globals.output,
-                                         "%s grpcomm:fence::create_dmns adding daemon %s to list",
-                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                         PRTE_NAME_PRINT(&node->daemon->name)));
-                    nm = PMIX_NEW(prte_namelist_t);
-                    PMIX_LOAD_PROCID(&nm->name, PRTE_PROC_MY_NAME->nspace, node->daemon->name.rank);
-                    pmix_list_append(&ds, &nm->super);
-                }
-            }
-        } else {
-            /* lookup the daemon for this proc and add it to the list */
-            PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_globals.output,
-                                 "%s sign: GETTING PROC OBJECT FOR %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_NAME_PRINT(&sig->signature[n])));
-            proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs,
-                                                               sig->signature[n].rank);
-            if (NULL == proc) {
-                if (tolerate) {
-                    continue;
-                }
-                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                rc = PRTE_ERR_NOT_FOUND;
-                goto done;
-            }
-            if (NULL == proc->node || NULL == proc->node->daemon) {
-                if (tolerate) {
-                    continue;
-                }
-                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                rc = PRTE_ERR_NOT_FOUND;
-                goto done;
-            }
-            vpid = proc->node->daemon->name.rank;
-            found = false;
-            PMIX_LIST_FOREACH(nm, &ds, prte_namelist_t)
-            {
-                if (nm->name.rank == vpid) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-                nm = PMIX_NEW(prte_namelist_t);
-                PMIX_LOAD_PROCID(&nm->name, PRTE_PROC_MY_NAME->nspace, vpid);
-                pmix_list_append(&ds, &nm->super);
-            }
-        }
     }
+    prte_grpcomm_dmns_finish(&res, dmns, ndmns);
+    return rc;
+}
 
-done:
-    if (0 < pmix_list_get_size(&ds)) {
-        dns = (pmix_rank_t *) malloc(pmix_list_get_size(&ds) * sizeof(pmix_rank_t));
-        nds = 0;
-        while (NULL != (nm = (prte_namelist_t *) pmix_list_remove_first(&ds))) {
-            PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_globals.output,
-                                 "%s grpcomm:fence::create_dmns adding daemon %s to array",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&nm->name)));
-            dns[nds++] = nm->name.rank;
-            PMIX_RELEASE(nm);
-        }
+/* Bring the compact form up to date with the array, for a signature
+ * that was built as one */
+static int fence_sig_compact(prte_grpcomm_fence_signature_t *sig)
+{
+    int rc;
+
+    if (sig->compact) {
+        return PRTE_SUCCESS;
+    }
+    rc = prte_grpcomm_procset_load(&sig->procs, sig->signature, sig->sz, true);
+    if (PRTE_SUCCESS == rc) {
+        sig->compact = true;
     }
-    PMIX_LIST_DESTRUCT(&ds);
-    *dmns = dns;
-    *ndmns = nds;
     return rc;
 }
 
-static int fence_sig_pack(pmix_data_buffer_t *bkt,
-                          prte_grpcomm_fence_signature_t *sig)
+/* Has a participant gone with a failed daemon?  prte_grpcomm_procs_lost
+ * wants the participants as an array, so expand them the first time this
+ * is asked after a failure - never, on a DVM that has not had one. */
+static bool fence_sig_lost(prte_grpcomm_fence_signature_t *sig)
 {
-    pmix_status_t rc;
+    int rc;
 
-    // always send the participating procs
-    rc = PMIx_Data_pack(NULL, bkt, &sig->sz, 1, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
+    if (pmix_bitmap_is_clear(&prte_rml_base.failed_dmns)) {
+        return false;
     }
-    if (0 < sig->sz) {
-        rc = PMIx_Data_pack(NULL, bkt, sig->signature, sig->sz, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return prte_pmix_convert_status(rc);
+    if (NULL == sig->signature && 0 < sig->procs.nprocs) {
+        rc = prte_grpcomm_procset_expand(&sig->procs, &sig->signature, &sig->sz);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
         }
     }
+    return prte_grpcomm_procs_lost(sig->signature, sig->sz);
+}
 
-    return PRTE_SUCCESS;
+static int fence_sig_pack(pmix_data_buffer_t *bkt,
+                          prte_grpcomm_fence_signature_t *sig)
+{
+    int rc;
+
+    // always send the participating procs - as runs, so a fence over a
+    // whole job costs the same to send at any scale
+    if (PRTE_SUCCESS != (rc = fence_sig_compact(sig))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    return prte_grpcomm_procset_pack(bkt, &sig->procs);
 }
 
 static int fence_sig_unpack(pmix_data_buffer_t *buffer,
                             prte_grpcomm_fence_signature_t **sig)
 {
-    pmix_status_t rc;
-    int32_t cnt;
+    int rc;
     prte_grpcomm_fence_signature_t *s;
 
     s = PMIX_NEW(prte_grpcomm_fence_signature_t);
 
-    // unpack the participating procs
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &s->sz, &cnt, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    // unpack the participating procs - they stay compact, which is all
+    // get_tracker needs to match them
+    rc = prte_grpcomm_procset_unpack(buffer, &s->procs);
+    if (PRTE_SUCCESS != rc) {
         PMIX_RELEASE(s);
-        return prte_pmix_convert_status(rc);
-    }
-    if (0 < s->sz) {
-        PMIX_PROC_CREATE(s->signature, s->sz);
-        cnt = s->sz;
-        rc = PMIx_Data_unpack(NULL, buffer, s->signature, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(s);
-            return prte_pmix_convert_status(rc);
-        }
+        return rc;
     }
+    s->compact = true;
 
     *sig = s;
     return PRTE_SUCCESS;
@@ -2430,18 +2430,8 @@ static void collect_departed(prte_grpcomm_group_t *coll)
 static int create_dmns(prte_grpcomm_group_signature_t *sig,
                        pmix_rank_t **dmns, size_t *ndmns)
 {
-    size_t n;
-    prte_job_t *jdata;
-    prte_proc_t *proc;
-    prte_node_t *node;
-    prte_job_map_t *map;
-    int i;
-    pmix_list_t ds;
-    prte_namelist_t *nm;
-    pmix_rank_t vpid;
-    bool found;
-    size_t nds = 0;
-    pmix_rank_t *dns = NULL;
+    size_t n, m;
+    prte_grpcomm_dmns_t res;
     int rc = PRTE_SUCCESS;
     /* Once the DVM has known failures, a member we cannot resolve is most
      * likely one whose node is being torn down, and refusing to resolve the
@@ -2456,118 +2446,25 @@ static int create_dmns(prte_grpcomm_group_signature_t *sig,
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          (NULL == sig->members) ? "NULL" : "NON-NULL", sig->nmembers));
 
-    PMIX_CONSTRUCT(&ds, pmix_list_t);
-    for (n = 0; n < sig->nmembers; n++) {
-        if (NULL == (jdata = prte_get_job_data_object(sig->members[n].nspace))) {
-            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-            rc = PRTE_ERR_NOT_FOUND;
-            break;
-        }
-        map = (prte_job_map_t*)jdata->map;
-        if (NULL == map || 0 == map->num_nodes) {
-            /* we haven't generated a job map yet - if we are the HNP,
-             * then we should only involve ourselves. Otherwise, we have
-             * no choice but to abort to avoid hangs */
-            if (PRTE_PROC_IS_MASTER) {
-                rc = PRTE_SUCCESS;
-                break;
-            }
-            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-            rc = PRTE_ERR_NOT_FOUND;
-            break;
-        }
-        if (PMIX_RANK_WILDCARD == sig->members[n].rank) {
-            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
-                                 "%s grpcomm:group::create_dmns called for all procs in job %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_JOBID_PRINT(sig->members[0].nspace)));
-            /* all daemons hosting this jobid are participating */
-            for (i = 0; i < map->nodes->size; i++) {
-                if (NULL == (node = pmix_pointer_array_get_item(map->nodes, i))) {
-                    continue;
-                }
-                if (NULL == node->daemon) {
-                    if (tolerate) {
-                        continue;
-                    }
-                    PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                    rc = PRTE_ERR_NOT_FOUND;
-                    goto done;
-                }
-                found = false;
-                PMIX_LIST_FOREACH(nm, &ds, prte_namelist_t)
-                {
-                    if (nm->name.rank == node->daemon->name.rank) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_globals.output,
-                                         "%s grpcomm:group::create_dmns adding daemon %s to list",
-                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                         PRTE_NAME_PRINT(&node->daemon->name)));
-                    nm = PMIX_NEW(prte_namelist_t);
-                    PMIX_LOAD_PROCID(&nm->name, PRTE_PROC_MY_NAME->nspace, node->daemon->name.rank);
-                    pmix_list_append(&ds, &nm->super);
-                }
-            }
-        } else {
-            /* lookup the daemon for this proc and add it to the list */
-            PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_globals.output,
-                                 "%s sign: GETTING PROC OBJECT FOR %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                 PRTE_NAME_PRINT(&sig->members[n])));
-            proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs,
-                                                               sig->members[n].rank);
-            if (NULL == proc) {
-                if (tolerate) {
-                    continue;
-                }
-                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                rc = PRTE_ERR_NOT_FOUND;
-                goto done;
-            }
-            if (NULL == proc->node || NULL == proc->node->daemon) {
-                if (tolerate) {
-                    continue;
-                }
-                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                rc = PRTE_ERR_NOT_FOUND;
-                goto done;
-            }
-            vpid = proc->node->daemon->name.rank;
-            found = false;
-            PMIX_LIST_FOREACH(nm, &ds, prte_namelist_t)
-            {
-                if (nm->name.rank == vpid) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-                nm = PMIX_NEW(prte_namelist_t);
-                PMIX_LOAD_PROCID(&nm->name, PRTE_PROC_MY_NAME->nspace, vpid);
-                pmix_list_append(&ds, &nm->super);
+    /* members listed as consecutive ranks of one nspace - the usual case -
+     * go to the resolver as one run */
+    prte_grpcomm_dmns_init(&res, tolerate);
+    for (n = 0; n < sig->nmembers && !res.stop; n = m) {
+        m = n + 1;
+        if (PMIX_RANK_VALID > sig->members[n].rank) {
+            while (m < sig->nmembers && sig->members[m].rank == sig->members[m - 1].rank + 1 &&
+                   PMIX_RANK_VALID > sig->members[m].rank &&
+                   PMIX_CHECK_NSPACE(sig->members[m].nspace, sig->members[n].nspace)) {
+                m++;
             }
         }
-    }
-
-done:
-    if (0 < pmix_list_get_size(&ds)) {
-        dns = (pmix_rank_t *) malloc(pmix_list_get_size(&ds) * sizeof(pmix_rank_t));
-        nds = 0;
-        while (NULL != (nm = (prte_namelist_t *) pmix_list_remove_first(&ds))) {
-            PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_globals.output,
-                                 "%s grpcomm:group::create_dmns adding daemon %s to array",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&nm->name)));
-            dns[nds++] = nm->name.rank;
-            PMIX_RELEASE(nm);
+        rc = prte_grpcomm_dmns_add(&res, sig->members[n].nspace, sig->members[n].rank,
+                                   (uint32_t) (m - n));
+        if (PRTE_SUCCESS != rc) {
+            break;
         }
     }
-    PMIX_LIST_DESTRUCT(&ds);
-    *dmns = dns;
-    *ndmns = nds;
+    prte_grpcomm_dmns_finish(&res, dmns, ndmns);
     return rc;
 }
 
@@ -2575,6 +2472,7 @@ static int pack_signature(pmix_data_buffer_t *bkt,
                           prte_grpcomm_group_signature_t *sig)
 {
     pmix_status_t rc;
+    int ret;
 
     // pack the operation
     rc = PMIx_Data_pack(NULL, bkt, &sig->op, 1, PMIX_INT);
@@ -2611,18 +2509,13 @@ static int pack_signature(pmix_data_buffer_t *bkt,
         }
     }
 
-    // pack members, if given
-    rc = PMIx_Data_pack(NULL, bkt, &sig->nmembers, 1, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
-    }
-    if (0 < sig->nmembers) {
-        rc = PMIx_Data_pack(NULL, bkt, sig->members, sig->nmembers, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return prte_pmix_convert_status(rc);
-        }
+    /* pack members, if given - the proc arrays go as rank runs, which keeps
+     * a construct over whole jobs small on the wire.  Their order is kept:
+     * final_order is an order, and the rest are matched by groupID */
+    ret = prte_grpcomm_pack_procs(bkt, sig->members, sig->nmembers);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        return ret;
     }
 
     // pack bootstrap number
@@ -2640,17 +2533,10 @@ static int pack_signature(pmix_data_buffer_t *bkt,
     }
 
     // pack added membership, if given
-    rc = PMIx_Data_pack(NULL, bkt, &sig->naddmembers, 1, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
-    }
-    if (0 < sig->naddmembers) {
-        rc = PMIx_Data_pack(NULL, bkt, sig->addmembers, sig->naddmembers, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return prte_pmix_convert_status(rc);
-        }
+    ret = prte_grpcomm_pack_procs(bkt, sig->addmembers, sig->naddmembers);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        return ret;
     }
 
     /* pack the fault-tolerant-collective flag. Deliberately not guarded by
@@ -2663,17 +2549,10 @@ static int pack_signature(pmix_data_buffer_t *bkt,
     }
 
     // pack final order, if given
-    rc = PMIx_Data_pack(NULL, bkt, &sig->nfinal, 1, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
-    }
-    if (0 < sig->nfinal) {
-        rc = PMIx_Data_pack(NULL, bkt, sig->final_order, sig->nfinal, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return prte_pmix_convert_status(rc);
-        }
+    ret = prte_grpcomm_pack_procs(bkt, sig->final_order, sig->nfinal);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        return ret;
     }
 
     return PRTE_SUCCESS;
@@ -2684,6 +2563,7 @@ static int unpack_signature(pmix_data_buffer_t *buffer,
 {
     pmix_status_t rc;
     int32_t cnt;
+    int ret;
     prte_grpcomm_group_signature_t *s;
 
     s = PMIX_NEW(prte_grpcomm_group_signature_t);
@@ -2734,22 +2614,11 @@ static int unpack_signature(pmix_data_buffer_t *buffer,
     }
 
     // unpack the membership
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &s->nmembers, &cnt, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    ret = prte_grpcomm_unpack_procs(buffer, &s->members, &s->nmembers);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
         PMIX_RELEASE(s);
-        return prte_pmix_convert_status(rc);
-    }
-    if (0 < s->nmembers) {
-        PMIX_PROC_CREATE(s->members, s->nmembers);
-        cnt = s->nmembers;
-        rc = PMIx_Data_unpack(NULL, buffer, s->members, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(s);
-            return prte_pmix_convert_status(rc);
-        }
+        return ret;
     }
 
     // unpack the bootstrap count
@@ -2771,22 +2640,11 @@ static int unpack_signature(pmix_data_buffer_t *buffer,
     }
 
     // unpack the added members
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &s->naddmembers, &cnt, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    ret = prte_grpcomm_unpack_procs(buffer, &s->addmembers, &s->naddmembers);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
         PMIX_RELEASE(s);
-        return prte_pmix_convert_status(rc);
-    }
-    if (0 < s->naddmembers) {
-        PMIX_PROC_CREATE(s->addmembers, s->naddmembers);
-        cnt = s->naddmembers;
-        rc = PMIx_Data_unpack(NULL, buffer, s->addmembers, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(s);
-            return prte_pmix_convert_status(rc);
-        }
+        return ret;
     }
 
     // unpack the fault-tolerant-collective flag - see pack_signature()
@@ -2799,22 +2657,11 @@ static int unpack_signature(pmix_data_buffer_t *buffer,
     }
 
     // unpack the final order
-    cnt = 1;
-    rc = PMIx_Data_unpack(NULL, buffer, &s->nfinal, &cnt, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    ret = prte_grpcomm_unpack_procs(buffer, &s->final_order, &s->nfinal);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
         PMIX_RELEASE(s);
-        return prte_pmix_convert_status(rc);
-    }
-    if (0 < s->nfinal) {
-        PMIX_PROC_CREATE(s->final_order, s->nfinal);
-        cnt = s->nfinal;
-        rc = PMIx_Data_unpack(NULL, buffer, s->final_order, &cnt, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(s);
-            return prte_pmix_convert_status(rc);
-        }
+        return ret;
     }
 
     *sig = s;
@@ -21,6 +21,7 @@
 #include "src/class/pmix_bitmap.h"
 
 #include "src/grpcomm/grpcomm.h"
+#include "src/runtime/prte_globals.h"
 
 BEGIN_C_DECLS
 
@@ -40,6 +41,9 @@ typedef struct {
     size_t op_id_completed_at_promotion;
     // ID of the last known initiated operation
     size_t op_id_inited;
+    // on the master: the pruned ops stamped since the last full one, which
+    // every later op carries (see grpcomm_xcast.c)
+    pmix_list_t pruned;
 } prte_grpcomm_xcast_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_grpcomm_xcast_t);
 
@@ -83,6 +87,11 @@ typedef struct {
     // and the clock reads it needs sit directly in the broadcast path.
     // Set with the grpcomm_enable_timing MCA parameter.
     bool enable_timing;
+    // Let a fence whose participating daemons all lie under one daemon of the
+    // routing tree complete at that daemon, releasing into its own subtree,
+    // instead of rolling up to the master and being broadcast to the whole
+    // DVM. On by default; set with the grpcomm_fence_subtree MCA parameter.
+    bool fence_subtree;
 } prte_grpcomm_globals_t;
 
 #define PRTE_GRPCOMM_GROUP_MEMO_MAX 64
@@ -106,6 +115,35 @@ PRTE_EXPORT bool prte_grpcomm_proc_departed(const pmix_proc_t *proc);
  * correctly. */
 PRTE_EXPORT bool prte_grpcomm_procs_lost(const pmix_proc_t *procs, size_t nprocs);
 
+/* Resolving a collective's participants to the daemons that host them,
+ * shared by fence and group.  Daemons collect in a bitmap over daemon
+ * ranks, so a daemon hosting many participants costs one bit test, and
+ * each distinct nspace is looked up once however many runs name it. */
+typedef struct {
+    pmix_bitmap_t dmns;
+    // skip participants we cannot place instead of failing - see create_dmns
+    bool tolerate;
+    // set when the rest of the participants should not be resolved: the
+    // master, asked about a job it has not mapped yet, involves only itself
+    bool stop;
+    // the nspaces looked up so far
+    prte_job_t **jobs;
+    size_t njobs;
+} prte_grpcomm_dmns_t;
+
+PRTE_EXPORT void prte_grpcomm_dmns_init(prte_grpcomm_dmns_t *r, bool tolerate);
+
+/* Add the daemons hosting ranks first .. first+len-1 of nspace, or every
+ * daemon hosting the job when first is PMIX_RANK_WILDCARD.  The whole-job
+ * answer is cached on the job's map. */
+PRTE_EXPORT int prte_grpcomm_dmns_add(prte_grpcomm_dmns_t *r, const pmix_nspace_t nspace,
+                                      pmix_rank_t first, uint32_t len);
+
+/* Hand back the daemons as a malloc'd rank array (NULL when there are
+ * none) and release the resolver */
+PRTE_EXPORT void prte_grpcomm_dmns_finish(prte_grpcomm_dmns_t *r, pmix_rank_t **dmns,
+                                          size_t *ndmns);
+
 /* Advance the recovery epoch and restart every in-flight collective at it.
  * Idempotent: an epoch at or below the current one does nothing. */
 PRTE_EXPORT void prte_grpcomm_advance_epoch(uint32_t to);
@@ -128,6 +166,22 @@ typedef int (*prte_grpcomm_release_bcast_fn_t)(prte_rml_tag_t tag, pmix_data_buf
 PRTE_EXPORT extern prte_grpcomm_release_bcast_fn_t prte_grpcomm_release_bcast;
 
 
+/* A set of procs held as runs of consecutive ranks rather than one
+ * pmix_proc_t per proc - a fence across a 100k-rank job is a single run.
+ * Each run is three uint32s: an index into nspaces, the first rank and the
+ * run length.  Wildcards and the other reserved ranks are runs of one.
+ * "hash" covers everything else, so two sets can be told apart without
+ * looking at their runs.  Plain C, not a class - it lives inside the
+ * signatures.  See grpcomm_procset.c. */
+typedef struct {
+    pmix_nspace_t *nspaces;
+    uint32_t nns;
+    uint32_t *runs;
+    uint32_t nruns;
+    size_t nprocs;
+    uint64_t hash;
+} prte_grpcomm_procset_t;
+
 /* Define collective signatures so we don't need to
  * track global collective id's. We provide a unique
  * signature struct for each collective type so that
@@ -135,6 +189,13 @@ PRTE_EXPORT extern prte_grpcomm_release_bcast_fn_t prte_grpcomm_release_bcast;
  * interfering with other collectives */
 typedef struct {
     pmix_object_t super;
+    // the participants in canonical form - sorted, duplicates dropped, and
+    // a wildcard standing for its whole nspace.  This is what gets matched
+    // and sent.  Valid only when "compact" is set.
+    prte_grpcomm_procset_t procs;
+    bool compact;
+    // the participants as an array, as the caller listed them or expanded
+    // from "procs" - NULL until a consumer needs it
     pmix_proc_t *signature;
     size_t sz;
 } prte_grpcomm_fence_signature_t;
@@ -171,8 +232,10 @@ typedef struct {
     /* collective's signature */
     prte_grpcomm_fence_signature_t *sig;
     pmix_status_t status;
-    /* collection bucket */
-    pmix_data_buffer_t bucket;
+    // collection bucket: the contributions as they arrived, each kept in the
+    // buffer it came in and chained rather than copied together, so that a
+    // rollup is sent on up as it stands (see tree_gather_answer)
+    prte_rml_payload_t *bucket;
     /* participating daemons */
     pmix_rank_t *dmns;
     /** number of participating daemons */
@@ -188,6 +251,12 @@ typedef struct {
     bool self_reported;
     bool converged;
     bool aborting;
+    // This daemon answers the fence: it is the lowest common ancestor of the
+    // participating daemons and is not the master. Nothing above it hears of
+    // the fence at all, so the timeout and the decision to end a fence that
+    // lost a participant are this daemon's, as they are the master's for any
+    // other fence. Recomputed on every restart with the tree it depends on.
+    bool subtree_root;
     // this daemon's own contribution, saved so a fault can replay it
     pmix_data_buffer_t *my_contribution;
     /* controls values */
@@ -307,6 +376,18 @@ int prte_grpcomm_xcast_nb(prte_rml_tag_t tag,
                                  prte_grpcomm_xcast_complete_fn_t cbfunc,
                                  void *cbdata);
 
+/* Mark in "wanted" (sized to the children array) the child slots an xcast
+ * for "dests" has to be forwarded into - every living child when dests is
+ * NULL - and return how many.  Exposed for the unit tests. */
+PRTE_EXPORT extern
+size_t prte_grpcomm_xcast_reach(const pmix_bitmap_t *dests, pmix_bitmap_t *wanted);
+
+/* Would an xcast for "dests" have been forwarded to this daemon - is one of
+ * them this daemon, or in its subtree?  What decides whether an op id this
+ * daemon never saw was pruned away from it.  Exposed for the unit tests. */
+PRTE_EXPORT extern
+bool prte_grpcomm_xcast_reaches_here(const pmix_bitmap_t *dests);
+
 PRTE_EXPORT extern
 void prte_grpcomm_xcast_recv(int status, pmix_proc_t *sender,
                                     pmix_data_buffer_t *buffer,
@@ -330,6 +411,11 @@ void prte_grpcomm_fence_release(int status, pmix_proc_t *sender,
                                 	   pmix_data_buffer_t *buffer,
                                 	   prte_rml_tag_t tag, void *cbdata);
 
+PRTE_EXPORT extern
+void prte_grpcomm_fence_subtree_release(int status, pmix_proc_t *sender,
+                                        pmix_data_buffer_t *buffer,
+                                        prte_rml_tag_t tag, void *cbdata);
+
 PRTE_EXPORT extern
 void prte_grpcomm_fence_fault_handler(const prte_rml_recovery_status_t* status);
 
@@ -341,6 +427,36 @@ PRTE_EXPORT
 prte_grpcomm_fence_t *prte_grpcomm_fence_get_tracker(prte_grpcomm_fence_signature_t *sig,
                                                             bool create);
 
+/* procset functions */
+PRTE_EXPORT void prte_grpcomm_procset_init(prte_grpcomm_procset_t *set);
+PRTE_EXPORT void prte_grpcomm_procset_free(prte_grpcomm_procset_t *set);
+
+/* Encode procs into set.  With "canonical" the procs are sorted and
+ * deduplicated first, so any listing of the same participants yields the
+ * same set; without it their order is kept and only adjacent ranks merge. */
+PRTE_EXPORT int prte_grpcomm_procset_load(prte_grpcomm_procset_t *set,
+                                          const pmix_proc_t *procs, size_t nprocs,
+                                          bool canonical);
+
+/* Back to an array, which is PMIX_PROC_FREE'd by the caller */
+PRTE_EXPORT int prte_grpcomm_procset_expand(const prte_grpcomm_procset_t *set,
+                                            pmix_proc_t **procs, size_t *nprocs);
+
+PRTE_EXPORT bool prte_grpcomm_procset_equal(const prte_grpcomm_procset_t *a,
+                                            const prte_grpcomm_procset_t *b);
+PRTE_EXPORT int prte_grpcomm_procset_copy(prte_grpcomm_procset_t *dst,
+                                          const prte_grpcomm_procset_t *src);
+PRTE_EXPORT int prte_grpcomm_procset_pack(pmix_data_buffer_t *buf,
+                                          const prte_grpcomm_procset_t *set);
+PRTE_EXPORT int prte_grpcomm_procset_unpack(pmix_data_buffer_t *buf,
+                                            prte_grpcomm_procset_t *set);
+
+/* Pack/unpack a proc array in the procset encoding with its order intact */
+PRTE_EXPORT int prte_grpcomm_pack_procs(pmix_data_buffer_t *buf,
+                                        const pmix_proc_t *procs, size_t nprocs);
+PRTE_EXPORT int prte_grpcomm_unpack_procs(pmix_data_buffer_t *buf,
+                                          pmix_proc_t **procs, size_t *nprocs);
+
 /* group functions */
 PRTE_EXPORT extern
 int prte_grpcomm_group(pmix_group_operation_t op, char *grpid,
@@ -0,0 +1,399 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/pmix/pmix-internal.h"
+
+#include "grpcomm_internal.h"
+
+/* FNV-1a, 64 bit */
+#define PROCSET_FNV_OFFSET 0xcbf29ce484222325ULL
+#define PROCSET_FNV_PRIME  0x100000001b3ULL
+
+static uint64_t fnv(uint64_t h, const void *data, size_t len)
+{
+    const unsigned char *p = (const unsigned char *) data;
+    size_t n;
+
+    for (n = 0; n < len; n++) {
+        h ^= p[n];
+        h *= PROCSET_FNV_PRIME;
+    }
+    return h;
+}
+
+static void set_hash(prte_grpcomm_procset_t *set)
+{
+    uint64_t h = PROCSET_FNV_OFFSET;
+    uint32_t n;
+
+    h = fnv(h, &set->nprocs, sizeof(set->nprocs));
+    for (n = 0; n < set->nns; n++) {
+        h = fnv(h, set->nspaces[n], strnlen(set->nspaces[n], PMIX_MAX_NSLEN));
+        /* keep "ab"+"c" apart from "a"+"bc" */
+        h = fnv(h, "", 1);
+    }
+    if (0 < set->nruns) {
+        h = fnv(h, set->runs, 3 * set->nruns * sizeof(uint32_t));
+    }
+    set->hash = h;
+}
+
+/* A rank that names one process, as opposed to a wildcard or one of the
+ * other reserved values - only these fall into runs */
+static inline bool plain_rank(pmix_rank_t rank)
+{
+    return rank < PMIX_RANK_VALID;
+}
+
+static int proc_order(const void *a, const void *b)
+{
+    const pmix_proc_t *pa = (const pmix_proc_t *) a;
+    const pmix_proc_t *pb = (const pmix_proc_t *) b;
+    int c;
+
+    c = strncmp(pa->nspace, pb->nspace, PMIX_MAX_NSLEN);
+    if (0 != c) {
+        return c;
+    }
+    return (pa->rank < pb->rank) ? -1 : (pa->rank > pb->rank);
+}
+
+void prte_grpcomm_procset_init(prte_grpcomm_procset_t *set)
+{
+    memset(set, 0, sizeof(*set));
+    set->hash = PROCSET_FNV_OFFSET;
+}
+
+void prte_grpcomm_procset_free(prte_grpcomm_procset_t *set)
+{
+    free(set->nspaces);
+    free(set->runs);
+    prte_grpcomm_procset_init(set);
+}
+
+/* Room for n more runs and one more namespace, whichever is needed */
+static int grow(prte_grpcomm_procset_t *set, uint32_t *cap_ns, uint32_t *cap_runs)
+{
+    void *tmp;
+
+    if (set->nns == *cap_ns) {
+        *cap_ns = (0 == *cap_ns) ? 4 : 2 * *cap_ns;
+        tmp = realloc(set->nspaces, *cap_ns * sizeof(pmix_nspace_t));
+        if (NULL == tmp) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        set->nspaces = (pmix_nspace_t *) tmp;
+    }
+    if (set->nruns == *cap_runs) {
+        *cap_runs = (0 == *cap_runs) ? 16 : 2 * *cap_runs;
+        tmp = realloc(set->runs, 3 * (size_t) *cap_runs * sizeof(uint32_t));
+        if (NULL == tmp) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        set->runs = (uint32_t *) tmp;
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_grpcomm_procset_load(prte_grpcomm_procset_t *set, const pmix_proc_t *procs,
+                              size_t nprocs, bool canonical)
+{
+    pmix_proc_t *sorted = NULL;
+    const pmix_proc_t *p;
+    uint32_t cap_ns = 0, cap_runs = 0, ns = 0, *run = NULL, k;
+    size_t n, m;
+    bool wild;
+    int rc;
+
+    prte_grpcomm_procset_free(set);
+    if (0 == nprocs) {
+        set_hash(set);
+        return PRTE_SUCCESS;
+    }
+
+    if (canonical) {
+        sorted = (pmix_proc_t *) malloc(nprocs * sizeof(pmix_proc_t));
+        if (NULL == sorted) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        memcpy(sorted, procs, nprocs * sizeof(pmix_proc_t));
+        qsort(sorted, nprocs, sizeof(pmix_proc_t), proc_order);
+        procs = sorted;
+    }
+
+    for (n = 0; n < nprocs; n++) {
+        p = &procs[n];
+        /* which namespace - the one before it, almost always */
+        if (0 == set->nns || !PMIX_CHECK_NSPACE(set->nspaces[ns], p->nspace)) {
+            for (k = 0; k < set->nns; k++) {
+                if (PMIX_CHECK_NSPACE(set->nspaces[k], p->nspace)) {
+                    break;
+                }
+            }
+            if (k == set->nns) {
+                if (PRTE_SUCCESS != (rc = grow(set, &cap_ns, &cap_runs))) {
+                    goto error;
+                }
+                PMIX_LOAD_NSPACE(set->nspaces[k], p->nspace);
+                set->nns++;
+            }
+            ns = k;
+            run = NULL;
+
+            if (canonical) {
+                /* a wildcard is the whole namespace - whatever else it
+                 * was listed with adds nothing */
+                wild = false;
+                for (m = n; m < nprocs && PMIX_CHECK_NSPACE(procs[m].nspace, p->nspace); m++) {
+                    if (PMIX_RANK_WILDCARD == procs[m].rank) {
+                        wild = true;
+                    }
+                }
+                if (wild) {
+                    if (PRTE_SUCCESS != (rc = grow(set, &cap_ns, &cap_runs))) {
+                        goto error;
+                    }
+                    run = &set->runs[3 * set->nruns++];
+                    run[0] = ns;
+                    run[1] = PMIX_RANK_WILDCARD;
+                    run[2] = 1;
+                    set->nprocs++;
+                    run = NULL;
+                    n = m - 1;
+                    continue;
+                }
+            }
+        }
+
+        if (NULL != run && plain_rank(p->rank) && plain_rank(run[1])) {
+            if (p->rank == run[1] + run[2]) {
+                run[2]++;
+                set->nprocs++;
+                continue;
+            }
+            if (canonical && p->rank < run[1] + run[2]) {
+                /* listed twice */
+                continue;
+            }
+        } else if (canonical && NULL != run && p->rank == run[1]) {
+            continue;
+        }
+        if (PRTE_SUCCESS != (rc = grow(set, &cap_ns, &cap_runs))) {
+            goto error;
+        }
+        run = &set->runs[3 * set->nruns++];
+        run[0] = ns;
+        run[1] = p->rank;
+        run[2] = 1;
+        set->nprocs++;
+    }
+
+    free(sorted);
+    set_hash(set);
+    return PRTE_SUCCESS;
+
+error:
+    free(sorted);
+    prte_grpcomm_procset_free(set);
+    return rc;
+}
+
+int prte_grpcomm_procset_expand(const prte_grpcomm_procset_t *set, pmix_proc_t **procs,
+                                size_t *nprocs)
+{
+    pmix_proc_t *p = NULL;
+    size_t n = 0;
+    uint32_t r, k;
+    const uint32_t *run;
+
+    if (0 < set->nprocs) {
+        PMIX_PROC_CREATE(p, set->nprocs);
+        if (NULL == p) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        for (r = 0; r < set->nruns; r++) {
+            run = &set->runs[3 * r];
+            for (k = 0; k < run[2]; k++) {
+                PMIX_LOAD_PROCID(&p[n], set->nspaces[run[0]], run[1] + k);
+                n++;
+            }
+        }
+    }
+    *procs = p;
+    *nprocs = n;
+    return PRTE_SUCCESS;
+}
+
+bool prte_grpcomm_procset_equal(const prte_grpcomm_procset_t *a,
+                                const prte_grpcomm_procset_t *b)
+{
+    uint32_t n;
+
+    if (a->hash != b->hash || a->nprocs != b->nprocs || a->nns != b->nns
+        || a->nruns != b->nruns) {
+        return false;
+    }
+    for (n = 0; n < a->nns; n++) {
+        if (!PMIX_CHECK_NSPACE(a->nspaces[n], b->nspaces[n])) {
+            return false;
+        }
+    }
+    return 0 == a->nruns
+           || 0 == memcmp(a->runs, b->runs, 3 * a->nruns * sizeof(uint32_t));
+}
+
+int prte_grpcomm_procset_copy(prte_grpcomm_procset_t *dst, const prte_grpcomm_procset_t *src)
+{
+    prte_grpcomm_procset_free(dst);
+    if (0 < src->nns) {
+        dst->nspaces = (pmix_nspace_t *) malloc(src->nns * sizeof(pmix_nspace_t));
+        if (NULL == dst->nspaces) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        memcpy(dst->nspaces, src->nspaces, src->nns * sizeof(pmix_nspace_t));
+    }
+    if (0 < src->nruns) {
+        dst->runs = (uint32_t *) malloc(3 * (size_t) src->nruns * sizeof(uint32_t));
+        if (NULL == dst->runs) {
+            prte_grpcomm_procset_free(dst);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        memcpy(dst->runs, src->runs, 3 * (size_t) src->nruns * sizeof(uint32_t));
+    }
+    dst->nns = src->nns;
+    dst->nruns = src->nruns;
+    dst->nprocs = src->nprocs;
+    dst->hash = src->hash;
+    return PRTE_SUCCESS;
+}
+
+int prte_grpcomm_procset_pack(pmix_data_buffer_t *buf, const prte_grpcomm_procset_t *set)
+{
+    pmix_status_t rc;
+    size_t nprocs = set->nprocs;
+    uint32_t nns = set->nns, nruns = set->nruns;
+
+    rc = PMIx_Data_pack(NULL, buf, &nprocs, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &nns, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc && 0 < nns) {
+        rc = PMIx_Data_pack(NULL, buf, set->nspaces, nns, PMIX_PROC_NSPACE);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &nruns, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc && 0 < nruns) {
+        rc = PMIx_Data_pack(NULL, buf, set->runs, 3 * nruns, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_grpcomm_procset_unpack(pmix_data_buffer_t *buf, prte_grpcomm_procset_t *set)
+{
+    pmix_status_t rc;
+    int32_t cnt;
+    uint32_t r;
+    size_t total = 0;
+    const uint32_t *run;
+
+    prte_grpcomm_procset_free(set);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &set->nprocs, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &set->nns, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc && 0 < set->nns) {
+        set->nspaces = (pmix_nspace_t *) calloc(set->nns, sizeof(pmix_nspace_t));
+        if (NULL == set->nspaces) {
+            prte_grpcomm_procset_free(set);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        cnt = (int32_t) set->nns;
+        rc = PMIx_Data_unpack(NULL, buf, set->nspaces, &cnt, PMIX_PROC_NSPACE);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &set->nruns, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc && 0 < set->nruns) {
+        set->runs = (uint32_t *) malloc(3 * (size_t) set->nruns * sizeof(uint32_t));
+        if (NULL == set->runs) {
+            prte_grpcomm_procset_free(set);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        cnt = (int32_t) (3 * set->nruns);
+        rc = PMIx_Data_unpack(NULL, buf, set->runs, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        prte_grpcomm_procset_free(set);
+        return prte_pmix_convert_status(rc);
+    }
+
+    /* it came off the wire - check every run before anyone expands it */
+    for (r = 0; r < set->nruns; r++) {
+        run = &set->runs[3 * r];
+        if (run[0] >= set->nns || 0 == run[2]
+            || (plain_rank(run[1]) ? (uint64_t) run[1] + run[2] > PMIX_RANK_VALID
+                                   : 1 != run[2])) {
+            break;
+        }
+        total += run[2];
+    }
+    if (r < set->nruns || total != set->nprocs) {
+        PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+        prte_grpcomm_procset_free(set);
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    set_hash(set);
+    return PRTE_SUCCESS;
+}
+
+int prte_grpcomm_pack_procs(pmix_data_buffer_t *buf, const pmix_proc_t *procs, size_t nprocs)
+{
+    prte_grpcomm_procset_t set;
+    int rc;
+
+    prte_grpcomm_procset_init(&set);
+    rc = prte_grpcomm_procset_load(&set, procs, nprocs, false);
+    if (PRTE_SUCCESS == rc) {
+        rc = prte_grpcomm_procset_pack(buf, &set);
+    }
+    prte_grpcomm_procset_free(&set);
+    return rc;
+}
+
+int prte_grpcomm_unpack_procs(pmix_data_buffer_t *buf, pmix_proc_t **procs, size_t *nprocs)
+{
+    prte_grpcomm_procset_t set;
+    int rc;
+
+    prte_grpcomm_procset_init(&set);
+    rc = prte_grpcomm_procset_unpack(buf, &set);
+    if (PRTE_SUCCESS == rc) {
+        rc = prte_grpcomm_procset_expand(&set, procs, nprocs);
+    }
+    prte_grpcomm_procset_free(&set);
+    return rc;
+}
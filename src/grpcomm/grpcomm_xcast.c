@@ -34,6 +34,7 @@
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
 #include "src/util/proc_info.h"
+#include "src/util/prte_compress.h"
 #include "src/util/pmix_show_help.h"
 #include "src/util/prte_show_help.h"
 
@@ -67,6 +68,32 @@ typedef struct {
 } pending_completion_t;
 PMIX_CLASS_INSTANCE(pending_completion_t, pmix_list_item_t, NULL, NULL);
 
+/* A pruned op, as the ops stamped after it carry it.
+ *
+ * Ops finish in op-id order, so a daemon that finds an id missing has to be
+ * told whether the op was pruned away from its subtree - never coming - or is
+ * one it was owed and has not had.  The master keeps every pruned op it has
+ * stamped since the last full one (XCAST.pruned) and each op it stamps takes
+ * a copy: the daemon that finds a gap checks each missing id against these,
+ * and skips it only if none of that op's destinations is in its subtree.  A
+ * full op reaches everyone, so the ops behind it are settled before it is,
+ * and nothing stamped after it needs to carry them.  To keep the list short
+ * the master sends an op full once XCAST_MAX_PRUNED are waiting. */
+typedef struct {
+    pmix_list_item_t super;
+    size_t op_id;
+    pmix_bitmap_t *dests;
+} pruned_op_t;
+static void pruned_op_des(pruned_op_t *p)
+{
+    if (NULL != p->dests) {
+        PMIX_RELEASE(p->dests);
+    }
+}
+PMIX_CLASS_INSTANCE(pruned_op_t, pmix_list_item_t, NULL, pruned_op_des);
+
+#define XCAST_MAX_PRUNED 64
+
 /* internal signature used to uniquely track a particular xcast */
 typedef struct {
     size_t op_id;    // HNP's assigned collective ID, globally unique
@@ -92,13 +119,22 @@ typedef struct {
     pmix_rank_t ack_id_down;
     // hold onto the user's message until completion is confirmed
     pmix_byte_object_t msg;
-    bool msg_compressed;
+    // how msg was compressed, if it was (prte_compress.h)
+    prte_compress_codec_t msg_codec;
     // tag for the underlying user message
     prte_rml_tag_t msg_tag;
     // optional completion callback, fired on the master when the whole DVM has
     // received this op (see prte_grpcomm_xcast_nb).  NULL when unused.
     prte_grpcomm_xcast_complete_fn_t cbfunc;
     void *cbdata;
+    // the daemons this op is for, or NULL for all of them.  Only the child
+    // subtrees holding one are forwarded to (see prte_grpcomm_xcast_pruned)
+    pmix_bitmap_t *dests;
+    // the pruned ops stamped between the last full op and this one - list of
+    // pruned_op_t - any of which a daemon may find missing
+    pmix_list_t pruned;
+    // an id before this one is missing, and not for pruning: reported once
+    bool gap_reported;
 } op_t;
 PMIX_CLASS_DECLARATION(op_t);
 
@@ -109,7 +145,7 @@ static void begin_xcast(int, short, void*);
 static op_t* find_op(signature_t *sig);
 // Returns op after constructing & inserting it into our tracking list
 static op_t* insert_forwarded_op(signature_t *sig);
-// Standard forward to all children,
+// Standard forward to all children the op is for
 static void forward_op(op_t *op);
 // Forward to specific destination
 static void forward_op_to(op_t *op, pmix_rank_t dest);
@@ -133,10 +169,14 @@ static void send_ack(signature_t* sig, pmix_rank_t ack_id);
 static void request_ack(pmix_rank_t from, signature_t* sig, pmix_rank_t ack_id);
 // Remove local tracking and ack to parent
 static void finish_op(op_t *op);
+// Master: hand this op the pruned ops stamped ahead of it, and note it if pruned
+static void stamp_pruned(op_t *op);
+// Is every id between the last op we finished and this one pruned away from us?
+static bool op_in_order(op_t *op);
 // Finish every op that is now both complete and next in op-id order
 static void drive_completions(void);
 // Give up on this op's exchange and get the payload the tree way
-static void tree_whole_forward(op_t *op);
+static void tree_whole_forward(op_t *op, pmix_bitmap_t *wanted);
 // How this broadcast will travel - decided by its originator, and only there
 // Is an op ahead of this one in op-id order still waiting on its payload?
 
@@ -156,6 +196,26 @@ static int pack_msg     (pmix_data_buffer_t* buffer, op_t* op);
 static int unpack_msg   (pmix_data_buffer_t* buffer, op_t* op);
 static int pack_bool    (pmix_data_buffer_t* buffer, bool* boolean);
 static int unpack_bool  (pmix_data_buffer_t* buffer, bool* boolean);
+static int pack_dests   (pmix_data_buffer_t* buffer, op_t* op);
+static int unpack_dests (pmix_data_buffer_t* buffer, op_t* op);
+static int pack_pruned  (pmix_data_buffer_t* buffer, op_t* op);
+static int unpack_pruned(pmix_data_buffer_t* buffer, op_t* op);
+static int pack_bitmap  (pmix_data_buffer_t* buffer, pmix_bitmap_t* bm);
+static int unpack_bitmap(pmix_data_buffer_t* buffer, pmix_bitmap_t** bm);
+
+/* d * k of the cost model below: the depth of the routing tree over the
+ * daemons we have now, times its radix */
+static double xcast_fanout(void){
+    size_t k = (1 < prte_rml_base.radix) ? (size_t) prte_rml_base.radix : 2;
+    size_t span = 1, width = 1, d = 0;
+
+    while (span < prte_process_info.num_daemons) {
+        width *= k;
+        span += width;
+        d++;
+    }
+    return (double) (d * k);
+}
 
 int prte_grpcomm_xcast(prte_rml_tag_t tag, pmix_data_buffer_t *msg){
     return prte_grpcomm_xcast_nb(tag, msg, NULL, NULL);
@@ -164,13 +224,29 @@ int prte_grpcomm_xcast(prte_rml_tag_t tag, pmix_data_buffer_t *msg){
 int prte_grpcomm_xcast_nb(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
                                  prte_grpcomm_xcast_complete_fn_t cbfunc,
                                  void *cbdata){
+    return prte_grpcomm_xcast_pruned(tag, msg, NULL, cbfunc, cbdata);
+}
+
+int prte_grpcomm_xcast_pruned(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
+                              const pmix_bitmap_t *dests,
+                              prte_grpcomm_xcast_complete_fn_t cbfunc,
+                              void *cbdata){
     PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
-                         "%s grpcomm:xcast: with %d bytes",
+                         "%s grpcomm:xcast: with %d bytes%s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                         (int) msg->bytes_used));
+                         (int) msg->bytes_used,
+                         (NULL == dests) ? "" : " (pruned)"));
 
     op_t* op = PMIX_NEW(op_t);
     op->msg_tag = tag;
+    if (NULL != dests) {
+        /* our own copy - the caller keeps theirs, and the op outlives this
+         * call by at least a thread-shift */
+        op->dests = PMIX_NEW(pmix_bitmap_t);
+        pmix_bitmap_init(op->dests, dests->array_size * 64);
+        memcpy(op->dests->bitmap, dests->bitmap,
+               dests->array_size * sizeof(uint64_t));
+    }
     /* stash the completion callback on the initiating op.  It is not fired from
      * this op (which is discarded after begin_xcast relays it); begin_xcast
      * copies it into the pending-completion FIFO once the broadcast is actually
@@ -201,11 +277,12 @@ int prte_grpcomm_xcast_nb(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
      *
      * a comparison of two rates, not a size.  A size threshold cannot express
      * that; it buys only protection from the fixed cost of starting the
-     * compressor and from the poor ratios of tiny inputs, which is worth having
-     * but is the compressor's own business - every pcompress component already
-     * declines an input below its configured limit, and declines any result
-     * that is not actually smaller.  So there is nothing for this layer to add:
-     * hand the payload over and let the component judge it.
+     * compressor and from the poor ratios of tiny inputs.  Nor is R one
+     * number: deflate's 100 MB/s loses to a 10-25 GbE link on a mid-sized
+     * launch message where LZ4's gigabytes per second win.  So prte_compress()
+     * is handed d * k and weighs each codec it has - with the rate and ratio
+     * it has measured on this process's payloads - against sending raw, and
+     * the codec it picks rides with the payload for process_msg() to undo.
      *
      * At the scales this runtime is built for the answer is a clear yes.  A
      * 10000-node DVM at 128 processes per node has d = 3 and k = 64 (the
@@ -216,7 +293,7 @@ int prte_grpcomm_xcast_nb(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
      * (B = 1.25 GB/s): 39 s raw against 20 s compressed, for well under a
      * second of deflate.  Compression halves it.
      *
-     * The one thing to keep in mind is that this deflate runs BEFORE the
+     * The one thing to keep in mind is that this compression runs BEFORE the
      * thread-shift below, so it is serial on the caller's thread - and every
      * caller is already the progress thread.  At 256 MB the HNP stalls for the
      * duration, servicing no RML message and no PMIx connection while it works.
@@ -225,16 +302,18 @@ int prte_grpcomm_xcast_nb(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
     {
         struct timeval t0, t1;
         char timing[32];
+        bool compressed;
 
         timing[0] = '\0';
         if (prte_grpcomm_globals.enable_timing) {
             gettimeofday(&t0, NULL);
         }
 
-        op->msg_compressed = (bool) PMIx_Data_compress(
-            (uint8_t*) msg->base_ptr, msg->bytes_used,
+        op->msg_codec = prte_compress(
+            (uint8_t*) msg->base_ptr, msg->bytes_used, xcast_fanout(),
             (uint8_t**) &op->msg.bytes, &op->msg.size
         );
+        compressed = (PRTE_COMPRESS_NONE != op->msg_codec);
 
         if (prte_grpcomm_globals.enable_timing) {
             gettimeofday(&t1, NULL);
@@ -246,26 +325,26 @@ int prte_grpcomm_xcast_nb(prte_rml_tag_t tag, pmix_data_buffer_t *msg,
         /* What the compressor decided and what it bought - raw size, on-wire
          * size, and the ratio - for every broadcast, so the line is a complete
          * census of what a DVM broadcasts rather than only of what it
-         * compressed.  The deflate time is appended only when timing is
+         * compressed.  The compression time is appended only when timing is
          * enabled; it is the term that has to be weighed against the wire time
          * saved on every link of the tree. */
         PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_globals.output,
                              "%s grpcomm:xcast: tag %u raw %lu wire %lu "
-                             "ratio %.4f %s%s",
+                             "ratio %.4f codec %s%s",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                              (unsigned) tag,
                              (unsigned long) msg->bytes_used,
-                             (unsigned long) (op->msg_compressed ? op->msg.size
-                                                                 : msg->bytes_used),
+                             (unsigned long) (compressed ? op->msg.size
+                                                         : msg->bytes_used),
                              (0 == msg->bytes_used) ? 1.0
-                                 : (double) (op->msg_compressed ? op->msg.size
-                                                                : msg->bytes_used)
+                                 : (double) (compressed ? op->msg.size
+                                                        : msg->bytes_used)
                                    / (double) msg->bytes_used,
-                             op->msg_compressed ? "compressed" : "uncompressed",
+                             prte_compress_codec_name(op->msg_codec),
                              timing));
     }
 
-    if(!op->msg_compressed){
+    if(PRTE_COMPRESS_NONE == op->msg_codec){
         pmix_data_buffer_t msg_copy;
         PMIx_Data_buffer_construct(&msg_copy);
 
@@ -395,6 +474,9 @@ void prte_grpcomm_xcast_recv(
             PMIX_RELEASE(op);
             return;
         }
+        if(PRTE_PROC_IS_MASTER){
+            stamp_pruned(op);
+        }
     }
 
     op->ack_id_up = ack_id;
@@ -434,6 +516,7 @@ void prte_grpcomm_xcast_recv(
     // children before the reshape is what delivers the notice to the very
     // children that are about to re-home. Do not move it into this set.
     bool process_first = PRTE_RML_TAG_WIREUP == op->msg_tag ||
+                         PRTE_RML_TAG_NIDMAP_SNAPSHOT == op->msg_tag ||
                          PRTE_RML_TAG_DAEMON_DIED == op->msg_tag;
     if(process_first){
         process_msg(op);
@@ -525,17 +608,18 @@ void prte_grpcomm_xcast_fault_handler(
 
         op_t* op;
         op_t* next_op;
+        pmix_bitmap_t wanted;
+        PMIX_CONSTRUCT(&wanted, pmix_bitmap_t);
         PMIX_LIST_FOREACH_SAFE(op, next_op, &XCAST.ops, op_t){
-            if(0 == prte_rml_base.n_children){
-                /* Under tree_whole both tests are constants - every op holds
-                 * its payload and nothing can be blocked - so this is the
-                 * unconditional finish it has always been. */
-                finish_op(op);
+            op->nexpected = prte_grpcomm_xcast_reach(op->dests, &wanted);
+            if(0 == op->nexpected){
+                /* No child of ours is owed this op, so it is ready to finish
+                 * as it stands - drive_completions below does that, in
+                 * op-id order. */
+                op->nreported = 0;
                 continue;
             }
 
-            op->nexpected = prte_rml_base.n_children;
-
             // If this op is currently pending replay, so are all after it.
             if(op->replay_pending_parent) break;
 
@@ -559,7 +643,8 @@ void prte_grpcomm_xcast_fault_handler(
             }
 
             for(size_t i = 0; i < prte_rml_base.children.size; i++){
-                if(PMIX_RANK_INVALID == children[i]){
+                if(PMIX_RANK_INVALID == children[i] ||
+                   !pmix_bitmap_is_set_bit(&wanted, i)){
                     continue;
                 } else if(children[i] != prev_children[i] || status->demoted){
                     // When demoted, we don't know if an old child that followed
@@ -573,6 +658,7 @@ void prte_grpcomm_xcast_fault_handler(
                 }
             }
         }
+        PMIX_DESTRUCT(&wanted);
     }
 
     /* Any exchange still running has lost a participant, and no rearrangement
@@ -691,21 +777,98 @@ static bool op_ready(const op_t* op){
     return op->nreported >= op->nexpected;
 }
 
+/* Ops finish strictly in op-id order, the list's order: a pruned op can be
+ * owed fewer acks than the op ahead of it and be ready first, and finishing
+ * it then would move op_id_completed past an op still in flight. */
 static void drive_completions(void){
-    bool progress = true;
-    while(progress){
-        op_t* op;
-        op_t* next;
-        progress = false;
-        PMIX_LIST_FOREACH_SAFE(op, next, &XCAST.ops, op_t){
-            if(!op_ready(op)) continue;
-            finish_op(op);
-            /* finish_op unlinked and released op, so restart the walk
-             * rather than trust the cursor */
-            progress = true;
-            break;
+    op_t* op;
+    while(NULL != (op = (op_t*) pmix_list_get_first(&XCAST.ops)) &&
+          op != (op_t*) pmix_list_get_end(&XCAST.ops)){
+        if(!op_ready(op) || !op_in_order(op)) break;
+        /* finish_op unlinks and releases it */
+        finish_op(op);
+    }
+}
+
+/* An op for these daemons was forwarded to us if one of them is us or in our
+ * subtree - the test prte_grpcomm_xcast_reach makes for each child, and like
+ * it, a failed daemon is nobody's destination. */
+bool prte_grpcomm_xcast_reaches_here(const pmix_bitmap_t* dests){
+    pmix_rank_t d, nbits = (pmix_rank_t) dests->array_size * 64;
+
+    for(d = 0; d < nbits; d++){
+        if(!pmix_bitmap_is_set_bit((pmix_bitmap_t *) dests, d) ||
+           pmix_bitmap_is_set_bit(&prte_rml_base.failed_dmns, d)){
+            continue;
+        }
+        if(d == PRTE_PROC_MY_NAME->rank || 0 <= prte_rml_get_subtree_index(d)){
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool op_in_order(op_t* op){
+    pruned_op_t* p;
+    size_t gap, covered = 0;
+
+    /* at or below the promotion mark there is nothing to check (see
+     * finish_op), and an id at or below the mark we have is finish_op's to
+     * report */
+    if(op->sig.op_id <= XCAST.op_id_completed_at_promotion ||
+       op->sig.op_id <= XCAST.op_id_completed + 1){
+        return true;
+    }
+    gap = op->sig.op_id - XCAST.op_id_completed - 1;
+    PMIX_LIST_FOREACH(p, &op->pruned, pruned_op_t){
+        if(p->op_id > XCAST.op_id_completed && p->op_id < op->sig.op_id &&
+           !prte_grpcomm_xcast_reaches_here(p->dests)){
+            covered++;
         }
     }
+    if(covered == gap){
+        return true;
+    }
+    /* an op we were owed has not arrived: hold this one, and everything
+     * behind it, until it does - a replay after a repair brings it */
+    if(!op->gap_reported){
+        op->gap_reported = true;
+        PMIX_OUTPUT_VERBOSE((
+            1, prte_grpcomm_globals.output,
+            "%s grpcomm:xcast op %lu held: %lu of the ops since %lu are missing",
+            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned long) op->sig.op_id,
+            (unsigned long) (gap - covered), (unsigned long) XCAST.op_id_completed
+        ));
+        PRTE_ERROR_LOG( PRTE_ERR_OUT_OF_ORDER_MSG );
+    }
+    return false;
+}
+
+static void stamp_pruned(op_t* op){
+    pruned_op_t *p, *cp;
+
+    if(NULL != op->dests && XCAST_MAX_PRUNED <= pmix_list_get_size(&XCAST.pruned)){
+        /* a full op settles the list - send this one everywhere */
+        PMIX_RELEASE(op->dests);
+        op->dests = NULL;
+    }
+    PMIX_LIST_FOREACH(p, &XCAST.pruned, pruned_op_t){
+        cp = PMIX_NEW(pruned_op_t);
+        cp->op_id = p->op_id;
+        PMIX_RETAIN(p->dests);
+        cp->dests = p->dests;
+        pmix_list_append(&op->pruned, &cp->super);
+    }
+    if(NULL == op->dests){
+        PMIX_LIST_DESTRUCT(&XCAST.pruned);
+        PMIX_CONSTRUCT(&XCAST.pruned, pmix_list_t);
+        return;
+    }
+    p = PMIX_NEW(pruned_op_t);
+    p->op_id = op->sig.op_id;
+    PMIX_RETAIN(op->dests);
+    p->dests = op->dests;
+    pmix_list_append(&XCAST.pruned, &p->super);
 }
 
 
@@ -713,10 +876,13 @@ static void finish_op(op_t* op) {
     send_ack(&op->sig, op->ack_id_up);
     pmix_list_remove_item(&XCAST.ops, &op->super);
     if(op->sig.op_id > XCAST.op_id_completed_at_promotion){
-        if(op->sig.op_id != XCAST.op_id_completed+1){
+        /* Ops finish in order, and op_in_order has checked that any id
+         * between the last one and this is an op pruned away from our
+         * subtree - one that was never coming. */
+        if(op->sig.op_id <= XCAST.op_id_completed){
             PRTE_ERROR_LOG( PRTE_ERR_OUT_OF_ORDER_MSG );
         } else {
-            XCAST.op_id_completed++;
+            XCAST.op_id_completed = op->sig.op_id;
         }
     }
     process_msg(op); // If not already processed, process before releasing
@@ -762,14 +928,57 @@ static int pack_ack_id(pmix_data_buffer_t* buffer, pmix_rank_t* ack_id){
 }
 static int pack_msg(pmix_data_buffer_t* buffer, op_t* op){
     DIRECT_XCAST_PACK(buffer, &op->msg_tag,        PRTE_RML_TAG);
-    DIRECT_XCAST_PACK(buffer, &op->msg_compressed, PMIX_BOOL);
+    DIRECT_XCAST_PACK(buffer, &op->msg_codec,      PRTE_COMPRESS_CODEC_T);
     DIRECT_XCAST_PACK(buffer, &op->msg,            PMIX_BYTE_OBJECT);
-    return PMIX_SUCCESS;
+    int rc = pack_dests(buffer, op);
+    if(PMIX_SUCCESS != rc) return rc;
+    return pack_pruned(buffer, op);
 }
 static int pack_bool(pmix_data_buffer_t* buffer, bool* boolean){
     DIRECT_XCAST_PACK(buffer, boolean, PMIX_BOOL);
     return PMIX_SUCCESS;
 }
+/* A bitmap goes as its word count and then its words. */
+static int pack_bitmap(pmix_data_buffer_t* buffer, pmix_bitmap_t* bm){
+    int32_t nwords = bm->array_size;
+    int rc;
+
+    DIRECT_XCAST_PACK(buffer, &nwords, PMIX_INT32);
+    if(0 < nwords){
+        rc = PMIx_Data_pack(NULL, buffer, bm->bitmap, nwords, PMIX_UINT64);
+        if(PMIX_SUCCESS != rc){
+            PMIX_ERROR_LOG(rc);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+/* The destination set rides with the op as its bitmap words, so that every
+ * hop can prune for its own children: a flag, then the bitmap when there is
+ * a set at all. */
+static int pack_dests(pmix_data_buffer_t* buffer, op_t* op){
+    bool pruned = (NULL != op->dests);
+
+    DIRECT_XCAST_PACK(buffer, &pruned, PMIX_BOOL);
+    if(!pruned) return PMIX_SUCCESS;
+    return pack_bitmap(buffer, op->dests);
+}
+/* The pruned ops ahead of this one (see pruned_op_t): a count, then each
+ * one's id and destination set. */
+static int pack_pruned(pmix_data_buffer_t* buffer, op_t* op){
+    int32_t n = (int32_t) pmix_list_get_size(&op->pruned);
+    pruned_op_t* p;
+    int rc;
+
+    DIRECT_XCAST_PACK(buffer, &n, PMIX_INT32);
+    PMIX_LIST_FOREACH(p, &op->pruned, pruned_op_t){
+        DIRECT_XCAST_PACK(buffer, &p->op_id, PMIX_SIZE);
+        rc = pack_bitmap(buffer, p->dests);
+        if(PMIX_SUCCESS != rc) return rc;
+    }
+    return PMIX_SUCCESS;
+}
 
 static int unpack_sig(pmix_data_buffer_t* buffer, signature_t* sig){
     DIRECT_XCAST_UNPACK(buffer, &sig->op_id, PMIX_SIZE);
@@ -781,14 +990,61 @@ static int unpack_ack_id(pmix_data_buffer_t* buffer, pmix_rank_t* ack_id){
 }
 static int unpack_msg(pmix_data_buffer_t* buffer, op_t* op){
     DIRECT_XCAST_UNPACK(buffer, &op->msg_tag,        PRTE_RML_TAG);
-    DIRECT_XCAST_UNPACK(buffer, &op->msg_compressed, PMIX_BOOL);
+    DIRECT_XCAST_UNPACK(buffer, &op->msg_codec,      PRTE_COMPRESS_CODEC_T);
     DIRECT_XCAST_UNPACK(buffer, &op->msg,            PMIX_BYTE_OBJECT);
-    return PMIX_SUCCESS;
+    int rc = unpack_dests(buffer, op);
+    if(PMIX_SUCCESS != rc) return rc;
+    return unpack_pruned(buffer, op);
 }
 static int unpack_bool(pmix_data_buffer_t* buffer, bool* boolean){
     DIRECT_XCAST_UNPACK(buffer, boolean, PMIX_BOOL);
     return PMIX_SUCCESS;
 }
+static int unpack_bitmap(pmix_data_buffer_t* buffer, pmix_bitmap_t** bm){
+    int32_t nwords, cnt;
+    int rc;
+
+    DIRECT_XCAST_UNPACK(buffer, &nwords, PMIX_INT32);
+    if(0 > nwords){
+        PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *bm = PMIX_NEW(pmix_bitmap_t);
+    pmix_bitmap_init(*bm, nwords * 64);
+    if(0 < nwords){
+        cnt = nwords;
+        rc = PMIx_Data_unpack(NULL, buffer, (*bm)->bitmap, &cnt, PMIX_UINT64);
+        if(PMIX_SUCCESS != rc){
+            PMIX_ERROR_LOG(rc);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+static int unpack_dests(pmix_data_buffer_t* buffer, op_t* op){
+    bool pruned;
+
+    DIRECT_XCAST_UNPACK(buffer, &pruned, PMIX_BOOL);
+    if(!pruned) return PMIX_SUCCESS;
+    return unpack_bitmap(buffer, &op->dests);
+}
+static int unpack_pruned(pmix_data_buffer_t* buffer, op_t* op){
+    int32_t n, i;
+    pruned_op_t* p;
+    int rc;
+
+    DIRECT_XCAST_UNPACK(buffer, &n, PMIX_INT32);
+    for(i = 0; i < n; i++){
+        p = PMIX_NEW(pruned_op_t);
+        /* on the list first, so that the op's destructor has it if we fail */
+        pmix_list_append(&op->pruned, &p->super);
+        DIRECT_XCAST_UNPACK(buffer, &p->op_id, PMIX_SIZE);
+        rc = unpack_bitmap(buffer, &p->dests);
+        if(PMIX_SUCCESS != rc) return rc;
+    }
+    return PMIX_SUCCESS;
+}
 
 /* The relay from an originator to the controller.  A point-to-point send; the
  * receiver tells it from a forward by the op-id, which is zero here and
@@ -859,20 +1115,18 @@ static op_t* insert_forwarded_op(signature_t* sig) {
  *
  * That is why pack_forward_msg takes no destination.  If a forward ever does
  * need to differ per child, this is the loop that has to go back to packing
- * inside it - the sharing is not an optimization the RML can make on its own. */
-static void tree_whole_forward(op_t* op){
+ * inside it - the sharing is not an optimization the RML can make on its own.
+ * A pruned op is no exception: its destination set goes to every child it is
+ * sent to, whole, and each of them prunes for its own children.
+ *
+ * "wanted" marks the children the op goes to, as prte_grpcomm_xcast_reach()
+ * left it. */
+static void tree_whole_forward(op_t* op, pmix_bitmap_t* wanted){
     pmix_rank_t* children = (pmix_rank_t*) prte_rml_base.children.array;
     prte_rml_payload_t* payload;
     size_t i;
-    bool any = false;
 
-    for (i = 0; i < prte_rml_base.children.size; i++) {
-        if (PMIX_RANK_INVALID != children[i]) {
-            any = true;
-            break;
-        }
-    }
-    if (!any) {
+    if (0 == op->nexpected) {
         return;
     }
 
@@ -882,7 +1136,8 @@ static void tree_whole_forward(op_t* op){
     }
 
     for (i = 0; i < prte_rml_base.children.size; i++) {
-        if (PMIX_RANK_INVALID == children[i]) {
+        if (PMIX_RANK_INVALID == children[i] ||
+            !pmix_bitmap_is_set_bit(wanted, i)) {
             continue;
         }
         forward_payload_to(op, payload, children[i]);
@@ -908,12 +1163,55 @@ static void forward_op(op_t* op){
     }
 
     /* A daemon reports its subtree complete once it holds the payload and
-     * all its children have reported. */
+     * every child it forwarded to has reported. */
+    pmix_bitmap_t wanted;
+    PMIX_CONSTRUCT(&wanted, pmix_bitmap_t);
     op->replay_pending_parent = false;
-    op->nexpected = prte_rml_base.n_children;
+    op->nexpected = prte_grpcomm_xcast_reach(op->dests, &wanted);
     op->nreported = 0;
 
-    tree_whole_forward(op);
+    tree_whole_forward(op, &wanted);
+    PMIX_DESTRUCT(&wanted);
+}
+
+size_t prte_grpcomm_xcast_reach(const pmix_bitmap_t *dests, pmix_bitmap_t *wanted){
+    pmix_rank_t* children = (pmix_rank_t*) prte_rml_base.children.array;
+    size_t i, n = 0;
+    pmix_rank_t d, nbits;
+    int slot;
+
+    pmix_bitmap_init(wanted, (0 < prte_rml_base.children.size)
+                                 ? (int) prte_rml_base.children.size : 1);
+    pmix_bitmap_clear_all_bits(wanted);
+    if (NULL == dests) {
+        for (i = 0; i < prte_rml_base.children.size; i++) {
+            if (PMIX_RANK_INVALID != children[i]) {
+                pmix_bitmap_set_bit(wanted, i);
+                n++;
+            }
+        }
+        return n;
+    }
+
+    /* One pass over the set rather than one per child.  A failed
+     * destination is nobody's to deliver to - a daemon promoted into its
+     * place is a destination only if it was named. */
+    nbits = (pmix_rank_t) dests->array_size * 64;
+    for (d = 0; d < nbits; d++) {
+        if (!pmix_bitmap_is_set_bit((pmix_bitmap_t *) dests, d) ||
+            d == PRTE_PROC_MY_NAME->rank ||
+            pmix_bitmap_is_set_bit(&prte_rml_base.failed_dmns, d)) {
+            continue;
+        }
+        slot = prte_rml_get_subtree_index(d);
+        if (0 > slot || PMIX_RANK_INVALID == children[slot] ||
+            pmix_bitmap_is_set_bit(wanted, slot)) {
+            continue;
+        }
+        pmix_bitmap_set_bit(wanted, slot);
+        n++;
+    }
+    return n;
 }
 
 /* A forward that never arrives is an ack that never comes.
@@ -1036,7 +1334,7 @@ static void forward_op_to(op_t* op, pmix_rank_t dest){
 static void process_wireup(pmix_data_buffer_t *msg){
     if(PRTE_PROC_IS_MASTER) return;
 
-    int ret = prte_util_decode_nidmap(msg);
+    int ret = prte_util_nidmap_apply_update(msg);
     if(PMIX_SUCCESS != ret){
        PMIX_ERROR_LOG(ret);
        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
@@ -1122,6 +1420,18 @@ static void process_wireup(pmix_data_buffer_t *msg){
     return;
 }
 
+/* The node map for a daemon that holds none, ahead of the WIREUP whose delta
+ * it could not apply.  Daemons it only passes through keep their map. */
+static void process_snapshot(pmix_data_buffer_t *msg){
+    if(PRTE_PROC_IS_MASTER) return;
+
+    int ret = prte_util_nidmap_apply_snapshot(msg);
+    if(PRTE_SUCCESS != ret){
+       PRTE_ERROR_LOG(ret);
+       PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+    }
+}
+
 static void process_msg(op_t* op){
     int ret = PMIX_SUCCESS;
 
@@ -1129,15 +1439,16 @@ static void process_msg(op_t* op){
     op->processed = true;
 
     pmix_data_buffer_t *msg = PMIx_Data_buffer_create();
-    if(op->msg_compressed){
+    if(PRTE_COMPRESS_NONE != op->msg_codec){
         pmix_byte_object_t decomp_msg = PMIX_BYTE_OBJECT_STATIC_INIT;
-        bool success = PMIx_Data_decompress(
-            (uint8_t* ) op->msg.bytes, op->msg.size,
+        bool success = prte_decompress(
+            op->msg_codec, (uint8_t* ) op->msg.bytes, op->msg.size,
             (uint8_t**) &decomp_msg.bytes, &decomp_msg.size
         );
         if(!success){
             prte_show_help("help-prte-runtime.txt", "failed-to-uncompress",
-                           true, prte_process_info.nodename);
+                           true, prte_process_info.nodename,
+                           prte_compress_codec_name(op->msg_codec));
             PMIX_BYTE_OBJECT_DESTRUCT(&decomp_msg);
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
             PMIx_Data_buffer_release(msg);
@@ -1155,6 +1466,8 @@ static void process_msg(op_t* op){
 
     if(PRTE_RML_TAG_WIREUP == op->msg_tag){
         process_wireup(msg);
+    } else if(PRTE_RML_TAG_NIDMAP_SNAPSHOT == op->msg_tag){
+        process_snapshot(msg);
     } else {
         /* pass the relay buffer to myself for processing - don't inject it into
          * the RML system via send as that will compete with the relay messages
@@ -1184,15 +1497,22 @@ static void op_con(op_t* p)
     p->ack_id_down = 0;
 
     PMIx_Byte_object_construct(&p->msg);
-    p->msg_compressed = false;
+    p->msg_codec = PRTE_COMPRESS_NONE;
     p->msg_tag = PRTE_RML_TAG_INVALID;
 
     p->cbfunc = NULL;
     p->cbdata = NULL;
+    p->dests = NULL;
+    PMIX_CONSTRUCT(&p->pruned, pmix_list_t);
+    p->gap_reported = false;
 }
 static void op_des(op_t* p)
 {
     PMIX_BYTE_OBJECT_DESTRUCT(&p->msg);
+    if (NULL != p->dests) {
+        PMIX_RELEASE(p->dests);
+    }
+    PMIX_LIST_DESTRUCT(&p->pruned);
 }
 PMIX_CLASS_INSTANCE(op_t, pmix_list_item_t, op_con, op_des);
 
@@ -1201,6 +1521,7 @@ static void xcast_con(prte_grpcomm_xcast_t* p)
 {
     PMIX_CONSTRUCT(&p->ops, pmix_list_t);
     PMIX_CONSTRUCT(&p->pending_completions, pmix_list_t);
+    PMIX_CONSTRUCT(&p->pruned, pmix_list_t);
     p->op_id_completed = 0;
     p->op_id_completed_at_promotion = 0;
     p->op_id_inited = 0;
@@ -1209,6 +1530,7 @@ static void xcast_des(prte_grpcomm_xcast_t* p)
 {
     PMIX_LIST_DESTRUCT(&p->ops);
     PMIX_LIST_DESTRUCT(&p->pending_completions);
+    PMIX_LIST_DESTRUCT(&p->pruned);
 }
 PMIX_CLASS_INSTANCE(prte_grpcomm_xcast_t, pmix_object_t, xcast_con, xcast_des);
 
@@ -126,6 +126,10 @@ prte_hwloc_print_buffers_t *prte_hwloc_get_print_buffer(void);
 extern char *prte_hwloc_print_null;
 
 PRTE_EXPORT extern char *prte_hwloc_base_topo_file;
+/* directory of the node-local topology cache (NULL: no cache), and
+ * whether to rediscover and rewrite the entry regardless */
+PRTE_EXPORT extern char *prte_hwloc_base_topo_cache;
+PRTE_EXPORT extern bool prte_hwloc_base_topo_cache_refresh;
 
 PRTE_EXPORT int prte_hwloc_base_set_default_binding(void *jdata,
                                                     void *options);
@@ -40,6 +40,8 @@ prte_hwloc_base_mbfa_t prte_hwloc_base_mbfa = PRTE_HWLOC_BASE_MBFA_WARN;
 prte_binding_policy_t prte_hwloc_default_binding_policy = 0;
 char *prte_hwloc_default_cpu_list = NULL;
 char *prte_hwloc_base_topo_file = NULL;
+char *prte_hwloc_base_topo_cache = NULL;
+bool prte_hwloc_base_topo_cache_refresh = false;
 int prte_hwloc_base_output = -1;
 bool prte_hwloc_default_use_hwthread_cpus = false;
 
@@ -249,6 +251,23 @@ int prte_hwloc_base_register(void)
     (void) pmix_mca_base_var_register_synonym(ret, "prte", "hwloc", "base", "use_topo_file",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    prte_hwloc_base_topo_cache = NULL;
+    (void) pmix_mca_base_var_register("prte", "hwloc", "topo", "cache",
+                                      "Directory in which to cache this node's discovered topology, "
+                                      "so that later daemon starts on the node load it instead of "
+                                      "rediscovering it. Entries are keyed by boot ID, hardware and "
+                                      "cpu set, and the directory is created if needed [default: "
+                                      "none - always discover]",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_hwloc_base_topo_cache);
+
+    prte_hwloc_base_topo_cache_refresh = false;
+    (void) pmix_mca_base_var_register("prte", "hwloc", "topo", "cache_refresh",
+                                      "Rediscover the topology and rewrite its cache entry even if "
+                                      "one matches (e.g., after a hardware change without a reboot)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_hwloc_base_topo_cache_refresh);
+
     /* register parameters */
     return PRTE_SUCCESS;
 }
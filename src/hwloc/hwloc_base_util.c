@@ -31,8 +31,13 @@
 
 #include "prte_config.h"
 
+#if PRTE_HAVE_SCHED_SETAFFINITY
+#    include <sched.h>
+#endif
 #include <errno.h>
+#include <inttypes.h>
 #include <limits.h>
+#include <stdio.h>
 
 #ifdef HAVE_SYS_TYPES_H
 #    include <sys/types.h>
@@ -61,6 +66,7 @@
 #include "src/util/proc_info.h"
 #include "src/util/pmix_show_help.h"
 #include "src/util/prte_show_help.h"
+#include "src/util/prte_profile.h"
 
 #include "src/hwloc/hwloc-internal.h"
 
@@ -449,11 +455,152 @@ static void fill_cache_line_size(void)
 static int set_topology(char *topofile);
 static int topology_set_flags(hwloc_topology_t topology, unsigned long flags, bool io);
 
+/*
+ * Node-local topology cache.
+ *
+ * Full discovery - I/O devices included - costs hundreds of milliseconds
+ * on a large node, and every daemon start on that node pays it again for
+ * the same answer. When hwloc_topo_cache names a directory, the first
+ * start exports what it discovered there as XML and later starts load
+ * that instead.
+ *
+ * The file name carries a hash of everything we can cheaply see that
+ * would change the answer: the boot ID, the host, the CPU count and memory
+ * size the OS reports, the hwloc version, and the cpu set and cgroup this
+ * process was started in. The last two matter because discovery drops the
+ * PUs we are not allowed to use, so two allocations sharing a node must
+ * not share an entry. Anything the hash cannot see - a device hot-plugged
+ * since boot, say - needs explicit invalidation: remove the file, or set
+ * hwloc_topo_cache_refresh to rediscover and rewrite it.
+ */
+#define PRTE_TOPO_CACHE_FNV_OFFSET 14695981039346656037ULL
+#define PRTE_TOPO_CACHE_FNV_PRIME  1099511628211ULL
+
+static uint64_t topo_cache_hash(uint64_t h, const void *data, size_t len)
+{
+    const unsigned char *p = (const unsigned char *) data;
+    size_t n;
+
+    for (n = 0; n < len; n++) {
+        h ^= p[n];
+        h *= PRTE_TOPO_CACHE_FNV_PRIME;
+    }
+    return h;
+}
+
+/* fold the contents of a (small, procfs) file into the hash - a file that
+ * is not there contributes nothing, which is the right answer off Linux */
+static uint64_t topo_cache_hash_file(uint64_t h, const char *path)
+{
+    char buf[4096];
+    size_t len;
+    FILE *fp;
+
+    if (NULL == (fp = fopen(path, "r"))) {
+        return h;
+    }
+    while (0 < (len = fread(buf, 1, sizeof(buf), fp))) {
+        h = topo_cache_hash(h, buf, len);
+    }
+    fclose(fp);
+    return h;
+}
+
+static char *topo_cache_path(void)
+{
+    uint64_t h = PRTE_TOPO_CACHE_FNV_OFFSET;
+    unsigned api;
+    long v;
+    char *path;
+    const char *host;
+#if PRTE_HAVE_SCHED_SETAFFINITY && defined(CPU_ZERO)
+    cpu_set_t mask;
+#endif
+
+    host = (NULL == prte_process_info.nodename) ? "localhost" : prte_process_info.nodename;
+    h = topo_cache_hash(h, host, strlen(host));
+    h = topo_cache_hash_file(h, "/proc/sys/kernel/random/boot_id");
+    v = sysconf(_SC_NPROCESSORS_CONF);
+    h = topo_cache_hash(h, &v, sizeof(v));
+#ifdef _SC_PHYS_PAGES
+    v = sysconf(_SC_PHYS_PAGES);
+    h = topo_cache_hash(h, &v, sizeof(v));
+#endif
+    api = hwloc_get_api_version();
+    h = topo_cache_hash(h, &api, sizeof(api));
+    /* cpu_set_t is a GNU extension: prte_config.h defines _GNU_SOURCE
+     * ahead of every system header, except for the compilers configure
+     * keeps it from, and there the mask is simply left out */
+#if PRTE_HAVE_SCHED_SETAFFINITY && defined(CPU_ZERO)
+    CPU_ZERO(&mask);
+    if (0 == sched_getaffinity(0, sizeof(mask), &mask)) {
+        h = topo_cache_hash(h, &mask, sizeof(mask));
+    }
+#endif
+    h = topo_cache_hash_file(h, "/proc/self/cgroup");
+
+    pmix_asprintf(&path, "%s/prte-topo-%s-%016" PRIx64 ".xml",
+                  prte_hwloc_base_topo_cache, host, h);
+    return path;
+}
+
+/* Load the cached topology at path as the topology of this very machine -
+ * unlike hwloc_use_topo_file, binding support then comes from the OS as it
+ * would for a discovered one. Any failure just means "not cached". */
+static bool topo_cache_load(const char *path)
+{
+    hwloc_topology_t topo;
+
+    if (0 != access(path, R_OK)) {
+        return false;
+    }
+    if (0 != hwloc_topology_init(&topo)) {
+        return false;
+    }
+    if (0 != hwloc_topology_set_xml(topo, path) ||
+        0 != topology_set_flags(topo, HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM, true) ||
+        0 != hwloc_topology_load(topo)) {
+        hwloc_topology_destroy(topo);
+        pmix_output_verbose(1, prte_hwloc_base_output,
+                            "hwloc:base cached topology %s unreadable - discovering", path);
+        return false;
+    }
+    prte_hwloc_topology = topo;
+    return true;
+}
+
+/* Write the topology we just discovered to path. Export to a private name
+ * and rename it into place, so a daemon starting alongside us never reads
+ * a half-written file. Failure costs only the next start's discovery. */
+static void topo_cache_save(const char *path)
+{
+    char *tmp;
+
+    if (PMIX_SUCCESS != pmix_os_dirpath_create(prte_hwloc_base_topo_cache, S_IRWXU)) {
+        pmix_output_verbose(1, prte_hwloc_base_output,
+                            "hwloc:base cannot create topology cache %s",
+                            prte_hwloc_base_topo_cache);
+        return;
+    }
+    pmix_asprintf(&tmp, "%s.%lu", path, (unsigned long) getpid());
+    if (0 != hwloc_topology_export_xml(prte_hwloc_topology, tmp, 0) ||
+        0 != rename(tmp, path)) {
+        pmix_output_verbose(1, prte_hwloc_base_output,
+                            "hwloc:base cannot write cached topology %s: %s",
+                            path, strerror(errno));
+        unlink(tmp);
+    }
+    free(tmp);
+}
+
 int prte_hwloc_base_get_topology(void)
 {
     int rc;
     unsigned i, j;
     hwloc_obj_t obj;
+    char *cache = NULL;
+    bool cached = false;
+    prte_profile_mark_t mark;
 
     pmix_output_verbose(2, prte_hwloc_base_output,
                         "hwloc:base:get_topology");
@@ -463,13 +610,31 @@ int prte_hwloc_base_get_topology(void)
         return PRTE_SUCCESS;
     }
 
-    if (NULL == prte_hwloc_base_topo_file) {
+    PRTE_PROFILE_MARK(&mark);
+
+    /* a topology file names some other machine's shape - never cache that */
+    if (NULL == prte_hwloc_base_topo_file && NULL != prte_hwloc_base_topo_cache &&
+        '\0' != prte_hwloc_base_topo_cache[0]) {
+        cache = topo_cache_path();
+        if (!prte_hwloc_base_topo_cache_refresh) {
+            cached = topo_cache_load(cache);
+        }
+        if (cached) {
+            pmix_output_verbose(1, prte_hwloc_base_output,
+                                "hwloc:base loaded cached topology %s", cache);
+        }
+    }
+
+    if (cached) {
+        /* nothing more to do */
+    } else if (NULL == prte_hwloc_base_topo_file) {
         pmix_output_verbose(1, prte_hwloc_base_output,
                             "hwloc:base discovering topology");
         if (0 != hwloc_topology_init(&prte_hwloc_topology)) {
             /* hwloc leaves the handle untouched on failure - do not hand a
              * garbage pointer to prte_hwloc_base_close() */
             prte_hwloc_topology = NULL;
+            free(cache);
             PRTE_ERROR_LOG(PRTE_ERR_NOT_SUPPORTED);
             return PRTE_ERR_NOT_SUPPORTED;
         }
@@ -477,9 +642,13 @@ int prte_hwloc_base_get_topology(void)
             0 != hwloc_topology_load(prte_hwloc_topology)) {
             hwloc_topology_destroy(prte_hwloc_topology);
             prte_hwloc_topology = NULL;
+            free(cache);
             PRTE_ERROR_LOG(PRTE_ERR_NOT_SUPPORTED);
             return PRTE_ERR_NOT_SUPPORTED;
         }
+        if (NULL != cache) {
+            topo_cache_save(cache);
+        }
     } else {
         pmix_output_verbose(1, prte_hwloc_base_output,
                             "hwloc:base loading topology from file %s",
@@ -521,6 +690,9 @@ int prte_hwloc_base_get_topology(void)
 
     // create the summary
     prte_hwloc_base_setup_summary(prte_hwloc_topology);
+
+    PRTE_PROFILE_STAGE(cached ? "topology_cached" : "topology", NULL, &mark, 0);
+    free(cache);
     return PRTE_SUCCESS;
 }
 
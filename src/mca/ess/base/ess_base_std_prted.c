@@ -70,6 +70,7 @@
 #include "src/util/name_fns.h"
 #include "src/util/session_dir.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/prte_profile.h"
 #include "src/util/prte_show_help.h"
 
 #include "src/mca/ess/base/base.h"
@@ -129,6 +130,7 @@ int prte_ess_base_prted_setup(void)
             goto error;
         }
     }
+    prte_profile_startup_phase("topology");
 
     /* define the HNP name */
     PMIX_LOAD_PROCID(PRTE_PROC_MY_HNP, PRTE_PROC_MY_NAME->nspace, 0);
@@ -173,6 +175,7 @@ int prte_ess_base_prted_setup(void)
             goto error;
         }
     }
+    prte_profile_startup_phase("state_errmgr_plm");
 
     /* Setup the job data object for the daemons */
     /* create and store the job data object */
@@ -224,6 +227,7 @@ int prte_ess_base_prted_setup(void)
         error = "prte_session_dir";
         goto error;
     }
+    prte_profile_startup_phase("session_dir");
 
     /* set the pmix_output env file location to be in the
      * proc-specific session directory. */
@@ -274,6 +278,7 @@ int prte_ess_base_prted_setup(void)
         error = "pmix_server_init";
         goto error;
     }
+    prte_profile_startup_phase("pmix_server_init");
 
     /* add network aliases to our list of alias hostnames - must
      * wait until after we init PMIx before getting them */
@@ -297,9 +302,11 @@ int prte_ess_base_prted_setup(void)
         error = "prte_rml_open";
         goto error;
     }
+    prte_profile_startup_phase("oob");
 
     /* it is now safe to start the pmix server */
     pmix_server_start();
+    prte_profile_startup_phase("pmix_server_start");
 
     /* select the errmgr */
     if (PRTE_SUCCESS != (ret = prte_errmgr_base_select())) {
@@ -315,6 +322,7 @@ int prte_ess_base_prted_setup(void)
         error = "prte_grpcomm_init";
         goto error;
     }
+    prte_profile_startup_phase("grpcomm");
     /* Open/select the odls */
     if (PRTE_SUCCESS
         != (ret = pmix_mca_base_framework_open(&prte_odls_base_framework,
@@ -328,6 +336,7 @@ int prte_ess_base_prted_setup(void)
         error = "prte_odls_base_select";
         goto error;
     }
+    prte_profile_startup_phase("odls");
     /* NOTE: a daemon does NOT open the rmaps framework. Mapping is the
      * HNP's job - the mapper is driven by the DVM state machine, which a
      * daemon does not run, and the launch path deliberately does not even
@@ -403,6 +412,7 @@ int prte_ess_base_prted_setup(void)
         error = "prte_filem_base_select";
         goto error;
     }
+    prte_profile_startup_phase("iof_filem");
 
     return PRTE_SUCCESS;
 
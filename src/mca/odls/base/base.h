@@ -63,6 +63,11 @@ typedef struct {
     bool scatter_cpusets;
     /* launches and cpuset slices that are waiting for each other */
     pmix_list_t pending_slices;
+    /* name the app contexts of a repeat launch rather than resending
+     * them - see src/runtime/prte_launch_template.h */
+    bool launch_templates;
+    /* launches waiting for the master to send a template they named */
+    pmix_list_t pending_templates;
     /* microseconds to stall between fork() and the store of the child's
      * pid - a fault-injection hook, see odls_base_frame.c */
     int fork_publish_delay;
@@ -112,6 +117,19 @@ PRTE_EXPORT void prte_odls_base_recv_cpuset_slice(int status, pmix_proc_t *sende
                                                   pmix_data_buffer_t *buffer,
                                                   prte_rml_tag_t tag, void *cbdata);
 
+/* The master's side of a launch template a daemon did not hold -
+ * registered on PRTE_RML_TAG_LAUNCH_TEMPLATE by the master only. */
+PRTE_EXPORT void prte_odls_base_recv_template_request(int status, pmix_proc_t *sender,
+                                                      pmix_data_buffer_t *buffer,
+                                                      prte_rml_tag_t tag, void *cbdata);
+
+/* The daemon's side: the template arrives and the launches that named it
+ * go ahead - registered on PRTE_RML_TAG_LAUNCH_TEMPLATE_RESP by every
+ * daemon other than the master. */
+PRTE_EXPORT void prte_odls_base_recv_template(int status, pmix_proc_t *sender,
+                                              pmix_data_buffer_t *buffer,
+                                              prte_rml_tag_t tag, void *cbdata);
+
 PRTE_EXPORT void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata);
 
 /* Apply the job's, then the app's, envar directives (SET/ADD/UNSET/
@@ -120,6 +138,23 @@ PRTE_EXPORT void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata);
 PRTE_EXPORT void prte_odls_base_process_envars(prte_job_t *jdata,
                                                prte_app_context_t *app);
 
+/* An app's launch environment, flattened into one block once per launch
+ * on this node and shared, read-only, by every local child of that app.
+ * Each child's envp is then just a pointer array over the block with the
+ * few rank-specific variables PMIx adds appended to it. */
+typedef struct {
+    pmix_object_t super;
+    char *block;    /* the "NAME=value" strings, back to back */
+    char **envp;    /* NULL-terminated, pointing into block */
+    char **byname;  /* the same pointers, sorted by variable name */
+    int count;
+} prte_odls_env_template_t;
+PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_odls_env_template_t);
+
+/* Flatten env into a new template. Returns NULL if out of memory, in which
+ * case the caller simply launches without one. */
+PRTE_EXPORT prte_odls_env_template_t *prte_odls_base_env_template(char **env);
+
 /* define an object for fork/exec the local proc */
 typedef struct {
     pmix_object_t super;
@@ -128,6 +163,11 @@ typedef struct {
     char *wdir;
     char **argv;
     char **env;
+    /* when env_shared is set, env is only a pointer array: its first
+       entries belong to env_template and the rest to env_overlay */
+    prte_odls_env_template_t *env_template;
+    char **env_overlay;
+    bool env_shared;
     prte_job_t *jdata;
     prte_app_context_t *app;
     prte_proc_t *child;
@@ -155,6 +195,13 @@ typedef struct {
 } prte_odls_spawn_caddy_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_odls_spawn_caddy_t);
 
+/* Point cd->env at cd->env_template followed by overlay, copying no
+ * strings; the caddy takes ownership of overlay. Returns false, leaving
+ * the caddy and overlay untouched, if overlay names a variable the
+ * template already sets - the caller must then build the environment the
+ * long way, as only the full copy can reproduce how PMIx resolved it. */
+PRTE_EXPORT bool prte_odls_base_env_compose(prte_odls_spawn_caddy_t *cd, char **overlay);
+
 /* define an object for starting local launch */
 typedef struct {
     pmix_object_t object;
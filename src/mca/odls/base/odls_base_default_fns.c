@@ -79,6 +79,7 @@
 #include "src/prted/pmix/pmix_server.h"
 #include "src/prted/prted.h"
 #include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_launch_template.h"
 #include "src/runtime/prte_wait.h"
 #include "src/runtime/prte_worker_pool.h"
 #include "src/threads/pmix_threads.h"
@@ -86,6 +87,7 @@
 #include "src/util/name_fns.h"
 #include "src/util/nidmap.h"
 #include "src/util/proc_info.h"
+#include "src/util/prte_profile.h"
 #include "src/util/session_dir.h"
 #include "src/util/pmix_show_help.h"
 #include "src/util/prte_show_help.h"
@@ -200,6 +202,51 @@ done:
     prte_event_active(&cd->ev, PRTE_EV_WRITE, 1);
 }
 
+/* The launch template header, ahead of the job.
+ *
+ * A zero id says the job carries its own apps.  Otherwise it names the
+ * template holding them, with the job's nspace and session - what a daemon
+ * that does not hold the template needs in order to ask for it - and, when
+ * the template is new, the template itself. */
+static int pack_template_header(pmix_data_buffer_t *buffer, prte_job_t *jdata,
+                                prte_launch_template_t *tmpl, bool fresh)
+{
+    pmix_status_t rc;
+    uint32_t id = (NULL == tmpl) ? 0 : tmpl->id;
+
+    rc = PMIx_Data_pack(NULL, buffer, &id, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 == id) {
+        return PRTE_SUCCESS;
+    }
+    rc = PMIx_Data_pack(NULL, buffer, &jdata->nspace, 1, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    rc = PMIx_Data_pack(NULL, buffer, &tmpl->session, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    rc = PMIx_Data_pack(NULL, buffer, &fresh, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (fresh) {
+        rc = PMIx_Data_pack(NULL, buffer, &tmpl->apps, 1, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
 /* IT IS CRITICAL THAT ANY CHANGE IN THE ORDER OF THE INFO PACKED IN
  * THIS FUNCTION BE REFLECTED IN THE CONSTRUCT_CHILD_LIST PARSER BELOW
  */
@@ -212,15 +259,18 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
     prte_node_t *node;
     int i, k;
     char **list, **procs, **micro, *tmp;
-#if !PRTE_PMIX_HAVE_REGEX2
-    char *regex;
-#endif
+    static prte_regex_memo_t node_memo = {0}, proc_memo = {0};
     prte_odls_jcaddy_t *cd;
     prte_proc_t *pptr;
     uint32_t uid;
     uint32_t gid;
     void *ilist, *mlist;
     pmix_data_array_t darray;
+    prte_profile_mark_t mark;
+    size_t start;
+    prte_job_pack_mode_t mode;
+    prte_launch_template_t *tmpl = NULL;
+    bool fresh = false;
 
     /* get the job data pointer */
     if (NULL == (jdata = prte_get_job_data_object(job))) {
@@ -244,24 +294,49 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
      * message the master sends at VM_READY - see prte_util_pack_job_catchup.
      */
 
-    /* Pack the job struct.
-     *
-     * Without the cpusets, if we are scattering them: this buffer is
+    PRTE_PROFILE_MARK(&mark);
+    start = buffer->bytes_used;
+
+    /* Without the cpusets, if we are scattering them: this buffer is
      * broadcast to every daemon, and a proc's binding is read only by the
      * daemon that forks it.  Each daemon's own bindings follow separately
      * from prte_odls_base_send_cpuset_slices() below. */
-    rc = prte_job_pack(buffer, jdata,
-                       prte_odls_globals.scatter_cpusets ? PRTE_JOB_PACK_NO_CPUSETS
-                                                         : PRTE_JOB_PACK_ALL);
+    mode = prte_odls_globals.scatter_cpusets ? PRTE_JOB_PACK_NO_CPUSETS : PRTE_JOB_PACK_ALL;
+
+    /* Without the apps, if the daemons already hold them: a repeat launch
+     * of what this session ran last names the launch template that was
+     * left with them then.  A template issued since the DVM last changed is
+     * one every daemon was sent; otherwise it goes out with this launch. */
+    if (prte_odls_globals.launch_templates && 0 < jdata->num_apps) {
+        rc = prte_launch_template_select(jdata, prte_grpcomm_current_epoch(),
+                                         prte_process_info.num_daemons, &tmpl, &fresh);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+        prte_set_attribute(&jdata->attributes, PRTE_JOB_LAUNCH_TEMPLATE, PRTE_ATTR_LOCAL,
+                           &tmpl->id, PMIX_UINT32);
+        mode |= PRTE_JOB_PACK_NO_APPS;
+    }
+    rc = pack_template_header(buffer, jdata, tmpl, fresh);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* Pack the job struct */
+    rc = prte_job_pack(buffer, jdata, mode);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         return rc;
     }
+    PRTE_PROFILE_STAGE("job_pack", jdata->nspace, &mark, buffer->bytes_used - start);
 
     PMIX_OUTPUT_VERBOSE((2, prte_odls_base_framework.framework_output,
-                         "%s odls:launch_msg jobdata %lu bytes (%u procs)",
+                         "%s odls:launch_msg jobdata %lu bytes (%u procs) template %u%s",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                         (unsigned long) buffer->bytes_used, jdata->num_procs));
+                         (unsigned long) buffer->bytes_used, jdata->num_procs,
+                         (NULL == tmpl) ? 0 : tmpl->id, fresh ? " (sent)" : ""));
 
     /* assemble the node and proc map info */
     list = NULL;
@@ -289,75 +364,33 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
         }
     }
 
-    /* let the PMIx server generate the nodemap regex */
+    /* let the PMIx server generate the nodemap regex - or reuse the one
+     * it generated for the last job laid out on the same nodes */
     if (NULL != list) {
         tmp = PMIx_Argv_join(list, ',');
         PMIx_Argv_free(list);
         list = NULL;
-#if PRTE_PMIX_HAVE_REGEX2
-        pmix_regex2_t nregex = PMIX_REGEX2_STATIC_INIT;
-        if (PMIX_SUCCESS != (ret = PMIx_generate_regex2(tmp, NULL, 0, &nregex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
-            if (NULL != procs) {
-                PMIx_Argv_free(procs);
-            }
-            PMIX_INFO_LIST_RELEASE(ilist);
-            return prte_pmix_convert_status(ret);
-        }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, ilist, PMIX_NODE_MAP, &nregex, PMIX_REGEX2);
-        PMIx_Regex2_destruct(&nregex);
-#else
-        if (PMIX_SUCCESS != (ret = PMIx_generate_regex(tmp, &regex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
+        rc = prte_util_regex_memo_add(&node_memo, PMIX_NODE_MAP, tmp, false, ilist);
+        if (PRTE_SUCCESS != rc) {
             if (NULL != procs) {
                 PMIx_Argv_free(procs);
             }
             PMIX_INFO_LIST_RELEASE(ilist);
-            return prte_pmix_convert_status(ret);
+            return rc;
         }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, ilist, PMIX_NODE_MAP, regex, PMIX_REGEX);
-        free(regex);
-#endif
     }
 
-    /* let the PMIx server generate the procmap regex */
+    /* likewise the procmap regex */
     if (NULL != procs) {
         tmp = PMIx_Argv_join(procs, ';');
         PMIx_Argv_free(procs);
         procs = NULL;
-#if PRTE_PMIX_HAVE_REGEX2
-        /* the proc map goes through the same generator: PMIx_generate_ppn is
-         * deprecated with no replacement, because the per-node rank mapping
-         * is now carried by an ordinary pmix_regex2_t.  The receiving side
-         * (gds/hash) splits it on ';' rather than ',' - which is a property
-         * of the string, not of the encoding */
-        pmix_regex2_t pregex = PMIX_REGEX2_STATIC_INIT;
-        if (PMIX_SUCCESS != (ret = PMIx_generate_regex2(tmp, NULL, 0, &pregex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
-            /* list and procs were already freed above */
-            PMIX_INFO_LIST_RELEASE(ilist);
-            return prte_pmix_convert_status(ret);
-        }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, ilist, PMIX_PROC_MAP, &pregex, PMIX_REGEX2);
-        PMIx_Regex2_destruct(&pregex);
-#else
-        if (PMIX_SUCCESS != (ret = PMIx_generate_ppn(tmp, &regex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
+        rc = prte_util_regex_memo_add(&proc_memo, PMIX_PROC_MAP, tmp, true, ilist);
+        if (PRTE_SUCCESS != rc) {
             /* list and procs were already freed above */
             PMIX_INFO_LIST_RELEASE(ilist);
-            return prte_pmix_convert_status(ret);
+            return rc;
         }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, ilist, PMIX_PROC_MAP, regex, PMIX_REGEX);
-        free(regex);
-#endif
     }
 
     /* add in the personality */
@@ -843,8 +876,337 @@ static bool slice_rendezvous(prte_odls_jcaddy_t *cd)
     return true;
 }
 
+/*
+ * Launches waiting for a template.
+ *
+ * A daemon is named a template it does not hold when it missed the launch
+ * that sent it, or has since been sent another for the same session - a
+ * launch parked here is the usual way for that to happen.  Either way the
+ * master still has the job the reference came with, and rebuilds the
+ * template from it.  Several launches can be waiting on one template; it is
+ * asked for once, and they go ahead in the order they arrived.
+ */
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t id;
+    pmix_nspace_t nspace;
+    /* what was left of the launch message after the header */
+    pmix_data_buffer_t *launch;
+    prte_odls_base_fork_local_proc_fn_t fork_local;
+} prte_odls_template_wait_t;
+static void twcon(prte_odls_template_wait_t *p)
+{
+    p->id = 0;
+    PMIX_LOAD_NSPACE(p->nspace, NULL);
+    p->launch = NULL;
+    p->fork_local = NULL;
+}
+static void twdes(prte_odls_template_wait_t *p)
+{
+    if (NULL != p->launch) {
+        PMIX_DATA_BUFFER_RELEASE(p->launch);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_odls_template_wait_t, pmix_list_item_t, twcon, twdes);
+
+static int construct_job(pmix_data_buffer_t *buffer, pmix_nspace_t *job,
+                         prte_odls_base_fork_local_proc_fn_t fork_local);
+static void report_launch_failure(prte_job_t *jdata, int rc);
+
+/* Read the launch template header.  On return *ready says whether the job
+ * that follows can be unpacked now; if not, the launch has been parked
+ * until the master sends the template it names. */
+static int template_rendezvous(pmix_data_buffer_t *buffer, pmix_nspace_t *job,
+                               prte_odls_base_fork_local_proc_fn_t fork_local, bool *ready)
+{
+    pmix_status_t rc;
+    int32_t cnt;
+    uint32_t id, session;
+    bool fresh, asked = false;
+    pmix_byte_object_t bo;
+    pmix_data_buffer_t *req;
+    prte_odls_template_wait_t *tw;
+
+    *ready = true;
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &id, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 == id) {
+        return PRTE_SUCCESS;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, job, &cnt, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &session, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &fresh, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+
+    if (fresh) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &bo, &cnt, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+        /* the master issued it and holds it already */
+        if (!PRTE_PROC_IS_MASTER) {
+            prte_launch_template_store(session, id, &bo);
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        return PRTE_SUCCESS;
+    }
+
+    if (NULL != prte_launch_template_lookup(id)) {
+        return PRTE_SUCCESS;
+    }
+
+    if (PRTE_PROC_IS_MASTER) {
+        /* we reach our own copy of the launch message asynchronously, so
+         * the next launch in this session may already have replaced the
+         * template.  Storing it again would throw away the one the session
+         * uses now - prte_job_unpack takes the apps from the job, which we
+         * hold in full. */
+        if (NULL == prte_get_job_data_object(*job)) {
+            PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+            return PRTE_ERR_NOT_FOUND;
+        }
+        return PRTE_SUCCESS;
+    }
+
+    /* park what is left of the message and ask for the template, unless
+     * an earlier launch already has */
+    PMIX_LIST_FOREACH(tw, &prte_odls_globals.pending_templates, prte_odls_template_wait_t)
+    {
+        if (tw->id == id) {
+            asked = true;
+            break;
+        }
+    }
+    tw = PMIX_NEW(prte_odls_template_wait_t);
+    tw->id = id;
+    PMIX_LOAD_NSPACE(tw->nspace, *job);
+    tw->fork_local = fork_local;
+    PMIX_DATA_BUFFER_CREATE(tw->launch);
+    rc = PMIx_Data_copy_payload(tw->launch, buffer);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(tw);
+        return prte_pmix_convert_status(rc);
+    }
+    pmix_list_append(&prte_odls_globals.pending_templates, &tw->super);
+    *ready = false;
+
+    PMIX_OUTPUT_VERBOSE((5, prte_odls_base_framework.framework_output,
+                         "%s odls:construct_child_list awaiting launch template %u for %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), id, PRTE_JOBID_PRINT(*job)));
+    if (asked) {
+        return PRTE_SUCCESS;
+    }
+
+    PMIX_DATA_BUFFER_CREATE(req);
+    rc = PMIx_Data_pack(NULL, req, job, 1, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, req, &id, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, req, &session, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(req);
+        pmix_list_remove_item(&prte_odls_globals.pending_templates, &tw->super);
+        PMIX_RELEASE(tw);
+        *ready = true;
+        return prte_pmix_convert_status(rc);
+    }
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, req, PRTE_RML_TAG_LAUNCH_TEMPLATE);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(req);
+        pmix_list_remove_item(&prte_odls_globals.pending_templates, &tw->super);
+        PMIX_RELEASE(tw);
+        *ready = true;
+        return rc;
+    }
+    return PRTE_SUCCESS;
+}
+
+void prte_odls_base_recv_template_request(int status, pmix_proc_t *sender,
+                                          pmix_data_buffer_t *buffer,
+                                          prte_rml_tag_t tag, void *cbdata)
+{
+    pmix_nspace_t nspace;
+    uint32_t id, session;
+    pmix_status_t rc;
+    int32_t cnt;
+    prte_job_t *jdata;
+    pmix_byte_object_t bo;
+    pmix_data_buffer_t *reply;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_PROC_NSPACE);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &id, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &session, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    /* rebuilt from the job rather than looked up: the template that was
+     * issued with it may have been replaced since.  An empty answer tells
+     * the daemon there is no such job any more. */
+    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+    jdata = prte_get_job_data_object(nspace);
+    if (NULL != jdata) {
+        if (PRTE_SUCCESS != (rc = prte_launch_template_pack_apps(jdata, &bo))) {
+            PRTE_ERROR_LOG(rc);
+            /* the daemon can only report that it launched nothing, which
+             * says nothing about the job's procs - fail the job here, once
+             * however many daemons ask */
+            if (PRTE_JOB_STATE_NEVER_LAUNCHED != jdata->state) {
+                jdata->exit_code = rc;
+                jdata->state = PRTE_JOB_STATE_NEVER_LAUNCHED;
+                PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
+            }
+        }
+    }
+
+    PMIX_DATA_BUFFER_CREATE(reply);
+    rc = PMIx_Data_pack(NULL, reply, &id, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, reply, &session, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, reply, &bo, 1, PMIX_BYTE_OBJECT);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+        return;
+    }
+    PRTE_RML_SEND(rc, sender->rank, reply, PRTE_RML_TAG_LAUNCH_TEMPLATE_RESP);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+    }
+}
+
+void prte_odls_base_recv_template(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tag, void *cbdata)
+{
+    uint32_t id, session;
+    pmix_status_t rc;
+    int32_t cnt;
+    pmix_byte_object_t bo;
+    prte_odls_template_wait_t *tw, *next;
+    pmix_nspace_t job;
+    prte_job_t *jdata;
+    bool have;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tag, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &id, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &session, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &bo, &cnt, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    have = (0 < bo.size);
+    if (have) {
+        prte_launch_template_store(session, id, &bo);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+
+    PMIX_LIST_FOREACH_SAFE(tw, next, &prte_odls_globals.pending_templates,
+                           prte_odls_template_wait_t)
+    {
+        if (tw->id != id) {
+            continue;
+        }
+        pmix_list_remove_item(&prte_odls_globals.pending_templates, &tw->super);
+        if (have) {
+            rc = construct_job(tw->launch, &job, tw->fork_local);
+            if (PRTE_SUCCESS != rc) {
+                /* construct_job has reported the failed launch */
+                PRTE_ERROR_LOG(rc);
+            }
+        } else {
+            /* we cannot unpack the job without its apps, so all we can
+             * fail is what we already hold of it - report it all the same,
+             * so the launch does not just vanish */
+            pmix_output_verbose(2, prte_odls_base_framework.framework_output,
+                                "%s odls: no launch template %u for %s - failing its launch",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), id,
+                                PRTE_JOBID_PRINT(tw->nspace));
+            jdata = prte_get_job_data_object(tw->nspace);
+            if (NULL == jdata) {
+                jdata = PMIX_NEW(prte_job_t);
+                PMIX_LOAD_NSPACE(jdata->nspace, tw->nspace);
+                prte_set_job_data_object(jdata);
+            }
+            jdata->exit_code = PRTE_ERR_NOT_FOUND;
+            slice_discard(jdata->nspace);
+            report_launch_failure(jdata, PRTE_ERR_NOT_FOUND);
+        }
+        PMIX_RELEASE(tw);
+    }
+}
+
 int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix_nspace_t *job,
                                                 prte_odls_base_fork_local_proc_fn_t fork_local)
+{
+    int rc;
+    bool ready;
+
+    /* set a default response */
+    PMIX_LOAD_NSPACE(*job, NULL);
+
+    rc = template_rendezvous(buffer, job, fork_local, &ready);
+    if (PRTE_SUCCESS != rc) {
+        /* as for any launch we could not read - see construct_job */
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_NEVER_LAUNCHED);
+        return rc;
+    }
+    if (!ready) {
+        /* parked - prte_odls_base_recv_template takes it from here */
+        return PRTE_SUCCESS;
+    }
+    return construct_job(buffer, job, fork_local);
+}
+
+static int construct_job(pmix_data_buffer_t *buffer, pmix_nspace_t *job,
+                         prte_odls_base_fork_local_proc_fn_t fork_local)
 {
     int rc;
     int32_t cnt;
@@ -1124,7 +1486,7 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
      * procs, which has nothing to bind and nothing to wait for.  Anything
      * parked for such a daemon is a slice for a job it will not launch;
      * drop it rather than leave it on the list. */
-    if (PRTE_JOB_PACK_NO_CPUSETS == mode && !PRTE_PROC_IS_MASTER) {
+    if ((PRTE_JOB_PACK_NO_CPUSETS & mode) && !PRTE_PROC_IS_MASTER) {
         if (0 < jdata->num_local_procs) {
             if (!slice_rendezvous(cd)) {
                 /* parked - the slice's receiver takes it from here, and
@@ -1147,10 +1509,19 @@ REPORT_ERROR:
         /* nobody is going to collect a slice for a job we are failing */
         slice_discard(jdata->nspace);
     }
+    /* never one of the prior jobs decoded above - they use their own variable */
+    report_launch_failure(jdata, rc);
+    return rc;
+}
+
+static void report_launch_failure(prte_job_t *jdata, int rc)
+{
+    prte_proc_t *pptr;
+    int32_t n;
+
     /* NB: "jdata" is either NULL (we failed before unpacking the job we
-     * were told to launch) or that job - never one of the prior jobs
-     * decoded above, which use their own variable. A NULL here is
-     * survivable: the prted errmgr falls back to the daemon job. */
+     * were told to launch) or that job. A NULL here is survivable: the
+     * prted errmgr falls back to the daemon job. */
     /* We have to report an error back to the HNP so we don't just hang.
      * Activating the job state is not enough on its own: what the errmgr
      * sends the HNP is the state of this daemon's local children of that
@@ -1190,7 +1561,6 @@ REPORT_ERROR:
         jdata->num_local_procs = nlocal;
     }
     PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
-    return rc;
 }
 
 static int setup_path(prte_job_t *job, prte_app_context_t *app, char **wdir)
@@ -1327,6 +1697,118 @@ static int compute_num_procs_alive(pmix_nspace_t job)
     return num_procs_alive;
 }
 
+/* length of the NAME part of a "NAME=value" entry */
+static size_t env_namelen(const char *entry)
+{
+    const char *eq = strchr(entry, '=');
+
+    return (NULL == eq) ? strlen(entry) : (size_t) (eq - entry);
+}
+
+static int env_namecmp(const char *a, const char *b)
+{
+    size_t alen = env_namelen(a), blen = env_namelen(b);
+    int rc;
+
+    rc = strncmp(a, b, (alen < blen) ? alen : blen);
+    if (0 != rc) {
+        return rc;
+    }
+    return (alen < blen) ? -1 : (alen > blen);
+}
+
+static int env_byname(const void *a, const void *b)
+{
+    return env_namecmp(*(char *const *) a, *(char *const *) b);
+}
+
+static bool env_template_sets(prte_odls_env_template_t *tmpl, const char *entry)
+{
+    int lo = 0, hi = tmpl->count - 1, mid, rc;
+
+    while (lo <= hi) {
+        mid = lo + (hi - lo) / 2;
+        rc = env_namecmp(entry, tmpl->byname[mid]);
+        if (0 == rc) {
+            return true;
+        }
+        if (rc < 0) {
+            hi = mid - 1;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return false;
+}
+
+prte_odls_env_template_t *prte_odls_base_env_template(char **env)
+{
+    prte_odls_env_template_t *tmpl;
+    size_t total = 0, len;
+    char *ptr;
+    int n, count;
+
+    count = PMIx_Argv_count(env);
+    for (n = 0; n < count; n++) {
+        total += strlen(env[n]) + 1;
+    }
+
+    tmpl = PMIX_NEW(prte_odls_env_template_t);
+    tmpl->block = (char *) malloc((0 < total) ? total : 1);
+    tmpl->envp = (char **) malloc((count + 1) * sizeof(char *));
+    tmpl->byname = (char **) malloc((count + 1) * sizeof(char *));
+    if (NULL == tmpl->block || NULL == tmpl->envp || NULL == tmpl->byname) {
+        PMIX_RELEASE(tmpl);
+        return NULL;
+    }
+
+    ptr = tmpl->block;
+    for (n = 0; n < count; n++) {
+        len = strlen(env[n]) + 1;
+        memcpy(ptr, env[n], len);
+        tmpl->envp[n] = ptr;
+        tmpl->byname[n] = ptr;
+        ptr += len;
+    }
+    tmpl->envp[count] = NULL;
+    tmpl->byname[count] = NULL;
+    qsort(tmpl->byname, count, sizeof(char *), env_byname);
+    tmpl->count = count;
+    return tmpl;
+}
+
+bool prte_odls_base_env_compose(prte_odls_spawn_caddy_t *cd, char **overlay)
+{
+    prte_odls_env_template_t *tmpl = cd->env_template;
+    char **envp;
+    int n, nover;
+
+    if (NULL == tmpl || NULL != cd->env) {
+        return false;
+    }
+    nover = PMIx_Argv_count(overlay);
+    for (n = 0; n < nover; n++) {
+        if (env_template_sets(tmpl, overlay[n])) {
+            return false;
+        }
+    }
+
+    envp = (char **) malloc((tmpl->count + nover + 1) * sizeof(char *));
+    if (NULL == envp) {
+        return false;
+    }
+    memcpy(envp, tmpl->envp, tmpl->count * sizeof(char *));
+    if (0 < nover) {
+        memcpy(envp + tmpl->count, overlay, nover * sizeof(char *));
+    }
+    envp[tmpl->count + nover] = NULL;
+
+    cd->env = envp;
+    cd->env_overlay = overlay;
+    cd->env_shared = true;
+    return true;
+}
+
 void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
 {
     prte_odls_spawn_caddy_t *cd = (prte_odls_spawn_caddy_t *) cbdata;
@@ -1339,7 +1821,7 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
     prte_proc_state_t state;
     pmix_proc_t pproc;
     pmix_status_t ret;
-    char *ptr;
+    char *ptr, **overlay;
     pmix_value_t pidval = PMIX_VALUE_STATIC_INIT;
 
     PRTE_HIDE_UNUSED_PARAMS(fd, sd);
@@ -1365,14 +1847,36 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
     child->exit_code = 0;
     PRTE_FLAG_UNSET(child, PRTE_PROC_FLAG_WAITPID);
 
-    /* setup the pmix environment */
-    cd->env = PMIx_Argv_copy(app->env);
+    /* setup the pmix environment. Copying the app's environment for every
+     * child costs a strdup per variable per child, so where the launch
+     * built a shared template we collect only what PMIx adds for this rank
+     * and lay it over the template. If PMIx touches a variable the app
+     * already sets, we cannot tell whether it meant to replace it, so that
+     * child is set up the long way instead. */
     PMIX_LOAD_PROCID(&pproc, child->name.nspace, child->name.rank);
-    if (PMIX_SUCCESS != (ret = PMIx_server_setup_fork(&pproc, &cd->env))) {
-        PMIX_ERROR_LOG(ret);
-        rc = PRTE_ERROR;
-        state = PRTE_PROC_STATE_FAILED_TO_LAUNCH;
-        goto errorout;
+    if (NULL != cd->env_template) {
+        overlay = NULL;
+        if (PMIX_SUCCESS != (ret = PMIx_server_setup_fork(&pproc, &overlay))) {
+            PMIX_ERROR_LOG(ret);
+            if (NULL != overlay) {
+                PMIx_Argv_free(overlay);
+            }
+            rc = PRTE_ERROR;
+            state = PRTE_PROC_STATE_FAILED_TO_LAUNCH;
+            goto errorout;
+        }
+        if (!prte_odls_base_env_compose(cd, overlay) && NULL != overlay) {
+            PMIx_Argv_free(overlay);
+        }
+    }
+    if (NULL == cd->env) {
+        cd->env = PMIx_Argv_copy(app->env);
+        if (PMIX_SUCCESS != (ret = PMIx_server_setup_fork(&pproc, &cd->env))) {
+            PMIX_ERROR_LOG(ret);
+            rc = PRTE_ERROR;
+            state = PRTE_PROC_STATE_FAILED_TO_LAUNCH;
+            goto errorout;
+        }
     }
 
     /* if we are not forwarding output for this job, then
@@ -1753,6 +2257,7 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
     bool index_argv;
     char *msg, **xfer;
     prte_odls_spawn_caddy_t *cd;
+    prte_odls_env_template_t *envt = NULL;
     prte_event_base_t *evb;
     prte_schizo_base_module_t *schizo;
     PRTE_HIDE_UNUSED_PARAMS(fd, sd);
@@ -1969,6 +2474,10 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             goto GETOUT;
         }
 
+        /* app->env is final for this launch - flatten it once, so each
+         * child's environment can share it rather than copy it */
+        envt = prte_odls_base_env_template(app->env);
+
         /* okay, now let's launch all the local procs for this app using the provided fork_local fn
          */
         for (idx = 0; idx < prte_local_children->size; idx++) {
@@ -2052,6 +2561,10 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             cd->child = child;
             cd->fork_local = fork_local;
             cd->index_argv = index_argv;
+            if (NULL != envt) {
+                PMIX_RETAIN(envt);
+                cd->env_template = envt;
+            }
             /* setup any IOF */
             cd->opts.usepty = PRTE_ENABLE_PTY_SUPPORT;
 
@@ -2104,11 +2617,19 @@ void prte_odls_base_default_launch_local(int fd, short sd, void *cbdata)
             prte_event_set(evb, &cd->ev, -1, PRTE_EV_WRITE, prte_odls_base_spawn_proc, cd);
             prte_event_active(&cd->ev, PRTE_EV_WRITE, 1);
         }
+        /* the caddies hold their own references */
+        if (NULL != envt) {
+            PMIX_RELEASE(envt);
+            envt = NULL;
+        }
     }
 
 GETOUT:
 
 ERROR_OUT:
+    if (NULL != envt) {
+        PMIX_RELEASE(envt);
+    }
     /* ensure we reset our working directory back to our default location  */
     if (0 != chdir(basedir)) {
         PRTE_ERROR_LOG(PRTE_ERROR);
@@ -2211,6 +2732,8 @@ void prte_odls_base_default_wait_local_proc(int fd, short sd, void *cbdata)
     prte_proc_state_t state = PRTE_PROC_STATE_WAITPID_FIRED;
     prte_proc_t *cptr;
     bool flag = false;
+    struct timeval cpu, *cpuptr = &cpu;
+    uint64_t maxrss, *rssptr = &maxrss;
     PRTE_HIDE_UNUSED_PARAMS(fd, sd);
 
     PMIX_ACQUIRE_OBJECT(t2);
@@ -2219,6 +2742,14 @@ void prte_odls_base_default_wait_local_proc(int fd, short sd, void *cbdata)
                         "%s odls:wait_local_proc child process %s pid %ld terminated",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&proc->name),
                         (long) proc->pid);
+    /* what it used, if the reaper had its rusage */
+    if (prte_get_attribute(&proc->attributes, PRTE_PROC_CPU_TIME, (void **) &cpuptr, PMIX_TIMEVAL)
+        && prte_get_attribute(&proc->attributes, PRTE_PROC_MAX_RSS, (void **) &rssptr, PMIX_UINT64)) {
+        pmix_output_verbose(5, prte_odls_base_framework.framework_output,
+                            "%s odls:wait_local_proc child %s used %ld.%06lds cpu, max rss %lu KB",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&proc->name),
+                            (long) cpu.tv_sec, (long) cpu.tv_usec, (unsigned long) maxrss);
+    }
 
     /* if the child was previously flagged as dead, then just
      * update its exit status and
@@ -74,7 +74,9 @@ prte_odls_globals_t prte_odls_globals = {
     .signal_direct_children_only = false,
     .exec_agent = NULL,
     .scatter_cpusets = true,
-    .pending_slices = PMIX_LIST_STATIC_INIT
+    .pending_slices = PMIX_LIST_STATIC_INIT,
+    .launch_templates = true,
+    .pending_templates = PMIX_LIST_STATIC_INIT
 };
 
 static int prte_odls_base_register(pmix_mca_base_register_flag_t flags)
@@ -101,6 +103,14 @@ static int prte_odls_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &prte_odls_globals.scatter_cpusets);
 
+    prte_odls_globals.launch_templates = true;
+    (void) pmix_mca_base_var_register("prte", "odls", "base", "launch_templates",
+                                      "Leave each launch's app contexts at the daemons, and send "
+                                      "a repeat launch of the same apps in the same session as a "
+                                      "reference to them rather than in full",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_odls_globals.launch_templates);
+
     /* A fault-injection hook, in the same spirit as prte_daemon_fail.  The
      * daemon forks its children on a worker thread and records each child's
      * pid there, while the SIGCHLD reaper runs on the progress thread and
@@ -143,6 +153,7 @@ static int prte_odls_base_close(void)
     /* anything still here is a launch that never completed, or a slice for
      * one - PMIX_DESTRUCT would leave the items themselves behind */
     PMIX_LIST_DESTRUCT(&prte_odls_globals.pending_slices);
+    PMIX_LIST_DESTRUCT(&prte_odls_globals.pending_templates);
 
     /* cleanup the global list of local children and job data */
     for (i = 0; i < prte_local_children->size; i++) {
@@ -178,6 +189,7 @@ static int prte_odls_base_open(pmix_mca_base_open_flag_t flags)
     /* initialize ODLS globals */
     PMIX_CONSTRUCT(&prte_odls_globals.xterm_ranks, pmix_list_t);
     PMIX_CONSTRUCT(&prte_odls_globals.pending_slices, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_odls_globals.pending_templates, pmix_list_t);
     prte_odls_globals.xtermcmd = NULL;
 
     /* ensure that SIGCHLD is unblocked as we need to capture it */
@@ -272,6 +284,9 @@ static void sccon(prte_odls_spawn_caddy_t *p)
     p->wdir = NULL;
     p->argv = NULL;
     p->env = NULL;
+    p->env_template = NULL;
+    p->env_overlay = NULL;
+    p->env_shared = false;
     p->bind_cpuset = NULL;
     p->bind_fatal = false;
     p->do_membind = false;
@@ -295,9 +310,18 @@ static void scdes(prte_odls_spawn_caddy_t *p)
     if (NULL != p->argv) {
         PMIx_Argv_free(p->argv);
     }
-    if (NULL != p->env) {
+    if (p->env_shared) {
+        /* the strings belong to the template and the overlay */
+        free(p->env);
+        if (NULL != p->env_overlay) {
+            PMIx_Argv_free(p->env_overlay);
+        }
+    } else if (NULL != p->env) {
         PMIx_Argv_free(p->env);
     }
+    if (NULL != p->env_template) {
+        PMIX_RELEASE(p->env_template);
+    }
     if (NULL != p->bind_cpuset) {
         hwloc_bitmap_free(p->bind_cpuset);
     }
@@ -313,3 +337,26 @@ static void scdes(prte_odls_spawn_caddy_t *p)
 PMIX_CLASS_INSTANCE(prte_odls_spawn_caddy_t,
                     pmix_object_t,
                     sccon, scdes);
+
+static void etcon(prte_odls_env_template_t *p)
+{
+    p->block = NULL;
+    p->envp = NULL;
+    p->byname = NULL;
+    p->count = 0;
+}
+static void etdes(prte_odls_env_template_t *p)
+{
+    if (NULL != p->block) {
+        free(p->block);
+    }
+    if (NULL != p->envp) {
+        free(p->envp);
+    }
+    if (NULL != p->byname) {
+        free(p->byname);
+    }
+}
+PMIX_CLASS_INSTANCE(prte_odls_env_template_t,
+                    pmix_object_t,
+                    etcon, etdes);
@@ -90,6 +90,10 @@ typedef uint8_t prte_daemon_cmd_flag_t;
 
 #define PRTE_DAEMON_SHRINK_CMD (prte_daemon_cmd_flag_t) 35
 
+/* the launch messages of several jobs submitted as one batch spawn, each
+ * an ADD_LOCAL_PROCS/DVM_ADD_PROCS command of its own */
+#define PRTE_DAEMON_ADD_PROCS_BATCH (prte_daemon_cmd_flag_t) 36
+
 /*
  * Identifies which point in the child's setup/exec sequence failed. The
  * child code that runs between fork() and execve() must be
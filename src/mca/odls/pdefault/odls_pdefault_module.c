@@ -699,6 +699,10 @@ static int fork_local_proc(void *cdptr)
         continue;
     }
     close(gate[1]);
+    if (NULL != child) {
+        /* now there is a pid to watch */
+        prte_wait_watch(child);
+    }
 
     close(p[1]);
     return do_parent(cd, p[0]);
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <limits.h>
+
+#include "src/class/pmix_list.h"
+#include "src/class/pmix_pointer_array.h"
+#include "src/event/event-internal.h"
+#include "src/grpcomm/grpcomm.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/odls/odls_types.h"
+#include "src/mca/state/state.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/rml/rml_types.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/attr.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/plm/base/base.h"
+#include "src/mca/plm/base/plm_private.h"
+
+/* The launch messages of one batch spawn, gathered until the last of its
+ * jobs has been mapped. A batch is identified by the daemon that relayed
+ * the request and the room number that request holds there - the same
+ * pair the spawn response is addressed to. */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t requestor;
+    int room;
+    uint32_t expected;
+    /* the held jobs, each retained */
+    pmix_pointer_array_t jobs;
+    uint32_t nheld;
+    prte_event_t timer;
+    bool timer_active;
+} prte_plm_batch_t;
+
+static void bcon(prte_plm_batch_t *p)
+{
+    PMIX_LOAD_PROCID(&p->requestor, NULL, PMIX_RANK_INVALID);
+    p->room = -1;
+    p->expected = 0;
+    PMIX_CONSTRUCT(&p->jobs, pmix_pointer_array_t);
+    pmix_pointer_array_init(&p->jobs, 8, INT_MAX, 8);
+    p->nheld = 0;
+    p->timer_active = false;
+}
+static void bdes(prte_plm_batch_t *p)
+{
+    prte_job_t *jdata;
+    int n;
+
+    if (p->timer_active) {
+        prte_event_evtimer_del(&p->timer);
+    }
+    for (n = 0; n < p->jobs.size; n++) {
+        jdata = (prte_job_t *) pmix_pointer_array_get_item(&p->jobs, n);
+        if (NULL != jdata) {
+            PMIX_RELEASE(jdata);
+        }
+    }
+    PMIX_DESTRUCT(&p->jobs);
+}
+static PMIX_CLASS_INSTANCE(prte_plm_batch_t, pmix_list_item_t, bcon, bdes);
+
+prte_plm_base_batch_send_fn_t prte_plm_base_batch_send = prte_grpcomm_xcast;
+
+static void flush(prte_plm_batch_t *b)
+{
+    pmix_data_buffer_t msg;
+    prte_daemon_cmd_flag_t command = PRTE_DAEMON_ADD_PROCS_BATCH;
+    pmix_byte_object_t bo;
+    prte_job_t *jdata;
+    int32_t njobs;
+    int n, rc;
+
+    pmix_list_remove_item(&prte_plm_globals.batches, &b->super);
+    if (b->timer_active) {
+        prte_event_evtimer_del(&b->timer);
+        b->timer_active = false;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:batch sending %u of %u jobs for room %d of %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), b->nheld, b->expected,
+                         b->room, PRTE_NAME_PRINT(&b->requestor)));
+
+    /* each job's launch message goes in whole, so a daemon handles it
+     * exactly as it would had it arrived on its own */
+    PMIX_DATA_BUFFER_CONSTRUCT(&msg);
+    rc = PMIx_Data_pack(NULL, &msg, &command, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS == rc) {
+        njobs = b->nheld;
+        rc = PMIx_Data_pack(NULL, &msg, &njobs, 1, PMIX_INT32);
+    }
+    for (n = 0; PMIX_SUCCESS == rc && n < b->jobs.size; n++) {
+        jdata = (prte_job_t *) pmix_pointer_array_get_item(&b->jobs, n);
+        if (NULL == jdata) {
+            continue;
+        }
+        bo.bytes = jdata->launch_msg.base_ptr;
+        bo.size = jdata->launch_msg.bytes_used;
+        rc = PMIx_Data_pack(NULL, &msg, &bo, 1, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    } else if (PRTE_SUCCESS != (rc = prte_plm_base_batch_send(PRTE_RML_TAG_DAEMON_LAUNCH, &msg))) {
+        PRTE_ERROR_LOG(rc);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&msg);
+
+    for (n = 0; n < b->jobs.size; n++) {
+        jdata = (prte_job_t *) pmix_pointer_array_get_item(&b->jobs, n);
+        if (NULL == jdata) {
+            continue;
+        }
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_NEVER_LAUNCHED);
+            continue;
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&jdata->launch_msg);
+        PMIX_DATA_BUFFER_CONSTRUCT(&jdata->launch_msg);
+        /* as in send_launch_msg: we count as having reported */
+        jdata->num_daemons_reported++;
+    }
+
+    PMIX_RELEASE(b);
+}
+
+/* A member of the batch never got this far - its request was refused,
+ * or it could not be mapped - so stop waiting for it and send the rest */
+static void window_expired(int fd, short args, void *cbdata)
+{
+    prte_plm_batch_t *b = (prte_plm_batch_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    b->timer_active = false;
+    flush(b);
+}
+
+bool prte_plm_base_batch_hold(prte_job_t *jdata)
+{
+    prte_plm_batch_t *b, *bptr = NULL;
+    uint32_t bsize, *bsptr = &bsize;
+    int room, *rptr = &room;
+    struct timeval tv;
+
+    if (0 >= prte_plm_globals.batch_window) {
+        return false;
+    }
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_BATCH_SIZE,
+                            (void **) &bsptr, PMIX_UINT32) || 2 > bsize) {
+        return false;
+    }
+    if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_ROOM_NUM,
+                            (void **) &rptr, PMIX_INT)) {
+        return false;
+    }
+
+    PMIX_LIST_FOREACH(b, &prte_plm_globals.batches, prte_plm_batch_t) {
+        if (b->room == room && PMIX_CHECK_PROCID(&b->requestor, &jdata->originator)) {
+            bptr = b;
+            break;
+        }
+    }
+    if (NULL == bptr) {
+        bptr = PMIX_NEW(prte_plm_batch_t);
+        PMIX_XFER_PROCID(&bptr->requestor, &jdata->originator);
+        bptr->room = room;
+        bptr->expected = bsize;
+        pmix_list_append(&prte_plm_globals.batches, &bptr->super);
+        tv.tv_sec = prte_plm_globals.batch_window / 1000;
+        tv.tv_usec = (prte_plm_globals.batch_window % 1000) * 1000;
+        prte_event_evtimer_set(prte_event_base, &bptr->timer, window_expired, bptr);
+        prte_event_evtimer_add(&bptr->timer, &tv);
+        bptr->timer_active = true;
+    }
+
+    PMIX_RETAIN(jdata);
+    pmix_pointer_array_add(&bptr->jobs, jdata);
+    bptr->nheld++;
+
+    PMIX_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                         "%s plm:base:batch holding job %s (%u of %u)",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                         bptr->nheld, bptr->expected));
+
+    if (bptr->nheld >= bptr->expected) {
+        flush(bptr);
+    }
+    return true;
+}
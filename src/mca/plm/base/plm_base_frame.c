@@ -57,7 +57,9 @@ prte_plm_globals_t prte_plm_globals = {
     .base_nspace = NULL,
     .next_jobid = 0,
     .daemon_nodes_assigned_at_launch = true,
-    .pass_environ_mca_params = true
+    .pass_environ_mca_params = true,
+    .batch_window = 100,
+    .batches = PMIX_LIST_STATIC_INIT
 };
 
 /*
@@ -114,6 +116,15 @@ static int mca_plm_base_register(pmix_mca_base_register_flag_t flags)
      This is why we tolerate this abstraction break up here in the
      PLM component base. */
     (void) pmix_mca_base_alias_register("prte", "plm", "ssh", "rsh", PMIX_MCA_BASE_ALIAS_FLAG_NONE);
+
+    prte_plm_globals.batch_window = 100;
+    (void) pmix_mca_base_var_register("prte", "plm", "base", "batch_window",
+                                      "Longest time (in msec) the launch of a job submitted as "
+                                      "part of a batch spawn is held back waiting for the rest "
+                                      "of its batch, so that all of them go to the daemons in "
+                                      "one message (0 = never hold)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_plm_globals.batch_window);
     return PRTE_SUCCESS;
 }
 
@@ -134,6 +145,9 @@ static int prte_plm_base_close(void)
         }
     }
 
+    /* whatever is still held is not going to be launched now */
+    PMIX_LIST_DESTRUCT(&prte_plm_globals.batches);
+
     if (NULL != prte_plm_globals.base_nspace) {
         free(prte_plm_globals.base_nspace);
         /* the tool-attach path in plm_base_receive reads this to mint a
@@ -156,6 +170,8 @@ static int prte_plm_base_open(pmix_mca_base_open_flag_t flags)
     /* default to assigning daemons to nodes at launch */
     prte_plm_globals.daemon_nodes_assigned_at_launch = true;
 
+    PMIX_CONSTRUCT(&prte_plm_globals.batches, pmix_list_t);
+
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&prte_plm_base_framework, flags);
 }
@@ -73,6 +73,8 @@
 #include "src/util/nidmap.h"
 #include "src/util/pmix_printf.h"
 #include "src/util/proc_info.h"
+#include "src/util/prte_compress.h"
+#include "src/util/prte_profile.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/session_dir.h"
 #include "src/util/pmix_show_help.h"
@@ -818,8 +820,10 @@ void prte_plm_base_setup_job(int fd, short args, void *cbdata)
     }
 
     // if we are not going to launch this job, then ensure we output something - otherwise,
-    // we will simply silently exit
+    // we will simply silently exit. A stage report is output enough, and printing
+    // a 100k-node map would swamp the stages being measured
     if (prte_get_attribute(&caddy->jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL) &&
+        !prte_profile_enabled &&
         !prte_get_attribute(&caddy->jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PMIX_BOOL) &&
         !prte_get_attribute(&caddy->jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL) &&
         !prte_get_attribute(&caddy->jdata->attributes, PRTE_JOB_REPORT_BINDINGS, NULL, PMIX_BOOL)) {
@@ -1005,6 +1009,13 @@ void prte_plm_base_send_launch_msg(int fd, short args, void *cbdata)
         }
     }
 
+    /* one of a batch spawn: its launch message goes out together with
+     * those of the rest of the batch, in a single xcast */
+    if (prte_plm_base_batch_hold(jdata)) {
+        PMIX_RELEASE(caddy);
+        return;
+    }
+
     /* Goes to all daemons, on the launch message's own tag rather than the
      * general daemon-command tag. This is the one large broadcast PRRTE makes
      * on a regular basis, and naming it is what lets grpcomm move it by what
@@ -1612,7 +1623,7 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
     char *alias;
     char *nodename = NULL;
     pmix_byte_object_t pbo, bo;
-    bool compressed;
+    prte_compress_codec_t codec;
     pmix_data_buffer_t datbuf, *data;
     pmix_topology_t ptopo;
     pmix_value_t cnctinfo;
@@ -1667,6 +1678,8 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
             ++prte_process_info.num_daemons;
         }
         daemon->state = PRTE_PROC_STATE_RUNNING;
+        /* whatever node map it held before, it holds none now */
+        prte_util_nidmap_forget(dname.rank);
         /* record that this daemon is alive */
         PRTE_FLAG_SET(daemon, PRTE_PROC_FLAG_ALIVE);
         /* unload its contact info */
@@ -1805,9 +1818,9 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
         if (!prte_homo_nodes || 1 == daemon->name.rank) {
             /* unpack the topology for that node */
             PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
-            /* unpack the flag to see if this payload is compressed */
+            /* unpack the codec this payload was compressed with, if any */
             idx = 1;
-            ret = PMIx_Data_unpack(NULL, buffer, &compressed, &idx, PMIX_BOOL);
+            ret = PMIx_Data_unpack(NULL, buffer, &codec, &idx, PRTE_COMPRESS_CODEC_T);
             if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
                 prted_failed_launch = true;
@@ -1821,10 +1834,10 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
                 prted_failed_launch = true;
                 goto CLEANUP;
             }
-            if (compressed) {
+            if (PRTE_COMPRESS_NONE != codec) {
                 /* decompress the data */
-                if (PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size,
-                                         (uint8_t **) &bo.bytes, &bo.size)) {
+                if (prte_decompress(codec, (uint8_t *) pbo.bytes, pbo.size,
+                                    (uint8_t **) &bo.bytes, &bo.size)) {
                     /* the data has been uncompressed */
                     ret = PMIx_Data_load(&datbuf, &bo);
                     PMIX_BYTE_OBJECT_DESTRUCT(&bo);
@@ -1836,7 +1849,8 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
                     }
                 } else {
                     prte_show_help("help-prte-runtime.txt", "failed-to-uncompress",
-                                   true, prte_process_info.nodename);
+                                   true, prte_process_info.nodename,
+                                   prte_compress_codec_name(codec));
                     prted_failed_launch = true;
                     PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
                     PMIX_BYTE_OBJECT_DESTRUCT(&bo);
@@ -2191,6 +2205,15 @@ int prte_plm_base_prted_append_basic_args(int *argc, char ***argv, char *ess, in
         pmix_argv_append(argc, argv, "1");
     }
 
+    /* Tell the daemon to send its startup phases. A daemon never writes
+     * the report itself, so it is only told "yes" - never the destination,
+     * which may be a file on the HNP's node or --report-startup's "-" */
+    if (prte_profile_startup_enabled) {
+        pmix_argv_append(argc, argv, "--prtemca");
+        pmix_argv_append(argc, argv, "prte_startup_report");
+        pmix_argv_append(argc, argv, "1");
+    }
+
     /* if --xterm was specified, pass that along */
     if (NULL != prte_xterm) {
         pmix_argv_append(argc, argv, "--prtemca");
@@ -3357,6 +3380,9 @@ void prte_plm_base_reset_dvm_node(prte_node_t *node)
     if (NULL == daemons || NULL == daemons->map) {
         return;
     }
+    /* the node's daemon is going, whether or not the map still held the
+     * node - the cached set of daemons names it */
+    prte_job_map_daemons_stale(daemons->map);
     for (i = 0; i < daemons->map->nodes->size; i++) {
         nptr = (prte_node_t *) pmix_pointer_array_get_item(daemons->map->nodes, i);
         if (nptr != node) {
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/mca/plm/base/plm_private.h"
+
+/* smoothed latency past this multiple of the best seen means the far side
+ * is queueing our launches rather than absorbing them */
+#define PRTE_LAUNCH_WINDOW_CONGESTED 2.0
+/* weight of each new sample in the smoothed latency */
+#define PRTE_LAUNCH_WINDOW_GAIN 0.25
+
+void prte_plm_base_launch_window_init(prte_plm_base_launch_window_t *w,
+                                      int initial, int ceiling)
+{
+    memset(w, 0, sizeof(*w));
+    w->ceiling = (1 > ceiling) ? 1 : ceiling;
+    if (1 > initial) {
+        initial = 1;
+    } else if (w->ceiling < initial) {
+        initial = w->ceiling;
+    }
+    w->window = initial;
+    w->peak = initial;
+    w->slow_start = true;
+}
+
+void prte_plm_base_launch_window_sample(prte_plm_base_launch_window_t *w,
+                                        uint64_t latency_us)
+{
+    double lat = (double) latency_us;
+
+    w->nsamples++;
+    w->total_us += latency_us;
+    if (latency_us > w->max_us) {
+        w->max_us = latency_us;
+    }
+    if (1 == w->nsamples || lat < w->base_us) {
+        w->base_us = lat;
+    }
+    if (1 == w->nsamples) {
+        w->ewma_us = lat;
+    } else {
+        w->ewma_us += PRTE_LAUNCH_WINDOW_GAIN * (lat - w->ewma_us);
+    }
+    w->since_cut++;
+
+    if (w->ewma_us > PRTE_LAUNCH_WINDOW_CONGESTED * w->base_us) {
+        /* the launches that were already in flight when we last cut were
+         * forked against the old window - let them drain before judging
+         * the new one */
+        if (w->since_cut >= w->window) {
+            w->window = (1 < w->window / 2) ? w->window / 2 : 1;
+            w->slow_start = false;
+            w->since_cut = 0;
+            w->acked = 0;
+        }
+        return;
+    }
+
+    if (w->slow_start) {
+        w->window++;
+    } else if (++w->acked >= w->window) {
+        w->window++;
+        w->acked = 0;
+    }
+    if (w->window > w->ceiling) {
+        w->window = w->ceiling;
+    }
+    if (w->window > w->peak) {
+        w->peak = w->window;
+    }
+}
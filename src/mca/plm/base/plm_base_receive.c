@@ -38,6 +38,7 @@
 #    include <sys/time.h>
 #endif
 
+#include "src/class/pmix_bitmap.h"
 #include "src/mca/mca.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/pmix_argv.h"
@@ -57,6 +58,7 @@
 #include "src/util/name_fns.h"
 #include "src/util/proc_info.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/prte_profile.h"
 #include "src/util/prte_show_help.h"
 #include "types.h"
 
@@ -69,6 +71,48 @@
 
 static bool recv_issued = false;
 
+/* the daemons whose startup phase table has arrived */
+static pmix_bitmap_t startup_reported = {.super = PMIX_OBJ_STATIC_INIT(pmix_bitmap_t)};
+
+/* a daemon's startup phase table - see src/util/prte_profile.h. The HNP
+ * added its own when prte_init returned, so once every live daemon of the
+ * daemon job has reported, the DVM is in. A count would not do: a DVM that
+ * grows reports again, and by then a daemon that died - or came back and
+ * reported twice - has thrown it off for good. */
+static void startup_profile_recv(int status, pmix_proc_t *sender,
+                                 pmix_data_buffer_t *buffer,
+                                 prte_rml_tag_t tag, void *cbdata)
+{
+    prte_job_t *daemons;
+    prte_proc_t *dmn;
+    int n;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    if (pmix_bitmap_is_set_bit(&startup_reported, (int) sender->rank)) {
+        /* a daemon that restarted - its first table is the one counted */
+        return;
+    }
+    pmix_bitmap_set_bit(&startup_reported, (int) sender->rank);
+    prte_profile_startup_add(sender->rank, prte_get_proc_hostname(sender), buffer);
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    if (NULL == daemons) {
+        return;
+    }
+    for (n = 0; n < daemons->procs->size; n++) {
+        dmn = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, n);
+        if (NULL == dmn || PRTE_PROC_MY_NAME->rank == dmn->name.rank ||
+            PRTE_PROC_STATE_UNTERMINATED < dmn->state) {
+            /* ourselves, or a daemon that will never report */
+            continue;
+        }
+        if (!pmix_bitmap_is_set_bit(&startup_reported, (int) dmn->name.rank)) {
+            return;
+        }
+    }
+    prte_profile_startup_summary();
+}
+
 /* The writers for the PRTE_PLM_UPDATE_PROC_STATE body.  They sit here, in
  * the same file as prte_plm_base_recv() which is their only reader, because
  * the wire has no format version: the pair has to change together, and one
@@ -253,6 +297,10 @@ int prte_plm_base_comm_start(void)
                       PRTE_RML_PERSISTENT, prte_plm_base_daemon_failed, NULL);
         PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STACK_TRACE,
                       PRTE_RML_PERSISTENT, prte_plm_base_stack_trace_recv, NULL);
+        if (prte_profile_startup_enabled) {
+            PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STARTUP_PROFILE,
+                          PRTE_RML_PERSISTENT, startup_profile_recv, NULL);
+        }
     }
     recv_issued = true;
 
@@ -273,6 +321,8 @@ int prte_plm_base_comm_stop(void)
         PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_PRTED_CALLBACK);
         PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_REPORT_REMOTE_LAUNCH);
         PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STACK_TRACE);
+        PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_STARTUP_PROFILE);
+        PMIX_DESTRUCT(&startup_reported);
     }
     recv_issued = false;
 
@@ -289,7 +339,7 @@ void prte_plm_base_recv(int status, pmix_proc_t *sender,
                         prte_rml_tag_t tag, void *cbdata)
 {
     prte_plm_cmd_flag_t command;
-    int32_t count;
+    int32_t count, njobs;
     pmix_nspace_t job;
     prte_session_t *session;
     /* jdata MUST start NULL: the ANSWER_LAUNCH error path reads it, and we
@@ -516,6 +566,44 @@ void prte_plm_base_recv(int status, pmix_proc_t *sender,
         }
         break;
 
+    case PRTE_PLM_LAUNCH_BATCH_CMD:
+        /* several jobs from one spawn request, each packed as a launch
+         * command of its own. Handing them to the state machine back to
+         * back is what lets their launch messages meet again in
+         * prte_plm_base_batch_hold() */
+        count = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &njobs, &count, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto CLEANUP;
+        }
+        PMIX_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                             "%s plm:base:receive batch of %d jobs from %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), njobs, PRTE_NAME_PRINT(sender)));
+        for (; 0 < njobs; njobs--) {
+            pmix_byte_object_t bo;
+            pmix_data_buffer_t sub;
+
+            count = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &bo, &count, PMIX_BYTE_OBJECT);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                goto CLEANUP;
+            }
+            PMIX_DATA_BUFFER_CONSTRUCT(&sub);
+            rc = PMIx_Data_load(&sub, &bo);
+            bo.bytes = NULL;
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DATA_BUFFER_DESTRUCT(&sub);
+                goto CLEANUP;
+            }
+            prte_plm_base_recv(status, sender, &sub, tag, cbdata);
+            PMIX_DATA_BUFFER_DESTRUCT(&sub);
+        }
+        break;
+
     case PRTE_PLM_LAUNCH_JOB_CMD:
         PMIX_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
                              "%s plm:base:receive job launch command from %s",
@@ -64,6 +64,10 @@ typedef struct {
      * when the resulting command line would be too long for the launcher */
     bool pass_environ_mca_params;
     size_t node_regex_threshold;
+    /* msec a batch-spawned job's launch may wait for the rest of its batch */
+    int batch_window;
+    /* batches whose launch messages are being gathered */
+    pmix_list_t batches;
 } prte_plm_globals_t;
 /**
  * Global instance of PLM framework data
@@ -103,6 +107,22 @@ PRTE_EXPORT void prte_plm_base_dvm_mod_notify(const pmix_proc_t *requester,
                                               bool success,
                                               pmix_status_t cause);
 
+/*
+ * Batch launch: the jobs of one PRTE_SPAWN_BATCH request reach
+ * send_launch_msg one at a time, each with its own launch message. hold()
+ * parks a job there until the rest of its batch has arrived (or
+ * plm_base_batch_window has passed) and then sends all of their launch
+ * messages to the daemons in a single xcast. Returns false if the job is
+ * not part of a batch, in which case the caller sends it as usual.
+ */
+PRTE_EXPORT bool prte_plm_base_batch_hold(prte_job_t *jdata);
+
+/* How a complete batch goes to the daemons: prte_grpcomm_xcast.  Indirected
+ * only so the unit test can see the one broadcast a batch turns into without
+ * standing up an RML - production code never changes it. */
+typedef int (*prte_plm_base_batch_send_fn_t)(prte_rml_tag_t tag, pmix_data_buffer_t *msg);
+PRTE_EXPORT extern prte_plm_base_batch_send_fn_t prte_plm_base_batch_send;
+
 /**
  * Utilities for plm components that use proxy daemons
  */
@@ -126,6 +146,42 @@ PRTE_EXPORT void prte_plm_base_recv(int status, pmix_proc_t *sender, pmix_data_b
 PRTE_EXPORT int prte_plm_base_prted_append_basic_args(int *argc, char ***argv, char *ess_module,
                                                       int *proc_vpid_index);
 
+/*
+ * Launch window: how many launch agents a launcher may have in flight,
+ * steered by how long each one takes to complete.
+ *
+ * A launcher that forks agents faster than the remote side can absorb them
+ * only makes each one slower, and one that forks too few leaves itself idle.
+ * The window grows while completion latency stays near the best seen -
+ * by one per completion to begin with (slow start), then by one per window's
+ * worth of completions - and halves, at most once per window of
+ * completions, when the smoothed latency climbs past twice that best.  It
+ * never leaves [1, ceiling].
+ */
+typedef struct {
+    int window;
+    int ceiling;
+    // largest window reached
+    int peak;
+    bool slow_start;
+    // completions since the window last grew (congestion avoidance), and
+    // since it was last cut
+    int acked;
+    int since_cut;
+    // lowest latency seen, and the smoothed latency, in usec
+    double base_us;
+    double ewma_us;
+    uint64_t nsamples;
+    uint64_t total_us;
+    uint64_t max_us;
+} prte_plm_base_launch_window_t;
+
+PRTE_EXPORT void prte_plm_base_launch_window_init(prte_plm_base_launch_window_t *w,
+                                                  int initial, int ceiling);
+/* Record the completion of one launch that took latency_us */
+PRTE_EXPORT void prte_plm_base_launch_window_sample(prte_plm_base_launch_window_t *w,
+                                                    uint64_t latency_us);
+
 END_C_DECLS
 
 #endif /* MCA_PLS_PRIVATE_H */
@@ -134,6 +134,7 @@ typedef int32_t prte_job_state_t;
 #define PRTE_JOB_STATE_LOCAL_LAUNCH_COMPLETE 18 /* all local procs have attempted launch */
 #define PRTE_JOB_STATE_READY_FOR_DEBUG       19 /* all local procs report ready for debug */
 #define PRTE_JOB_STATE_STARTED               20 /* first process has been started */
+#define PRTE_JOB_STATE_QUEUED                21 /* parked: waiting in the DVM's job queue for free slots */
 
 /*
  * Define a "boundary" so we can easily and quickly determine
@@ -230,6 +231,7 @@ typedef uint8_t prte_plm_cmd_flag_t;
 #define PRTE_PLM_READY_FOR_DEBUG_CMD    5
 #define PRTE_PLM_LOCAL_LAUNCH_COMP_CMD  6
 #define PRTE_PLM_TOOL_DEPARTED_CMD      7
+#define PRTE_PLM_LAUNCH_BATCH_CMD       8
 
 END_C_DECLS
 
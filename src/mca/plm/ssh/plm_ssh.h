@@ -63,6 +63,9 @@ struct prte_mca_plm_ssh_component_t {
     int priority;
     bool no_tree_spawn;
     int num_concurrent;
+    bool adaptive;
+    int initial_concurrent;
+    bool launch_profile;
     char *agent;
     char *agent_path;
     char **agent_argv;
@@ -111,6 +111,27 @@ static int ssh_component_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_INT,
                                                 &prte_mca_plm_ssh_component.num_concurrent);
 
+    prte_mca_plm_ssh_component.adaptive = true;
+    (void) pmix_mca_base_component_var_register(c, "adaptive",
+                                                "Adapt how many plm_ssh_agent instances run concurrently to how long each takes to "
+                                                "complete, never exceeding num_concurrent",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_plm_ssh_component.adaptive);
+
+    prte_mca_plm_ssh_component.initial_concurrent = 16;
+    (void) pmix_mca_base_component_var_register(c, "initial_concurrent",
+                                                "How many plm_ssh_agent instances to start with when adapting - a tree-spawned "
+                                                "daemon is handed its parent's current window here",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_plm_ssh_component.initial_concurrent);
+
+    prte_mca_plm_ssh_component.launch_profile = false;
+    (void) pmix_mca_base_component_var_register(c, "launch_profile",
+                                                "Have every launching daemon report its launch timing to the HNP's stage report "
+                                                "(set automatically when prte_stage_report is)",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_plm_ssh_component.launch_profile);
+
     prte_mca_plm_ssh_component.force_ssh = false;
     (void) pmix_mca_base_component_var_register(c, "force_ssh",
                                                 "Force the launcher to always use ssh",
@@ -85,6 +85,7 @@
 #include "src/util/proc_info.h"
 #include "src/util/pmix_show_help.h"
 #include "src/util/prte_show_help.h"
+#include "src/util/prte_profile.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/ess/base/base.h"
@@ -122,11 +123,20 @@ typedef struct {
     int argc;
     char **argv;
     prte_proc_t *daemon;
+    /* where in argv the window handed to a tree-spawned child goes, or -1 */
+    int window_index;
+    /* when the agent was forked, and whether its launch has since been
+     * counted complete - by the agent exiting or the child saying hello,
+     * whichever came first */
+    struct timespec started;
+    bool released;
 } prte_plm_ssh_caddy_t;
 static void caddy_const(prte_plm_ssh_caddy_t *ptr)
 {
     ptr->argv = NULL;
     ptr->daemon = NULL;
+    ptr->window_index = -1;
+    ptr->released = false;
 }
 static void caddy_dest(prte_plm_ssh_caddy_t *ptr)
 {
@@ -166,11 +176,30 @@ static int setup_shell(prte_plm_ssh_shell_t *sshell, prte_plm_ssh_shell_t *lshel
                        int *argc, char ***argv);
 static void launch_daemons(int fd, short args, void *cbdata);
 static void process_launch_list(int fd, short args, void *cbdata);
+static void launch_complete(prte_plm_ssh_caddy_t *caddy, bool sample);
+static void child_warmed_up(pmix_rank_t rank);
+static void launch_profile_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                                prte_rml_tag_t tag, void *cbdata);
 
 /* local global storage */
 static int num_in_progress = 0;
 static pmix_list_t launch_list;
 static prte_event_t launch_event;
+/* launches forked and not yet complete */
+static pmix_list_t in_flight;
+/* how many of them we allow at once, when adapting */
+static prte_plm_base_launch_window_t window;
+static bool adapting = false;
+/* where setup_launch put the window in the argv template, or -1 */
+static int template_window_index = -1;
+/* this round of launches, for the launch profile */
+static struct {
+    struct timespec started;
+    int nlaunched;
+    int nsampled;
+    uint64_t total_us;
+    uint64_t max_us;
+} launch_round;
 static char *ssh_agent_path = NULL;
 static char **ssh_agent_argv = NULL;
 
@@ -242,8 +271,28 @@ static int ssh_init(void)
 
     /* setup the event for metering the launch */
     PMIX_CONSTRUCT(&launch_list, pmix_list_t);
+    PMIX_CONSTRUCT(&in_flight, pmix_list_t);
     prte_event_set(prte_event_base, &launch_event, -1, 0, process_launch_list, NULL);
 
+    /* an attached session never exits, so an agent slot is only freed by
+     * its child saying hello - and in a flat launch nobody does. Shrinking
+     * the window below the daemon count would then hang the launch, so
+     * only adapt when the agents are expected to finish */
+    adapting = prte_mca_plm_ssh_component.adaptive && !prte_debug_daemons_flag
+               && !prte_leave_session_attached;
+    prte_plm_base_launch_window_init(&window, prte_mca_plm_ssh_component.initial_concurrent,
+                                     prte_mca_plm_ssh_component.num_concurrent);
+    /* a tree-spawned child's warmup is the first word we get from it */
+    prte_rml_set_warmup_callback(child_warmed_up);
+
+    if (PRTE_PROC_IS_MASTER) {
+        if (prte_profile_enabled) {
+            prte_mca_plm_ssh_component.launch_profile = true;
+        }
+        PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_PROFILE,
+                      PRTE_RML_PERSISTENT, launch_profile_recv, NULL);
+    }
+
     /* start the recvs */
     if (PRTE_SUCCESS != (rc = prte_plm_base_comm_start())) {
         PRTE_ERROR_LOG(rc);
@@ -278,11 +327,18 @@ static void ssh_wait_daemon(int sd, short flags, void *cbdata)
         /* ignore any such report - it will occur if we left the
          * session attached, e.g., while debugging
          */
+        if (!caddy->released) {
+            pmix_list_remove_item(&in_flight, &caddy->super);
+        }
         PMIX_RELEASE(caddy);
         PMIX_RELEASE(t2);
         return;
     }
 
+    /* one fewer agent in flight - admit the next from the launch list. An
+     * agent that failed says nothing about how long a launch takes */
+    launch_complete(caddy, WIFEXITED(daemon->exit_code) && 0 == WEXITSTATUS(daemon->exit_code));
+
     if (!WIFEXITED(daemon->exit_code)
         || WEXITSTATUS(daemon->exit_code) != 0) { /* if abnormal exit */
         /* if we are not the HNP, send a message to the HNP alerting it
@@ -364,12 +420,6 @@ static void ssh_wait_daemon(int sd, short flags, void *cbdata)
         }
     }
 
-    /* one fewer ssh in flight - admit the next from the launch list */
-    --num_in_progress;
-    if (num_in_progress < prte_mca_plm_ssh_component.num_concurrent) {
-        /* trigger continuation of the launch */
-        prte_event_active(&launch_event, EV_WRITE, 1);
-    }
     /* cleanup - the caddy was handed to us by process_launch_list and
      * nobody else owns it (the wait tracker only releases its child), so
      * releasing it here is what frees the launch argv and the retained
@@ -752,11 +802,25 @@ static int setup_launch(int *argcptr, char ***argvptr, char *nodename, int *node
 
     /* if we are tree-spawning, tell our child daemons the
      * uri of their parent (me) */
+    template_window_index = -1;
     if (!prte_mca_plm_ssh_component.no_tree_spawn) {
         pmix_argv_append(&argc, &argv, "--tree-spawn");
         pmix_argv_append(&argc, &argv, "--prtemca");
         pmix_argv_append(&argc, &argv, "prte_parent_uri");
         pmix_argv_append(&argc, &argv, prte_process_info.my_uri);
+        /* and start them at the window we have learned so far rather
+         * than from scratch - the value is filled in as each is forked */
+        if (adapting) {
+            pmix_argv_append(&argc, &argv, "--prtemca");
+            pmix_argv_append(&argc, &argv, "plm_ssh_initial_concurrent");
+            pmix_argv_append(&argc, &argv, "0");
+            template_window_index = argc - 1;
+        }
+        if (prte_mca_plm_ssh_component.launch_profile) {
+            pmix_argv_append(&argc, &argv, "--prtemca");
+            pmix_argv_append(&argc, &argv, "plm_ssh_launch_profile");
+            pmix_argv_append(&argc, &argv, "1");
+        }
     }
 
     /* protect the params */
@@ -952,6 +1016,7 @@ static int remote_spawn(void)
         caddy = PMIX_NEW(prte_plm_ssh_caddy_t);
         caddy->argc = argc;
         caddy->argv = PMIx_Argv_copy(argv);
+        caddy->window_index = template_window_index;
         /* fake a proc structure for the new daemon - will be released
          * upon startup
          */
@@ -1023,6 +1088,144 @@ static int ssh_launch(prte_job_t *jdata)
     return PRTE_SUCCESS;
 }
 
+static uint64_t usec_since(const struct timespec *then)
+{
+    struct timespec now;
+    int64_t us;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    us = (int64_t) (now.tv_sec - then->tv_sec) * 1000000
+         + (now.tv_nsec - then->tv_nsec) / 1000;
+    return (0 > us) ? 0 : (uint64_t) us;
+}
+
+/* Tell the HNP how this daemon's round of launches went */
+static void report_launch_round(void)
+{
+    pmix_data_buffer_t *buf;
+    uint64_t spawn_us, mean_us;
+    int32_t i32[3];
+    pmix_status_t rc;
+
+    spawn_us = usec_since(&launch_round.started);
+    mean_us = (0 == launch_round.nsampled) ? 0 : launch_round.total_us / launch_round.nsampled;
+
+    if (PRTE_PROC_IS_MASTER) {
+        if (prte_profile_enabled) {
+            prte_profile_launch(PRTE_PROC_MY_NAME->rank, prte_process_info.nodename,
+                                launch_round.nlaunched, spawn_us, mean_us, launch_round.max_us,
+                                window.window, window.peak);
+        }
+        return;
+    }
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    i32[0] = launch_round.nlaunched;
+    i32[1] = window.window;
+    i32[2] = window.peak;
+    rc = PMIx_Data_pack(NULL, buf, i32, 3, PMIX_INT32);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &spawn_us, 1, PMIX_UINT64);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &mean_us, 1, PMIX_UINT64);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &launch_round.max_us, 1, PMIX_UINT64);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+    PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, buf, PRTE_RML_TAG_LAUNCH_PROFILE);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+}
+
+static void launch_profile_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                                prte_rml_tag_t tag, void *cbdata)
+{
+    int32_t i32[3], cnt;
+    uint64_t u64[3];
+    pmix_status_t rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    cnt = 3;
+    rc = PMIx_Data_unpack(NULL, buffer, i32, &cnt, PMIX_INT32);
+    for (int n = 0; PMIX_SUCCESS == rc && n < 3; n++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &u64[n], &cnt, PMIX_UINT64);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    if (prte_profile_enabled) {
+        prte_profile_launch(sender->rank, prte_get_proc_hostname(sender), i32[0],
+                            u64[0], u64[1], u64[2], i32[1], i32[2]);
+    }
+}
+
+/* A launch has completed - the agent exited, or the daemon it started
+ * said hello - so free its slot and, if asked, learn from how long it took */
+static void launch_complete(prte_plm_ssh_caddy_t *caddy, bool sample)
+{
+    uint64_t us;
+    int limit;
+
+    if (caddy->released) {
+        return;
+    }
+    caddy->released = true;
+    pmix_list_remove_item(&in_flight, &caddy->super);
+    --num_in_progress;
+
+    if (sample) {
+        us = usec_since(&caddy->started);
+        launch_round.nsampled++;
+        launch_round.total_us += us;
+        if (us > launch_round.max_us) {
+            launch_round.max_us = us;
+        }
+        if (adapting) {
+            prte_plm_base_launch_window_sample(&window, us);
+            PMIX_OUTPUT_VERBOSE((2, prte_plm_base_framework.framework_output,
+                                 "%s plm:ssh: launch of %s took %" PRIu64 " usec - window now %d",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                 PRTE_NAME_PRINT(&caddy->daemon->name), us, window.window));
+        }
+    }
+
+    limit = adapting ? window.window : prte_mca_plm_ssh_component.num_concurrent;
+    if (0 < pmix_list_get_size(&launch_list) && num_in_progress < limit) {
+        /* trigger continuation of the launch */
+        prte_event_active(&launch_event, EV_WRITE, 1);
+    } else if (0 == num_in_progress && 0 == pmix_list_get_size(&launch_list)) {
+        /* the round is over - a later one (adding hosts) starts afresh */
+        if (prte_mca_plm_ssh_component.launch_profile) {
+            report_launch_round();
+        }
+        memset(&launch_round, 0, sizeof(launch_round));
+    }
+}
+
+static void child_warmed_up(pmix_rank_t rank)
+{
+    prte_plm_ssh_caddy_t *caddy;
+
+    PMIX_LIST_FOREACH(caddy, &in_flight, prte_plm_ssh_caddy_t) {
+        if (caddy->daemon->name.rank == rank) {
+            /* a tree-spawned child holds its agent open for as long as it
+             * lives, so this is the only completion its launch will get */
+            launch_complete(caddy, true);
+            return;
+        }
+    }
+}
+
 static void process_launch_list(int fd, short args, void *cbdata)
 {
     pmix_list_item_t *item;
@@ -1030,13 +1233,19 @@ static void process_launch_list(int fd, short args, void *cbdata)
     prte_plm_ssh_caddy_t *caddy;
     PRTE_HIDE_UNUSED_PARAMS(fd, args, cbdata);
 
-    while (num_in_progress < prte_mca_plm_ssh_component.num_concurrent) {
+    while (num_in_progress < (adapting ? window.window
+                                       : prte_mca_plm_ssh_component.num_concurrent)) {
         item = pmix_list_remove_first(&launch_list);
         if (NULL == item) {
             /* we are done */
             break;
         }
         caddy = (prte_plm_ssh_caddy_t *) item;
+        /* hand a tree-spawned child the window as it stands now */
+        if (0 <= caddy->window_index) {
+            free(caddy->argv[caddy->window_index]);
+            pmix_asprintf(&caddy->argv[caddy->window_index], "\"%d\"", window.window);
+        }
         /* register the sigchild callback */
         PRTE_FLAG_SET(caddy->daemon, PRTE_PROC_FLAG_ALIVE);
         prte_wait_cb(caddy->daemon, ssh_wait_daemon, (void *) caddy);
@@ -1098,11 +1307,18 @@ static void process_launch_list(int fd, short args, void *cbdata)
             caddy->daemon->state = PRTE_PROC_STATE_RUNNING;
             /* record the pid of the ssh fork */
             caddy->daemon->pid = pid;
+            prte_wait_watch(caddy->daemon);
 
             PMIX_OUTPUT_VERBOSE((1, prte_plm_base_framework.framework_output,
                                  "%s plm:ssh: recording launch of daemon %s",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                  PRTE_NAME_PRINT(&(caddy->daemon->name))));
+            clock_gettime(CLOCK_MONOTONIC, &caddy->started);
+            if (0 == num_in_progress && 0 == launch_round.nlaunched) {
+                launch_round.started = caddy->started;
+            }
+            launch_round.nlaunched++;
+            pmix_list_append(&in_flight, &caddy->super);
             num_in_progress++;
         }
     }
@@ -1320,6 +1536,7 @@ static void launch_daemons(int fd, short args, void *cbdata)
         caddy = PMIX_NEW(prte_plm_ssh_caddy_t);
         caddy->argc = argc;
         caddy->argv = PMIx_Argv_copy(argv);
+        caddy->window_index = template_window_index;
         /* insert the alternate port if any */
         portptr = &port;
         if (prte_get_attribute(&node->attributes, PRTE_NODE_PORT, (void **) &portptr, PMIX_INT)) {
@@ -1328,6 +1545,10 @@ static void launch_daemons(int fd, short args, void *cbdata)
             pmix_argv_insert_element(&caddy->argv, node_name_index1 + 1, "-p");
             snprintf(portname, 15, "%d", port);
             pmix_argv_insert_element(&caddy->argv, node_name_index1 + 2, portname);
+            /* which moves everything after the node name along */
+            if (0 <= caddy->window_index) {
+                caddy->window_index += 2;
+            }
         }
         caddy->daemon = node->daemon;
         PMIX_RETAIN(caddy->daemon);
@@ -1389,6 +1610,15 @@ static int ssh_finalize(void)
     /* remove launch event */
     prte_event_del(&launch_event);
     PMIX_LIST_DESTRUCT(&launch_list);
+    /* whatever is still in flight belongs to its wait callback */
+    while (NULL != pmix_list_remove_first(&in_flight)) {
+        continue;
+    }
+    PMIX_DESTRUCT(&in_flight);
+    prte_rml_set_warmup_callback(NULL);
+    if (PRTE_PROC_IS_MASTER) {
+        PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_PROFILE);
+    }
 
     /* cleanup any pending recvs */
     if (PRTE_SUCCESS != (rc = prte_plm_base_comm_stop())) {
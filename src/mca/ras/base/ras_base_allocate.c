@@ -67,6 +67,8 @@
 #include "src/util/pmix_string_copy.h"
 #include "src/util/proc_info.h"
 #include "src/util/prte_cmd_line.h"
+#include "src/util/prte_profile.h"
+#include "src/util/prte_strbuf.h"
 
 #include "src/mca/ras/base/base.h"
 
@@ -111,11 +113,12 @@ char *prte_ras_base_flag_string(prte_node_t *node)
 /* function to display allocation */
 void prte_ras_base_display_alloc(prte_job_t *jdata)
 {
-    char *tmp = NULL, *tmp2, *tmp3;
-    int i, istart;
+    prte_strbuf_t sb = PRTE_STRBUF_STATIC_INIT;
+    char *out;
+    int i, j, istart;
     prte_node_t *alloc;
     char *flgs, *aliases;
-    bool parsable;
+    bool parsable, json, first = true;
     pmix_proc_t source;
 
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_ALLOC_DISPLAYED, NULL, PMIX_BOOL)) {
@@ -123,13 +126,22 @@ void prte_ras_base_display_alloc(prte_job_t *jdata)
     }
 
     parsable = prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT, NULL, PMIX_BOOL);
+    json = prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_JSON_OUTPUT, NULL, PMIX_BOOL);
     PMIX_LOAD_PROCID(&source, jdata->nspace, PMIX_RANK_WILDCARD);
 
-    if (parsable) {
-        pmix_asprintf(&tmp, "<allocation>\n");
+    /* appended to one buffer as we go - re-printing the accumulated string
+     * for every node made this quadratic in the size of the allocation */
+    if (json) {
+        /* one line, in the same shape as the "job_map" line of
+         * --display map:json */
+        prte_strbuf_append(&sb, "{\"allocation\":{\"job\":");
+        prte_strbuf_json_string(&sb, jdata->nspace);
+        prte_strbuf_append(&sb, ",\"nodes\":[");
+    } else if (parsable) {
+        prte_strbuf_append(&sb, "<allocation>\n");
     } else {
-        pmix_asprintf(&tmp,
-                      "\n======================   ALLOCATED NODES FOR JOB %s  ======================\n", jdata->nspace);
+        prte_strbuf_printf(&sb,
+                           "\n======================   ALLOCATED NODES FOR JOB %s  ======================\n", jdata->nspace);
     }
     if (prte_hnp_is_allocated) {
         istart = 0;
@@ -140,12 +152,27 @@ void prte_ras_base_display_alloc(prte_job_t *jdata)
         if (NULL == (alloc = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, i))) {
             continue;
         }
-        if (parsable) {
+        if (json) {
+            prte_strbuf_append(&sb, first ? "{\"name\":" : ",{\"name\":");
+            first = false;
+            prte_strbuf_json_string(&sb, alloc->name);
+            prte_strbuf_printf(&sb, ",\"slots\":%d,\"slots_max\":%d,\"slots_inuse\":%d,\"state\":",
+                               (int) alloc->slots, (int) alloc->slots_max, (int) alloc->slots_inuse);
+            prte_strbuf_json_string(&sb, prte_node_state_to_str(alloc->state));
+            prte_strbuf_append(&sb, ",\"aliases\":[");
+            for (j = 0; NULL != alloc->aliases && NULL != alloc->aliases[j]; j++) {
+                if (0 < j) {
+                    prte_strbuf_append(&sb, ",");
+                }
+                prte_strbuf_json_string(&sb, alloc->aliases[j]);
+            }
+            prte_strbuf_append(&sb, "]}");
+        } else if (parsable) {
             /* need to create the output in XML format */
-            pmix_asprintf(&tmp2,
-                          "\t<host name=\"%s\" slots=\"%d\" max_slots=\"%d\" slots_inuse=\"%d\">\n",
-                          (NULL == alloc->name) ? "UNKNOWN" : alloc->name, (int) alloc->slots,
-                          (int) alloc->slots_max, (int) alloc->slots_inuse);
+            prte_strbuf_printf(&sb,
+                               "\t<host name=\"%s\" slots=\"%d\" max_slots=\"%d\" slots_inuse=\"%d\">\n",
+                               (NULL == alloc->name) ? "UNKNOWN" : alloc->name, (int) alloc->slots,
+                               (int) alloc->slots_max, (int) alloc->slots_inuse);
         } else {
             /* build the flags string */
             flgs = prte_ras_base_flag_string(alloc);
@@ -155,39 +182,34 @@ void prte_ras_base_display_alloc(prte_job_t *jdata)
             } else {
                 aliases = NULL;
             }
-            pmix_asprintf(&tmp2, "    %s: slots=%d max_slots=%d slots_inuse=%d state=%s\n\t%s\n\taliases: %s\n",
-                          (NULL == alloc->name) ? "UNKNOWN" : alloc->name, (int) alloc->slots,
-                          (int) alloc->slots_max, (int) alloc->slots_inuse,
-                          prte_node_state_to_str(alloc->state), flgs,
-                          (NULL == aliases) ? "NONE" : aliases);
+            prte_strbuf_printf(&sb, "    %s: slots=%d max_slots=%d slots_inuse=%d state=%s\n\t%s\n\taliases: %s\n",
+                               (NULL == alloc->name) ? "UNKNOWN" : alloc->name, (int) alloc->slots,
+                               (int) alloc->slots_max, (int) alloc->slots_inuse,
+                               prte_node_state_to_str(alloc->state), flgs,
+                               (NULL == aliases) ? "NONE" : aliases);
             free(flgs);
             if (NULL != aliases) {
                 free(aliases);
             }
         }
-        if (NULL == tmp) {
-            tmp = tmp2;
-        } else {
-            pmix_asprintf(&tmp3, "%s%s", tmp, tmp2);
-            free(tmp);
-            free(tmp2);
-            tmp = tmp3;
-        }
     }
-    if (parsable) {
-        pmix_asprintf(&tmp2, "%s</allocation>\n", tmp);
+    if (json) {
+        prte_strbuf_append(&sb, "]}}\n");
+    } else if (parsable) {
+        prte_strbuf_append(&sb, "</allocation>\n");
     } else {
-        pmix_asprintf(&tmp2,
-                    "%s=================================================================\n", tmp);
+        prte_strbuf_append(&sb, "=================================================================\n");
     }
-    free(tmp);
-    if (prte_persistent) {
-        fprintf(stdout, "%s", tmp2);
+    out = prte_strbuf_release(&sb);
+    if (NULL == out) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+    } else if (prte_persistent) {
+        fprintf(stdout, "%s", out);
         /* prte_iof_base_output would have taken ownership of the string;
          * this branch does not hand it anywhere, so it has to free it */
-        free(tmp2);
+        free(out);
     } else {
-        prte_iof_base_output(&source, PMIX_FWD_STDOUT_CHANNEL, tmp2);
+        prte_iof_base_output(&source, PMIX_FWD_STDOUT_CHANNEL, out);
     }
     prte_set_attribute(&jdata->attributes, PRTE_JOB_ALLOC_DISPLAYED, PRTE_ATTR_LOCAL, NULL, PMIX_BOOL);
 }
@@ -335,9 +357,11 @@ void prte_ras_base_allocate(int fd, short args, void *cbdata)
     char *hosts;
     char **hostlist;
     char *ptr;
+    prte_profile_mark_t mark;
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
     PMIX_ACQUIRE_OBJECT(caddy);
+    PRTE_PROFILE_MARK(&mark);
 
     PMIX_OUTPUT_VERBOSE((5, prte_ras_base_framework.framework_output,
                          "%s ras:base:allocate",
@@ -539,6 +563,8 @@ DISPLAY:
         }
     }
 
+    PRTE_PROFILE_STAGE("allocate", jdata->nspace, &mark, 0);
+
     /* set the job state to the next position */
     PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_ALLOCATION_COMPLETE);
 
@@ -29,6 +29,7 @@ struct prte_ras_sim_component_t {
     char *topologies;
     bool have_cpubind;
     bool have_membind;
+    bool launch;
 };
 typedef struct prte_ras_sim_component_t prte_ras_sim_component_t;
 
@@ -90,6 +90,15 @@ static int ras_sim_register(void)
                                                 "Topology supports binding to memory",
                                                 PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                                 &prte_mca_ras_simulator_component.have_membind);
+
+    prte_mca_ras_simulator_component.launch = false;
+    (void) pmix_mca_base_component_var_register(component, "launch",
+                                                "Launch daemons on the simulated nodes rather than only mapping "
+                                                "onto them. Requires a launch agent that starts them somewhere "
+                                                "real - e.g., on this host, each told its node name through "
+                                                "prte_hostname (see test/emulate)",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_ras_simulator_component.launch);
     return PRTE_SUCCESS;
 }
 
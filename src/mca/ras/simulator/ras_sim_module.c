@@ -192,9 +192,12 @@ static int allocate(prte_job_t *jdata, pmix_list_t *nodes)
     /* record the number of allocated nodes */
     prte_num_allocated_nodes = pmix_list_get_size(nodes);
 
-    // ensure we do not attempt to launch this job
-    prte_set_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, PRTE_ATTR_GLOBAL,
-                       NULL, PMIX_BOOL);
+    // ensure we do not attempt to launch this job - unless there is
+    // something standing by to play the part of the nodes
+    if (!prte_mca_ras_simulator_component.launch) {
+        prte_set_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, PRTE_ATTR_GLOBAL,
+                           NULL, PMIX_BOOL);
+    }
 
     if (NULL != max_slot_cnt) {
         PMIx_Argv_free(max_slot_cnt);
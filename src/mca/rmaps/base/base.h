@@ -93,6 +93,10 @@ typedef struct {
      * counts go back when the map is done. Emptied by
      * prte_rmaps_base_restore_resized() at the end of every map. */
     pmix_list_t resized_nodes;
+    /* how many job shapes to remember for replay on an idle DVM (0 = off),
+     * and the shapes themselves, most recently used first */
+    int hot_jobs;
+    pmix_list_t hot_shapes;
 } prte_rmaps_base_t;
 
 /* one entry of prte_rmaps_base.resized_nodes: the node is borrowed, since
@@ -109,6 +113,52 @@ typedef struct {
 } prte_rmaps_base_resize_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_rmaps_base_resize_t);
 
+/* A map we already computed once, kept so that the same job submitted again
+ * to the same idle DVM can be laid out without running a mapper. Nodes and
+ * procs are held by value - pool index and rank - since the job that made
+ * the shape is long gone by the time it is replayed. */
+typedef struct {
+    int32_t index;          // node's index in prte_node_pool
+    hwloc_cpuset_t pre;     // node->available before the map
+    hwloc_cpuset_t post;    // ... and after it
+    bool oversubscribed;
+} prte_rmaps_base_hot_node_t;
+
+typedef struct {
+    int32_t node;           // index into the shape's nodes
+    prte_app_idx_t app_idx;
+    prte_local_rank_t local_rank;
+    prte_node_rank_t node_rank;
+    prte_local_rank_t numa_rank;
+    int32_t app_rank;
+    char *cpuset;
+} prte_rmaps_base_hot_proc_t;
+
+typedef struct {
+    pmix_list_item_t super;
+    /* everything the mappers would have read, packed - see
+     * prte_rmaps_base_hot_key() */
+    pmix_byte_object_t key;
+    /* the DVM the shape was computed on */
+    uint32_t epoch;
+    pmix_rank_t ndaemons;
+    char *mapper;
+    prte_mapping_policy_t mapping;
+    prte_ranking_policy_t ranking;
+    prte_binding_policy_t binding;
+    bool oversubscribed;
+    /* per-app proc counts, which the mapper may have filled in */
+    int32_t napps;
+    pmix_rank_t *app_nprocs;
+    int32_t nnodes;
+    prte_rmaps_base_hot_node_t *nodes;
+    /* indexed by rank - procs_len entries, of which nprocs were filled */
+    pmix_rank_t nprocs;
+    pmix_rank_t procs_len;
+    prte_rmaps_base_hot_proc_t *procs;
+} prte_rmaps_base_hot_shape_t;
+PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_rmaps_base_hot_shape_t);
+
 /**
  * Global instance of rmaps-wide framework data
  */
@@ -144,6 +194,22 @@ PRTE_EXPORT void prte_rmaps_base_record_resize(prte_node_t *node, int32_t slots)
  * than one that succeeded. */
 PRTE_EXPORT void prte_rmaps_base_restore_resized(void);
 
+/* Hot-job replay. Build the key a job's map is remembered under; returns
+ * false when the job is not one we replay (the key is then left empty) */
+PRTE_EXPORT bool prte_rmaps_base_hot_key(prte_job_t *jdata,
+                                         prte_rmaps_options_t *options,
+                                         pmix_byte_object_t *key);
+/* Lay the job out from a remembered shape. Returns the name of the mapper
+ * that originally placed it, or NULL if there is no shape for the key or
+ * the DVM is not in the state the shape was computed in - the job has not
+ * been touched in that case and must be mapped normally */
+PRTE_EXPORT const char *prte_rmaps_base_hot_replay(prte_job_t *jdata,
+                                                   pmix_byte_object_t *key);
+/* Remember the map a mapper just made, if it was made on an idle DVM */
+PRTE_EXPORT void prte_rmaps_base_hot_record(prte_job_t *jdata,
+                                            pmix_byte_object_t *key,
+                                            const char *mapper);
+
 PRTE_EXPORT int prte_rmaps_base_filter_nodes(prte_app_context_t *app, pmix_list_t *nodes,
                                              bool remove);
 
@@ -72,7 +72,9 @@ prte_rmaps_base_t prte_rmaps_base = {
     .default_ranking_policy = NULL,
     .require_hwtcpus = false,
     .have_cores = true,
-    .resized_nodes = PMIX_LIST_STATIC_INIT
+    .resized_nodes = PMIX_LIST_STATIC_INIT,
+    .hot_jobs = 8,
+    .hot_shapes = PMIX_LIST_STATIC_INIT
 };
 
 static void rsz_con(prte_rmaps_base_resize_t *p)
@@ -132,6 +134,14 @@ static int prte_rmaps_base_register(pmix_mca_base_register_flag_t flags)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &prte_rmaps_base.inherit);
 
+    prte_rmaps_base.hot_jobs = 8;
+    (void) pmix_mca_base_var_register("prte", "rmaps", "base", "hot_jobs",
+                                      "Number of distinct jobs whose map is remembered, so that "
+                                      "submitting the same job again to an otherwise idle DVM "
+                                      "reuses it rather than running the mapper (0 = never)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_rmaps_base.hot_jobs);
+
     return PRTE_SUCCESS;
 }
 
@@ -147,6 +157,7 @@ static int prte_rmaps_base_close(void)
     /* a map always drains this, but a teardown in the middle of one must
      * not leak what it left */
     PMIX_LIST_DESTRUCT(&prte_rmaps_base.resized_nodes);
+    PMIX_LIST_DESTRUCT(&prte_rmaps_base.hot_shapes);
     hwloc_bitmap_free(prte_rmaps_base.available);
     hwloc_bitmap_free(prte_rmaps_base.baseset);
 
@@ -164,6 +175,7 @@ static int prte_rmaps_base_open(pmix_mca_base_open_flag_t flags)
     /* init the globals */
     PMIX_CONSTRUCT(&prte_rmaps_base.selected_modules, pmix_list_t);
     PMIX_CONSTRUCT(&prte_rmaps_base.resized_nodes, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_rmaps_base.hot_shapes, pmix_list_t);
     prte_rmaps_base.available = hwloc_bitmap_alloc();
     prte_rmaps_base.baseset = hwloc_bitmap_alloc();
 
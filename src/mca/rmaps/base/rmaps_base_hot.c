@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Hot-job replay.
+ *
+ * A persistent DVM is often handed the same job over and over - a test
+ * harness, a workflow launching one small step after another. Each time the
+ * mapper walks the same allocation with the same directives and, because the
+ * DVM is idle again between runs, comes to the same answer. What it cost to
+ * get there is what stands between a warm DVM and a sub-second start.
+ *
+ * So when a whole-job map completes on an otherwise idle DVM, remember the
+ * answer: which nodes, which cpus on each, and every proc's rank, node,
+ * local/node/app rank and binding. The next job that presents the same key
+ * - the same apps, the same resolved directives, in the same session - on
+ * the same daemons, with every node idle and its cpus as they were, is laid
+ * out from that record. Anything else maps as it always did.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/class/pmix_list.h"
+#include "src/class/pmix_pointer_array.h"
+#include "src/grpcomm/grpcomm.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/plm/plm_types.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_launch_template.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_output.h"
+#include "src/util/proc_info.h"
+
+#include "src/mca/rmaps/base/base.h"
+#include "src/mca/rmaps/base/rmaps_private.h"
+
+static void hcon(prte_rmaps_base_hot_shape_t *p)
+{
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->key);
+    p->epoch = 0;
+    p->ndaemons = 0;
+    p->mapper = NULL;
+    p->mapping = 0;
+    p->ranking = 0;
+    p->binding = 0;
+    p->oversubscribed = false;
+    p->napps = 0;
+    p->app_nprocs = NULL;
+    p->nnodes = 0;
+    p->nodes = NULL;
+    p->nprocs = 0;
+    p->procs_len = 0;
+    p->procs = NULL;
+}
+static void hdes(prte_rmaps_base_hot_shape_t *p)
+{
+    int32_t n;
+    pmix_rank_t r;
+
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->key);
+    if (NULL != p->mapper) {
+        free(p->mapper);
+    }
+    if (NULL != p->app_nprocs) {
+        free(p->app_nprocs);
+    }
+    if (NULL != p->nodes) {
+        for (n = 0; n < p->nnodes; n++) {
+            if (NULL != p->nodes[n].pre) {
+                hwloc_bitmap_free(p->nodes[n].pre);
+            }
+            if (NULL != p->nodes[n].post) {
+                hwloc_bitmap_free(p->nodes[n].post);
+            }
+        }
+        free(p->nodes);
+    }
+    if (NULL != p->procs) {
+        /* a record abandoned part way has cpusets anywhere in the array */
+        for (r = 0; r < p->procs_len; r++) {
+            if (NULL != p->procs[r].cpuset) {
+                free(p->procs[r].cpuset);
+            }
+        }
+        free(p->procs);
+    }
+}
+PMIX_CLASS_INSTANCE(prte_rmaps_base_hot_shape_t, pmix_list_item_t, hcon, hdes);
+
+static prte_rmaps_base_hot_shape_t *find_shape(pmix_byte_object_t *key)
+{
+    prte_rmaps_base_hot_shape_t *s;
+
+    PMIX_LIST_FOREACH(s, &prte_rmaps_base.hot_shapes, prte_rmaps_base_hot_shape_t)
+    {
+        if (s->key.size == key->size &&
+            0 == memcmp(s->key.bytes, key->bytes, key->size)) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+/* the number of slots in use across the whole pool - a shape is only valid
+ * on the DVM it was computed on, and that DVM was running nothing else */
+static int32_t pool_inuse(void)
+{
+    prte_node_t *node;
+    int32_t inuse = 0;
+    int n;
+
+    for (n = 0; n < prte_node_pool->size; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, n);
+        if (NULL != node) {
+            inuse += node->slots_inuse;
+        }
+    }
+    return inuse;
+}
+
+bool prte_rmaps_base_hot_key(prte_job_t *jdata,
+                             prte_rmaps_options_t *options,
+                             pmix_byte_object_t *key)
+{
+    pmix_data_buffer_t buf;
+    pmix_byte_object_t apps;
+    prte_app_context_t *app;
+    prte_mapping_policy_t pol;
+    uint32_t session;
+    uint16_t u16[9];
+    bool flags[7];
+    int32_t i32[4];
+    pmix_status_t rc;
+    int n;
+
+    if (0 >= prte_rmaps_base.hot_jobs) {
+        return false;
+    }
+    /* only jobs whose placement the mapper decides from the allocation and
+     * the directives alone: not a job we will not launch, a tool, a restart,
+     * a rankfile or sequential list, nor a device map that depends on which
+     * devices happen to be free */
+    pol = PRTE_GET_MAPPING_POLICY(jdata->map->mapping);
+    if (options->donotlaunch || options->userranked || NULL != options->map_device ||
+        PRTE_MAPPING_SEQ == pol || PRTE_MAPPING_BYUSER == pol ||
+        PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_TOOL) ||
+        PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_RESTART) ||
+        PMIX_CHECK_NSPACE(jdata->nspace, PRTE_PROC_MY_NAME->nspace)) {
+        return false;
+    }
+    for (n = 0; n < jdata->apps->size; n++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, n);
+        if (NULL != app && PRTE_FLAG_TEST(app, PRTE_APP_FLAG_TOOL)) {
+            return false;
+        }
+    }
+
+    if (PRTE_SUCCESS != prte_launch_template_pack_apps(jdata, &apps)) {
+        return false;
+    }
+    session = (NULL == jdata->session) ? 0 : jdata->session->session_id;
+    u16[0] = jdata->map->mapping;
+    u16[1] = jdata->map->ranking;
+    u16[2] = jdata->map->binding;
+    u16[3] = options->map;
+    u16[4] = options->rank;
+    u16[5] = options->bind;
+    u16[6] = options->mapdepth;
+    u16[7] = options->cpus_per_rank;
+    u16[8] = options->limit;
+    flags[0] = options->use_hwthreads;
+    flags[1] = options->oversubscribe;
+    flags[2] = options->overload;
+    flags[3] = options->mapspan;
+    flags[4] = options->ordered;
+    flags[5] = options->dobind;
+    flags[6] = options->mapgiven;
+    i32[0] = options->nprocs;
+    i32[1] = options->pprn;
+    i32[2] = (int32_t) options->maptype;
+    i32[3] = (int32_t) options->hwb;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = PMIx_Data_pack(NULL, &buf, &session, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &buf, u16, 9, PMIX_UINT16);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &buf, flags, 7, PMIX_BOOL);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &buf, i32, 4, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &buf, &options->cpuset, 1, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &buf, &apps, 1, PMIX_BYTE_OBJECT);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&apps);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_unload(&buf, key);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return false;
+    }
+    return true;
+}
+
+const char *prte_rmaps_base_hot_replay(prte_job_t *jdata,
+                                       pmix_byte_object_t *key)
+{
+    prte_rmaps_base_hot_shape_t *s;
+    prte_rmaps_base_hot_proc_t *hp;
+    prte_app_context_t *app;
+    prte_node_t **nodes, *node;
+    prte_proc_t *proc;
+    pmix_rank_t r;
+    int32_t n;
+    int rc;
+
+    if (NULL == key->bytes || NULL == (s = find_shape(key))) {
+        return NULL;
+    }
+    /* the shape is only the answer on the DVM it came from, idle, with
+     * every node it used up and its cpus as they were */
+    if (s->epoch != prte_grpcomm_current_epoch() ||
+        s->ndaemons != prte_process_info.num_daemons ||
+        0 != pool_inuse() || 0 != jdata->num_procs ||
+        0 != jdata->map->num_nodes) {
+        return NULL;
+    }
+    nodes = (prte_node_t **) malloc(s->nnodes * sizeof(prte_node_t *));
+    if (NULL == nodes) {
+        return NULL;
+    }
+    for (n = 0; n < s->nnodes; n++) {
+        nodes[n] = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool,
+                                                               s->nodes[n].index);
+        if (NULL == nodes[n] || PRTE_NODE_STATE_UP != nodes[n]->state ||
+            NULL == nodes[n]->available ||
+            !hwloc_bitmap_isequal(nodes[n]->available, s->nodes[n].pre)) {
+            free(nodes);
+            return NULL;
+        }
+    }
+    /* we are committed from here: nothing below can refuse the shape */
+    pmix_list_remove_item(&prte_rmaps_base.hot_shapes, &s->super);
+    pmix_list_prepend(&prte_rmaps_base.hot_shapes, &s->super);
+
+    jdata->map->mapping = s->mapping;
+    jdata->map->ranking = s->ranking;
+    jdata->map->binding = s->binding;
+    for (n = 0; n < s->napps; n++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, n);
+        if (NULL != app) {
+            app->num_procs = s->app_nprocs[n];
+        }
+    }
+    for (n = 0; n < s->nnodes; n++) {
+        node = nodes[n];
+        hwloc_bitmap_copy(node->jobcache, s->nodes[n].pre);
+        hwloc_bitmap_copy(node->available, s->nodes[n].post);
+        if (s->nodes[n].oversubscribed) {
+            PRTE_FLAG_SET(node, PRTE_NODE_FLAG_OVERSUBSCRIBED);
+        }
+        PMIX_RETAIN(node);
+        pmix_pointer_array_add(jdata->map->nodes, node);
+        ++jdata->map->num_nodes;
+    }
+    for (r = 0; r < s->nprocs; r++) {
+        hp = &s->procs[r];
+        node = nodes[hp->node];
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, jdata->nspace, r);
+        proc->state = PRTE_PROC_STATE_INIT;
+        proc->app_idx = hp->app_idx;
+        PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_UPDATED);
+        proc->parent = (NULL == node->daemon) ? PMIX_RANK_INVALID : node->daemon->name.rank;
+        proc->node = node;
+        proc->local_rank = hp->local_rank;
+        proc->node_rank = hp->node_rank;
+        proc->numa_rank = hp->numa_rank;
+        proc->app_rank = hp->app_rank;
+        if (NULL != hp->cpuset) {
+            proc->cpuset = strdup(hp->cpuset);
+        }
+        /* one reference for the node, one for the job - as the mapper and
+         * the ranking leave them */
+        if (0 > (rc = pmix_pointer_array_add(node->procs, proc))) {
+            PRTE_ERROR_LOG(rc);
+        }
+        ++node->num_procs;
+        ++node->slots_inuse;
+        PMIX_RETAIN(proc);
+        pmix_pointer_array_set_item(jdata->procs, r, proc);
+    }
+    jdata->num_procs = s->nprocs;
+    if (s->oversubscribed) {
+        PRTE_FLAG_SET(jdata, PRTE_JOB_FLAG_OVERSUBSCRIBED);
+    }
+    free(nodes);
+
+    pmix_output_verbose(5, prte_rmaps_base_framework.framework_output,
+                        "%s rmaps:base:hot replayed map of job %s (%u procs on %d nodes)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                        s->nprocs, s->nnodes);
+    return s->mapper;
+}
+
+void prte_rmaps_base_hot_record(prte_job_t *jdata,
+                                pmix_byte_object_t *key,
+                                const char *mapper)
+{
+    prte_rmaps_base_hot_shape_t *s;
+    prte_rmaps_base_hot_proc_t *hp;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_proc_t *proc;
+    pmix_list_item_t *item;
+    int32_t n, nn;
+    int m;
+
+    if (NULL == key->bytes || NULL == mapper) {
+        return;
+    }
+    /* a map made around someone else's procs is not the map an idle DVM
+     * would get, so it is not worth remembering */
+    if (pool_inuse() != (int32_t) jdata->num_procs) {
+        return;
+    }
+    if (NULL != (s = find_shape(key))) {
+        /* same job on a different DVM - this one supersedes it */
+        pmix_list_remove_item(&prte_rmaps_base.hot_shapes, &s->super);
+        PMIX_RELEASE(s);
+    }
+
+    s = PMIX_NEW(prte_rmaps_base_hot_shape_t);
+    s->key.bytes = (char *) malloc(key->size);
+    if (NULL == s->key.bytes) {
+        PMIX_RELEASE(s);
+        return;
+    }
+    memcpy(s->key.bytes, key->bytes, key->size);
+    s->key.size = key->size;
+    s->epoch = prte_grpcomm_current_epoch();
+    s->ndaemons = prte_process_info.num_daemons;
+    s->mapper = strdup(mapper);
+    s->mapping = jdata->map->mapping;
+    s->ranking = jdata->map->ranking;
+    s->binding = jdata->map->binding;
+    s->oversubscribed = PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_OVERSUBSCRIBED);
+
+    s->napps = jdata->apps->size;
+    s->app_nprocs = (pmix_rank_t *) calloc(s->napps, sizeof(pmix_rank_t));
+    s->nodes = (prte_rmaps_base_hot_node_t *) calloc(jdata->map->num_nodes,
+                                                     sizeof(prte_rmaps_base_hot_node_t));
+    s->procs = (prte_rmaps_base_hot_proc_t *) calloc(jdata->num_procs,
+                                                     sizeof(prte_rmaps_base_hot_proc_t));
+    if (NULL == s->app_nprocs || NULL == s->nodes || NULL == s->procs) {
+        PMIX_RELEASE(s);
+        return;
+    }
+    s->procs_len = jdata->num_procs;
+    for (n = 0; n < s->napps; n++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, n);
+        if (NULL != app) {
+            s->app_nprocs[n] = app->num_procs;
+        }
+    }
+    for (m = 0; m < jdata->map->nodes->size; m++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(jdata->map->nodes, m);
+        if (NULL == node) {
+            continue;
+        }
+        nn = s->nnodes++;
+        s->nodes[nn].index = node->index;
+        s->nodes[nn].pre = hwloc_bitmap_dup(node->jobcache);
+        s->nodes[nn].post = hwloc_bitmap_dup(node->available);
+        s->nodes[nn].oversubscribed = PRTE_FLAG_TEST(node, PRTE_NODE_FLAG_OVERSUBSCRIBED);
+    }
+    for (m = 0; m < jdata->procs->size; m++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, m);
+        if (NULL == proc) {
+            continue;
+        }
+        if (proc->name.rank >= jdata->num_procs) {
+            PMIX_RELEASE(s);
+            return;
+        }
+        hp = &s->procs[proc->name.rank];
+        for (n = 0; n < s->nnodes; n++) {
+            if (s->nodes[n].index == proc->node->index) {
+                break;
+            }
+        }
+        if (n == s->nnodes) {
+            PMIX_RELEASE(s);
+            return;
+        }
+        hp->node = n;
+        hp->app_idx = proc->app_idx;
+        hp->local_rank = proc->local_rank;
+        hp->node_rank = proc->node_rank;
+        hp->numa_rank = proc->numa_rank;
+        hp->app_rank = proc->app_rank;
+        if (NULL != proc->cpuset) {
+            hp->cpuset = strdup(proc->cpuset);
+        }
+        ++s->nprocs;
+    }
+    if (s->nprocs != jdata->num_procs) {
+        PMIX_RELEASE(s);
+        return;
+    }
+
+    pmix_list_prepend(&prte_rmaps_base.hot_shapes, &s->super);
+    while ((int) pmix_list_get_size(&prte_rmaps_base.hot_shapes) > prte_rmaps_base.hot_jobs) {
+        item = pmix_list_remove_last(&prte_rmaps_base.hot_shapes);
+        PMIX_RELEASE(item);
+    }
+}
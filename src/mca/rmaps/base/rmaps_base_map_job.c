@@ -47,6 +47,7 @@
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/prte_profile.h"
 #include "src/util/prte_show_help.h"
 
 #include "src/mca/rmaps/base/base.h"
@@ -618,10 +619,15 @@ void prte_rmaps_base_map_job(int fd, short args, void *cbdata)
     bool flag, *fptr;
     bool map_succeeded = false;
     prte_mapping_policy_t job_oversub = 0;
+    prte_profile_mark_t mark;
+    pmix_byte_object_t hotkey;
+    const char *hot_mapper = NULL;
 
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
     PMIX_ACQUIRE_OBJECT(caddy);
+    PRTE_PROFILE_MARK(&mark);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&hotkey);
     // init options
     memset(&options, 0, sizeof(prte_rmaps_options_t));
     memset(&app_options, 0, sizeof(prte_rmaps_options_t));
@@ -1566,12 +1572,25 @@ ranking:
         }
         did_map = true;
     } else if (!any_per_app) {
+        did_map = false;
+        /* the same job on the same idle DVM maps the same way every time,
+         * so a map we have already made is simply laid down again */
+        if (prte_rmaps_base_hot_key(jdata, &options, &hotkey)) {
+            const char *replayed = prte_rmaps_base_hot_replay(jdata, &hotkey);
+            if (NULL != replayed) {
+                record_mapper(jdata, -1, replayed);
+                did_map = true;
+                rc = PRTE_SUCCESS;
+            }
+        }
         /* cycle thru the available mappers until one agrees to map
          * the job
          */
-        did_map = false;
         PMIX_LIST_FOREACH(mod, &prte_rmaps_base.selected_modules, prte_rmaps_base_selected_module_t)
         {
+            if (did_map) {
+                break;
+            }
             if (PRTE_SUCCESS == (rc = mod->module->map_job(jdata, &options)) ||
                 PRTE_ERR_RESOURCE_BUSY == rc) {
                 /* the base records who did the mapping, not the mapper - a
@@ -1579,6 +1598,7 @@ ranking:
                  * still be the answer. Every app of a whole-job map was
                  * placed by the same component, so they all get the name */
                 record_mapper(jdata, -1, mod->component->pmix_mca_component_name);
+                hot_mapper = mod->component->pmix_mca_component_name;
                 did_map = true;
                 break;
             }
@@ -1715,6 +1735,11 @@ ranking:
         goto cleanup;
     }
 
+    /* remember a map a mapper made, so the next run of the job need not */
+    if (NULL != hot_mapper) {
+        prte_rmaps_base_hot_record(jdata, &hotkey, hot_mapper);
+    }
+
     /* set the offset so shared memory components can potentially
      * connect to any spawned jobs
      */
@@ -1728,11 +1753,14 @@ ranking:
             parent->bookmark = jdata->bookmark;
         }
     }
+    PRTE_PROFILE_STAGE("map", jdata->nspace, &mark, 0);
 
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_MAP, NULL, PMIX_BOOL) ||
         prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL)) {
         /* display the map */
+        PRTE_PROFILE_MARK(&mark);
         prte_rmaps_base_display_map(jdata);
+        PRTE_PROFILE_STAGE("display_map", jdata->nspace, &mark, 0);
     } else if (options.donotlaunch &&
                prte_get_attribute(&jdata->attributes, PRTE_JOB_REPORT_BINDINGS, NULL, PMIX_BOOL)) {
         prte_rmaps_base_report_bindings(jdata, &options);
@@ -1770,6 +1798,7 @@ cleanup:
     free_cpusets(&app_options);
     free_strings(&options);
     free_strings(&app_options);
+    PMIX_BYTE_OBJECT_DESTRUCT(&hotkey);
     if (NULL != nptr) {
         PMIX_PROC_RELEASE(nptr);
         nptr = NULL;
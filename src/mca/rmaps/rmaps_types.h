@@ -29,6 +29,7 @@
 #include "prte_config.h"
 #include "constants.h"
 
+#include "src/class/pmix_bitmap.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/hwloc/hwloc-internal.h"
 
@@ -76,10 +77,30 @@ struct prte_job_map_t {
     int32_t num_nodes;
     /* array of pointers to nodes in this map for this job */
     pmix_pointer_array_t *nodes;
+    /* the daemons hosting this job, one bit per daemon rank - built by
+     * grpcomm the first time a collective spans the whole job, so the
+     * next one is a bitmap copy.  NULL until then, and again once a node
+     * leaves the map */
+    pmix_bitmap_t *daemons;
+    /* how many nodes the map held when "daemons" was built - a map that
+     * has gained nodes since cannot use it */
+    int32_t daemons_nnodes;
 };
 typedef struct prte_job_map_t prte_job_map_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_job_map_t);
 
+/* Drop the cached daemon set when a node leaves the map or loses its
+ * daemon.  The node count only catches a map that grew: one that lost a
+ * node and gained another looks unchanged, so every path that takes a
+ * node out has to call this. */
+static inline void prte_job_map_daemons_stale(prte_job_map_t *map)
+{
+    if (NULL != map && NULL != map->daemons) {
+        PMIX_RELEASE(map->daemons);
+        map->daemons = NULL;
+    }
+}
+
 typedef struct {
     /* input info */
     uint16_t cpus_per_rank;
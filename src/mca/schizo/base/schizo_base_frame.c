@@ -441,6 +441,7 @@ static char *display_quals[] = {
     PRTE_CLI_PARSEABLE,
     PRTE_CLI_PARSABLE,
     PRTE_CLI_PHYSICAL_CPUS,
+    PRTE_CLI_JSON,
     NULL
 };
 
@@ -1069,6 +1070,7 @@ int prte_schizo_base_parse_display(pmix_cli_item_t *opt, void *jinfo)
         {PRTE_CLI_PARSEABLE, PMIX_DISPLAY_PARSEABLE_OUTPUT, false, false},
         {PRTE_CLI_PARSABLE, PMIX_DISPLAY_PARSEABLE_OUTPUT, false, false},
         {PRTE_CLI_PHYSICAL_CPUS, PMIX_REPORT_PHYSICAL_CPUS, false, false},
+        {PRTE_CLI_JSON, PRTE_DISPLAY_JSON_OUTPUT, false, false},
         {NULL, NULL, false, false}
     };
 
@@ -1086,7 +1088,7 @@ int prte_schizo_base_parse_display(pmix_cli_item_t *opt, void *jinfo)
                     if (!set_bool_directive(qualtbl, PRTE_CLI_DISPLAY, quals[m],
                                             PMIX_CLI_QUALIFIER_VALUE(quals[m]), &rc)) {
                         prte_show_help("help-prte-rmaps-base.txt", "unrecognized-qualifier", true,
-                                       "display", cptr, "PARSEABLE,PARSABLE,PHYSICAL");
+                                       "display", cptr, "PARSEABLE,PARSABLE,PHYSICAL,JSON");
                         rc = PRTE_ERR_FATAL;
                         goto cleanup;
                     }
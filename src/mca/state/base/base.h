@@ -47,6 +47,10 @@ typedef struct {
     bool show_launch_progress;
     bool notifyerrors;
     bool autorestart;
+    bool batch;
+    int caddy_cache;
+    bool job_queue;
+    bool queue_backfill;
 } prte_state_base_t;
 PRTE_EXPORT extern prte_state_base_t prte_state_base;
 
@@ -82,6 +86,18 @@ PRTE_EXPORT int prte_state_base_set_proc_state_callback(prte_proc_state_t state,
 
 PRTE_EXPORT int prte_state_base_remove_proc_state(prte_proc_state_t state);
 
+/* The dispatch path - see state_base_dispatch.c.  The lookups return the
+ * entry an activation of "state" runs, fallbacks included, or NULL; "exact"
+ * says whether it is the state's own.  Anything that changes the lists -
+ * including a component constructing or destructing them - calls
+ * states_changed. */
+PRTE_EXPORT prte_state_t *prte_state_base_lookup_job_state(prte_job_state_t state, bool *exact);
+PRTE_EXPORT prte_state_t *prte_state_base_lookup_proc_state(prte_proc_state_t state, bool *exact);
+PRTE_EXPORT void prte_state_base_states_changed(void);
+PRTE_EXPORT prte_state_caddy_t *prte_state_base_caddy_get(void);
+PRTE_EXPORT void prte_state_base_dispatch(prte_state_caddy_t *caddy, prte_state_cbfunc_t cbfunc);
+PRTE_EXPORT void prte_state_base_dispatch_finalize(void);
+
 /* common state processing functions */
 PRTE_EXPORT void prte_state_base_local_launch_complete(int fd, short argc, void *cbdata);
 PRTE_EXPORT void prte_state_base_report_progress(int fd, short argc, void *cbdata);
@@ -97,6 +113,23 @@ PRTE_EXPORT void prte_state_base_orphaned_proc(pmix_proc_t *proc, prte_proc_stat
 // resource recovery
 PRTE_EXPORT void prte_state_base_recover_resources(prte_job_t *jdata, prte_proc_t *pptr);
 
+/* The job queue - see state_base_queue.c.  queue_map is the DVM's MAP
+ * callback: it maps a job whose procs fit the free slots and holds one that
+ * does not.  Whatever frees slots calls queue_kick. */
+typedef struct {
+    int32_t free;           // slots not in use on the nodes the mapper would consider
+    int32_t capacity;       // all the slots on those nodes
+    int32_t local_free;     // the HNP node's part of each
+    int32_t local_capacity;
+} prte_state_slot_index_t;
+
+PRTE_EXPORT void prte_state_base_slot_index(prte_state_slot_index_t *idx);
+PRTE_EXPORT bool prte_state_base_queue_need(prte_job_t *jdata, int32_t *nprocs, bool *nolocal);
+PRTE_EXPORT void prte_state_base_queue_map(int fd, short args, void *cbdata);
+PRTE_EXPORT void prte_state_base_queue_kick(void);
+PRTE_EXPORT size_t prte_state_base_queue_depth(void);
+PRTE_EXPORT void prte_state_base_queue_finalize(void);
+
 END_C_DECLS
 
 #endif
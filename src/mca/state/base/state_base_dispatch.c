@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * The state machine's dispatch path: finding the callback for a state,
+ * getting a caddy to carry the activation, and getting it onto the event
+ * base.
+ *
+ * Every proc of a job goes through several states at launch and again at
+ * exit, so this runs thousands of times per job on a busy node.  Three
+ * things keep it cheap without changing what any handler sees:
+ *
+ *  - the callback lists are resolved into a table indexed by state, rebuilt
+ *    only when the lists change.  The lists stay the record; the table is a
+ *    cache of the walk prte_state_base_activate_*_state used to make every
+ *    time, fallbacks included.  Activations come from whichever event base
+ *    the caller is on, so the table is only read or rebuilt under its lock;
+ *  - caddies come from a small cache.  A handler releases its caddy as it
+ *    always has; the dispatcher holds a reference of its own across the
+ *    call, and a caddy nobody else kept goes back to the cache instead of
+ *    to free();
+ *  - with state_base_batch set, activations are queued and one event
+ *    drains the queue in order, instead of each arming an event of its own.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/class/pmix_list.h"
+#include "src/event/event-internal.h"
+#include "src/threads/pmix_threads.h"
+
+#include "src/mca/state/base/base.h"
+
+/* states this far up are looked up in the lists as they always were - only
+ * components that make up dynamic states go past it */
+#define PRTE_STATE_TABLE_SIZE 128
+
+typedef struct {
+    prte_state_t *state;
+    bool exact;
+} prte_state_entry_t;
+
+typedef struct {
+    unsigned generation;
+    prte_state_entry_t entries[PRTE_STATE_TABLE_SIZE];
+} prte_state_table_t;
+
+/* bumped by every change to either list - a table built at any other
+ * generation is stale.  Starts past the tables' zero so neither is taken
+ * as current before it has been built. */
+static unsigned states_generation = 1;
+static prte_state_table_t job_table = {0};
+static prte_state_table_t proc_table = {0};
+/* covers both tables and the generation: a lookup on one thread must not
+ * read an entry another is halfway through rebuilding */
+static pmix_mutex_t table_lock = PMIX_MUTEX_STATIC_INIT;
+
+static pmix_mutex_t caddy_lock = PMIX_MUTEX_STATIC_INIT;
+static prte_state_caddy_t **free_caddies = NULL;
+static int nfree = 0;
+
+static prte_state_caddy_t *batch_head = NULL;
+static prte_state_caddy_t *batch_tail = NULL;
+static prte_event_t batch_ev;
+static bool batch_armed = false;
+static bool batch_ev_set = false;
+
+/* The walk prte_state_base_activate_*_state has always made: the state's
+ * own entry if it has one, else ERROR for an error state and ANY for the
+ * rest.  "job" picks which half of each entry is the key. */
+static prte_state_t *resolve(pmix_list_t *states, bool job, int state, bool *exact)
+{
+    prte_state_t *s, *any = NULL, *error = NULL;
+    int key, anykey, errkey;
+
+    anykey = job ? (int) PRTE_JOB_STATE_ANY : (int) PRTE_PROC_STATE_ANY;
+    errkey = job ? (int) PRTE_JOB_STATE_ERROR : (int) PRTE_PROC_STATE_ERROR;
+    PMIX_LIST_FOREACH(s, states, prte_state_t)
+    {
+        key = job ? (int) s->job_state : (int) s->proc_state;
+        if (anykey == key) {
+            any = s;
+        }
+        if (errkey == key) {
+            error = s;
+        }
+        if (key == state) {
+            *exact = true;
+            return s;
+        }
+    }
+    *exact = false;
+    if (errkey < state && NULL != error) {
+        return error;
+    }
+    return any;
+}
+
+static prte_state_t *lookup(prte_state_table_t *table, pmix_list_t *states, bool job,
+                            int state, bool *exact)
+{
+    prte_state_t *s;
+    int n;
+
+    if (state < 0 || PRTE_STATE_TABLE_SIZE <= state) {
+        return resolve(states, job, state, exact);
+    }
+    pmix_mutex_lock(&table_lock);
+    /* the size of the lists is no guide: a state removed and another added
+     * leaves it where it was, and so does a component tearing its lists
+     * down and building the same number of entries again */
+    if (table->generation != states_generation) {
+        for (n = 0; n < PRTE_STATE_TABLE_SIZE; n++) {
+            table->entries[n].state = resolve(states, job, n, &table->entries[n].exact);
+        }
+        table->generation = states_generation;
+    }
+    *exact = table->entries[state].exact;
+    s = table->entries[state].state;
+    pmix_mutex_unlock(&table_lock);
+    return s;
+}
+
+prte_state_t *prte_state_base_lookup_job_state(prte_job_state_t state, bool *exact)
+{
+    return lookup(&job_table, &prte_job_states, true, (int) state, exact);
+}
+
+prte_state_t *prte_state_base_lookup_proc_state(prte_proc_state_t state, bool *exact)
+{
+    return lookup(&proc_table, &prte_proc_states, false, (int) state, exact);
+}
+
+void prte_state_base_states_changed(void)
+{
+    pmix_mutex_lock(&table_lock);
+    if (0 == ++states_generation) {
+        /* wrapped onto the value a never-built table holds */
+        states_generation = 1;
+    }
+    pmix_mutex_unlock(&table_lock);
+}
+
+prte_state_caddy_t *prte_state_base_caddy_get(void)
+{
+    prte_state_caddy_t *caddy = NULL;
+
+    pmix_mutex_lock(&caddy_lock);
+    if (0 < nfree) {
+        caddy = free_caddies[--nfree];
+    }
+    pmix_mutex_unlock(&caddy_lock);
+    if (NULL == caddy) {
+        caddy = PMIX_NEW(prte_state_caddy_t);
+    }
+    return caddy;
+}
+
+/* The handler has let go of this caddy and nobody else holds it: return it
+ * to the cache in the state the constructor leaves a new one in. */
+static void caddy_put(prte_state_caddy_t *caddy)
+{
+    if (NULL != caddy->jdata) {
+        PMIX_RELEASE(caddy->jdata);
+    }
+    memset(&caddy->ev, 0, sizeof(prte_event_t));
+    caddy->jdata = NULL;
+    caddy->job_state = PRTE_JOB_STATE_UNDEF;
+    PMIX_LOAD_PROCID(&caddy->name, NULL, PMIX_RANK_INVALID);
+    caddy->proc_state = PRTE_PROC_STATE_UNDEF;
+    caddy->cbfunc = NULL;
+    caddy->next = NULL;
+
+    pmix_mutex_lock(&caddy_lock);
+    if (NULL == free_caddies && 0 < prte_state_base.caddy_cache) {
+        free_caddies = (prte_state_caddy_t **) calloc(prte_state_base.caddy_cache,
+                                                      sizeof(prte_state_caddy_t *));
+    }
+    if (NULL != free_caddies && nfree < prte_state_base.caddy_cache) {
+        free_caddies[nfree++] = caddy;
+        caddy = NULL;
+    }
+    pmix_mutex_unlock(&caddy_lock);
+    if (NULL != caddy) {
+        PMIX_RELEASE(caddy);
+    }
+}
+
+/* Run one activation's handler.  It releases the caddy when it is done,
+ * exactly as when libevent called it directly; the reference taken here
+ * is what tells us afterwards whether it kept one. */
+static void run_caddy(prte_state_caddy_t *caddy)
+{
+    prte_state_cbfunc_t cbfunc = caddy->cbfunc;
+
+    PMIX_RETAIN(caddy);
+    cbfunc(-1, PRTE_EV_WRITE, caddy);
+    if (1 == caddy->super.obj_reference_count) {
+        caddy_put(caddy);
+    } else {
+        PMIX_RELEASE(caddy);
+    }
+}
+
+static void run_one(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+    run_caddy(caddy);
+}
+
+static void run_batch(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy, *next;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args, cbdata);
+
+    /* take the queue as it stands - whatever the handlers activate goes on
+     * a new one, and runs on the next pass of the event loop as it would
+     * have with an event of its own */
+    pmix_mutex_lock(&caddy_lock);
+    caddy = batch_head;
+    batch_head = NULL;
+    batch_tail = NULL;
+    batch_armed = false;
+    pmix_mutex_unlock(&caddy_lock);
+
+    while (NULL != caddy) {
+        next = caddy->next;
+        caddy->next = NULL;
+        PMIX_ACQUIRE_OBJECT(caddy);
+        run_caddy(caddy);
+        caddy = next;
+    }
+}
+
+void prte_state_base_dispatch(prte_state_caddy_t *caddy, prte_state_cbfunc_t cbfunc)
+{
+    bool arm = false;
+
+    caddy->cbfunc = cbfunc;
+    if (!prte_state_base.batch) {
+        PRTE_PMIX_THREADSHIFT(caddy, prte_event_base, run_one);
+        return;
+    }
+
+    PMIX_POST_OBJECT(caddy);
+    pmix_mutex_lock(&caddy_lock);
+    if (NULL == batch_tail) {
+        batch_head = caddy;
+    } else {
+        batch_tail->next = caddy;
+    }
+    batch_tail = caddy;
+    if (!batch_armed) {
+        batch_armed = true;
+        arm = true;
+        if (!batch_ev_set) {
+            prte_event_set(prte_event_base, &batch_ev, -1, PRTE_EV_WRITE, run_batch, NULL);
+            batch_ev_set = true;
+        }
+    }
+    pmix_mutex_unlock(&caddy_lock);
+    if (arm) {
+        prte_event_active(&batch_ev, PRTE_EV_WRITE, 1);
+    }
+}
+
+void prte_state_base_dispatch_finalize(void)
+{
+    prte_state_caddy_t *caddy;
+
+    /* activations still queued never ran, and now never will */
+    while (NULL != (caddy = batch_head)) {
+        batch_head = caddy->next;
+        PMIX_RELEASE(caddy);
+    }
+    batch_tail = NULL;
+    if (batch_ev_set) {
+        prte_event_del(&batch_ev);
+        batch_ev_set = false;
+    }
+    batch_armed = false;
+
+    while (0 < nfree) {
+        PMIX_RELEASE(free_caddies[--nfree]);
+    }
+    free(free_caddies);
+    free_caddies = NULL;
+    prte_state_base_states_changed();
+}
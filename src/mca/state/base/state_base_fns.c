@@ -48,71 +48,47 @@
 
 void prte_state_base_activate_job_state(prte_job_t *jdata, prte_job_state_t state)
 {
-    pmix_list_item_t *itm, *any = NULL, *error = NULL;
     prte_state_t *s;
     prte_state_caddy_t *caddy;
+    bool exact;
 
-    for (itm = pmix_list_get_first(&prte_job_states); itm != pmix_list_get_end(&prte_job_states);
-         itm = pmix_list_get_next(itm)) {
-        s = (prte_state_t *) itm;
-        if (s->job_state == PRTE_JOB_STATE_ANY) {
-            /* save this place */
-            any = itm;
-        }
-        if (s->job_state == PRTE_JOB_STATE_ERROR) {
-            error = itm;
-        }
-        if (s->job_state == state) {
-            PRTE_REACHING_JOB_STATE(jdata, state);
-            if (NULL == s->cbfunc) {
-                PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR JOB %s STATE %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                     (NULL == jdata) ? "ALL" : PRTE_JOBID_PRINT(jdata->nspace),
-                                     prte_job_state_to_str(state)));
-                return;
-            }
-            caddy = PMIX_NEW(prte_state_caddy_t);
-            /* the state is always recorded, even when no job accompanies it -
-             * handlers reached via the ERROR/ANY fallback read it to decide
-             * what happened */
-            caddy->job_state = state;
-            if (NULL != jdata) {
-                caddy->jdata = jdata;
-                PMIX_RETAIN(jdata);
-            }
-            PRTE_PMIX_THREADSHIFT(caddy, prte_event_base, s->cbfunc);
-            return;
-        }
-    }
-    /* if we get here, then the state wasn't found, so execute
-     * the default handler if it is defined
-     */
-    if (PRTE_JOB_STATE_ERROR < state && NULL != error) {
-        s = (prte_state_t *) error;
-    } else if (NULL != any) {
-        s = (prte_state_t *) any;
-    } else {
+    s = prte_state_base_lookup_job_state(state, &exact);
+    if (NULL == s) {
         PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
                              "ACTIVATE: JOB STATE %s NOT REGISTERED",
                              prte_job_state_to_str(state)));
         return;
     }
+    if (exact) {
+        PRTE_REACHING_JOB_STATE(jdata, state);
+    }
     if (NULL == s->cbfunc) {
-        PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
-                             "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
+        if (exact) {
+            PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                                 "%s NULL CBFUNC FOR JOB %s STATE %s",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                 (NULL == jdata) ? "ALL" : PRTE_JOBID_PRINT(jdata->nspace),
+                                 prte_job_state_to_str(state)));
+        } else {
+            PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                                 "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
+        }
         return;
     }
-    caddy = PMIX_NEW(prte_state_caddy_t);
-    /* record the state that actually fired, not the fallback we matched -
-     * this is the only way the ERROR/ANY handler can tell what happened */
+    caddy = prte_state_base_caddy_get();
+    /* the state is always recorded, even when no job accompanies it, and it
+     * is the state that actually fired rather than the fallback we matched -
+     * handlers reached via the ERROR/ANY fallback read it to decide what
+     * happened */
     caddy->job_state = state;
     if (NULL != jdata) {
         caddy->jdata = jdata;
         PMIX_RETAIN(jdata);
     }
-    PRTE_REACHING_JOB_STATE(jdata, state);
-    PRTE_PMIX_THREADSHIFT(caddy, prte_event_base, s->cbfunc);
+    if (!exact) {
+        PRTE_REACHING_JOB_STATE(jdata, state);
+    }
+    prte_state_base_dispatch(caddy, s->cbfunc);
 }
 
 int prte_state_base_add_job_state(prte_job_state_t state, prte_state_cbfunc_t cbfunc)
@@ -132,6 +108,7 @@ int prte_state_base_add_job_state(prte_job_state_t state, prte_state_cbfunc_t cb
     st->job_state = state;
     st->cbfunc = cbfunc;
     pmix_list_append(&prte_job_states, &(st->super));
+    prte_state_base_states_changed();
 
     return PRTE_SUCCESS;
 }
@@ -155,6 +132,7 @@ int prte_state_base_set_job_state_callback(prte_job_state_t state, prte_state_cb
     st->job_state = state;
     st->cbfunc = cbfunc;
     pmix_list_append(&prte_job_states, &(st->super));
+    prte_state_base_states_changed();
 
     return PRTE_SUCCESS;
 }
@@ -170,6 +148,7 @@ int prte_state_base_remove_job_state(prte_job_state_t state)
         if (st->job_state == state) {
             pmix_list_remove_item(&prte_job_states, item);
             PMIX_RELEASE(item);
+            prte_state_base_states_changed();
             return PRTE_SUCCESS;
         }
     }
@@ -193,9 +172,9 @@ void prte_state_base_print_job_state_machine(void)
 /****    PROC STATE MACHINE    ****/
 void prte_state_base_activate_proc_state(pmix_proc_t *proc, prte_proc_state_t state)
 {
-    pmix_list_item_t *itm, *any = NULL, *error = NULL;
     prte_state_t *s;
     prte_state_caddy_t *caddy;
+    bool exact;
 
     /* the proc machine is keyed entirely on the name - there is nothing
      * to dispatch without one */
@@ -206,54 +185,34 @@ void prte_state_base_activate_proc_state(pmix_proc_t *proc, prte_proc_state_t st
         return;
     }
 
-    for (itm = pmix_list_get_first(&prte_proc_states); itm != pmix_list_get_end(&prte_proc_states);
-         itm = pmix_list_get_next(itm)) {
-        s = (prte_state_t *) itm;
-        if (s->proc_state == PRTE_PROC_STATE_ANY) {
-            /* save this place */
-            any = itm;
-        }
-        if (s->proc_state == PRTE_PROC_STATE_ERROR) {
-            error = itm;
-        }
-        if (s->proc_state == state) {
-            PRTE_REACHING_PROC_STATE(proc, state);
-            if (NULL == s->cbfunc) {
-                PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
-                                     "%s NULL CBFUNC FOR PROC %s STATE %s",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(proc),
-                                     prte_proc_state_to_str(state)));
-                return;
-            }
-            caddy = PMIX_NEW(prte_state_caddy_t);
-            caddy->name = *proc;
-            caddy->proc_state = state;
-            PRTE_PMIX_THREADSHIFT(caddy, prte_event_base, s->cbfunc);
-            return;
-        }
-    }
-    /* if we get here, then the state wasn't found, so execute
-     * the default handler if it is defined
-     */
-    if (PRTE_PROC_STATE_ERROR < state && NULL != error) {
-        s = (prte_state_t *) error;
-    } else if (NULL != any) {
-        s = (prte_state_t *) any;
-    } else {
+    s = prte_state_base_lookup_proc_state(state, &exact);
+    if (NULL == s) {
         PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
                              "INCREMENT: ANY STATE NOT FOUND"));
         return;
     }
+    if (exact) {
+        PRTE_REACHING_PROC_STATE(proc, state);
+    }
     if (NULL == s->cbfunc) {
-        PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
-                             "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
+        if (exact) {
+            PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                                 "%s NULL CBFUNC FOR PROC %s STATE %s",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(proc),
+                                 prte_proc_state_to_str(state)));
+        } else {
+            PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                                 "ACTIVATE: ANY STATE HANDLER NOT DEFINED"));
+        }
         return;
     }
-    caddy = PMIX_NEW(prte_state_caddy_t);
+    caddy = prte_state_base_caddy_get();
     caddy->name = *proc;
     caddy->proc_state = state;
-    PRTE_REACHING_PROC_STATE(proc, state);
-    PRTE_PMIX_THREADSHIFT(caddy, prte_event_base, s->cbfunc);
+    if (!exact) {
+        PRTE_REACHING_PROC_STATE(proc, state);
+    }
+    prte_state_base_dispatch(caddy, s->cbfunc);
 }
 
 int prte_state_base_add_proc_state(prte_proc_state_t state, prte_state_cbfunc_t cbfunc)
@@ -276,6 +235,7 @@ int prte_state_base_add_proc_state(prte_proc_state_t state, prte_state_cbfunc_t
     st->proc_state = state;
     st->cbfunc = cbfunc;
     pmix_list_append(&prte_proc_states, &(st->super));
+    prte_state_base_states_changed();
 
     return PRTE_SUCCESS;
 }
@@ -307,6 +267,7 @@ int prte_state_base_remove_proc_state(prte_proc_state_t state)
         if (st->proc_state == state) {
             pmix_list_remove_item(&prte_proc_states, item);
             PMIX_RELEASE(item);
+            prte_state_base_states_changed();
             return PRTE_SUCCESS;
         }
     }
@@ -954,6 +915,7 @@ next:
         if (node_idx < INT_MAX) {
             /* set the node location to NULL */
             pmix_pointer_array_set_item(map->nodes, node_idx, NULL);
+            prte_job_map_daemons_stale(map);
         }
         /* flag that the node is no longer in a map.  This must happen BEFORE
          * the release below: the map holds a reference, and dropping it can
@@ -966,4 +928,6 @@ next:
     // release the scratch bitmap
     hwloc_bitmap_free(boundcpus);
 
+    // a queued job may fit now
+    prte_state_base_queue_kick();
 }
@@ -103,6 +103,33 @@ static int prte_state_base_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                &prte_state_base.autorestart);
 
+    prte_state_base.batch = false;
+    pmix_mca_base_var_register("prte", "state", "base", "batch",
+                               "Queue state activations and run every one pending from a single event, "
+                               "rather than arming an event for each",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_state_base.batch);
+
+    prte_state_base.caddy_cache = 256;
+    pmix_mca_base_var_register("prte", "state", "base", "caddy_cache",
+                               "Number of finished state caddies to keep for reuse (0 = free each one)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT,
+                               &prte_state_base.caddy_cache);
+
+    prte_state_base.job_queue = false;
+    pmix_mca_base_var_register("prte", "state", "base", "job_queue",
+                               "In a persistent DVM, hold a job whose procs do not fit the free slots "
+                               "until they do, rather than failing to map it",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_state_base.job_queue);
+
+    prte_state_base.queue_backfill = true;
+    pmix_mca_base_var_register("prte", "state", "base", "queue_backfill",
+                               "Let a job that fits the free slots start ahead of queued jobs that do "
+                               "not (false = start queued jobs strictly in arrival order)",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_state_base.queue_backfill);
+
     return PRTE_SUCCESS;
 }
 
@@ -112,6 +139,8 @@ static int prte_state_base_close(void)
     if (NULL != prte_state.finalize) {
         prte_state.finalize();
     }
+    prte_state_base_queue_finalize();
+    prte_state_base_dispatch_finalize();
 
     return pmix_mca_base_framework_components_close(&prte_state_base_framework, NULL);
 }
@@ -153,6 +182,8 @@ static void prte_state_caddy_construct(prte_state_caddy_t *caddy)
     caddy->job_state = PRTE_JOB_STATE_UNDEF;
     PMIX_LOAD_PROCID(&caddy->name, NULL, PMIX_RANK_INVALID);
     caddy->proc_state = PRTE_PROC_STATE_UNDEF;
+    caddy->cbfunc = NULL;
+    caddy->next = NULL;
 }
 static void prte_state_caddy_destruct(prte_state_caddy_t *caddy)
 {
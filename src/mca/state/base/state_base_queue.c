@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * The DVM's job queue.
+ *
+ * Without it a job that asks for more slots than are free when it reaches
+ * the mapper fails to map, and the submitter has to try again later.  With
+ * state_base_job_queue set, the DVM's MAP callback first counts the job's
+ * procs against the free slots: a job that fits is mapped at once, one that
+ * does not is held here, in arrival order, until enough slots come back.
+ *
+ * Slots come back one proc at a time through
+ * prte_state_base_recover_resources and a job at a time through the DVM's
+ * job completion, and both kick the queue.  A burst of kicks is one pass:
+ * it sweeps the node pool once into a count of the free slots and walks
+ * the queue against that count, taking off each job it starts, so a pass
+ * is one walk over the nodes plus one step per queued job - no queued job
+ * is put through the mapper to find out whether it fits.
+ *
+ * With state_base_queue_backfill (the default), a job that fits may start
+ * ahead of an earlier one that does not, whether it is newly arrived or
+ * already queued.  That keeps the slots busy on a many-task workload, but
+ * nothing here knows how long a job will run, so a steady stream of small
+ * jobs can hold a large one off indefinitely - turn backfill off for strict
+ * arrival order.
+ *
+ * Only a job whose size is known before mapping and which the mapper would
+ * place on the free slots alone is held: every app gives its proc count,
+ * none names its own hosts or adds to the allocation, the job may not
+ * oversubscribe, and it was not spawned by a running job (which could be
+ * waiting on it while holding slots of its own).  Anything else - and a job
+ * bigger than the whole DVM - goes straight to the mapper as it always did.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/class/pmix_list.h"
+#include "src/event/event-internal.h"
+#include "src/mca/rmaps/base/base.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/attr.h"
+#include "src/util/error_strings.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_output.h"
+#include "src/util/prte_profile.h"
+
+#include "src/mca/state/base/base.h"
+
+typedef struct {
+    pmix_list_item_t super;
+    prte_job_t *jdata;
+    int32_t nprocs;
+    bool nolocal;
+    prte_profile_mark_t queued;
+} prte_state_queued_job_t;
+
+static void qcon(prte_state_queued_job_t *q)
+{
+    q->jdata = NULL;
+    q->nprocs = 0;
+    q->nolocal = false;
+    memset(&q->queued, 0, sizeof(q->queued));
+}
+static void qdes(prte_state_queued_job_t *q)
+{
+    if (NULL != q->jdata) {
+        PMIX_RELEASE(q->jdata);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_state_queued_job_t, pmix_list_item_t, qcon, qdes);
+
+static pmix_list_t queue = PMIX_LIST_STATIC_INIT;
+static prte_event_t pass_ev;
+static bool pass_armed = false;
+static bool pass_ev_set = false;
+
+/* for the summary at finalize */
+static uint64_t nqueued = 0;
+static uint64_t nstarted = 0;
+static uint64_t nbackfilled = 0;
+static uint64_t wait_total_us = 0;
+static uint64_t wait_max_us = 0;
+
+void prte_state_base_slot_index(prte_state_slot_index_t *idx)
+{
+    prte_node_t *node;
+    int32_t slots, avail;
+    int i;
+
+    memset(idx, 0, sizeof(*idx));
+    /* the nodes get_target_nodes would offer the mapper */
+    for (i = 0; i < prte_node_pool->size; i++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, i);
+        if (NULL == node) {
+            continue;
+        }
+        if (PRTE_FLAG_TEST(node, PRTE_NODE_NON_USABLE) ||
+            PRTE_NODE_STATE_DOWN == node->state ||
+            PRTE_NODE_STATE_NOT_INCLUDED == node->state ||
+            NULL == node->daemon || NULL == node->topology) {
+            continue;
+        }
+        if (0 == node->index && !prte_hnp_is_allocated) {
+            continue;
+        }
+        slots = node->slots;
+        if (0 != node->slots_max && node->slots_max < slots) {
+            slots = node->slots_max;
+        }
+        avail = slots - node->slots_inuse;
+        if (avail < 0) {
+            avail = 0;
+        }
+        idx->capacity += slots;
+        idx->free += avail;
+        if (0 == node->index) {
+            idx->local_capacity = slots;
+            idx->local_free = avail;
+        }
+    }
+}
+
+static bool may_oversubscribe(prte_job_t *jdata)
+{
+    prte_app_context_t *app;
+    prte_mapping_policy_t pol;
+    uint16_t u16, *u16ptr = &u16;
+    int i;
+
+    /* the same precedence prte_rmaps_base_hoist_job_directives and
+     * prte_rmaps_base_map_job apply: the job, then its apps, then the
+     * default */
+    if (NULL != jdata->map &&
+        (PRTE_MAPPING_SUBSCRIBE_GIVEN & PRTE_GET_MAPPING_DIRECTIVE(jdata->map->mapping))) {
+        return !(PRTE_MAPPING_NO_OVERSUBSCRIBE & PRTE_GET_MAPPING_DIRECTIVE(jdata->map->mapping));
+    }
+    for (i = 0; i < jdata->apps->size; i++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, i);
+        if (NULL == app) {
+            continue;
+        }
+        if (prte_get_attribute(&app->attributes, PRTE_APP_MAPBY, (void **) &u16ptr, PMIX_UINT16)) {
+            pol = u16;
+            if (PRTE_MAPPING_SUBSCRIBE_GIVEN & PRTE_GET_MAPPING_DIRECTIVE(pol)) {
+                return !(PRTE_MAPPING_NO_OVERSUBSCRIBE & PRTE_GET_MAPPING_DIRECTIVE(pol));
+            }
+        }
+    }
+    if (PRTE_MAPPING_SUBSCRIBE_GIVEN & PRTE_GET_MAPPING_DIRECTIVE(prte_rmaps_base.mapping)) {
+        return !(PRTE_MAPPING_NO_OVERSUBSCRIBE & PRTE_GET_MAPPING_DIRECTIVE(prte_rmaps_base.mapping));
+    }
+    return false;
+}
+
+static bool spawned_by_app(prte_job_t *jdata)
+{
+    pmix_proc_t *nptr = NULL;
+    prte_job_t *parent;
+    bool ret = false;
+
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_LAUNCH_PROXY, (void **) &nptr, PMIX_PROC) &&
+        NULL != nptr) {
+        if (!PMIX_CHECK_NSPACE(PRTE_PROC_MY_NAME->nspace, nptr->nspace) &&
+            NULL != (parent = prte_get_job_data_object(nptr->nspace)) &&
+            !PRTE_FLAG_TEST(parent, PRTE_JOB_FLAG_TOOL)) {
+            ret = true;
+        }
+    }
+    if (NULL != nptr) {
+        PMIX_PROC_RELEASE(nptr);
+    }
+    return ret;
+}
+
+bool prte_state_base_queue_need(prte_job_t *jdata, int32_t *nprocs, bool *nolocal)
+{
+    prte_app_context_t *app;
+    prte_mapping_policy_t pol;
+    int i;
+
+    *nprocs = 0;
+    *nolocal = false;
+
+    /* the daemons' own job is mapped as the DVM starts.  A plain compare:
+     * PMIX_CHECK_NSPACE takes an empty nspace as a match for anything */
+    if (0 == strncmp(PRTE_PROC_MY_NAME->nspace, jdata->nspace, PMIX_MAX_NSLEN) ||
+        PRTE_FLAG_TEST(jdata, PRTE_JOB_FLAG_TOOL)) {
+        return false;
+    }
+    if (NULL != jdata->session && prte_default_session != jdata->session) {
+        return false;
+    }
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
+        return false;
+    }
+    for (i = 0; i < jdata->apps->size; i++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, i);
+        if (NULL == app) {
+            continue;
+        }
+        /* zero means "fill what you find", which only the mapper can size */
+        if (0 == app->num_procs || PRTE_FLAG_TEST(app, PRTE_APP_FLAG_TOOL)) {
+            return false;
+        }
+        if (prte_get_attribute(&app->attributes, PRTE_APP_DASH_HOST, NULL, PMIX_STRING) ||
+            prte_get_attribute(&app->attributes, PRTE_APP_HOSTFILE, NULL, PMIX_STRING) ||
+            prte_get_attribute(&app->attributes, PRTE_APP_ADD_HOST, NULL, PMIX_STRING) ||
+            prte_get_attribute(&app->attributes, PRTE_APP_ADD_HOSTFILE, NULL, PMIX_STRING)) {
+            return false;
+        }
+        *nprocs += app->num_procs;
+    }
+    if (0 == *nprocs || may_oversubscribe(jdata) || spawned_by_app(jdata)) {
+        return false;
+    }
+
+    if (NULL != jdata->map) {
+        pol = jdata->map->mapping;
+    } else {
+        pol = prte_rmaps_base.mapping;
+    }
+    *nolocal = (PRTE_MAPPING_NO_USE_LOCAL & PRTE_GET_MAPPING_DIRECTIVE(pol));
+    return true;
+}
+
+static bool fits(const prte_state_slot_index_t *idx, int32_t nprocs, bool nolocal)
+{
+    return nprocs <= (nolocal ? idx->free - idx->local_free : idx->free);
+}
+
+static bool ever_fits(const prte_state_slot_index_t *idx, int32_t nprocs, bool nolocal)
+{
+    return nprocs <= (nolocal ? idx->capacity - idx->local_capacity : idx->capacity);
+}
+
+/* Count a job's procs as taken, so the rest of the pass does not offer the
+ * same slots twice - the free slots left on the HNP's node go first only
+ * for a job that may use them */
+static void take(prte_state_slot_index_t *idx, int32_t nprocs, bool nolocal)
+{
+    int32_t remote = idx->free - idx->local_free;
+
+    idx->free -= nprocs;
+    if (!nolocal && nprocs > remote) {
+        idx->local_free -= nprocs - remote;
+    }
+}
+
+/* Map the job now, in this event, so the slots it was counted against
+ * are still free when the mapper looks.  The caddy takes over the queue's
+ * reference to the job and the mapper releases it. */
+static void start(prte_state_queued_job_t *q)
+{
+    prte_state_caddy_t *caddy;
+    prte_profile_mark_t now;
+    uint64_t wait_us;
+
+    prte_profile_mark(&now);
+    wait_us = prte_profile_elapsed_us(&q->queued, &now);
+    ++nstarted;
+    wait_total_us += wait_us;
+    if (wait_max_us < wait_us) {
+        wait_max_us = wait_us;
+    }
+    pmix_output_verbose(1, prte_state_base_framework.framework_output,
+                        "%s state:queue starting job %s after %.3f seconds in the queue",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(q->jdata->nspace),
+                        (double) wait_us / 1000000.0);
+    PRTE_PROFILE_STAGE("queue_wait", q->jdata->nspace, &q->queued, 0);
+
+    caddy = prte_state_base_caddy_get();
+    caddy->jdata = q->jdata;
+    caddy->job_state = PRTE_JOB_STATE_MAP;
+    q->jdata = NULL;
+    prte_rmaps_base_map_job(-1, PRTE_EV_WRITE, caddy);
+}
+
+static void run_pass(int fd, short args, void *cbdata)
+{
+    prte_state_queued_job_t *q, *next;
+    prte_state_slot_index_t idx;
+    bool blocked = false;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args, cbdata);
+
+    pass_armed = false;
+    prte_state_base_slot_index(&idx);
+
+    PMIX_LIST_FOREACH_SAFE(q, next, &queue, prte_state_queued_job_t) {
+        /* it was killed or cancelled while it waited */
+        if (PRTE_JOB_STATE_UNTERMINATED < q->jdata->state ||
+            prte_get_attribute(&q->jdata->attributes, PRTE_JOB_CANCELLED, NULL, PMIX_BOOL)) {
+            pmix_output_verbose(1, prte_state_base_framework.framework_output,
+                                "%s state:queue dropping job %s in state %s",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                PRTE_JOBID_PRINT(q->jdata->nspace),
+                                prte_job_state_to_str(q->jdata->state));
+            pmix_list_remove_item(&queue, &q->super);
+            PMIX_RELEASE(q);
+            continue;
+        }
+        if (blocked) {
+            continue;
+        }
+        if (!fits(&idx, q->nprocs, q->nolocal)) {
+            /* without backfill, nothing passes the first job that waits */
+            blocked = !prte_state_base.queue_backfill;
+            continue;
+        }
+        take(&idx, q->nprocs, q->nolocal);
+        pmix_list_remove_item(&queue, &q->super);
+        start(q);
+        PMIX_RELEASE(q);
+    }
+}
+
+void prte_state_base_queue_kick(void)
+{
+    if (pass_armed || 0 == pmix_list_get_size(&queue)) {
+        return;
+    }
+    pass_armed = true;
+    if (!pass_ev_set) {
+        prte_event_set(prte_event_base, &pass_ev, -1, PRTE_EV_WRITE, run_pass, NULL);
+        pass_ev_set = true;
+    }
+    prte_event_active(&pass_ev, PRTE_EV_WRITE, 1);
+}
+
+void prte_state_base_queue_map(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    prte_job_t *jdata = caddy->jdata;
+    prte_state_queued_job_t *q;
+    prte_state_slot_index_t idx;
+    int32_t nprocs;
+    bool nolocal;
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+
+    if (!prte_state_base.job_queue || NULL == jdata ||
+        !prte_state_base_queue_need(jdata, &nprocs, &nolocal)) {
+        prte_rmaps_base_map_job(fd, args, caddy);
+        return;
+    }
+
+    prte_state_base_slot_index(&idx);
+    if (fits(&idx, nprocs, nolocal)) {
+        if (0 == pmix_list_get_size(&queue)) {
+            prte_rmaps_base_map_job(fd, args, caddy);
+            return;
+        }
+        if (prte_state_base.queue_backfill) {
+            ++nbackfilled;
+            pmix_output_verbose(2, prte_state_base_framework.framework_output,
+                                "%s state:queue job %s of %d procs backfilled past %d queued",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                                (int) nprocs, (int) pmix_list_get_size(&queue));
+            prte_rmaps_base_map_job(fd, args, caddy);
+            return;
+        }
+    } else if (!ever_fits(&idx, nprocs, nolocal)) {
+        /* waiting will not help - let the mapper say why */
+        prte_rmaps_base_map_job(fd, args, caddy);
+        return;
+    }
+
+    q = PMIX_NEW(prte_state_queued_job_t);
+    PMIX_RETAIN(jdata);
+    q->jdata = jdata;
+    q->nprocs = nprocs;
+    q->nolocal = nolocal;
+    prte_profile_mark(&q->queued);
+    jdata->state = PRTE_JOB_STATE_QUEUED;
+    pmix_list_append(&queue, &q->super);
+    ++nqueued;
+
+    pmix_output_verbose(1, prte_state_base_framework.framework_output,
+                        "%s state:queue job %s of %d procs queued with %d of %d slots free - %d waiting",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace),
+                        (int) nprocs, (int) (nolocal ? idx.free - idx.local_free : idx.free),
+                        (int) (nolocal ? idx.capacity - idx.local_capacity : idx.capacity),
+                        (int) pmix_list_get_size(&queue));
+
+    PMIX_RELEASE(caddy);
+}
+
+size_t prte_state_base_queue_depth(void)
+{
+    return pmix_list_get_size(&queue);
+}
+
+void prte_state_base_queue_finalize(void)
+{
+    prte_state_queued_job_t *q;
+
+    if (0 < nqueued) {
+        pmix_output_verbose(1, prte_state_base_framework.framework_output,
+                            "%s state:queue %llu jobs queued, %llu started from the queue "
+                            "(mean wait %.3f s, max %.3f s), %llu backfilled, %d never started",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned long long) nqueued,
+                            (unsigned long long) nstarted,
+                            (0 == nstarted) ? 0.0
+                                            : (double) wait_total_us / nstarted / 1000000.0,
+                            (double) wait_max_us / 1000000.0, (unsigned long long) nbackfilled,
+                            (int) pmix_list_get_size(&queue));
+    }
+    while (NULL != (q = (prte_state_queued_job_t *) pmix_list_remove_first(&queue))) {
+        PMIX_RELEASE(q);
+    }
+    if (pass_ev_set) {
+        prte_event_del(&pass_ev);
+        pass_ev_set = false;
+    }
+    pass_armed = false;
+    nqueued = nstarted = nbackfilled = 0;
+    wait_total_us = wait_max_us = 0;
+}
@@ -29,6 +29,7 @@
 #include "src/util/pmix_os_dirpath.h"
 #include "src/util/pmix_output.h"
 #include "src/util/proc_info.h"
+#include "src/util/prte_profile.h"
 #include "src/util/session_dir.h"
 #include "src/util/pmix_show_help.h"
 #include "src/util/prte_show_help.h"
@@ -121,7 +122,7 @@ static prte_state_cbfunc_t launch_callbacks[] = {
     prte_plm_base_daemons_launched,
     prte_plm_base_daemons_reported,
     vm_ready,
-    prte_rmaps_base_map_job,
+    prte_state_base_queue_map,
     prte_plm_base_mapping_complete,
     prte_plm_base_complete_setup,
     prte_plm_base_launch_apps,
@@ -183,6 +184,8 @@ static int init(void)
     /* setup the state machines */
     PMIX_CONSTRUCT(&prte_job_states, pmix_list_t);
     PMIX_CONSTRUCT(&prte_proc_states, pmix_list_t);
+    /* nothing resolved from lists before these is valid now */
+    prte_state_base_states_changed();
 
     /* setup the job state machine */
     num_states = sizeof(launch_states) / sizeof(prte_job_state_t);
@@ -234,6 +237,7 @@ static int finalize(void)
     /* cleanup the state machines */
     PMIX_LIST_DESTRUCT(&prte_proc_states);
     PMIX_LIST_DESTRUCT(&prte_job_states);
+    prte_state_base_states_changed();
 
     return PRTE_SUCCESS;
 }
@@ -266,13 +270,15 @@ static void vm_ready(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
     int rc, i;
-    pmix_data_buffer_t buf;
+    pmix_data_buffer_t buf, snap;
+    pmix_bitmap_t joiners;
     prte_job_t *jptr;
     prte_proc_t *dmn;
     int32_t v;
     uint32_t epoch;
     pmix_value_t *val, *sval;
     pmix_status_t ret;
+    prte_profile_mark_t mark;
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
     PMIX_ACQUIRE_OBJECT(caddy);
@@ -286,7 +292,20 @@ static void vm_ready(int fd, short args, void *cbdata)
              * do this here so we don't have to do it for every
              * job we are going to launch */
             PMIX_DATA_BUFFER_CONSTRUCT(&buf);
-            rc = prte_util_nidmap_create(prte_node_pool, &buf);
+            PMIX_DATA_BUFFER_CONSTRUCT(&snap);
+            PMIX_CONSTRUCT(&joiners, pmix_bitmap_t);
+            PRTE_PROFILE_MARK(&mark);
+            /* only what changed since the map the daemons already hold */
+            rc = prte_util_nidmap_pack_update(prte_node_pool, &buf, &joiners, &snap);
+            if (PRTE_SUCCESS == rc && 0 < snap.bytes_used) {
+                /* ...and a full one for the daemons that have just joined,
+                 * to them alone.  It must be out ahead of the WIREUP below,
+                 * whose delta they cannot apply without it. */
+                rc = prte_grpcomm_xcast_pruned(PRTE_RML_TAG_NIDMAP_SNAPSHOT, &snap,
+                                               &joiners, NULL, NULL);
+            }
+            PMIX_DATA_BUFFER_DESTRUCT(&snap);
+            PMIX_DESTRUCT(&joiners);
             if (PRTE_SUCCESS != rc) {
                 PRTE_ERROR_LOG(rc);
                 PMIX_DATA_BUFFER_DESTRUCT(&buf);
@@ -314,6 +333,7 @@ static void vm_ready(int fd, short args, void *cbdata)
                 PMIX_RELEASE(caddy);
                 return;
             }
+            PRTE_PROFILE_STAGE("nidmap", caddy->jdata->nspace, &mark, buf.bytes_used);
 
             /* ...and the collective recovery epoch this DVM has reached.  A
              * daemon that just joined starts at zero, and every fence or group
@@ -1036,6 +1056,7 @@ release:
             }
             /* set the node location to NULL */
             pmix_pointer_array_set_item(map->nodes, index, NULL);
+            prte_job_map_daemons_stale(map);
             /* flag that the node is no longer in a map.  This has to precede
              * the release: the map holds a reference, and dropping it may be
              * the last one */
@@ -1046,6 +1067,8 @@ release:
         hwloc_bitmap_free(boundcpus);
         PMIX_RELEASE(map);
         jdata->map = NULL;
+        /* a queued job may fit now */
+        prte_state_base_queue_kick();
     }
     // if this job has apps that named a pset, then remove them
     PMIX_LIST_FOREACH_SAFE(pst, pst2, &prte_pmix_server_globals.psets, prte_pmix_server_pset_t) {
@@ -103,6 +103,8 @@ static int init(void)
     /* setup the state machine */
     PMIX_CONSTRUCT(&prte_job_states, pmix_list_t);
     PMIX_CONSTRUCT(&prte_proc_states, pmix_list_t);
+    /* nothing resolved from lists before these is valid now */
+    prte_state_base_states_changed();
 
     num_states = sizeof(job_states) / sizeof(prte_job_state_t);
     for (i = 0; i < num_states; i++) {
@@ -146,6 +148,7 @@ static int finalize(void)
     /* cleanup the state machines */
     PMIX_LIST_DESTRUCT(&prte_proc_states);
     PMIX_LIST_DESTRUCT(&prte_job_states);
+    prte_state_base_states_changed();
 
     return PRTE_SUCCESS;
 }
@@ -665,6 +668,7 @@ static void job_teardown(int fd, short argc, void *cbdata)
             }
             /* set the node location to NULL */
             pmix_pointer_array_set_item(map->nodes, index, NULL);
+            prte_job_map_daemons_stale(map);
             /* flag that the node is no longer in a map.  This has to
              * precede the release: the map holds a reference, and
              * dropping it may be the last one */
@@ -65,13 +65,16 @@ typedef struct {
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_state_t);
 
 /* caddy for passing job and proc data to state event handlers */
-typedef struct {
+typedef struct prte_state_caddy_t {
     pmix_object_t super;
     prte_event_t ev;
     prte_job_t *jdata;
     prte_job_state_t job_state;
     pmix_proc_t name;
     prte_proc_state_t proc_state;
+    /* the dispatcher's own - handlers never need them */
+    prte_state_cbfunc_t cbfunc;
+    struct prte_state_caddy_t *next;
 } prte_state_caddy_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_state_caddy_t);
 
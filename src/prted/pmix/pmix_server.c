@@ -1236,6 +1236,12 @@ void pmix_server_start(void)
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_MONITOR_RESP,
                   PRTE_RML_PERSISTENT, pmix_server_monitor_resp, NULL);
 
+    /* setup recvs for DVM-wide traffic queries */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_TRAFFIC_REQUEST,
+                  PRTE_RML_PERSISTENT, pmix_server_traffic_request, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_TRAFFIC_RESP,
+                  PRTE_RML_PERSISTENT, pmix_server_traffic_resp, NULL);
+
     // setup recv for logging responses
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LOGGING_RESP,
                   PRTE_RML_PERSISTENT, pmix_server_logging_resp, NULL);
@@ -1274,6 +1280,8 @@ void pmix_server_finalize(void)
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_SCHED_RESP);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_MONITOR_REQUEST);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_MONITOR_RESP);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_TRAFFIC_REQUEST);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_TRAFFIC_RESP);
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LOGGING_RESP);
     if (PRTE_PROC_IS_MASTER) {
         PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LOGGING);
@@ -2826,6 +2834,8 @@ static void rqcon(prte_pmix_server_req_t *p)
     p->proxy = *PRTE_NAME_INVALID;
     p->target = *PRTE_NAME_INVALID;
     p->jdata = NULL;
+    p->batch = NULL;
+    p->nbatch = 0;
     PMIX_DATA_BUFFER_CONSTRUCT(&p->msg);
     p->timeout = prte_pmix_server_globals.timeout;
     p->opcbfunc = NULL;
@@ -2861,6 +2871,14 @@ static void rqdes(prte_pmix_server_req_t *p)
     if (NULL != p->jdata) {
         PMIX_RELEASE(p->jdata);
     }
+    if (NULL != p->batch) {
+        for (int n = 0; n < p->nbatch; n++) {
+            if (NULL != p->batch[n]) {
+                PMIX_RELEASE(p->batch[n]);
+            }
+        }
+        free(p->batch);
+    }
     PMIX_DATA_BUFFER_DESTRUCT(&p->msg);
 }
 PMIX_CLASS_INSTANCE(prte_pmix_server_req_t,
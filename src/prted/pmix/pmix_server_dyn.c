@@ -77,6 +77,35 @@ void pmix_server_notify_spawn(pmix_nspace_t jobid, int room, pmix_status_t ret)
         PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
         return;
     }
+
+    if (0 < req->nbatch) {
+        /* every job of a batch answers separately under the one room
+         * number. The requestor gets a single callback once they all
+         * have: the first error if there was one, else the nspace of
+         * the first job to launch - the rest it learns from their
+         * job-end events, exactly as it would for separate spawns */
+        if (NULL != jdata) {
+            prte_set_attribute(&jdata->attributes, PRTE_JOB_SPAWN_NOTIFIED,
+                               PRTE_ATTR_GLOBAL, NULL, PMIX_BOOL);
+        }
+        req->nreported++;
+        if (PMIX_SUCCESS != ret) {
+            if (PMIX_SUCCESS == req->pstatus) {
+                req->pstatus = ret;
+            }
+        } else if (PMIX_NSPACE_INVALID(req->target.nspace)) {
+            PMIX_LOAD_NSPACE(req->target.nspace, jobid);
+        }
+        if (req->nreported < (uint32_t) req->nbatch) {
+            return;
+        }
+        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, room, NULL);
+        if (NULL != req->spcbfunc) {
+            req->spcbfunc(req->pstatus, req->target.nspace, req->cbdata);
+        }
+        PMIX_RELEASE(req);
+        return;
+    }
     pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, room, NULL);
 
     /* execute the callback */
@@ -196,6 +225,93 @@ callback:
     PMIX_RELEASE(req);
 }
 
+/* As spawn(), but for the jobs of a PRTE_SPAWN_BATCH request: all of them
+ * go to the HNP in one message under one room number, and each is tagged
+ * with the size of the batch so the HNP knows how many launch messages to
+ * gather into a single xcast (see plm_base_batch.c). */
+static void spawn_batch(int sd, short args, void *cbdata)
+{
+    prte_pmix_server_req_t *req = (prte_pmix_server_req_t *) cbdata;
+    int rc, n;
+    int32_t nbatch;
+    uint32_t bsize;
+    pmix_data_buffer_t *buf, sub;
+    pmix_byte_object_t bo;
+    prte_plm_cmd_flag_t command;
+    char nspace[PMIX_MAX_NSLEN + 1];
+    pmix_status_t prc;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(req);
+
+    req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    command = PRTE_PLM_LAUNCH_BATCH_CMD;
+    rc = PMIx_Data_pack(NULL, buf, &command, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto error;
+    }
+    nbatch = req->nbatch;
+    rc = PMIx_Data_pack(NULL, buf, &nbatch, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto error;
+    }
+
+    /* each job travels as a complete launch command of its own, so the
+     * HNP handles it exactly as it would a separate spawn */
+    bsize = req->nbatch;
+    command = PRTE_PLM_LAUNCH_JOB_CMD;
+    for (n = 0; n < req->nbatch; n++) {
+        prte_set_attribute(&req->batch[n]->attributes, PRTE_JOB_ROOM_NUM,
+                           PRTE_ATTR_GLOBAL, &req->local_index, PMIX_INT);
+        prte_set_attribute(&req->batch[n]->attributes, PRTE_JOB_BATCH_SIZE,
+                           PRTE_ATTR_GLOBAL, &bsize, PMIX_UINT32);
+        PMIX_DATA_BUFFER_CONSTRUCT(&sub);
+        rc = PMIx_Data_pack(NULL, &sub, &command, 1, PMIX_UINT8);
+        if (PMIX_SUCCESS == rc) {
+            rc = prte_job_pack(&sub, req->batch[n], PRTE_JOB_PACK_ALL);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&sub);
+            goto error;
+        }
+        rc = PMIx_Data_unload(&sub, &bo);
+        PMIX_DATA_BUFFER_DESTRUCT(&sub);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+        rc = PMIx_Data_pack(NULL, buf, &bo, 1, PMIX_BYTE_OBJECT);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto error;
+        }
+    }
+
+    /* send it to the HNP for processing - might be myself! */
+    PRTE_RML_RELIABLE_SEND(rc, PRTE_PROC_MY_HNP->rank, buf, PRTE_RML_TAG_PLM);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        goto error;
+    }
+    return;
+
+error:
+    pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
+    PMIX_DATA_BUFFER_RELEASE(buf);
+    if (NULL != req->spcbfunc) {
+        prc = prte_pmix_convert_rc(rc);
+        PMIX_LOAD_NSPACE(nspace, NULL);
+        req->spcbfunc(prc, nspace, req->cbdata);
+    }
+    PMIX_RELEASE(req);
+}
+
 /* Submit a fully-constructed job for launch.  This is the same path a
  * PMIx_Spawn takes once interim() has finished translating it, exposed so
  * that a caller which builds its own job object - notably a session
@@ -357,6 +473,16 @@ int prte_pmix_xfer_job_info(prte_job_t *jdata,
             prte_set_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT,
                                PRTE_ATTR_GLOBAL, &flag, PMIX_BOOL);
 
+            /***   DISPLAY JSON OUTPUT   ***/
+        } else if (PMIX_CHECK_KEY(info, PRTE_DISPLAY_JSON_OUTPUT)) {
+            flag = PMIX_INFO_TRUE(info);
+            prte_set_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_JSON_OUTPUT,
+                               PRTE_ATTR_GLOBAL, &flag, PMIX_BOOL);
+
+        } else if (PMIX_CHECK_KEY(info, PRTE_SPAWN_BATCH)) {
+            /* already acted upon by interim(), which split the request
+             * into one job per app - nothing left to record on the job */
+
         /***   PPR (PROCS-PER-RESOURCE)   ***/
         } else if (PMIX_CHECK_KEY(info, PMIX_PPR)) {
             if (PRTE_MAPPING_POLICY_IS_SET(jdata->map->mapping)) {
@@ -1058,9 +1184,13 @@ int prte_pmix_xfer_app(prte_job_t *jdata, pmix_app_t *papp)
     return PRTE_SUCCESS;
 }
 
-static void interim(int sd, short args, void *cbdata)
+/* Build the job object for apps[0..napps-1] of a spawn request, applying
+ * the request's job-level info to it. The job is returned through jptr
+ * even on error so the caller can dispose of it. */
+static int build_job(prte_pmix_server_op_caddy_t *cd,
+                     pmix_app_t *apps, size_t napps,
+                     prte_job_t **jptr)
 {
-    prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t *) cbdata;
     pmix_proc_t *requestor = &cd->proc;
     prte_job_t *jdata;
     prte_app_context_t *app;
@@ -1068,16 +1198,11 @@ static void interim(int sd, short args, void *cbdata)
     size_t n;
     prte_rmaps_options_t options;
     prte_schizo_base_module_t *schizo;
-    PRTE_HIDE_UNUSED_PARAMS(sd, args);
-
-    pmix_output_verbose(2, prte_pmix_server_globals.output,
-                        "%s spawn called from proc %s with %d apps",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(requestor),
-                        (int) cd->napps);
 
     /* create the job object */
     jdata = PMIX_NEW(prte_job_t);
     jdata->map = PMIX_NEW(prte_job_map_t);
+    *jptr = jdata;
     /* default to the requestor as the originator */
     PMIX_LOAD_PROCID(&jdata->originator, requestor->nspace, requestor->rank);
     /* find the personality being passed - we need this info to direct
@@ -1106,15 +1231,14 @@ static void interim(int sd, short args, void *cbdata)
         if (NULL != prsn) {
             free(prsn);
         }
-        rc = PRTE_ERR_NOT_FOUND;
-        goto complete;
+        return PRTE_ERR_NOT_FOUND;
     }
 
     /* transfer the apps across */
-    for (n = 0; n < cd->napps; n++) {
-        rc = prte_pmix_xfer_app(jdata, &cd->apps[n]);
+    for (n = 0; n < napps; n++) {
+        rc = prte_pmix_xfer_app(jdata, &apps[n]);
         if (PRTE_SUCCESS != rc) {
-            goto complete;
+            return rc;
         }
     }
 
@@ -1128,13 +1252,13 @@ static void interim(int sd, short args, void *cbdata)
     rc = schizo->set_default_rto(jdata, &options);
     if (PRTE_SUCCESS != rc) {
         PRTE_ERROR_LOG(rc);
-        goto complete;
+        return rc;
     }
 
     /* transfer the job info across */
     rc = prte_pmix_xfer_job_info(jdata, cd->info, cd->ninfo);
     if (PRTE_SUCCESS != rc) {
-        goto complete;
+        return rc;
     }
 
     /* set debugger flags on apps if needed */
@@ -1154,10 +1278,70 @@ static void interim(int sd, short args, void *cbdata)
     /* indicate that IO is to be forwarded */
     PRTE_FLAG_SET(jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT);
 
-    /* setup a spawn tracker so we know who to call back when this is done
-     * and thread-shift the entire thing so it can be safely added to
-     * our tracking list */
-    PRTE_SPN_REQ(jdata, spawn, cd->spcbfunc, cd->cbdata);
+    return PRTE_SUCCESS;
+}
+
+static void interim(int sd, short args, void *cbdata)
+{
+    prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t *) cbdata;
+    pmix_proc_t *requestor = &cd->proc;
+    prte_pmix_server_req_t *req;
+    prte_job_t *jdata = NULL;
+    bool batch = false;
+    int rc;
+    size_t n;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s spawn called from proc %s with %d apps",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(requestor),
+                        (int) cd->napps);
+
+    for (n=0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PRTE_SPAWN_BATCH)) {
+            batch = PMIX_INFO_TRUE(&cd->info[n]);
+            break;
+        }
+    }
+
+    if (!batch || cd->napps < 2) {
+        rc = build_job(cd, cd->apps, cd->napps, &jdata);
+        if (PRTE_SUCCESS != rc) {
+            goto complete;
+        }
+        /* setup a spawn tracker so we know who to call back when this is done
+         * and thread-shift the entire thing so it can be safely added to
+         * our tracking list */
+        PRTE_SPN_REQ(jdata, spawn, cd->spcbfunc, cd->cbdata);
+        PMIX_RELEASE(cd);
+        return;
+    }
+
+    /* a batch: one job per app, all tracked by a single request. A job that
+     * cannot be built fails the whole batch before any of it is sent - the
+     * requestor asked for all of them and has only one status to see */
+    req = PMIX_NEW(prte_pmix_server_req_t);
+    pmix_asprintf(&req->operation, "SPAWN BATCH: %s:%d", __FILE__, __LINE__);
+    req->batch = (prte_job_t **) calloc(cd->napps, sizeof(prte_job_t *));
+    req->nbatch = cd->napps;
+    for (n = 0; n < cd->napps; n++) {
+        rc = build_job(cd, &cd->apps[n], 1, &req->batch[n]);
+        if (PRTE_SUCCESS != rc) {
+            jdata = req->batch[n];
+            req->batch[n] = NULL;
+            PMIX_RELEASE(req);
+            goto complete;
+        }
+    }
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s spawn from proc %s submitted as a batch of %d jobs",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(requestor),
+                        req->nbatch);
+    req->spcbfunc = cd->spcbfunc;
+    req->cbdata = cd->cbdata;
+    prte_event_set(prte_event_base, &req->ev, -1, PRTE_EV_WRITE, spawn_batch, req);
+    PMIX_POST_OBJECT(req);
+    prte_event_active(&req->ev, PRTE_EV_WRITE, 1);
     PMIX_RELEASE(cd);
     return;
 
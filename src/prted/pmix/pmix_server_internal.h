@@ -97,6 +97,8 @@ typedef struct {
     pmix_proc_t target;
     pmix_proc_t tproc;
     prte_job_t *jdata;
+    prte_job_t **batch;     // jobs of a PRTE_SPAWN_BATCH request - owned
+    int nbatch;
     pmix_data_buffer_t msg;
     pmix_op_cbfunc_t opcbfunc;
     pmix_modex_cbfunc_t mdxcbfunc;
@@ -441,6 +443,24 @@ PRTE_EXPORT extern void pmix_server_monitor_resp(int status, pmix_proc_t *sender
                                                  pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
                                                  void *cbdata);
 
+/* Answer a query with whatever "results" (an info list) holds, and release
+ * the request. */
+PRTE_EXPORT extern void pmix_server_query_complete(prte_pmix_server_op_caddy_t *cd,
+                                                   void *results, pmix_status_t ret);
+
+/* Add the whole DVM's RML traffic to a query's results, then complete it.
+ * "tmo" is the query's PMIX_TIMEOUT in seconds, or <= 0 for the default. */
+PRTE_EXPORT extern void pmix_server_traffic_gather(prte_pmix_server_op_caddy_t *cd,
+                                                   void *results, int tmo);
+
+PRTE_EXPORT extern void pmix_server_traffic_request(int status, pmix_proc_t *sender,
+                                                    pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                                    void *cbdata);
+
+PRTE_EXPORT extern void pmix_server_traffic_resp(int status, pmix_proc_t *sender,
+                                                 pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                                 void *cbdata);
+
 #define PRTE_PMIX_ALLOC_REQ      0
 #define PRTE_PMIX_SESSION_CTRL   1
 /* Ask the DVM master for a group context id. Unlike its two siblings this
@@ -51,6 +51,7 @@
 #include "src/mca/plm/plm.h"
 #include "src/mca/rmaps/rmaps_types.h"
 #include "src/rml/rml.h"
+#include "src/rml/rml_stats.h"
 #include "src/mca/schizo/schizo.h"
 #include "src/mca/state/state.h"
 #include "src/runtime/prte_globals.h"
@@ -72,7 +73,6 @@ static void qrel(void *cbdata)
 static void _query(int sd, short args, void *cbdata)
 {
     prte_pmix_server_op_caddy_t *cd = (prte_pmix_server_op_caddy_t *) cbdata;
-    prte_pmix_server_op_caddy_t *rcd;
     pmix_query_t *q;
     pmix_status_t ret = PMIX_SUCCESS;
     void *results, *plist, *stack, *cache;
@@ -100,6 +100,9 @@ static void _query(int sd, short args, void *cbdata)
     prte_proc_t *proct;
     pmix_proc_t *proc;
     size_t sz;
+    bool dvmwide, traffic_dvm = false;
+    int traffic_timeout = -1;
+    prte_rml_traffic_report_t *report;
     PRTE_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(cd);
@@ -120,6 +123,7 @@ static void _query(int sd, short args, void *cbdata)
 #ifdef PMIX_ALLOC_PROPERTY
         allocprop = NULL;
 #endif
+        dvmwide = false;
         /* default to the requestor's jobid */
         PMIX_LOAD_NSPACE(jobid, cd->proct.nspace);
         /* see if they provided any qualifiers */
@@ -218,6 +222,11 @@ static void _query(int sd, short args, void *cbdata)
                 } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_ALLOC_PROPERTY)) {
                     allocprop = q->qualifiers[n].value.data.string;
 #endif
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PRTE_RML_TRAFFIC_DVM)) {
+                    dvmwide = PMIX_INFO_TRUE(&q->qualifiers[n]);
+
+                } else if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_TIMEOUT)) {
+                    PMIX_VALUE_GET_NUMBER(rc, &q->qualifiers[n].value, traffic_timeout, int);
                 }
 
             }
@@ -377,6 +386,7 @@ static void _query(int sd, short args, void *cbdata)
                 PMIx_Argv_append_nosize(&ans, PMIX_RANKBY);
                 PMIx_Argv_append_nosize(&ans, PMIX_BINDTO);
                 PMIx_Argv_append_nosize(&ans, PMIX_COSPAWN_APP);
+                PMIx_Argv_append_nosize(&ans, PRTE_SPAWN_BATCH);
                 /* create the return kv */
                 tmp = PMIx_Argv_join(ans, ',');
                 PMIx_Argv_free(ans);
@@ -1112,6 +1122,30 @@ static void _query(int sd, short args, void *cbdata)
                 PMIx_Argv_free(nodes);
                 PMIX_INFO_LIST_ADD(rc, results, PMIX_QUERY_RESOLVE_NODE, nodelist, PMIX_STRING);
 
+            } else if (PMIx_Check_key(q->keys[n], PRTE_QUERY_RML_TRAFFIC)) {
+                if (dvmwide && 1 < prte_process_info.num_daemons) {
+                    /* the other daemons are asked once the rest of the
+                     * query has been answered - see pmix_server_traffic.c */
+                    traffic_dvm = true;
+                    continue;
+                }
+                report = PMIX_NEW(prte_rml_traffic_report_t);
+                rc = prte_rml_traffic_snapshot(report);
+                if (PRTE_SUCCESS == rc) {
+                    rc = prte_rml_traffic_load(report, &dry);
+                }
+                PMIX_RELEASE(report);
+                if (PRTE_SUCCESS != rc) {
+                    ret = prte_pmix_convert_rc(rc);
+                    goto done;
+                }
+                PMIX_INFO_LIST_ADD(rc, results, PRTE_QUERY_RML_TRAFFIC, &dry, PMIX_DATA_ARRAY);
+                PMIX_DATA_ARRAY_DESTRUCT(&dry);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    goto done;
+                }
+
             } else if (PMIx_Check_key(q->keys[n], PMIX_QUERY_PROC_RESOURCE_USAGE)) {
 
             } else if (PMIx_Check_key(q->keys[n], PMIX_QUERY_NODE_RESOURCE_USAGE)) {
@@ -1129,6 +1163,21 @@ static void _query(int sd, short args, void *cbdata)
     }     // for
 
 done:
+    if (traffic_dvm && PMIX_SUCCESS == ret) {
+        /* the answer is complete once the other daemons have reported */
+        pmix_server_traffic_gather(cd, results, traffic_timeout);
+        return;
+    }
+    pmix_server_query_complete(cd, results, ret);
+}
+
+void pmix_server_query_complete(prte_pmix_server_op_caddy_t *cd, void *results,
+                                pmix_status_t ret)
+{
+    prte_pmix_server_op_caddy_t *rcd;
+    pmix_data_array_t dry;
+    pmix_status_t rc;
+
     rcd = PMIX_NEW(prte_pmix_server_op_caddy_t);
     PMIX_INFO_LIST_CONVERT(rc, results, &dry);
     if (PMIX_SUCCESS != rc && PMIX_ERR_EMPTY != rc) {
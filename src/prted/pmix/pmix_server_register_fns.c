@@ -53,6 +53,8 @@
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/prte_wait.h"
 #include "src/util/name_fns.h"
+#include "src/util/nidmap.h"
+#include "src/util/prte_profile.h"
 #include "src/util/session_dir.h"
 
 #include "src/prted/pmix/pmix_server.h"
@@ -69,6 +71,10 @@ typedef struct {
     pmix_op_cbfunc_t cbfunc;
     void *cbdata;
     pmix_status_t status;
+    // set only for a job registration being profiled
+    bool profile;
+    pmix_nspace_t nspace;
+    prte_profile_mark_t start;
 } prte_pmix_reg_caddy_t;
 static void regcon(prte_pmix_reg_caddy_t *p)
 {
@@ -78,6 +84,7 @@ static void regcon(prte_pmix_reg_caddy_t *p)
     p->cbfunc = NULL;
     p->cbdata = NULL;
     p->status = PMIX_SUCCESS;
+    p->profile = false;
 }
 static void regdes(prte_pmix_reg_caddy_t *p)
 {
@@ -91,6 +98,9 @@ static PMIX_CLASS_INSTANCE(prte_pmix_reg_caddy_t, pmix_object_t, regcon, regdes)
  * and cleanup */
 static void complete_reg(prte_pmix_reg_caddy_t *cd)
 {
+    if (cd->profile) {
+        PRTE_PROFILE_STAGE("register_nspace", cd->nspace, &cd->start, 0);
+    }
     if (NULL != cd->cbfunc) {
         cd->cbfunc(cd->status, cd->cbdata);
     }
@@ -241,6 +251,7 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata,
     prte_node_t *node;
     pmix_rank_t vpid;
     char **list, **procs, **micro, *tmp, *regex;
+    static prte_regex_memo_t node_memo = {0}, proc_memo = {0};
     prte_job_map_t *map;
     prte_app_context_t *app;
     uid_t uid;
@@ -258,6 +269,7 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata,
     pmix_cpuset_t cpuset;
     uint32_t ui32, *ui32_ptr;
     pmix_data_array_t *devarray;
+    prte_profile_mark_t mark;
     uint32_t nodesize;
     prte_job_t *parent = NULL;
     pmix_device_distance_t *distances;
@@ -269,6 +281,7 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata,
     pmix_output_verbose(2, prte_pmix_server_globals.output,
                         "%s register nspace for %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_JOBID_PRINT(jdata->nspace));
+    PRTE_PROFILE_MARK(&mark);
 
     /* setup the info list */
     PMIX_INFO_LIST_START(info);
@@ -416,66 +429,29 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata,
             PMIX_INFO_LIST_RELEASE(iarray);
         }
     }
-    /* let the PMIx server generate the nodemap regex */
+    /* let the PMIx server generate the nodemap regex - or reuse the one
+     * it generated for the last job registered on the same nodes */
     if (NULL != list) {
         tmp = PMIx_Argv_join(list, ',');
         PMIx_Argv_free(list);
         list = NULL;
-#if PRTE_PMIX_HAVE_REGEX2
-        pmix_regex2_t nregex = PMIX_REGEX2_STATIC_INIT;
-        if (PMIX_SUCCESS != (ret = PMIx_generate_regex2(tmp, NULL, 0, &nregex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
+        rc = prte_util_regex_memo_add(&node_memo, PMIX_NODE_MAP, tmp, false, info);
+        if (PRTE_SUCCESS != rc) {
             PMIX_INFO_LIST_RELEASE(info);
-            rc = prte_pmix_convert_status(ret);
             return rc;
         }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, info, PMIX_NODE_MAP, &nregex, PMIX_REGEX2);
-        PMIx_Regex2_destruct(&nregex);
-#else
-        if (PMIX_SUCCESS != (ret = PMIx_generate_regex(tmp, &regex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
-            PMIX_INFO_LIST_RELEASE(info);
-            rc = prte_pmix_convert_status(ret);
-            return rc;
-        }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, info, PMIX_NODE_MAP, regex, PMIX_REGEX);
-        free(regex);
-#endif
     }
 
-    /* let the PMIx server generate the procmap regex */
+    /* likewise the procmap regex */
     if (NULL != procs) {
         tmp = PMIx_Argv_join(procs, ';');
         PMIx_Argv_free(procs);
         procs = NULL;
-#if PRTE_PMIX_HAVE_REGEX2
-        pmix_regex2_t pregex = PMIX_REGEX2_STATIC_INIT;
-        if (PMIX_SUCCESS != (ret = PMIx_generate_regex2(tmp, NULL, 0, &pregex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
+        rc = prte_util_regex_memo_add(&proc_memo, PMIX_PROC_MAP, tmp, true, info);
+        if (PRTE_SUCCESS != rc) {
             PMIX_INFO_LIST_RELEASE(info);
-            rc = prte_pmix_convert_status(ret);
             return rc;
         }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, info, PMIX_PROC_MAP, &pregex, PMIX_REGEX2);
-        PMIx_Regex2_destruct(&pregex);
-#else
-        if (PMIX_SUCCESS != (ret = PMIx_generate_ppn(tmp, &regex))) {
-            PMIX_ERROR_LOG(ret);
-            free(tmp);
-            PMIX_INFO_LIST_RELEASE(info);
-            rc = prte_pmix_convert_status(ret);
-            return rc;
-        }
-        free(tmp);
-        PMIX_INFO_LIST_ADD(ret, info, PMIX_PROC_MAP, regex, PMIX_REGEX);
-        free(regex);
-#endif
     }
 
     /* pass the number of nodes in the job */
@@ -878,6 +854,13 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata,
     cd->publish = true;
     cd->cbfunc = cbfunc;
     cd->cbdata = cbdata;
+    if (prte_profile_enabled) {
+        /* the stage ends when the PMIx server has the job, not when we
+         * hand it over */
+        cd->profile = true;
+        PMIX_LOAD_NSPACE(cd->nspace, jdata->nspace);
+        cd->start = mark;
+    }
     ret = PMIx_server_register_nspace(pproc.nspace, jdata->num_local_procs,
                                       cd->pinfo, cd->ninfo, regcbfunc, cd);
     if (PMIX_SUCCESS != ret) {
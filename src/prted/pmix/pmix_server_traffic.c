@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+
+#include "src/pmix/pmix-internal.h"
+#include "src/util/pmix_output.h"
+
+#include "src/grpcomm/grpcomm.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/rml/rml.h"
+#include "src/rml/rml_stats.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+
+#include "src/prted/pmix/pmix_server_internal.h"
+
+/* A DVM-wide PRTE_QUERY_RML_TRAFFIC: the daemon the tool asked xcasts the
+ * request, every other daemon sends its counters straight back, and the
+ * answer goes to the tool once all of them are in - or, if a daemon never
+ * answers, when the query's PMIX_TIMEOUT (default below) runs out, as a
+ * partial success holding what did arrive.  A traffic "top" polls, and an
+ * incomplete picture now is worth more to it than a complete one never. */
+
+#define PRTE_TRAFFIC_DEFAULT_TIMEOUT 10
+
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t id;
+    prte_event_t timer;
+    prte_pmix_server_op_caddy_t *cd;
+    void *results;
+    prte_rml_traffic_report_t *report;
+    pmix_rank_t nexpected;
+    pmix_rank_t nrecvd;
+} traffic_tracker_t;
+static void tcon(traffic_tracker_t *p)
+{
+    p->id = 0;
+    p->cd = NULL;
+    p->results = NULL;
+    p->report = PMIX_NEW(prte_rml_traffic_report_t);
+    p->nexpected = 0;
+    p->nrecvd = 0;
+}
+static void tdes(traffic_tracker_t *p)
+{
+    PMIX_RELEASE(p->report);
+}
+static PMIX_CLASS_INSTANCE(traffic_tracker_t, pmix_list_item_t, tcon, tdes);
+
+static pmix_list_t trackers = PMIX_LIST_STATIC_INIT;
+static uint32_t next_id = 0;
+
+static void finish(traffic_tracker_t *t, pmix_status_t ret)
+{
+    pmix_data_array_t darray;
+    pmix_status_t rc;
+    int prc;
+
+    prte_event_evtimer_del(&t->timer);
+    pmix_list_remove_item(&trackers, &t->super);
+
+    prc = prte_rml_traffic_load(t->report, &darray);
+    if (PRTE_SUCCESS != prc) {
+        ret = prte_pmix_convert_rc(prc);
+    } else {
+        PMIX_INFO_LIST_ADD(rc, t->results, PRTE_QUERY_RML_TRAFFIC, &darray, PMIX_DATA_ARRAY);
+        PMIX_DATA_ARRAY_DESTRUCT(&darray);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = rc;
+        }
+    }
+    pmix_server_query_complete(t->cd, t->results, ret);
+    PMIX_RELEASE(t);
+}
+
+static void timeout(int fd, short args, void *cbdata)
+{
+    traffic_tracker_t *t = (traffic_tracker_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s traffic query %u: %u of %u daemons answered in time",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), t->id,
+                        (unsigned) t->nrecvd, (unsigned) t->nexpected);
+    finish(t, PMIX_QUERY_PARTIAL_SUCCESS);
+}
+
+void pmix_server_traffic_gather(prte_pmix_server_op_caddy_t *cd, void *results, int tmo)
+{
+    traffic_tracker_t *t;
+    pmix_data_buffer_t msg;
+    struct timeval tv = {0, 0};
+    pmix_status_t rc;
+    int ret;
+
+    t = PMIX_NEW(traffic_tracker_t);
+    t->id = next_id++;
+    t->cd = cd;
+    t->results = results;
+    t->nexpected = prte_process_info.num_daemons - 1;
+
+    ret = prte_rml_traffic_snapshot(t->report);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        pmix_server_query_complete(cd, results, prte_pmix_convert_rc(ret));
+        PMIX_RELEASE(t);
+        return;
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&msg);
+    rc = PMIx_Data_pack(NULL, &msg, &PRTE_PROC_MY_NAME->rank, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, &msg, &t->id, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&msg);
+        pmix_server_query_complete(cd, results, rc);
+        PMIX_RELEASE(t);
+        return;
+    }
+
+    pmix_list_append(&trackers, &t->super);
+    tv.tv_sec = (0 < tmo) ? tmo : PRTE_TRAFFIC_DEFAULT_TIMEOUT;
+    prte_event_evtimer_set(prte_event_base, &t->timer, timeout, t);
+    prte_event_evtimer_add(&t->timer, &tv);
+
+    ret = prte_grpcomm_xcast(PRTE_RML_TAG_TRAFFIC_REQUEST, &msg);
+    PMIX_DATA_BUFFER_DESTRUCT(&msg);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        /* nobody was asked, so nobody is coming - answer with our own */
+        finish(t, PMIX_QUERY_PARTIAL_SUCCESS);
+    }
+}
+
+void pmix_server_traffic_request(int status, pmix_proc_t *sender,
+                                 pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                                 void *cbdata)
+{
+    prte_rml_traffic_report_t *report;
+    pmix_data_buffer_t *msg;
+    pmix_rank_t requester;
+    pmix_status_t rc;
+    uint32_t id;
+    int32_t cnt;
+    int ret;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &requester, &cnt, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    // the daemon that asked has already counted itself
+    if (requester == PRTE_PROC_MY_NAME->rank) {
+        return;
+    }
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &id, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+
+    report = PMIX_NEW(prte_rml_traffic_report_t);
+    ret = prte_rml_traffic_snapshot(report);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_RELEASE(report);
+        return;
+    }
+    PMIX_DATA_BUFFER_CREATE(msg);
+    rc = PMIx_Data_pack(NULL, msg, &id, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(msg);
+        PMIX_RELEASE(report);
+        return;
+    }
+    ret = prte_rml_traffic_pack(msg, report);
+    PMIX_RELEASE(report);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(msg);
+        return;
+    }
+    PRTE_RML_SEND(ret, requester, msg, PRTE_RML_TAG_TRAFFIC_RESP);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(msg);
+    }
+}
+
+void pmix_server_traffic_resp(int status, pmix_proc_t *sender,
+                              pmix_data_buffer_t *buffer, prte_rml_tag_t tg,
+                              void *cbdata)
+{
+    traffic_tracker_t *t, *found = NULL;
+    pmix_status_t rc;
+    uint32_t id;
+    int32_t cnt;
+    int ret;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &id, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    PMIX_LIST_FOREACH(t, &trackers, traffic_tracker_t)
+    {
+        if (t->id == id) {
+            found = t;
+            break;
+        }
+    }
+    if (NULL == found) {
+        /* it arrived after the query timed out */
+        pmix_output_verbose(2, prte_pmix_server_globals.output,
+                            "%s late traffic report from %s dropped",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender));
+        return;
+    }
+
+    ret = prte_rml_traffic_unpack(buffer, found->report);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+    }
+    found->nrecvd++;
+    if (found->nrecvd == found->nexpected) {
+        finish(found, PMIX_SUCCESS);
+    }
+}
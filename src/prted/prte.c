@@ -87,6 +87,7 @@
 #include "src/util/pmix_getcwd.h"
 #include "src/util/pmix_show_help.h"
 #include "src/util/prte_show_help.h"
+#include "src/util/prte_profile.h"
 #include "src/util/pmix_string_copy.h"
 #include "src/util/session_dir.h"
 
@@ -720,6 +721,17 @@ PRTE_EXPORT int prte(int argc, char *argv[])
     if (NULL != opt) {
         prte_pmix_server_globals.report_uri = strdup(opt->values[0]);
     }
+    /* likewise the startup profile - "-" and "+" as for the uri */
+    opt = pmix_cmd_line_get_param(&results, PRTE_CLI_REPORT_STARTUP);
+    if (NULL != opt) {
+        if (0 == strcmp(opt->values[0], "-")) {
+            prte_profile_startup_set_report("stdout");
+        } else if (0 == strcmp(opt->values[0], "+")) {
+            prte_profile_startup_set_report("stderr");
+        } else {
+            prte_profile_startup_set_report(opt->values[0]);
+        }
+    }
 
     /* if we were given a launch agent, set the MCA param for it */
     opt = pmix_cmd_line_get_param(&results, PRTE_CLI_LAUNCH_AGENT);
@@ -813,6 +825,10 @@ PRTE_EXPORT int prte(int argc, char *argv[])
         prte_job_session_dir_finalize(NULL);
         return ret;
     }
+    /* our own startup is complete - the daemons' follow as they report */
+    if (prte_profile_startup_enabled) {
+        prte_profile_startup_add(PRTE_PROC_MY_NAME->rank, prte_process_info.nodename, NULL);
+    }
     /* get my proc ID */
     ret = PMIx_Get(NULL, PMIX_PROCID, NULL, 0, &val);
     if (PMIX_SUCCESS != ret) {
@@ -1094,6 +1110,9 @@ PRTE_EXPORT int prte(int argc, char *argv[])
                     } else if (PMIX_CHECK_KEY(&dptr[dn], PMIX_DISPLAY_PARSEABLE_OUTPUT)) {
                         prte_set_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT,
                                            PRTE_ATTR_GLOBAL, NULL, PMIX_BOOL);
+                    } else if (PMIX_CHECK_KEY(&dptr[dn], PRTE_DISPLAY_JSON_OUTPUT)) {
+                        prte_set_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_JSON_OUTPUT,
+                                           PRTE_ATTR_GLOBAL, NULL, PMIX_BOOL);
                     }
                 }
                 PMIX_DATA_ARRAY_DESTRUCT(&darray2);
@@ -1126,6 +1145,9 @@ PRTE_EXPORT int prte(int argc, char *argv[])
      * of the procs we are about to fork. */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_SLICE,
                   PRTE_RML_PERSISTENT, prte_odls_base_recv_cpuset_slice, NULL);
+    /* A daemon that was named a launch template it does not hold. */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_TEMPLATE,
+                  PRTE_RML_PERSISTENT, prte_odls_base_recv_template_request, NULL);
 
     /* setup to capture job-level info */
     PMIX_INFO_LIST_START(jinfo);
@@ -467,6 +467,41 @@ void prte_daemon_recv(int status, pmix_proc_t *sender,
         }
         break;
 
+        /****    ADD_PROCS_BATCH   ****/
+    case PRTE_DAEMON_ADD_PROCS_BATCH:
+        n = 1;
+        ret = PMIx_Data_unpack(NULL, buffer, &num_replies, &n, PMIX_INT32);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            goto CLEANUP;
+        }
+        if (prte_debug_daemons_flag) {
+            pmix_output(0, "%s prted_cmd: received add_procs for a batch of %d jobs",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), num_replies);
+        }
+        /* each is a complete launch command in its own right - one job
+         * failing to launch does not stop the others */
+        for (i = 0; i < num_replies; i++) {
+            n = 1;
+            ret = PMIx_Data_unpack(NULL, buffer, &pbo, &n, PMIX_BYTE_OBJECT);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                goto CLEANUP;
+            }
+            PMIX_DATA_BUFFER_CONSTRUCT(&data);
+            ret = PMIx_Data_load(&data, &pbo);
+            pbo.bytes = NULL;
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                PMIX_DATA_BUFFER_DESTRUCT(&data);
+                goto CLEANUP;
+            }
+            prte_daemon_recv(status, sender, &data, tag, cbdata);
+            PMIX_DATA_BUFFER_DESTRUCT(&data);
+        }
+        break;
+
     case PRTE_DAEMON_ABORT_PROCS_CALLED:
         if (prte_debug_daemons_flag) {
             pmix_output(0, "%s prted_cmd: received abort_procs report",
@@ -1000,6 +1035,9 @@ static const char *get_prted_comm_cmd_str(int command)
     case PRTE_DAEMON_SHRINK_CMD:
         return "PRTE_DAEMON_SHRINK_CMD";
 
+    case PRTE_DAEMON_ADD_PROCS_BATCH:
+        return "PRTE_DAEMON_ADD_PROCS_BATCH";
+
     default:
         return "Unknown Command!";
     }
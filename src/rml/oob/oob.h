@@ -104,6 +104,19 @@ typedef struct {
                                delay backs off exponentially up to this value (0 => fixed delay) */
     int connect_max_time;   /**< max seconds to keep retrying a non-lifeline peer before giving up
                                and letting the routing tree heal to an ancestor (0 => forever) */
+    int handshake_timeout;  /**< max seconds a connection may take over its IDENT handshake once
+                               the socket is up (0 => wait forever) */
+
+    /* priority lanes */
+    bool control_tags[PRTE_RML_TAG_MAX]; /**< tags that travel on the control lane */
+    int segment_size; /**< most bytes of a bulk message sent before the control lane gets a
+                           turn (0 => bulk messages go whole) */
+
+    /* unix-domain support */
+    bool uds_enable;  /**< listen on, and connect co-located peers over, a unix-domain socket */
+    char *uds_path;   /**< the socket we listen on in our session directory, if any */
+    char *uds_host;   /**< names this host in our contact info - peers that see their own
+                           name there are on the same host and can reach uds_path */
 } prte_oob_base_t;
 PRTE_EXPORT extern prte_oob_base_t prte_oob_base;
 
@@ -178,7 +191,8 @@ PRTE_EXPORT void prte_oob_base_complete_send(int fd, short args, void *cbdata);
     } while (0)
 
 /* Build this process's contact URI: our name followed by the TCP
- * address(es) we are listening on, in a semicolon-separated string. During
+ * address(es) we are listening on, and our unix-domain socket if we have
+ * one, in a semicolon-separated string. During
  * initial wireup this can only be transferred on the daemon command line,
  * so the result is a compact string representation of our listening
  * endpoints.
@@ -16,6 +16,10 @@
 #include "prte_config.h"
 #include "constants.h"
 
+#ifdef HAVE_SYS_UN_H
+#    include <sys/un.h>
+#endif
+
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
 #include "src/util/pmix_argv.h"
@@ -32,7 +36,6 @@
 #include "src/rml/oob/oob_tcp_connection.h"
 #include "src/rml/oob/oob_tcp_peer.h"
 
-static prte_oob_tcp_peer_t* process_uri(char *uri);
 
 /* Run a send's completion callback on the main progress thread.
  *
@@ -157,7 +160,7 @@ resolve_hop:
         /* the macro reports a PMIx status, not a PRRTE error code */
         PRTE_MODEX_RECV_VALUE_OPTIONAL(rc, PMIX_PROC_URI, &hop, (char **) &uri, PMIX_STRING);
         if (PMIX_SUCCESS == rc && NULL != uri) {
-            peer = process_uri(uri);
+            peer = prte_oob_base_process_uri(uri);
             /* process_uri only reads (and temporarily splits) the string - the
              * copy the modex handed us is ours to release */
             free(uri);
@@ -191,7 +194,7 @@ resolve_hop:
             char *synth = NULL;
             if (PRTE_SUCCESS == prte_ess_base_bootstrap_peer_uri(hop.rank, &synth)
                 && NULL != synth) {
-                peer = process_uri(synth);
+                peer = prte_oob_base_process_uri(synth);
                 free(synth);
             }
         }
@@ -259,7 +262,8 @@ send:
      */
     MCA_OOB_TCP_QUEUE_PENDING(msg, peer);
 
-    if (MCA_OOB_TCP_CONNECTING != peer->state && MCA_OOB_TCP_CONNECT_ACK != peer->state) {
+    if (MCA_OOB_TCP_CONNECTING != peer->state && MCA_OOB_TCP_CONNECT_ACK != peer->state
+        && MCA_OOB_TCP_ACCEPTING != peer->state) {
         /* we have to initiate the connection - again, we do not
          * want to block while the connection is created.
          * So throw us into an event that will create
@@ -279,7 +283,8 @@ send:
  * During initial wireup, we can only transfer contact info on the daemon
  * command line, so we render it as a compact, uri-like string: our process
  * name followed by the TCP endpoints (IPv4 and, if enabled, IPv6) we are
- * listening on. Returns *uri == NULL if we have no usable connection.
+ * listening on, and then our unix-domain socket as "uds://<host>:<path>".
+ * Returns *uri == NULL if we have no usable connection.
  *
  * Note: since there is a limit to what an OS will allow on a cmd line, we
  * impose a limit on the length of the resulting uri via an MCA param. The
@@ -345,6 +350,15 @@ void prte_oob_base_get_addr(char **uri)
     }
 #endif // PRTE_ENABLE_IPV6
 
+    /* peers on this host may reach us without TCP - tell them where.  Only
+     * alongside a TCP address, which is what everyone else uses */
+    if (NULL != cptr && NULL != prte_oob_base.uds_path) {
+        pmix_asprintf(&tmp, "%s;uds://%s:%s", cptr, prte_oob_base.uds_host,
+                      prte_oob_base.uds_path);
+        free(cptr);
+        cptr = tmp;
+    }
+
     if (NULL == cptr) {
         PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
         *uri = NULL;
@@ -406,6 +420,57 @@ static int parse_uri(const uint16_t af_family, const char *host, const char *por
     return PRTE_SUCCESS;
 }
 
+/* A "uds://<host>:<path>" entry: the peer's unix-domain socket, which is
+ * only any use to us if the peer is on our host.  The addresses TCP chooses
+ * between are kept apart from it - try_connect tries this one first. */
+static void set_uds_addr(pmix_proc_t *peer, const char *uri)
+{
+    prte_oob_tcp_peer_t *pr;
+    struct sockaddr_un *un;
+    const char *host, *path;
+    size_t hlen;
+
+    if (NULL == prte_oob_base.uds_host) {
+        /* we cannot tell who shares our host */
+        return;
+    }
+    host = uri + strlen("uds://");
+    path = strchr(host, ':');
+    if (NULL == path) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return;
+    }
+    hlen = path - host;
+    path++;
+    if (hlen != strlen(prte_oob_base.uds_host)
+        || 0 != strncmp(host, prte_oob_base.uds_host, hlen)) {
+        pmix_output_verbose(20, prte_oob_base.output,
+                            "%s set_peer: peer %s is on another host",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(peer));
+        return;
+    }
+    if (sizeof(un->sun_path) <= strlen(path)) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return;
+    }
+
+    if (NULL == (pr = prte_oob_tcp_peer_lookup(peer))) {
+        pr = PMIX_NEW(prte_oob_tcp_peer_t);
+        PMIX_XFER_PROCID(&pr->name, peer);
+        pmix_list_append(&prte_oob_base.peers, &pr->super);
+    }
+    if (NULL == pr->uds_addr) {
+        pr->uds_addr = PMIX_NEW(prte_oob_tcp_addr_t);
+    }
+    memset(&pr->uds_addr->addr, 0, sizeof(pr->uds_addr->addr));
+    un = (struct sockaddr_un *) &pr->uds_addr->addr;
+    un->sun_family = AF_UNIX;
+    memcpy(un->sun_path, path, strlen(path));
+    pmix_output_verbose(20, prte_oob_base.output,
+                        "%s set_peer: peer %s is listening on %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(peer), path);
+}
+
 static void set_addr(pmix_proc_t *peer, char **uris)
 {
     char **addrs, **masks, *hptr;
@@ -440,6 +505,10 @@ static void set_addr(pmix_proc_t *peer, char **uris)
             free(tcpuri);
             continue;
 #endif // PRTE_ENABLE_IPV6
+        } else if (0 == strncmp(uris[i], "uds:", 4)) {
+            set_uds_addr(peer, uris[i]);
+            free(tcpuri);
+            continue;
         } else {
             /* not one of ours */
             pmix_output_verbose(2, prte_oob_base.output,
@@ -567,7 +636,7 @@ static void set_addr(pmix_proc_t *peer, char **uris)
 
 static prte_oob_tcp_peer_t *get_peer(const pmix_proc_t *pr);
 
-static prte_oob_tcp_peer_t* process_uri(char *uri)
+prte_oob_tcp_peer_t *prte_oob_base_process_uri(char *uri)
 {
     pmix_proc_t peer;
     char *cptr;
@@ -107,7 +107,11 @@ prte_oob_base_t prte_oob_base = {
     .keepalive_time = 0,
     .keepalive_intvl = 0,
     .retry_delay = 0,
-    .max_recon_attempts = 0
+    .max_recon_attempts = 0,
+
+    .uds_enable = false,
+    .uds_path = NULL,
+    .uds_host = NULL
 };
 
 int prte_oob_open(void)
@@ -155,8 +159,13 @@ int prte_oob_open(void)
     }
 
     /* if we are the master, then check the interfaces for loopbacks
-     * and keep loopbacks only if no non-loopback interface exists */
-    if (PRTE_PROC_IS_MASTER) {
+     * and keep loopbacks only if no non-loopback interface exists. An
+     * explicit include is taken at its word, loopback or not - that is
+     * how daemons emulating separate nodes on one host (prte_hostname)
+     * are wired up over lo */
+    if (including) {
+        keeploopback = true;
+    } else if (PRTE_PROC_IS_MASTER) {
         keeploopback = true;
         PMIX_LIST_FOREACH(selected_interface, &pmix_if_list, pmix_pif_t)
         {
@@ -378,6 +387,14 @@ void prte_oob_close(void)
     if (NULL != prte_oob_base.if_masks) {
         PMIx_Argv_free(prte_oob_base.if_masks);
     }
+    if (NULL != prte_oob_base.uds_path) {
+        free(prte_oob_base.uds_path);
+        prte_oob_base.uds_path = NULL;
+    }
+    if (NULL != prte_oob_base.uds_host) {
+        free(prte_oob_base.uds_host);
+        prte_oob_base.uds_host = NULL;
+    }
 
     if (0 <= prte_oob_base.output) {
         pmix_output_close(prte_oob_base.output);
@@ -394,6 +411,8 @@ static char *dyn_port_string;
 static char *dyn_port_string6;
 #endif
 
+static char *control_tag_string;
+
 int prte_oob_register(void)
 {
     prte_oob_base.peer_limit = -1;
@@ -586,6 +605,50 @@ int prte_oob_register(void)
                                         PMIX_MCA_BASE_VAR_TYPE_INT,
                                         &prte_oob_base.connect_max_time);
 
+    prte_oob_base.handshake_timeout = 30;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "handshake_timeout",
+                                        "Maximum time (in sec) to wait for a peer to complete the connection handshake once its socket is up, after which the connection is dropped; 0 means wait forever",
+                                        PMIX_MCA_BASE_VAR_TYPE_INT,
+                                        &prte_oob_base.handshake_timeout);
+
+    /* what a lost daemon, RELM and the xcast's acknowledgements say is what
+     * the DVM's failure detection runs on - none of it waits behind bulk */
+    pmix_asprintf(&control_tag_string, "%d,%d,%d,%d,%d,%d,%d",
+                  PRTE_RML_TAG_DAEMON_DIED, PRTE_RML_TAG_DAEMON_ADOPTED,
+                  PRTE_RML_TAG_XCAST_ACK, PRTE_RML_TAG_RELM_STATE, PRTE_RML_TAG_RELM_LINK,
+                  PRTE_RML_TAG_DAEMON_RETURNED, PRTE_RML_TAG_DAEMON_REVIVED);
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "oob_control_tags",
+                                        "Comma-delimited list of RML tags (ranges allowed) whose messages are sent ahead of all other traffic to the same peer",
+                                        PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                        &control_tag_string);
+    memset(prte_oob_base.control_tags, 0, sizeof(prte_oob_base.control_tags));
+    if (NULL != control_tag_string) {
+        char **tags = NULL;
+        int n, t;
+
+        pmix_util_parse_range_options(control_tag_string, &tags);
+        for (n = 0; NULL != tags && NULL != tags[n]; n++) {
+            t = strtol(tags[n], NULL, 10);
+            /* dynamic tags are not known until they are handed out */
+            if (PRTE_RML_TAG_INVALID < t && t < PRTE_RML_TAG_MAX) {
+                prte_oob_base.control_tags[t] = true;
+            }
+        }
+        PMIx_Argv_free(tags);
+    }
+
+    prte_oob_base.segment_size = 64 * 1024;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "oob_segment_size",
+                                        "Size (in bytes) of the segments a larger message is sent in, so that a control message (see prte_oob_control_tags) to the same peer waits for at most one segment instead of the whole message (0 = send every message whole)",
+                                        PMIX_MCA_BASE_VAR_TYPE_INT,
+                                        &prte_oob_base.segment_size);
+
+    prte_oob_base.uds_enable = true;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "oob_uds",
+                                        "Listen on a unix-domain socket in the session directory, and use it instead of TCP to reach peers on the same host (e.g., several DVMs or emulated nodes on one host)",
+                                        PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                        &prte_oob_base.uds_enable);
+
     prte_oob_base.max_msg_size = 100;
     (void) pmix_mca_base_var_register("prte", "prte", NULL, "max_msg_size",
                                         "Max size of an OOB message in Megabytes(default = 100)",
@@ -636,15 +699,37 @@ static void recv_handler(int sd, short flags, void *user);
  */
 void prte_oob_accept_connection(const int accepted_fd, const struct sockaddr *addr)
 {
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                        "%s accept_connection: %s:%d\n", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                        pmix_net_get_hostname(addr), pmix_net_get_port(addr));
+    int flags;
+
+    if (AF_UNIX == addr->sa_family) {
+        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                            "%s accept_connection: %s\n", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            prte_oob_base.uds_path);
+    } else {
+        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                            "%s accept_connection: %s:%d\n", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            pmix_net_get_hostname(addr), pmix_net_get_port(addr));
+    }
 
     /* setup socket options */
     prte_oob_tcp_set_socket_options(accepted_fd);
 
-    /* use a one-time event to wait for receipt of peer's
-     *  process ident message to complete this connection
+    /* An accepted socket does not inherit the listener's O_NONBLOCK, and the
+     * handshake is read from it as it arrives - a blocking read here would
+     * hold every other connection on this base hostage to the slowest
+     * connector */
+    if ((flags = fcntl(accepted_fd, F_GETFL, 0)) < 0) {
+        pmix_output(0, "%s prte_oob_accept_connection: fcntl(F_GETFL) failed: %s (%d)",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), strerror(prte_socket_errno),
+                    prte_socket_errno);
+    } else if (fcntl(accepted_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        pmix_output(0, "%s prte_oob_accept_connection: fcntl(F_SETFL) failed: %s (%d)",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), strerror(prte_socket_errno),
+                    prte_socket_errno);
+    }
+
+    /* use a one-time event, re-armed until it is all in, to wait for
+     * receipt of peer's process ident message to complete this connection
      */
     PRTE_ACTIVATE_TCP_ACCEPT_STATE(accepted_fd, addr, recv_handler);
 }
@@ -659,18 +744,28 @@ void prte_oob_accept_connection(const int accepted_fd, const struct sockaddr *ad
 static void recv_handler(int sd, short flg, void *cbdata)
 {
     prte_oob_tcp_conn_op_t *op = (prte_oob_tcp_conn_op_t *) cbdata;
-    int flags;
     prte_oob_tcp_hdr_t hdr;
     prte_oob_tcp_peer_t *peer;
-    PRTE_HIDE_UNUSED_PARAMS(flg);
+    int rc;
 
     PMIX_ACQUIRE_OBJECT(op);
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                         "%s:tcp:recv:handler called", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
-    /* get the handshake */
-    if (PRTE_SUCCESS != prte_oob_tcp_peer_recv_connect_ack(NULL, sd, &hdr)) {
+    if (PRTE_EV_TIMEOUT & flg) {
+        goto timedout;
+    }
+
+    /* get the handshake - or as much of it as has arrived */
+    rc = prte_oob_tcp_peer_recv_connect_ack(NULL, sd, &op->hs, &hdr);
+    if (PRTE_ERR_WOULD_BLOCK == rc) {
+        if (PRTE_SUCCESS == prte_oob_tcp_handshake_wait(&op->hs, &op->ev)) {
+            return;
+        }
+        goto timedout;
+    }
+    if (PRTE_SUCCESS != rc) {
         goto cleanup;
     }
 
@@ -685,19 +780,6 @@ static void recv_handler(int sd, short flg, void *cbdata)
             /* should never happen */
             goto cleanup;
         }
-        /* set socket up to be non-blocking */
-        if ((flags = fcntl(sd, F_GETFL, 0)) < 0) {
-            pmix_output(0, "%s prte_oob_tcp_recv_connect: fcntl(F_GETFL) failed: %s (%d)",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), strerror(prte_socket_errno),
-                        prte_socket_errno);
-        } else {
-            flags |= O_NONBLOCK;
-            if (fcntl(sd, F_SETFL, flags) < 0) {
-                pmix_output(0, "%s prte_oob_tcp_recv_connect: fcntl(F_SETFL) failed: %s (%d)",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), strerror(prte_socket_errno),
-                            prte_socket_errno);
-            }
-        }
         /* is the peer instance willing to accept this connection */
         peer->sd = sd;
         if (prte_oob_tcp_peer_accept(peer) == false) {
@@ -715,6 +797,16 @@ static void recv_handler(int sd, short flg, void *cbdata)
 
 cleanup:
     PMIX_RELEASE(op);
+    return;
+
+timedout:
+    /* a connector that cannot get a few hundred bytes to us in
+     * prte_handshake_timeout seconds is not going to complete */
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                        "%s handshake on accepted socket %d timed out",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sd);
+    CLOSE_THE_SOCKET(sd);
+    PMIX_RELEASE(op);
 }
 
 /*
@@ -32,6 +32,8 @@
 #include "prte_config.h"
 #include "types.h"
 
+#include <string.h>
+
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
@@ -138,10 +140,22 @@ static void set_keepalive(int sd)
 
 void prte_oob_tcp_set_socket_options(int sd)
 {
+    struct sockaddr_storage local;
+    prte_socklen_t len = sizeof(local);
+    bool is_unix = false;
+
+    /* a connection to a co-located peer over its unix-domain socket takes
+     * the buffer sizes, but has no TCP layer to set anything else on */
+    memset(&local, 0, sizeof(local));
+    if (0 == getsockname(sd, (struct sockaddr *) &local, &len) && AF_UNIX == local.ss_family) {
+        is_unix = true;
+    }
+
 #if defined(TCP_NODELAY)
     int optval;
     optval = 1;
-    if (setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, (char *) &optval, sizeof(optval)) < 0) {
+    if (!is_unix
+        && setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, (char *) &optval, sizeof(optval)) < 0) {
         prte_backtrace_print(stderr, NULL, 1);
         pmix_output_verbose(5, prte_oob_base.output,
                             "[%s:%d] setsockopt(TCP_NODELAY) failed: %s (%d)", __FILE__, __LINE__,
@@ -169,7 +183,7 @@ void prte_oob_tcp_set_socket_options(int sd)
     }
 #endif
 
-    if (0 < prte_oob_base.keepalive_time) {
+    if (0 < prte_oob_base.keepalive_time && !is_unix) {
         set_keepalive(sd);
     }
 }
@@ -34,4 +34,9 @@
 PRTE_EXPORT void prte_oob_tcp_set_socket_options(int sd);
 PRTE_EXPORT char *prte_oob_tcp_state_print(prte_oob_tcp_state_t state);
 PRTE_EXPORT prte_oob_tcp_peer_t *prte_oob_tcp_peer_lookup(const pmix_proc_t *name);
+/* Record a peer's contact URI, as built by prte_oob_base_get_addr: its TCP
+ * addresses, and its unix-domain socket if it is on our host.  The string
+ * is split in place.  Returns the peer, created if it was not known, or
+ * NULL if the URI is malformed or names us. */
+PRTE_EXPORT prte_oob_tcp_peer_t *prte_oob_base_process_uri(char *uri);
 #endif /* _MCA_OOB_TCP_COMMON_H_ */
@@ -170,17 +170,24 @@ static void peer_cons(prte_oob_tcp_peer_t *peer)
     peer->evbase = prte_worker_pool_assign();
     PMIX_CONSTRUCT(&peer->lock, pmix_mutex_t);
     PMIX_CONSTRUCT(&peer->addrs, pmix_list_t);
+    peer->uds_addr = NULL;
     peer->active_addr = NULL;
     peer->state = MCA_OOB_TCP_UNCONNECTED;
     peer->established = false;
     peer->num_retries = 0;
     peer->first_attempt = 0;
     PMIX_CONSTRUCT(&peer->send_queue, pmix_list_t);
+    PMIX_CONSTRUCT(&peer->ctl_queue, pmix_list_t);
     peer->send_msg = NULL;
+    peer->bulk_msg = NULL;
     peer->recv_msg = NULL;
+    peer->bulk_recv = NULL;
+    memset(&peer->traffic, 0, sizeof(peer->traffic));
+    peer->queue_hwm = 0;
     peer->send_ev_active = false;
     peer->recv_ev_active = false;
     peer->timer_ev_active = false;
+    memset(&peer->hs, 0, sizeof(peer->hs));
 }
 static void peer_des(prte_oob_tcp_peer_t *peer)
 {
@@ -202,14 +209,25 @@ static void peer_des(prte_oob_tcp_peer_t *peer)
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->sd);
         CLOSE_THE_SOCKET(peer->sd);
     }
+    prte_oob_tcp_handshake_reset(&peer->hs);
     PMIX_LIST_DESTRUCT(&peer->addrs);
+    if (NULL != peer->uds_addr) {
+        PMIX_RELEASE(peer->uds_addr);
+    }
     /* the on-deck message is not in the send queue, so it has to be
      * disposed of separately - along with anything still queued behind
      * it, each of which still owns its RML message */
     if (NULL != peer->send_msg) {
         PMIX_RELEASE(peer->send_msg);
     }
+    if (NULL != peer->bulk_msg) {
+        PMIX_RELEASE(peer->bulk_msg);
+    }
+    PMIX_LIST_DESTRUCT(&peer->ctl_queue);
     PMIX_LIST_DESTRUCT(&peer->send_queue);
+    if (NULL != peer->bulk_recv) {
+        PMIX_RELEASE(peer->bulk_recv);
+    }
     PMIX_DESTRUCT(&peer->lock);
 }
 PMIX_CLASS_INSTANCE(prte_oob_tcp_peer_t, pmix_list_item_t, peer_cons, peer_des);
@@ -238,7 +256,16 @@ static void pop_des(prte_oob_tcp_peer_op_t *pop)
 }
 PMIX_CLASS_INSTANCE(prte_oob_tcp_peer_op_t, pmix_object_t, pop_cons, pop_des);
 
-PMIX_CLASS_INSTANCE(prte_oob_tcp_conn_op_t, pmix_object_t, NULL, NULL);
+static void cop_cons(prte_oob_tcp_conn_op_t *cop)
+{
+    cop->peer = NULL;
+    memset(&cop->hs, 0, sizeof(cop->hs));
+}
+static void cop_des(prte_oob_tcp_conn_op_t *cop)
+{
+    prte_oob_tcp_handshake_reset(&cop->hs);
+}
+PMIX_CLASS_INSTANCE(prte_oob_tcp_conn_op_t, pmix_object_t, cop_cons, cop_des);
 
 static void nicaddr_cons(prte_oob_tcp_nicaddr_t *ptr)
 {
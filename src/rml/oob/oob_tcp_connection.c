@@ -35,6 +35,9 @@
 #endif
 #include <fcntl.h>
 #include <sys/socket.h>
+#ifdef HAVE_SYS_UN_H
+#    include <sys/un.h>
+#endif
 
 #ifdef HAVE_SYS_UIO_H
 #    include <sys/uio.h>
@@ -85,9 +88,13 @@
 static void tcp_peer_event_init(prte_oob_tcp_peer_t *peer);
 static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer);
 static int tcp_peer_send_connect_nack(int sd, pmix_proc_t *name);
-static int tcp_peer_send_blocking(int sd, void *data, size_t size);
-static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data, size_t size);
+static int tcp_peer_send_nb(int sd, void *data, size_t size);
+static int tcp_peer_handshake_write(prte_oob_tcp_peer_t *peer);
+static int tcp_peer_recv_nb(prte_oob_tcp_peer_t *peer, int sd, void *data, size_t size,
+                            size_t *got);
 static void tcp_peer_connected(prte_oob_tcp_peer_t *peer);
+static void tcp_peer_handshake_timer(prte_oob_tcp_peer_t *peer);
+static void tcp_peer_accepted(prte_oob_tcp_peer_t *peer);
 
 static int tcp_peer_create_socket(prte_oob_tcp_peer_t *peer, sa_family_t family)
 {
@@ -195,6 +202,14 @@ static void tcp_peer_fail_queued_sends(prte_oob_tcp_peer_t *peer, int status)
         pmix_list_append(&doomed, &peer->send_msg->super);
         peer->send_msg = NULL;
     }
+    /* nor is a segmented message that stood aside for the control lane */
+    if (NULL != peer->bulk_msg) {
+        pmix_list_append(&doomed, &peer->bulk_msg->super);
+        peer->bulk_msg = NULL;
+    }
+    while (NULL != (snd = (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->ctl_queue))) {
+        pmix_list_append(&doomed, &snd->super);
+    }
     while (NULL != (snd = (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->send_queue))) {
         pmix_list_append(&doomed, &snd->super);
     }
@@ -212,9 +227,52 @@ static void tcp_peer_fail_queued_sends(prte_oob_tcp_peer_t *peer, int status)
     PMIX_DESTRUCT(&doomed);
 }
 
+/*
+ * Connect to a peer on this host through its unix-domain socket.  It either
+ * connects at once or not at all - no socket yet, a full backlog, a peer
+ * that has gone - and anything short of connecting marks the socket failed
+ * for this round and leaves the peer to TCP.  Past connect() the connection
+ * is handled exactly as a TCP one.
+ */
+bool prte_oob_tcp_peer_connect_uds(prte_oob_tcp_peer_t *peer)
+{
+    prte_oob_tcp_addr_t *addr = peer->uds_addr;
+
+    if (peer->sd >= 0) {
+        CLOSE_THE_SOCKET(peer->sd);
+        peer->sd = -1;
+    }
+    if (PRTE_SUCCESS != tcp_peer_create_socket(peer, AF_UNIX)) {
+        addr->state = MCA_OOB_TCP_FAILED;
+        return false;
+    }
+    addr->retries++;
+    if (connect(peer->sd, (struct sockaddr *) &addr->addr, sizeof(struct sockaddr_un)) < 0) {
+        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                            "%s prte_tcp_peer_try_connect: %s unreachable on %s: %s (%d)",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
+                            ((struct sockaddr_un *) &addr->addr)->sun_path,
+                            strerror(prte_socket_errno), prte_socket_errno);
+        addr->state = MCA_OOB_TCP_FAILED;
+        CLOSE_THE_SOCKET(peer->sd);
+        peer->sd = -1;
+        return false;
+    }
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                        "%s prte_tcp_peer_try_connect: connected to %s on %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
+                        ((struct sockaddr_un *) &addr->addr)->sun_path);
+    addr->retries = 0;
+    peer->active_addr = addr;
+    peer->num_retries = 0;
+    peer->first_attempt = 0;
+    return true;
+}
+
 /*
  * Try connecting to a peer - cycle across all known addresses
- * until one succeeds.
+ * until one succeeds.  A peer on this host is tried on its unix-domain
+ * socket before any of them.
  */
 void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
 {
@@ -281,6 +339,10 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
                         peer->sd);
 
+    if (NULL != peer->uds_addr && MCA_OOB_TCP_FAILED != peer->uds_addr->state) {
+        connected = prte_oob_tcp_peer_connect_uds(peer);
+    }
+
     /* Loops over the reachable bitmap. This should only run once, but
      * if a connection does fail even after being declared as reachable,
      * it will try remaining connections.
@@ -483,6 +545,10 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
                     addr->state = MCA_OOB_TCP_UNCONNECTED;
                     addr->retries = 0;
                 }
+                if (NULL != peer->uds_addr) {
+                    peer->uds_addr->state = MCA_OOB_TCP_UNCONNECTED;
+                    peer->uds_addr->retries = 0;
+                }
                 /* give it awhile and try again.  The base case is a fixed
                  * delay of retry_delay seconds (unchanged behavior).  When
                  * retry_max_delay is larger, the delay backs off
@@ -514,7 +580,8 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
         /* no address succeeded, so we cannot reach this peer */
         peer->state = MCA_OOB_TCP_FAILED;
         host = prte_get_proc_hostname(&(peer->name));
-        if (NULL == host && NULL != peer->active_addr) {
+        if (NULL == host && NULL != peer->active_addr
+            && AF_UNIX != peer->active_addr->addr.ss_family) {
             host = pmix_net_get_hostname((struct sockaddr *) &(peer->active_addr->addr));
         }
         /* use an pmix_output here instead of show_help as we may well
@@ -557,6 +624,7 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
     /* send our globally unique process identifier to the peer */
     if (PRTE_SUCCESS == (rc = tcp_peer_send_connect_ack(peer))) {
         peer->state = MCA_OOB_TCP_CONNECT_ACK;
+        tcp_peer_handshake_timer(peer);
     } else if (PRTE_ERR_UNREACH == rc) {
         /* this could happen if we are in a race condition where both
          * we and the peer are trying to connect at the same time. If I
@@ -575,12 +643,21 @@ void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata)
          * and only the connect-in-progress return above hands it off */
         goto cleanup;
     } else {
-        pmix_output(0,
-                    "%s prte_tcp_peer_try_connect: "
-                    "tcp_peer_send_connect_ack to proc %s on %s:%d failed: %s (%d)",
-                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
-                    pmix_net_get_hostname((struct sockaddr *) &addr->addr),
-                    pmix_net_get_port((struct sockaddr *) &addr->addr), prte_strerror(rc), rc);
+        addr = peer->active_addr;
+        if (AF_UNIX == addr->addr.ss_family) {
+            pmix_output(0,
+                        "%s prte_tcp_peer_try_connect: "
+                        "tcp_peer_send_connect_ack to proc %s on %s failed: %s (%d)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
+                        ((struct sockaddr_un *) &addr->addr)->sun_path, prte_strerror(rc), rc);
+        } else {
+            pmix_output(0,
+                        "%s prte_tcp_peer_try_connect: "
+                        "tcp_peer_send_connect_ack to proc %s on %s:%d failed: %s (%d)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
+                        pmix_net_get_hostname((struct sockaddr *) &addr->addr),
+                        pmix_net_get_port((struct sockaddr *) &addr->addr), prte_strerror(rc), rc);
+        }
         /* close the socket */
         CLOSE_THE_SOCKET(peer->sd);
         tcp_peer_fail_queued_sends(peer, PRTE_ERR_UNREACH);
@@ -605,7 +682,12 @@ out:
 
 /* send a handshake that includes our process identifier, our
  * version string, and a security token to ensure we are talking
- * to another OMPI process
+ * to another OMPI process.
+ *
+ * This starts the handshake's clock, and goes out as fast as the socket
+ * will take it: whatever does not fit now is left in peer->hs and the
+ * peer's write event finishes it (prte_oob_tcp_peer_send_handshake).  So
+ * success means "on its way", and peer->hs.out says whether it is all out.
  */
 static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
 {
@@ -613,6 +695,7 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     prte_oob_tcp_hdr_t hdr;
     uint16_t ack_flag = htons(1);
     size_t sdsize, hdrsize, offset = 0;
+    int rc;
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                         "%s SEND CONNECT ACK", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -651,14 +734,23 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     memcpy(msg + offset, prte_version_string, strlen(prte_version_string) + 1);
     offset += strlen(prte_version_string) + 1;
 
-    /* send it */
-    if (PRTE_SUCCESS != tcp_peer_send_blocking(peer->sd, msg, sdsize)) {
-        free(msg);
+    /* send what the socket will take - the handshake owns the message now */
+    prte_oob_tcp_handshake_start(&peer->hs);
+    peer->hs.out = msg;
+    peer->hs.outlen = sdsize;
+    rc = tcp_peer_handshake_write(peer);
+    if (PRTE_ERR_WOULD_BLOCK == rc) {
+        /* the events are still on prte_event_base, and so are we */
+        if (!peer->send_ev_active) {
+            peer->send_ev_active = true;
+            PMIX_POST_OBJECT(peer);
+            prte_event_add(&peer->send_event, 0);
+        }
+    } else if (PRTE_SUCCESS != rc) {
         peer->state = MCA_OOB_TCP_FAILED;
         prte_oob_tcp_peer_close(peer);
         return PRTE_ERR_UNREACH;
     }
-    free(msg);
 
     return PRTE_SUCCESS;
 }
@@ -708,7 +800,7 @@ static int tcp_peer_send_connect_nack(int sd, pmix_proc_t *name)
     offset += sizeof(ack_flag);
 
     /* send it */
-    if (PRTE_SUCCESS != tcp_peer_send_blocking(sd, msg, sdsize)) {
+    if (PRTE_SUCCESS != tcp_peer_send_nb(sd, msg, sdsize)) {
         /* it's ok if it fails - remote side may already
          * identifiet the collision and closed the connection
          */
@@ -798,7 +890,8 @@ void prte_oob_tcp_peer_start_connect(int fd, short args, void *cbdata)
     PMIX_ACQUIRE_OBJECT(op);
     peer = op->peer;
 
-    if (MCA_OOB_TCP_CONNECTING == peer->state || MCA_OOB_TCP_CONNECT_ACK == peer->state) {
+    if (MCA_OOB_TCP_CONNECTING == peer->state || MCA_OOB_TCP_CONNECT_ACK == peer->state
+        || MCA_OOB_TCP_ACCEPTING == peer->state) {
         /* somebody beat us to it */
         PMIX_RELEASE(op);
         return;
@@ -808,7 +901,7 @@ void prte_oob_tcp_peer_start_connect(int fd, short args, void *cbdata)
          * message will actually go out */
         pmix_mutex_lock(&peer->lock);
         if (NULL == peer->send_msg) {
-            peer->send_msg = (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->send_queue);
+            peer->send_msg = prte_oob_tcp_peer_next_send(peer);
         }
         if (NULL != peer->send_msg && !peer->send_ev_active) {
             peer->send_ev_active = true;
@@ -881,6 +974,7 @@ void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t *peer)
 
     if (tcp_peer_send_connect_ack(peer) == PRTE_SUCCESS) {
         peer->state = MCA_OOB_TCP_CONNECT_ACK;
+        tcp_peer_handshake_timer(peer);
         pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                             "%s tcp_peer_complete_connect: "
                             "setting read event on connection to %s",
@@ -900,10 +994,12 @@ void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t *peer)
 }
 
 /*
- * A blocking send on a non-blocking socket. Used to send the small amount of connection
- * information that identifies the peers endpoint.
+ * Send the few bytes of a reply written just before the socket is closed -
+ * a nack, or the answer to a probe - without waiting for the socket.  Nobody
+ * is left to finish them later, so they go now or not at all; the IDENT we
+ * stay connected over goes through tcp_peer_handshake_write instead.
  */
-static int tcp_peer_send_blocking(int sd, void *data, size_t size)
+static int tcp_peer_send_nb(int sd, void *data, size_t size)
 {
     unsigned char *ptr = (unsigned char *) data;
     size_t cnt = 0;
@@ -912,31 +1008,193 @@ static int tcp_peer_send_blocking(int sd, void *data, size_t size)
     PMIX_ACQUIRE_OBJECT(ptr);
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                        "%s send blocking of %" PRIsize_t " bytes to socket %d",
+                        "%s send handshake of %" PRIsize_t " bytes to socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), size, sd);
 
     while (cnt < size) {
         retval = send(sd, (char *) ptr + cnt, size - cnt, 0);
         if (retval < 0) {
-            if (prte_socket_errno != EINTR && prte_socket_errno != EAGAIN
-                && prte_socket_errno != EWOULDBLOCK) {
-                pmix_output(0, "%s tcp_peer_send_blocking: send() to socket %d failed: %s (%d)\n",
+            if (prte_socket_errno == EINTR) {
+                continue;
+            }
+            if (prte_socket_errno == EAGAIN || prte_socket_errno == EWOULDBLOCK) {
+                pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                                    "%s tcp_peer_send_nb: socket %d cannot take the "
+                                    "reply - %" PRIsize_t " of %" PRIsize_t " bytes sent",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sd, cnt, size);
+            } else {
+                pmix_output(0, "%s tcp_peer_send_nb: send() to socket %d failed: %s (%d)\n",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sd, strerror(prte_socket_errno),
                             prte_socket_errno);
-                return PRTE_ERR_UNREACH;
             }
-            continue;
+            return PRTE_ERR_UNREACH;
         }
         cnt += retval;
     }
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                        "%s blocking send complete to socket %d",
+                        "%s handshake send complete to socket %d",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sd);
 
     return PRTE_SUCCESS;
 }
 
+/*
+ * Write as much of our pending IDENT as the socket will take.  Returns
+ * PRTE_SUCCESS once all of it is out, PRTE_ERR_WOULD_BLOCK while some is
+ * still to go - peer->hs remembers how much - and PRTE_ERR_UNREACH if the
+ * socket has failed.
+ */
+static int tcp_peer_handshake_write(prte_oob_tcp_peer_t *peer)
+{
+    prte_oob_tcp_handshake_t *hs = &peer->hs;
+    ssize_t retval;
+
+    while (hs->sent < hs->outlen) {
+        retval = send(peer->sd, hs->out + hs->sent, hs->outlen - hs->sent, 0);
+        if (retval < 0) {
+            if (prte_socket_errno == EINTR) {
+                continue;
+            }
+            if (prte_socket_errno == EAGAIN || prte_socket_errno == EWOULDBLOCK) {
+                pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                                    "%s handshake to %s waiting on socket %d - %" PRIsize_t
+                                    " of %" PRIsize_t " bytes sent",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                    PRTE_NAME_PRINT(&peer->name), peer->sd, hs->sent,
+                                    hs->outlen);
+                return PRTE_ERR_WOULD_BLOCK;
+            }
+            pmix_output(0, "%s tcp_peer_handshake_write: send() to socket %d failed: %s (%d)\n",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->sd,
+                        strerror(prte_socket_errno), prte_socket_errno);
+            return PRTE_ERR_UNREACH;
+        }
+        hs->sent += retval;
+    }
+
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                        "%s handshake send complete to %s on socket %d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
+                        peer->sd);
+    free(hs->out);
+    hs->out = NULL;
+    hs->outlen = 0;
+    hs->sent = 0;
+    return PRTE_SUCCESS;
+}
+
+/*
+ * The peer's socket is writable while our IDENT is still going out: send
+ * the next piece.  Runs from the send handler, on prte_event_base - the
+ * events only leave it at CONNECTED, which waits for this to finish.  Once
+ * the IDENT is all out, an accepted connection is done; one we placed goes
+ * on waiting for the answer, which its recv event is already armed for.
+ */
+void prte_oob_tcp_peer_send_handshake(prte_oob_tcp_peer_t *peer)
+{
+    int rc = PRTE_SUCCESS;
+
+    if (NULL != peer->hs.out) {
+        rc = tcp_peer_handshake_write(peer);
+        if (PRTE_ERR_WOULD_BLOCK == rc) {
+            /* the write event brings us back for the rest */
+            return;
+        }
+    }
+    if (peer->send_ev_active) {
+        prte_event_del(&peer->send_event);
+        peer->send_ev_active = false;
+    }
+    if (PRTE_SUCCESS != rc) {
+        peer->state = MCA_OOB_TCP_FAILED;
+        prte_oob_tcp_peer_close(peer);
+        return;
+    }
+    if (MCA_OOB_TCP_ACCEPTING == peer->state) {
+        tcp_peer_accepted(peer);
+    }
+}
+
+void prte_oob_tcp_handshake_reset(prte_oob_tcp_handshake_t *hs)
+{
+    if (NULL != hs->msg) {
+        free(hs->msg);
+    }
+    if (NULL != hs->out) {
+        free(hs->out);
+    }
+    memset(hs, 0, sizeof(*hs));
+}
+
+void prte_oob_tcp_handshake_start(prte_oob_tcp_handshake_t *hs)
+{
+    prte_oob_tcp_handshake_reset(hs);
+    if (0 < prte_oob_base.handshake_timeout) {
+        hs->deadline = time(NULL) + prte_oob_base.handshake_timeout;
+    }
+}
+
+int prte_oob_tcp_handshake_wait(prte_oob_tcp_handshake_t *hs, prte_event_t *ev)
+{
+    struct timeval tv;
+    time_t now;
+
+    if (0 == hs->deadline) {
+        prte_event_add(ev, 0);
+        return PRTE_SUCCESS;
+    }
+    now = time(NULL);
+    if (now >= hs->deadline) {
+        return PRTE_ERR_TIMEOUT;
+    }
+    tv.tv_sec = hs->deadline - now;
+    tv.tv_usec = 0;
+    prte_event_add(ev, &tv);
+    return PRTE_SUCCESS;
+}
+
+/* The handshake has had as long as prte_handshake_timeout allows and is not
+ * done: either the peer has not answered our IDENT, or it has not read all
+ * of it.  Treat it as any other handshake that broke down - closing a peer
+ * that is not yet established moves it on to its next address. */
+static void tcp_peer_ack_timeout(int fd, short args, void *cbdata)
+{
+    prte_oob_tcp_peer_t *peer = (prte_oob_tcp_peer_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(peer);
+    peer->timer_ev_active = false;
+    if (MCA_OOB_TCP_CONNECT_ACK != peer->state && MCA_OOB_TCP_ACCEPTING != peer->state) {
+        return;
+    }
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                        "%s handshake with %s timed out on socket %d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
+                        peer->sd);
+    if (MCA_OOB_TCP_ACCEPTING == peer->state) {
+        peer->state = MCA_OOB_TCP_FAILED;
+    }
+    prte_oob_tcp_peer_close(peer);
+}
+
+/* Our IDENT is on its way, and tcp_peer_send_connect_ack started the clock:
+ * hold the rest of the handshake - our send and, for a connection we placed,
+ * the peer's answer - to whatever that clock has left. */
+static void tcp_peer_handshake_timer(prte_oob_tcp_peer_t *peer)
+{
+    if (peer->timer_ev_active) {
+        prte_event_del(&peer->timer_event);
+        peer->timer_ev_active = false;
+    }
+    if (0 < peer->hs.deadline) {
+        prte_event_evtimer_set(prte_event_base, &peer->timer_event, tcp_peer_ack_timeout, peer);
+        if (PRTE_SUCCESS == prte_oob_tcp_handshake_wait(&peer->hs, &peer->timer_event)) {
+            peer->timer_ev_active = true;
+        }
+    }
+}
+
 /*
  *  Receive the peers globally unique process identification from a newly
  *  connected socket and verify the expected response. If so, move the
@@ -983,7 +1241,13 @@ static bool retry(prte_oob_tcp_peer_t *peer, int sd, bool fatal)
                 prte_event_del(&peer->recv_event);
                 peer->recv_ev_active = false;
             }
+            if (peer->timer_ev_active) {
+                prte_event_del(&peer->timer_event);
+                peer->timer_ev_active = false;
+            }
             CLOSE_THE_SOCKET(peer->sd);
+            /* whatever of our IDENT had not gone out went with it */
+            prte_oob_tcp_handshake_reset(&peer->hs);
             /* We have just thrown away our own socket in favour of the one
              * the caller accepted, and the caller carries on to finish the
              * handshake there, so that socket is the peer's from here on.
@@ -1004,7 +1268,8 @@ static bool retry(prte_oob_tcp_peer_t *peer, int sd, bool fatal)
     }
 }
 
-int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob_tcp_hdr_t *dhdr)
+int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd,
+                                       prte_oob_tcp_handshake_t *hs, prte_oob_tcp_hdr_t *dhdr)
 {
     char *msg;
     char *version;
@@ -1014,6 +1279,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
     pmix_proc_t sender;
     uint16_t ack_flag;
     bool is_new = (NULL == pr);
+    int rc;
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                         "%s RECV CONNECT ACK FROM %s ON SOCKET %d",
@@ -1021,155 +1287,197 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
                         (NULL == pr) ? "UNKNOWN" : PRTE_NAME_PRINT(&pr->name), sd);
 
     peer = pr;
-    /* get the fixed part of the header - the nspace that trails it is only
-     * as long as the header says, so it takes a second read */
-    if (tcp_peer_recv_blocking(peer, sd, &hdr, PRTE_OOB_TCP_HDR_FIXED)) {
-        if (NULL != peer) {
-            /* If the peer state is CONNECT_ACK, then we were waiting for
-             * the connection to be ack'd
-             */
-            if (peer->state != MCA_OOB_TCP_CONNECT_ACK) {
-                /* handshake broke down - abort this connection */
-                pmix_output(0, "%s RECV CONNECT BAD HANDSHAKE (%d) FROM %s ON SOCKET %d",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->state,
-                            PRTE_NAME_PRINT(&(peer->name)), sd);
-                prte_oob_tcp_peer_close(peer);
-                return PRTE_ERR_UNREACH;
-            }
+    /* Everything up to the payload is read and vetted once, however many
+     * events it takes to arrive; a call that finds the payload phase already
+     * reached picks the handshake up there. */
+    if (PRTE_OOB_TCP_HS_HDR == hs->phase) {
+        /* get the fixed part of the header - the nspace that trails it is
+         * only as long as the header says, so it takes a second read */
+        rc = tcp_peer_recv_nb(peer, sd, &hs->hdr, PRTE_OOB_TCP_HDR_FIXED, &hs->got);
+        if (PRTE_ERR_WOULD_BLOCK == rc) {
+            return rc;
         }
-    } else {
-        /* unable to complete the recv */
-        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                            "%s unable to complete recv of connect-ack from %s ON SOCKET %d",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name), sd);
-        return PRTE_ERR_UNREACH;
+        if (PRTE_SUCCESS != rc) {
+            /* unable to complete the recv */
+            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                                "%s unable to complete recv of connect-ack from %s ON SOCKET %d",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name), sd);
+            return PRTE_ERR_UNREACH;
+        }
+        /* If the peer state is CONNECT_ACK, then we were waiting for
+         * the connection to be ack'd
+         */
+        if (NULL != peer && peer->state != MCA_OOB_TCP_CONNECT_ACK) {
+            /* handshake broke down - abort this connection */
+            pmix_output(0, "%s RECV CONNECT BAD HANDSHAKE (%d) FROM %s ON SOCKET %d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->state,
+                        PRTE_NAME_PRINT(&(peer->name)), sd);
+            prte_oob_tcp_peer_close(peer);
+            return PRTE_ERR_UNREACH;
+        }
+        hs->phase = PRTE_OOB_TCP_HS_NSPACE;
+        hs->got = 0;
     }
 
-    /* and now the nspace those ranks belong to.  nslen is a single byte and
-     * PMIX_MAX_NSLEN is 255, so it cannot overrun the field */
-    if (0 < hdr.nslen && !tcp_peer_recv_blocking(peer, sd, hdr.nspace, hdr.nslen)) {
+    if (PRTE_OOB_TCP_HS_NSPACE == hs->phase) {
+        /* and now the nspace those ranks belong to.  nslen is a single byte
+         * and PMIX_MAX_NSLEN is 255, so it cannot overrun the field */
+        rc = tcp_peer_recv_nb(peer, sd, hs->hdr.nspace, hs->hdr.nslen, &hs->got);
+        if (PRTE_ERR_WOULD_BLOCK == rc) {
+            return rc;
+        }
+        if (PRTE_SUCCESS != rc) {
+            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                                "%s unable to complete recv of connect-ack nspace from %s ON SOCKET %d",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name), sd);
+            return PRTE_ERR_UNREACH;
+        }
+        PRTE_OOB_TCP_HDR_END_NSPACE(&hs->hdr);
+        hdr = hs->hdr;
+
         pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                            "%s unable to complete recv of connect-ack nspace from %s ON SOCKET %d",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                            (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name), sd);
-        return PRTE_ERR_UNREACH;
-    }
-    PRTE_OOB_TCP_HDR_END_NSPACE(&hdr);
+                            "%s connect-ack recvd from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name));
+
+        /* convert the header */
+        MCA_OOB_TCP_HDR_NTOH(&hdr);
+
+        /* A handshake is the one header that carries a namespace, and this is
+         * the one place it is checked - which is what lets every message that
+         * follows leave it out and be reconstructed with our own (see
+         * oob_tcp_hdr.h).  Only daemons of this DVM have an OOB endpoint, so a
+         * peer naming any other namespace is not a peer of ours: a daemon of a
+         * different DVM belonging to the same user, or a process claiming to be
+         * one.  Refuse it rather than adopt it as the local daemon of that rank.
+         * An absent namespace is refused for the same reason - it would fall
+         * back to ours and defeat the check. */
+        if (0 == hdr.nslen
+            || !PMIX_CHECK_NSPACE(hdr.nspace, PRTE_PROC_MY_NAME->nspace)) {
+            pmix_output(0,
+                        "%s tcp_peer_recv_connect_ack: refusing a connection from "
+                        "namespace \"%s\" - this daemon serves \"%s\"",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        (0 == hdr.nslen) ? "(none given)" : hdr.nspace,
+                        PRTE_PROC_MY_NAME->nspace);
+            if (NULL != peer) {
+                peer->state = MCA_OOB_TCP_FAILED;
+                prte_oob_tcp_peer_close(peer);
+            } else {
+                CLOSE_THE_SOCKET(sd);
+            }
+            return PRTE_ERR_CONNECTION_REFUSED;
+        }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                        "%s connect-ack recvd from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                        (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&peer->name));
-
-    /* convert the header */
-    MCA_OOB_TCP_HDR_NTOH(&hdr);
-
-    /* A handshake is the one header that carries a namespace, and this is
-     * the one place it is checked - which is what lets every message that
-     * follows leave it out and be reconstructed with our own (see
-     * oob_tcp_hdr.h).  Only daemons of this DVM have an OOB endpoint, so a
-     * peer naming any other namespace is not a peer of ours: a daemon of a
-     * different DVM belonging to the same user, or a process claiming to be
-     * one.  Refuse it rather than adopt it as the local daemon of that rank.
-     * An absent namespace is refused for the same reason - it would fall
-     * back to ours and defeat the check. */
-    if (0 == hdr.nslen
-        || !PMIX_CHECK_NSPACE(hdr.nspace, PRTE_PROC_MY_NAME->nspace)) {
-        pmix_output(0,
-                    "%s tcp_peer_recv_connect_ack: refusing a connection from "
-                    "namespace \"%s\" - this daemon serves \"%s\"",
-                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                    (0 == hdr.nslen) ? "(none given)" : hdr.nspace,
-                    PRTE_PROC_MY_NAME->nspace);
-        if (NULL != peer) {
-            peer->state = MCA_OOB_TCP_FAILED;
-            prte_oob_tcp_peer_close(peer);
-        } else {
+        /* rebuild the sender's identity, which the header carries as a rank
+         * plus the nspace read above */
+        PRTE_OOB_TCP_HDR_PROC(&hdr, hdr.origin, &sender);
+        /* if the requestor wanted the header returned, then do so now */
+        if (NULL != dhdr) {
+            *dhdr = hdr;
+        }
+
+        if (MCA_OOB_TCP_PROBE == hdr.type) {
+            size_t hdrsize;
+            /* send a header back */
+            hdr.type = MCA_OOB_TCP_PROBE;
+            hdr.dst = hdr.origin;
+            hdr.origin = PRTE_PROC_MY_NAME->rank;
+            PRTE_OOB_TCP_HDR_LOAD_NSPACE(&hdr, PRTE_PROC_MY_NAME->nspace);
+            hdrsize = PRTE_OOB_TCP_HDR_LEN(&hdr);
+            MCA_OOB_TCP_HDR_HTON(&hdr);
+            tcp_peer_send_nb(sd, &hdr, hdrsize);
             CLOSE_THE_SOCKET(sd);
+            return PRTE_SUCCESS;
         }
-        return PRTE_ERR_CONNECTION_REFUSED;
-    }
 
-    /* rebuild the sender's identity, which the header carries as a rank
-     * plus the nspace read above */
-    PRTE_OOB_TCP_HDR_PROC(&hdr, hdr.origin, &sender);
-    /* if the requestor wanted the header returned, then do so now */
-    if (NULL != dhdr) {
-        *dhdr = hdr;
-    }
-
-    if (MCA_OOB_TCP_PROBE == hdr.type) {
-        size_t hdrsize;
-        /* send a header back */
-        hdr.type = MCA_OOB_TCP_PROBE;
-        hdr.dst = hdr.origin;
-        hdr.origin = PRTE_PROC_MY_NAME->rank;
-        PRTE_OOB_TCP_HDR_LOAD_NSPACE(&hdr, PRTE_PROC_MY_NAME->nspace);
-        hdrsize = PRTE_OOB_TCP_HDR_LEN(&hdr);
-        MCA_OOB_TCP_HDR_HTON(&hdr);
-        tcp_peer_send_blocking(sd, &hdr, hdrsize);
-        CLOSE_THE_SOCKET(sd);
-        return PRTE_SUCCESS;
-    }
+        if (hdr.type != MCA_OOB_TCP_IDENT) {
+            pmix_output(0, "tcp_peer_recv_connect_ack: invalid header type: %d\n", hdr.type);
+            if (NULL != peer) {
+                peer->state = MCA_OOB_TCP_FAILED;
+                prte_oob_tcp_peer_close(peer);
+            } else {
+                CLOSE_THE_SOCKET(sd);
+            }
+            return PRTE_ERR_COMM_FAILURE;
+        }
 
-    if (hdr.type != MCA_OOB_TCP_IDENT) {
-        pmix_output(0, "tcp_peer_recv_connect_ack: invalid header type: %d\n", hdr.type);
-        if (NULL != peer) {
-            peer->state = MCA_OOB_TCP_FAILED;
-            prte_oob_tcp_peer_close(peer);
+        /* if we don't already have it, get the peer */
+        if (NULL == peer) {
+            peer = prte_oob_tcp_peer_lookup(&sender);
+            if (NULL == peer) {
+                pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                                    "%s prte_oob_tcp_recv_connect: connection from new peer",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+                peer = PMIX_NEW(prte_oob_tcp_peer_t);
+                PMIX_XFER_PROCID(&peer->name, &sender);
+                peer->state = MCA_OOB_TCP_ACCEPTING;
+                pmix_list_append(&prte_oob_base.peers, &peer->super);
+            }
         } else {
-            CLOSE_THE_SOCKET(sd);
+            /* compare the peers name to the expected value */
+            if (!PMIX_CHECK_PROCID(&peer->name, &sender)) {
+                pmix_output(0,
+                            "%s tcp_peer_recv_connect_ack: "
+                            "received unexpected process identifier %s from %s\n",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&sender),
+                            PRTE_NAME_PRINT(&(peer->name)));
+                peer->state = MCA_OOB_TCP_FAILED;
+                prte_oob_tcp_peer_close(peer);
+                return PRTE_ERR_CONNECTION_REFUSED;
+            }
         }
-        return PRTE_ERR_COMM_FAILURE;
-    }
 
-    /* if we don't already have it, get the peer */
-    if (NULL == peer) {
-        peer = prte_oob_tcp_peer_lookup(&sender);
-        if (NULL == peer) {
-            pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                                "%s prte_oob_tcp_recv_connect: connection from new peer",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-            peer = PMIX_NEW(prte_oob_tcp_peer_t);
-            PMIX_XFER_PROCID(&peer->name, &sender);
-            peer->state = MCA_OOB_TCP_ACCEPTING;
-            pmix_list_append(&prte_oob_base.peers, &peer->super);
+        pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                            "%s connect-ack header from %s is okay",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
+
+        /* get the authentication and version payload */
+        if (hdr.nbytes > (uint32_t)(prte_oob_base.max_msg_size * 1024 * 1024)) {
+            prte_show_help("help-oob-tcp.txt", "msg-too-big", true,
+                            PRTE_NAME_PRINT(&peer->name), PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                            hdr.nbytes, prte_oob_base.max_msg_size);
+            abort_handshake(peer, sd);
+            return PRTE_ERR_OUT_OF_RESOURCE;
         }
+        if (NULL == (hs->msg = (char *) malloc(hdr.nbytes))) {
+            abort_handshake(peer, sd);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        /* keep the converted header - it is what the rest of this works from */
+        hs->hdr = hdr;
+        hs->phase = PRTE_OOB_TCP_HS_PAYLOAD;
+        hs->got = 0;
     } else {
-        /* compare the peers name to the expected value */
-        if (!PMIX_CHECK_PROCID(&peer->name, &sender)) {
-            pmix_output(0,
-                        "%s tcp_peer_recv_connect_ack: "
-                        "received unexpected process identifier %s from %s\n",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&sender),
-                        PRTE_NAME_PRINT(&(peer->name)));
-            peer->state = MCA_OOB_TCP_FAILED;
-            prte_oob_tcp_peer_close(peer);
-            return PRTE_ERR_CONNECTION_REFUSED;
+        /* picking up where an earlier call left off */
+        hdr = hs->hdr;
+        PRTE_OOB_TCP_HDR_PROC(&hdr, hdr.origin, &sender);
+        if (NULL != dhdr) {
+            *dhdr = hdr;
+        }
+        if (NULL == peer && NULL == (peer = prte_oob_tcp_peer_lookup(&sender))) {
+            /* it was looked up or made when the header came in, and
+             * nothing removes a peer */
+            CLOSE_THE_SOCKET(sd);
+            return PRTE_ERR_UNREACH;
         }
     }
 
-    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                        "%s connect-ack header from %s is okay", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                        PRTE_NAME_PRINT(&peer->name));
-
-    /* get the authentication and version payload */
-    if (hdr.nbytes > (uint32_t)(prte_oob_base.max_msg_size * 1024 * 1024)) {
-        prte_show_help("help-oob-tcp.txt", "msg-too-big", true,
-                        PRTE_NAME_PRINT(&peer->name), PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                        hdr.nbytes, prte_oob_base.max_msg_size);
-        abort_handshake(peer, sd);
-        return PRTE_ERR_OUT_OF_RESOURCE;
-    }
-    if (NULL == (msg = (char *) malloc(hdr.nbytes))) {
-        abort_handshake(peer, sd);
-        return PRTE_ERR_OUT_OF_RESOURCE;
-    }
     /* An inbound handshake is read with no peer, exactly as the two reads
      * above it were: the peer we just looked up does not own this socket, so
-     * recv_blocking must dispose of the socket rather than of the peer. */
-    if (!tcp_peer_recv_blocking(is_new ? NULL : peer, sd, msg, hdr.nbytes)) {
-        /* unable to complete the recv but should never happen */
+     * recv_nb must dispose of the socket rather than of the peer. */
+    rc = tcp_peer_recv_nb(is_new ? NULL : peer, sd, hs->msg, hdr.nbytes, &hs->got);
+    if (PRTE_ERR_WOULD_BLOCK == rc) {
+        return rc;
+    }
+    /* the handshake is ours now, whatever becomes of it */
+    msg = hs->msg;
+    hs->msg = NULL;
+    hs->phase = PRTE_OOB_TCP_HS_HDR;
+    hs->got = 0;
+    if (PRTE_SUCCESS != rc) {
+        /* unable to complete the recv */
         pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                             "%s unable to complete recv of connect-ack from %s ON SOCKET %d",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
@@ -1231,7 +1539,8 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
      */
     if (is_new
         && (MCA_OOB_TCP_CONNECTED == peer->state || MCA_OOB_TCP_CONNECTING == peer->state
-            || MCA_OOB_TCP_CONNECT_ACK == peer->state)) {
+            || MCA_OOB_TCP_CONNECT_ACK == peer->state
+            || (MCA_OOB_TCP_ACCEPTING == peer->state && NULL != peer->hs.out))) {
         if (retry(peer, sd, false)) {
             free(msg);
             return PRTE_ERR_UNREACH;
@@ -1329,7 +1638,7 @@ static void tcp_peer_connected(prte_oob_tcp_peer_t *peer)
 
     /* initiate send of first message on queue */
     if (NULL == peer->send_msg) {
-        peer->send_msg = (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->send_queue);
+        peer->send_msg = prte_oob_tcp_peer_next_send(peer);
     }
     if (NULL != peer->send_msg && !peer->send_ev_active) {
         peer->send_ev_active = true;
@@ -1409,6 +1718,7 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
         }
         close(peer->sd);
         peer->sd = -1;
+        prte_oob_tcp_handshake_reset(&peer->hs);
         if (NULL != peer->active_addr) {
             /* FAILED stops try_connect from picking this address again, so
              * the candidate set shrinks and the rotation terminates.  With
@@ -1449,6 +1759,7 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
     }
     close(peer->sd);
     peer->sd = -1;
+    prte_oob_tcp_handshake_reset(&peer->hs);
 
     /* clean up any partial send/recv data - the recv object's destructor
      * disposes of whatever payload had already been read into it */
@@ -1456,6 +1767,10 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
         PMIX_RELEASE(peer->recv_msg);
         peer->recv_msg = NULL;
     }
+    if (NULL != peer->bulk_recv) {
+        PMIX_RELEASE(peer->bulk_recv);
+        peer->bulk_recv = NULL;
+    }
 
     /* inform rml of all queued sends' completion (as failures)
      * do not try to re-queue messages at this level - risking message loss is
@@ -1475,25 +1790,28 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
 }
 
 /*
- * A blocking recv on a non-blocking socket. Used to receive the small amount of connection
- * information that identifies the peers endpoint.
+ * Read what has arrived of one part of a handshake, without waiting for the
+ * rest.  "*got" is how much of "size" earlier calls read; returns
+ * PRTE_SUCCESS once all of it is in and PRTE_ERR_WOULD_BLOCK while it is not.
+ * Any other return means the connection is gone and has been disposed of -
+ * the peer closed if it owns the socket, else the socket alone.
  */
-static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data, size_t size)
+static int tcp_peer_recv_nb(prte_oob_tcp_peer_t *peer, int sd, void *data, size_t size,
+                            size_t *got)
 {
     unsigned char *ptr = (unsigned char *) data;
-    size_t cnt = 0;
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                        "%s waiting for connect ack from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        "%s reading connect ack from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&(peer->name)));
 
-    while (cnt < size) {
-        int retval = recv(sd, (char *) ptr + cnt, size - cnt, 0);
+    while (*got < size) {
+        int retval = recv(sd, (char *) ptr + *got, size - *got, 0);
 
         /* remote closed connection */
         if (retval == 0) {
             pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
-                                "%s-%s tcp_peer_recv_blocking: "
+                                "%s-%s tcp_peer_recv_nb: "
                                 "peer closed connection: peer state %d",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                 (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&(peer->name)),
@@ -1503,59 +1821,62 @@ static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data
             } else {
                 CLOSE_THE_SOCKET(sd);
             }
-            return false;
+            return PRTE_ERR_UNREACH;
         }
 
         /* socket is non-blocking so handle errors */
         if (retval < 0) {
-            if (prte_socket_errno != EINTR && prte_socket_errno != EAGAIN
-                && prte_socket_errno != EWOULDBLOCK) {
-                if (NULL == peer) {
-                    /* protect against things like port scanners */
-                    CLOSE_THE_SOCKET(sd);
-                    return false;
-                } else if (peer->state == MCA_OOB_TCP_CONNECT_ACK) {
-                    /* If we overflow the listen backlog, it's
-                       possible that even though we finished the three
-                       way handshake, the remote host was unable to
-                       transition the connection from half connected
-                       (received the initial SYN) to fully connected
-                       (in the listen backlog).  We likely won't see
-                       the failure until we try to receive, due to
-                       timing and the like.  The first thing we'll get
-                       in that case is a RST packet, which receive
-                       will turn into a connection reset by peer
-                       errno.  In that case, leave the socket in
-                       CONNECT_ACK and propogate the error up to
-                       recv_connect_ack, who will try to establish the
-                       connection again */
-                    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
-                                        prte_oob_base.output,
-                                        "%s connect ack received error %s from %s",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        strerror(prte_socket_errno),
-                                        PRTE_NAME_PRINT(&(peer->name)));
-                    return false;
-                } else {
-                    pmix_output(0,
-                                "%s tcp_peer_recv_blocking: "
-                                "recv() failed for %s: %s (%d)\n",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
-                                strerror(prte_socket_errno), prte_socket_errno);
-                    peer->state = MCA_OOB_TCP_FAILED;
-                    prte_oob_tcp_peer_close(peer);
-                    return false;
-                }
+            if (prte_socket_errno == EINTR) {
+                continue;
+            }
+            if (prte_socket_errno == EAGAIN || prte_socket_errno == EWOULDBLOCK) {
+                /* the rest is still on its way - come back when it is here */
+                return PRTE_ERR_WOULD_BLOCK;
+            }
+            if (NULL == peer) {
+                /* protect against things like port scanners */
+                CLOSE_THE_SOCKET(sd);
+                return PRTE_ERR_UNREACH;
+            } else if (peer->state == MCA_OOB_TCP_CONNECT_ACK) {
+                /* If we overflow the listen backlog, it's
+                   possible that even though we finished the three
+                   way handshake, the remote host was unable to
+                   transition the connection from half connected
+                   (received the initial SYN) to fully connected
+                   (in the listen backlog).  We likely won't see
+                   the failure until we try to receive, due to
+                   timing and the like.  The first thing we'll get
+                   in that case is a RST packet, which receive
+                   will turn into a connection reset by peer
+                   errno.  In that case, leave the socket in
+                   CONNECT_ACK and propogate the error up to
+                   recv_connect_ack, who will try to establish the
+                   connection again */
+                pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
+                                    prte_oob_base.output,
+                                    "%s connect ack received error %s from %s",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                    strerror(prte_socket_errno),
+                                    PRTE_NAME_PRINT(&(peer->name)));
+                return PRTE_ERR_UNREACH;
+            } else {
+                pmix_output(0,
+                            "%s tcp_peer_recv_nb: "
+                            "recv() failed for %s: %s (%d)\n",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
+                            strerror(prte_socket_errno), prte_socket_errno);
+                peer->state = MCA_OOB_TCP_FAILED;
+                prte_oob_tcp_peer_close(peer);
+                return PRTE_ERR_UNREACH;
             }
-            continue;
         }
-        cnt += retval;
+        *got += retval;
     }
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                         "%s connect ack received from %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         (NULL == peer) ? "UNKNOWN" : PRTE_NAME_PRINT(&(peer->name)));
-    return true;
+    return PRTE_SUCCESS;
 }
 
 /*
@@ -1563,9 +1884,9 @@ static bool tcp_peer_recv_blocking(prte_oob_tcp_peer_t *peer, int sd, void *data
  */
 void prte_oob_tcp_peer_dump(prte_oob_tcp_peer_t *peer, const char *msg)
 {
-    char src[64];
-    char dst[64];
-    char buff[255];
+    char src[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+    char dst[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+    char buff[512];
     int sndbuf, rcvbuf, nodelay, flags;
     struct sockaddr_storage inaddr;
     prte_socklen_t addrlen = sizeof(struct sockaddr_storage);
@@ -1575,13 +1896,19 @@ void prte_oob_tcp_peer_dump(prte_oob_tcp_peer_t *peer, const char *msg)
         pmix_output(0, "tcp_peer_dump: getsockname error: %s (%d)\n",
                     strerror(prte_socket_errno), prte_socket_errno);
         snprintf(src, sizeof(src), "%s", "unknown");
+    } else if (AF_UNIX == inaddr.ss_family) {
+        /* a unix-domain end has a path, if it was bound, and no host */
+        snprintf(src, sizeof(src), "%s", ((struct sockaddr_un *) &inaddr)->sun_path);
     } else {
         snprintf(src, sizeof(src), "%s", pmix_net_get_hostname((struct sockaddr *) &inaddr));
     }
+    addrlen = sizeof(struct sockaddr_storage);
     if (getpeername(peer->sd, (struct sockaddr *) &inaddr, &addrlen) < 0) {
         pmix_output(0, "tcp_peer_dump: getpeername error: %s (%d)\n",
                     strerror(prte_socket_errno), prte_socket_errno);
         snprintf(dst, sizeof(dst), "%s", "unknown");
+    } else if (AF_UNIX == inaddr.ss_family) {
+        snprintf(dst, sizeof(dst), "%s", ((struct sockaddr_un *) &inaddr)->sun_path);
     } else {
         snprintf(dst, sizeof(dst), "%s", pmix_net_get_hostname((struct sockaddr *) &inaddr));
     }
@@ -1650,16 +1977,15 @@ bool prte_oob_tcp_peer_accept(prte_oob_tcp_peer_t *peer)
             return false;
         }
 
-        tcp_peer_connected(peer);
-        if (!peer->recv_ev_active) {
-            peer->recv_ev_active = true;
-            PMIX_POST_OBJECT(peer);
-            prte_event_add(&peer->recv_event, 0);
-        }
-        if (OOB_TCP_DEBUG_CONNECT
-            <= pmix_output_get_verbosity(prte_oob_base.output)) {
-            prte_oob_tcp_peer_dump(peer, "accepted");
+        if (NULL != peer->hs.out) {
+            /* the socket has not taken all of our ack yet - the peer's
+             * write event finishes it, and the connection is ours once
+             * it has */
+            peer->state = MCA_OOB_TCP_ACCEPTING;
+            tcp_peer_handshake_timer(peer);
+            return true;
         }
+        tcp_peer_accepted(peer);
         return true;
     }
 
@@ -1669,3 +1995,18 @@ bool prte_oob_tcp_peer_accept(prte_oob_tcp_peer_t *peer)
                         prte_oob_tcp_state_print(peer->state), peer->sd);
     return false;
 }
+
+/* Our ack to an accepted connection is all out: it is connected. */
+static void tcp_peer_accepted(prte_oob_tcp_peer_t *peer)
+{
+    tcp_peer_connected(peer);
+    if (!peer->recv_ev_active) {
+        peer->recv_ev_active = true;
+        PMIX_POST_OBJECT(peer);
+        prte_event_add(&peer->recv_event, 0);
+    }
+    if (OOB_TCP_DEBUG_CONNECT
+        <= pmix_output_get_verbosity(prte_oob_base.output)) {
+        prte_oob_tcp_peer_dump(peer, "accepted");
+    }
+}
@@ -44,6 +44,8 @@ typedef struct {
     pmix_object_t super;
     prte_oob_tcp_peer_t *peer;
     prte_event_t ev;
+    /* an accepted socket's handshake, as far as it has arrived */
+    prte_oob_tcp_handshake_t hs;
 } prte_oob_tcp_conn_op_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
 
@@ -71,8 +73,9 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
         prte_oob_tcp_conn_op_t *cop;                                               \
         cop = PMIX_NEW(prte_oob_tcp_conn_op_t);                                    \
         prte_event_set(prte_event_base, &cop->ev, s, PRTE_EV_READ, (cbfunc), cop); \
+        prte_oob_tcp_handshake_start(&cop->hs);                                    \
         PMIX_POST_OBJECT(cop);                                                     \
-        prte_event_add(&cop->ev, 0);                                               \
+        (void) prte_oob_tcp_handshake_wait(&cop->hs, &cop->ev);                    \
     } while (0);
 
 #define PRTE_RETRY_TCP_CONN_STATE(p, cbfunc, tv)                                                  \
@@ -89,6 +92,11 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_conn_op_t);
     } while (0);
 
 PRTE_EXPORT void prte_oob_tcp_peer_try_connect(int fd, short args, void *cbdata);
+/* Connect to a peer on this host through its unix-domain socket, which
+ * try_connect does before any TCP address.  On failure the socket is marked
+ * failed, so that try_connect goes on to TCP and leaves it alone until the
+ * next round of retries. */
+PRTE_EXPORT bool prte_oob_tcp_peer_connect_uds(prte_oob_tcp_peer_t *peer);
 /* Ask the main progress thread to (re)start the connection to a peer. Use
  * this rather than try_connect when the caller may not be on that thread:
  * it makes the "is it already coming up?" test and the state transition
@@ -97,8 +105,21 @@ PRTE_EXPORT void prte_oob_tcp_peer_start_connect(int fd, short args, void *cbdat
 PRTE_EXPORT void prte_oob_tcp_peer_dump(prte_oob_tcp_peer_t *peer, const char *msg);
 PRTE_EXPORT bool prte_oob_tcp_peer_accept(prte_oob_tcp_peer_t *peer);
 PRTE_EXPORT void prte_oob_tcp_peer_complete_connect(prte_oob_tcp_peer_t *peer);
+/* Write more of our IDENT once the socket will take it; called from the
+ * send handler while a handshake is still going out. */
+PRTE_EXPORT void prte_oob_tcp_peer_send_handshake(prte_oob_tcp_peer_t *peer);
+/* Read and act on an IDENT handshake arriving on "sd", without blocking.
+ * Returns PRTE_ERR_WOULD_BLOCK when only part of it has arrived: "hs" holds
+ * what has, and the caller calls again once the socket is readable. */
 PRTE_EXPORT int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *peer, int sd,
-                                                          prte_oob_tcp_hdr_t *dhdr);
+                                                   prte_oob_tcp_handshake_t *hs,
+                                                   prte_oob_tcp_hdr_t *dhdr);
+/* Start a handshake's clock, and forget whatever an earlier one read. */
+PRTE_EXPORT void prte_oob_tcp_handshake_start(prte_oob_tcp_handshake_t *hs);
+PRTE_EXPORT void prte_oob_tcp_handshake_reset(prte_oob_tcp_handshake_t *hs);
+/* Add "ev" to wait for more of the handshake, for no longer than it has
+ * left.  Returns PRTE_ERR_TIMEOUT, adding nothing, if that is no time. */
+PRTE_EXPORT int prte_oob_tcp_handshake_wait(prte_oob_tcp_handshake_t *hs, prte_event_t *ev);
 PRTE_EXPORT void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer);
 
 #endif /* _MCA_OOB_TCP_CONNECTION_H_ */
@@ -37,12 +37,21 @@
 /* Message types carried in the TCP header. IDENT and PROBE are used
  * during the connection handshake; USER marks a normal RML message,
  * whether it is destined for us or is being relayed on to the next hop.
+ *
+ * A bulk USER message longer than prte_oob_segment_size goes out as a run
+ * of SEG headers, each followed by the next slice of its body, the last of
+ * them SEG_LAST.  Every one carries the whole message's origin, dst, tag and
+ * seq_num; nbytes is the slice.  Whole messages from the control lane may
+ * come between two slices, but the slices of one message are never mixed
+ * with another's - a peer has at most one bulk message part-way out.
  */
 typedef uint8_t prte_oob_tcp_msg_type_t;
 
-#define MCA_OOB_TCP_IDENT 1
-#define MCA_OOB_TCP_PROBE 2
-#define MCA_OOB_TCP_USER  4
+#define MCA_OOB_TCP_IDENT    1
+#define MCA_OOB_TCP_PROBE    2
+#define MCA_OOB_TCP_USER     4
+#define MCA_OOB_TCP_SEG      8
+#define MCA_OOB_TCP_SEG_LAST 16
 
 /* header for tcp msgs
  *
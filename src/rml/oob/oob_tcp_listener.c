@@ -48,7 +48,12 @@
 #ifdef HAVE_NETDB_H
 #    include <netdb.h>
 #endif
+#ifdef HAVE_SYS_UN_H
+#    include <sys/un.h>
+#endif
 #include <ctype.h>
+#include <stdio.h>
+#include <string.h>
 
 #include "src/class/pmix_list.h"
 #include "src/include/prte_socket_errno.h"
@@ -74,15 +79,31 @@
 #include "src/rml/oob/oob_tcp_listener.h"
 #include "src/rml/oob/oob_tcp_peer.h"
 
+/* room for a printed address: host:port, or a unix-domain path */
+#define PRTE_OOB_TCP_WHERE_LEN 128
+
 static void connection_event_handler(int incoming_sd, short flags, void *cbdata);
 static void *listen_thread(pmix_object_t *obj);
 static int create_listen(void);
 #if PRTE_ENABLE_IPV6
 static int create_listen6(void);
 #endif
+static void create_listen_uds(void);
 static void connection_handler(int sd, short flags, void *cbdata);
 static void connection_event_handler(int sd, short flags, void *cbdata);
 
+/* an accepted address for the log - a unix-domain one has neither a host
+ * nor a port, only a path (which is empty for a peer that did not bind) */
+static const char *conn_print(const struct sockaddr *sa, char *buf, size_t len)
+{
+    if (AF_UNIX == sa->sa_family) {
+        snprintf(buf, len, "%s", ((const struct sockaddr_un *) sa)->sun_path);
+    } else {
+        snprintf(buf, len, "%s:%d", pmix_net_get_hostname(sa), pmix_net_get_port(sa));
+    }
+    return buf;
+}
+
 /*
  * Component initialization - create a module for each available
  * TCP interface and initialize the static resources associated
@@ -129,6 +150,8 @@ int prte_oob_tcp_start_listening(void)
     }
 #endif
 
+    /* peers on this host can also reach us through the session directory */
+    create_listen_uds();
 
     /* if I am the HNP, start a listening thread so we can
      * harvest connection requests as rapidly as possible
@@ -563,6 +586,135 @@ static int create_listen6(void)
 }
 #endif
 
+/*
+ * Name this host for the peers that read our contact info.  A peer that
+ * finds its own name in it is on the same host, and so sees the same
+ * session directory.  That rules out prte_process_info.nodename, which
+ * prte_hostname can set to anything (emulated nodes all share one host):
+ * it is what the OS calls the host, plus its boot id where there is one
+ * to tell apart containers and guests that share a hostname.
+ */
+int prte_oob_tcp_set_uds_host(void)
+{
+    char host[PRTE_MAXHOSTNAMELEN], boot[64];
+    FILE *fp;
+    size_t n;
+
+    if (NULL != prte_oob_base.uds_host) {
+        return PRTE_SUCCESS;
+    }
+    memset(host, 0, sizeof(host));
+    if (0 != gethostname(host, sizeof(host) - 1) || '\0' == host[0]) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+    /* the name goes into a ':'-separated field */
+    if (NULL != strchr(host, ':') || NULL != strchr(host, ';')) {
+        return PRTE_ERR_BAD_PARAM;
+    }
+    memset(boot, 0, sizeof(boot));
+    if (NULL != (fp = fopen("/proc/sys/kernel/random/boot_id", "r"))) {
+        if (NULL != fgets(boot, sizeof(boot), fp)) {
+            n = strlen(boot);
+            while (0 < n && ('\n' == boot[n - 1] || ' ' == boot[n - 1])) {
+                boot[--n] = '\0';
+            }
+        }
+        fclose(fp);
+    }
+    if ('\0' == boot[0]) {
+        prte_oob_base.uds_host = strdup(host);
+    } else {
+        pmix_asprintf(&prte_oob_base.uds_host, "%s@%s", host, boot);
+    }
+    return PRTE_SUCCESS;
+}
+
+/*
+ * Create a unix-domain listen socket in our session directory for peers on
+ * this host, which otherwise reach us over TCP loopback.  Not getting one
+ * is not an error - those peers simply keep using TCP - so this only says
+ * why at a verbose level.
+ *
+ * Like the others, the caller registers whatever events it needs.
+ */
+static void create_listen_uds(void)
+{
+    struct sockaddr_un un;
+    prte_oob_tcp_listener_t *conn;
+    char *path = NULL;
+    int sd, flags;
+
+    if (!prte_oob_base.uds_enable || NULL == prte_process_info.top_session_dir) {
+        return;
+    }
+    if (PRTE_SUCCESS != prte_oob_tcp_set_uds_host()) {
+        pmix_output_verbose(5, prte_oob_base.output,
+                            "%s cannot name this host - no unix-domain listener",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+        return;
+    }
+
+    /* the top session dir is already ours alone - it carries our pid */
+    pmix_asprintf(&path, "%s/oob.sock", prte_process_info.top_session_dir);
+    if (NULL == path) {
+        return;
+    }
+    memset(&un, 0, sizeof(un));
+    if (sizeof(un.sun_path) <= strlen(path)) {
+        pmix_output_verbose(5, prte_oob_base.output,
+                            "%s unix-domain socket path %s is too long - not listening on it",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), path);
+        free(path);
+        return;
+    }
+    un.sun_family = AF_UNIX;
+    memcpy(un.sun_path, path, strlen(path));
+
+    sd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sd < 0) {
+        pmix_output_verbose(5, prte_oob_base.output,
+                            "%s unix-domain socket() failed: %s (%d)",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), strerror(prte_socket_errno),
+                            prte_socket_errno);
+        free(path);
+        return;
+    }
+    if (pmix_fd_set_cloexec(sd) != PRTE_SUCCESS) {
+        goto fail;
+    }
+    /* a stale socket can only be left by an earlier process with our pid */
+    (void) unlink(path);
+    if (bind(sd, (struct sockaddr *) &un, sizeof(un)) < 0) {
+        goto fail;
+    }
+    if (listen(sd, SOMAXCONN) < 0) {
+        unlink(path);
+        goto fail;
+    }
+    if ((flags = fcntl(sd, F_GETFL, 0)) < 0 || fcntl(sd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        unlink(path);
+        goto fail;
+    }
+
+    conn = PMIX_NEW(prte_oob_tcp_listener_t);
+    conn->sd = sd;
+    conn->path = path;
+    pmix_list_append(&prte_oob_base.listeners, &conn->item);
+    prte_oob_base.uds_path = strdup(path);
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
+                        "%s listening on unix-domain socket %s as host %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), path, prte_oob_base.uds_host);
+    return;
+
+fail:
+    pmix_output_verbose(5, prte_oob_base.output,
+                        "%s unable to listen on unix-domain socket %s: %s (%d)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), path, strerror(prte_socket_errno),
+                        prte_socket_errno);
+    CLOSE_THE_SOCKET(sd);
+    free(path);
+}
+
 /*
  * The listen thread created when listen_mode is threaded.  Accepts
  * incoming connections and places them in a queue for further
@@ -578,6 +730,7 @@ static void *listen_thread(pmix_object_t *obj)
     struct timeval timeout;
     fd_set readfds;
     prte_oob_tcp_listener_t *listener;
+    char where[PRTE_OOB_TCP_WHERE_LEN];
     PRTE_HIDE_UNUSED_PARAMS(obj);
 
     /* only execute during the initial VM startup stage - once
@@ -684,18 +837,16 @@ static void *listen_thread(pmix_object_t *obj)
 
                 pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                                     "%s prte_oob_tcp_listen_thread: incoming connection: "
-                                    "(%d, %d) %s:%d\n",
+                                    "(%d, %d) %s\n",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), pending_connection->fd,
                                     prte_socket_errno,
-                                    pmix_net_get_hostname(
-                                        (struct sockaddr *) &pending_connection->addr),
-                                    pmix_net_get_port(
-                                        (struct sockaddr *) &pending_connection->addr));
+                                    conn_print((struct sockaddr *) &pending_connection->addr,
+                                               where, sizeof(where)));
 
                 /* if we are on a privileged port, we only accept connections
                  * from other privileged sockets. A privileged port is one
                  * whose port is less than 1024 on Linux, so we'll check for that. */
-                if (1024 >= listener->port) {
+                if (NULL == listener->path && 1024 >= listener->port) {
                     uint16_t inport;
                     inport = pmix_net_get_port((struct sockaddr *) &pending_connection->addr);
                     if (1024 < inport) {
@@ -730,6 +881,7 @@ done:
 static void connection_handler(int sd, short flags, void *cbdata)
 {
     prte_oob_tcp_pending_connection_t *new_connection;
+    char where[PRTE_OOB_TCP_WHERE_LEN];
     PRTE_HIDE_UNUSED_PARAMS(sd, flags);
 
     new_connection = (prte_oob_tcp_pending_connection_t *) cbdata;
@@ -738,10 +890,10 @@ static void connection_handler(int sd, short flags, void *cbdata)
 
     pmix_output_verbose(4, prte_oob_base.output,
                         "%s connection_handler: working connection "
-                        "(%d, %d) %s:%d\n",
+                        "(%d, %d) %s\n",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), new_connection->fd, prte_socket_errno,
-                        pmix_net_get_hostname((struct sockaddr *) &new_connection->addr),
-                        pmix_net_get_port((struct sockaddr *) &new_connection->addr));
+                        conn_print((struct sockaddr *) &new_connection->addr,
+                                   where, sizeof(where)));
 
     /* process the connection */
     prte_oob_accept_connection(new_connection->fd, (struct sockaddr *) &(new_connection->addr));
@@ -755,18 +907,20 @@ static void connection_handler(int sd, short flags, void *cbdata)
  */
 static void connection_event_handler(int incoming_sd, short flags, void *cbdata)
 {
-    struct sockaddr addr;
-    prte_socklen_t addrlen = sizeof(struct sockaddr);
+    struct sockaddr_storage addr;
+    prte_socklen_t addrlen = sizeof(addr);
+    char where[PRTE_OOB_TCP_WHERE_LEN];
     int sd;
     PRTE_HIDE_UNUSED_PARAMS(flags, cbdata);
 
+    memset(&addr, 0, sizeof(addr));
     sd = accept(incoming_sd, (struct sockaddr *) &addr, &addrlen);
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                         "%s connection_event_handler: working connection "
-                        "(%d, %d) %s:%d\n",
+                        "(%d, %d) %s\n",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), sd, prte_socket_errno,
-                        pmix_net_get_hostname((struct sockaddr *) &addr),
-                        pmix_net_get_port((struct sockaddr *) &addr));
+                        (sd < 0) ? "none" : conn_print((struct sockaddr *) &addr,
+                                                       where, sizeof(where)));
     if (sd < 0) {
         /* Non-fatal errors */
         if (EINTR == prte_socket_errno || EAGAIN == prte_socket_errno
@@ -798,7 +952,7 @@ static void connection_event_handler(int incoming_sd, short flags, void *cbdata)
     }
 
     /* process the connection */
-    prte_oob_accept_connection(sd, &addr);
+    prte_oob_accept_connection(sd, (struct sockaddr *) &addr);
 }
 
 static void tcp_ev_cons(prte_oob_tcp_listener_t *event)
@@ -807,6 +961,7 @@ static void tcp_ev_cons(prte_oob_tcp_listener_t *event)
     event->tcp6 = false;
     event->sd = -1;
     event->port = 0;
+    event->path = NULL;
 }
 static void tcp_ev_des(prte_oob_tcp_listener_t *event)
 {
@@ -818,6 +973,11 @@ static void tcp_ev_des(prte_oob_tcp_listener_t *event)
         CLOSE_THE_SOCKET(event->sd);
         event->sd = -1;
     }
+    if (NULL != event->path) {
+        unlink(event->path);
+        free(event->path);
+        event->path = NULL;
+    }
 }
 
 PMIX_CLASS_INSTANCE(prte_oob_tcp_listener_t, pmix_list_item_t, tcp_ev_cons, tcp_ev_des);
@@ -48,6 +48,7 @@ struct prte_oob_tcp_listener_t {
     bool tcp6;
     int sd;
     uint16_t port;
+    char *path; // the unix-domain listener's socket - NULL for a TCP one
 };
 typedef struct prte_oob_tcp_listener_t prte_oob_tcp_listener_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_listener_t);
@@ -61,5 +62,8 @@ typedef struct {
 PMIX_CLASS_DECLARATION(prte_oob_tcp_pending_connection_t);
 
 PRTE_EXPORT int prte_oob_tcp_start_listening(void);
+/* name this host in the "uds://" entry of our contact info - only a peer
+ * that finds the same name there shares our session directory */
+PRTE_EXPORT int prte_oob_tcp_set_uds_host(void);
 
 #endif /* _MCA_OOB_TCP_LISTENER_H_ */
@@ -34,6 +34,7 @@
 
 #include "src/rml/oob/oob_tcp.h"
 #include "src/rml/oob/oob_tcp_sendrecv.h"
+#include "src/rml/rml_stats.h"
 #include "src/threads/pmix_threads.h"
 
 typedef struct {
@@ -45,6 +46,34 @@ typedef struct {
 } prte_oob_tcp_addr_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_addr_t);
 
+/* Where an IDENT handshake has got to.  The handshake is read as it
+ * arrives - a header, the nspace it names, then the payload - and our own
+ * IDENT is written as the socket will take it; this is what is kept between
+ * one readable or writable event and the next so that nobody waits on a
+ * peer that reads or sends it slowly. */
+typedef enum {
+    PRTE_OOB_TCP_HS_HDR,
+    PRTE_OOB_TCP_HS_NSPACE,
+    PRTE_OOB_TCP_HS_PAYLOAD
+} prte_oob_tcp_hs_phase_t;
+
+typedef struct {
+    prte_oob_tcp_hs_phase_t phase;
+    /* as it came off the wire until the nspace is in, host order after */
+    prte_oob_tcp_hdr_t hdr;
+    /* the payload, once the header has been accepted */
+    char *msg;
+    /* bytes of the current phase read so far */
+    size_t got;
+    /* when to give up on it, or 0 to wait for as long as it takes */
+    time_t deadline;
+    /* our IDENT while the socket has not yet taken all of it, and how much
+     * of it has gone */
+    char *out;
+    size_t outlen;
+    size_t sent;
+} prte_oob_tcp_handshake_t;
+
 /* object for tracking peers in the module */
 typedef struct {
     pmix_list_item_t super;
@@ -55,6 +84,8 @@ typedef struct {
     char *auth_method; // method they used to authenticate
     int sd;
     pmix_list_t addrs;
+    prte_oob_tcp_addr_t *uds_addr; /**< the peer's unix-domain socket, if it is on this
+                                        host - tried before any of addrs */
     prte_oob_tcp_addr_t *active_addr;
     prte_oob_tcp_state_t state;
     bool established;          /**< did the connection currently held ever reach CONNECTED?
@@ -81,14 +112,28 @@ typedef struct {
     bool send_ev_active;
     prte_event_t recv_event; /**< registration with event thread for recv events */
     bool recv_ev_active;
-    prte_event_t timer_event; /**< timer for retrying connection failures */
+    prte_event_t timer_event; /**< bounds how long our IDENT and the peer's
+                                   answer to it may take (prte_handshake_timeout) */
     bool timer_ev_active;
-    pmix_list_t send_queue;        /**< list of messages to send */
+    prte_oob_tcp_handshake_t hs; /**< our IDENT and its answer, as far as each has got */
+    pmix_list_t send_queue;        /**< bulk messages to send */
+    pmix_list_t ctl_queue;         /**< control messages to send - ahead of send_queue */
     prte_oob_tcp_send_t *send_msg; /**< current send in progress */
+    prte_oob_tcp_send_t *bulk_msg; /**< a segmented message stood aside, between two of
+                                        its segments, for the control lane */
     prte_oob_tcp_recv_t *recv_msg; /**< current recv in progress */
+    prte_oob_tcp_recv_t *bulk_recv; /**< the message being put back together from its
+                                         segments */
+    prte_rml_traffic_t traffic;    /**< what has gone to and come from this peer */
+    size_t queue_hwm;              /**< most messages ever waiting to go to it */
 } prte_oob_tcp_peer_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_peer_t);
 
+/* The message to put on deck next, called with the peer lock held: the
+ * control lane first, then a segmented message that stood aside for it,
+ * then the next bulk message.  NULL if there is nothing to send. */
+PRTE_EXPORT prte_oob_tcp_send_t *prte_oob_tcp_peer_next_send(prte_oob_tcp_peer_t *peer);
+
 /* state machine for processing peer data */
 typedef struct {
     pmix_object_t super;
@@ -80,25 +80,54 @@
 #include "src/rml/oob/oob_tcp_peer.h"
 
 #define OOB_SEND_MAX_RETRIES 3
+/* regions handed to one writev at most - well under any IOV_MAX; a message
+ * made of more simply takes another call */
+#define PRTE_OOB_TCP_MAX_IOV 128
 
 void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
 {
     prte_oob_tcp_send_t *snd = (prte_oob_tcp_send_t *) cbdata;
     prte_oob_tcp_peer_t *peer;
     bool connect_needed = false;
+    prte_rml_tag_t tag;
+    prte_rml_stat_dir_t dir;
+    size_t depth;
     PRTE_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(snd);
     peer = (prte_oob_tcp_peer_t *) snd->peer;
 
+    /* pick the lane.  A bulk message that would hold the socket for longer
+     * than a segment is sent a segment at a time, so that the control lane
+     * can get in between */
+    tag = PRTE_RML_TAG_NTOH(snd->hdr.tag);
+    snd->control = (tag < PRTE_RML_TAG_MAX && prte_oob_base.control_tags[tag]);
+    if (!snd->control && 0 < prte_oob_base.segment_size
+        && (size_t) prte_oob_base.segment_size < ntohl(snd->hdr.nbytes)) {
+        snd->segmented = true;
+    }
+
+    /* a message that started somewhere else is one we are relaying */
+    dir = (ntohl(snd->hdr.origin) == PRTE_PROC_MY_NAME->rank) ? PRTE_RML_STAT_SENT
+                                                               : PRTE_RML_STAT_RELAYED;
+    prte_rml_stats_record(tag, dir, ntohl(snd->hdr.nbytes));
+    prte_rml_stats_count(&peer->traffic, dir, ntohl(snd->hdr.nbytes));
+
     pmix_mutex_lock(&peer->lock);
     /* if there is no message on-deck, put this one there */
     if (NULL == peer->send_msg) {
         peer->send_msg = snd;
+    } else if (snd->control) {
+        pmix_list_append(&peer->ctl_queue, &snd->super);
     } else {
         /* add it to the queue */
         pmix_list_append(&peer->send_queue, &snd->super);
     }
+    depth = 1 + pmix_list_get_size(&peer->ctl_queue) + pmix_list_get_size(&peer->send_queue)
+            + (NULL == peer->bulk_msg ? 0 : 1);
+    if (depth > peer->queue_hwm) {
+        peer->queue_hwm = depth;
+    }
 
     /* Whether or not the caller asked us to activate, a CONNECTED peer must
      * have its send event running - the last of us to observe the connection
@@ -139,27 +168,69 @@ void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
     }
 }
 
+/* The message body as regions for writev: a relayed message or a plain buffer
+ * is one, a chained payload one more per segment (see prte_rml_payload_t).
+ * Returns the number of regions; "k" picks the one to describe. */
+static int body_region(prte_oob_tcp_send_t *msg, int k, struct iovec *iov)
+{
+    prte_rml_payload_t *payload;
+    pmix_data_buffer_t *seg;
+
+    if (NULL != msg->data) {
+        /* relay message - just send that data */
+        iov->iov_base = msg->data;
+        iov->iov_len = ntohl(msg->hdr.nbytes);
+        return 1;
+    }
+    payload = msg->msg->payload;
+    if (0 == k) {
+        /* buffer send */
+        iov->iov_base = msg->msg->dbuf->base_ptr;
+        iov->iov_len = msg->msg->dbuf->bytes_used;
+    } else {
+        seg = payload->segs[k - 1];
+        iov->iov_base = seg->unpack_ptr;
+        iov->iov_len = seg->bytes_used - (size_t) (seg->unpack_ptr - seg->base_ptr);
+    }
+    return (NULL == payload) ? 1 : 1 + (int) payload->nsegs;
+}
+
+/* Progress is sdptr/sdbytes: what is left of the header until hdr_sent, then
+ * what is left of body region iovnum.  Each call writes that and as many of
+ * the regions after it as one writev takes. */
 static int send_msg(prte_oob_tcp_peer_t *peer, prte_oob_tcp_send_t *msg)
 {
-    struct iovec iov[2];
-    int iov_count, retries = 0;
-    ssize_t remain = msg->sdbytes, rc;
+    struct iovec iov[PRTE_OOB_TCP_MAX_IOV];
+    int region[PRTE_OOB_TCP_MAX_IOV];
+    int iov_count, nregions, k, i, retries = 0;
+    ssize_t remain, rc;
+
+    if (msg->hdr_sent && 0 == msg->sdbytes) {
+        /* the last write ended exactly on a region boundary */
+        nregions = body_region(msg, 0, &iov[0]);
+        if (msg->iovnum + 1 >= nregions) {
+            return PRTE_SUCCESS;
+        }
+        msg->iovnum++;
+        body_region(msg, msg->iovnum, &iov[0]);
+        msg->sdptr = (char *) iov[0].iov_base;
+        msg->sdbytes = iov[0].iov_len;
+    }
 
     iov[0].iov_base = msg->sdptr;
     iov[0].iov_len = msg->sdbytes;
-    if (!msg->hdr_sent) {
-        if (NULL != msg->data) {
-            /* relay message - just send that data */
-            iov[1].iov_base = msg->data;
-        } else {
-            /* buffer send */
-            iov[1].iov_base = msg->msg->dbuf->base_ptr;
+    region[0] = msg->hdr_sent ? msg->iovnum : -1;
+    remain = msg->sdbytes;
+    iov_count = 1;
+    nregions = body_region(msg, 0, &iov[1]);
+    for (k = region[0] + 1; k < nregions && iov_count < PRTE_OOB_TCP_MAX_IOV; k++) {
+        body_region(msg, k, &iov[iov_count]);
+        if (0 == iov[iov_count].iov_len) {
+            continue;
         }
-        iov[1].iov_len = ntohl(msg->hdr.nbytes);
-        remain += ntohl(msg->hdr.nbytes);
-        iov_count = 2;
-    } else {
-        iov_count = 1;
+        region[iov_count] = k;
+        remain += iov[iov_count].iov_len;
+        iov_count++;
     }
 
 retry:
@@ -169,6 +240,11 @@ retry:
         msg->hdr_sent = true;
         msg->sdbytes = 0;
         msg->sdptr = (char *) iov[iov_count - 1].iov_base + iov[iov_count - 1].iov_len;
+        msg->iovnum = (0 > region[iov_count - 1]) ? nregions - 1 : region[iov_count - 1];
+        if (msg->iovnum + 1 < nregions) {
+            /* more regions than one writev takes - carry on from the next */
+            return send_msg(peer, msg);
+        }
         return PRTE_SUCCESS;
     } else if (rc < 0) {
         if (prte_socket_errno == EINTR) {
@@ -204,23 +280,120 @@ retry:
     } else {
         /* short writev. This usually means the kernel buffer is full,
          * so there is no point for retrying at that time.
-         * simply update the msg and return with PMIX_ERR_RESOURCE_BUSY */
-        if ((size_t) rc < msg->sdbytes) {
-            /* partial write of the header or the msg data */
-            msg->sdptr = (char *) msg->sdptr + rc;
-            msg->sdbytes -= rc;
-        } else {
-            /* header was fully written, but only a part of the msg data was written */
+         * simply find where it stopped and return with PRTE_ERR_RESOURCE_BUSY */
+        for (i = 0; i < iov_count && (size_t) rc >= iov[i].iov_len; i++) {
+            rc -= iov[i].iov_len;
+        }
+        assert(i < iov_count);
+        msg->sdptr = (char *) iov[i].iov_base + rc;
+        msg->sdbytes = iov[i].iov_len - rc;
+        if (0 <= region[i]) {
+            /* the header was fully written, and part of the msg data */
             msg->hdr_sent = true;
-            rc -= msg->sdbytes;
-            assert(2 == iov_count);
-            msg->sdptr = (char *) iov[1].iov_base + rc;
-            msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
+            msg->iovnum = region[i];
         }
         return PRTE_ERR_RESOURCE_BUSY;
     }
 }
 
+prte_oob_tcp_send_t *prte_oob_tcp_peer_next_send(prte_oob_tcp_peer_t *peer)
+{
+    prte_oob_tcp_send_t *msg;
+
+    if (NULL != (msg = (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->ctl_queue))) {
+        return msg;
+    }
+    if (NULL != (msg = peer->bulk_msg)) {
+        peer->bulk_msg = NULL;
+        return msg;
+    }
+    return (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->send_queue);
+}
+
+/* Send the next segment of a segmented message, or as much of it as the
+ * socket takes.  The segment is its header and the body from seg_off on;
+ * where the body's regions (see body_region) fall makes no difference to
+ * where a segment starts or ends.  Sets *last once the final segment is
+ * out. */
+static int send_segment(prte_oob_tcp_peer_t *peer, prte_oob_tcp_send_t *msg, bool *last)
+{
+    struct iovec iov[PRTE_OOB_TCP_MAX_IOV];
+    size_t total, seglen, hdrlen, skip, want, len;
+    int iov_count = 0, nregions, k;
+    ssize_t rc;
+
+    *last = false;
+    total = ntohl(msg->hdr.nbytes);
+    hdrlen = PRTE_OOB_TCP_HDR_LEN(&msg->hdr);
+    if (0 == msg->seg_done) {
+        /* a new segment - stamp its header */
+        seglen = total - msg->seg_off;
+        if ((size_t) prte_oob_base.segment_size < seglen) {
+            seglen = prte_oob_base.segment_size;
+        }
+        msg->seg_hdr = msg->hdr;
+        msg->seg_hdr.nbytes = htonl((uint32_t) seglen);
+        msg->seg_hdr.type = (msg->seg_off + seglen == total) ? MCA_OOB_TCP_SEG_LAST
+                                                              : MCA_OOB_TCP_SEG;
+    }
+    seglen = ntohl(msg->seg_hdr.nbytes);
+
+    if (msg->seg_done < hdrlen) {
+        iov[0].iov_base = (char *) &msg->seg_hdr + msg->seg_done;
+        iov[0].iov_len = hdrlen - msg->seg_done;
+        iov_count = 1;
+        skip = msg->seg_off;
+        want = seglen;
+    } else {
+        skip = msg->seg_off + (msg->seg_done - hdrlen);
+        want = seglen - (msg->seg_done - hdrlen);
+    }
+
+    /* the part of the body still owed to this segment */
+    nregions = body_region(msg, 0, &iov[iov_count]);
+    for (k = 0; k < nregions && 0 < want && iov_count < PRTE_OOB_TCP_MAX_IOV; k++) {
+        body_region(msg, k, &iov[iov_count]);
+        len = iov[iov_count].iov_len;
+        if (skip >= len) {
+            skip -= len;
+            continue;
+        }
+        iov[iov_count].iov_base = (char *) iov[iov_count].iov_base + skip;
+        len -= skip;
+        skip = 0;
+        if (len > want) {
+            len = want;
+        }
+        iov[iov_count].iov_len = len;
+        want -= len;
+        iov_count++;
+    }
+
+    do {
+        rc = writev(peer->sd, iov, iov_count);
+    } while (rc < 0 && EINTR == prte_socket_errno);
+    if (rc < 0) {
+        if (EAGAIN == prte_socket_errno || EWOULDBLOCK == prte_socket_errno) {
+            return PRTE_ERR_RESOURCE_BUSY;
+        }
+        if (!prte_prteds_term_ordered && !prte_abnormal_term_ordered) {
+            pmix_output(0, "oob:tcp: send_segment: write failed: %s (%d) [sd = %d]",
+                        strerror(prte_socket_errno), prte_socket_errno, peer->sd);
+        }
+        return PRTE_ERR_UNREACH;
+    }
+    msg->seg_done += rc;
+    if (msg->seg_done < hdrlen + seglen) {
+        /* the kernel buffer is full, or the segment spans more regions than
+         * one writev takes - either way, come back when it is writable */
+        return PRTE_ERR_RESOURCE_BUSY;
+    }
+    msg->seg_off += seglen;
+    msg->seg_done = 0;
+    *last = (msg->seg_off == total);
+    return PRTE_SUCCESS;
+}
+
 /*
  * A file descriptor is available/ready for send. Check the state
  * of the socket and take the appropriate action.
@@ -254,21 +427,48 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
                             prte_oob_tcp_state_print(peer->state));
         prte_oob_tcp_peer_complete_connect(peer);
         /* de-activate the send event until the connection
-         * handshake completes
+         * handshake completes - unless it is carrying the rest
+         * of our IDENT
          */
-        if (peer->send_ev_active) {
+        if (peer->send_ev_active && NULL == peer->hs.out) {
             prte_event_del(&peer->send_event);
             peer->send_ev_active = false;
         }
         break;
+    case MCA_OOB_TCP_CONNECT_ACK:
+    case MCA_OOB_TCP_ACCEPTING:
+        /* our IDENT did not all fit when it was sent */
+        prte_oob_tcp_peer_send_handshake(peer);
+        break;
     case MCA_OOB_TCP_CONNECTED:
         pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                             "%s tcp:send_handler SENDING TO %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                             (NULL == peer->send_msg) ? "NULL" : PRTE_NAME_PRINT(&peer->name));
-        if (NULL != msg) {
+        if (NULL != msg && msg->segmented) {
+            bool last;
+
+            rc = send_segment(peer, msg, &last);
+            if (PRTE_SUCCESS == rc && !last) {
+                /* between two segments is where the control lane gets its
+                 * turn - let anything waiting on it go first */
+                pmix_mutex_lock(&peer->lock);
+                if (0 < pmix_list_get_size(&peer->ctl_queue)) {
+                    peer->bulk_msg = msg;
+                    peer->send_msg = (prte_oob_tcp_send_t *)
+                        pmix_list_remove_first(&peer->ctl_queue);
+                }
+                pmix_mutex_unlock(&peer->lock);
+                /* either way, leave the socket to the event lib until it is
+                 * writable again */
+                return;
+            }
+        } else if (NULL != msg) {
             pmix_output_verbose(2, prte_oob_base.output,
                                 "oob:tcp:send_handler SENDING MSG");
-            if (PRTE_SUCCESS == (rc = send_msg(peer, msg))) {
+            rc = send_msg(peer, msg);
+        }
+        if (NULL != msg) {
+            if (PRTE_SUCCESS == rc) {
                 /* this msg is complete */
                 if (NULL != msg->data || NULL == msg->msg) {
                     /* the relay is complete - release the data */
@@ -324,7 +524,7 @@ void prte_oob_tcp_send_handler(int sd, short flags, void *cbdata)
              */
             pmix_mutex_lock(&peer->lock);
             if (NULL == peer->send_msg) {
-                peer->send_msg = (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->send_queue);
+                peer->send_msg = prte_oob_tcp_peer_next_send(peer);
             }
             pmix_mutex_unlock(&peer->lock);
         }
@@ -408,6 +608,59 @@ static int read_bytes(prte_oob_tcp_peer_t *peer)
     return PRTE_SUCCESS;
 }
 
+/* Make room in the message being reassembled for the slice whose header
+ * was just read, and point the read at it.  The reassembled message keeps
+ * its running length in hdr.nbytes; the slice's recv object never owns a
+ * data region of its own. */
+static int seg_extend(prte_oob_tcp_peer_t *peer)
+{
+    prte_oob_tcp_recv_t *seg = peer->recv_msg;
+    prte_oob_tcp_recv_t *bulk = peer->bulk_recv;
+    size_t need, space;
+    char *data;
+
+    if (NULL == bulk) {
+        bulk = PMIX_NEW(prte_oob_tcp_recv_t);
+        bulk->hdr = seg->hdr;
+        bulk->hdr.type = MCA_OOB_TCP_USER;
+        bulk->hdr.nbytes = 0;
+        bulk->hdr_recvd = true;
+        bulk->nspace_recvd = true;
+        peer->bulk_recv = bulk;
+    } else if (bulk->hdr.tag != seg->hdr.tag || bulk->hdr.seq_num != seg->hdr.seq_num
+               || bulk->hdr.origin != seg->hdr.origin || bulk->hdr.dst != seg->hdr.dst) {
+        /* the sender never mixes two messages' slices */
+        pmix_output(0, "%s-%s oob:tcp: segment does not belong to the message in progress",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
+        return PRTE_ERR_COMM_FAILURE;
+    }
+
+    need = (size_t) bulk->hdr.nbytes + seg->hdr.nbytes;
+    if (need > (size_t) prte_oob_base.max_msg_size * 1024 * 1024) {
+        prte_show_help("help-oob-tcp.txt", "msg-too-big", true,
+                       PRTE_NAME_PRINT(&peer->name), PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                       (uint32_t) need, prte_oob_base.max_msg_size);
+        return PRTE_ERR_COMM_FAILURE;
+    }
+    if (need > bulk->space) {
+        /* double, so that a long message is not copied once per slice */
+        space = (0 == bulk->space) ? need : bulk->space;
+        while (space < need) {
+            space *= 2;
+        }
+        data = (char *) realloc(bulk->data, space);
+        if (NULL == data) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        bulk->data = data;
+        bulk->space = space;
+    }
+    seg->rdptr = bulk->data + bulk->hdr.nbytes;
+    seg->rdbytes = seg->hdr.nbytes;
+    bulk->hdr.nbytes = (uint32_t) need;
+    return PRTE_SUCCESS;
+}
+
 /*
  * Dispatch to the appropriate action routine based on the state
  * of the connection with the peer.
@@ -429,7 +682,12 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
 
     switch (peer->state) {
     case MCA_OOB_TCP_CONNECT_ACK:
-        if (PRTE_SUCCESS == (rc = prte_oob_tcp_peer_recv_connect_ack(peer, peer->sd, NULL))) {
+        rc = prte_oob_tcp_peer_recv_connect_ack(peer, peer->sd, &peer->hs, NULL);
+        if (PRTE_ERR_WOULD_BLOCK == rc) {
+            /* only part of the answer is in - the rest will wake us again */
+            break;
+        }
+        if (PRTE_SUCCESS == rc) {
             pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
                                 "%s:tcp:recv:handler starting send/recv events",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -452,7 +710,7 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
             /* if there is a message waiting to be sent, queue it */
             pmix_mutex_lock(&peer->lock);
             if (NULL == peer->send_msg) {
-                peer->send_msg = (prte_oob_tcp_send_t *) pmix_list_remove_first(&peer->send_queue);
+                peer->send_msg = prte_oob_tcp_peer_next_send(peer);
             }
             if (NULL != peer->send_msg && !peer->send_ev_active) {
                 peer->send_ev_active = true;
@@ -551,6 +809,15 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                                     PRTE_NAME_PRINT(&peer->name), peer->recv_msg->hdr.tag);
                 peer->recv_msg->data = NULL; // make sure
+            } else if (MCA_OOB_TCP_SEG == peer->recv_msg->hdr.type
+                       || MCA_OOB_TCP_SEG_LAST == peer->recv_msg->hdr.type) {
+                /* a slice of a bulk message - it is read straight onto the
+                 * end of what the earlier slices brought */
+                if (PRTE_SUCCESS != (rc = seg_extend(peer))) {
+                    peer->state = MCA_OOB_TCP_FAILED;
+                    prte_oob_tcp_peer_close(peer);
+                    return;
+                }
             } else {
                 pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
                                     prte_oob_base.output,
@@ -586,6 +853,21 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
              * beginning or somewhere in the message
              */
             if (PRTE_SUCCESS == (rc = read_bytes(peer))) {
+                if (MCA_OOB_TCP_SEG == peer->recv_msg->hdr.type) {
+                    /* more slices to come */
+                    PMIX_RELEASE(peer->recv_msg);
+                    peer->recv_msg = NULL;
+                    return;
+                }
+                if (MCA_OOB_TCP_SEG_LAST == peer->recv_msg->hdr.type) {
+                    /* the message is whole - carry on with it as if it
+                     * had come in one piece */
+                    PMIX_RELEASE(peer->recv_msg);
+                    peer->recv_msg = peer->bulk_recv;
+                    peer->bulk_recv = NULL;
+                }
+                prte_rml_stats_count(&peer->traffic, PRTE_RML_STAT_RECVD,
+                                     peer->recv_msg->hdr.nbytes);
                 /* we recvd all of the message */
                 pmix_output_verbose(
                     OOB_TCP_DEBUG_CONNECT, prte_oob_base.output,
@@ -623,6 +905,8 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                                         "%s DELIVERING TO RML tag = %d seq_num = %d",
                                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), peer->recv_msg->hdr.tag,
                                         peer->recv_msg->hdr.seq_num);
+                    prte_rml_stats_record(peer->recv_msg->hdr.tag, PRTE_RML_STAT_RECVD,
+                                          peer->recv_msg->hdr.nbytes);
                     PRTE_RML_POST_MESSAGE(&origin, peer->recv_msg->hdr.tag,
                                           peer->recv_msg->hdr.seq_num, peer->recv_msg->data,
                                           peer->recv_msg->hdr.nbytes);
@@ -689,9 +973,14 @@ static void snd_cons(prte_oob_tcp_send_t *ptr)
     ptr->msg = NULL;
     ptr->data = NULL;
     ptr->hdr_sent = false;
-    ptr->iovnum = 0;
+    ptr->iovnum = -1;
     ptr->sdptr = NULL;
     ptr->sdbytes = 0;
+    ptr->control = false;
+    ptr->segmented = false;
+    memset(&ptr->seg_hdr, 0, sizeof(prte_oob_tcp_hdr_t));
+    ptr->seg_off = 0;
+    ptr->seg_done = 0;
 }
 /* an OOB send owns the RML message attached to it until that message is
  * completed - completion clears the pointer, so anything still attached
@@ -718,6 +1007,7 @@ static void rcv_cons(prte_oob_tcp_recv_t *ptr)
     ptr->data = NULL;
     ptr->rdptr = NULL;
     ptr->rdbytes = 0;
+    ptr->space = 0;
 }
 /* the payload buffer belongs to the recv object until somebody takes it: the
  * two paths that hand it on (deliver locally, relay onward) clear the pointer
@@ -51,9 +51,19 @@ typedef struct {
     prte_rml_send_t *msg;
     char *data;
     bool hdr_sent;
+    // once hdr_sent, the body region sdptr points into (see send_msg)
     int iovnum;
     char *sdptr;
     size_t sdbytes;
+    // its tag is a control one - it goes ahead of every bulk message
+    bool control;
+    /* a bulk message sent as segments (see oob_tcp_hdr.h): the header of
+     * the segment going out, how much of the body earlier segments took,
+     * and how much of this segment - header included - is written */
+    bool segmented;
+    prte_oob_tcp_hdr_t seg_hdr;
+    size_t seg_off;
+    size_t seg_done;
 } prte_oob_tcp_send_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_send_t);
 
@@ -68,14 +78,17 @@ typedef struct {
     char *data;
     char *rdptr;
     size_t rdbytes;
+    // a message being put back together from segments: the room in data
+    size_t space;
 } prte_oob_tcp_recv_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
 
 /* Queue a message to be sent to a specified peer. The macro
  * checks to see if a message is already in position to be
  * sent - if it is, then the message provided is simply added
- * to the peer's message queue. If not, then the provided message
- * is placed in the "ready" position
+ * to the peer's message queue for its lane (control or bulk, by
+ * tag). If not, then the provided message is placed in the "ready"
+ * position
  *
  * If the provided boolean is true, then the send event for the
  * peer is checked and activated if not already active. This allows
@@ -127,7 +140,7 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
         /* point to the actual message */                                                      \
         _s->msg = (m);                                                                         \
         /* set the total number of bytes to be sent */                                         \
-        _s->hdr.nbytes = (m)->dbuf->bytes_used;                                                \
+        _s->hdr.nbytes = prte_rml_send_size(m);                                                \
         /* prep header for xmission */                                                         \
         MCA_OOB_TCP_HDR_HTON(&_s->hdr);                                                        \
         /* start the send with the header */                                                   \
@@ -163,7 +176,7 @@ PMIX_CLASS_DECLARATION(prte_oob_tcp_recv_t);
         /* point to the actual message */                                                         \
         _s->msg = (m);                                                                            \
         /* set the total number of bytes to be sent */                                            \
-        _s->hdr.nbytes = (m)->dbuf->bytes_used;                                                   \
+        _s->hdr.nbytes = prte_rml_send_size(m);                                                   \
         /* prep header for xmission */                                                            \
         MCA_OOB_TCP_HDR_HTON(&_s->hdr);                                                           \
         /* start the send with the header */                                                      \
@@ -479,6 +479,7 @@ static void sm_cons(prte_relm_state_machine_t* sm){
     PMIX_CONSTRUCT(&sm->cached_messages, pmix_list_t);
 
     sm->max_cache_count = prte_relm_base.cache_max_count;
+    sm->cached_hwm = 0;
 
     sm->cache_tv = (struct timeval) {0};
     if(prte_relm_base.cache_ms > 0){
@@ -68,6 +68,7 @@ typedef struct {
     // they are evicted, so we can keep the state - but do release the msg data
     pmix_list_t cached_messages; // prte_relm_msg_t
     uint32_t max_cache_count;    // Remove first msg if caching n+1th msg
+    size_t cached_hwm;           // Most msgs ever cached at once (rml_stats.h)
     struct timeval cache_tv;     // Remove msg from cache after time
 
     // The next UID to use for a locally-generated message
@@ -324,6 +324,9 @@ static void local_update(
         prte_event_evtimer_add(&msg->eviction_ev, &prte_relm_sm->cache_tv);
 
         size_t n = pmix_list_get_size(&prte_relm_sm->cached_messages);
+        if(n > prte_relm_sm->cached_hwm){
+            prte_relm_sm->cached_hwm = n;
+        }
         if(n > prte_relm_sm->max_cache_count){
             prte_relm_msg_t* first = (prte_relm_msg_t*)
                 pmix_list_get_first(&prte_relm_sm->cached_messages);
@@ -59,6 +59,7 @@ prte_rml_base_t prte_rml_base = {
     .revived_dmns = { .super = PMIX_OBJ_STATIC_INIT(pmix_bitmap_t) },
     .lateral_links = { .super = PMIX_OBJ_STATIC_INIT(pmix_bitmap_t) },
     .lateral_lost_cb = NULL,
+    .warmup_cb = NULL,
     .peer_epochs = NULL,
     .peer_epochs_size = 0,
 };
@@ -557,12 +558,20 @@ PMIX_CLASS_INSTANCE(prte_rml_send_t, pmix_list_item_t, send_cons, send_des);
 static void payload_cons(prte_rml_payload_t *ptr)
 {
     ptr->dbuf = NULL;
+    ptr->segs = NULL;
+    ptr->nsegs = 0;
 }
 static void payload_des(prte_rml_payload_t *ptr)
 {
+    size_t n;
+
     if (NULL != ptr->dbuf) {
         PMIX_DATA_BUFFER_RELEASE(ptr->dbuf);
     }
+    for (n = 0; n < ptr->nsegs; n++) {
+        PMIX_DATA_BUFFER_RELEASE(ptr->segs[n]);
+    }
+    free(ptr->segs);
 }
 PMIX_CLASS_INSTANCE(prte_rml_payload_t, pmix_object_t, payload_cons, payload_des);
 
@@ -150,6 +150,26 @@ PRTE_EXPORT int prte_rml_send_payload_cb_nb(pmix_rank_t rank,
                                             prte_rml_buffer_callback_fn_t cbfunc,
                                             void *cbdata);
 
+/**
+ * Chain the unread part of "buf" onto a payload, after everything already in
+ * it, without copying it.  The bytes move: "buf" is left empty, for its owner
+ * to release as usual - which is what a receive callback that keeps its
+ * message is expected to do.  Like the rest of a payload, the chain must not
+ * change once the payload has been handed to a send.
+ */
+PRTE_EXPORT int prte_rml_payload_take(prte_rml_payload_t *payload, pmix_data_buffer_t *buf);
+
+/* The number of bytes a payload puts on the wire: dbuf and every segment. */
+PRTE_EXPORT size_t prte_rml_payload_size(const prte_rml_payload_t *payload);
+
+/* Copy a payload, chain and all, onto the end of "dest" - for the one
+ * consumer that needs it in one piece. */
+PRTE_EXPORT int prte_rml_payload_flatten(const prte_rml_payload_t *payload,
+                                         pmix_data_buffer_t *dest);
+
+/* The number of bytes a send puts on the wire after its header. */
+PRTE_EXPORT size_t prte_rml_send_size(const prte_rml_send_t *snd);
+
 #define PRTE_RML_SEND_PAYLOAD_CB(_r, r, p, t, cf, cd)               \
     do {                                                            \
         pmix_output_verbose(2, prte_rml_base.rml_output,            \
@@ -218,6 +238,13 @@ PRTE_EXPORT bool prte_rml_is_lateral_only(pmix_rank_t rank);
 typedef void (*prte_rml_lateral_lost_fn_t)(pmix_rank_t rank);
 PRTE_EXPORT void prte_rml_lateral_set_lost_callback(prte_rml_lateral_lost_fn_t cbfunc);
 
+/* Told the sender of every warmup message.  A daemon started with a parent
+ * URI sends one to that parent before it does anything else, so to whoever
+ * launched it the warmup is the first sign the launch worked - well before
+ * its rollup, which waits on its whole subtree. */
+typedef void (*prte_rml_warmup_fn_t)(pmix_rank_t rank);
+PRTE_EXPORT void prte_rml_set_warmup_callback(prte_rml_warmup_fn_t cbfunc);
+
 /**
  * As prte_rml_send_buffer_nb, but attempts to deliver message even after daemon
  * failures
@@ -381,6 +408,9 @@ typedef struct {
     // Told when a purely-lateral link is lost, so the collective that opened it
     // can end or re-plan. NULL until a collective registers interest.
     prte_rml_lateral_lost_fn_t lateral_lost_cb;
+    // Told who sent each warmup message. NULL unless a launcher is timing
+    // its children.
+    prte_rml_warmup_fn_t warmup_cb;
 } prte_rml_base_t;
 
 PRTE_EXPORT extern prte_rml_base_t prte_rml_base;
@@ -442,6 +472,11 @@ PRTE_EXPORT void prte_rml_repair_routing_tree(pmix_data_array_t* failed_ranks,
 PRTE_EXPORT void prte_rml_revive_routing_tree(pmix_rank_t rank);
 PRTE_EXPORT void prte_rml_fault_handler(const prte_rml_recovery_status_t* s);
 PRTE_EXPORT int prte_rml_get_num_contributors(pmix_rank_t *dmns, size_t ndmns);
+/* True if this daemon is the lowest common ancestor of the living daemons in
+ * dmns in the current routing tree: each of them is this daemon or lies below
+ * it, and either this daemon is one of them or they sit under at least two of
+ * its children. */
+PRTE_EXPORT bool prte_rml_is_subtree_root(pmix_rank_t *dmns, size_t ndmns);
 PRTE_EXPORT void prte_rml_recv_failures_notice(int status, pmix_proc_t *sender,
                                                pmix_data_buffer_t* buf,
                                                prte_rml_tag_t tag,
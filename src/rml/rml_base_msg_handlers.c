@@ -152,6 +152,11 @@ static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
     }
 }
 
+void prte_rml_set_warmup_callback(prte_rml_warmup_fn_t cbfunc)
+{
+    prte_rml_base.warmup_cb = cbfunc;
+}
+
 void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
 {
     prte_rml_recv_t *msg = (prte_rml_recv_t *) cbdata;
@@ -170,6 +175,9 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
      * forever. If the node map has not been communicated yet, answer it with
      * one first. Either way the message dies here. */
     if (PRTE_RML_TAG_WARMUP_CONNECTION == msg->tag) {
+        if (NULL != prte_rml_base.warmup_cb) {
+            prte_rml_base.warmup_cb(msg->sender.rank);
+        }
         if (!prte_nidmap_communicated) {
             pmix_data_buffer_t *buffer;
             int rc;
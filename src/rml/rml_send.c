@@ -26,6 +26,8 @@
 #include "prte_config.h"
 #include "types.h"
 
+#include <stdlib.h>
+
 #include "src/pmix/pmix-internal.h"
 #include "src/util/name_fns.h"
 #include "src/util/pmix_output.h"
@@ -95,12 +97,10 @@ static int send_buffer(pmix_rank_t rank,
             int rc;
 
             PMIX_DATA_BUFFER_CREATE(copy);
-            rc = PMIx_Data_copy_payload(copy, buffer);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
+            rc = prte_rml_payload_flatten(payload, copy);
+            if (PRTE_SUCCESS != rc) {
                 PMIX_DATA_BUFFER_RELEASE(copy);
-                /* every other exit from this function reports a PRRTE code */
-                return prte_pmix_convert_status(rc);
+                return rc;
             }
             buffer = copy;
         }
@@ -171,6 +171,73 @@ int prte_rml_send_payload_cb_nb(pmix_rank_t rank,
     return send_buffer(rank, NULL, payload, tag, false, cbfunc, cbdata);
 }
 
+int prte_rml_payload_take(prte_rml_payload_t *payload, pmix_data_buffer_t *buf)
+{
+    pmix_data_buffer_t **segs, *seg;
+
+    if (NULL == payload || NULL == buf) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return PRTE_ERR_BAD_PARAM;
+    }
+    segs = (pmix_data_buffer_t **) realloc(payload->segs,
+                                           (payload->nsegs + 1) * sizeof(pmix_data_buffer_t *));
+    if (NULL == segs) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    payload->segs = segs;
+    /* the buffer's storage, pointers and all, changes hands: nothing is
+     * copied but the bookkeeping, and the unpack pointer comes along so the
+     * segment is just what had not been read */
+    PMIX_DATA_BUFFER_CREATE(seg);
+    *seg = *buf;
+    PMIX_DATA_BUFFER_CONSTRUCT(buf);
+    payload->segs[payload->nsegs++] = seg;
+    return PRTE_SUCCESS;
+}
+
+size_t prte_rml_payload_size(const prte_rml_payload_t *payload)
+{
+    size_t n, nbytes;
+
+    nbytes = (NULL == payload->dbuf) ? 0 : payload->dbuf->bytes_used;
+    for (n = 0; n < payload->nsegs; n++) {
+        nbytes += payload->segs[n]->bytes_used
+                  - (size_t) (payload->segs[n]->unpack_ptr - payload->segs[n]->base_ptr);
+    }
+    return nbytes;
+}
+
+int prte_rml_payload_flatten(const prte_rml_payload_t *payload, pmix_data_buffer_t *dest)
+{
+    pmix_status_t rc;
+    size_t n;
+
+    if (NULL != payload->dbuf) {
+        rc = PMIx_Data_copy_payload(dest, payload->dbuf);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+    }
+    for (n = 0; n < payload->nsegs; n++) {
+        rc = PMIx_Data_copy_payload(dest, payload->segs[n]);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+size_t prte_rml_send_size(const prte_rml_send_t *snd)
+{
+    if (NULL != snd->payload) {
+        return prte_rml_payload_size(snd->payload);
+    }
+    return snd->dbuf->bytes_used;
+}
+
 int prte_rml_send_buffer_direct_nb(pmix_rank_t rank,
                                    pmix_data_buffer_t *buffer,
                                    prte_rml_tag_t tag)
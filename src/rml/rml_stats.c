@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/runtime/prte_globals.h"
+
+#include "src/rml/oob/oob.h"
+#include "src/rml/oob/oob_tcp_peer.h"
+#include "src/rml/relm/state_machine.h"
+#include "src/rml/rml.h"
+#include "src/rml/rml_stats.h"
+
+/* every static tag has its own slot; the dynamic ones share the last */
+static prte_rml_traffic_t tag_traffic[PRTE_RML_TAG_MAX + 1];
+
+void prte_rml_stats_record(prte_rml_tag_t tag, prte_rml_stat_dir_t dir, size_t nbytes)
+{
+    if (PRTE_RML_TAG_MAX < tag) {
+        tag = PRTE_RML_TAG_MAX;
+    }
+    prte_rml_stats_count(&tag_traffic[tag], dir, nbytes);
+}
+
+static void rcon(prte_rml_traffic_report_t *p)
+{
+    memset(p->tags, 0, sizeof(p->tags));
+    p->peers = NULL;
+    p->npeers = 0;
+    p->relm = NULL;
+    p->nrelm = 0;
+}
+static void rdes(prte_rml_traffic_report_t *p)
+{
+    free(p->peers);
+    free(p->relm);
+}
+PMIX_CLASS_INSTANCE(prte_rml_traffic_report_t, pmix_object_t, rcon, rdes);
+
+static int add_rows(uint64_t **rows, size_t *nrows, const uint64_t *add, size_t nadd,
+                    size_t ncols)
+{
+    uint64_t *tmp;
+
+    if (0 == nadd) {
+        return PRTE_SUCCESS;
+    }
+    tmp = (uint64_t *) realloc(*rows, (*nrows + nadd) * ncols * sizeof(uint64_t));
+    if (NULL == tmp) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(tmp + *nrows * ncols, add, nadd * ncols * sizeof(uint64_t));
+    *rows = tmp;
+    *nrows += nadd;
+    return PRTE_SUCCESS;
+}
+
+static void read_traffic(prte_rml_traffic_t *t, uint64_t *out)
+{
+    int d;
+
+    for (d = 0; d < PRTE_RML_STAT_NDIR; d++) {
+        out[2 * d] = atomic_load_explicit(&t->msgs[d], memory_order_relaxed);
+        out[2 * d + 1] = atomic_load_explicit(&t->bytes[d], memory_order_relaxed);
+    }
+}
+
+int prte_rml_traffic_snapshot(prte_rml_traffic_report_t *report)
+{
+    uint64_t counts[2 * PRTE_RML_STAT_NDIR];
+    uint64_t row[PRTE_RML_TRAFFIC_PEER_COLS];
+    prte_oob_tcp_peer_t *peer;
+    prte_relm_msg_t *msg;
+    int t, c, rc;
+
+    for (t = 0; t <= PRTE_RML_TAG_MAX; t++) {
+        read_traffic(&tag_traffic[t], counts);
+        for (c = 0; c < 2 * PRTE_RML_STAT_NDIR; c++) {
+            report->tags[t][c] += counts[c];
+        }
+    }
+
+    PMIX_LIST_FOREACH(peer, &prte_oob_base.peers, prte_oob_tcp_peer_t)
+    {
+        row[0] = PRTE_PROC_MY_NAME->rank;
+        row[1] = peer->name.rank;
+        read_traffic(&peer->traffic, &row[2]);
+        pmix_mutex_lock(&peer->lock);
+        row[8] = peer->queue_hwm;
+        pmix_mutex_unlock(&peer->lock);
+        rc = add_rows(&report->peers, &report->npeers, row, 1, PRTE_RML_TRAFFIC_PEER_COLS);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
+    if (NULL != prte_relm_sm) {
+        row[0] = PRTE_PROC_MY_NAME->rank;
+        row[1] = pmix_list_get_size(&prte_relm_sm->cached_messages);
+        row[2] = 0;
+        PMIX_LIST_FOREACH(msg, &prte_relm_sm->cached_messages, prte_relm_msg_t)
+        {
+            row[2] += msg->data.size;
+        }
+        row[3] = prte_relm_sm->cached_hwm;
+        rc = add_rows(&report->relm, &report->nrelm, row, 1, PRTE_RML_TRAFFIC_RELM_COLS);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+static int pack_rows(pmix_data_buffer_t *buf, const uint64_t *rows, size_t nrows, size_t ncols)
+{
+    pmix_status_t rc;
+
+    rc = PMIx_Data_pack(NULL, buf, &nrows, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc && 0 < nrows) {
+        rc = PMIx_Data_pack(NULL, buf, (void *) rows, (int32_t) (nrows * ncols), PMIX_UINT64);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+static int unpack_rows(pmix_data_buffer_t *buf, uint64_t **rows, size_t *nrows, size_t ncols)
+{
+    pmix_status_t rc;
+    uint64_t *in;
+    size_t n;
+    int32_t cnt;
+    int ret;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &n, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 == n) {
+        return PRTE_SUCCESS;
+    }
+    in = (uint64_t *) malloc(n * ncols * sizeof(uint64_t));
+    if (NULL == in) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    cnt = (int32_t) (n * ncols);
+    rc = PMIx_Data_unpack(NULL, buf, in, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        free(in);
+        return prte_pmix_convert_status(rc);
+    }
+    ret = add_rows(rows, nrows, in, n, ncols);
+    free(in);
+    return ret;
+}
+
+/* the tag table goes as rows, like the others, so that the tags nobody used
+ * cost nothing on the wire */
+static int tag_rows(const prte_rml_traffic_report_t *report, uint64_t **rows, size_t *nrows)
+{
+    uint64_t row[PRTE_RML_TRAFFIC_TAG_COLS];
+    int t, c, rc;
+    bool used;
+
+    for (t = 0; t <= PRTE_RML_TAG_MAX; t++) {
+        used = false;
+        row[0] = t;
+        for (c = 0; c < 2 * PRTE_RML_STAT_NDIR; c++) {
+            row[c + 1] = report->tags[t][c];
+            used |= (0 != row[c + 1]);
+        }
+        if (!used) {
+            continue;
+        }
+        rc = add_rows(rows, nrows, row, 1, PRTE_RML_TRAFFIC_TAG_COLS);
+        if (PRTE_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_rml_traffic_pack(pmix_data_buffer_t *buf, const prte_rml_traffic_report_t *report)
+{
+    uint64_t *rows = NULL;
+    size_t nrows = 0;
+    int rc;
+
+    rc = tag_rows(report, &rows, &nrows);
+    if (PRTE_SUCCESS == rc) {
+        rc = pack_rows(buf, rows, nrows, PRTE_RML_TRAFFIC_TAG_COLS);
+    }
+    free(rows);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
+    }
+    rc = pack_rows(buf, report->peers, report->npeers, PRTE_RML_TRAFFIC_PEER_COLS);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
+    }
+    return pack_rows(buf, report->relm, report->nrelm, PRTE_RML_TRAFFIC_RELM_COLS);
+}
+
+int prte_rml_traffic_unpack(pmix_data_buffer_t *buf, prte_rml_traffic_report_t *report)
+{
+    uint64_t *rows = NULL, *row;
+    size_t nrows = 0, n;
+    int c, rc;
+
+    rc = unpack_rows(buf, &rows, &nrows, PRTE_RML_TRAFFIC_TAG_COLS);
+    if (PRTE_SUCCESS != rc) {
+        free(rows);
+        return rc;
+    }
+    for (n = 0; n < nrows; n++) {
+        row = &rows[n * PRTE_RML_TRAFFIC_TAG_COLS];
+        if (PRTE_RML_TAG_MAX < row[0]) {
+            continue;
+        }
+        for (c = 0; c < 2 * PRTE_RML_STAT_NDIR; c++) {
+            report->tags[row[0]][c] += row[c + 1];
+        }
+    }
+    free(rows);
+
+    rc = unpack_rows(buf, &report->peers, &report->npeers, PRTE_RML_TRAFFIC_PEER_COLS);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
+    }
+    return unpack_rows(buf, &report->relm, &report->nrelm, PRTE_RML_TRAFFIC_RELM_COLS);
+}
+
+static pmix_status_t add_table(void *list, const char *key, const uint64_t *rows, size_t nrows,
+                               size_t ncols)
+{
+    pmix_data_array_t darray;
+    pmix_status_t rc;
+
+    if (0 == nrows) {
+        return PMIX_SUCCESS;
+    }
+    PMIX_DATA_ARRAY_CONSTRUCT(&darray, nrows * ncols, PMIX_UINT64);
+    memcpy(darray.array, rows, nrows * ncols * sizeof(uint64_t));
+    PMIX_INFO_LIST_ADD(rc, list, key, &darray, PMIX_DATA_ARRAY);
+    PMIX_DATA_ARRAY_DESTRUCT(&darray);
+    return rc;
+}
+
+int prte_rml_traffic_load(const prte_rml_traffic_report_t *report, pmix_data_array_t *darray)
+{
+    uint64_t *rows = NULL;
+    size_t nrows = 0;
+    pmix_status_t rc;
+    void *list;
+    int ret;
+
+    PMIX_DATA_ARRAY_CONSTRUCT(darray, 0, PMIX_INFO);
+    ret = tag_rows(report, &rows, &nrows);
+    if (PRTE_SUCCESS != ret) {
+        free(rows);
+        PRTE_ERROR_LOG(ret);
+        return ret;
+    }
+    PMIX_INFO_LIST_START(list);
+    rc = add_table(list, PRTE_RML_TRAFFIC_TAGS, rows, nrows, PRTE_RML_TRAFFIC_TAG_COLS);
+    free(rows);
+    if (PMIX_SUCCESS == rc) {
+        rc = add_table(list, PRTE_RML_TRAFFIC_PEERS, report->peers, report->npeers,
+                       PRTE_RML_TRAFFIC_PEER_COLS);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = add_table(list, PRTE_RML_TRAFFIC_RELM, report->relm, report->nrelm,
+                       PRTE_RML_TRAFFIC_RELM_COLS);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_INFO_LIST_CONVERT(rc, list, darray);
+        if (PMIX_ERR_EMPTY == rc) {
+            /* nothing has moved yet - an empty answer, not a failure */
+            rc = PMIX_SUCCESS;
+        }
+    }
+    PMIX_INFO_LIST_RELEASE(list);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
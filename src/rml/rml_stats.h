@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * RML traffic accounting: messages and bytes per tag and per peer.
+ *
+ * Every message the OOB puts on or takes off a socket is counted, once, as
+ * one of
+ *
+ *  - SENT:    it started here;
+ *  - RECVD:   it ended here (per tag), or it came in from that peer (per
+ *             peer, whatever its destination);
+ *  - RELAYED: it is passing through on its way somewhere else.
+ *
+ * The counters are relaxed atomic adds on the socket threads - no lock,
+ * nothing allocated - so they are always on.  Each static tag has a slot of
+ * its own, and the dynamic tags share one more.  A query (PRTE_QUERY_RML_TRAFFIC,
+ * see pmix_server_queries.c) takes a snapshot of them, of the OOB peers'
+ * queue high-water marks, and of the RELM cache, and can add up the same
+ * snapshot from every daemon in the DVM.
+ */
+
+#ifndef PRTE_RML_STATS_H
+#define PRTE_RML_STATS_H
+
+#include "prte_config.h"
+
+#include "src/include/prte_stdatomic.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/rml/rml_types.h"
+
+BEGIN_C_DECLS
+
+/* Query key: this daemon's traffic, or with PRTE_RML_TRAFFIC_DVM the whole
+ * DVM's.  The value is a PMIX_DATA_ARRAY of pmix_info_t holding the three
+ * tables below, each a PMIX_DATA_ARRAY of PMIX_UINT64 laid out row after
+ * row. */
+#define PRTE_QUERY_RML_TRAFFIC "prte.query.rml.traffic"
+/* qualifier (bool): gather every daemon's counters, not just ours */
+#define PRTE_RML_TRAFFIC_DVM   "prte.rml.traffic.dvm"
+/* rows of tag, sent msgs, sent bytes, recvd msgs, recvd bytes, relayed msgs,
+ * relayed bytes - summed across the daemons reporting.  Tag
+ * PRTE_RML_TAG_MAX stands for all the dynamic tags.  Tags with no traffic
+ * are left out. */
+#define PRTE_RML_TRAFFIC_TAGS  "prte.rml.traffic.tags"
+#define PRTE_RML_TRAFFIC_TAG_COLS 7
+/* rows of reporting daemon, peer, the same six counts, and the most messages
+ * ever waiting to go to that peer */
+#define PRTE_RML_TRAFFIC_PEERS "prte.rml.traffic.peers"
+#define PRTE_RML_TRAFFIC_PEER_COLS 9
+/* rows of reporting daemon, RELM messages cached, their bytes, and the most
+ * ever cached at once */
+#define PRTE_RML_TRAFFIC_RELM  "prte.rml.traffic.relm"
+#define PRTE_RML_TRAFFIC_RELM_COLS 4
+
+typedef enum {
+    PRTE_RML_STAT_SENT,
+    PRTE_RML_STAT_RECVD,
+    PRTE_RML_STAT_RELAYED,
+    PRTE_RML_STAT_NDIR
+} prte_rml_stat_dir_t;
+
+typedef struct {
+    prte_atomic_uint64_t msgs[PRTE_RML_STAT_NDIR];
+    prte_atomic_uint64_t bytes[PRTE_RML_STAT_NDIR];
+} prte_rml_traffic_t;
+
+static inline void prte_rml_stats_count(prte_rml_traffic_t *t, prte_rml_stat_dir_t dir,
+                                        size_t nbytes)
+{
+    atomic_fetch_add_explicit(&t->msgs[dir], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&t->bytes[dir], nbytes, memory_order_relaxed);
+}
+
+/* Count a message against its tag. */
+PRTE_EXPORT void prte_rml_stats_record(prte_rml_tag_t tag, prte_rml_stat_dir_t dir,
+                                       size_t nbytes);
+
+/* A snapshot of the counters, from one daemon or added up from several. */
+typedef struct {
+    pmix_object_t super;
+    uint64_t tags[PRTE_RML_TAG_MAX + 1][2 * PRTE_RML_STAT_NDIR];
+    uint64_t *peers;
+    size_t npeers;
+    uint64_t *relm;
+    size_t nrelm;
+} prte_rml_traffic_report_t;
+PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_rml_traffic_report_t);
+
+/* Add this daemon's counters to the report.  Main progress thread only - it
+ * walks the OOB's peers and the RELM cache. */
+PRTE_EXPORT int prte_rml_traffic_snapshot(prte_rml_traffic_report_t *report);
+
+/* Send a report to another daemon, and add one that came from another
+ * daemon to ours. */
+PRTE_EXPORT int prte_rml_traffic_pack(pmix_data_buffer_t *buf,
+                                      const prte_rml_traffic_report_t *report);
+PRTE_EXPORT int prte_rml_traffic_unpack(pmix_data_buffer_t *buf,
+                                        prte_rml_traffic_report_t *report);
+
+/* The report as the value of a PRTE_QUERY_RML_TRAFFIC answer. */
+PRTE_EXPORT int prte_rml_traffic_load(const prte_rml_traffic_report_t *report,
+                                      pmix_data_array_t *darray);
+
+END_C_DECLS
+
+#endif /* PRTE_RML_STATS_H */
@@ -129,6 +129,12 @@ typedef void (*prte_rml_buffer_callback_fn_t)(int status, pmix_proc_t *peer,
  * prte_odls_base_send_cpuset_slices(). */
 #define PRTE_RML_TAG_LAUNCH_SLICE 19
 
+/* A daemon named a launch template it does not hold asks the master for it
+ * on the first, and is answered on the second.  See
+ * src/runtime/prte_launch_template.h. */
+#define PRTE_RML_TAG_LAUNCH_TEMPLATE      20
+#define PRTE_RML_TAG_LAUNCH_TEMPLATE_RESP 25
+
 #define PRTE_RML_TAG_XCAST         15
 #define PRTE_RML_TAG_XCAST_ACK     16
 /* The bulk broadcast's allgather phase, and the request to abandon it.  Kept
@@ -151,6 +157,11 @@ typedef void (*prte_rml_buffer_callback_fn_t)(int status, pmix_proc_t *peer,
 
 /* collectives */
 #define PRTE_RML_TAG_FENCE_RELEASE     31
+/* The release of a fence answered below the master, passed down only the
+ * branches of the answering daemon's subtree that hold a participant.  Not
+ * PRTE_RML_TAG_FENCE_RELEASE, which is what the xcast delivers: this one is
+ * relayed by its receiver as well as delivered. */
+#define PRTE_RML_TAG_FENCE_SUBTREE     32
 #define PRTE_RML_TAG_FENCE             33
 /* A fence's lateral allgather.  Separate from PRTE_RML_TAG_FENCE because
  * these arrive from exchange partners rather than from a routing-tree child,
@@ -218,6 +229,23 @@ typedef void (*prte_rml_buffer_callback_fn_t)(int status, pmix_proc_t *peer,
  * src/util/prte_show_help.c for why a prted cannot emit its own */
 #define PRTE_RML_TAG_SHOW_HELP            82
 
+/* a DVM-wide traffic query (rml_stats.h): the request is xcast, and each
+ * daemon answers the daemon that asked */
+#define PRTE_RML_TAG_TRAFFIC_REQUEST      83
+#define PRTE_RML_TAG_TRAFFIC_RESP         84
+
+/* a launching daemon's launch timing, on its way to the HNP's launch
+ * profile - see plm_ssh_module.c */
+#define PRTE_RML_TAG_LAUNCH_PROFILE       85
+
+/* a daemon's startup phase timings, on their way to the HNP's startup
+ * report - see src/util/prte_profile.h */
+#define PRTE_RML_TAG_STARTUP_PROFILE      86
+
+/* the full node map for the daemons that hold none, xcast to just them ahead
+ * of the WIREUP that carries everybody else's delta - see src/util/nidmap.c */
+#define PRTE_RML_TAG_NIDMAP_SNAPSHOT      87
+
 #define PRTE_RML_TAG_MAX                 100
 
 #define PRTE_RML_TAG_NTOH(t) ntohl(t)
@@ -267,10 +295,22 @@ PMIX_CLASS_DECLARATION(prte_rml_recv_cb_t);
  * (sdptr/sdbytes/hdr_sent) in the send object, so several sends can read one
  * buffer concurrently.  The one rule is the obvious one - a shared payload is
  * immutable from the moment it is first handed to a send.
+ *
+ * A payload can also be a chain: dbuf followed by segments, buffers taken
+ * whole from elsewhere (see prte_rml_payload_take) and sent after it, in
+ * order, as one message.  The OOB hands the pieces to writev as they are, so
+ * a message assembled from others - a fence rollup, its children's
+ * contributions behind a header of its own - reaches the wire without ever
+ * being copied into one buffer.  The receiver sees the concatenation.  What
+ * a segment contributes is what has not been unpacked from it, so a received
+ * buffer can be chained with its already-read header left behind.
  */
 typedef struct {
     pmix_object_t super;
     pmix_data_buffer_t *dbuf;
+    // the chained segments, owned by the payload - NULL/0 for a plain one
+    pmix_data_buffer_t **segs;
+    size_t nsegs;
 } prte_rml_payload_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_rml_payload_t);
 
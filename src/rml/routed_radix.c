@@ -72,22 +72,28 @@ static void shrink_ranks(pmix_data_array_t* arr){
     resize_ranks(arr, size);
 }
 
+// True if target lies below us in the current tree: in the subtree of our
+// tree position, and not an ancestor that was promoted up out of it
+static bool below_me(pmix_rank_t target){
+    if(!radix_subtree_contains(&prte_rml_base.cur_node, target)){
+        return false;
+    }
+    pmix_rank_t* ancestors = (pmix_rank_t*)prte_rml_base.ancestors.array;
+    for(size_t i = 0; i < prte_rml_base.ancestors.size; i++){
+        if(ancestors[i] == target){
+            return false;
+        }
+    }
+    return true;
+}
+
 pmix_rank_t prte_rml_get_route(pmix_rank_t target){
     pmix_rank_t ret = PMIX_RANK_INVALID;
 
     if (PRTE_PROC_MY_NAME->rank == target) {
         ret = target;
-    } else if(!radix_subtree_contains(&prte_rml_base.cur_node, target)){
+    } else if(!below_me(target)){
         ret = PRTE_PROC_MY_PARENT->rank;
-    } else {
-        // This could still be an ancestor promoted up out of my current subtree
-        pmix_rank_t* ancestors = (pmix_rank_t*)prte_rml_base.ancestors.array;
-        for(size_t i = 0; i < prte_rml_base.ancestors.size; i++){
-            if(ancestors[i] == target){
-                ret = PRTE_PROC_MY_PARENT->rank;
-                break;
-            }
-        }
     }
 
     if(PMIX_RANK_INVALID == ret) {
@@ -834,3 +840,34 @@ int prte_rml_get_num_contributors(pmix_rank_t *dmns, size_t ndmns){
     PMIX_DESTRUCT(&contributors);
     return n_contributors;
 }
+
+bool prte_rml_is_subtree_root(pmix_rank_t *dmns, size_t ndmns){
+    pmix_rank_t first = PMIX_RANK_INVALID;
+    bool any = false, self = false, spans = false;
+
+    for(size_t i = 0; i < ndmns; i++){
+        if(pmix_bitmap_is_set_bit(&prte_rml_base.failed_dmns, dmns[i])){
+            continue;
+        }
+        any = true;
+        if(dmns[i] == PRTE_PROC_MY_NAME->rank){
+            self = true;
+            continue;
+        }
+        if(!below_me(dmns[i])){
+            return false;
+        }
+        pmix_rank_t child =
+            radix_subtree_index(&prte_rml_base.cur_node, dmns[i]);
+        if(child >= prte_rml_base.children.size){
+            // a failed rank we can't get any closer to, as in get_route
+            continue;
+        }
+        if(PMIX_RANK_INVALID == first){
+            first = child;
+        } else if(child != first){
+            spans = true;
+        }
+    }
+    return any && (self || spans);
+}
@@ -82,31 +82,114 @@ static int pack_map(pmix_data_buffer_t *bkt, char **list, char delim)
     return PRTE_SUCCESS;
 }
 
-/* One app's proc map: for each node of the job's map, in map order, the
- * ranks of that app resident on it.  A node where this app has no procs
- * contributes "-" rather than an empty field, so the map stays aligned with
- * the node map - an empty field would be dropped by the argv split at the
- * far end and silently shift every later node's ranks onto the wrong node.
+/* Encode a column of 32-bit values - one field of every proc, or of every
+ * run of a proc map, laid end to end.
  *
- * The per-node walk is node->procs in array order, which is exactly the
- * order compute_local_rank() assigns local ranks in, and the apps are walked
- * in the same order there and here.  That is what makes local_rank
- * derivable rather than merely guessable.
+ * The values of a field barely change from one proc to the next: every
+ * proc of a fresh job is in the same state, ranks climb by one, node ranks
+ * track local ranks.  A column is therefore run-length encoded, after
+ * replacing each value by its difference from the one before when "delta"
+ * is set, and goes into the buffer as two arrays of (value, run length) -
+ * one PMIx_Data_pack call each rather than one per element.  A column the
+ * runs would make bigger, which cannot happen for a regular map but can for
+ * a scattered one, goes as the plain array instead.  The decoder is told the
+ * column's length by its caller, never by the buffer.
  */
-static int pack_proc_map(pmix_data_buffer_t *bkt, prte_job_t *job, prte_app_idx_t idx)
+static int pack_column(pmix_data_buffer_t *bkt, const uint32_t *col, uint32_t n, bool delta)
 {
-    char **fields = NULL, **micro;
-    char *tmp;
+    uint32_t *vals, *lens, prev = 0, v, npairs = 0, i;
+    uint8_t form;
+    pmix_status_t rc;
+
+    if (0 == n) {
+        return PRTE_SUCCESS;
+    }
+    vals = (uint32_t *) malloc(2 * n * sizeof(uint32_t));
+    if (NULL == vals) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    lens = vals + n;
+    for (i = 0; i < n; i++) {
+        /* unsigned arithmetic: a step down wraps, and wraps back on decode */
+        v = delta ? col[i] - prev : col[i];
+        prev = col[i];
+        if (0 < npairs && vals[npairs - 1] == v) {
+            ++lens[npairs - 1];
+        } else {
+            vals[npairs] = v;
+            lens[npairs] = 1;
+            ++npairs;
+        }
+    }
+
+    form = (2 * npairs < n) ? PRTE_COLUMN_RUNS : PRTE_COLUMN_PLAIN;
+    rc = PMIx_Data_pack(NULL, bkt, &form, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+    if (PRTE_COLUMN_PLAIN == form) {
+        if (delta) {
+            /* a plain column still carries the differences, so that the
+             * decoder treats both forms alike */
+            prev = 0;
+            for (i = 0; i < n; i++) {
+                vals[i] = col[i] - prev;
+                prev = col[i];
+            }
+            rc = PMIx_Data_pack(NULL, bkt, vals, n, PMIX_UINT32);
+        } else {
+            rc = PMIx_Data_pack(NULL, bkt, (void *) col, n, PMIX_UINT32);
+        }
+        goto done;
+    }
+    rc = PMIx_Data_pack(NULL, bkt, &npairs, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, bkt, vals, npairs, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, bkt, lens, npairs, PMIX_UINT32);
+    }
+
+done:
+    free(vals);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+/* One app's proc map, as arithmetic runs: walking the nodes of the job's
+ * map in map order, and on each node the procs of this app in node->procs
+ * order, every stretch of ranks that climbs by a fixed stride on one node
+ * becomes a run of (node index, first rank, stride, length).  A by-slot map
+ * is one run per node, a by-node map one run per proc - and in both the
+ * four columns of runs are themselves regular enough that pack_column turns
+ * each into a handful of pairs, however many nodes there are.
+ *
+ * The walk is the one compute_local_rank() makes when it assigns local
+ * ranks, and the apps are walked in the same order there and here.  That is
+ * what makes local_rank derivable rather than merely guessable.  The local
+ * rank the far end will derive is recorded in "lrank", by rank, counting
+ * per node in "nlocal" across the apps.
+ */
+static int pack_proc_runs(pmix_data_buffer_t *bkt, prte_job_t *job, prte_app_idx_t idx,
+                          prte_local_rank_t *nlocal, prte_local_rank_t *lrank)
+{
+    uint32_t *col[4] = {NULL, NULL, NULL, NULL}, *tmp;
+    uint32_t nruns = 0, cap = 0, nidx = 0, last;
     prte_node_t *node;
     prte_proc_t *proc;
-    int n, m, rc;
+    pmix_rank_t r;
+    int n, m, k, rc = PRTE_SUCCESS;
 
+    /* col[0] node index, col[1] first rank, col[2] stride, col[3] length */
     for (n = 0; n < job->map->nodes->size; n++) {
         node = (prte_node_t *) pmix_pointer_array_get_item(job->map->nodes, n);
         if (NULL == node) {
             continue;
         }
-        micro = NULL;
         for (m = 0; m < node->procs->size; m++) {
             proc = (prte_proc_t *) pmix_pointer_array_get_item(node->procs, m);
             if (NULL == proc) {
@@ -118,19 +201,160 @@ static int pack_proc_map(pmix_data_buffer_t *bkt, prte_job_t *job, prte_app_idx_
             if (proc->app_idx != idx) {
                 continue;
             }
-            PMIx_Argv_append_nosize(&micro, PRTE_VPID_PRINT(proc->name.rank));
+            r = proc->name.rank;
+            if (job->num_procs <= r) {
+                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+                rc = PRTE_ERR_BAD_PARAM;
+                goto cleanup;
+            }
+            lrank[r] = nlocal[nidx]++;
+            if (0 < nruns && col[0][nruns - 1] == nidx) {
+                /* a second rank fixes the run's stride, any later one has
+                 * to keep to it */
+                last = nruns - 1;
+                if (1 == col[3][last]) {
+                    col[2][last] = r - col[1][last];
+                    ++col[3][last];
+                    continue;
+                }
+                if (r == col[1][last] + col[3][last] * col[2][last]) {
+                    ++col[3][last];
+                    continue;
+                }
+            }
+            if (nruns == cap) {
+                cap = (0 == cap) ? 64 : 2 * cap;
+                for (k = 0; k < 4; k++) {
+                    tmp = (uint32_t *) realloc(col[k], cap * sizeof(uint32_t));
+                    if (NULL == tmp) {
+                        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                        rc = PRTE_ERR_OUT_OF_RESOURCE;
+                        goto cleanup;
+                    }
+                    col[k] = tmp;
+                }
+            }
+            col[0][nruns] = nidx;
+            col[1][nruns] = r;
+            col[2][nruns] = 0;
+            col[3][nruns] = 1;
+            ++nruns;
         }
-        if (NULL == micro) {
-            PMIx_Argv_append_nosize(&fields, "-");
-        } else {
-            tmp = PMIx_Argv_join(micro, ',');
-            PMIx_Argv_free(micro);
-            PMIx_Argv_append_nosize(&fields, tmp);
-            free(tmp);
+        ++nidx;
+    }
+
+    rc = PMIx_Data_pack(NULL, bkt, &nruns, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        rc = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    /* node index and first rank climb, stride and length repeat */
+    for (k = 0; k < 4; k++) {
+        rc = pack_column(bkt, col[k], nruns, k < 2);
+        if (PRTE_SUCCESS != rc) {
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    for (k = 0; k < 4; k++) {
+        free(col[k]);
+    }
+    return rc;
+}
+
+/* What the proc maps cannot say, a column per field in rank order.
+ *
+ * The node rank counts procs of every job on the node, so one job's map
+ * cannot produce it - but in a DVM running one job at a time it is the local
+ * rank, which the far end derives (pack_proc_runs left it in "lrank"), so it
+ * travels as the difference and that column is a single run.  The state column of a job being launched is
+ * likewise one run.  The cpusets are strings: they go as one array, and not
+ * at all when they are being scattered - they are no use to anybody but the
+ * daemon that forks the proc, and in PRTE_JOB_PACK_NO_CPUSETS mode travel
+ * to that daemon alone (see prte_odls_base_send_cpuset_slices()).  Anything
+ * left that is of a shape no column suits is packed proc by proc by
+ * prte_proc_pack. */
+static int pack_proc_columns(pmix_data_buffer_t *bkt, prte_job_t *job,
+                             const prte_local_rank_t *lrank, bool devices,
+                             prte_job_pack_mode_t mode)
+{
+    uint32_t *col = NULL, k = 0;
+    char **cpusets = NULL;
+    prte_proc_t *proc;
+    pmix_status_t prc;
+    int j, rc = PRTE_SUCCESS;
+
+    col = (uint32_t *) malloc(job->num_procs * sizeof(uint32_t));
+    cpusets = (char **) malloc(job->num_procs * sizeof(char *));
+    if (NULL == col || NULL == cpusets) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+
+    for (j = 0; j < job->procs->size; j++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
+            continue;
+        }
+        if (k == job->num_procs) {
+            /* the far end reads exactly num_procs of everything */
+            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+            rc = PRTE_ERR_BAD_PARAM;
+            goto cleanup;
+        }
+        col[k] = (uint32_t) proc->node_rank - (uint32_t) lrank[proc->name.rank];
+        cpusets[k] = proc->cpuset;
+        ++k;
+    }
+    if (k != job->num_procs) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        rc = PRTE_ERR_BAD_PARAM;
+        goto cleanup;
+    }
+    rc = pack_column(bkt, col, k, false);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+
+    k = 0;
+    for (j = 0; j < job->procs->size && k < job->num_procs; j++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
+            continue;
+        }
+        col[k++] = proc->state;
+    }
+    rc = pack_column(bkt, col, k, false);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+
+    if (!(PRTE_JOB_PACK_NO_CPUSETS & mode)) {
+        prc = PMIx_Data_pack(NULL, bkt, cpusets, k, PMIX_STRING);
+        if (PMIX_SUCCESS != prc) {
+            PMIX_ERROR_LOG(prc);
+            rc = prte_pmix_convert_status(prc);
+            goto cleanup;
+        }
+    }
+
+    k = 0;
+    for (j = 0; j < job->procs->size && k < job->num_procs; j++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
+            continue;
         }
+        rc = prte_proc_pack(bkt, proc, devices);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        ++k;
     }
-    rc = pack_map(bkt, fields, ';');
-    PMIx_Argv_free(fields);
+
+cleanup:
+    free(col);
+    free(cpusets);
     return rc;
 }
 
@@ -139,7 +363,6 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job, prte_job_pack_mode_t
     pmix_status_t rc;
     int32_t j, count, bookmark;
     prte_app_context_t *app;
-    prte_proc_t *proc;
     prte_attribute_t *kv;
     pmix_list_t *cache;
     prte_info_item_t *val;
@@ -263,8 +486,22 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job, prte_job_pack_mode_t
         return prte_pmix_convert_status(rc);
     }
 
-    /* if there are apps, pack the app_contexts */
-    if (0 < job->num_apps) {
+    /* A launch against a template names it instead of packing the apps -
+     * the receiver already holds them (see prte_launch_template.h) */
+    if (PRTE_JOB_PACK_NO_APPS & mode) {
+        uint32_t id, *idptr = &id;
+        if (!prte_get_attribute(&job->attributes, PRTE_JOB_LAUNCH_TEMPLATE,
+                                (void **) &idptr, PMIX_UINT32)) {
+            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+            return PRTE_ERR_BAD_PARAM;
+        }
+        rc = PMIx_Data_pack(NULL, bkt, (void *) &id, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+    } else if (0 < job->num_apps) {
+        /* if there are apps, pack the app_contexts */
         for (j = 0; j < job->apps->size; j++) {
             if (NULL == (app = (prte_app_context_t *) pmix_pointer_array_get_item(job->apps, j))) {
                 continue;
@@ -292,13 +529,13 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job, prte_job_pack_mode_t
     /* The placement, as maps rather than as a per-proc array.
      *
      * The node map names the nodes this job is mapped onto, in map order.
-     * One proc map per app then gives, for each of those nodes in the same
-     * order, the ranks of that app resident on it - "-" where the app has
-     * none there, so the two lists stay in step.  Between them they carry
-     * every proc's rank, its hosting daemon, its app, its app rank and its
-     * local rank, in a form that compresses with the number of NODES rather
-     * than growing with the number of processes.  See prte_job_unpack for
-     * why each of those five is derivable.
+     * One proc map per app then gives, as runs of ranks against indices
+     * into that node map, the ranks of that app resident on each node.
+     * Between them they carry every proc's rank, its hosting daemon, its
+     * app, its app rank and its local rank, in a form that compresses with
+     * the regularity of the map rather than growing with the number of
+     * processes.  See prte_job_unpack for why each of those five is
+     * derivable.
      *
      * An unmapped job - a spawn request on its way to the HNP, which has not
      * been through rmaps yet - packs a zero here and nothing else. */
@@ -311,6 +548,7 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job, prte_job_pack_mode_t
         }
     } else {
         char **nodenames = NULL;
+        prte_local_rank_t *nlocal, *lrank;
         j = job->map->num_nodes;
         rc = PMIx_Data_pack(NULL, bkt, &j, 1, PMIX_INT32);
         if (PMIX_SUCCESS != rc) {
@@ -331,27 +569,35 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job, prte_job_pack_mode_t
             return rc;
         }
 
+        nlocal = (prte_local_rank_t *) calloc(job->map->nodes->size, sizeof(prte_local_rank_t));
+        lrank = (prte_local_rank_t *) calloc(job->num_procs, sizeof(prte_local_rank_t));
+        if (NULL == nlocal || NULL == lrank) {
+            free(nlocal);
+            free(lrank);
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+
         for (j = 0; j < job->apps->size; j++) {
             if (NULL == (app = (prte_app_context_t *) pmix_pointer_array_get_item(job->apps, j))) {
                 continue;
             }
-            rc = pack_proc_map(bkt, job, app->idx);
+            rc = pack_proc_runs(bkt, job, app->idx, nlocal, lrank);
             if (PRTE_SUCCESS != rc) {
                 PRTE_ERROR_LOG(rc);
-                return rc;
+                break;
             }
         }
 
         /* ...and then what the maps cannot say, in rank order */
-        for (j = 0; j < job->procs->size; j++) {
-            if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
-                continue;
-            }
-            rc = prte_proc_pack(bkt, proc, devices, mode);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                return prte_pmix_convert_status(rc);
-            }
+        if (PRTE_SUCCESS == rc) {
+            rc = pack_proc_columns(bkt, job, lrank, devices, mode);
+        }
+        free(nlocal);
+        free(lrank);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            return rc;
         }
     }
 
@@ -505,57 +751,26 @@ int prte_node_pack(pmix_data_buffer_t *bkt, prte_node_t *node)
 /*
  * PROC
  */
-int prte_proc_pack(pmix_data_buffer_t *bkt, prte_proc_t *proc, bool devices,
-                   prte_job_pack_mode_t mode)
+int prte_proc_pack(pmix_data_buffer_t *bkt, prte_proc_t *proc, bool devices)
 {
     pmix_status_t rc;
 
-    /* Only what the job's node and proc maps cannot say.
+    /* Only what neither the job's proc maps nor its per-proc columns say.
      *
      * A proc's rank, its hosting daemon, its app index, its app rank and its
      * local rank are all properties of WHERE it was placed, and the maps
-     * packed by prte_job_pack say exactly that - so packing them here was
-     * repeating the map once per process.  What is left is genuinely
-     * per-proc: the node rank counts procs of every job on that node, so one
-     * job's map cannot produce it; the cpuset is the binding the mapper
-     * computed; the state and attributes are its own. */
-
-    /* pack the node rank */
-    rc = PMIx_Data_pack(NULL, bkt, &proc->node_rank, 1, PMIX_UINT16);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
-    }
-
-    /* pack the state */
-    rc = PMIx_Data_pack(NULL, bkt, &proc->state, 1, PMIX_UINT32);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
-    }
-
-    /* The cpuset, unless it is being scattered.
-     *
-     * It is the largest of the three and the only one that is of no use to
-     * anybody but the daemon that forks the proc: node rank and state are
-     * read for procs this daemon does not host, the binding is not.  In
-     * PRTE_JOB_PACK_NO_CPUSETS mode it therefore travels to that daemon
-     * alone - see prte_odls_base_send_cpuset_slices(). */
-    if (PRTE_JOB_PACK_NO_CPUSETS != mode) {
-        rc = PMIx_Data_pack(NULL, bkt, (void *) &proc->cpuset, 1, PMIX_STRING);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return prte_pmix_convert_status(rc);
-        }
-    }
+     * packed by prte_job_pack say exactly that.  Its node rank, state and
+     * cpuset are packed there too, a column per field across the whole job.
+     * What is left is of a shape no column suits, and is packed here, proc
+     * by proc, after the columns. */
 
     /* The device this proc was mapped against, when the job was mapped by
      * one.  Packed as its own field rather than as an attribute, because no
      * attribute list goes on the wire (see below), and packed only for a
      * job that asked for a device map, so that every other job pays nothing
      * for it - the size discipline the comment below describes applies here
-     * too. Both ends test the same condition, and the job's mapping policy
-     * has already been packed by the time this runs. */
+     * too. Both ends test the same condition, which travels at the head of
+     * the job. */
     if (devices) {
         pmix_data_array_t *devs = NULL;
         uint16_t ndevs;
@@ -38,13 +38,20 @@
 #include "src/runtime/prte_globals.h"
 #include "src/util/error_strings.h"
 #include "src/util/name_fns.h"
-
-
+#include "src/util/prte_strbuf.h"
+/* Every printer here appends to a prte_strbuf_t rather than re-printing the
+ * accumulated report onto itself: a map is one string handed to the IOF,
+ * and building it "%s%s" at a time copied the whole thing once per line.
+ * The public char** entry points below are thin wrappers. */
+static void job_print(prte_strbuf_t *sb, prte_job_t *src);
+static void app_print(prte_strbuf_t *sb, prte_app_context_t *src);
+static void map_print(prte_strbuf_t *sb, prte_job_t *jdata);
+static void node_print(prte_strbuf_t *sb, prte_job_t *jdata, prte_node_t *src);
+static void proc_print(prte_strbuf_t *sb, prte_job_t *jdata, prte_proc_t *src);
 
 /* This function is a modified version of the one found in src/mca/ras/base/ras_base_allocate.c*/
-static void display_cpus(prte_topology_t *t,
-                         prte_job_t *jdata,
-                         char *node, char**output)
+static void display_cpus(prte_strbuf_t *sb, prte_topology_t *t,
+                         prte_job_t *jdata)
 {
     char *tmp;
     unsigned pkg, npkgs;
@@ -52,163 +59,197 @@ static void display_cpus(prte_topology_t *t,
     hwloc_obj_t obj;
     hwloc_cpuset_t avail = NULL;
     hwloc_cpuset_t allowed;
-    PRTE_HIDE_UNUSED_PARAMS(node);
-
-    char *tmp1, *tmp2;
 
     use_hwthread_cpus = prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PMIX_BOOL);
     physical = prte_get_attribute(&jdata->attributes, PRTE_JOB_REPORT_PHYSICAL_CPUS, NULL,
                                   PMIX_BOOL);
     avail = hwloc_bitmap_alloc();
-    pmix_asprintf(&tmp1, "        <processors>\n");
+    prte_strbuf_append(sb, "        <processors>\n");
     npkgs = prte_hwloc_base_get_nbobjs_by_type(t->topo, HWLOC_OBJ_PACKAGE);
     allowed = (hwloc_cpuset_t)hwloc_topology_get_allowed_cpuset(t->topo);
     for (pkg = 0; pkg < npkgs; pkg++) {
         obj = prte_hwloc_base_get_obj_by_type(t->topo, HWLOC_OBJ_PACKAGE, pkg);
         hwloc_bitmap_and(avail, obj->cpuset, allowed);
         if (hwloc_bitmap_iszero(avail)) {
-            pmix_asprintf(&tmp2, "%s            <package id=\"%d\" cpus=\"%s\"/>\n", tmp1, pkg, "NONE");
-            /* fall through to the accumulate step below rather than
-             * continuing: skipping it both dropped this package from the
-             * output and leaked the string just built for it */
-            free(tmp1);
-            tmp1 = tmp2;
-            tmp2 = NULL;
+            prte_strbuf_printf(sb, "            <package id=\"%d\" cpus=\"%s\"/>\n", pkg, "NONE");
             continue;
         }
         /* the bits are PU OS indices; what the user needs to read back out
          * (and hand to --cpu-set) is the list of cores, or of hwthreads if
          * that is what this job is using as cpus */
         tmp = prte_hwloc_base_cpuset2ranges(t->topo, avail, use_hwthread_cpus, physical);
-        pmix_asprintf(&tmp2, "%s            <package id=\"%d\" cpus=\"%s\"/>\n", tmp1, pkg,
-                      (NULL == tmp) ? "NONE" : tmp);
+        prte_strbuf_printf(sb, "            <package id=\"%d\" cpus=\"%s\"/>\n", pkg,
+                           (NULL == tmp) ? "NONE" : tmp);
         free(tmp);
-        free(tmp1);
-        tmp1 = tmp2;
-        tmp2 = NULL;
     }
     hwloc_bitmap_free(avail);
 
-    pmix_asprintf(output, "%s        </processors>\n", tmp1);
-    free(tmp1);
+    prte_strbuf_append(sb, "        </processors>\n");
     return;
 }
 
+static int rank_cmp(const void *a, const void *b)
+{
+    const prte_proc_t *pa = *(prte_proc_t *const *) a;
+    const prte_proc_t *pb = *(prte_proc_t *const *) b;
+
+    if (pa->name.rank < pb->name.rank) {
+        return -1;
+    }
+    return (pa->name.rank > pb->name.rank) ? 1 : 0;
+}
+
+/* This job's procs on this node, in job-rank order. They sit in the node
+ * array in the order they were mapped, which often is not rank order; the
+ * old way round was to scan every proc of the job for each node, which is
+ * nodes x procs for a whole map. Caller frees the array. */
+static prte_proc_t **node_job_procs(prte_job_t *jdata, prte_node_t *node, int *nprocs)
+{
+    prte_proc_t **procs, *proc;
+    int j, n = 0;
+
+    *nprocs = 0;
+    if (0 == node->procs->size) {
+        return NULL;
+    }
+    procs = (prte_proc_t **) malloc(node->procs->size * sizeof(prte_proc_t *));
+    if (NULL == procs) {
+        return NULL;
+    }
+    for (j = 0; j < node->procs->size; j++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(node->procs, j))) {
+            continue;
+        }
+        if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
+            continue;
+        }
+        procs[n++] = proc;
+    }
+    qsort(procs, n, sizeof(prte_proc_t *), rank_cmp);
+    *nprocs = n;
+    return procs;
+}
+
+/* The device names assigned to a proc, comma separated, or nothing at all
+ * if the job was not mapped by device */
+static void proc_devices(prte_strbuf_t *sb, prte_proc_t *src, const char *pfx,
+                         bool json)
+{
+    pmix_data_array_t *devarray = NULL;
+    pmix_device_t *dv;
+    const char *nm;
+    size_t dn;
+    bool first = true;
+
+    if (!prte_get_attribute(&src->attributes, PRTE_PROC_DEVICE_ID,
+                            (void **) &devarray, PMIX_DATA_ARRAY)
+        || NULL == devarray) {
+        return;
+    }
+    dv = (pmix_device_t *) devarray->array;
+    /* the assignment is always an array, so render every entry -
+     * showing only the first would misreport a job using "ndev" */
+    for (dn = 0; dn < devarray->size; dn++) {
+        nm = (NULL != dv[dn].osname) ? dv[dn].osname : dv[dn].uuid;
+        if (NULL == nm) {
+            continue;
+        }
+        if (first) {
+            prte_strbuf_append(sb, pfx);
+        } else {
+            prte_strbuf_append(sb, ",");
+        }
+        if (json) {
+            prte_strbuf_json_string(sb, nm);
+        } else {
+            prte_strbuf_append(sb, nm);
+        }
+        first = false;
+    }
+    PMIX_DATA_ARRAY_FREE(devarray);
+}
 
 /*
  * JOB
  */
-void prte_job_print(char **output, prte_job_t *src)
+static void job_print(prte_strbuf_t *sb, prte_job_t *src)
 {
-    char *tmp, *tmp2, *tmp3;
+    char *tmp;
     int32_t i;
     prte_app_context_t *app;
     prte_proc_t *proc;
 
-    /* set default result */
-    *output = NULL;
-
-    tmp2 = PMIx_Argv_join(src->personality, ',');
-    pmix_asprintf(&tmp,
-                  "\nData for job: %s\tPersonality: %s\tRecovery: %s\n\tNum apps: %ld\tStdin "
-                  "target: %s\tState: %s\tAbort: %s",
-                  PRTE_JOBID_PRINT(src->nspace), tmp2,
-                  (prte_get_attribute(&src->attributes, PRTE_JOB_RECOVERABLE, NULL, PMIX_BOOL)) ? "ENABLED" : "DISABLED",
-                  (long) src->num_apps, PRTE_VPID_PRINT(src->stdin_target),
-                  prte_job_state_to_str(src->state),
-                  (PRTE_FLAG_TEST(src, PRTE_JOB_FLAG_ABORTED)) ? "True" : "False");
-    free(tmp2);
+    tmp = PMIx_Argv_join(src->personality, ',');
+    prte_strbuf_printf(sb,
+                       "\nData for job: %s\tPersonality: %s\tRecovery: %s\n\tNum apps: %ld\tStdin "
+                       "target: %s\tState: %s\tAbort: %s",
+                       PRTE_JOBID_PRINT(src->nspace), tmp,
+                       (prte_get_attribute(&src->attributes, PRTE_JOB_RECOVERABLE, NULL, PMIX_BOOL)) ? "ENABLED" : "DISABLED",
+                       (long) src->num_apps, PRTE_VPID_PRINT(src->stdin_target),
+                       prte_job_state_to_str(src->state),
+                       (PRTE_FLAG_TEST(src, PRTE_JOB_FLAG_ABORTED)) ? "True" : "False");
+    free(tmp);
 
     for (i = 0; i < src->apps->size; i++) {
         if (NULL == (app = (prte_app_context_t *) pmix_pointer_array_get_item(src->apps, i))) {
             continue;
         }
-        prte_app_print(&tmp2, src, app);
-        pmix_asprintf(&tmp3, "%s\n%s", tmp, tmp2);
-        free(tmp);
-        free(tmp2);
-        tmp = tmp3;
+        prte_strbuf_append(sb, "\n");
+        app_print(sb, app);
     }
 
     if (NULL != src->map) {
-        prte_map_print(&tmp2, src);
-        pmix_asprintf(&tmp3, "%s%s", tmp, tmp2);
-        free(tmp);
-        free(tmp2);
-        tmp = tmp3;
+        map_print(sb, src);
     } else {
-        pmix_asprintf(&tmp2, "%s\nNo Map", tmp);
-        free(tmp);
-        tmp = tmp2;
+        prte_strbuf_append(sb, "\nNo Map");
     }
 
-    pmix_asprintf(&tmp2, "%s\nNum procs: %ld\tOffset: %ld", tmp, (long) src->num_procs,
-                  (long) src->offset);
-    free(tmp);
-    tmp = tmp2;
+    prte_strbuf_printf(sb, "\nNum procs: %ld\tOffset: %ld", (long) src->num_procs,
+                       (long) src->offset);
 
     for (i = 0; i < src->procs->size; i++) {
         if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(src->procs, i))) {
             continue;
         }
-        prte_proc_print(&tmp2, src, proc);
-        pmix_asprintf(&tmp3, "%s%s", tmp, tmp2);
-        free(tmp);
-        free(tmp2);
-        tmp = tmp3;
+        proc_print(sb, src, proc);
     }
 
-    pmix_asprintf(&tmp2, "%s\n\tNum launched: %ld\tNum reported: %ld\tNum terminated: %ld", tmp,
-                  (long) src->num_launched, (long) src->num_reported, (long) src->num_terminated);
-    free(tmp);
-    tmp = tmp2;
+    prte_strbuf_printf(sb, "\n\tNum launched: %ld\tNum reported: %ld\tNum terminated: %ld",
+                       (long) src->num_launched, (long) src->num_reported,
+                       (long) src->num_terminated);
+}
 
-    /* set the return */
-    *output = tmp;
-    return;
+void prte_job_print(char **output, prte_job_t *jdata)
+{
+    prte_strbuf_t sb = PRTE_STRBUF_STATIC_INIT;
+
+    job_print(&sb, jdata);
+    *output = prte_strbuf_release(&sb);
 }
 
 /*
  * NODE
  */
-void prte_node_print(char **output, prte_job_t *jdata, prte_node_t *src)
+static void node_print(prte_strbuf_t *sb, prte_job_t *jdata, prte_node_t *src)
 {
-    char *tmp, *tmp1 = NULL, *tmp2, *tmp3;
-    int32_t i,j;
-    prte_proc_t *proc;
+    char *tmp;
+    int32_t i, j;
+    int nprocs;
+    prte_proc_t *proc, **procs;
     prte_topology_t *t;
 
-    /* set default result */
-    *output = NULL;
-
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT, NULL, PMIX_BOOL)) {
-        pmix_asprintf(&tmp, "    <host name=\"%s\" slots=\"%d\" max_slots=\"%d\">\n",
-                      (NULL == src->name) ? "UNKNOWN" : src->name, (int) src->slots,
-                      (int) src->slots_max);
+        prte_strbuf_printf(sb, "    <host name=\"%s\" slots=\"%d\" max_slots=\"%d\">\n",
+                           (NULL == src->name) ? "UNKNOWN" : src->name, (int) src->slots,
+                           (int) src->slots_max);
 
-        tmp2 = (char*)malloc(1);
-        tmp2[0] = '\0';
         for (j=0; j < prte_node_topologies->size; j++) {
             t = (prte_topology_t*)pmix_pointer_array_get_item(prte_node_topologies, j);
             if (NULL != t) {
-                display_cpus(t, jdata, "N/A", &tmp1);
-                pmix_asprintf(&tmp3, "%s%s",tmp2, tmp1);
-                free(tmp1);
-                tmp1 = NULL;
-                free(tmp2);
-                tmp2 = NULL;
-                tmp2 = tmp3;
+                display_cpus(sb, t, jdata);
             }
         }
 
-        pmix_asprintf(&tmp3, "%s%s", tmp,tmp2);
-        free(tmp2);
-        tmp2 = NULL;
-        free(tmp1);
-        tmp1 = NULL;
-        free(tmp);
-        tmp = tmp3;
-
         /* loop through procs and print their rank */
         for (j = 0; j < src->procs->size; j++) {
             if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(src->procs, j))) {
@@ -217,106 +258,102 @@ void prte_node_print(char **output, prte_job_t *jdata, prte_node_t *src)
             if (!PMIX_CHECK_NSPACE(proc->name.nspace, jdata->nspace)) {
                 continue;
             }
-            prte_proc_print(&tmp2, jdata, proc);
-            pmix_asprintf(&tmp3, "%s%s", tmp, tmp2);
-            free(tmp2);
-            tmp2 = NULL;
-            free(tmp);
-            tmp = tmp3;
-        }
-        pmix_asprintf(&tmp3, "%s    </host>\n", tmp);
-        free(tmp);
-        *output = tmp3;
+            proc_print(sb, jdata, proc);
+        }
+        prte_strbuf_append(sb, "    </host>\n");
         return;
     }
 
     if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL)) {
         /* just provide a simple output for users */
-        pmix_asprintf(&tmp, "\nData for node: %s\tNum slots: %ld\tMax slots: %ld\tNum procs: %ld",
-                      (NULL == src->name) ? "UNKNOWN" : src->name, (long) src->slots,
-                      (long) src->slots_max, (long) src->num_procs);
+        prte_strbuf_printf(sb, "\nData for node: %s\tNum slots: %ld\tMax slots: %ld\tNum procs: %ld",
+                           (NULL == src->name) ? "UNKNOWN" : src->name, (long) src->slots,
+                           (long) src->slots_max, (long) src->num_procs);
         if (0 == src->num_procs) {
-            *output = tmp;
             return;
         }
         goto PRINT_PROCS;
     }
 
-    tmp3 = prte_ras_base_flag_string(src);
-    pmix_asprintf(&tmp, "\nData for node: %s\tState: %0x\t%s",
-                  (NULL == src->name) ? "UNKNOWN" : src->name, src->state, tmp3);
-    free(tmp3);
-    tmp3 = NULL;
+    tmp = prte_ras_base_flag_string(src);
+    prte_strbuf_printf(sb, "\nData for node: %s\tState: %0x\t%s",
+                       (NULL == src->name) ? "UNKNOWN" : src->name, src->state, tmp);
+    free(tmp);
 
     /* does this node have any aliases? */
     if (NULL != src->aliases) {
         for (i = 0; NULL != src->aliases[i]; i++) {
-            pmix_asprintf(&tmp2, "%s\n                resolved from %s", tmp, src->aliases[i]);
-            free(tmp);
-            tmp = tmp2;
+            prte_strbuf_printf(sb, "\n                resolved from %s", src->aliases[i]);
         }
     }
 
-    pmix_asprintf(&tmp2, "%s\n        Daemon: %s\tDaemon launched: %s", tmp,
-                  (NULL == src->daemon) ? "Not defined" : PRTE_NAME_PRINT(&(src->daemon->name)),
-                  PRTE_FLAG_TEST(src, PRTE_NODE_FLAG_DAEMON_LAUNCHED) ? "True" : "False");
-    free(tmp);
-    tmp = tmp2;
+    prte_strbuf_printf(sb, "\n        Daemon: %s\tDaemon launched: %s",
+                       (NULL == src->daemon) ? "Not defined" : PRTE_NAME_PRINT(&(src->daemon->name)),
+                       PRTE_FLAG_TEST(src, PRTE_NODE_FLAG_DAEMON_LAUNCHED) ? "True" : "False");
 
-    pmix_asprintf(&tmp2, "%s\n            Num slots: %ld\tSlots in use: %ld\tOversubscribed: %s",
-                  tmp, (long) src->slots, (long) src->slots_inuse,
-                  PRTE_FLAG_TEST(src, PRTE_NODE_FLAG_OVERSUBSCRIBED) ? "TRUE" : "FALSE");
-    free(tmp);
-    tmp = tmp2;
+    prte_strbuf_printf(sb, "\n            Num slots: %ld\tSlots in use: %ld\tOversubscribed: %s",
+                       (long) src->slots, (long) src->slots_inuse,
+                       PRTE_FLAG_TEST(src, PRTE_NODE_FLAG_OVERSUBSCRIBED) ? "TRUE" : "FALSE");
 
-    pmix_asprintf(&tmp2, "%s\n            Num slots allocated: %ld\tMax slots: %ld\tNum procs: %ld", tmp,
-                  (long) src->slots, (long) src->slots_max, (long) src->num_procs);
-    free(tmp);
-    tmp = tmp2;
+    prte_strbuf_printf(sb, "\n            Num slots allocated: %ld\tMax slots: %ld\tNum procs: %ld",
+                       (long) src->slots, (long) src->slots_max, (long) src->num_procs);
 
-    tmp3 = NULL;
-    if (prte_get_attribute(&src->attributes, PRTE_NODE_USERNAME, (void **) &tmp3, PMIX_STRING) &&
-        NULL != tmp3) {
-        pmix_asprintf(&tmp2, "%s\n            Username on node: %s", tmp, tmp3);
-        free(tmp3);
+    tmp = NULL;
+    if (prte_get_attribute(&src->attributes, PRTE_NODE_USERNAME, (void **) &tmp, PMIX_STRING) &&
+        NULL != tmp) {
+        prte_strbuf_printf(sb, "\n            Username on node: %s", tmp);
         free(tmp);
-        tmp = tmp2;
     }
 
 PRINT_PROCS:
     /* we want to print these procs in their job-rank'd order, but they
      * will be in the node array based on the order in which they were
      * mapped - which doesn't match job-rank'd order in many cases */
-    for (i = 0; i < jdata->procs->size; i++) {
-        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, i))) {
-            continue;
-        }
-        if (proc->node != src) {
-            continue;
-        }
-        prte_proc_print(&tmp2, jdata, proc);
-        pmix_asprintf(&tmp3, "%s%s", tmp, tmp2);
-        free(tmp);
-        free(tmp2);
-        tmp = tmp3;
+    procs = node_job_procs(jdata, src, &nprocs);
+    for (i = 0; i < nprocs; i++) {
+        proc_print(sb, jdata, procs[i]);
     }
+    free(procs);
+}
 
-    /* set the return */
-    *output = tmp;
+void prte_node_print(char **output, prte_job_t *jdata, prte_node_t *src)
+{
+    prte_strbuf_t sb = PRTE_STRBUF_STATIC_INIT;
 
-    return;
+    node_print(&sb, jdata, src);
+    *output = prte_strbuf_release(&sb);
+}
+
+/* The cpus a proc is bound to, rendered for a human, or NULL if that
+ * cannot be worked out. The topology has to be reachable to render a
+ * cpuset: a proc that was never mapped (or whose node has already been
+ * torn down - the node clears the backpointer on the procs it knows about)
+ * has no node. */
+static char *proc_bound(prte_proc_t *src, bool use_hwthread_cpus, bool physical)
+{
+    hwloc_cpuset_t mycpus;
+    char *str;
+
+    if (NULL == src->cpuset || NULL == src->node ||
+        NULL == src->node->topology || NULL == src->node->topology->topo) {
+        return NULL;
+    }
+    mycpus = hwloc_bitmap_alloc();
+    hwloc_bitmap_list_sscanf(mycpus, src->cpuset);
+    str = prte_hwloc_base_cset2str(mycpus, use_hwthread_cpus, physical,
+                                   src->node->topology->topo);
+    hwloc_bitmap_free(mycpus);
+    return str;
 }
 
 /*
  * PROC
  */
-void prte_proc_print(char **output, prte_job_t *jdata, prte_proc_t *src)
+static void proc_print(prte_strbuf_t *sb, prte_job_t *jdata, prte_proc_t *src)
 {
-    char *tmp, *tmp3, *tmp4, *pfx2 = "        ";
-    char *tmp2;
+    char *pfx2 = "        ";
     hwloc_cpuset_t mycpus;
     char *str;
-    pmix_data_array_t *devarray;
     bool use_hwthread_cpus;
     int npus;
     int npkgs;
@@ -324,9 +361,6 @@ void prte_proc_print(char **output, prte_job_t *jdata, prte_proc_t *src)
     char xmlsp = ' ';
     bool physical;
 
-    /* set default result */
-    *output = NULL;
-
     /* check for type of cpu being used */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PMIX_BOOL)) {
         use_hwthread_cpus = true;
@@ -339,9 +373,6 @@ void prte_proc_print(char **output, prte_job_t *jdata, prte_proc_t *src)
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT, NULL, PMIX_BOOL)) {
         if (NULL != src->cpuset && NULL != src->node &&
             NULL != src->node->topology && NULL != src->node->topology->topo) {
-            mycpus = hwloc_bitmap_alloc();
-            hwloc_bitmap_list_sscanf(mycpus, src->cpuset);
-
             npus = prte_hwloc_base_get_nbobjs_by_type(src->node->topology->topo, HWLOC_OBJ_PU);
             npkgs = prte_hwloc_base_get_nbobjs_by_type(src->node->topology->topo,
                                                        HWLOC_OBJ_PACKAGE);
@@ -357,10 +388,11 @@ void prte_proc_print(char **output, prte_job_t *jdata, prte_proc_t *src)
             int sz = sizeof(char) * (npus * 48 + npkgs * 64 + 64);
             cores = (char*)malloc(sz);
             if (NULL == cores) {
-                pmix_asprintf(&tmp, "\n%*c<MemoryError/>\n", 8, xmlsp);
-                *output = tmp;
+                prte_strbuf_printf(sb, "\n%*c<MemoryError/>\n", 8, xmlsp);
                 return;
             }
+            mycpus = hwloc_bitmap_alloc();
+            hwloc_bitmap_list_sscanf(mycpus, src->cpuset);
             /* the renderer emits the <package> elements itself: a process
              * bound across two packages has two of them, and the shape this
              * used to wrap around it could only ever name one */
@@ -369,172 +401,106 @@ void prte_proc_print(char **output, prte_job_t *jdata, prte_proc_t *src)
 
             hwloc_bitmap_free(mycpus);
 
-            pmix_asprintf(&tmp, "\n%*c<rank id=\"%s\" appid=\"%ld\">\n%*c<binding>\n"
-                          "%s%*c</binding>\n%*c</rank>\n",
-                          8, xmlsp, PRTE_VPID_PRINT(src->name.rank), (long) src->app_idx, 12, xmlsp,
-                          cores, 12, xmlsp, 8, xmlsp);
+            prte_strbuf_printf(sb, "\n%*c<rank id=\"%s\" appid=\"%ld\">\n%*c<binding>\n"
+                               "%s%*c</binding>\n%*c</rank>\n",
+                               8, xmlsp, PRTE_VPID_PRINT(src->name.rank), (long) src->app_idx, 12, xmlsp,
+                               cores, 12, xmlsp, 8, xmlsp);
 
             free (cores);
         } else {
-            pmix_asprintf(&tmp, "\n%*c<rank id=\"%s\">\n%*c<binding></binding>\n%*c</rank>\n",
-                          8, xmlsp, PRTE_VPID_PRINT(src->name.rank), 12, xmlsp, 8, xmlsp);
+            prte_strbuf_printf(sb, "\n%*c<rank id=\"%s\">\n%*c<binding></binding>\n%*c</rank>\n",
+                               8, xmlsp, PRTE_VPID_PRINT(src->name.rank), 12, xmlsp, 8, xmlsp);
         }
-
-        /* set the return */
-        *output = tmp;
         return;
     }
 
     if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL)) {
         if (NULL != src->cpuset && NULL != src->node
             && NULL != src->node->topology && NULL != src->node->topology->topo) {
-            mycpus = hwloc_bitmap_alloc();
-            hwloc_bitmap_list_sscanf(mycpus, src->cpuset);
-            str = prte_hwloc_base_cset2str(mycpus, use_hwthread_cpus, physical,
-                                           src->node->topology->topo);
-            if (NULL == str) {
-                str = strdup("UNBOUND");
-            }
-            hwloc_bitmap_free(mycpus);
-            pmix_asprintf(&tmp, "\n%sProcess jobid: %s App: %ld Process rank: %s Bound: %s", pfx2,
-                          PRTE_JOBID_PRINT(src->name.nspace), (long) src->app_idx,
-                          PRTE_VPID_PRINT(src->name.rank), str);
+            str = proc_bound(src, use_hwthread_cpus, physical);
+            prte_strbuf_printf(sb, "\n%sProcess jobid: %s App: %ld Process rank: %s Bound: %s", pfx2,
+                               PRTE_JOBID_PRINT(src->name.nspace), (long) src->app_idx,
+                               PRTE_VPID_PRINT(src->name.rank), (NULL == str) ? "UNBOUND" : str);
             free(str);
         } else {
             /* just print a very simple output for users */
-            pmix_asprintf(&tmp, "\n%sProcess jobid: %s App: %ld Process rank: %s Bound: N/A", pfx2,
-                          PRTE_JOBID_PRINT(src->name.nspace), (long) src->app_idx,
-                          PRTE_VPID_PRINT(src->name.rank));
+            prte_strbuf_printf(sb, "\n%sProcess jobid: %s App: %ld Process rank: %s Bound: N/A", pfx2,
+                               PRTE_JOBID_PRINT(src->name.nspace), (long) src->app_idx,
+                               PRTE_VPID_PRINT(src->name.rank));
         }
 
         /* When the job was mapped by device, say which device this proc got.
          * A placement the user cannot see is a placement they will not
          * trust, and --display map is the first thing they will check. */
-        devarray = NULL;
-        if (prte_get_attribute(&src->attributes, PRTE_PROC_DEVICE_ID,
-                               (void **) &devarray, PMIX_DATA_ARRAY)
-            && NULL != devarray) {
-            pmix_device_t *dv = (pmix_device_t *) devarray->array;
-            char *dlist = NULL, *dt;
-            size_t dn;
-            /* the assignment is always an array, so render every entry -
-             * showing only the first would misreport a job using "ndev" */
-            for (dn = 0; dn < devarray->size; dn++) {
-                const char *nm = (NULL != dv[dn].osname) ? dv[dn].osname
-                                                         : dv[dn].uuid;
-                if (NULL == nm) {
-                    continue;
-                }
-                if (NULL == dlist) {
-                    dlist = strdup(nm);
-                } else {
-                    pmix_asprintf(&dt, "%s,%s", dlist, nm);
-                    free(dlist);
-                    dlist = dt;
-                }
-            }
-            if (NULL != dlist) {
-                pmix_asprintf(&tmp2, "%s Device: %s", tmp, dlist);
-                free(tmp);
-                free(dlist);
-                tmp = tmp2;
-            }
-            PMIX_DATA_ARRAY_FREE(devarray);
-        }
-
-        /* set the return */
-        *output = tmp;
+        proc_devices(sb, src, " Device: ", false);
         return;
     }
 
-    pmix_asprintf(&tmp, "\n%sData for proc: %s", pfx2, PRTE_NAME_PRINT(&src->name));
+    prte_strbuf_printf(sb, "\n%sData for proc: %s", pfx2, PRTE_NAME_PRINT(&src->name));
 
-    pmix_asprintf(&tmp3, "%s\n%s        Pid: %ld\tLocal rank: %lu\tNode rank: %lu\tApp rank: %d",
-                  tmp, pfx2, (long) src->pid, (unsigned long) src->local_rank,
-                  (unsigned long) src->node_rank, src->app_rank);
-    free(tmp);
-    tmp = tmp3;
-
-    /* the topology has to be reachable to render a cpuset: a proc that was
-     * never mapped (or whose node has already been torn down - the node
-     * clears the backpointer on the procs it knows about) has no node, and
-     * this path had none of the guards its two siblings above carry */
-    if (NULL != src->cpuset && NULL != src->node &&
-        NULL != src->node->topology && NULL != src->node->topology->topo) {
-        mycpus = hwloc_bitmap_alloc();
-        hwloc_bitmap_list_sscanf(mycpus, src->cpuset);
-        tmp2 = prte_hwloc_base_cset2str(mycpus, use_hwthread_cpus,
-                                        physical, src->node->topology->topo);
-        hwloc_bitmap_free(mycpus);
-        if (NULL == tmp2) {
-            tmp2 = strdup("UNBOUND");
-        }
-    } else {
-        tmp2 = strdup("UNBOUND");
-    }
-    pmix_asprintf(&tmp4,
-                  "%s\n%s        State: %s\tApp_context: %ld\n%s\tBinding: %s",
-                  tmp, pfx2, prte_proc_state_to_str(src->state), (long) src->app_idx, pfx2, tmp2);
-    free(tmp);
-    free(tmp2);
+    prte_strbuf_printf(sb, "\n%s        Pid: %ld\tLocal rank: %lu\tNode rank: %lu\tApp rank: %d",
+                       pfx2, (long) src->pid, (unsigned long) src->local_rank,
+                       (unsigned long) src->node_rank, src->app_rank);
 
-    /* set the return */
-    *output = tmp4;
+    str = proc_bound(src, use_hwthread_cpus, physical);
+    prte_strbuf_printf(sb, "\n%s        State: %s\tApp_context: %ld\n%s\tBinding: %s",
+                       pfx2, prte_proc_state_to_str(src->state), (long) src->app_idx, pfx2,
+                       (NULL == str) ? "UNBOUND" : str);
+    free(str);
+}
 
-    return;
+void prte_proc_print(char **output, prte_job_t *jdata, prte_proc_t *src)
+{
+    prte_strbuf_t sb = PRTE_STRBUF_STATIC_INIT;
+
+    proc_print(&sb, jdata, src);
+    *output = prte_strbuf_release(&sb);
 }
 
 /*
  * APP CONTEXT
  */
-void prte_app_print(char **output, prte_job_t *jdata, prte_app_context_t *src)
+static void app_print(prte_strbuf_t *sb, prte_app_context_t *src)
 {
-    char *tmp, *tmp2, *tmp3;
+    char *prefix;
     int i, count;
-    PRTE_HIDE_UNUSED_PARAMS(jdata);
 
-    /* set default result */
-    *output = NULL;
-
-    pmix_asprintf(&tmp,
-                  "\nData for app_context: index %lu\tapp: %s\n\tNum procs: %lu\tFirstRank: %s",
-                  (unsigned long) src->idx, (NULL == src->app) ? "NULL" : src->app,
-                  (unsigned long) src->num_procs, PRTE_VPID_PRINT(src->first_rank));
+    prte_strbuf_printf(sb,
+                       "\nData for app_context: index %lu\tapp: %s\n\tNum procs: %lu\tFirstRank: %s",
+                       (unsigned long) src->idx, (NULL == src->app) ? "NULL" : src->app,
+                       (unsigned long) src->num_procs, PRTE_VPID_PRINT(src->first_rank));
 
     count = PMIx_Argv_count(src->argv);
     for (i = 0; i < count; i++) {
-        pmix_asprintf(&tmp2, "%s\n\tArgv[%d]: %s", tmp, i, src->argv[i]);
-        free(tmp);
-        tmp = tmp2;
+        prte_strbuf_printf(sb, "\n\tArgv[%d]: %s", i, src->argv[i]);
     }
 
     count = PMIx_Argv_count(src->env);
     for (i = 0; i < count; i++) {
-        pmix_asprintf(&tmp2, "%s\n\tEnv[%lu]: %s", tmp, (unsigned long) i, src->env[i]);
-        free(tmp);
-        tmp = tmp2;
+        prte_strbuf_printf(sb, "\n\tEnv[%lu]: %s", (unsigned long) i, src->env[i]);
     }
 
-    tmp3 = NULL;
+    prefix = NULL;
     for (i=0; NULL != src->env && NULL != src->env[i]; i++) {
         if (0 == strncmp(src->env[i], "PMIX_PREFIX", strlen("PMIX_PREFIX"))) {
-            tmp3 = src->env[i];
-            tmp3 += strlen("PMIX_PREFIX=");
+            prefix = src->env[i];
+            prefix += strlen("PMIX_PREFIX=");
         }
     }
-    pmix_asprintf(&tmp2, "%s\n\tWorking dir: %s\n\tPMIxPrefix: %s\n\tUsed on node: %s", tmp,
-                  (NULL == src->cwd) ? "NULL" : src->cwd, (NULL == tmp3) ? "NULL" : tmp3,
-                  PRTE_FLAG_TEST(src, PRTE_APP_FLAG_USED_ON_NODE) ? "TRUE" : "FALSE");
-    free(tmp);
-    tmp = tmp2;
+    prte_strbuf_printf(sb, "\n\tWorking dir: %s\n\tPMIxPrefix: %s\n\tUsed on node: %s",
+                       (NULL == src->cwd) ? "NULL" : src->cwd, (NULL == prefix) ? "NULL" : prefix,
+                       PRTE_FLAG_TEST(src, PRTE_APP_FLAG_USED_ON_NODE) ? "TRUE" : "FALSE");
+}
 
-    /* set the return */
-    *output = tmp;
+void prte_app_print(char **output, prte_job_t *jdata, prte_app_context_t *src)
+{
+    prte_strbuf_t sb = PRTE_STRBUF_STATIC_INIT;
+    PRTE_HIDE_UNUSED_PARAMS(jdata);
 
-    return;
+    app_print(&sb, src);
+    *output = prte_strbuf_release(&sb);
 }
 
-
 /* Decide whether to print per-app policy lines instead of a single job-level
  * line. We do so only when the per-app dispatch recorded resolved policies for
  * two or more apps AND those policies are not all identical: that is the case
@@ -618,113 +584,225 @@ static char *job_mapper(prte_job_t *jdata)
     return strdup("N/A");
 }
 
-/* Build one "App N: Mapping/Ranking/Binding policy" line per app for a job
- * that was mapped with per-app policies, joined by newlines and each prefixed
- * with 'indent'. An app that did not record a resolved policy falls back to
- * the job-level value. The mapping component that placed the app is named
+/* The policies an app was actually placed with. An app that did not
+ * record a resolved policy falls back to the job-level value. */
+static void app_policy(prte_job_t *jdata, prte_app_context_t *app,
+                       prte_mapping_policy_t *m, prte_ranking_policy_t *r,
+                       prte_binding_policy_t *b)
+{
+    prte_job_map_t *src = jdata->map;
+    uint16_t u16, *u16ptr;
+
+    u16ptr = &u16;
+    *m = prte_get_attribute(&app->attributes, PRTE_APP_RESOLVED_MAPBY, (void **) &u16ptr, PMIX_UINT16)
+            ? (prte_mapping_policy_t) u16 : src->mapping;
+    u16ptr = &u16;
+    *r = prte_get_attribute(&app->attributes, PRTE_APP_RESOLVED_RANKBY, (void **) &u16ptr, PMIX_UINT16)
+            ? (prte_ranking_policy_t) u16 : src->ranking;
+    u16ptr = &u16;
+    *b = prte_get_attribute(&app->attributes, PRTE_APP_RESOLVED_BINDTO, (void **) &u16ptr, PMIX_UINT16)
+            ? (prte_binding_policy_t) u16 : src->binding;
+}
+
+static char *app_mapper(prte_app_context_t *app)
+{
+    char *mapper = NULL;
+
+    if (!prte_get_attribute(&app->attributes, PRTE_APP_LAST_MAPPER,
+                            (void **) &mapper, PMIX_STRING) || NULL == mapper) {
+        mapper = strdup("N/A");
+    }
+    return mapper;
+}
+
+/* Write one "App N: Mapping/Ranking/Binding policy" line per app for a job
+ * that was mapped with per-app policies, separated by newlines and each
+ * prefixed with 'indent'. The mapping component that placed the app is named
  * too: with each app's own policy deciding which mapper claims it, two apps
  * of one job can be placed by two different components, and the job-level
- * "Last mapper" line can only name one of them. Caller frees the returned
- * string. */
-static char *per_app_policy_lines(prte_job_t *jdata, const char *indent)
+ * "Last mapper" line can only name one of them. */
+static void per_app_policy_lines(prte_strbuf_t *sb, prte_job_t *jdata, const char *indent)
 {
-    prte_job_map_t *src = jdata->map;
     prte_app_context_t *app;
-    char *block, *tmp, *mapper;
+    prte_mapping_policy_t m;
+    prte_ranking_policy_t r;
+    prte_binding_policy_t b;
+    char *mapper;
+    bool first = true;
     int i;
-    uint16_t u16, *u16ptr;
 
-    block = strdup("");
     for (i = 0; i < jdata->apps->size; i++) {
-        prte_mapping_policy_t m;
-        prte_ranking_policy_t r;
-        prte_binding_policy_t b;
-
         app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, i);
         if (NULL == app) {
             continue;
         }
-        u16ptr = &u16;
-        m = prte_get_attribute(&app->attributes, PRTE_APP_RESOLVED_MAPBY, (void **) &u16ptr, PMIX_UINT16)
-                ? (prte_mapping_policy_t) u16 : src->mapping;
-        u16ptr = &u16;
-        r = prte_get_attribute(&app->attributes, PRTE_APP_RESOLVED_RANKBY, (void **) &u16ptr, PMIX_UINT16)
-                ? (prte_ranking_policy_t) u16 : src->ranking;
-        u16ptr = &u16;
-        b = prte_get_attribute(&app->attributes, PRTE_APP_RESOLVED_BINDTO, (void **) &u16ptr, PMIX_UINT16)
-                ? (prte_binding_policy_t) u16 : src->binding;
-        mapper = NULL;
-        if (!prte_get_attribute(&app->attributes, PRTE_APP_LAST_MAPPER,
-                                (void **) &mapper, PMIX_STRING) || NULL == mapper) {
-            mapper = strdup("N/A");
-        }
-        pmix_asprintf(&tmp,
-                      "%s%s%sApp %d: Mapper: %s  Mapping policy: %s  Ranking policy: %s  Binding policy: %s",
-                      block, ('\0' == block[0]) ? "" : "\n", indent, (int) app->idx, mapper,
-                      prte_rmaps_base_print_mapping(m),
-                      prte_rmaps_base_print_ranking(r),
-                      prte_hwloc_base_print_binding(b));
+        app_policy(jdata, app, &m, &r, &b);
+        mapper = app_mapper(app);
+        prte_strbuf_printf(sb,
+                           "%s%sApp %d: Mapper: %s  Mapping policy: %s  Ranking policy: %s  Binding policy: %s",
+                           first ? "" : "\n", indent, (int) app->idx, mapper,
+                           prte_rmaps_base_print_mapping(m),
+                           prte_rmaps_base_print_ranking(r),
+                           prte_hwloc_base_print_binding(b));
         free(mapper);
-        free(block);
-        block = tmp;
+        first = false;
+    }
+}
+
+/* One line of JSON describing the map - the same facts as the text form,
+ * for tools that would otherwise have to scrape it:
+ *
+ *   {"job_map":{"job":...,"offset":...,"total_slots":...,
+ *     "mapping":...,"ranking":...,"binding":...,"cpu_set":...,"ppr":...,
+ *     "cpus_per_rank":...,"cpu_type":...,"per_app_policy":<bool>,
+ *     "apps":[{"app":<idx>,"mapper":...,"mapping":...,"ranking":...,"binding":...}],
+ *     "do_not_launch":<bool>,
+ *     "nodes":[{"name":...,"slots":...,"slots_max":...,"num_procs":...,"daemon":<rank|null>,
+ *       "procs":[{"rank":...,"app":...,"local_rank":...,"node_rank":...,
+ *                 "cpuset":<PU list|null>,"bound":<rendered|null>,"devices":[...]}]}]}}
+ *
+ * Fields the text form shows as "N/A" are null here. Procs are listed in
+ * rank order within their node. */
+static void map_print_json(prte_strbuf_t *sb, prte_job_t *jdata, const char *cpuset,
+                           const char *ppr, int cpus_per_rank, const char *cpu_type)
+{
+    prte_job_map_t *src = jdata->map;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_proc_t **procs, *proc;
+    prte_mapping_policy_t m;
+    prte_ranking_policy_t r;
+    prte_binding_policy_t b;
+    bool use_hwthread_cpus, physical, first;
+    char *str;
+    int i, j, nprocs;
+
+    use_hwthread_cpus = prte_get_attribute(&jdata->attributes, PRTE_JOB_HWT_CPUS, NULL, PMIX_BOOL);
+    physical = prte_get_attribute(&jdata->attributes, PRTE_JOB_REPORT_PHYSICAL_CPUS, NULL, PMIX_BOOL);
+
+    prte_strbuf_append(sb, "{\"job_map\":{\"job\":");
+    prte_strbuf_json_string(sb, jdata->nspace);
+    prte_strbuf_printf(sb, ",\"offset\":%lu,\"total_slots\":%lu,\"mapping\":",
+                       (unsigned long) jdata->offset, (unsigned long) jdata->total_slots_alloc);
+    prte_strbuf_json_string(sb, prte_rmaps_base_print_mapping(src->mapping));
+    prte_strbuf_append(sb, ",\"ranking\":");
+    prte_strbuf_json_string(sb, prte_rmaps_base_print_ranking(src->ranking));
+    prte_strbuf_append(sb, ",\"binding\":");
+    prte_strbuf_json_string(sb, prte_hwloc_base_print_binding(src->binding));
+    prte_strbuf_append(sb, ",\"cpu_set\":");
+    prte_strbuf_json_string(sb, cpuset);
+    prte_strbuf_append(sb, ",\"ppr\":");
+    prte_strbuf_json_string(sb, ppr);
+    if (0 < cpus_per_rank) {
+        prte_strbuf_printf(sb, ",\"cpus_per_rank\":%d", cpus_per_rank);
+    } else {
+        prte_strbuf_append(sb, ",\"cpus_per_rank\":null");
     }
-    return block;
+    prte_strbuf_append(sb, ",\"cpu_type\":");
+    prte_strbuf_json_string(sb, cpu_type);
+    prte_strbuf_printf(sb, ",\"per_app_policy\":%s,\"apps\":[",
+                       job_show_per_app_policy(jdata) ? "true" : "false");
+
+    first = true;
+    for (i = 0; i < jdata->apps->size; i++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, i);
+        if (NULL == app) {
+            continue;
+        }
+        app_policy(jdata, app, &m, &r, &b);
+        str = app_mapper(app);
+        prte_strbuf_printf(sb, "%s{\"app\":%d,\"mapper\":", first ? "" : ",", (int) app->idx);
+        prte_strbuf_json_string(sb, str);
+        prte_strbuf_append(sb, ",\"mapping\":");
+        prte_strbuf_json_string(sb, prte_rmaps_base_print_mapping(m));
+        prte_strbuf_append(sb, ",\"ranking\":");
+        prte_strbuf_json_string(sb, prte_rmaps_base_print_ranking(r));
+        prte_strbuf_append(sb, ",\"binding\":");
+        prte_strbuf_json_string(sb, prte_hwloc_base_print_binding(b));
+        prte_strbuf_append(sb, "}");
+        free(str);
+        first = false;
+    }
+    prte_strbuf_printf(sb, "],\"do_not_launch\":%s,\"nodes\":[",
+                       prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)
+                           ? "true" : "false");
+
+    first = true;
+    for (i = 0; i < src->nodes->size; i++) {
+        if (NULL == (node = (prte_node_t *) pmix_pointer_array_get_item(src->nodes, i))) {
+            continue;
+        }
+        prte_strbuf_append(sb, first ? "{\"name\":" : ",{\"name\":");
+        prte_strbuf_json_string(sb, node->name);
+        prte_strbuf_printf(sb, ",\"slots\":%ld,\"slots_max\":%ld,\"num_procs\":%ld,\"daemon\":",
+                           (long) node->slots, (long) node->slots_max, (long) node->num_procs);
+        if (NULL == node->daemon) {
+            prte_strbuf_append(sb, "null");
+        } else {
+            prte_strbuf_printf(sb, "%lu", (unsigned long) node->daemon->name.rank);
+        }
+        prte_strbuf_append(sb, ",\"procs\":[");
+        procs = node_job_procs(jdata, node, &nprocs);
+        for (j = 0; j < nprocs; j++) {
+            proc = procs[j];
+            prte_strbuf_printf(sb, "%s{\"rank\":%lu,\"app\":%ld,\"local_rank\":%lu,\"node_rank\":%lu,\"cpuset\":",
+                               (0 == j) ? "" : ",", (unsigned long) proc->name.rank,
+                               (long) proc->app_idx, (unsigned long) proc->local_rank,
+                               (unsigned long) proc->node_rank);
+            prte_strbuf_json_string(sb, proc->cpuset);
+            prte_strbuf_append(sb, ",\"bound\":");
+            str = proc_bound(proc, use_hwthread_cpus, physical);
+            prte_strbuf_json_string(sb, str);
+            free(str);
+            prte_strbuf_append(sb, ",\"devices\":[");
+            proc_devices(sb, proc, "", true);
+            prte_strbuf_append(sb, "]}");
+        }
+        free(procs);
+        prte_strbuf_append(sb, "]}");
+        first = false;
+    }
+    prte_strbuf_append(sb, "]}}\n");
 }
 
 /*
  * JOB_MAP
  */
-void prte_map_print(char **output, prte_job_t *jdata)
+static void map_print(prte_strbuf_t *sb, prte_job_t *jdata)
 {
-    char *tmp = NULL, *tmp2 = NULL, *tmp3 = NULL, *tmp4 = NULL;
-    char *tmp_node = NULL;
     int32_t i;
     prte_node_t *node;
     prte_job_map_t *src = jdata->map;
     uint16_t u16, *u16ptr = &u16;
+    int cpr = 0;
     char *ppr, *cpus_per_rank, *cpu_type, *cpuset = NULL, *mapper;
 
-    /* set default result */
-    *output = NULL;
-
-
-    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT, NULL, PMIX_BOOL)) {
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT, NULL, PMIX_BOOL) &&
+        !prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_JSON_OUTPUT, NULL, PMIX_BOOL)) {
         /* creating the output in an XML format */
-        pmix_asprintf(&tmp4, "<?xml version=\"1.0\" ?>\n<map>\n");
-        tmp = (char*)malloc(1);
-        tmp[0] = '\0';
+        prte_strbuf_append(sb, "<?xml version=\"1.0\" ?>\n<map>\n");
 
         /* loop through nodes */
         for (i = 0; i < src->nodes->size; i++) {
             if (NULL == (node = (prte_node_t*)pmix_pointer_array_get_item(src->nodes, i))) {
                 continue;
             }
-            prte_node_print(&tmp_node, jdata, node);
-            pmix_asprintf(&tmp3, "%s%s",tmp,tmp_node);
-            free(tmp_node);
-            tmp_node = NULL;
-            free(tmp);
-            tmp = tmp3;
+            node_print(sb, jdata, node);
         }
 
         if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
-            pmix_asprintf(&tmp2, "%s<!-- \n"
+            prte_strbuf_append(sb, "<!-- \n"
                 "\tWarning: This map has been generated with the DONOTLAUNCH option;\n"
                 "\tThe compute node architecture has not been probed, and the displayed\n"
                 "\tmap reflects the HEADNODE ARCHITECTURE. On systems with a different\n"
                 "\tarchitecture between headnode and compute nodes, the map can be\n"
                 "\tdisplayed using prterun's display `map /bin/true`, which will launch\n"
                 "\tenough of the DVM to probe the compute node architecture.\n"
-                " -->\n", tmp);
-            free(tmp);
-            tmp = tmp2;
+                " -->\n");
         }
 
         /* end of the xml "map" tag */
-        pmix_asprintf(&tmp2, "%s%s</map>\n", tmp4,tmp);
-        *output = tmp2;
-        free(tmp);
-        free(tmp4);
+        prte_strbuf_append(sb, "</map>\n");
         return;
     }
 
@@ -736,6 +814,7 @@ void prte_map_print(char **output, prte_job_t *jdata)
 
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_PES_PER_PROC, (void **) &u16ptr,
                            PMIX_UINT16)) {
+        cpr = u16;
         pmix_asprintf(&cpus_per_rank, "%d", (int) u16);
     } else {
         cpus_per_rank = strdup("N/A");
@@ -758,23 +837,30 @@ void prte_map_print(char **output, prte_job_t *jdata)
         cpuset = strdup("N/A");
     }
 
+    if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_JSON_OUTPUT, NULL, PMIX_BOOL)) {
+        map_print_json(sb, jdata, (0 == strcmp(cpuset, "N/A")) ? NULL : cpuset,
+                       (0 == strcmp(ppr, "N/A")) ? NULL : ppr, cpr, cpu_type);
+        free(ppr);
+        free(cpus_per_rank);
+        free(cpuset);
+        return;
+    }
+
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DISPLAY_DEVEL_MAP, NULL, PMIX_BOOL)) {
         if (job_show_per_app_policy(jdata)) {
-            char *plines = per_app_policy_lines(jdata, "");
-            pmix_asprintf(
-                &tmp,
+            prte_strbuf_printf(sb,
                 "\n=================================   JOB MAP   =================================\n"
-                "Data for JOB %s offset %s Total slots allocated %lu\n"
-                "%s\n"
-                "Cpu set: %s  PPR: %s  Cpus-per-rank: %s  Cpu Type: %s",
+                "Data for JOB %s offset %s Total slots allocated %lu\n",
                 PRTE_JOBID_PRINT(jdata->nspace), PRTE_VPID_PRINT(jdata->offset),
-                (long unsigned) jdata->total_slots_alloc,
-                plines, cpuset, ppr, cpus_per_rank, cpu_type);
-            free(plines);
+                (long unsigned) jdata->total_slots_alloc);
+            per_app_policy_lines(sb, jdata, "");
+            prte_strbuf_printf(sb,
+                "\n"
+                "Cpu set: %s  PPR: %s  Cpus-per-rank: %s  Cpu Type: %s",
+                cpuset, ppr, cpus_per_rank, cpu_type);
         } else {
             mapper = job_mapper(jdata);
-            pmix_asprintf(
-                &tmp,
+            prte_strbuf_printf(sb,
                 "\n=================================   JOB MAP   =================================\n"
                 "Data for JOB %s offset %s Total slots allocated %lu\n"
                 "Mapper: %s  Mapping policy: %s  Ranking policy: %s\n"
@@ -789,42 +875,40 @@ void prte_map_print(char **output, prte_job_t *jdata)
         }
 
         if (PMIX_RANK_INVALID == src->daemon_vpid_start) {
-            pmix_asprintf(
-                &tmp2, "%s\nNum new daemons: %ld\tNew daemon starting vpid INVALID\nNum nodes: %ld",
-                tmp, (long) src->num_new_daemons, (long) src->num_nodes);
+            prte_strbuf_printf(sb,
+                "\nNum new daemons: %ld\tNew daemon starting vpid INVALID\nNum nodes: %ld",
+                (long) src->num_new_daemons, (long) src->num_nodes);
         } else {
-            pmix_asprintf(&tmp2,
-                          "%s\nNum new daemons: %ld\tNew daemon starting vpid %ld\nNum nodes: %ld",
-                          tmp, (long) src->num_new_daemons, (long) src->daemon_vpid_start,
-                          (long) src->num_nodes);
+            prte_strbuf_printf(sb,
+                               "\nNum new daemons: %ld\tNew daemon starting vpid %ld\nNum nodes: %ld",
+                               (long) src->num_new_daemons, (long) src->daemon_vpid_start,
+                               (long) src->num_nodes);
         }
-        free(tmp);
-        tmp = tmp2;
     } else if (job_show_per_app_policy(jdata)) {
         /* per-app (MPMD) job: show a policy line for each app */
-        char *plines = per_app_policy_lines(jdata, "    ");
-        pmix_asprintf(&tmp,
-                      "\n========================   JOB MAP   ========================\n"
-                      "Data for JOB %s offset %s Total slots allocated %lu\n"
-                      "%s\n"
-                      "    Cpu set: %s  PPR: %s  Cpus-per-rank: %s  Cpu Type: %s\n",
-                      PRTE_JOBID_PRINT(jdata->nspace), PRTE_VPID_PRINT(jdata->offset),
-                      (long unsigned) jdata->total_slots_alloc, plines,
-                      cpuset, ppr, cpus_per_rank, cpu_type);
-        free(plines);
+        prte_strbuf_printf(sb,
+                           "\n========================   JOB MAP   ========================\n"
+                           "Data for JOB %s offset %s Total slots allocated %lu\n",
+                           PRTE_JOBID_PRINT(jdata->nspace), PRTE_VPID_PRINT(jdata->offset),
+                           (long unsigned) jdata->total_slots_alloc);
+        per_app_policy_lines(sb, jdata, "    ");
+        prte_strbuf_printf(sb,
+                           "\n"
+                           "    Cpu set: %s  PPR: %s  Cpus-per-rank: %s  Cpu Type: %s\n",
+                           cpuset, ppr, cpus_per_rank, cpu_type);
     } else {
         /* this is being printed for a user, so let's make it easier to see */
-        pmix_asprintf(&tmp,
-                      "\n========================   JOB MAP   ========================\n"
-                      "Data for JOB %s offset %s Total slots allocated %lu\n"
-                      "    Mapping policy: %s  Ranking policy: %s Binding policy: %s\n"
-                      "    Cpu set: %s  PPR: %s  Cpus-per-rank: %s  Cpu Type: %s\n",
-                      PRTE_JOBID_PRINT(jdata->nspace), PRTE_VPID_PRINT(jdata->offset),
-                      (long unsigned) jdata->total_slots_alloc,
-                      prte_rmaps_base_print_mapping(src->mapping),
-                      prte_rmaps_base_print_ranking(src->ranking),
-                      prte_hwloc_base_print_binding(src->binding), cpuset, ppr, cpus_per_rank,
-                      cpu_type);
+        prte_strbuf_printf(sb,
+                           "\n========================   JOB MAP   ========================\n"
+                           "Data for JOB %s offset %s Total slots allocated %lu\n"
+                           "    Mapping policy: %s  Ranking policy: %s Binding policy: %s\n"
+                           "    Cpu set: %s  PPR: %s  Cpus-per-rank: %s  Cpu Type: %s\n",
+                           PRTE_JOBID_PRINT(jdata->nspace), PRTE_VPID_PRINT(jdata->offset),
+                           (long unsigned) jdata->total_slots_alloc,
+                           prte_rmaps_base_print_mapping(src->mapping),
+                           prte_rmaps_base_print_ranking(src->ranking),
+                           prte_hwloc_base_print_binding(src->binding), cpuset, ppr, cpus_per_rank,
+                           cpu_type);
     }
     free(ppr);
     free(cpus_per_rank);
@@ -834,33 +918,28 @@ void prte_map_print(char **output, prte_job_t *jdata)
         if (NULL == (node = (prte_node_t *) pmix_pointer_array_get_item(src->nodes, i))) {
             continue;
         }
-        prte_node_print(&tmp2, jdata, node);
-        pmix_asprintf(&tmp3, "%s\n%s", tmp, tmp2);
-        free(tmp);
-        free(tmp2);
-        tmp = tmp3;
+        prte_strbuf_append(sb, "\n");
+        node_print(sb, jdata, node);
     }
 
     /* put some warning out for the donotlaunch case */
     if (prte_get_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
-        pmix_asprintf(&tmp2, "%s\n\nWarning: This map has been generated with the DONOTLAUNCH option;\n"
-                             "\tThe compute node architecture has not been probed, and the displayed\n"
-                             "\tmap reflects the HEADNODE ARCHITECTURE. On systems with a different\n"
-                             "\tarchitecture between headnode and compute nodes, the map can be\n"
-                             "\tdisplayed using `prte --display map /bin/true`, which will launch\n"
-                             "\tenough of the DVM to probe the compute node architecture.", tmp);
-        free(tmp);
-        tmp = tmp2;
+        prte_strbuf_append(sb, "\n\nWarning: This map has been generated with the DONOTLAUNCH option;\n"
+                               "\tThe compute node architecture has not been probed, and the displayed\n"
+                               "\tmap reflects the HEADNODE ARCHITECTURE. On systems with a different\n"
+                               "\tarchitecture between headnode and compute nodes, the map can be\n"
+                               "\tdisplayed using `prte --display map /bin/true`, which will launch\n"
+                               "\tenough of the DVM to probe the compute node architecture.");
     }
 
     /* let's make it easier to see */
-    pmix_asprintf(&tmp2, "%s\n\n=============================================================\n",
-                  tmp);
-    free(tmp);
-    tmp = tmp2;
+    prte_strbuf_append(sb, "\n\n=============================================================\n");
+}
 
-    /* set the return */
-    *output = tmp;
+void prte_map_print(char **output, prte_job_t *jdata)
+{
+    prte_strbuf_t sb = PRTE_STRBUF_STATIC_INIT;
 
-    return;
+    map_print(&sb, jdata);
+    *output = prte_strbuf_release(&sb);
 }
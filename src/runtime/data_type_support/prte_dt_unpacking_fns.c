@@ -33,6 +33,7 @@
 #include "src/util/pmix_argv.h"
 
 #include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_launch_template.h"
 
 /*
  * JOB
@@ -85,6 +86,83 @@ static int unpack_map(pmix_data_buffer_t *bkt, char delim, char ***list)
     return PRTE_SUCCESS;
 }
 
+/* Decode a column written by pack_column() into the "n" values the caller
+ * expects - a buffer that claims more or fewer is refused, not trusted. */
+static int unpack_column(pmix_data_buffer_t *bkt, uint32_t *col, uint32_t n, bool delta)
+{
+    uint32_t *vals = NULL, *lens, npairs, i, k, m = 0;
+    uint8_t form;
+    int32_t cnt = 1;
+    pmix_status_t rc;
+
+    if (0 == n) {
+        return PRTE_SUCCESS;
+    }
+    rc = PMIx_Data_unpack(NULL, bkt, &form, &cnt, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (PRTE_COLUMN_PLAIN == form) {
+        cnt = (int32_t) n;
+        rc = PMIx_Data_unpack(NULL, bkt, col, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+    } else if (PRTE_COLUMN_RUNS == form) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, bkt, &npairs, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+        if (0 == npairs || n < npairs) {
+            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+            return PRTE_ERR_BAD_PARAM;
+        }
+        vals = (uint32_t *) malloc(2 * npairs * sizeof(uint32_t));
+        if (NULL == vals) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+        lens = vals + npairs;
+        cnt = (int32_t) npairs;
+        rc = PMIx_Data_unpack(NULL, bkt, vals, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS == rc) {
+            cnt = (int32_t) npairs;
+            rc = PMIx_Data_unpack(NULL, bkt, lens, &cnt, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS != rc) {
+            free(vals);
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+        for (i = 0; i < npairs; i++) {
+            if (n - m < lens[i]) {
+                break;
+            }
+            for (k = 0; k < lens[i]; k++) {
+                col[m++] = vals[i];
+            }
+        }
+        free(vals);
+        if (m != n) {
+            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+            return PRTE_ERR_BAD_PARAM;
+        }
+    } else {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return PRTE_ERR_BAD_PARAM;
+    }
+    if (delta) {
+        for (i = 1; i < n; i++) {
+            col[i] += col[i - 1];
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
 /* Get (creating if need be) the proc holding a given rank of this job. */
 static prte_proc_t *get_proc(prte_job_t *jptr, pmix_rank_t rank)
 {
@@ -113,11 +191,12 @@ static int unpack_layout(pmix_data_buffer_t *bkt, prte_job_t *jptr,
                          bool devices, prte_job_pack_mode_t mode)
 {
     int32_t nnodes, n, cnt = 1;
-    int rc, a, i, j;
-    char **nodenames = NULL, **fields = NULL, **ranks = NULL;
+    int rc, a, k;
+    uint32_t *runs[4] = {NULL, NULL, NULL, NULL}, nruns, i, m, *col = NULL;
+    char **nodenames = NULL, **cpusets = NULL;
     prte_node_t **nodes = NULL, *nd;
     prte_local_rank_t *lranks = NULL;
-    pmix_rank_t *applist = NULL;
+    pmix_rank_t *applist = NULL, rank, j;
     size_t napp;
     prte_proc_t *proc;
     prte_app_context_t *app;
@@ -147,7 +226,8 @@ static int unpack_layout(pmix_data_buffer_t *bkt, prte_job_t *jptr,
      * before any of this arrived */
     nodes = (prte_node_t **) calloc(nnodes, sizeof(prte_node_t *));
     lranks = (prte_local_rank_t *) calloc(nnodes, sizeof(prte_local_rank_t));
-    if (NULL == nodes || NULL == lranks) {
+    applist = (pmix_rank_t *) calloc(jptr->num_procs, sizeof(pmix_rank_t));
+    if (NULL == nodes || NULL == lranks || NULL == applist) {
         PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
         rc = PRTE_ERR_OUT_OF_RESOURCE;
         goto cleanup;
@@ -168,30 +248,48 @@ static int unpack_layout(pmix_data_buffer_t *bkt, prte_job_t *jptr,
         if (NULL == app) {
             continue;
         }
-        rc = unpack_map(bkt, ';', &fields);
-        if (PRTE_SUCCESS != rc) {
+        cnt = 1;
+        prc = PMIx_Data_unpack(NULL, bkt, &nruns, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != prc) {
+            PMIX_ERROR_LOG(prc);
+            rc = prte_pmix_convert_status(prc);
             goto cleanup;
         }
-        if (nnodes != PMIx_Argv_count(fields)) {
+        if (jptr->num_procs < nruns) {
             PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
             rc = PRTE_ERR_BAD_PARAM;
             goto cleanup;
         }
-        napp = 0;
-        applist = (pmix_rank_t *) calloc(jptr->num_procs, sizeof(pmix_rank_t));
-        if (NULL == applist) {
-            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
-            rc = PRTE_ERR_OUT_OF_RESOURCE;
-            goto cleanup;
+        /* runs[0] node index, runs[1] first rank, runs[2] stride,
+         * runs[3] length - see pack_proc_runs */
+        for (k = 0; k < 4 && 0 < nruns; k++) {
+            runs[k] = (uint32_t *) malloc(nruns * sizeof(uint32_t));
+            if (NULL == runs[k]) {
+                PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+                rc = PRTE_ERR_OUT_OF_RESOURCE;
+                goto cleanup;
+            }
+            rc = unpack_column(bkt, runs[k], nruns, k < 2);
+            if (PRTE_SUCCESS != rc) {
+                goto cleanup;
+            }
         }
-        for (n = 0; n < nnodes; n++) {
-            if (0 == strcmp(fields[n], "-")) {
-                continue;
+        napp = 0;
+        for (i = 0; i < nruns; i++) {
+            if ((uint32_t) nnodes <= runs[0][i]) {
+                PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+                rc = PRTE_ERR_BAD_PARAM;
+                goto cleanup;
+            }
+            nd = nodes[runs[0][i]];
+            if (NULL == nd->daemon) {
+                PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+                rc = PRTE_ERR_NOT_FOUND;
+                goto cleanup;
             }
-            ranks = PMIx_Argv_split(fields[n], ',');
-            for (i = 0; NULL != ranks && NULL != ranks[i]; i++) {
-                pmix_rank_t rank = (pmix_rank_t) strtoul(ranks[i], NULL, 10);
-                if (jptr->num_procs <= rank) {
+            for (m = 0; m < runs[3][i]; m++) {
+                rank = runs[1][i] + m * runs[2][i];
+                if (jptr->num_procs <= rank || jptr->num_procs <= napp) {
                     PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
                     rc = PRTE_ERR_BAD_PARAM;
                     goto cleanup;
@@ -203,27 +301,21 @@ static int unpack_layout(pmix_data_buffer_t *bkt, prte_job_t *jptr,
                     goto cleanup;
                 }
                 proc->app_idx = app->idx;
-                nd = nodes[n];
-                if (NULL == nd->daemon) {
-                    PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
-                    rc = PRTE_ERR_NOT_FOUND;
-                    goto cleanup;
-                }
                 proc->parent = nd->daemon->name.rank;
                 /* apps outermost, node->procs order within: the same walk
                  * compute_local_rank() makes */
-                proc->local_rank = lranks[n]++;
+                proc->local_rank = lranks[runs[0][i]]++;
                 applist[napp++] = rank;
             }
-            PMIx_Argv_free(ranks);
-            ranks = NULL;
         }
-        PMIx_Argv_free(fields);
-        fields = NULL;
+        for (k = 0; k < 4; k++) {
+            free(runs[k]);
+            runs[k] = NULL;
+        }
         /* app ranks are assigned in ascending rank order */
         if (0 < napp) {
             qsort(applist, napp, sizeof(pmix_rank_t), rank_cmp);
-            for (i = 0; (size_t) i < napp; i++) {
+            for (i = 0; i < napp; i++) {
                 proc = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs,
                                                                    (int) applist[i]);
                 if (NULL != proc) {
@@ -231,19 +323,68 @@ static int unpack_layout(pmix_data_buffer_t *bkt, prte_job_t *jptr,
                 }
             }
         }
-        free(applist);
-        applist = NULL;
     }
 
-    /* and now what the maps could not say, in rank order */
-    for (j = 0; j < (int) jptr->num_procs; j++) {
-        proc = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, j);
-        if (NULL == proc) {
+    /* and now what the maps could not say - a column per field, in rank
+     * order, for which every rank must have been placed above */
+    for (j = 0; j < jptr->num_procs; j++) {
+        if (NULL == pmix_pointer_array_get_item(jptr->procs, (int) j)) {
             PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
             rc = PRTE_ERR_NOT_FOUND;
             goto cleanup;
         }
-        rc = prte_proc_unpack(bkt, proc, devices, mode);
+    }
+    col = (uint32_t *) malloc(jptr->num_procs * sizeof(uint32_t));
+    if (NULL == col) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        rc = PRTE_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    /* node ranks travel as their distance from the local rank */
+    rc = unpack_column(bkt, col, jptr->num_procs, false);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+    for (j = 0; j < jptr->num_procs; j++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, (int) j);
+        proc->node_rank = (prte_node_rank_t) (proc->local_rank + col[j]);
+    }
+    rc = unpack_column(bkt, col, jptr->num_procs, false);
+    if (PRTE_SUCCESS != rc) {
+        goto cleanup;
+    }
+    for (j = 0; j < jptr->num_procs; j++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, (int) j);
+        proc->state = col[j];
+    }
+
+    /* The cpusets, if this buffer is carrying them.  When it is not, each
+     * proc keeps the NULL its constructor gave it and the daemon that forks
+     * it fills it in from the slice it is sent. */
+    if (!(PRTE_JOB_PACK_NO_CPUSETS & mode)) {
+        cpusets = (char **) calloc(jptr->num_procs, sizeof(char *));
+        if (NULL == cpusets) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            rc = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        cnt = (int32_t) jptr->num_procs;
+        prc = PMIx_Data_unpack(NULL, bkt, cpusets, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != prc) {
+            PMIX_ERROR_LOG(prc);
+            rc = prte_pmix_convert_status(prc);
+            goto cleanup;
+        }
+        for (j = 0; j < jptr->num_procs; j++) {
+            proc = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, (int) j);
+            proc->cpuset = cpusets[j]; // the proc owns it now
+            cpusets[j] = NULL;
+        }
+    }
+
+    for (j = 0; j < jptr->num_procs; j++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, (int) j);
+        rc = prte_proc_unpack(bkt, proc, devices);
         if (PRTE_SUCCESS != rc) {
             PRTE_ERROR_LOG(rc);
             goto cleanup;
@@ -255,12 +396,16 @@ cleanup:
     if (NULL != nodenames) {
         PMIx_Argv_free(nodenames);
     }
-    if (NULL != fields) {
-        PMIx_Argv_free(fields);
+    for (k = 0; k < 4; k++) {
+        free(runs[k]);
     }
-    if (NULL != ranks) {
-        PMIx_Argv_free(ranks);
+    if (NULL != cpusets) {
+        for (j = 0; j < jptr->num_procs; j++) {
+            free(cpusets[j]);
+        }
+        free(cpusets);
     }
+    free(col);
     if (NULL != nodes) {
         free(nodes);
     }
@@ -416,8 +561,44 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job,
         PMIX_RELEASE(jptr);
         return prte_pmix_convert_status(rc);
     }
-    /* if there are apps, unpack them */
-    if (0 < jptr->num_apps) {
+    if (PRTE_JOB_PACK_NO_APPS & md) {
+        /* they are in a template we were sent before - the launch path
+         * makes sure we hold it before it gets here */
+        uint32_t id;
+        prte_launch_template_t *tmpl;
+        prte_job_t *held;
+        pmix_byte_object_t bo;
+        n = 1;
+        rc = PMIx_Data_unpack(NULL, bkt, &id, &n, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(jptr);
+            return prte_pmix_convert_status(rc);
+        }
+        tmpl = prte_launch_template_lookup(id);
+        if (NULL != tmpl) {
+            rc = prte_launch_template_unpack_apps(&tmpl->apps, jptr->num_apps, jptr);
+        } else if (PRTE_PROC_IS_MASTER
+                   && NULL != (held = prte_get_job_data_object(jptr->nspace))) {
+            /* the master reads its own copy of a launch asynchronously, so
+             * the next launch in the session may have replaced the template
+             * by now - take the apps from the job it holds instead, and
+             * leave the session's current template alone */
+            rc = prte_launch_template_pack_apps(held, &bo);
+            if (PRTE_SUCCESS == rc) {
+                rc = prte_launch_template_unpack_apps(&bo, jptr->num_apps, jptr);
+                PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            }
+        } else {
+            rc = PRTE_ERR_NOT_FOUND;
+        }
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_RELEASE(jptr);
+            return rc;
+        }
+    } else if (0 < jptr->num_apps) {
+        /* if there are apps, unpack them */
         prte_app_context_t *app;
         for (j = 0; j < jptr->num_apps; j++) {
             n = 1;
@@ -636,50 +817,20 @@ int prte_node_unpack(pmix_data_buffer_t *bkt, prte_node_t **nd)
 /*
  * PROC
  */
-int prte_proc_unpack(pmix_data_buffer_t *bkt, prte_proc_t *proc, bool devices,
-                     prte_job_pack_mode_t mode)
+int prte_proc_unpack(pmix_data_buffer_t *bkt, prte_proc_t *proc, bool devices)
 {
     pmix_status_t rc;
     int32_t n;
 
-    /* Everything the job's maps already say has been set on this proc by
-     * prte_job_unpack before we are called - its rank, its hosting daemon,
-     * its app, its app rank and its local rank.  What follows is only what
-     * the maps cannot say.  The proc belongs to the job, not to us: an
-     * error here leaves it for prte_job_unpack to release along with
-     * everything else it built. */
-
-    /* unpack the node rank */
-    n = 1;
-    rc = PMIx_Data_unpack(NULL, bkt, &proc->node_rank, &n, PMIX_UINT16);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
-    }
-
-    /* unpack the state */
-    n = 1;
-    rc = PMIx_Data_unpack(NULL, bkt, &proc->state, &n, PMIX_UINT32);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return prte_pmix_convert_status(rc);
-    }
-
-    /* The cpuset, if this buffer is carrying it.  When it is not, the proc
-     * keeps the NULL its constructor gave it and the daemon that forks it
-     * fills it in from the slice it is sent - see prte_proc_pack. */
-    if (PRTE_JOB_PACK_NO_CPUSETS != mode) {
-        n = 1;
-        rc = PMIx_Data_unpack(NULL, bkt, &proc->cpuset, &n, PMIX_STRING);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return prte_pmix_convert_status(rc);
-        }
-    }
+    /* Everything the job's maps and columns already say has been set on
+     * this proc by prte_job_unpack before we are called.  What follows is
+     * only the remainder prte_proc_pack wrote.  The proc belongs to the job,
+     * not to us: an error here leaves it for prte_job_unpack to release
+     * along with everything else it built. */
 
     /* The device this proc was mapped against, present only for a job that
-     * was mapped by device - the same condition prte_proc_pack tests, read
-     * from the job's mapping policy, which arrived before this. */
+     * was mapped by device - the same condition prte_proc_pack tests, which
+     * arrived at the head of the job. */
     if (devices) {
         pmix_data_array_t *darray;
         uint16_t ndevs = 0;
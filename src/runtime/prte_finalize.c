@@ -44,12 +44,15 @@
 #include "src/mca/ess/ess.h"
 #include "src/mca/ras/base/base.h"
 #include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_launch_template.h"
 #include "src/runtime/prte_locks.h"
 #include "src/runtime/prte_progress_threads.h"
 #include "src/runtime/prte_worker_pool.h"
 #include "src/runtime/runtime.h"
 #include "src/util/name_fns.h"
 #include "src/util/proc_info.h"
+#include "src/util/prte_compress.h"
+#include "src/util/prte_profile.h"
 #include "src/util/session_dir.h"
 
 int prte_finalize(void)
@@ -242,6 +245,15 @@ int prte_finalize(void)
     /* Close the general debug stream */
     pmix_output_close(prte_debug_output);
 
+    /* ...and the stage report, if one was being written */
+    prte_profile_finalize();
+
+    /* the compression contexts and dictionary */
+    prte_compress_finalize();
+
+    /* the launch templates this process was holding */
+    prte_launch_template_finalize();
+
     pmix_mca_base_alias_cleanup();
 
     prte_proc_info_finalize();
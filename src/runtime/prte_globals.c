@@ -984,6 +984,8 @@ static void prte_job_map_construct(prte_job_map_t *map)
     map->nodes = PMIX_NEW(pmix_pointer_array_t);
     pmix_pointer_array_init(map->nodes, PRTE_GLOBAL_ARRAY_BLOCK_SIZE, PRTE_GLOBAL_ARRAY_MAX_SIZE,
                             PRTE_GLOBAL_ARRAY_BLOCK_SIZE);
+    map->daemons = NULL;
+    map->daemons_nnodes = 0;
 }
 
 static void prte_job_map_destruct(prte_job_map_t *map)
@@ -998,6 +1000,7 @@ static void prte_job_map_destruct(prte_job_map_t *map)
         }
     }
     PMIX_RELEASE(map->nodes);
+    prte_job_map_daemons_stale(map);
 }
 
 PMIX_CLASS_INSTANCE(prte_job_map_t, pmix_object_t,
@@ -148,6 +148,20 @@ PRTE_EXPORT extern int prte_exit_status;
  * --host syntax. */
 #define PRTE_ACTIVATE_HOSTS "prte.activate.hosts"
 
+/* Spawn directive asking for the --display map and allocation reports as
+ * JSON rather than text or XML.  PMIx defines only the "parseable" flag,
+ * which this runtime has always answered with XML, so the JSON form is
+ * requested with a key of our own.  The value is a bool. */
+#define PRTE_DISPLAY_JSON_OUTPUT "prte.display.json"
+
+/* Spawn directive asking that each pmix_app_t in the request be started
+ * as a job of its own rather than as one MPMD job.  The job-level info
+ * applies to every one of them.  The jobs are allocated, mapped and
+ * launched together - the daemons see one launch message for the whole
+ * batch - but each gets its own nspace and its own termination event.
+ * The value is a bool. */
+#define PRTE_SPAWN_BATCH "prte.spawn.batch"
+
 /* State Machine lists */
 PRTE_EXPORT extern pmix_list_t prte_job_states;
 PRTE_EXPORT extern pmix_list_t prte_proc_states;
@@ -606,13 +620,23 @@ PRTE_EXPORT int prte_set_job_data_object(prte_job_t *jdata);
  * point (prte_odls_base_send_cpuset_slices). Every other caller packs
  * everything.
  *
+ * A repeat launch in a persistent DVM can also leave out the app contexts,
+ * naming instead the launch template every daemon already holds them in
+ * (src/runtime/prte_launch_template.h).
+ *
  * The mode is packed at the head of the buffer so the decoder reads what
  * is there rather than being told out of band; prte_job_unpack hands it
- * back so the caller can tell "not sent" from "not bound".
+ * back so the caller can tell "not sent" from "not bound".  The modes are
+ * bits, and combine.
  */
 typedef uint8_t prte_job_pack_mode_t;
-#define PRTE_JOB_PACK_ALL        0 // everything, including each proc's cpuset
-#define PRTE_JOB_PACK_NO_CPUSETS 1 // cpusets are being scattered separately
+#define PRTE_JOB_PACK_ALL        0x00 // everything, including each proc's cpuset
+#define PRTE_JOB_PACK_NO_CPUSETS 0x01 // cpusets are being scattered separately
+#define PRTE_JOB_PACK_NO_APPS    0x02 // apps are in the PRTE_JOB_LAUNCH_TEMPLATE template
+
+/* the two forms a per-proc column takes inside a packed job */
+#define PRTE_COLUMN_PLAIN 0 // every value, in order
+#define PRTE_COLUMN_RUNS  1 // (value, run length) pairs
 
 /** Pack/unpack a job object. "mode" may be NULL on the unpack if the
  * caller does not care which shape arrived. */
@@ -629,16 +653,18 @@ PRTE_EXPORT int prte_app_unpack(pmix_data_buffer_t *bkt, prte_app_context_t **ap
 PRTE_EXPORT int prte_app_copy(prte_app_context_t **dest, prte_app_context_t *src);
 PRTE_EXPORT void prte_app_print(char **output, prte_job_t *jdata, prte_app_context_t *src);
 
-/** Pack/unpack a proc*/
+/** Pack/unpack what of a proc prte_job_pack does not carry as a column
+ * across the whole job - see there.  Only ever called from within a job's
+ * pack and unpack. */
 /* "devices" says whether this job's procs carry a device assignment.  It is
  * a parameter rather than something read back off the job because the job's
  * map is packed AFTER the proc array - so a decoder reading a proc has not
  * yet seen the mapping policy, and deriving the answer there would skip a
  * field the packer wrote and desynchronize the rest of the buffer. */
 PRTE_EXPORT int prte_proc_pack(pmix_data_buffer_t *bkt, prte_proc_t *proc,
-                               bool devices, prte_job_pack_mode_t mode);
+                               bool devices);
 PRTE_EXPORT int prte_proc_unpack(pmix_data_buffer_t *bkt, prte_proc_t *proc,
-                                 bool devices, prte_job_pack_mode_t mode);
+                                 bool devices);
 PRTE_EXPORT int prte_proc_copy(prte_proc_t **dest, prte_proc_t *src);
 PRTE_EXPORT void prte_proc_print(char **output, prte_job_t *jdata, prte_proc_t *src);
 
@@ -53,6 +53,7 @@
 #include "src/util/pmix_os_path.h"
 #include "src/util/proc_info.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/prte_profile.h"
 #include "src/util/prte_show_help.h"
 #include "src/util/stacktrace.h"
 #include "src/util/sys_limits.h"
@@ -380,6 +381,7 @@ int prte_init_util(prte_proc_type_t flags)
         return PRTE_SUCCESS;
     }
     util_initialized = true;
+    prte_profile_startup_begin();
 
     ret = prte_init_minimum();
     if (PRTE_SUCCESS != ret) {
@@ -416,6 +418,7 @@ int prte_init_util(prte_proc_type_t flags)
         error = "prte_backtrace_base_open";
         goto error;
     }
+    prte_profile_startup_phase("util");
 
     return PRTE_SUCCESS;
 
@@ -444,6 +447,9 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
     if (PRTE_SUCCESS != ret) {
         return ret;
     }
+    /* whatever the caller did between prte_init_util and here - command
+     * line parsing, for the most part */
+    prte_profile_startup_phase("pre_init");
 
     /*
      * Initialize the event library
@@ -464,6 +470,7 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
         error = "prte_proc_info";
         goto error;
     }
+    prte_profile_startup_phase("proc_info");
 
     if (PRTE_SUCCESS != (ret = prte_hwloc_base_register())) {
         error = "prte_hwloc_base_register";
@@ -479,6 +486,7 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
         error = "prte_hwloc_base_open";
         goto error;
     }
+    prte_profile_startup_phase("hwloc_open");
 
     /* setup the global job and node arrays */
     prte_job_data = PMIX_NEW(pmix_pointer_array_t);
@@ -545,6 +553,7 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
         error = "prte_schizo_base_select";
         goto error;
     }
+    prte_profile_startup_phase("schizo");
 
     /* open the ESS and select the correct module for this environment */
     ret = pmix_mca_base_framework_open(&prte_ess_base_framework,
@@ -559,6 +568,7 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
         error = "prte_ess_base_select";
         goto error;
     }
+    prte_profile_startup_phase("ess_select");
 
     /* Stand up the pool of worker threads.  Only the DVM master and the
      * daemons have anything to put on it - peer sockets and local children -
@@ -573,6 +583,7 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
             error = "prte_worker_pool_init";
             goto error;
         }
+        prte_profile_startup_phase("worker_pool");
     }
 
     /* initialize the RTE for this environment */
@@ -580,6 +591,7 @@ int prte_init(int *pargc, char ***pargv, prte_proc_type_t flags)
         error = "prte_ess_init";
         goto error;
     }
+    prte_profile_startup_phase("ess_init");
 
     /* initialize the cache */
     prte_cache = PMIX_NEW(pmix_pointer_array_t);
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/class/pmix_list.h"
+#include "src/class/pmix_pointer_array.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/pmix/pmix-internal.h"
+
+#include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_launch_template.h"
+
+static void tcon(prte_launch_template_t *p)
+{
+    p->session = 0;
+    p->id = 0;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->apps);
+    p->epoch = 0;
+    p->ndaemons = 0;
+}
+static void tdes(prte_launch_template_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->apps);
+}
+PMIX_CLASS_INSTANCE(prte_launch_template_t, pmix_list_item_t, tcon, tdes);
+
+/* at most one per session, so a short list - and there is no need for
+ * anything cleverer while DVMs run a handful of sessions */
+static pmix_list_t templates = PMIX_LIST_STATIC_INIT;
+/* zero is never issued: the launch message uses it for "no template" */
+static uint32_t next_id = 1;
+
+static prte_launch_template_t *find_session(uint32_t session)
+{
+    prte_launch_template_t *t;
+
+    PMIX_LIST_FOREACH(t, &templates, prte_launch_template_t)
+    {
+        if (t->session == session) {
+            return t;
+        }
+    }
+    return NULL;
+}
+
+int prte_launch_template_pack_apps(prte_job_t *jdata, pmix_byte_object_t *bo)
+{
+    pmix_data_buffer_t buf;
+    prte_app_context_t *app;
+    pmix_status_t rc;
+    int j;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    for (j = 0; j < jdata->apps->size; j++) {
+        app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, j);
+        if (NULL == app) {
+            continue;
+        }
+        rc = prte_app_pack(&buf, app);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&buf);
+            return prte_pmix_convert_status(rc);
+        }
+    }
+    rc = PMIx_Data_unload(&buf, bo);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_launch_template_unpack_apps(const pmix_byte_object_t *bo,
+                                     prte_app_idx_t napps, prte_job_t *jdata)
+{
+    pmix_data_buffer_t buf;
+    prte_app_context_t *app;
+    pmix_status_t rc;
+    prte_app_idx_t j;
+
+    /* embed copies - the template outlives this job and is read again by
+     * the next one */
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = PMIx_Data_embed(&buf, bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        return prte_pmix_convert_status(rc);
+    }
+    for (j = 0; j < napps; j++) {
+        rc = prte_app_unpack(&buf, &app);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&buf);
+            return prte_pmix_convert_status(rc);
+        }
+        pmix_pointer_array_add(jdata->apps, app);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    return PRTE_SUCCESS;
+}
+
+int prte_launch_template_select(prte_job_t *jdata, uint32_t epoch, pmix_rank_t ndaemons,
+                                prte_launch_template_t **tmpl, bool *fresh)
+{
+    prte_launch_template_t *t;
+    pmix_byte_object_t bo;
+    uint32_t session;
+    int rc;
+
+    session = (NULL == jdata->session) ? 0 : jdata->session->session_id;
+
+    /* the apps have to be packed either way, so "is it the same as last
+     * time" is a compare of what we just packed - not a digest that two
+     * different environments could share */
+    rc = prte_launch_template_pack_apps(jdata, &bo);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    t = find_session(session);
+    if (NULL != t && t->epoch == epoch && t->ndaemons == ndaemons
+        && t->apps.size == bo.size
+        && 0 == memcmp(t->apps.bytes, bo.bytes, bo.size)) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        *tmpl = t;
+        *fresh = false;
+        return PRTE_SUCCESS;
+    }
+
+    if (NULL == t) {
+        t = PMIX_NEW(prte_launch_template_t);
+        t->session = session;
+        pmix_list_append(&templates, &t->super);
+    } else {
+        PMIX_BYTE_OBJECT_DESTRUCT(&t->apps);
+    }
+    t->id = next_id++;
+    if (0 == next_id) {
+        next_id = 1;
+    }
+    t->apps = bo; // the template owns the bytes now
+    t->epoch = epoch;
+    t->ndaemons = ndaemons;
+    *tmpl = t;
+    *fresh = true;
+    return PRTE_SUCCESS;
+}
+
+int prte_launch_template_store(uint32_t session, uint32_t id, pmix_byte_object_t *apps)
+{
+    prte_launch_template_t *t;
+
+    t = find_session(session);
+    if (NULL == t) {
+        t = PMIX_NEW(prte_launch_template_t);
+        t->session = session;
+        pmix_list_append(&templates, &t->super);
+    } else {
+        PMIX_BYTE_OBJECT_DESTRUCT(&t->apps);
+    }
+    t->id = id;
+    t->epoch = 0;
+    t->ndaemons = 0;
+    t->apps = *apps;
+    PMIX_BYTE_OBJECT_CONSTRUCT(apps);
+    return PRTE_SUCCESS;
+}
+
+prte_launch_template_t *prte_launch_template_lookup(uint32_t id)
+{
+    prte_launch_template_t *t;
+
+    if (0 == id) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH(t, &templates, prte_launch_template_t)
+    {
+        if (t->id == id) {
+            return t;
+        }
+    }
+    return NULL;
+}
+
+void prte_launch_template_finalize(void)
+{
+    PMIX_LIST_DESTRUCT(&templates);
+    PMIX_CONSTRUCT(&templates, pmix_list_t);
+    next_id = 1;
+}
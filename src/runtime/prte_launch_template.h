@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * Launch templates: the app contexts of a repeat launch, left at the daemons.
+ *
+ * A persistent DVM is often asked to run the same thing over and over - the
+ * same apps, argv and environment, each time under a new nspace.  The app
+ * contexts, the environment above all, are most of a launch message, and
+ * every daemon already holds the copy it was sent the last time.  A template
+ * is that copy, kept by the master and by every daemon under an id the
+ * master assigns, so that a repeat launch can name it instead of sending it
+ * again (PRTE_JOB_PACK_NO_APPS).  Everything else in the launch message -
+ * the node and proc maps, the per-proc records - is particular to the job
+ * and is sent as before.
+ *
+ * The master keeps one template per session: the apps it last launched in
+ * it.  A daemon keeps the last one it was sent for each session.  Neither
+ * side relies on the other still holding one: the master stops naming a
+ * template once the DVM has changed under it, and a daemon that is named a
+ * template it does not have asks the master for it (see
+ * odls_base_default_fns.c).
+ */
+
+#ifndef PRTE_LAUNCH_TEMPLATE_H
+#define PRTE_LAUNCH_TEMPLATE_H
+
+#include "prte_config.h"
+
+#include "src/class/pmix_list.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/runtime/prte_globals.h"
+
+BEGIN_C_DECLS
+
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t session;
+    uint32_t id;
+    /* the job's app contexts, packed one after another by prte_app_pack */
+    pmix_byte_object_t apps;
+    /* master only: the DVM the template was issued to, as its recovery
+     * epoch and its size - a daemon that joined since, or that replaced one
+     * that was lost, never saw it */
+    uint32_t epoch;
+    pmix_rank_t ndaemons;
+} prte_launch_template_t;
+PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_launch_template_t);
+
+/* Pack every app context of the job into "bo", in the form a template
+ * holds them. */
+PRTE_EXPORT int prte_launch_template_pack_apps(prte_job_t *jdata, pmix_byte_object_t *bo);
+
+/* Unpack "napps" app contexts from a template into the job's app array. */
+PRTE_EXPORT int prte_launch_template_unpack_apps(const pmix_byte_object_t *bo,
+                                                 prte_app_idx_t napps, prte_job_t *jdata);
+
+/* Master: the template to launch "jdata" against.  A job whose apps match
+ * the session's current template, issued to the same DVM, gets that one
+ * back with *fresh false - the daemons have it.  Anything else is issued a
+ * new id, replaces the session's template, and comes back with *fresh
+ * true: it has to travel with the launch. */
+PRTE_EXPORT int prte_launch_template_select(prte_job_t *jdata, uint32_t epoch,
+                                            pmix_rank_t ndaemons,
+                                            prte_launch_template_t **tmpl, bool *fresh);
+
+/* Keep a template the master sent, replacing whatever this session held
+ * before.  Takes the byte object's contents.  A template stored this way
+ * is never selected on the master - it has no DVM recorded against it. */
+PRTE_EXPORT int prte_launch_template_store(uint32_t session, uint32_t id,
+                                           pmix_byte_object_t *apps);
+
+/* The template with this id, or NULL if this process does not hold it. */
+PRTE_EXPORT prte_launch_template_t *prte_launch_template_lookup(uint32_t id);
+
+PRTE_EXPORT void prte_launch_template_finalize(void);
+
+END_C_DECLS
+
+#endif /* PRTE_LAUNCH_TEMPLATE_H */
@@ -46,6 +46,8 @@
 #include "src/util/proc_info.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/prte_compress.h"
+#include "src/util/prte_profile.h"
 #include "src/util/prte_show_help.h"
 #include "src/mca/errmgr/errmgr.h"
 
@@ -329,6 +331,64 @@ int prte_register_params(void)
     prte_clean_output = pmix_output_open(&lds);
     PMIX_DESTRUCT(&lds);
 
+    /* stage profiling - see src/util/prte_profile.h */
+    prte_profile_stage_report = NULL;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "stage_report",
+                                      "Report the wall time, heap growth and peak RSS of each "
+                                      "control-plane stage (allocation, mapping, launch message, "
+                                      "nspace registration) as one JSON object per line.  Accepts "
+                                      "stdout, stderr, or a file name to append to (default: none)",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_profile_stage_report);
+    prte_profile_enabled = (NULL != prte_profile_stage_report &&
+                            0 != strcmp(prte_profile_stage_report, "none"));
+    prte_profile_startup_report = NULL;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "startup_report",
+                                      "Gather the time each daemon spends in each startup phase "
+                                      "(topology, session directory, PMIx server, OOB, ...) at "
+                                      "the HNP and report it per daemon plus min/median/max per "
+                                      "phase across the DVM, one JSON object per line.  Accepts "
+                                      "stdout, stderr, or a file name to append to (default: none)",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_profile_startup_report);
+    prte_profile_startup_enabled = (NULL != prte_profile_startup_report &&
+                                    0 != strcmp(prte_profile_startup_report, "none"));
+
+    /* control-plane compression - see src/util/prte_compress.h */
+    prte_compress_codecs = NULL;
+    (void) pmix_mca_base_var_register("prte", "prte", "compress", "codecs",
+                                      "Comma-delimited list of the codecs a broadcast or "
+                                      "topology upload may be compressed with (deflate, lz4, "
+                                      "zstd, zstd_dict), or none.  The cost model picks among "
+                                      "them per message (default: every codec this build has)",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_compress_codecs);
+    prte_compress_link_bandwidth = 1250;
+    (void) pmix_mca_base_var_register("prte", "prte", "compress", "link_bandwidth",
+                                      "Bandwidth of one control-plane link in MB/s, against which "
+                                      "the compression cost model weighs each codec's measured "
+                                      "rate (default: 1250, i.e. 10 Gb/s)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_compress_link_bandwidth);
+    prte_compress_min_size = 4096;
+    (void) pmix_mca_base_var_register("prte", "prte", "compress", "min_size",
+                                      "Payloads smaller than this many bytes are never compressed "
+                                      "(default: 4096)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_compress_min_size);
+    prte_compress_zstd_level = 3;
+    (void) pmix_mca_base_var_register("prte", "prte", "compress", "zstd_level",
+                                      "Compression level for the zstd codecs (default: 3)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_compress_zstd_level);
+    prte_compress_zstd_dict = NULL;
+    (void) pmix_mca_base_var_register("prte", "prte", "compress", "zstd_dict",
+                                      "Path to a zstd dictionary trained on launch messages (e.g., "
+                                      "with \"zstd --train\").  Enables the zstd_dict codec; every "
+                                      "daemon must be given the same file (default: none)",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_compress_zstd_dict);
+
     /* check directive for warning about shared fs on tmpdir */
     (void) pmix_mca_base_var_register("prte", "prte", NULL, "silence_shared_fs",
                                       "Silence the shared file system warning",
@@ -50,7 +50,14 @@
 #ifdef HAVE_SYS_WAIT_H
 #    include <sys/wait.h>
 #endif
+#ifdef HAVE_SYS_RESOURCE_H
+#    include <sys/resource.h>
+#endif
+#if HAVE_DECL_SYS_PIDFD_OPEN
+#    include <sys/syscall.h>
+#endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_object.h"
 #include "src/event/event-internal.h"
@@ -61,6 +68,7 @@
 #include "src/mca/errmgr/errmgr.h"
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
+#include "src/util/attr.h"
 #include "src/util/name_fns.h"
 
 #include "src/runtime/prte_wait.h"
@@ -83,9 +91,15 @@ static void wccon(prte_wait_tracker_t *p)
     p->child = NULL;
     p->cbfunc = NULL;
     p->cbdata = NULL;
+    p->pid = 0;
+    p->pidfd = -1;
 }
 static void wcdes(prte_wait_tracker_t *p)
 {
+    if (0 <= p->pidfd) {
+        prte_event_del(&p->pidfd_ev);
+        close(p->pidfd);
+    }
     if (NULL != p->child) {
         PMIX_RELEASE(p->child);
     }
@@ -95,7 +109,16 @@ PMIX_CLASS_INSTANCE(prte_wait_tracker_t, pmix_list_item_t,
 
 /* Local Variables */
 static prte_event_t handler;
-static pmix_list_t pending_cbs;
+/* Every registration, keyed by the proc it is for - re-registering and
+ * cancelling are a lookup, not a walk */
+static pmix_hash_table_t trackers;
+/* The same registrations keyed by pid, which is all a reaped child comes
+ * back with.  A proc is registered before it is forked, so its pid is
+ * indexed once the fork has stored it: by prte_wait_watch, or by a reap
+ * that gets there first.  Until then the registration sits on "unindexed"
+ * - the only ones a miss has to look at. */
+static pmix_hash_table_t by_pid;
+static pmix_list_t unindexed;
 
 /* Local Function Prototypes */
 static void wait_signal_callback(int fd, short event, void *arg);
@@ -114,7 +137,11 @@ void prte_wait_enable(void)
 
 int prte_wait_init(void)
 {
-    PMIX_CONSTRUCT(&pending_cbs, pmix_list_t);
+    PMIX_CONSTRUCT(&trackers, pmix_hash_table_t);
+    pmix_hash_table_init(&trackers, 256);
+    PMIX_CONSTRUCT(&by_pid, pmix_hash_table_t);
+    pmix_hash_table_init(&by_pid, 256);
+    PMIX_CONSTRUCT(&unindexed, pmix_list_t);
 
     prte_event_set(prte_event_base, &handler, SIGCHLD,
                    PRTE_EV_SIGNAL | PRTE_EV_PERSIST,
@@ -126,14 +153,185 @@ int prte_wait_init(void)
 
 int prte_wait_finalize(void)
 {
+    uint64_t key;
+    prte_wait_tracker_t *t2;
+
     prte_event_del(&handler);
 
-    /* clear out the pending cbs */
-    PMIX_LIST_DESTRUCT(&pending_cbs);
+    /* clear out the pending cbs - neither by_pid nor unindexed holds
+     * references of its own */
+    while (NULL != pmix_list_remove_first(&unindexed)) {
+        continue;
+    }
+    PMIX_DESTRUCT(&unindexed);
+    PMIX_HASH_TABLE_FOREACH(key, uint64, t2, &trackers) {
+        PMIX_RELEASE(t2);
+    }
+    PMIX_DESTRUCT(&trackers);
+    PMIX_DESTRUCT(&by_pid);
 
     return PRTE_SUCCESS;
 }
 
+static prte_wait_tracker_t *find_child(prte_proc_t *child)
+{
+    prte_wait_tracker_t *t2 = NULL;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&trackers, (uint64_t) (uintptr_t) child,
+                                                         (void **) &t2)) {
+        return NULL;
+    }
+    return t2;
+}
+
+static void index_pid(prte_wait_tracker_t *t2)
+{
+    t2->pid = t2->child->pid;
+    pmix_hash_table_set_value_uint32(&by_pid, (uint32_t) t2->pid, t2);
+    pmix_list_remove_item(&unindexed, &t2->super);
+}
+
+/* The registration a reaped pid belongs to, or NULL.  A miss indexes the
+ * registrations whose fork has since stored a pid and looks again - a child
+ * forked on a worker thread stored its pid there, and the barrier pairs
+ * with the one it issues before it lets the child run.  Only those not yet
+ * indexed are looked at, and each is indexed once, so a stream of
+ * unregistered children does not rescan the table. */
+static prte_wait_tracker_t *find_pid(pid_t pid)
+{
+    prte_wait_tracker_t *t2 = NULL, *next;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&by_pid, (uint32_t) pid, (void **) &t2)) {
+        return t2;
+    }
+    if (0 == pmix_list_get_size(&unindexed)) {
+        return NULL;
+    }
+    PMIX_ACQUIRE_OBJECT(&trackers);
+    PMIX_LIST_FOREACH_SAFE(t2, next, &unindexed, prte_wait_tracker_t) {
+        if (0 < t2->child->pid) {
+            index_pid(t2);
+        }
+    }
+    t2 = NULL;
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&by_pid, (uint32_t) pid, (void **) &t2)) {
+        return t2;
+    }
+    return NULL;
+}
+
+static void unwatch(prte_wait_tracker_t *t2)
+{
+    if (0 <= t2->pidfd) {
+        prte_event_del(&t2->pidfd_ev);
+        close(t2->pidfd);
+        t2->pidfd = -1;
+    }
+}
+
+/* Drop a registration from both indexes; the caller has the reference the
+ * table held. */
+static void untrack(prte_wait_tracker_t *t2)
+{
+    pmix_hash_table_remove_value_uint64(&trackers, (uint64_t) (uintptr_t) t2->child);
+    if (0 < t2->pid) {
+        pmix_hash_table_remove_value_uint32(&by_pid, (uint32_t) t2->pid);
+    } else {
+        pmix_list_remove_item(&unindexed, &t2->super);
+    }
+    unwatch(t2);
+}
+
+/* Record what the child used, for whoever reports on it.  Only a child that
+ * has gone has a total to report - a stop is not an end. */
+static void record_usage(prte_proc_t *child, int status, struct rusage *ru)
+{
+    struct timeval cpu;
+    uint64_t maxrss;
+
+    if (NULL == ru || !(WIFEXITED(status) || WIFSIGNALED(status))) {
+        return;
+    }
+    timeradd(&ru->ru_utime, &ru->ru_stime, &cpu);
+    prte_set_attribute(&child->attributes, PRTE_PROC_CPU_TIME, PRTE_ATTR_LOCAL, &cpu,
+                       PMIX_TIMEVAL);
+    /* kilobytes on Linux and the BSDs */
+    maxrss = (uint64_t) ru->ru_maxrss;
+    prte_set_attribute(&child->attributes, PRTE_PROC_MAX_RSS, PRTE_ATTR_LOCAL, &maxrss,
+                       PMIX_UINT64);
+}
+
+/* A registered child has been reaped: hand its status to the callback. */
+static void complete(prte_wait_tracker_t *t2, int status, struct rusage *ru)
+{
+    untrack(t2);
+    t2->child->exit_code = status;
+    record_usage(t2->child, status, ru);
+    if (NULL != t2->cbfunc) {
+        prte_event_set(prte_event_base, &t2->ev, -1, PRTE_EV_WRITE, t2->cbfunc, t2);
+        prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
+    } else {
+        PMIX_RELEASE(t2);
+    }
+}
+
+#if HAVE_DECL_SYS_PIDFD_OPEN
+/* The child's pidfd turned readable: it has exited, so reap it - just it -
+ * here rather than waiting for the SIGCHLD pass to find it. */
+static void pidfd_callback(int fd, short args, void *cbdata)
+{
+    prte_wait_tracker_t *t2 = (prte_wait_tracker_t *) cbdata;
+    struct rusage ru;
+    int status;
+    pid_t pid;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    do {
+        pid = wait4(t2->pid, &status, WNOHANG, &ru);
+    } while (-1 == pid && EINTR == errno);
+
+    if (pid == t2->pid) {
+        complete(t2, status, &ru);
+    } else if (0 == pid) {
+        /* not reapable yet after all - keep watching */
+        prte_event_add(&t2->pidfd_ev, NULL);
+    } else {
+        /* somebody reaped it behind our back - nothing more will come of
+         * this descriptor */
+        PMIX_OUTPUT_VERBOSE((5, prte_debug_output,
+                             "%s wait: pidfd for pid %d could not be reaped: %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) t2->pid,
+                             strerror(errno)));
+        unwatch(t2);
+    }
+}
+#endif
+
+/* Where the platform has pidfds, give a registration whose pid is known an
+ * event of its own.  Anything that fails here leaves the child to the SIGCHLD
+ * pass, which reaps everything regardless. */
+static void watch(prte_wait_tracker_t *t2)
+{
+#if HAVE_DECL_SYS_PIDFD_OPEN
+    int fd;
+
+    if (0 <= t2->pidfd || 0 >= t2->pid) {
+        return;
+    }
+    /* a child that has exited but not been reaped still has a pidfd, so
+     * there is no window here for an exit to slip through */
+    fd = (int) syscall(SYS_pidfd_open, t2->pid, 0);
+    if (0 > fd) {
+        return;
+    }
+    t2->pidfd = fd;
+    prte_event_set(prte_event_base, &t2->pidfd_ev, fd, PRTE_EV_READ, pidfd_callback, t2);
+    prte_event_add(&t2->pidfd_ev, NULL);
+#else
+    PRTE_HIDE_UNUSED_PARAMS(t2);
+#endif
+}
+
 /* this function *must* always be called from
  * within an event in the prte_event_base */
 void prte_wait_cb(prte_proc_t *child,
@@ -164,13 +362,11 @@ void prte_wait_cb(prte_proc_t *child,
     }
 
     /* we just override any existing registration */
-    PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-    {
-        if (t2->child == child) {
-            t2->cbfunc = callback;
-            t2->cbdata = data;
-            return;
-        }
+    t2 = find_child(child);
+    if (NULL != t2) {
+        t2->cbfunc = callback;
+        t2->cbdata = data;
+        return;
     }
     /* get here if this is a new registration */
     t2 = PMIX_NEW(prte_wait_tracker_t);
@@ -178,10 +374,16 @@ void prte_wait_cb(prte_proc_t *child,
     t2->child = child;
     t2->cbfunc = callback;
     t2->cbdata = data;
-    pmix_list_append(&pending_cbs, &t2->super);
+    pmix_hash_table_set_value_uint64(&trackers, (uint64_t) (uintptr_t) child, t2);
+    pmix_list_append(&unindexed, &t2->super);
+    /* a proc re-registered after a stop already has its pid */
+    if (0 < child->pid) {
+        index_pid(t2);
+        watch(t2);
+    }
 }
 
-static void cancel_callback(int fd, short args, void *cbdata)
+static void watch_callback(int fd, short args, void *cbdata)
 {
     prte_wait_tracker_t *trk = (prte_wait_tracker_t *) cbdata;
     prte_wait_tracker_t *t2;
@@ -189,14 +391,46 @@ static void cancel_callback(int fd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(trk);
 
-    PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-    {
-        if (t2->child == trk->child) {
-            pmix_list_remove_item(&pending_cbs, &t2->super);
-            PMIX_RELEASE(t2);
-            PMIX_RELEASE(trk);
-            return;
+    /* gone already if the SIGCHLD pass got there first */
+    t2 = find_child(trk->child);
+    if (NULL != t2 && 0 < trk->child->pid) {
+        if (0 == t2->pid) {
+            index_pid(t2);
         }
+        watch(t2);
+    }
+    PMIX_RELEASE(trk);
+}
+
+void prte_wait_watch(prte_proc_t *child)
+{
+    prte_wait_tracker_t *trk;
+
+    if (NULL == child) {
+        /* bozo protection */
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return;
+    }
+
+    /* push this into the event library for handling */
+    trk = PMIX_NEW(prte_wait_tracker_t);
+    PMIX_RETAIN(child); // protect against race conditions
+    trk->child = child;
+    PRTE_PMIX_THREADSHIFT(trk, prte_event_base, watch_callback);
+}
+
+static void cancel_callback(int fd, short args, void *cbdata)
+{
+    prte_wait_tracker_t *trk = (prte_wait_tracker_t *) cbdata;
+    prte_wait_tracker_t *t2;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(trk);
+
+    t2 = find_child(trk->child);
+    if (NULL != t2) {
+        untrack(t2);
+        PMIX_RELEASE(t2);
     }
 
     PMIX_RELEASE(trk);
@@ -226,7 +460,7 @@ static void wait_signal_callback(int fd, short event, void *arg)
     int status;
     pid_t pid;
     prte_wait_tracker_t *t2;
-    bool found;
+    struct rusage ru;
     PRTE_HIDE_UNUSED_PARAMS(fd, event);
 
     PMIX_ACQUIRE_OBJECT(signal);
@@ -239,7 +473,7 @@ static void wait_signal_callback(int fd, short event, void *arg)
      * sigchild callback, so reap all the waitpids until we
      * don't get anything valid back */
     while (1) {
-        pid = waitpid(-1, &status, WNOHANG);
+        pid = wait4(-1, &status, WNOHANG, &ru);
         if (-1 == pid && EINTR == errno) {
             /* try it again */
             continue;
@@ -249,30 +483,11 @@ static void wait_signal_callback(int fd, short event, void *arg)
             return;
         }
 
-        /* A child forked by one of the worker threads had its pid stored
-         * by that thread; pair the reads below with the barrier it issues
-         * before it lets the child run. */
-        PMIX_ACQUIRE_OBJECT(&pending_cbs);
-
-        /* we are already in an event, so it is safe to access the list */
-        found = false;
-        PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-        {
-            if (pid == t2->child->pid) {
-                /* found it! */
-                found = true;
-                t2->child->exit_code = status;
-                pmix_list_remove_item(&pending_cbs, &t2->super);
-                if (NULL != t2->cbfunc) {
-                    prte_event_set(prte_event_base, &t2->ev, -1, PRTE_EV_WRITE, t2->cbfunc, t2);
-                    prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
-                } else {
-                    PMIX_RELEASE(t2);
-                }
-                break;
-            }
-        }
-        if (!found) {
+        /* we are already in an event, so it is safe to access the tables */
+        t2 = find_pid(pid);
+        if (NULL != t2) {
+            complete(t2, status, &ru);
+        } else {
             /* This is expected for a child nobody registered - the popen()
              * helpers scattered around the tree are ours too, and waitpid(-1)
              * takes whichever of them exits first.  It is a lost termination
@@ -66,6 +66,12 @@ typedef struct {
     prte_proc_t *child;
     prte_wait_cbfunc_t cbfunc;
     void *cbdata;
+    /* the pid this registration is indexed under - 0 until the fork that
+     * creates the child has stored one */
+    pid_t pid;
+    /* where supported, a pidfd for the child and the event watching it */
+    int pidfd;
+    prte_event_t pidfd_ev;
 } prte_wait_tracker_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_wait_tracker_t);
 
@@ -91,6 +97,17 @@ PRTE_EXPORT void prte_wait_cb(prte_proc_t *proc,
 
 PRTE_EXPORT void prte_wait_cb_cancel(prte_proc_t *proc);
 
+/**
+ * Tell the wait system a registered proc has been forked
+ *
+ * Call once proc->pid has been stored.  Where the platform supports it
+ * (Linux pidfds), the child then gets an event of its own and is reaped
+ * by itself when it exits, with no need to wait for SIGCHLD and sweep
+ * every child.  Elsewhere, or if the pidfd cannot be had, this does
+ * nothing and the SIGCHLD handler reaps the child as it always has.
+ */
+PRTE_EXPORT void prte_wait_watch(prte_proc_t *proc);
+
 /* In a few places, we need to barrier until something happens
  * that changes a flag to indicate we can release - e.g., waiting
  * for a specific message to arrive. If no progress thread is running,
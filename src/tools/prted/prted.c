@@ -83,6 +83,8 @@
 #include "src/util/nidmap.h"
 #include "src/util/pmix_parse_options.h"
 #include "src/util/proc_info.h"
+#include "src/util/prte_compress.h"
+#include "src/util/prte_profile.h"
 #include "src/util/session_dir.h"
 #include "src/util/pmix_show_help.h"
 #include "src/util/prte_show_help.h"
@@ -172,7 +174,7 @@ int main(int argc, char *argv[])
     prte_job_t *jdata;
     pmix_data_buffer_t data;
     pmix_topology_t ptopo;
-    bool compressed;
+    prte_compress_codec_t codec;
     bool bootstrap_controller = false;
 
     char *umask_str = getenv("PRTE_DAEMON_UMASK_VALUE");
@@ -485,6 +487,9 @@ int main(int argc, char *argv[])
      * of the procs we are about to fork. */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_SLICE,
                   PRTE_RML_PERSISTENT, prte_odls_base_recv_cpuset_slice, NULL);
+    /* The master's answer when a launch named a template we lacked. */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_LAUNCH_TEMPLATE_RESP,
+                  PRTE_RML_PERSISTENT, prte_odls_base_recv_template, NULL);
 
     /* output a message indicating we are alive, our name, and our pid
      * for debugging purposes
@@ -713,19 +718,19 @@ int main(int argc, char *argv[])
             ret = PRTE_ERROR;
             goto DONE;
         }
-        if (PMIx_Data_compress((uint8_t *) data.base_ptr, data.bytes_used, (uint8_t **) &pbo.bytes,
-                               &pbo.size)) {
-            /* the data was compressed - mark that we compressed it */
-            compressed = true;
-        } else {
-            compressed = false;
+        /* it crosses every link between us and the HNP, one after the other */
+        codec = prte_compress((uint8_t *) data.base_ptr, data.bytes_used,
+                              (double) (0 < prte_rml_base.cur_node.depth
+                                            ? prte_rml_base.cur_node.depth : 1),
+                              (uint8_t **) &pbo.bytes, &pbo.size);
+        if (PRTE_COMPRESS_NONE == codec) {
             pbo.bytes = data.base_ptr;
             pbo.size = data.bytes_used;
             data.base_ptr = NULL;
             data.bytes_used = 0;
         }
         PMIX_DATA_BUFFER_DESTRUCT(&data);
-        prc = PMIx_Data_pack(NULL, buffer, &compressed, 1, PMIX_BOOL);
+        prc = PMIx_Data_pack(NULL, buffer, &codec, 1, PRTE_COMPRESS_CODEC_T);
         if (PMIX_SUCCESS != prc) {
             PMIX_ERROR_LOG(prc);
             PMIX_DATA_BUFFER_RELEASE(buffer);
@@ -762,6 +767,22 @@ int main(int argc, char *argv[])
             goto DONE;
         }
     }
+    prte_profile_startup_phase("report_in");
+
+    /* if the HNP is gathering startup profiles, ours goes straight to
+     * it - it is not on the critical path, so it need not ride the
+     * callback up the tree */
+    if (prte_profile_startup_enabled) {
+        PMIX_DATA_BUFFER_CREATE(buffer);
+        ret = prte_profile_startup_pack(buffer);
+        if (PRTE_SUCCESS == ret) {
+            PRTE_RML_SEND(ret, PRTE_PROC_MY_HNP->rank, buffer, PRTE_RML_TAG_STARTUP_PROFILE);
+        }
+        if (PRTE_SUCCESS != ret) {
+            PRTE_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_RELEASE(buffer);
+        }
+    }
 
     /* if we are tree-spawning, then we need to capture the MCA params
      * from our cmd line so we can pass them along to the daemons we spawn -
@@ -420,6 +420,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "JOB-NOTIFICATIONS";
         case PRTE_JOB_ROOM_NUM:
             return "JOB-ROOM-NUM";
+        case PRTE_JOB_BATCH_SIZE:
+            return "JOB-BATCH-SIZE";
         case PRTE_JOB_LAUNCH_PROXY:
             return "JOB-LAUNCH-PROXY";
         case PRTE_JOB_NSPACE_REGISTERED:
@@ -526,6 +528,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "STOP-IN-APP";
         case PRTE_JOB_BREAKPOINT:
             return "BREAKPOINT";
+        case PRTE_JOB_LAUNCH_TEMPLATE:
+            return "LAUNCH TEMPLATE";
         case PRTE_JOB_ENVARS_HARVESTED:
             return "ENVARS-HARVESTED";
         case PRTE_JOB_OUTPUT_NOCOPY:
@@ -570,6 +574,8 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "DISPLAY PROCESSORS";
         case PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT:
             return "DISPLAY PARSEABLE OUTPUT";
+        case PRTE_JOB_DISPLAY_JSON_OUTPUT:
+            return "DISPLAY JSON OUTPUT";
         case PRTE_JOB_EXTEND_DVM:
             return "EXTEND DVM";
         case PRTE_JOB_SESSION_ID:
@@ -624,6 +630,10 @@ const char *prte_attr_key_to_str(prte_attribute_key_t key)
             return "PROC-CGROUP";
         case PRTE_PROC_DEVICE_ID:
             return "PROC_DEVICE_ID";
+        case PRTE_PROC_CPU_TIME:
+            return "PROC_CPU_TIME";
+        case PRTE_PROC_MAX_RSS:
+            return "PROC_MAX_RSS";
         case PRTE_PROC_NBEATS:
             return "PROC-NBEATS";
 
@@ -186,6 +186,7 @@ typedef uint16_t prte_job_flags_t;
 #define PRTE_JOB_CPUSET                     (PRTE_JOB_START_KEY +  37) // string - "soft" cgroup envelope for the job
 #define PRTE_JOB_NOTIFICATIONS              (PRTE_JOB_START_KEY +  38) // string - comma-separated list of desired notifications+methods
 #define PRTE_JOB_ROOM_NUM                   (PRTE_JOB_START_KEY +  39) // int - number of remote request's hotel room
+#define PRTE_JOB_BATCH_SIZE                 (PRTE_JOB_START_KEY + 134) // uint32_t - number of jobs submitted in the same batch spawn as this one
 #define PRTE_JOB_LAUNCH_PROXY               (PRTE_JOB_START_KEY +  40) // pmix_proc_t - name of spawn requestor
 #define PRTE_JOB_NSPACE_REGISTERED          (PRTE_JOB_START_KEY +  41) // bool - job has been registered with embedded PMIx server
 #define PRTE_JOB_FIXED_DVM                  (PRTE_JOB_START_KEY +  42) // bool - do not change the size of the DVM for this job
@@ -241,6 +242,7 @@ typedef uint16_t prte_job_flags_t;
 #define PRTE_JOB_STOP_IN_INIT               (PRTE_JOB_START_KEY +  88) // bool - stop in PMIx_Init
 #define PRTE_JOB_STOP_IN_APP                (PRTE_JOB_START_KEY +  89) // bool - stop at app-determined location
 #define PRTE_JOB_BREAKPOINT                 (PRTE_JOB_START_KEY + 131) // char* - string ID of the app-determined location at which to stop
+#define PRTE_JOB_LAUNCH_TEMPLATE            (PRTE_JOB_START_KEY + 132) // uint32_t - id of the launch template holding this job's apps
 #define PRTE_JOB_ENVARS_HARVESTED           (PRTE_JOB_START_KEY +  90) // envars have already been harvested
 #define PRTE_JOB_OUTPUT_NOCOPY              (PRTE_JOB_START_KEY +  91) // bool - do not copy output to stdout/err
 #define PRTE_JOB_RANK_OUTPUT                (PRTE_JOB_START_KEY +  92) // bool - tag stdout/stderr with rank
@@ -265,6 +267,7 @@ typedef uint16_t prte_job_flags_t;
 #define PRTE_JOB_DISPLAY_PROCESSORS         (PRTE_JOB_START_KEY + 109) // char* - string displaying nodes whose avail CPUs
                                                                        //         are to be displayed
 #define PRTE_JOB_DISPLAY_PARSEABLE_OUTPUT   (PRTE_JOB_START_KEY + 110) // bool - display output in machine parsable format
+#define PRTE_JOB_DISPLAY_JSON_OUTPUT        (PRTE_JOB_START_KEY + 133) // bool - display the map as a single line of JSON
 #define PRTE_JOB_EXTEND_DVM                 (PRTE_JOB_START_KEY + 111) // bool - DVM is being extended
 #define PRTE_JOB_SESSION_ID                 (PRTE_JOB_START_KEY + 112) // uint32_t - session id of this job
 #define PRTE_JOB_ALLOC_ID                   (PRTE_JOB_START_KEY + 113) // char* - string identifier assigned by the host for the session
@@ -336,6 +339,8 @@ typedef uint16_t prte_proc_flags_t;
 #define PRTE_PROC_CGROUP            (PRTE_PROC_START_KEY + 13) // string - name of cgroup this proc shall be assigned to
 #define PRTE_PROC_NBEATS            (PRTE_PROC_START_KEY + 14) // int32 - number of heartbeats in current window
 #define PRTE_PROC_DEVICE_ID         (PRTE_PROC_START_KEY + 15) // pmix_data_array_t of pmix_device_t - the devices this proc was mapped against, always an array even for one
+#define PRTE_PROC_CPU_TIME          (PRTE_PROC_START_KEY + 16) // struct timeval - user plus system CPU time the proc used, from its rusage when reaped
+#define PRTE_PROC_MAX_RSS           (PRTE_PROC_START_KEY + 17) // uint64_t - peak resident set size of the proc in KB, from its rusage when reaped
 
 #define PRTE_PROC_MAX_KEY (PRTE_PROC_START_KEY + 100)
 
@@ -21,6 +21,7 @@
 #    include <unistd.h>
 #endif
 #include <ctype.h>
+#include <string.h>
 
 #include "src/util/pmix_argv.h"
 
@@ -33,17 +34,40 @@
 #include "src/prted/pmix/pmix_server.h"
 #include "src/util/nidmap.h"
 
+/* The node's aliases as they travel in a node map: comma-joined, minus the
+ * loopback names, or "PRTENONE" for a node that has none. */
+static char *node_aliases(prte_node_t *nptr)
+{
+    char **als = NULL, *raw;
+    int m;
+
+    if (NULL == nptr->aliases) {
+        return strdup("PRTENONE");
+    }
+    for (m=0; NULL != nptr->aliases[m]; m++) {
+        // skip any localhost entries
+        if (0 == strcmp(nptr->aliases[m], "localhost") ||
+            0 == strcmp(nptr->aliases[m], "127.0.0.1")) {
+            continue;
+        }
+        PMIx_Argv_append_nosize(&als, nptr->aliases[m]);
+    }
+    raw = PMIx_Argv_join(als, ',');
+    PMIx_Argv_free(als);
+    return raw;
+}
+
 int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer)
 {
     char *raw = NULL;
     pmix_rank_t *vpids = NULL;
     int32_t *ndidx = NULL;
     uint8_t u8;
-    int n, m, ndaemons, nbytes;
+    int n, ndaemons, nbytes;
     pmix_rank_t span;
     bool compressed;
     char **names = NULL;
-    char **aliases = NULL, **als;
+    char **aliases = NULL;
     prte_node_t *nptr;
     pmix_byte_object_t bo;
     size_t sz;
@@ -135,23 +159,9 @@ int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buff
         }
         /* add the hostname to the argv */
         PMIx_Argv_append_nosize(&names, nptr->name);
-        als = NULL;
-        if (NULL != nptr->aliases) {
-            for (m=0; NULL != nptr->aliases[m]; m++) {
-                // skip any localhost entries
-                if (0 == strcmp(nptr->aliases[m], "localhost") ||
-                    0 == strcmp(nptr->aliases[m], "127.0.0.1")) {
-                    continue;
-                }
-                PMIx_Argv_append_nosize(&als, nptr->aliases[m]);
-            }
-            raw = PMIx_Argv_join(als, ',');
-            PMIx_Argv_free(als);
-            PMIx_Argv_append_nosize(&aliases, raw);
-            free(raw);
-        } else {
-            PMIx_Argv_append_nosize(&aliases, "PRTENONE");
-        }
+        raw = node_aliases(nptr);
+        PMIx_Argv_append_nosize(&aliases, raw);
+        free(raw);
         /* store the vpid and the pool slot this node occupies */
         vpids[ndaemons] = nptr->daemon->name.rank;
         ndidx[ndaemons] = nptr->index;
@@ -306,6 +316,113 @@ int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buff
     return rc;
 }
 
+/* Put the named node in the sender's pool slot and bind it to the daemon
+ * the sender says is on it */
+static int bind_node(prte_job_t *daemons, prte_topology_t *t, int32_t idx,
+                     const char *name, const char *aliases, pmix_rank_t vpid)
+{
+    prte_node_t *nd;
+    prte_proc_t *proc;
+
+    if (0 > idx) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return PRTE_ERR_BAD_PARAM;
+    }
+    nd = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, idx);
+    if (NULL == nd) {
+        /* add this node to the pool, in the sender's slot */
+        nd = PMIX_NEW(prte_node_t);
+        nd->name = strdup(name);
+        nd->index = idx;
+        pmix_pointer_array_set_item(prte_node_pool, idx, nd);
+        /* set the topology - always default to homogeneous
+         * as that is the most common scenario. Retain it: the node holds a
+         * counted reference so the topology cannot go away underneath it */
+        PMIX_RETAIN(t);
+        nd->topology = t;
+    } else if (0 != strcmp(nd->name, name)) {
+        /* the sender has put a different machine in this slot - the old
+         * name's aliases are not this one's, so they go too rather than
+         * surviving into a node that never claimed them */
+        free(nd->name);
+        nd->name = strdup(name);
+        if (NULL != nd->aliases) {
+            PMIx_Argv_free(nd->aliases);
+            nd->aliases = NULL;
+        }
+    }
+    /* refresh the aliases */
+    if (0 != strcmp(aliases, "PRTENONE")) {
+        if (NULL != nd->aliases) {
+            PMIx_Argv_free(nd->aliases);
+        }
+        nd->aliases = PMIx_Argv_split(aliases, ',');
+    }
+    /* record the daemon on it */
+    proc = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, vpid);
+    if (NULL == proc) {
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, PRTE_PROC_MY_NAME->nspace, vpid);
+        proc->state = PRTE_PROC_STATE_RUNNING;
+        PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
+        daemons->num_procs++;
+        pmix_pointer_array_set_item(daemons->procs, proc->name.rank, proc);
+    }
+    /* the node backpointer is borrowed, not retained (see
+     * prte_proc_destruct) */
+    proc->node = nd;
+    if (nd->daemon != proc) {
+        /* the node holds a counted reference on its daemon, so a rebind
+         * has to drop the one it was holding */
+        if (NULL != nd->daemon) {
+            PMIX_RELEASE(nd->daemon);
+        }
+        PMIX_RETAIN(proc);
+        nd->daemon = proc;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* Adopt the sender's daemon vpid span [0, ndmns) */
+static void settle_span(prte_job_t *daemons, pmix_rank_t ndmns)
+{
+    /* Record any vpid holes as departed ranks. The DVM spans [0, ndmns) daemon
+     * vpids, but a shrunk-out (or not-yet-present bootstrap) daemon leaves a
+     * hole with no entry above, so daemons->procs has a gap at that rank.
+     * Marking the gap makes this daemon's routing tree route around the hole
+     * exactly as the HNP and the surviving daemons do - closing the gap that a
+     * brand-new daemon (empty failure set) would otherwise have (#2491). On an
+     * unshrunk, fully-present DVM ndmns equals the live count, so nothing is
+     * marked and behavior is unchanged. */
+    bool newdead = false;
+    for (pmix_rank_t r = 0; r < ndmns; r++) {
+        if (NULL != pmix_pointer_array_get_item(daemons->procs, r)) {
+            continue;
+        }
+        // In a bootstrapped DVM a vpid hole is not necessarily permanent: the
+        // node can reboot and its daemon return with the same rank. Record it
+        // as absent (clearable by the unheal path) rather than dead. In a
+        // launched/elastic DVM the hole is permanent (#2491) and goes to
+        // dead_dmns exactly as before.
+        if (prte_bootstrap_setup) {
+            if (!pmix_bitmap_is_set_bit(&prte_rml_base.absent_dmns, r)) {
+                pmix_bitmap_set_bit(&prte_rml_base.absent_dmns, r);
+                newdead = true;
+            }
+        } else if (!pmix_bitmap_is_set_bit(&prte_rml_base.dead_dmns, r)) {
+            pmix_bitmap_set_bit(&prte_rml_base.dead_dmns, r);
+            newdead = true;
+        }
+    }
+
+    /* update num daemons and (re)build the routing tree if the vpid span grew
+     * or a new hole appeared */
+    if (prte_process_info.num_daemons != ndmns || newdead) {
+        prte_process_info.num_daemons = ndmns;
+        prte_rml_compute_routing_tree();
+    }
+}
+
 int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
 {
     uint8_t u8;
@@ -320,7 +437,6 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
     char *seen = NULL;
     prte_node_t *nd;
     prte_job_t *daemons;
-    prte_proc_t *proc;
     prte_topology_t *t = NULL;
     pmix_status_t rc;
 
@@ -524,63 +640,10 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
      * daemons->procs had a hole where odls looks up the parent of every proc
      * in a job, and that daemon launched nothing (#2616). */
     for (n = 0; n < nnodes; n++) {
-        if (0 > ndidx[n]) {
-            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
-            rc = PRTE_ERR_BAD_PARAM;
+        rc = bind_node(daemons, t, ndidx[n], names[n], aliases[n], vpid[n]);
+        if (PRTE_SUCCESS != rc) {
             goto cleanup;
         }
-        nd = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, ndidx[n]);
-        if (NULL == nd) {
-            /* add this node to the pool, in the sender's slot */
-            nd = PMIX_NEW(prte_node_t);
-            nd->name = strdup(names[n]);
-            nd->index = ndidx[n];
-            pmix_pointer_array_set_item(prte_node_pool, ndidx[n], nd);
-            /* set the topology - always default to homogeneous
-             * as that is the most common scenario. Retain it: the node holds a
-             * counted reference so the topology cannot go away underneath it */
-            PMIX_RETAIN(t);
-            nd->topology = t;
-        } else if (0 != strcmp(nd->name, names[n])) {
-            /* the sender has put a different machine in this slot - the old
-             * name's aliases are not this one's, so they go too rather than
-             * surviving into a node that never claimed them */
-            free(nd->name);
-            nd->name = strdup(names[n]);
-            if (NULL != nd->aliases) {
-                PMIx_Argv_free(nd->aliases);
-                nd->aliases = NULL;
-            }
-        }
-        /* refresh the aliases */
-        if (0 != strcmp(aliases[n], "PRTENONE")) {
-            if (NULL != nd->aliases) {
-                PMIx_Argv_free(nd->aliases);
-            }
-            nd->aliases = PMIx_Argv_split(aliases[n], ',');
-        }
-        /* record the daemon on it */
-        proc = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, vpid[n]);
-        if (NULL == proc) {
-            proc = PMIX_NEW(prte_proc_t);
-            PMIX_LOAD_PROCID(&proc->name, PRTE_PROC_MY_NAME->nspace, vpid[n]);
-            proc->state = PRTE_PROC_STATE_RUNNING;
-            PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
-            daemons->num_procs++;
-            pmix_pointer_array_set_item(daemons->procs, proc->name.rank, proc);
-        }
-        /* the node backpointer is borrowed, not retained (see
-         * prte_proc_destruct) */
-        proc->node = nd;
-        if (nd->daemon != proc) {
-            /* the node holds a counted reference on its daemon, so a rebind
-             * has to drop the one it was holding */
-            if (NULL != nd->daemon) {
-                PMIX_RELEASE(nd->daemon);
-            }
-            PMIX_RETAIN(proc);
-            nd->daemon = proc;
-        }
     }
 
     /* A node the sender did not name has no daemon on it any more - it was
@@ -610,41 +673,7 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
         nd->daemon = NULL;
     }
 
-    /* Record any vpid holes as departed ranks. The DVM spans [0, ndmns) daemon
-     * vpids, but a shrunk-out (or not-yet-present bootstrap) daemon leaves a
-     * hole with no entry above, so daemons->procs has a gap at that rank.
-     * Marking the gap makes this daemon's routing tree route around the hole
-     * exactly as the HNP and the surviving daemons do - closing the gap that a
-     * brand-new daemon (empty failure set) would otherwise have (#2491). On an
-     * unshrunk, fully-present DVM ndmns equals the live count, so nothing is
-     * marked and behavior is unchanged. */
-    bool newdead = false;
-    for (pmix_rank_t r = 0; r < ndmns; r++) {
-        if (NULL != pmix_pointer_array_get_item(daemons->procs, r)) {
-            continue;
-        }
-        // In a bootstrapped DVM a vpid hole is not necessarily permanent: the
-        // node can reboot and its daemon return with the same rank. Record it
-        // as absent (clearable by the unheal path) rather than dead. In a
-        // launched/elastic DVM the hole is permanent (#2491) and goes to
-        // dead_dmns exactly as before.
-        if (prte_bootstrap_setup) {
-            if (!pmix_bitmap_is_set_bit(&prte_rml_base.absent_dmns, r)) {
-                pmix_bitmap_set_bit(&prte_rml_base.absent_dmns, r);
-                newdead = true;
-            }
-        } else if (!pmix_bitmap_is_set_bit(&prte_rml_base.dead_dmns, r)) {
-            pmix_bitmap_set_bit(&prte_rml_base.dead_dmns, r);
-            newdead = true;
-        }
-    }
-
-    /* update num daemons and (re)build the routing tree if the vpid span grew
-     * or a new hole appeared */
-    if (prte_process_info.num_daemons != ndmns || newdead) {
-        prte_process_info.num_daemons = ndmns;
-        prte_rml_compute_routing_tree();
-    }
+    settle_span(daemons, ndmns);
 
 
 cleanup:
@@ -668,6 +697,451 @@ cleanup:
     return rc;
 }
 
+/* Versioned node-map updates.
+ *
+ * Every time the DVM changes shape the master used to send every daemon the
+ * whole node map, and every daemon rebuilt its pool from it - growing a
+ * 4k-node DVM by 16 nodes cost 4k full decodes of a 4k-node map.  The master
+ * now numbers the maps it publishes and remembers what the last one said, so
+ * the WIREUP message carries only the slots that changed since then.  A
+ * daemon holding the previous version applies that.
+ *
+ * A daemon that holds no map yet (it just joined, or it rebooted and reported
+ * in again) cannot apply a delta, and is sent a full snapshot of its own
+ * instead: a pruned xcast to just those daemons, made ahead of the WIREUP.
+ * Ops reach a daemon in op-id order down the same tree path, so the snapshot
+ * is in place by the time the delta arrives, and the delta - which the joiner
+ * then already holds the version of - is stepped over.  The daemons a pruned
+ * xcast passes through on its way also see it; they hold the base map, and
+ * leave the snapshot for the delta behind it.  The snapshot is only built
+ * when such a daemon exists - a shrink, or a grow that was rolled back, is a
+ * pure delta.
+ *
+ * WIREUP layout:
+ *     uint32 base version, uint32 new version,
+ *     bool has_delta     [byte object: uint8 hnp-allocated, rank span,
+ *                         int32 nset, nset x (int32 slot, string name,
+ *                                             string aliases, rank vpid),
+ *                         int32 nclear, nclear x int32 slot]
+ *
+ * Snapshot layout (PRTE_RML_TAG_NIDMAP_SNAPSHOT):
+ *     uint32 base version, uint32 new version, a prte_util_nidmap_create() map
+ */
+typedef struct {
+    char *name;
+    char *aliases;
+    pmix_rank_t vpid;
+} published_slot_t;
+
+/* master: the last map published, and which daemons hold it.
+ * daemon: the version of the map this daemon holds. */
+static uint32_t nidmap_version = 0;
+static published_slot_t *published = NULL;
+static int npublished = 0;
+static pmix_bitmap_t synced;
+static bool synced_init = false;
+
+void prte_util_nidmap_forget(pmix_rank_t vpid)
+{
+    if (synced_init && (int) vpid < pmix_bitmap_size(&synced)) {
+        pmix_bitmap_clear_bit(&synced, vpid);
+    }
+}
+
+static bool slot_differs(published_slot_t *ps, prte_node_t *nptr, char *aliases)
+{
+    return ps->vpid != nptr->daemon->name.rank
+           || NULL == ps->name || 0 != strcmp(ps->name, nptr->name)
+           || 0 != strcmp(ps->aliases, aliases);
+}
+
+int prte_util_nidmap_pack_update(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer,
+                                 pmix_bitmap_t *joiners, pmix_data_buffer_t *snapshot)
+{
+    published_slot_t *now = NULL;
+    pmix_data_buffer_t delta;
+    pmix_byte_object_t bo;
+    prte_node_t *nptr;
+    pmix_rank_t span;
+    uint32_t version;
+    int32_t nset = 0, nclear = 0, idx;
+    bool has_delta, has_snapshot = false;
+    uint8_t u8;
+    int n, rc;
+
+    if (!synced_init) {
+        PMIX_CONSTRUCT(&synced, pmix_bitmap_t);
+        synced_init = true;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&delta);
+    pmix_bitmap_clear_all_bits(joiners);
+
+    /* what the map says now, slot by slot */
+    if (0 < pool->size) {
+        now = (published_slot_t *) calloc(pool->size, sizeof(published_slot_t));
+        if (NULL == now) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+    }
+    span = prte_process_info.num_daemons;
+    for (n = 0; n < pool->size; n++) {
+        now[n].vpid = PMIX_RANK_INVALID;
+        nptr = (prte_node_t *) pmix_pointer_array_get_item(pool, n);
+        if (NULL == nptr || NULL == nptr->daemon) {
+            continue;
+        }
+        now[n].name = strdup(nptr->name);
+        now[n].aliases = node_aliases(nptr);
+        now[n].vpid = nptr->daemon->name.rank;
+        if (now[n].vpid + 1 > span) {
+            span = now[n].vpid + 1;
+        }
+        /* a daemon that does not hold the last map cannot apply a delta */
+        if ((int) now[n].vpid >= pmix_bitmap_size(&synced)
+            || !pmix_bitmap_is_set_bit(&synced, now[n].vpid)) {
+            if (!PMIX_CHECK_PROCID(&nptr->daemon->name, PRTE_PROC_MY_NAME)) {
+                pmix_bitmap_set_bit(joiners, now[n].vpid);
+                has_snapshot = true;
+            }
+        }
+    }
+    has_delta = (0 < nidmap_version);
+    version = nidmap_version + 1;
+
+    rc = PMIx_Data_pack(NULL, buffer, &nidmap_version, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buffer, &version, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buffer, &has_delta, 1, PMIX_BOOL);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        rc = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+
+    if (has_delta) {
+        /* count first: the receiver reads counts, not to the end */
+        for (n = 0; n < pool->size || n < npublished; n++) {
+            if (n < pool->size && PMIX_RANK_INVALID != now[n].vpid) {
+                if (n >= npublished || slot_differs(&published[n],
+                                                    (prte_node_t *) pmix_pointer_array_get_item(pool, n),
+                                                    now[n].aliases)) {
+                    ++nset;
+                }
+            } else if (n < npublished && PMIX_RANK_INVALID != published[n].vpid) {
+                ++nclear;
+            }
+        }
+        u8 = prte_hnp_is_allocated ? 1 : 0;
+        rc = PMIx_Data_pack(NULL, &delta, &u8, 1, PMIX_UINT8);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &delta, &span, 1, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &delta, &nset, 1, PMIX_INT32);
+        }
+        for (n = 0; PMIX_SUCCESS == rc && n < pool->size; n++) {
+            if (PMIX_RANK_INVALID == now[n].vpid) {
+                continue;
+            }
+            if (n < npublished && !slot_differs(&published[n],
+                                                (prte_node_t *) pmix_pointer_array_get_item(pool, n),
+                                                now[n].aliases)) {
+                continue;
+            }
+            idx = n;
+            rc = PMIx_Data_pack(NULL, &delta, &idx, 1, PMIX_INT32);
+            if (PMIX_SUCCESS == rc) {
+                rc = PMIx_Data_pack(NULL, &delta, &now[n].name, 1, PMIX_STRING);
+            }
+            if (PMIX_SUCCESS == rc) {
+                rc = PMIx_Data_pack(NULL, &delta, &now[n].aliases, 1, PMIX_STRING);
+            }
+            if (PMIX_SUCCESS == rc) {
+                rc = PMIx_Data_pack(NULL, &delta, &now[n].vpid, 1, PMIX_PROC_RANK);
+            }
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &delta, &nclear, 1, PMIX_INT32);
+        }
+        for (n = 0; PMIX_SUCCESS == rc && n < npublished; n++) {
+            if (PMIX_RANK_INVALID == published[n].vpid
+                || (n < pool->size && PMIX_RANK_INVALID != now[n].vpid)) {
+                continue;
+            }
+            idx = n;
+            rc = PMIx_Data_pack(NULL, &delta, &idx, 1, PMIX_INT32);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            rc = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+        /* as an object of its own, so a daemon it is not meant for can step
+         * over it without reading it */
+        rc = PMIx_Data_unload(&delta, &bo);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            rc = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+    }
+
+    /* nobody holds a map yet on the first publication, and every daemon is
+     * a joiner - the loop above has already said so */
+    if (has_snapshot) {
+        rc = PMIx_Data_pack(NULL, snapshot, &nidmap_version, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, snapshot, &version, 1, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            rc = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+        rc = prte_util_nidmap_create(pool, snapshot);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    }
+
+    /* this is now what the DVM holds - or will, once the xcast lands */
+    for (n = 0; n < npublished; n++) {
+        free(published[n].name);
+        free(published[n].aliases);
+    }
+    free(published);
+    published = now;
+    npublished = pool->size;
+    now = NULL;
+    pmix_bitmap_clear_all_bits(&synced);
+    for (n = 0; n < npublished; n++) {
+        if (PMIX_RANK_INVALID != published[n].vpid) {
+            pmix_bitmap_set_bit(&synced, published[n].vpid);
+        }
+    }
+    nidmap_version = version;
+    rc = PRTE_SUCCESS;
+
+cleanup:
+    if (NULL != now) {
+        for (n = 0; n < pool->size; n++) {
+            free(now[n].name);
+            free(now[n].aliases);
+        }
+        free(now);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&delta);
+    return rc;
+}
+
+static int apply_delta(pmix_data_buffer_t *buf)
+{
+    prte_job_t *daemons;
+    prte_topology_t *t;
+    prte_node_t *nd;
+    pmix_rank_t span, vpid;
+    int32_t nset, nclear, idx, n;
+    char *name = NULL, *aliases = NULL;
+    uint8_t u8;
+    int cnt;
+    pmix_status_t rc;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &u8, &cnt, PMIX_UINT8);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &span, &cnt, PMIX_PROC_RANK);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &nset, &cnt, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    prte_hnp_is_allocated = (1 == u8);
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, 0);
+    if (NULL == daemons || NULL == t) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    for (n = 0; n < nset; n++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &idx, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, buf, &name, &cnt, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, buf, &aliases, &cnt, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, buf, &vpid, &cnt, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            free(name);
+            free(aliases);
+            return prte_pmix_convert_status(rc);
+        }
+        if (NULL == name || NULL == aliases) {
+            PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+            free(name);
+            free(aliases);
+            return PRTE_ERR_BAD_PARAM;
+        }
+        rc = bind_node(daemons, t, idx, name, aliases, vpid);
+        free(name);
+        free(aliases);
+        name = NULL;
+        aliases = NULL;
+        if (PRTE_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &nclear, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    for (n = 0; n < nclear; n++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &idx, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+        /* that node's daemon has left the DVM - see the same step in
+         * prte_util_decode_nidmap */
+        nd = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, idx);
+        if (NULL == nd || NULL == nd->daemon) {
+            continue;
+        }
+        PMIX_RELEASE(nd->daemon);
+        nd->daemon = NULL;
+    }
+
+    settle_span(daemons, span);
+    return PRTE_SUCCESS;
+}
+
+static int load_and_apply(pmix_byte_object_t *bo, int (*fn)(pmix_data_buffer_t *))
+{
+    pmix_data_buffer_t part;
+    int rc;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&part);
+    /* the buffer takes the bytes */
+    rc = PMIx_Data_load(&part, bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(bo);
+        return prte_pmix_convert_status(rc);
+    }
+    rc = fn(&part);
+    PMIX_DATA_BUFFER_DESTRUCT(&part);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+int prte_util_nidmap_apply_snapshot(pmix_data_buffer_t *buf)
+{
+    uint32_t base, version;
+    int cnt, rc;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &base, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &version, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    /* passing through on its way to a joiner: the delta behind it is ours */
+    if (0 < base && base == nidmap_version) {
+        return PRTE_SUCCESS;
+    }
+    rc = prte_util_decode_nidmap(buf);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    nidmap_version = version;
+    return PRTE_SUCCESS;
+}
+
+int prte_util_nidmap_apply_update(pmix_data_buffer_t *buf)
+{
+    uint32_t base, version;
+    bool has_delta;
+    pmix_byte_object_t bo;
+    int cnt, rc;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &base, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &version, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &has_delta, &cnt, PMIX_BOOL);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+
+    if (has_delta) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+        if (base == nidmap_version) {
+            rc = load_and_apply(&bo, apply_delta);
+            if (PRTE_SUCCESS != rc) {
+                return rc;
+            }
+            nidmap_version = version;
+            return PRTE_SUCCESS;
+        }
+        /* against a map we do not hold - the snapshot ahead of it has
+         * already brought us to this version, or nothing has */
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    }
+
+    if (version != nidmap_version) {
+        /* no snapshot reached us ahead of this: the master's idea of which
+         * daemons are synced is wrong */
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_ORDER_MSG);
+        return PRTE_ERR_OUT_OF_ORDER_MSG;
+    }
+    return PRTE_SUCCESS;
+}
+
 /* The jobs already running in the DVM.
  *
  * A daemon that has just joined the DVM has to be told about the jobs that
@@ -851,3 +1325,59 @@ int prte_util_decode_job_catchup(pmix_data_buffer_t *buffer)
 
     return PRTE_SUCCESS;
 }
+
+int prte_util_regex_memo_add(prte_regex_memo_t *memo, const char *key,
+                             char *input, bool ppn, void *ilist)
+{
+    pmix_status_t ret;
+
+    if (memo->valid && 0 == strcmp(memo->input, input)) {
+        free(input);
+    } else {
+        if (memo->valid) {
+            PMIX_INFO_DESTRUCT(&memo->info);
+            free(memo->input);
+            memo->input = NULL;
+            memo->valid = false;
+        }
+#if PRTE_PMIX_HAVE_REGEX2
+        /* the proc map goes through the same generator: PMIx_generate_ppn is
+         * deprecated with no replacement, because the per-node rank mapping
+         * is now carried by an ordinary pmix_regex2_t.  The receiving side
+         * (gds/hash) splits it on ';' rather than ',' - which is a property
+         * of the string, not of the encoding */
+        pmix_regex2_t rx = PMIX_REGEX2_STATIC_INIT;
+        PRTE_HIDE_UNUSED_PARAMS(ppn);
+        if (PMIX_SUCCESS != (ret = PMIx_generate_regex2(input, NULL, 0, &rx))) {
+            PMIX_ERROR_LOG(ret);
+            free(input);
+            return prte_pmix_convert_status(ret);
+        }
+        PMIX_INFO_LOAD(&memo->info, key, &rx, PMIX_REGEX2);
+        PMIx_Regex2_destruct(&rx);
+#else
+        char *regex = NULL;
+        if (ppn) {
+            ret = PMIx_generate_ppn(input, &regex);
+        } else {
+            ret = PMIx_generate_regex(input, &regex);
+        }
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            free(input);
+            return prte_pmix_convert_status(ret);
+        }
+        PMIX_INFO_LOAD(&memo->info, key, regex, PMIX_REGEX);
+        free(regex);
+#endif
+        memo->input = input;
+        memo->valid = true;
+    }
+
+    PMIX_INFO_LIST_XFER(ret, ilist, &memo->info);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return prte_pmix_convert_status(ret);
+    }
+    return PRTE_SUCCESS;
+}
@@ -35,6 +35,24 @@ PRTE_EXPORT int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_bu
 
 PRTE_EXPORT int prte_util_decode_nidmap(pmix_data_buffer_t *buf);
 
+/* Versioned form of the node map for the WIREUP message: the slots that
+ * changed since the map last published go in "buf".  If some daemon does not
+ * hold that map, its vpid is set in "joiners" and a full snapshot for it is
+ * packed into "snapshot", which is left empty otherwise - it is for those
+ * daemons alone, and has to be sent to them ahead of the WIREUP.  The master
+ * packs, daemons apply, and a daemon checks the version its map is at before
+ * applying anything. */
+PRTE_EXPORT int prte_util_nidmap_pack_update(pmix_pointer_array_t *pool, pmix_data_buffer_t *buf,
+                                             pmix_bitmap_t *joiners, pmix_data_buffer_t *snapshot);
+
+PRTE_EXPORT int prte_util_nidmap_apply_update(pmix_data_buffer_t *buf);
+
+PRTE_EXPORT int prte_util_nidmap_apply_snapshot(pmix_data_buffer_t *buf);
+
+/* Master: this daemon (re)reported and holds no node map - the next update
+ * has to carry a snapshot for it */
+PRTE_EXPORT void prte_util_nidmap_forget(pmix_rank_t vpid);
+
 /* Catch-up payload: the jobs already running in this DVM, for the benefit of
  * daemons that have only just joined it.  Rides in the same message as the
  * nidmap because it answers the same question - what does the DVM currently
@@ -45,4 +63,21 @@ PRTE_EXPORT int prte_util_pack_job_catchup(pmix_data_buffer_t *buf, prte_job_t *
 
 PRTE_EXPORT int prte_util_decode_job_catchup(pmix_data_buffer_t *buf);
 
+/* The node and proc map regexes a job's nspace is registered with. A DVM
+ * that runs the same shape of job again asks for the same regex from the
+ * same string, so each caller keeps the last one it generated and hands it
+ * out again while the string is unchanged. */
+typedef struct {
+    char *input;
+    pmix_info_t info;
+    bool valid;
+} prte_regex_memo_t;
+
+/* Add "key" (PMIX_NODE_MAP or PMIX_PROC_MAP) to the info list "ilist",
+ * carrying the regex of "input" - regenerated only if the memo was made from
+ * a different string. "ppn" selects the proc-map generator for a PMIx that
+ * still distinguishes the two. Takes ownership of "input". */
+PRTE_EXPORT int prte_util_regex_memo_add(prte_regex_memo_t *memo, const char *key,
+                                         char *input, bool ppn, void *ilist);
+
 #endif /* PRTE_NIDMAP_H */
@@ -78,6 +78,7 @@ PRTE_EXPORT prte_process_info_t prte_process_info = {
 
 static bool init = false;
 static char *prte_strip_prefix;
+static char *prte_emulated_hostname;
 
 void prte_setup_hostname(void)
 {
@@ -94,6 +95,22 @@ void prte_setup_hostname(void)
                                       PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                       &prte_keep_fqdn_hostnames);
 
+    /* a process told which node it is stands in for that node, whatever
+     * host it is really on - this is how many daemons on one machine each
+     * emulate a separate (simulated) node for scale testing. None of the
+     * real host's names are claimed as aliases: every daemon on the host
+     * would claim the same ones */
+    prte_emulated_hostname = NULL;
+    (void) pmix_mca_base_var_register("prte", "prte", NULL, "hostname",
+                                      "Name to use for the node this process is on instead of the one "
+                                      "the OS reports (for emulating many nodes on one host)",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_emulated_hostname);
+    if (NULL != prte_emulated_hostname && '\0' != prte_emulated_hostname[0]) {
+        prte_process_info.nodename = strdup(prte_emulated_hostname);
+        return;
+    }
+
     /* get the nodename. POSIX does not require gethostname() to terminate
      * the buffer when the name does not fit, so leave room and terminate it
      * ourselves - and fall back to something usable if the call fails, since
@@ -76,6 +76,7 @@ BEGIN_C_DECLS
 #define PRTE_CLI_SET_SID                "set-sid"                   // none
 #define PRTE_CLI_REPORT_PID             "report-pid"                // required
 #define PRTE_CLI_REPORT_URI             "report-uri"                // required
+#define PRTE_CLI_REPORT_STARTUP         "report-startup"            // required
 #define PRTE_CLI_DEFAULT_HOSTFILE       "default-hostfile"          // required
 #define PRTE_CLI_SINGLETON              "singleton"                 // required
 #define PRTE_CLI_KEEPALIVE              "keepalive"                 // required
@@ -213,6 +214,7 @@ BEGIN_C_DECLS
 #define PRTE_CLI_TOPO       	"topo="
 #define PRTE_CLI_CPUS       	"cpus="
 #define PRTE_CLI_PHYSICAL_CPUS 	"physical"
+#define PRTE_CLI_JSON       	"json"
 
 // Runtime directives
 #define PRTE_CLI_ERROR_NZ           "error-nonzero-status"          // optional arg
@@ -0,0 +1,426 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if PRTE_HAVE_LZ4
+#    include <lz4.h>
+#endif
+#if PRTE_HAVE_ZSTD
+#    include <zstd.h>
+#endif
+
+#include "constants.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_output.h"
+
+#include "src/util/prte_compress.h"
+
+char *prte_compress_codecs = NULL;
+int prte_compress_link_bandwidth = 1250;
+int prte_compress_min_size = 4096;
+int prte_compress_zstd_level = 3;
+char *prte_compress_zstd_dict = NULL;
+
+/* What a codec does to a payload: it runs at "rate" bytes of input per
+ * second and leaves "ratio" of them.  The starting figures are the modex
+ * corpus grpcomm_xcast.c quotes for deflate and zstd, and typical ones for
+ * LZ4 and a primed zstd; every measurement then moves them a quarter of the
+ * way toward what this process actually sees. */
+typedef struct {
+    const char *name;
+    // this process can encode and decode it
+    bool usable;
+    // the sender may choose it (prte_compress_codecs)
+    bool allowed;
+    double rate;
+    double ratio;
+    // payloads chosen for since it was last measured
+    unsigned idle;
+} codec_t;
+
+static codec_t codecs[PRTE_COMPRESS_NCODECS] = {
+    [PRTE_COMPRESS_NONE] = {"none", true, false, 0.0, 1.0, 0},
+    [PRTE_COMPRESS_DEFLATE] = {"deflate", true, false, 103e6, 0.65, 0},
+    [PRTE_COMPRESS_LZ4] = {"lz4", PRTE_HAVE_LZ4, false, 2000e6, 0.80, 0},
+    [PRTE_COMPRESS_ZSTD] = {"zstd", PRTE_HAVE_ZSTD, false, 434e6, 0.63, 0},
+    // usable only once its dictionary has loaded
+    [PRTE_COMPRESS_ZSTD_DICT] = {"zstd_dict", false, false, 434e6, 0.55, 0},
+};
+
+/* Timing a small payload measures the codec's start-up, not its rate */
+#define MEASURE_MIN (64 * 1024)
+/* A codec the cost model has not picked for this many payloads gets the
+ * next one between MEASURE_MIN and PROBE_MAX, so that its figures follow the
+ * payloads rather than staying at whatever first ruled it out.  The bound
+ * keeps a probe with a slow codec from stalling on a large broadcast. */
+#define PROBE_INTERVAL 64
+#define PROBE_MAX (1024 * 1024)
+
+#define LZ4_HDR 8
+
+static bool ready = false;
+#if PRTE_HAVE_ZSTD
+static ZSTD_CCtx *cctx = NULL;
+static ZSTD_DCtx *dctx = NULL;
+static ZSTD_CDict *cdict = NULL;
+static ZSTD_DDict *ddict = NULL;
+
+static void load_dict(void)
+{
+    FILE *fp;
+    void *buf = NULL;
+    long sz;
+
+    if (NULL == prte_compress_zstd_dict) {
+        return;
+    }
+    fp = fopen(prte_compress_zstd_dict, "r");
+    if (NULL == fp) {
+        pmix_output(0, "%s zstd dictionary %s could not be opened - not used",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), prte_compress_zstd_dict);
+        return;
+    }
+    if (0 == fseek(fp, 0, SEEK_END) && 0 < (sz = ftell(fp)) && 0 == fseek(fp, 0, SEEK_SET)
+        && NULL != (buf = malloc(sz)) && 1 == fread(buf, sz, 1, fp)) {
+        cdict = ZSTD_createCDict(buf, sz, prte_compress_zstd_level);
+        ddict = ZSTD_createDDict(buf, sz);
+    }
+    free(buf);
+    fclose(fp);
+    if (NULL == cdict || NULL == ddict) {
+        pmix_output(0, "%s zstd dictionary %s could not be loaded - not used",
+                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), prte_compress_zstd_dict);
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+        cdict = NULL;
+        ddict = NULL;
+        return;
+    }
+    codecs[PRTE_COMPRESS_ZSTD_DICT].usable = true;
+}
+#endif
+
+static void setup(void)
+{
+    char **names;
+    int n, c;
+
+    if (ready) {
+        return;
+    }
+    ready = true;
+#if PRTE_HAVE_ZSTD
+    load_dict();
+#endif
+
+    for (c = PRTE_COMPRESS_DEFLATE; c < PRTE_COMPRESS_NCODECS; c++) {
+        codecs[c].allowed = false;
+    }
+    if (NULL == prte_compress_codecs) {
+        for (c = PRTE_COMPRESS_DEFLATE; c < PRTE_COMPRESS_NCODECS; c++) {
+            codecs[c].allowed = codecs[c].usable;
+        }
+        return;
+    }
+    names = PMIx_Argv_split(prte_compress_codecs, ',');
+    for (n = 0; NULL != names && NULL != names[n]; n++) {
+        if (0 == strcmp(names[n], "none")) {
+            continue;
+        }
+        for (c = PRTE_COMPRESS_DEFLATE; c < PRTE_COMPRESS_NCODECS; c++) {
+            if (0 == strcmp(names[n], codecs[c].name)) {
+                break;
+            }
+        }
+        if (PRTE_COMPRESS_NCODECS == c || !codecs[c].usable) {
+            pmix_output(0, "%s compression codec %s is not available - ignored",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), names[n]);
+            continue;
+        }
+        codecs[c].allowed = true;
+    }
+    PMIx_Argv_free(names);
+}
+
+void prte_compress_finalize(void)
+{
+#if PRTE_HAVE_ZSTD
+    ZSTD_freeCCtx(cctx);
+    ZSTD_freeDCtx(dctx);
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+    cctx = NULL;
+    dctx = NULL;
+    cdict = NULL;
+    ddict = NULL;
+    codecs[PRTE_COMPRESS_ZSTD_DICT].usable = false;
+#endif
+    ready = false;
+}
+
+const char *prte_compress_codec_name(prte_compress_codec_t codec)
+{
+    if (PRTE_COMPRESS_NCODECS <= codec) {
+        return "unknown";
+    }
+    return codecs[codec].name;
+}
+
+prte_compress_codec_t prte_compress_choose(size_t nbytes, double fanout)
+{
+    prte_compress_codec_t best = PRTE_COMPRESS_NONE, probe = PRTE_COMPRESS_NONE;
+    double bw, cost, best_cost;
+    int c;
+
+    setup();
+    if (nbytes < (size_t) prte_compress_min_size || 0.0 >= fanout) {
+        return PRTE_COMPRESS_NONE;
+    }
+    bw = 1e6 * (0 < prte_compress_link_bandwidth ? prte_compress_link_bandwidth : 1);
+
+    /* per byte of payload: sending it raw costs fanout / B; compressing it
+     * costs 1 / R and then sending what is left, fanout * rho / B */
+    best_cost = fanout / bw;
+    for (c = PRTE_COMPRESS_DEFLATE; c < PRTE_COMPRESS_NCODECS; c++) {
+        if (!codecs[c].allowed) {
+            continue;
+        }
+        cost = 1.0 / codecs[c].rate + fanout * codecs[c].ratio / bw;
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = c;
+        }
+    }
+
+    if (MEASURE_MIN <= nbytes && nbytes <= PROBE_MAX) {
+        for (c = PRTE_COMPRESS_DEFLATE; c < PRTE_COMPRESS_NCODECS; c++) {
+            if (!codecs[c].allowed || c == best) {
+                continue;
+            }
+            if (PROBE_INTERVAL <= ++codecs[c].idle && PRTE_COMPRESS_NONE == probe) {
+                probe = c;
+            }
+        }
+        if (PRTE_COMPRESS_NONE != probe) {
+            return probe;
+        }
+    }
+    return best;
+}
+
+static void measure(prte_compress_codec_t codec, size_t inlen, size_t outlen,
+                    const struct timespec *t0, const struct timespec *t1)
+{
+    double secs;
+
+    if (inlen < MEASURE_MIN) {
+        return;
+    }
+    secs = (double) (t1->tv_sec - t0->tv_sec) + 1e-9 * (double) (t1->tv_nsec - t0->tv_nsec);
+    if (0.0 < secs) {
+        codecs[codec].rate += 0.25 * ((double) inlen / secs - codecs[codec].rate);
+    }
+    codecs[codec].ratio += 0.25 * ((double) outlen / (double) inlen - codecs[codec].ratio);
+}
+
+static bool encode(prte_compress_codec_t codec, const uint8_t *in, size_t inlen, uint8_t **out,
+                   size_t *outlen)
+{
+    switch (codec) {
+    case PRTE_COMPRESS_DEFLATE:
+        /* PMIx declines what it judges too small or incompressible */
+        return PMIx_Data_compress(in, inlen, out, outlen);
+#if PRTE_HAVE_LZ4
+    case PRTE_COMPRESS_LZ4: {
+        uint8_t *buf;
+        size_t cap;
+        int i, n;
+
+        /* LZ4's block format does not carry the original size - ours does,
+         * in front, most significant byte first */
+        if (LZ4_MAX_INPUT_SIZE < inlen) {
+            return false;
+        }
+        cap = LZ4_HDR + LZ4_compressBound((int) inlen);
+        buf = (uint8_t *) malloc(cap);
+        if (NULL == buf) {
+            return false;
+        }
+        for (i = 0; i < LZ4_HDR; i++) {
+            buf[i] = (uint8_t) ((uint64_t) inlen >> (8 * (LZ4_HDR - 1 - i)));
+        }
+        n = LZ4_compress_default((const char *) in, (char *) buf + LZ4_HDR, (int) inlen,
+                                 (int) (cap - LZ4_HDR));
+        if (0 >= n) {
+            free(buf);
+            return false;
+        }
+        *out = buf;
+        *outlen = LZ4_HDR + n;
+        return true;
+    }
+#endif
+#if PRTE_HAVE_ZSTD
+    case PRTE_COMPRESS_ZSTD:
+    case PRTE_COMPRESS_ZSTD_DICT: {
+        uint8_t *buf;
+        size_t cap, n;
+
+        if (NULL == cctx && NULL == (cctx = ZSTD_createCCtx())) {
+            return false;
+        }
+        cap = ZSTD_compressBound(inlen);
+        buf = (uint8_t *) malloc(cap);
+        if (NULL == buf) {
+            return false;
+        }
+        /* the frame records the original size, and the dictionary's ID */
+        if (PRTE_COMPRESS_ZSTD_DICT == codec) {
+            n = ZSTD_compress_usingCDict(cctx, buf, cap, in, inlen, cdict);
+        } else {
+            n = ZSTD_compressCCtx(cctx, buf, cap, in, inlen, prte_compress_zstd_level);
+        }
+        if (ZSTD_isError(n)) {
+            free(buf);
+            return false;
+        }
+        *out = buf;
+        *outlen = n;
+        return true;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+prte_compress_codec_t prte_compress(const uint8_t *in, size_t inlen, double fanout,
+                                    uint8_t **out, size_t *outlen)
+{
+    prte_compress_codec_t codec;
+    struct timespec t0, t1;
+    uint8_t *buf = NULL;
+    size_t len = 0;
+    bool ok;
+
+    codec = prte_compress_choose(inlen, fanout);
+    if (PRTE_COMPRESS_NONE == codec) {
+        return PRTE_COMPRESS_NONE;
+    }
+    codecs[codec].idle = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    ok = encode(codec, in, inlen, &buf, &len);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!ok) {
+        return PRTE_COMPRESS_NONE;
+    }
+    measure(codec, inlen, len, &t0, &t1);
+    if (len >= inlen) {
+        free(buf);
+        return PRTE_COMPRESS_NONE;
+    }
+    *out = buf;
+    *outlen = len;
+    return codec;
+}
+
+bool prte_decompress(prte_compress_codec_t codec, const uint8_t *in, size_t inlen, uint8_t **out,
+                     size_t *outlen)
+{
+    uint8_t *buf;
+
+    setup();
+    switch (codec) {
+    case PRTE_COMPRESS_NONE:
+        buf = (uint8_t *) malloc(0 < inlen ? inlen : 1);
+        if (NULL == buf) {
+            return false;
+        }
+        memcpy(buf, in, inlen);
+        *out = buf;
+        *outlen = inlen;
+        return true;
+    case PRTE_COMPRESS_DEFLATE:
+        return PMIx_Data_decompress(in, inlen, out, outlen);
+#if PRTE_HAVE_LZ4
+    case PRTE_COMPRESS_LZ4: {
+        uint64_t raw;
+        int i;
+
+        if (LZ4_HDR > inlen) {
+            return false;
+        }
+        raw = 0;
+        for (i = 0; i < LZ4_HDR; i++) {
+            raw = (raw << 8) | in[i];
+        }
+        if (LZ4_MAX_INPUT_SIZE < raw || INT_MAX < inlen - LZ4_HDR) {
+            return false;
+        }
+        buf = (uint8_t *) malloc(0 < raw ? raw : 1);
+        if (NULL == buf) {
+            return false;
+        }
+        if ((int) raw != LZ4_decompress_safe((const char *) in + LZ4_HDR, (char *) buf,
+                                             (int) (inlen - LZ4_HDR), (int) raw)) {
+            free(buf);
+            return false;
+        }
+        *out = buf;
+        *outlen = raw;
+        return true;
+    }
+#endif
+#if PRTE_HAVE_ZSTD
+    case PRTE_COMPRESS_ZSTD:
+    case PRTE_COMPRESS_ZSTD_DICT: {
+        unsigned long long sz;
+        size_t n;
+
+        if (PRTE_COMPRESS_ZSTD_DICT == codec && NULL == ddict) {
+            return false;
+        }
+        if (NULL == dctx && NULL == (dctx = ZSTD_createDCtx())) {
+            return false;
+        }
+        sz = ZSTD_getFrameContentSize(in, inlen);
+        if (ZSTD_CONTENTSIZE_UNKNOWN == sz || ZSTD_CONTENTSIZE_ERROR == sz) {
+            return false;
+        }
+        buf = (uint8_t *) malloc(0 < sz ? sz : 1);
+        if (NULL == buf) {
+            return false;
+        }
+        if (PRTE_COMPRESS_ZSTD_DICT == codec) {
+            n = ZSTD_decompress_usingDDict(dctx, buf, sz, in, inlen, ddict);
+        } else {
+            n = ZSTD_decompressDCtx(dctx, buf, sz, in, inlen);
+        }
+        if (ZSTD_isError(n) || n != sz) {
+            free(buf);
+            return false;
+        }
+        *out = buf;
+        *outlen = n;
+        return true;
+    }
+#endif
+    default:
+        return false;
+    }
+}
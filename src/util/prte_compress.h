@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/** @file:
+ *
+ * Control-plane payload compression with a choice of codec.
+ *
+ * PMIx_Data_compress offers one codec - whichever pcompress component PMIx
+ * selected, deflate in practice - and its answer is only "compressed or
+ * not".  That is the right codec for a slow link and the wrong one for a
+ * fast one: deflate runs at about 100 MB/s, and on a 10-25 GbE link a
+ * mid-sized launch message gets to its children sooner raw than deflated.
+ * This layer adds LZ4 and zstd (when configure found them) next to PMIx's
+ * deflate and picks one per payload.
+ *
+ * The choice is the cost model grpcomm_xcast.c derives: a codec that runs at
+ * R bytes/sec and leaves a fraction rho of its input pays off iff
+ *
+ *     R  >  B / (fanout * (1 - rho))
+ *
+ * where B is the link bandwidth and fanout the number of links the payload
+ * crosses in series on the critical path (d * k for a broadcast down a
+ * radix-k tree of depth d, the hop count for one message up it).  Of the
+ * codecs that pay off, the one with the least total time wins.  R and rho are
+ * not constants: each codec starts from a typical figure and then tracks
+ * what it actually achieves on this process's payloads.
+ *
+ * The codec used travels with the payload as a prte_compress_codec_t
+ * (packed as PMIX_UINT8), so a receiver always knows how to decode it.
+ * Every daemon must therefore have the codecs its senders can pick - the
+ * same build and, for PRTE_COMPRESS_ZSTD_DICT, the same dictionary file.
+ *
+ * Not thread safe: the measurements are plain variables updated by the
+ * caller, and every caller is on the progress thread.
+ */
+
+#ifndef PRTE_UTIL_COMPRESS_H
+#define PRTE_UTIL_COMPRESS_H
+
+#include "prte_config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "src/pmix/pmix-internal.h"
+
+BEGIN_C_DECLS
+
+typedef uint8_t prte_compress_codec_t;
+#define PRTE_COMPRESS_CODEC_T PMIX_UINT8
+
+#define PRTE_COMPRESS_NONE      0
+// PMIx_Data_compress - whatever pcompress component PMIx selected
+#define PRTE_COMPRESS_DEFLATE   1
+#define PRTE_COMPRESS_LZ4       2
+#define PRTE_COMPRESS_ZSTD      3
+// zstd primed with the dictionary named by prte_compress_zstd_dict
+#define PRTE_COMPRESS_ZSTD_DICT 4
+#define PRTE_COMPRESS_NCODECS   5
+
+/* Comma-delimited codecs the sender may choose from ("deflate", "lz4",
+ * "zstd", "zstd_dict"), or "none".  NULL (the default) allows every codec
+ * this build has. */
+PRTE_EXPORT extern char *prte_compress_codecs;
+// link bandwidth the cost model assumes, in MB/s
+PRTE_EXPORT extern int prte_compress_link_bandwidth;
+// payloads smaller than this are never compressed
+PRTE_EXPORT extern int prte_compress_min_size;
+// zstd compression level
+PRTE_EXPORT extern int prte_compress_zstd_level;
+// path to a zstd dictionary trained on launch messages, or NULL
+PRTE_EXPORT extern char *prte_compress_zstd_dict;
+
+PRTE_EXPORT void prte_compress_finalize(void);
+
+PRTE_EXPORT const char *prte_compress_codec_name(prte_compress_codec_t codec);
+
+/* The codec the cost model picks for a payload of nbytes crossing "fanout"
+ * links in series - PRTE_COMPRESS_NONE when sending it raw is quickest. */
+PRTE_EXPORT prte_compress_codec_t prte_compress_choose(size_t nbytes, double fanout);
+
+/* Compress a payload with the codec prte_compress_choose() picks and return
+ * that codec.  On PRTE_COMPRESS_NONE - not worth it, or the result was no
+ * smaller - *out is untouched and the caller sends the input as it is;
+ * otherwise *out is malloc'd and belongs to the caller. */
+PRTE_EXPORT prte_compress_codec_t prte_compress(const uint8_t *in, size_t inlen, double fanout,
+                                                uint8_t **out, size_t *outlen);
+
+/* Undo prte_compress().  *out is malloc'd and belongs to the caller.  False
+ * if this process cannot decode that codec or the payload is corrupt. */
+PRTE_EXPORT bool prte_decompress(prte_compress_codec_t codec, const uint8_t *in, size_t inlen,
+                                 uint8_t **out, size_t *outlen);
+
+END_C_DECLS
+
+#endif /* PRTE_UTIL_COMPRESS_H */
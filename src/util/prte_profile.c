@@ -0,0 +1,437 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+#ifdef HAVE_SYS_RESOURCE_H
+#    include <sys/resource.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_MALLINFO2
+#    include <malloc.h>
+#endif
+
+#include "constants.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_output.h"
+#include "src/util/proc_info.h"
+
+#include "src/util/prte_profile.h"
+
+char *prte_profile_stage_report = NULL;
+bool prte_profile_enabled = false;
+
+static FILE *report = NULL;
+static bool report_is_file = false;
+
+static FILE *startup_fp = NULL;
+static bool startup_is_file = false;
+static char *startup_dest = NULL;
+
+/* this process's own startup phases - names are literals, so only the
+ * pointer is kept */
+#define PRTE_PROFILE_MAX_PHASES 32
+typedef struct {
+    const char *name;
+    uint64_t us;
+} startup_phase_t;
+static startup_phase_t phases[PRTE_PROFILE_MAX_PHASES];
+static int nphases = 0;
+static bool startup_begun = false;
+static struct timespec startup_last;
+
+/* the HNP's view across the DVM: each daemon's time in each phase */
+typedef struct {
+    char *name;
+    uint64_t *us;
+    pmix_rank_t *daemon;
+    int n;
+    int size;
+} startup_dvm_phase_t;
+static startup_dvm_phase_t dvm[PRTE_PROFILE_MAX_PHASES];
+static int ndvm = 0;
+static int nreported = 0;
+
+static FILE *open_report(const char *dest, FILE **fp, bool *is_file, bool *enabled)
+{
+    if (NULL != *fp) {
+        return *fp;
+    }
+    if (NULL == dest) {
+        return NULL;
+    }
+    if (0 == strcmp(dest, "stdout")) {
+        *fp = stdout;
+    } else if (0 == strcmp(dest, "stderr")) {
+        *fp = stderr;
+    } else {
+        /* appended to, so successive runs pointed at the same file - a
+         * harness sweeping a parameter - accumulate rather than overwrite */
+        *fp = fopen(dest, "a");
+        if (NULL == *fp) {
+            /* say so once, and stop trying */
+            pmix_output(0, "%s report %s could not be opened - profiling disabled",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), dest);
+            *enabled = false;
+            return NULL;
+        }
+        *is_file = true;
+    }
+    return *fp;
+}
+
+static FILE *get_report(void)
+{
+    return open_report(prte_profile_stage_report, &report, &report_is_file,
+                       &prte_profile_enabled);
+}
+
+static FILE *get_startup_report(void)
+{
+    return open_report((NULL != startup_dest) ? startup_dest : prte_profile_startup_report,
+                       &startup_fp, &startup_is_file, &prte_profile_startup_enabled);
+}
+
+void prte_profile_finalize(void)
+{
+    int i;
+
+    if (NULL != report && report_is_file) {
+        fclose(report);
+    }
+    report = NULL;
+    report_is_file = false;
+
+    if (NULL != startup_fp && startup_is_file) {
+        fclose(startup_fp);
+    }
+    startup_fp = NULL;
+    startup_is_file = false;
+    free(startup_dest);
+    startup_dest = NULL;
+    for (i = 0; i < ndvm; i++) {
+        free(dvm[i].name);
+        free(dvm[i].us);
+        free(dvm[i].daemon);
+    }
+    memset(dvm, 0, sizeof(dvm));
+    ndvm = 0;
+    nreported = 0;
+}
+
+void prte_profile_mark(prte_profile_mark_t *mark)
+{
+    clock_gettime(CLOCK_MONOTONIC, &mark->ts);
+#ifdef HAVE_MALLINFO2
+    {
+        struct mallinfo2 mi = mallinfo2();
+        mark->heap = mi.uordblks + mi.hblkhd;
+    }
+#else
+    mark->heap = 0;
+#endif
+}
+
+uint64_t prte_profile_elapsed_us(const prte_profile_mark_t *start,
+                                 const prte_profile_mark_t *end)
+{
+    int64_t us;
+
+    us = (int64_t) (end->ts.tv_sec - start->ts.tv_sec) * 1000000
+         + (end->ts.tv_nsec - start->ts.tv_nsec) / 1000;
+    return (0 > us) ? 0 : (uint64_t) us;
+}
+
+long prte_profile_peak_rss_kb(void)
+{
+#ifdef HAVE_SYS_RESOURCE_H
+    struct rusage ru;
+
+    if (0 == getrusage(RUSAGE_SELF, &ru)) {
+        /* KB on Linux and the BSDs; macOS reports bytes */
+#ifdef __APPLE__
+        return ru.ru_maxrss / 1024;
+#else
+        return ru.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+void prte_profile_stage(const char *stage, const char *job,
+                        const prte_profile_mark_t *start, size_t bytes)
+{
+    prte_profile_mark_t now;
+    FILE *fp;
+    long long delta;
+
+    fp = get_report();
+    if (NULL == fp) {
+        return;
+    }
+    prte_profile_mark(&now);
+    /* the heap can shrink across a stage that frees more than it keeps */
+    delta = (long long) now.heap - (long long) start->heap;
+
+    fprintf(fp,
+            "{\"stage\":\"%s\",\"job\":\"%s\",\"host\":\"%s\",\"pid\":%lu,"
+            "\"wall_us\":%llu,\"heap_delta\":%lld,\"heap_bytes\":%llu,"
+            "\"peak_rss_kb\":%ld,\"bytes\":%llu}\n",
+            stage, (NULL == job) ? "" : job,
+            (NULL == prte_process_info.nodename) ? "" : prte_process_info.nodename,
+            (unsigned long) getpid(),
+            (unsigned long long) prte_profile_elapsed_us(start, &now),
+            delta, (unsigned long long) now.heap,
+            prte_profile_peak_rss_kb(), (unsigned long long) bytes);
+    fflush(fp);
+}
+
+void prte_profile_launch(pmix_rank_t daemon, const char *host, int nlaunched,
+                         uint64_t spawn_us, uint64_t mean_us, uint64_t max_us,
+                         int window, int peak_window)
+{
+    FILE *fp;
+
+    fp = get_report();
+    if (NULL == fp) {
+        return;
+    }
+    fprintf(fp,
+            "{\"stage\":\"daemon_launch\",\"daemon\":%u,\"host\":\"%s\","
+            "\"launched\":%d,\"spawn_us\":%llu,\"agent_mean_us\":%llu,"
+            "\"agent_max_us\":%llu,\"window\":%d,\"peak_window\":%d}\n",
+            (unsigned) daemon, (NULL == host) ? "" : host, nlaunched,
+            (unsigned long long) spawn_us, (unsigned long long) mean_us,
+            (unsigned long long) max_us, window, peak_window);
+    fflush(fp);
+}
+
+char *prte_profile_startup_report = NULL;
+bool prte_profile_startup_enabled = false;
+
+void prte_profile_startup_set_report(const char *dest)
+{
+    free(startup_dest);
+    startup_dest = strdup(dest);
+    prte_profile_startup_enabled = (0 != strcmp(dest, "none"));
+}
+
+void prte_profile_startup_begin(void)
+{
+    if (!startup_begun) {
+        clock_gettime(CLOCK_MONOTONIC, &startup_last);
+        startup_begun = true;
+    }
+}
+
+void prte_profile_startup_phase(const char *phase)
+{
+    struct timespec now;
+    int64_t us;
+
+    if (!startup_begun) {
+        /* nothing to measure this phase from */
+        prte_profile_startup_begin();
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    us = (int64_t) (now.tv_sec - startup_last.tv_sec) * 1000000
+         + (now.tv_nsec - startup_last.tv_nsec) / 1000;
+    if (PRTE_PROFILE_MAX_PHASES > nphases) {
+        phases[nphases].name = phase;
+        phases[nphases].us = (0 > us) ? 0 : (uint64_t) us;
+        ++nphases;
+    }
+    startup_last = now;
+}
+
+int prte_profile_startup_pack(pmix_data_buffer_t *buf)
+{
+    int32_t n = nphases;
+    pmix_status_t rc;
+    int i;
+
+    rc = PMIx_Data_pack(NULL, buf, &n, 1, PMIX_INT32);
+    for (i = 0; PMIX_SUCCESS == rc && i < nphases; i++) {
+        rc = PMIx_Data_pack(NULL, buf, (void *) &phases[i].name, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buf, &phases[i].us, 1, PMIX_UINT64);
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+static void dvm_add(const char *name, pmix_rank_t daemon, uint64_t us)
+{
+    startup_dvm_phase_t *p = NULL;
+    uint64_t *u;
+    pmix_rank_t *d;
+    int i;
+
+    for (i = 0; i < ndvm; i++) {
+        if (0 == strcmp(dvm[i].name, name)) {
+            p = &dvm[i];
+            break;
+        }
+    }
+    if (NULL == p) {
+        if (PRTE_PROFILE_MAX_PHASES == ndvm) {
+            return;
+        }
+        p = &dvm[ndvm];
+        p->name = strdup(name);
+        if (NULL == p->name) {
+            return;
+        }
+        ++ndvm;
+    }
+    if (p->n == p->size) {
+        i = (0 == p->size) ? 16 : 2 * p->size;
+        u = (uint64_t *) realloc(p->us, i * sizeof(uint64_t));
+        if (NULL == u) {
+            return;
+        }
+        p->us = u;
+        d = (pmix_rank_t *) realloc(p->daemon, i * sizeof(pmix_rank_t));
+        if (NULL == d) {
+            return;
+        }
+        p->daemon = d;
+        p->size = i;
+    }
+    p->us[p->n] = us;
+    p->daemon[p->n] = daemon;
+    ++p->n;
+}
+
+int prte_profile_startup_add(pmix_rank_t daemon, const char *host,
+                             pmix_data_buffer_t *buf)
+{
+    FILE *fp;
+    int32_t n, i, cnt;
+    char *name;
+    uint64_t us, total = 0;
+    pmix_status_t rc;
+
+    if (NULL == buf) {
+        n = nphases;
+    } else {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &n, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return nreported;
+        }
+    }
+
+    fp = get_startup_report();
+    if (NULL != fp) {
+        fprintf(fp, "{\"startup\":\"daemon\",\"daemon\":%u,\"host\":\"%s\",\"phases\":{",
+                (unsigned) daemon, (NULL == host) ? "" : host);
+    }
+    for (i = 0; i < n; i++) {
+        if (NULL == buf) {
+            name = (char *) phases[i].name;
+            us = phases[i].us;
+        } else {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, buf, &name, &cnt, PMIX_STRING);
+            if (PMIX_SUCCESS == rc) {
+                cnt = 1;
+                rc = PMIx_Data_unpack(NULL, buf, &us, &cnt, PMIX_UINT64);
+                if (PMIX_SUCCESS != rc) {
+                    free(name);
+                }
+            }
+            if (PMIX_SUCCESS != rc) {
+                /* keep what arrived intact and close the line */
+                PMIX_ERROR_LOG(rc);
+                break;
+            }
+        }
+        dvm_add(name, daemon, us);
+        total += us;
+        if (NULL != fp) {
+            fprintf(fp, "%s\"%s\":%llu", (0 == i) ? "" : ",", name, (unsigned long long) us);
+        }
+        if (NULL != buf) {
+            free(name);
+        }
+    }
+    if (NULL != fp) {
+        fprintf(fp, "},\"total_us\":%llu}\n", (unsigned long long) total);
+        fflush(fp);
+    }
+    return ++nreported;
+}
+
+static int cmp_us(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+void prte_profile_startup_summary(void)
+{
+    FILE *fp;
+    uint64_t *sorted, median;
+    pmix_rank_t maxd;
+    int i, j, n;
+
+    fp = get_startup_report();
+    if (NULL == fp) {
+        return;
+    }
+    for (i = 0; i < ndvm; i++) {
+        n = dvm[i].n;
+        if (0 == n) {
+            continue;
+        }
+        sorted = (uint64_t *) malloc(n * sizeof(uint64_t));
+        if (NULL == sorted) {
+            return;
+        }
+        memcpy(sorted, dvm[i].us, n * sizeof(uint64_t));
+        qsort(sorted, n, sizeof(uint64_t), cmp_us);
+        median = (sorted[(n - 1) / 2] + sorted[n / 2]) / 2;
+        /* the slowest daemon is the one worth going to look at */
+        maxd = dvm[i].daemon[0];
+        for (j = 1; j < n; j++) {
+            if (dvm[i].us[j] == sorted[n - 1]) {
+                maxd = dvm[i].daemon[j];
+                break;
+            }
+        }
+        fprintf(fp,
+                "{\"startup\":\"phase\",\"phase\":\"%s\",\"daemons\":%d,"
+                "\"min_us\":%llu,\"median_us\":%llu,\"max_us\":%llu,\"max_daemon\":%u}\n",
+                dvm[i].name, n, (unsigned long long) sorted[0],
+                (unsigned long long) median, (unsigned long long) sorted[n - 1],
+                (unsigned) maxd);
+        free(sorted);
+    }
+    fflush(fp);
+}
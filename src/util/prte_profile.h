@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/** @file:
+ *
+ * Control-plane stage profiling.
+ *
+ * A "stage" is one piece of the per-job work the HNP does before anything
+ * is launched - allocating, mapping, building the launch message,
+ * registering the namespace.  Each is bracketed by a mark taken when it
+ * starts and a report written when it completes, and the report is one
+ * JSON object per line so a harness (test/bench) can read it without
+ * scraping.  Every report carries the stage's wall time, how much the heap
+ * in use grew across it, and the process's peak resident set size at its
+ * end - ru_maxrss only ever grows, so the peak is "as of" the stage, not
+ * "of" it.
+ *
+ * The ssh launcher adds a "daemon_launch" line for every daemon that
+ * launched others - the HNP's own, and those its tree-spawned daemons send
+ * it - so the launch of the DVM itself can be read off the same report.
+ *
+ * Obtaining the local topology is reported once per process, as
+ * "topology" when hwloc discovered it and "topology_cached" when it came
+ * from the node's topology cache, so the cost of a daemon's start can be
+ * compared with and without the cache.
+ *
+ * Off unless the prte_stage_report MCA parameter names a destination, and
+ * then the cost of a disabled site is the one branch in the macros below.
+ *
+ * Startup phases are the other half: prte_init() and the daemon setup
+ * mark the end of each phase of a process's startup - parameter
+ * registration, topology, session directory, PMIx server, OOB and so on.
+ * Recording is unconditional (a clock read into a fixed table - the MCA
+ * parameter that would turn it on is not registered yet when the first
+ * phase ends). When prte_startup_report (or prte's --report-startup)
+ * names a destination, each daemon sends its table to the HNP once it has
+ * reported in, and the HNP writes one "daemon" line per daemon and, each
+ * time every daemon in the DVM has reported, one "phase" line per phase
+ * with its min/median/max across the DVM.
+ */
+
+#ifndef PRTE_UTIL_PROFILE_H
+#define PRTE_UTIL_PROFILE_H
+
+#include "prte_config.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#include "src/pmix/pmix-internal.h"
+
+BEGIN_C_DECLS
+
+typedef struct {
+    struct timespec ts;
+    // bytes of heap in use, where the allocator can tell us - zero otherwise
+    size_t heap;
+} prte_profile_mark_t;
+
+/* Where stage reports go: "stdout", "stderr", or a file appended to.
+ * NULL (the default) leaves profiling off. */
+PRTE_EXPORT extern char *prte_profile_stage_report;
+PRTE_EXPORT extern bool prte_profile_enabled;
+
+PRTE_EXPORT void prte_profile_finalize(void);
+
+/* Take a mark now */
+PRTE_EXPORT void prte_profile_mark(prte_profile_mark_t *mark);
+
+/* Microseconds between two marks */
+PRTE_EXPORT uint64_t prte_profile_elapsed_us(const prte_profile_mark_t *start,
+                                             const prte_profile_mark_t *end);
+
+/* Peak resident set size of this process so far, in KB */
+PRTE_EXPORT long prte_profile_peak_rss_kb(void);
+
+/* Report a stage that began at "start" and ends now.  "job" may be NULL
+ * for a stage that belongs to no job; "bytes" is the size of whatever the
+ * stage produced (a message, a report) and zero where that means nothing. */
+PRTE_EXPORT void prte_profile_stage(const char *stage, const char *job,
+                                    const prte_profile_mark_t *start, size_t bytes);
+
+/* Report one daemon's part in launching the DVM: how many daemons it
+ * launched, how long from its first launch to its last completing, the mean
+ * and worst time a launch agent took, and the concurrency window it ended
+ * at and peaked at. */
+PRTE_EXPORT void prte_profile_launch(pmix_rank_t daemon, const char *host, int nlaunched,
+                                     uint64_t spawn_us, uint64_t mean_us, uint64_t max_us,
+                                     int window, int peak_window);
+
+/* Where the startup report goes, as for prte_stage_report. A daemon only
+ * tests it for "enabled" - the HNP is the one that writes. */
+PRTE_EXPORT extern char *prte_profile_startup_report;
+PRTE_EXPORT extern bool prte_profile_startup_enabled;
+
+/* Override the startup report destination (prte's --report-startup) */
+PRTE_EXPORT void prte_profile_startup_set_report(const char *dest);
+
+/* Start the startup clock - idempotent, so whichever of the init paths
+ * runs first owns the start */
+PRTE_EXPORT void prte_profile_startup_begin(void);
+
+/* Record that the phase named "phase" (a string literal) ends now; it
+ * began where the previous one ended */
+PRTE_EXPORT void prte_profile_startup_phase(const char *phase);
+
+/* Pack this process's phase table for the HNP */
+PRTE_EXPORT int prte_profile_startup_pack(pmix_data_buffer_t *buf);
+
+/* HNP: add one daemon's phase table (packed by prte_profile_startup_pack,
+ * or NULL for the HNP's own) to the report, returning how many daemons
+ * have now reported */
+PRTE_EXPORT int prte_profile_startup_add(pmix_rank_t daemon, const char *host,
+                                         pmix_data_buffer_t *buf);
+
+/* HNP: write the min/median/max of every phase across the daemons added */
+PRTE_EXPORT void prte_profile_startup_summary(void);
+
+#define PRTE_PROFILE_MARK(m)                 \
+    do {                                     \
+        if (prte_profile_enabled) {          \
+            prte_profile_mark(m);            \
+        }                                    \
+    } while (0)
+
+#define PRTE_PROFILE_STAGE(s, j, m, b)                  \
+    do {                                                \
+        if (prte_profile_enabled) {                     \
+            prte_profile_stage((s), (j), (m), (b));     \
+        }                                               \
+    } while (0)
+
+END_C_DECLS
+
+#endif /* PRTE_UTIL_PROFILE_H */
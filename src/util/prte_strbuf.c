@@ -0,0 +1,161 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "prte_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/util/prte_strbuf.h"
+
+void prte_strbuf_init(prte_strbuf_t *sb)
+{
+    sb->buf = NULL;
+    sb->len = 0;
+    sb->size = 0;
+    sb->failed = false;
+}
+
+/* room for n more characters plus the terminator */
+static bool reserve(prte_strbuf_t *sb, size_t n)
+{
+    size_t want;
+    char *tmp;
+
+    if (sb->failed) {
+        return false;
+    }
+    if (sb->len + n + 1 <= sb->size) {
+        return true;
+    }
+    want = (0 == sb->size) ? 256 : sb->size;
+    while (want < sb->len + n + 1) {
+        want *= 2;
+    }
+    tmp = (char *) realloc(sb->buf, want);
+    if (NULL == tmp) {
+        sb->failed = true;
+        return false;
+    }
+    sb->buf = tmp;
+    sb->size = want;
+    return true;
+}
+
+void prte_strbuf_append(prte_strbuf_t *sb, const char *str)
+{
+    size_t n;
+
+    if (NULL == str) {
+        return;
+    }
+    n = strlen(str);
+    if (!reserve(sb, n)) {
+        return;
+    }
+    memcpy(sb->buf + sb->len, str, n + 1);
+    sb->len += n;
+}
+
+void prte_strbuf_vprintf(prte_strbuf_t *sb, const char *fmt, va_list ap)
+{
+    va_list cp;
+    int n;
+
+    /* try in whatever room there is, and only grow if that was not enough */
+    if (!reserve(sb, 0)) {
+        return;
+    }
+    va_copy(cp, ap);
+    n = vsnprintf(sb->buf + sb->len, sb->size - sb->len, fmt, cp);
+    va_end(cp);
+    if (0 > n) {
+        sb->failed = true;
+        return;
+    }
+    if ((size_t) n >= sb->size - sb->len) {
+        if (!reserve(sb, (size_t) n)) {
+            return;
+        }
+        vsnprintf(sb->buf + sb->len, sb->size - sb->len, fmt, ap);
+    }
+    sb->len += (size_t) n;
+}
+
+void prte_strbuf_printf(prte_strbuf_t *sb, const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    prte_strbuf_vprintf(sb, fmt, ap);
+    va_end(ap);
+}
+
+void prte_strbuf_json_string(prte_strbuf_t *sb, const char *str)
+{
+    const unsigned char *p;
+    char esc[8];
+
+    if (NULL == str) {
+        prte_strbuf_append(sb, "null");
+        return;
+    }
+    prte_strbuf_append(sb, "\"");
+    for (p = (const unsigned char *) str; '\0' != *p; p++) {
+        switch (*p) {
+        case '"':
+            prte_strbuf_append(sb, "\\\"");
+            break;
+        case '\\':
+            prte_strbuf_append(sb, "\\\\");
+            break;
+        case '\n':
+            prte_strbuf_append(sb, "\\n");
+            break;
+        case '\t':
+            prte_strbuf_append(sb, "\\t");
+            break;
+        default:
+            if (0x20 > *p) {
+                snprintf(esc, sizeof(esc), "\\u%04x", *p);
+                prte_strbuf_append(sb, esc);
+            } else if (reserve(sb, 1)) {
+                sb->buf[sb->len++] = (char) *p;
+                sb->buf[sb->len] = '\0';
+            }
+            break;
+        }
+    }
+    prte_strbuf_append(sb, "\"");
+}
+
+char *prte_strbuf_release(prte_strbuf_t *sb)
+{
+    char *out;
+
+    if (sb->failed) {
+        prte_strbuf_free(sb);
+        return NULL;
+    }
+    if (NULL == sb->buf) {
+        out = strdup("");
+    } else {
+        out = sb->buf;
+    }
+    prte_strbuf_init(sb);
+    return out;
+}
+
+void prte_strbuf_free(prte_strbuf_t *sb)
+{
+    free(sb->buf);
+    prte_strbuf_init(sb);
+}
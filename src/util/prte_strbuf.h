@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/** @file:
+ *
+ * An append-only string that grows geometrically.
+ *
+ * The report printers (--display map, --display allocation) used to build
+ * their output by pmix_asprintf-ing the accumulated string onto itself,
+ * which copies everything written so far on every line - quadratic in the
+ * size of the report, and minutes of HNP time for a 100k-rank map.  Append
+ * to one of these instead and the whole report costs one pass.
+ *
+ * An allocation failure is remembered rather than returned from every call:
+ * the appends become no-ops and prte_strbuf_release() hands back NULL, which
+ * every printer already documents as "no output".
+ */
+
+#ifndef PRTE_UTIL_STRBUF_H
+#define PRTE_UTIL_STRBUF_H
+
+#include "prte_config.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+BEGIN_C_DECLS
+
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t size;
+    bool failed;
+} prte_strbuf_t;
+
+#define PRTE_STRBUF_STATIC_INIT {NULL, 0, 0, false}
+
+PRTE_EXPORT void prte_strbuf_init(prte_strbuf_t *sb);
+
+PRTE_EXPORT void prte_strbuf_append(prte_strbuf_t *sb, const char *str);
+
+PRTE_EXPORT void prte_strbuf_printf(prte_strbuf_t *sb, const char *fmt, ...)
+    __prte_attribute_format__(__printf__, 2, 3);
+
+PRTE_EXPORT void prte_strbuf_vprintf(prte_strbuf_t *sb, const char *fmt, va_list ap)
+    __prte_attribute_format__(__printf__, 2, 0);
+
+/* Append str as a JSON string literal, quotes and escapes included - or
+ * the literal null when str is NULL */
+PRTE_EXPORT void prte_strbuf_json_string(prte_strbuf_t *sb, const char *str);
+
+/* Take the string: the caller frees it, and the buffer is left empty.
+ * NULL if any append failed. */
+PRTE_EXPORT char *prte_strbuf_release(prte_strbuf_t *sb);
+
+PRTE_EXPORT void prte_strbuf_free(prte_strbuf_t *sb);
+
+END_C_DECLS
+
+#endif /* PRTE_UTIL_STRBUF_H */
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Launch-message microbenchmark.
+ *
+ * "prterun --rtos donotlaunch" on the simulator RAS measures allocation
+ * and mapping at any scale, but it stops before the stages that build
+ * what the HNP actually sends: with no daemons there is no daemon map to
+ * build and no launch message to pack.  This program fabricates what those
+ * stages read - a node pool in which every node has a daemon, and a job
+ * mapped across it - and runs them directly:
+ *
+ *   nidmap      prte_util_nidmap_create() over the whole pool
+ *   nidmap_update  prte_util_nidmap_pack_update(): a full snapshot on the
+ *               first repetition, when no daemon holds a map, and only the
+ *               (here empty) delta after that - the bytes are the WIREUP's
+ *               and the snapshot's together
+ *   job_pack    prte_job_pack() of the mapped job
+ *   job_unpack  prte_job_unpack() of that message, as a daemon would
+ *
+ * Each repetition emits one stage report per stage (see
+ * src/util/prte_profile.h), to stdout unless prte_stage_report says
+ * otherwise.  run_bench.py drives this across a node/ppn/policy sweep.
+ *
+ * usage: bench_launch_msg [-n nodes] [-p ppn] [-m slot|node] [-r reps]
+ */
+
+#include "prte_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "constants.h"
+#include "types.h"
+
+#include "src/class/pmix_pointer_array.h"
+#include "src/mca/rmaps/rmaps_types.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/runtime/prte_globals.h"
+#include "src/runtime/runtime.h"
+#include "src/util/nidmap.h"
+#include "src/util/proc_info.h"
+#include "src/util/prte_profile.h"
+
+static void fresh_array(pmix_pointer_array_t **array)
+{
+    *array = PMIX_NEW(pmix_pointer_array_t);
+    pmix_pointer_array_init(*array, 1024, INT_MAX, 1024);
+}
+
+/* a pool of "nnodes" nodes, each hosting a daemon */
+static void build_pool(int nnodes, int ppn)
+{
+    prte_node_t *node;
+    prte_proc_t *dmn;
+    char name[64];
+    int n;
+
+    for (n = 0; n < nnodes; n++) {
+        node = PMIX_NEW(prte_node_t);
+        snprintf(name, sizeof(name), "bench%06d", n);
+        node->name = strdup(name);
+        node->slots = ppn;
+        node->slots_available = ppn;
+        node->state = PRTE_NODE_STATE_UP;
+        dmn = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&dmn->name, "bench.dvm", n);
+        dmn->state = PRTE_PROC_STATE_RUNNING;
+        node->daemon = dmn;
+        node->index = pmix_pointer_array_add(prte_node_pool, node);
+    }
+    prte_process_info.num_daemons = nnodes;
+}
+
+/* nnodes * ppn ranks of one app, placed the way the named policy would
+ * place them on uniform nodes */
+static prte_job_t *build_job(int nnodes, int ppn, bool bynode)
+{
+    prte_job_t *jdata;
+    prte_app_context_t *app;
+    prte_node_t *node;
+    prte_proc_t *proc;
+    pmix_rank_t r, nprocs;
+    int n;
+
+    jdata = PMIX_NEW(prte_job_t);
+    PMIX_LOAD_NSPACE(jdata->nspace, "bench.job");
+    nprocs = (pmix_rank_t) nnodes * ppn;
+    jdata->num_procs = nprocs;
+
+    app = PMIX_NEW(prte_app_context_t);
+    app->idx = 0;
+    app->app = strdup("/bin/true");
+    PMIx_Argv_append_nosize(&app->argv, "true");
+    app->num_procs = nprocs;
+    pmix_pointer_array_set_item(jdata->apps, 0, app);
+    jdata->num_apps = 1;
+
+    jdata->map = PMIX_NEW(prte_job_map_t);
+    jdata->map->mapping = bynode ? PRTE_MAPPING_BYNODE : PRTE_MAPPING_BYSLOT;
+    for (n = 0; n < nnodes; n++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, n);
+        PMIX_RETAIN(node);
+        pmix_pointer_array_add(jdata->map->nodes, node);
+    }
+    jdata->map->num_nodes = nnodes;
+
+    for (r = 0; r < nprocs; r++) {
+        n = bynode ? (int) (r % nnodes) : (int) (r / ppn);
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, n);
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, jdata->nspace, r);
+        proc->parent = node->daemon->name.rank;
+        proc->local_rank = node->num_procs;
+        proc->node_rank = node->num_procs;
+        proc->app_rank = r;
+        proc->app_idx = 0;
+        proc->state = PRTE_PROC_STATE_INIT;
+        pmix_pointer_array_set_item(jdata->procs, r, proc);
+        PMIX_RETAIN(proc);
+        pmix_pointer_array_add(node->procs, proc);
+        node->num_procs++;
+    }
+    return jdata;
+}
+
+static int run(prte_job_t *jdata)
+{
+    pmix_data_buffer_t buf, snap;
+    pmix_bitmap_t joiners;
+    prte_profile_mark_t mark;
+    prte_job_t *dst = NULL;
+    prte_job_pack_mode_t mode;
+    int rc;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    PRTE_PROFILE_MARK(&mark);
+    rc = prte_util_nidmap_create(prte_node_pool, &buf);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        return rc;
+    }
+    PRTE_PROFILE_STAGE("nidmap", jdata->nspace, &mark, buf.bytes_used);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    PMIX_DATA_BUFFER_CONSTRUCT(&snap);
+    PMIX_CONSTRUCT(&joiners, pmix_bitmap_t);
+    PRTE_PROFILE_MARK(&mark);
+    rc = prte_util_nidmap_pack_update(prte_node_pool, &buf, &joiners, &snap);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        PMIX_DATA_BUFFER_DESTRUCT(&snap);
+        PMIX_DESTRUCT(&joiners);
+        return rc;
+    }
+    PRTE_PROFILE_STAGE("nidmap_update", jdata->nspace, &mark,
+                       buf.bytes_used + snap.bytes_used);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    PMIX_DATA_BUFFER_DESTRUCT(&snap);
+    PMIX_DESTRUCT(&joiners);
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    PRTE_PROFILE_MARK(&mark);
+    rc = prte_job_pack(&buf, jdata, PRTE_JOB_PACK_ALL);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        return rc;
+    }
+    PRTE_PROFILE_STAGE("job_pack", jdata->nspace, &mark, buf.bytes_used);
+
+    PRTE_PROFILE_MARK(&mark);
+    rc = prte_job_unpack(&buf, &dst, &mode);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        return rc;
+    }
+    PRTE_PROFILE_STAGE("job_unpack", jdata->nspace, &mark, 0);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    PMIX_RELEASE(dst);
+    return PRTE_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    int nnodes = 1000, ppn = 1, reps = 3, n, opt, rc;
+    bool bynode = false;
+    prte_job_t *jdata;
+    pmix_status_t prc;
+
+    while (-1 != (opt = getopt(argc, argv, "n:p:m:r:"))) {
+        switch (opt) {
+        case 'n':
+            nnodes = atoi(optarg);
+            break;
+        case 'p':
+            ppn = atoi(optarg);
+            break;
+        case 'm':
+            bynode = (0 == strcmp(optarg, "node"));
+            break;
+        case 'r':
+            reps = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n nodes] [-p ppn] [-m slot|node] [-r reps]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (0 >= nnodes || 0 >= ppn || 0 >= reps) {
+        fprintf(stderr, "nodes, ppn and reps must be positive\n");
+        return 1;
+    }
+
+    rc = prte_init_util(PRTE_PROC_MASTER);
+    if (PRTE_SUCCESS != rc) {
+        fprintf(stderr, "prte_init_util failed: %d\n", rc);
+        return 1;
+    }
+    /* PMIx_Data_pack refuses to run until PMIx itself is up */
+    prc = PMIx_server_init(NULL, NULL, 0);
+    if (PMIX_SUCCESS != prc) {
+        fprintf(stderr, "PMIx_server_init failed: %s\n", PMIx_Error_string(prc));
+        return 1;
+    }
+    /* report to stdout unless told otherwise - reporting is the point */
+    if (NULL == prte_profile_stage_report) {
+        prte_profile_stage_report = strdup("stdout");
+    }
+    prte_profile_enabled = true;
+
+    fresh_array(&prte_job_data);
+    fresh_array(&prte_node_pool);
+    fresh_array(&prte_node_topologies);
+    PMIX_LOAD_PROCID(PRTE_PROC_MY_NAME, "bench.dvm", 0);
+
+    build_pool(nnodes, ppn);
+    jdata = build_job(nnodes, ppn, bynode);
+    prte_set_job_data_object(jdata);
+
+    for (n = 0; n < reps; n++) {
+        rc = run(jdata);
+        if (PRTE_SUCCESS != rc) {
+            break;
+        }
+    }
+
+    PMIx_server_finalize();
+    prte_finalize();
+    return (PRTE_SUCCESS == rc) ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026      Nanook Consulting  All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+"""Control-plane scaling benchmark for PRRTE.
+
+Sweeps simulated cluster size, processes per node and mapping policy, and
+reports how long each per-job stage the HNP runs takes at every point, how
+much heap it leaves behind, and how big a message it produces.  Two sources
+feed each point:
+
+* ``prterun --rtos donotlaunch`` against the simulator RAS, which allocates
+  and maps a job over any number of fictional nodes without starting a
+  daemon - the "allocate", "map" and "display_map" stages;
+* ``bench_launch_msg``, which fabricates a daemon on every node and runs
+  the stages a real launch adds - "nidmap", "job_pack" and "job_unpack".
+
+Both write PRRTE's stage reports (src/util/prte_profile.h), one JSON object
+per line.  The results are written as one JSON document; given a previous
+one with ``--baseline``, every stage that slowed by more than
+``--threshold`` percent is listed and the exit status is 1.
+
+Exit status: 0 = ran (and no regressions), 1 = a failure or a regression,
+77 = prerequisites missing (the Automake "skip" convention).
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+SKIP = 77
+
+here = os.path.dirname(os.path.abspath(__file__))
+# prterun from a build tree needs the same care the offline map harness
+# takes (a libtool wrapper fixes argv[0] to "prte") - use its finder
+sys.path.insert(0, os.path.join(here, "..", "offline"))
+from run_offline_maps import locate_prterun  # noqa: E402
+
+
+def int_list(s):
+    return [int(v) for v in s.split(",") if v]
+
+
+def locate_microbench(top_builddir):
+    env = os.environ.get("PRTE_BENCH_LAUNCH_MSG")
+    if env and os.path.exists(env):
+        return env
+    for d in (os.path.join(top_builddir or "", "test", "bench"), here):
+        cand = os.path.join(d, "bench_launch_msg")
+        if os.path.exists(cand):
+            return cand
+    return None
+
+
+def read_reports(path):
+    recs = []
+    if not os.path.exists(path):
+        return recs
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                recs.append(json.loads(line))
+            except ValueError:
+                pass
+    return recs
+
+
+def summarize(recs):
+    """Collapse repeated reports of a stage into medians."""
+    stages = {}
+    for r in recs:
+        stages.setdefault(r["stage"], []).append(r)
+    out = {}
+    for name, rs in stages.items():
+        out[name] = {
+            "samples": len(rs),
+            "wall_us": statistics.median(r["wall_us"] for r in rs),
+            "heap_delta": statistics.median(r["heap_delta"] for r in rs),
+            "peak_rss_kb": max(r["peak_rss_kb"] for r in rs),
+            "bytes": max(r["bytes"] for r in rs),
+        }
+    return out
+
+
+def run_prterun(prterun, nodes, ppn, map_by, report, timeout):
+    exe, argv0 = prterun
+    argv = [argv0, "--rtos", "donotlaunch",
+            "--prtemca", "ras", "simulator",
+            "--prtemca", "ras_simulator_num_nodes", str(nodes),
+            "--prtemca", "ras_simulator_slots", str(ppn),
+            "--prtemca", "ras_simulator_max_slots", str(ppn),
+            "--prtemca", "prte_stage_report", report,
+            "--map-by", map_by,
+            "-n", str(nodes * ppn), "hostname"]
+    t0 = time.monotonic()
+    proc = subprocess.run(argv, executable=exe, stdout=subprocess.PIPE,
+                          stderr=subprocess.STDOUT, timeout=timeout,
+                          universal_newlines=True)
+    return proc, time.monotonic() - t0
+
+
+def run_microbench(bench, nodes, ppn, map_by, reps, report, timeout):
+    env = dict(os.environ)
+    env["PRTE_MCA_prte_stage_report"] = report
+    argv = [bench, "-n", str(nodes), "-p", str(ppn), "-m", map_by,
+            "-r", str(reps)]
+    return subprocess.run(argv, stdout=subprocess.PIPE,
+                          stderr=subprocess.STDOUT, timeout=timeout,
+                          universal_newlines=True, env=env)
+
+
+def compare(results, baseline, threshold):
+    """Return a line per stage that got slower than the threshold allows."""
+    base = {(r["nodes"], r["ppn"], r["map_by"]): r for r in baseline["results"]}
+    regressions = []
+    for r in results:
+        key = (r["nodes"], r["ppn"], r["map_by"])
+        if key not in base:
+            continue
+        for stage, s in r["stages"].items():
+            b = base[key]["stages"].get(stage)
+            # sub-millisecond stages are all noise
+            if b is None or b["wall_us"] < 1000:
+                continue
+            pct = 100.0 * (s["wall_us"] - b["wall_us"]) / b["wall_us"]
+            if pct > threshold:
+                regressions.append("%s nodes=%d ppn=%d map-by=%s: %.0f -> %.0f us (+%.0f%%)"
+                                   % (stage, key[0], key[1], key[2],
+                                      b["wall_us"], s["wall_us"], pct))
+    return regressions
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--nodes", type=int_list, default=[1000, 10000, 100000],
+                    help="comma list of simulated node counts")
+    ap.add_argument("--ppn", type=int_list, default=[1, 16],
+                    help="comma list of processes per node")
+    ap.add_argument("--map-by", default="slot,node",
+                    help="comma list of mapping policies")
+    ap.add_argument("--reps", type=int, default=3,
+                    help="repetitions of each point (medians are reported)")
+    ap.add_argument("--timeout", type=int, default=600,
+                    help="seconds allowed for any one run")
+    ap.add_argument("--output", default="bench-results.json")
+    ap.add_argument("--baseline", default=None,
+                    help="previous results to compare against")
+    ap.add_argument("--threshold", type=float, default=10.0,
+                    help="percent slowdown that counts as a regression")
+    ap.add_argument("--no-prterun", action="store_true",
+                    help="run only the launch-message microbenchmark")
+    args = ap.parse_args(argv)
+
+    top_builddir = os.environ.get("top_builddir")
+    prterun = None if args.no_prterun else locate_prterun(top_builddir)
+    bench = locate_microbench(top_builddir)
+    if prterun is None and bench is None:
+        print("SKIP: neither prterun nor bench_launch_msg found", file=sys.stderr)
+        return SKIP
+
+    results = []
+    failed = False
+    tmpdir = tempfile.mkdtemp(prefix="prte-bench-")
+    for nodes in args.nodes:
+        for ppn in args.ppn:
+            for map_by in args.map_by.split(","):
+                report = os.path.join(tmpdir, "%d-%d-%s.jsonl" % (nodes, ppn, map_by))
+                point = {"nodes": nodes, "ppn": ppn, "map_by": map_by,
+                         "prterun_wall_s": None}
+                if prterun is not None:
+                    walls = []
+                    for _ in range(args.reps):
+                        proc, wall = run_prterun(prterun, nodes, ppn, map_by,
+                                                 report, args.timeout)
+                        if proc.returncode != 0:
+                            print("FAIL: prterun nodes=%d ppn=%d map-by=%s:\n%s"
+                                  % (nodes, ppn, map_by, proc.stdout), file=sys.stderr)
+                            failed = True
+                            break
+                        walls.append(wall)
+                    if walls:
+                        point["prterun_wall_s"] = statistics.median(walls)
+                if bench is not None:
+                    proc = run_microbench(bench, nodes, ppn, map_by, args.reps,
+                                          report, args.timeout)
+                    if proc.returncode != 0:
+                        print("FAIL: bench_launch_msg nodes=%d ppn=%d map-by=%s:\n%s"
+                              % (nodes, ppn, map_by, proc.stdout), file=sys.stderr)
+                        failed = True
+                point["stages"] = summarize(read_reports(report))
+                results.append(point)
+                print("nodes=%-7d ppn=%-3d map-by=%-5s %s"
+                      % (nodes, ppn, map_by,
+                         " ".join("%s=%.0fus" % (k, v["wall_us"])
+                                  for k, v in sorted(point["stages"].items()))))
+
+    doc = {"host": os.uname()[1], "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+           "reps": args.reps, "results": results}
+    with open(args.output, "w") as f:
+        json.dump(doc, f, indent=1, sort_keys=True)
+    print("results written to %s" % args.output)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(results, baseline, args.threshold)
+        for line in regressions:
+            print("REGRESSION: " + line)
+        if regressions:
+            failed = True
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
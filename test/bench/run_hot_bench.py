@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026      Nanook Consulting  All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+"""Warm-DVM job start latency benchmark for PRRTE.
+
+Starts a persistent DVM, then times ``prun -n N hostname`` against it over
+and over for N from one rank up to a full node, and reports the median and
+90th percentile wall time of each size.  This is the cost a workflow that
+launches many short jobs into one DVM actually pays per job - daemons are
+already up, so what is left is allocation, mapping, the launch message,
+nspace registration and the fork.
+
+The sweep is run twice: once with the DVM remembering the maps it makes
+(the default - a repeat of a job on an idle DVM reuses its map, see
+src/mca/rmaps/base/rmaps_base_hot.c) and once with that turned off
+(``rmaps_base_hot_jobs 0``), so the difference is the saving.
+
+Exit status: 0 = ran, 1 = a failure, 77 = prerequisites missing (the
+Automake "skip" convention).
+"""
+
+import argparse
+import json
+import os
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+SKIP = 77
+
+
+def int_list(s):
+    return [int(v) for v in s.split(",") if v]
+
+
+def locate_tool(name, top_builddir):
+    """Return the path to a PRRTE tool, preferring an explicit override,
+    then the PATH, then the build tree (where the libtool wrapper is fine -
+    these tools do not pick a personality from argv[0])."""
+    env = os.environ.get("PRTE_" + name.upper())
+    if env and os.path.exists(env):
+        return env
+    found = shutil.which(name)
+    if found:
+        return found
+    if top_builddir:
+        cand = os.path.join(top_builddir, "src", "tools", name, name)
+        if os.path.exists(cand):
+            return cand
+    return None
+
+
+def default_sizes():
+    ncpu = os.cpu_count() or 1
+    sizes = []
+    n = 1
+    while n < ncpu:
+        sizes.append(n)
+        n *= 2
+    sizes.append(ncpu)
+    return sizes
+
+
+def percentile(values, pct):
+    vals = sorted(values)
+    k = (len(vals) - 1) * pct / 100.0
+    lo = int(k)
+    hi = min(lo + 1, len(vals) - 1)
+    return vals[lo] + (vals[hi] - vals[lo]) * (k - lo)
+
+
+def start_dvm(prte, uri, hostfile, hot, timeout):
+    argv = [prte, "--daemonize", "--report-uri", uri]
+    if hostfile:
+        argv += ["--hostfile", hostfile]
+    if not hot:
+        argv += ["--prtemca", "rmaps_base_hot_jobs", "0"]
+    proc = subprocess.run(argv, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                          timeout=timeout, universal_newlines=True)
+    if proc.returncode != 0:
+        return proc.stdout
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        if os.path.exists(uri) and os.path.getsize(uri) > 0:
+            return None
+        time.sleep(0.1)
+    return "DVM did not report its URI within %d seconds" % timeout
+
+
+def stop_dvm(pterm, uri, timeout):
+    subprocess.run([pterm, "--dvm-uri", "file:" + uri],
+                   stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL,
+                   timeout=timeout)
+
+
+def time_job(prun, uri, nprocs, timeout):
+    argv = [prun, "--dvm-uri", "file:" + uri, "-n", str(nprocs), "hostname"]
+    t0 = time.monotonic()
+    proc = subprocess.run(argv, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                          timeout=timeout, universal_newlines=True)
+    return proc, time.monotonic() - t0
+
+
+def sweep(tools, args, hot, tmpdir):
+    prte, prun, pterm = tools
+    uri = os.path.join(tmpdir, "dvm-%s.uri" % ("hot" if hot else "cold"))
+    err = start_dvm(prte, uri, args.hostfile, hot, args.timeout)
+    if err is not None:
+        print("FAIL: could not start the DVM:\n%s" % err, file=sys.stderr)
+        return None
+    points = []
+    try:
+        for n in args.sizes:
+            for _ in range(args.warmup):
+                time_job(prun, uri, n, args.timeout)
+            walls = []
+            for _ in range(args.reps):
+                proc, wall = time_job(prun, uri, n, args.timeout)
+                if proc.returncode != 0:
+                    print("FAIL: prun -n %d:\n%s" % (n, proc.stdout), file=sys.stderr)
+                    return None
+                walls.append(wall * 1000.0)
+            point = {"nprocs": n, "samples": len(walls),
+                     "median_ms": statistics.median(walls),
+                     "p90_ms": percentile(walls, 90)}
+            points.append(point)
+            print("%-4s n=%-4d median=%7.1fms p90=%7.1fms"
+                  % ("hot" if hot else "cold", n, point["median_ms"], point["p90_ms"]))
+    finally:
+        stop_dvm(pterm, uri, args.timeout)
+    return points
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--sizes", type=int_list, default=default_sizes(),
+                    help="comma list of job sizes (default: 1, 2, 4, ... up to the cpu count)")
+    ap.add_argument("--reps", type=int, default=20,
+                    help="timed jobs per size")
+    ap.add_argument("--warmup", type=int, default=2,
+                    help="untimed jobs per size before the timed ones")
+    ap.add_argument("--hostfile", default=None,
+                    help="hostfile for the DVM (default: this node only)")
+    ap.add_argument("--timeout", type=int, default=120,
+                    help="seconds allowed for any one command")
+    ap.add_argument("--output", default="hot-bench-results.json")
+    ap.add_argument("--hot-only", action="store_true",
+                    help="skip the sweep with map reuse turned off")
+    args = ap.parse_args(argv)
+
+    top_builddir = os.environ.get("top_builddir")
+    tools = tuple(locate_tool(t, top_builddir) for t in ("prte", "prun", "pterm"))
+    if None in tools:
+        print("SKIP: prte, prun and pterm are all required", file=sys.stderr)
+        return SKIP
+
+    tmpdir = tempfile.mkdtemp(prefix="prte-hot-bench-")
+    doc = {"host": os.uname()[1], "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+           "reps": args.reps}
+    for hot in ([True] if args.hot_only else [True, False]):
+        points = sweep(tools, args, hot, tmpdir)
+        if points is None:
+            return 1
+        doc["hot" if hot else "cold"] = points
+
+    with open(args.output, "w") as f:
+        json.dump(doc, f, indent=1, sort_keys=True)
+    print("results written to %s" % args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026      Nanook Consulting  All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+"""DVM job queue throughput benchmark for PRRTE.
+
+Starts a DVM on nodes made up by the simulator RAS - each with a real
+``prted`` on this host, started through test/emulate's launch agent - with
+the job queue turned on (``state_base_job_queue``), then submits a fixed,
+seeded mix of jobs faster than they can all run: mostly small ones, with a
+share of large ones that need half the DVM.  Every job is ``sleep`` for a
+random time, so the work is the same on every run.
+
+Jobs that do not fit the free slots wait in the DVM's queue (see
+src/mca/state/base/state_base_queue.c) instead of failing.  The mix is run
+twice, each time on a fresh DVM: strictly in arrival order
+(``state_base_queue_backfill 0``) and with backfill, where a job that fits
+may start ahead of a large one that is still waiting.  Each run reports the
+makespan, jobs per second, how busy it kept the slots, and the queue wait
+of the jobs that waited - read from the ``queue_wait`` lines of the DVM's
+stage report (``prte_stage_report``).
+
+Exit status: 0 = ran, 1 = a failure, 77 = prerequisites missing (the
+Automake "skip" convention).
+"""
+
+import argparse
+import glob
+import json
+import os
+import random
+import shutil
+import signal
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+SKIP = 77
+here = os.path.dirname(os.path.abspath(__file__))
+
+
+def locate_tool(name, top_builddir):
+    """Return the path to a PRRTE tool, preferring an explicit override,
+    then the build tree (the daemons must come from the same build as the
+    DVM), then the PATH."""
+    env = os.environ.get("PRTE_" + name.upper())
+    if env and os.path.exists(env):
+        return env
+    if top_builddir:
+        cand = os.path.join(top_builddir, "src", "tools", name, name)
+        if os.path.exists(cand):
+            return cand
+    return shutil.which(name)
+
+
+def locate_agent():
+    for top in (os.environ.get("top_srcdir"), os.path.join(here, "..", "..")):
+        if top:
+            cand = os.path.join(top, "test", "emulate", "prte-emulate-agent")
+            if os.path.exists(cand):
+                return os.path.abspath(cand)
+    return None
+
+
+def percentile(values, pct):
+    vals = sorted(values)
+    k = (len(vals) - 1) * pct / 100.0
+    lo = int(k)
+    hi = min(lo + 1, len(vals) - 1)
+    return vals[lo] + (vals[hi] - vals[lo]) * (k - lo)
+
+
+def make_workload(args):
+    """The same jobs, in the same order, for every run."""
+    rng = random.Random(args.seed)
+    total = args.nodes * args.slots
+    jobs = []
+    for _ in range(args.jobs):
+        if rng.random() < args.large:
+            nprocs = max(1, total // 2)
+        else:
+            nprocs = rng.randint(1, args.slots)
+        jobs.append({"nprocs": nprocs,
+                     "runtime": round(rng.uniform(args.min_runtime, args.max_runtime), 2)})
+    return jobs
+
+
+def emulated_daemons():
+    """Pids of the daemons started by the emulation agent."""
+    pids = []
+    for env in glob.glob("/proc/[0-9]*/environ"):
+        try:
+            with open(os.path.join(os.path.dirname(env), "comm")) as f:
+                if f.read().strip() not in ("prted", "lt-prted"):
+                    continue
+            with open(env, "rb") as f:
+                if b"PRTE_MCA_prte_hostname=" in f.read():
+                    pids.append(int(env.split("/")[2]))
+        except OSError:
+            continue
+    return pids
+
+
+class Dvm:
+    def __init__(self, tools, agent, args, backfill, tmpdir):
+        self.tools = tools
+        self.args = args
+        tag = "backfill" if backfill else "fifo"
+        self.uri = os.path.join(tmpdir, "dvm-%s.uri" % tag)
+        self.report = os.path.join(tmpdir, "stages-%s.json" % tag)
+        self.env = dict(os.environ)
+        # the daemons are started by name; make sure it is this build's
+        self.env["PATH"] = os.path.dirname(tools["prted"]) + os.pathsep + self.env.get("PATH", "")
+        self.argv = [tools["prte"], "--report-uri", self.uri, "--no-ready-msg",
+                     "--prtemca", "ras", "simulator",
+                     "--prtemca", "ras_simulator_num_nodes", str(args.nodes),
+                     "--prtemca", "ras_simulator_slots", str(args.slots),
+                     "--prtemca", "ras_simulator_launch", "1",
+                     "--prtemca", "plm_ssh_agent", agent,
+                     "--prtemca", "prte_if_include", "lo",
+                     "--prtemca", "prte_stage_report", self.report,
+                     "--prtemca", "state_base_job_queue", "1",
+                     "--prtemca", "state_base_queue_backfill", "1" if backfill else "0"]
+        self.proc = None
+
+    def start(self):
+        self.proc = subprocess.Popen(self.argv, env=self.env, stdout=subprocess.DEVNULL,
+                                     stderr=subprocess.STDOUT)
+        deadline = time.monotonic() + self.args.timeout
+        while time.monotonic() < deadline:
+            if self.proc.poll() is not None:
+                return "prte exited with status %d" % self.proc.returncode
+            if os.path.exists(self.uri) and os.path.getsize(self.uri) > 0:
+                return None
+            time.sleep(0.1)
+        return "DVM did not report its URI within %d seconds" % self.args.timeout
+
+    def submit(self, job):
+        argv = [self.tools["prun"], "--dvm-uri", "file:" + self.uri,
+                "-n", str(job["nprocs"]), "sleep", str(job["runtime"])]
+        return subprocess.Popen(argv, env=self.env, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT, universal_newlines=True)
+
+    def queue_waits(self):
+        waits = []
+        try:
+            with open(self.report) as f:
+                for line in f:
+                    try:
+                        rec = json.loads(line)
+                    except ValueError:
+                        continue
+                    if rec.get("stage") == "queue_wait":
+                        waits.append(rec["wall_us"] / 1000.0)
+        except OSError:
+            pass
+        return waits
+
+    def stop(self):
+        if self.proc is None:
+            return
+        if self.proc.poll() is None:
+            try:
+                subprocess.run([self.tools["pterm"], "--dvm-uri", "file:" + self.uri],
+                               env=self.env, timeout=60, stdout=subprocess.DEVNULL,
+                               stderr=subprocess.STDOUT)
+                self.proc.wait(timeout=60)
+            except subprocess.TimeoutExpired:
+                self.proc.kill()
+        # no emulated daemon outlives its DVM
+        for pid in emulated_daemons():
+            try:
+                os.kill(pid, signal.SIGKILL)
+            except OSError:
+                pass
+
+
+def run(tools, agent, args, backfill, workload, tmpdir):
+    tag = "backfill" if backfill else "fifo"
+    dvm = Dvm(tools, agent, args, backfill, tmpdir)
+    err = dvm.start()
+    if err is not None:
+        dvm.stop()
+        print("FAIL: could not start the DVM: %s" % err, file=sys.stderr)
+        return None
+    try:
+        pending = list(workload)
+        running = []
+        failed = 0
+        t0 = time.monotonic()
+        deadline = t0 + args.timeout * max(1, len(workload) // 10)
+        while pending or running:
+            while pending and len(running) < args.inflight:
+                running.append(dvm.submit(pending.pop(0)))
+            still = []
+            for p in running:
+                if p.poll() is None:
+                    still.append(p)
+                elif p.returncode != 0:
+                    failed += 1
+                    if failed == 1:
+                        print("%s: first failure:\n%s" % (tag, p.stdout.read()), file=sys.stderr)
+            running = still
+            if time.monotonic() > deadline:
+                for p in running:
+                    p.kill()
+                print("FAIL: %s run did not finish in time" % tag, file=sys.stderr)
+                return None
+            time.sleep(0.02)
+        makespan = time.monotonic() - t0
+    finally:
+        dvm.stop()
+
+    waits = dvm.queue_waits()
+    work = sum(j["nprocs"] * j["runtime"] for j in workload)
+    result = {"jobs": len(workload), "failed": failed, "makespan_s": makespan,
+              "jobs_per_s": len(workload) / makespan,
+              "utilization": work / (args.nodes * args.slots * makespan),
+              "queued": len(waits)}
+    if waits:
+        result.update({"wait_median_ms": statistics.median(waits),
+                       "wait_p90_ms": percentile(waits, 90),
+                       "wait_max_ms": max(waits)})
+    print("%-8s makespan=%7.2fs jobs/s=%6.2f util=%4.0f%% queued=%d wait median=%.0fms max=%.0fms"
+          % (tag, makespan, result["jobs_per_s"], 100.0 * result["utilization"], len(waits),
+             result.get("wait_median_ms", 0.0), result.get("wait_max_ms", 0.0)))
+    return result
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--nodes", type=int, default=4, help="simulated nodes")
+    ap.add_argument("--slots", type=int, default=4, help="slots per node")
+    ap.add_argument("--jobs", type=int, default=200, help="jobs in the mix")
+    ap.add_argument("--large", type=float, default=0.1,
+                    help="share of the jobs that need half the DVM")
+    ap.add_argument("--min-runtime", type=float, default=0.2, help="shortest job, seconds")
+    ap.add_argument("--max-runtime", type=float, default=1.0, help="longest job, seconds")
+    ap.add_argument("--inflight", type=int, default=64,
+                    help="most jobs submitted and not yet finished at once")
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--timeout", type=int, default=120,
+                    help="seconds allowed for the DVM to start, and per ten jobs")
+    ap.add_argument("--output", default="queue-bench-results.json")
+    ap.add_argument("--backfill-only", action="store_true",
+                    help="skip the run in strict arrival order")
+    args = ap.parse_args(argv)
+
+    top_builddir = os.environ.get("top_builddir")
+    tools = {t: locate_tool(t, top_builddir) for t in ("prte", "prted", "prun", "pterm")}
+    if None in tools.values():
+        print("SKIP: prte, prted, prun and pterm are all required", file=sys.stderr)
+        return SKIP
+    agent = locate_agent()
+    if agent is None:
+        print("SKIP: test/emulate/prte-emulate-agent not found", file=sys.stderr)
+        return SKIP
+
+    workload = make_workload(args)
+    tmpdir = tempfile.mkdtemp(prefix="prte-queue-bench-")
+    doc = {"host": os.uname()[1], "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+           "nodes": args.nodes, "slots": args.slots, "seed": args.seed}
+    try:
+        for backfill in ([True] if args.backfill_only else [False, True]):
+            result = run(tools, agent, args, backfill, workload, tmpdir)
+            if result is None or result["failed"]:
+                return 1
+            doc["backfill" if backfill else "fifo"] = result
+    finally:
+        shutil.rmtree(tmpdir, ignore_errors=True)
+
+    with open(args.output, "w") as f:
+        json.dump(doc, f, indent=1, sort_keys=True)
+    print("results written to %s" % args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Back-to-back fences across the whole job, optionally each carrying a
+ * modex contribution, for the emulated-DVM scenarios.  Rank 0 prints the
+ * mean fence time as "fence_storm: <n> fences <us> us/fence".
+ *
+ * usage: fence_storm [iterations] [bytes-per-rank]
+ */
+
+#include <pmix.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int main(int argc, char **argv)
+{
+    pmix_proc_t myproc, allproc;
+    pmix_info_t info;
+    pmix_value_t value;
+    pmix_status_t rc;
+    struct timespec t0, t1;
+    bool collect;
+    char key[32], *blob = NULL;
+    int iters = 100, bytes = 0, n;
+    double us;
+
+    if (1 < argc) {
+        iters = atoi(argv[1]);
+    }
+    if (2 < argc) {
+        bytes = atoi(argv[2]);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_LOAD_PROCID(&allproc, myproc.nspace, PMIX_RANK_WILDCARD);
+    collect = (0 < bytes);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &collect, PMIX_BOOL);
+    if (collect) {
+        blob = malloc(bytes);
+        memset(blob, (int) myproc.rank, bytes);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (n = 0; n < iters; n++) {
+        if (collect) {
+            snprintf(key, sizeof(key), "storm.%d", n);
+            value.type = PMIX_BYTE_OBJECT;
+            value.data.bo.bytes = blob;
+            value.data.bo.size = bytes;
+            PMIx_Put(PMIX_GLOBAL, key, &value);
+            PMIx_Commit();
+        }
+        if (PMIX_SUCCESS != (rc = PMIx_Fence(&allproc, 1, &info, 1))) {
+            fprintf(stderr, "%s:%u fence %d failed: %s\n", myproc.nspace, myproc.rank, n,
+                    PMIx_Error_string(rc));
+            PMIx_Finalize(NULL, 0);
+            exit(1);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    if (0 == myproc.rank) {
+        us = (t1.tv_sec - t0.tv_sec) * 1e6 + (t1.tv_nsec - t0.tv_nsec) / 1e3;
+        printf("fence_storm: %d fences %.1f us/fence\n", iters, us / iters);
+        fflush(stdout);
+    }
+
+    free(blob);
+    PMIX_INFO_DESTRUCT(&info);
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026      Nanook Consulting  All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+"""Emulate a many-daemon DVM on one host and run scale scenarios against it.
+
+Starts ``prte`` with the simulator RAS in launch mode, so every simulated
+node gets a real ``prted``.  The launch agent is ``prte-emulate-agent``,
+which runs each daemon on this host and tells it, through
+``prte_hostname``, which node it is.  The daemons wire up to one another
+over loopback with the TCP OOB and route through the ordinary radix tree, so
+xcast, fence, RELM (reliable delivery) and fault recovery all run their real
+code paths - only the hardware is missing.
+
+Scenarios (all run by default, or pick with ``--scenario``):
+
+``launch``   a launch storm: ``--jobs`` concurrent ``prun`` jobs, each one
+             proc per daemon
+``fence``    a fence storm: one job with a proc per daemon doing
+             ``--fences`` back-to-back fences (``--fence-bytes`` of modex
+             data per rank each time)
+``kill``     daemon kills: a long job across every daemon, then
+             ``--kills`` daemons killed one at a time; measures how long
+             the job takes to be torn down, then checks the DVM still
+             launches on the survivors
+
+Each prints one JSON line of timings per scenario, and all of them go to
+``--output``.
+
+``--agent-latency`` (with ``--agent-jitter`` and ``--agent-load``) makes
+every launch take as long as a slow ssh would, so the launcher's adaptive
+concurrency window has something to adapt to; the launch profile each
+launching daemon reports ends up under ``launch_profile`` in the output.
+
+Exit status: 0 = every scenario passed, 1 = a failure, 77 = prerequisites
+missing (the Automake "skip" convention).
+"""
+
+import argparse
+import glob
+import json
+import os
+import shutil
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+
+SKIP = 77
+here = os.path.dirname(os.path.abspath(__file__))
+
+
+def find_tool(name, top_builddir):
+    """A tool from the build tree if there is one, else from PATH."""
+    if top_builddir:
+        cand = os.path.join(top_builddir, "src", "tools", name, name)
+        if os.path.exists(cand):
+            return cand
+    return shutil.which(name)
+
+
+def find_local(name, top_builddir):
+    for d in (os.path.join(top_builddir or "", "test", "emulate"), here):
+        cand = os.path.join(d, name)
+        if os.path.exists(cand):
+            return cand
+    return None
+
+
+def daemon_pids():
+    """Map of simulated node name -> pid for every emulated daemon."""
+    pids = {}
+    for env in glob.glob("/proc/[0-9]*/environ"):
+        # the daemons' children inherit the variable too
+        try:
+            with open(os.path.join(os.path.dirname(env), "comm")) as f:
+                if f.read().strip() not in ("prted", "lt-prted"):
+                    continue
+            with open(env, "rb") as f:
+                vars = f.read().split(b"\0")
+        except OSError:
+            continue
+        for v in vars:
+            if v.startswith(b"PRTE_MCA_prte_hostname="):
+                pid = int(env.split("/")[2])
+                pids[v.split(b"=", 1)[1].decode()] = pid
+                break
+    return pids
+
+
+class Dvm:
+    def __init__(self, args, tools, agent):
+        self.args = args
+        self.tools = tools
+        self.tmpdir = tempfile.mkdtemp(prefix="prte-emulate-")
+        self.urifile = os.path.join(self.tmpdir, "dvm.uri")
+        self.profile = os.path.join(self.tmpdir, "stages.json")
+        self.env = dict(os.environ)
+        if args.agent_latency > 0:
+            self.env["PRTE_EMULATE_AGENT_LATENCY"] = str(args.agent_latency)
+            self.env["PRTE_EMULATE_AGENT_JITTER"] = str(args.agent_jitter)
+            self.env["PRTE_EMULATE_AGENT_LOAD"] = str(args.agent_load)
+            self.env["PRTE_EMULATE_AGENT_DIR"] = os.path.join(self.tmpdir, "agents")
+        # the daemons are started by name; make sure it is this build's
+        prted = os.path.dirname(tools["prted"])
+        self.env["PATH"] = prted + os.pathsep + self.env.get("PATH", "")
+        self.argv = [tools["prte"], "--report-uri", self.urifile, "--no-ready-msg",
+                     "--prtemca", "ras", "simulator",
+                     "--prtemca", "ras_simulator_num_nodes", str(args.daemons),
+                     "--prtemca", "ras_simulator_slots", str(args.slots),
+                     "--prtemca", "ras_simulator_launch", "1",
+                     "--prtemca", "plm_ssh_agent", agent,
+                     "--prtemca", "plm_ssh_num_concurrent",
+                     str(args.concurrent or args.daemons),
+                     "--prtemca", "plm_ssh_adaptive", "0" if args.fixed_window else "1",
+                     "--prtemca", "prte_stage_report", self.profile,
+                     "--prtemca", "prte_if_include", "lo",
+                     "--prtemca", "rml_base_radix", str(args.radix)]
+        self.proc = None
+
+    def start(self):
+        t0 = time.monotonic()
+        self.proc = subprocess.Popen(self.argv, env=self.env,
+                                     stdout=subprocess.DEVNULL,
+                                     stderr=subprocess.STDOUT)
+        while time.monotonic() - t0 < self.args.timeout:
+            if self.proc.poll() is not None:
+                return None
+            if os.path.exists(self.urifile) and os.path.getsize(self.urifile) > 0:
+                return time.monotonic() - t0
+            time.sleep(0.1)
+        return None
+
+    def prun(self, argv, timeout=None):
+        full = [self.tools["prun"], "--dvm-uri", "file:" + self.urifile] + argv
+        return subprocess.run(full, env=self.env, stdout=subprocess.PIPE,
+                              stderr=subprocess.STDOUT, universal_newlines=True,
+                              timeout=timeout or self.args.timeout)
+
+    def prun_bg(self, argv):
+        full = [self.tools["prun"], "--dvm-uri", "file:" + self.urifile] + argv
+        return subprocess.Popen(full, env=self.env, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT, universal_newlines=True)
+
+    def launch_profile(self):
+        """The daemon_launch records the launching daemons reported."""
+        recs = []
+        try:
+            with open(self.profile) as f:
+                for line in f:
+                    try:
+                        rec = json.loads(line)
+                    except ValueError:
+                        continue
+                    if rec.get("stage") == "daemon_launch":
+                        recs.append(rec)
+        except OSError:
+            pass
+        return recs
+
+    def stop(self):
+        if self.proc is None:
+            return
+        if self.proc.poll() is None:
+            try:
+                subprocess.run([self.tools["pterm"], "--dvm-uri", "file:" + self.urifile],
+                               env=self.env, timeout=60, stdout=subprocess.DEVNULL,
+                               stderr=subprocess.STDOUT)
+                self.proc.wait(timeout=60)
+            except subprocess.TimeoutExpired:
+                self.proc.kill()
+        # no emulated daemon outlives its DVM
+        for pid in daemon_pids().values():
+            try:
+                os.kill(pid, signal.SIGKILL)
+            except OSError:
+                pass
+        shutil.rmtree(self.tmpdir, ignore_errors=True)
+
+
+def scenario_launch(dvm, args):
+    t0 = time.monotonic()
+    jobs = [dvm.prun_bg(["--map-by", "ppr:1:node", "hostname"])
+            for _ in range(args.jobs)]
+    failed = 0
+    for j in jobs:
+        try:
+            j.communicate(timeout=args.timeout)
+        except subprocess.TimeoutExpired:
+            j.kill()
+        if j.returncode != 0:
+            failed += 1
+    return {"jobs": args.jobs, "failed": failed,
+            "wall_s": time.monotonic() - t0}, failed == 0
+
+
+def scenario_fence(dvm, args):
+    t0 = time.monotonic()
+    res = dvm.prun(["--map-by", "ppr:1:node", args.fence_storm,
+                    str(args.fences), str(args.fence_bytes)])
+    wall = time.monotonic() - t0
+    per = None
+    for line in res.stdout.splitlines():
+        if line.startswith("fence_storm:"):
+            per = float(line.split()[3])
+    return {"fences": args.fences, "bytes": args.fence_bytes,
+            "us_per_fence": per, "wall_s": wall}, res.returncode == 0 and per is not None
+
+
+def scenario_kill(dvm, args):
+    results = []
+    ok = True
+    for k in range(args.kills):
+        job = dvm.prun_bg(["--map-by", "ppr:1:node", "sleep", "600"])
+        # give every proc time to start before pulling a daemon out
+        time.sleep(args.settle)
+        pids = daemon_pids()
+        if not pids:
+            job.kill()
+            return {"error": "no emulated daemons found"}, False
+        victim = sorted(pids)[(k * 7919) % len(pids)]
+        t0 = time.monotonic()
+        os.kill(pids[victim], signal.SIGKILL)
+        try:
+            job.communicate(timeout=args.timeout)
+            teardown = time.monotonic() - t0
+        except subprocess.TimeoutExpired:
+            job.kill()
+            teardown = None
+            ok = False
+        # the survivors must still take work
+        t1 = time.monotonic()
+        res = dvm.prun(["--map-by", "ppr:1:node", "hostname"])
+        relaunch = time.monotonic() - t1
+        if res.returncode != 0:
+            ok = False
+        results.append({"victim": victim, "teardown_s": teardown,
+                        "relaunch_s": relaunch, "relaunch_ok": res.returncode == 0})
+    return {"kills": results}, ok
+
+
+SCENARIOS = {"launch": scenario_launch, "fence": scenario_fence, "kill": scenario_kill}
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--daemons", type=int, default=64,
+                    help="number of emulated nodes (one prted each)")
+    ap.add_argument("--slots", type=int, default=1)
+    ap.add_argument("--radix", type=int, default=64,
+                    help="fan-out of the daemon routing tree")
+    ap.add_argument("--scenario", action="append", choices=sorted(SCENARIOS),
+                    help="scenario to run (repeatable; default: all)")
+    ap.add_argument("--jobs", type=int, default=16, help="launch storm: concurrent jobs")
+    ap.add_argument("--fences", type=int, default=100, help="fence storm: fences per job")
+    ap.add_argument("--fence-bytes", type=int, default=0,
+                    help="fence storm: modex bytes each rank contributes per fence")
+    ap.add_argument("--kills", type=int, default=1, help="kill: daemons to kill")
+    ap.add_argument("--settle", type=float, default=5.0,
+                    help="kill: seconds to let the job start before a kill")
+    ap.add_argument("--concurrent", type=int, default=0,
+                    help="most launch agents in flight per launcher (default: --daemons)")
+    ap.add_argument("--fixed-window", action="store_true",
+                    help="run --concurrent agents at once rather than adapting")
+    ap.add_argument("--agent-latency", type=float, default=0.0,
+                    help="seconds each launch takes in the stub agent")
+    ap.add_argument("--agent-jitter", type=float, default=0.0,
+                    help="up to this many seconds more per launch, at random")
+    ap.add_argument("--agent-load", type=float, default=0.0,
+                    help="seconds more per launch for each other one in flight")
+    ap.add_argument("--timeout", type=int, default=300)
+    ap.add_argument("--output", default="emulate-results.json")
+    args = ap.parse_args(argv)
+
+    if not os.path.isdir("/proc"):
+        print("SKIP: needs /proc to find the emulated daemons", file=sys.stderr)
+        return SKIP
+    top_builddir = os.environ.get("top_builddir")
+    tools = {t: find_tool(t, top_builddir) for t in ("prte", "prted", "prun", "pterm")}
+    missing = [t for t, p in tools.items() if p is None]
+    if missing:
+        print("SKIP: cannot find %s" % ", ".join(missing), file=sys.stderr)
+        return SKIP
+    agent = os.path.join(here, "prte-emulate-agent")
+    args.fence_storm = find_local("fence_storm", top_builddir)
+    scenarios = args.scenario or sorted(SCENARIOS)
+    if "fence" in scenarios and args.fence_storm is None:
+        print("SKIP: fence_storm has not been built", file=sys.stderr)
+        return SKIP
+
+    dvm = Dvm(args, tools, agent)
+    doc = {"daemons": args.daemons, "radix": args.radix, "scenarios": {}}
+    ok = True
+    try:
+        startup = dvm.start()
+        if startup is None:
+            print("FAIL: the emulated DVM did not come up", file=sys.stderr)
+            return 1
+        doc["startup_s"] = startup
+        print(json.dumps({"scenario": "startup", "daemons": args.daemons,
+                          "wall_s": startup}))
+        for name in scenarios:
+            res, passed = SCENARIOS[name](dvm, args)
+            res["passed"] = passed
+            doc["scenarios"][name] = res
+            print(json.dumps(dict(scenario=name, **res)))
+            ok = ok and passed
+    finally:
+        doc["launch_profile"] = dvm.launch_profile()
+        dvm.stop()
+
+    with open(args.output, "w") as f:
+        json.dump(doc, f, indent=1, sort_keys=True)
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
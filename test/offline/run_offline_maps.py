@@ -21,6 +21,7 @@ Automake "skip" convention).
 """
 
 import argparse
+import json
 import fnmatch
 import glob
 import os
@@ -98,6 +99,8 @@ BIND_DISPLAY = {"none": {"NONE"}, "hwthread": {"HWTHREAD"},
                 "numa": {"NUMA"}, "package": {"PACKAGE"}}
 
 JOBMAP_MARKER = "JOB MAP"
+# the one line "--display map:json" writes starts with this
+JSONMAP_MARKER = '{"job_map":'
 
 
 # ===========================================================================
@@ -356,7 +359,44 @@ def _parse_bound(text):
     return BoundSpec(m.group(1), int(m.group(2)), m.group(3), lo, hi)
 
 
+def _json_map_lines(raw):
+    return [l.strip() for l in raw.splitlines()
+            if l.strip().startswith(JSONMAP_MARKER)]
+
+
+def parse_map_json(raw):
+    """Build a ParsedMap from the "--display map:json" line rather than by
+    scraping the text report.  The same checks then run over either."""
+    lines = _json_map_lines(raw)
+    if len(lines) != 1:
+        raise ParseError("expected exactly one JSON job map line")
+    try:
+        jm = json.loads(lines[0])["job_map"]
+    except (ValueError, KeyError) as e:
+        raise ParseError("unreadable JSON job map: %s" % e)
+    # the text form shows the first app's policies in place of the job's
+    # when the apps were placed differently - do the same
+    pol = jm["apps"][0] if jm.get("per_app_policy") and jm.get("apps") else jm
+    parts = (pol["mapping"] or "").split(":")
+    nodes = []
+    for n in jm["nodes"]:
+        node = NodeMap(n["name"], int(n["slots"]), int(n["slots_max"]),
+                       int(n["num_procs"]))
+        for p in n["procs"]:
+            bound = p.get("bound")
+            node.procs.append(Proc(int(p["app"]), int(p["rank"]),
+                                   None if bound is None
+                                   else _parse_bound(bound)))
+        nodes.append(node)
+    if not nodes:
+        raise ParseError("JSON job map lists no nodes")
+    return ParsedMap(parts[0], parts[1:], pol["ranking"], pol["binding"],
+                     jm.get("cpu_type") or "", nodes)
+
+
 def parse_map(raw):
+    if _json_map_lines(raw):
+        return parse_map_json(raw)
     if raw.count(JOBMAP_MARKER) != 1:
         raise ParseError("expected exactly one JOB MAP block")
     hm = HEADER_RE.search(raw)
@@ -473,8 +513,9 @@ def locate_prterun(top_builddir):
     return None
 
 
-def build_argv(prterun_argv0, topo_path, case):
-    argv = [prterun_argv0, "--rtos", "donotlaunch", "--display", "map"]
+def build_argv(prterun_argv0, topo_path, case, json_map=False):
+    argv = [prterun_argv0, "--rtos", "donotlaunch",
+            "--display", "map:json" if json_map else "map"]
     argv += list(case.alloc_args)
     argv += [
             # pin the mapping-policy baseline so the harness is hermetic: do not
@@ -519,7 +560,8 @@ def build_argv(prterun_argv0, topo_path, case):
 
 
 def classify(out):
-    mapped = out.count(JOBMAP_MARKER) == 1
+    mapped = (out.count(JOBMAP_MARKER) == 1
+              or len(_json_map_lines(out)) == 1)
     banner = None
     if not mapped:
         m = re.search(r"Topic:\s*(\S+)", out)
@@ -535,9 +577,9 @@ def classify(out):
     return mapped, banner
 
 
-def run_case(prterun, topo_path, case, timeout=60):
+def run_case(prterun, topo_path, case, timeout=60, json_map=False):
     exe, argv0 = prterun
-    argv = build_argv(argv0, topo_path, case)
+    argv = build_argv(argv0, topo_path, case, json_map)
     proc = subprocess.run(argv, executable=exe, stdout=subprocess.PIPE,
                           stderr=subprocess.STDOUT, timeout=timeout,
                           universal_newlines=True)
@@ -1293,7 +1335,13 @@ def main(argv=None):
     ap.add_argument("--update-golden", action="store_true",
                     help="regenerate golden snapshots")
     ap.add_argument("--golden-dir", default=None)
+    ap.add_argument("--json", action="store_true",
+                    help="read the map from --display map:json instead of "
+                         "the text report (golden snapshots are text, so "
+                         "are not compared)")
     args = ap.parse_args(argv)
+    if args.json and (args.golden or args.update_golden):
+        ap.error("--json cannot be combined with --golden/--update-golden")
 
     here = os.path.dirname(os.path.abspath(__file__))
     # this script lives at <top_srcdir>/test/offline, so the source-tree root
@@ -1361,7 +1409,7 @@ def main(argv=None):
     for c in cases:
         topo_path = topo_path_by_name[c.topo.name]
         try:
-            res = run_case(prterun, topo_path, c)
+            res = run_case(prterun, topo_path, c, json_map=args.json)
         except Exception as e:  # noqa
             print("FAIL %s harness-error: %s" % (c.id, e))
             n_fail += 1
@@ -44,6 +44,17 @@
  *      fence fault handler's choice -- re-converge a fence that merely
  *      lost a message path, end one that lost a participant -- are pinned
  *      down away from a live DVM, with the release broadcast stubbed.
+ *
+ *   6. The pruned xcast's choice of child subtrees, which needs only the
+ *      routing tree and that can be computed here.
+ *
+ *   7. The compact proc sets collective signatures travel as: any listing
+ *      of the same participants has to come out identical, and what goes
+ *      on the wire has to come back as the procs that went in.
+ *
+ *   8. Resolving participants to daemons, which reads only the job map:
+ *      each daemon reported once, and the whole-job answer cached on the
+ *      map until a node leaves it.
  */
 
 #include "prte_config.h"
@@ -63,6 +74,7 @@
 
 #include "src/grpcomm/grpcomm.h"
 #include "src/grpcomm/grpcomm_internal.h"
+#include "src/mca/rmaps/rmaps_types.h"
 
 #define CHECK(label, cond)                                              \
     do {                                                                \
@@ -170,6 +182,8 @@ static int test_classes(void)
     CHECK("fence trk ndmns 0", 0 == fc->ndmns);
     CHECK("fence trk nexpected 0", 0 == fc->nexpected);
     CHECK("fence trk nreported 0", 0 == fc->nreported);
+    CHECK("fence trk bucket empty chain",
+          NULL != fc->bucket && NULL == fc->bucket->dbuf && 0 == fc->bucket->nsegs);
     CHECK("fence trk timeout 0", 0 == fc->timeout);
     CHECK("fence trk cbfunc NULL", NULL == fc->cbfunc);
     PMIX_RELEASE(fc);
@@ -548,8 +562,7 @@ static char fence_xcast_nspace[PMIX_MAX_NSLEN + 1];
 
 static int stub_xcast(prte_rml_tag_t tag, pmix_data_buffer_t *msg)
 {
-    size_t sz = 0;
-    pmix_proc_t *procs = NULL;
+    prte_grpcomm_procset_t set;
     pmix_status_t st = PMIX_SUCCESS;
     int32_t cnt;
 
@@ -559,18 +572,14 @@ static int stub_xcast(prte_rml_tag_t tag, pmix_data_buffer_t *msg)
     fence_xcast_nspace[0] = '\0';
 
     /* read it back the way fence_release() does - signature, then status */
-    cnt = 1;
-    if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, msg, &sz, &cnt, PMIX_SIZE)) {
+    prte_grpcomm_procset_init(&set);
+    if (PRTE_SUCCESS != prte_grpcomm_procset_unpack(msg, &set)) {
         return PRTE_SUCCESS;
     }
-    if (0 < sz) {
-        PMIX_PROC_CREATE(procs, sz);
-        cnt = (int32_t) sz;
-        if (PMIX_SUCCESS == PMIx_Data_unpack(NULL, msg, procs, &cnt, PMIX_PROC)) {
-            PMIX_LOAD_NSPACE(fence_xcast_nspace, procs[0].nspace);
-        }
-        PMIX_PROC_FREE(procs, sz);
+    if (0 < set.nns) {
+        PMIX_LOAD_NSPACE(fence_xcast_nspace, set.nspaces[0]);
     }
+    prte_grpcomm_procset_free(&set);
     cnt = 1;
     if (PMIX_SUCCESS == PMIx_Data_unpack(NULL, msg, &st, &cnt, PMIX_INT32)) {
         fence_xcast_status = st;
@@ -850,6 +859,330 @@ static int test_recovery_epoch(void)
     return failures;
 }
 
+/*
+ * A pruned xcast goes only into the child subtrees holding a destination,
+ * and expects acks from just those.  prte_grpcomm_xcast_reach() is that
+ * choice, and it needs no more than the routing tree, which
+ * prte_rml_compute_routing_tree() builds from the radix and the DVM size.
+ */
+#if PRTE_TEST_GRPCOMM_INTERNALS
+static int child_slot(pmix_rank_t rank)
+{
+    pmix_rank_t *children = (pmix_rank_t *) prte_rml_base.children.array;
+    size_t i;
+
+    for (i = 0; i < prte_rml_base.children.size; i++) {
+        if (children[i] == rank) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+#endif
+
+static int test_xcast_reach(void)
+{
+    int failures = 0;
+#if PRTE_TEST_GRPCOMM_INTERNALS
+    pmix_bitmap_t dests, wanted;
+    pmix_rank_t save_rank = PRTE_PROC_MY_NAME->rank;
+    pmix_rank_t save_ndmns = prte_process_info.num_daemons;
+    int save_radix = prte_rml_base.radix;
+
+    /* the failure bitmaps the way prte_rml_open() constructs them */
+    PMIX_CONSTRUCT(&prte_rml_base.failed_dmns, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&prte_rml_base.global_failed_dmns, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&prte_rml_base.dead_dmns, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.dead_dmns, 64);
+    PMIX_CONSTRUCT(&prte_rml_base.absent_dmns, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.absent_dmns, 64);
+    PMIX_CONSTRUCT(&prte_rml_base.lateral_links, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.lateral_links, 64);
+    PMIX_CONSTRUCT(&prte_rml_base.revived_dmns, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.revived_dmns, 64);
+
+    /* radix 2, 7 daemons, seen from rank 1: children 3 and 5 */
+    prte_rml_base.radix = 2;
+    prte_process_info.num_daemons = 7;
+    PRTE_PROC_MY_NAME->rank = 1;
+    prte_rml_compute_routing_tree();
+    CHECK("reach: the tree has the two children",
+          0 <= child_slot(3) && 0 <= child_slot(5));
+
+    PMIX_CONSTRUCT(&wanted, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&dests, pmix_bitmap_t);
+    pmix_bitmap_init(&dests, 7);
+
+    CHECK("reach: a full xcast goes to every child",
+          2 == prte_grpcomm_xcast_reach(NULL, &wanted));
+    CHECK("reach: ...both of them",
+          pmix_bitmap_is_set_bit(&wanted, child_slot(3)) &&
+          pmix_bitmap_is_set_bit(&wanted, child_slot(5)));
+
+    pmix_bitmap_set_bit(&dests, 3);
+    CHECK("reach: one branch", 1 == prte_grpcomm_xcast_reach(&dests, &wanted));
+    CHECK("reach: ...the one holding the destination",
+          pmix_bitmap_is_set_bit(&wanted, child_slot(3)) &&
+          !pmix_bitmap_is_set_bit(&wanted, child_slot(5)));
+
+    pmix_bitmap_set_bit(&dests, 5);
+    CHECK("reach: two branches", 2 == prte_grpcomm_xcast_reach(&dests, &wanted));
+
+    pmix_bitmap_clear_all_bits(&dests);
+    pmix_bitmap_set_bit(&dests, 1);
+    pmix_bitmap_set_bit(&dests, 0);
+    pmix_bitmap_set_bit(&dests, 4);
+    CHECK("reach: ourselves, our parent and a cousin reach no child",
+          0 == prte_grpcomm_xcast_reach(&dests, &wanted));
+
+    /* and whether an op for them would have come to us at all: the ids a
+     * daemon may skip are those of ops for which this is false */
+    CHECK("reaches here: an op for us", prte_grpcomm_xcast_reaches_here(&dests));
+    pmix_bitmap_clear_bit(&dests, 1);
+    CHECK("reaches here: not an op for our parent and a cousin",
+          !prte_grpcomm_xcast_reaches_here(&dests));
+    pmix_bitmap_set_bit(&dests, 3);
+    CHECK("reaches here: an op for a child comes through us",
+          prte_grpcomm_xcast_reaches_here(&dests));
+
+    pmix_bitmap_clear_all_bits(&dests);
+    pmix_bitmap_set_bit(&dests, 5);
+    pmix_bitmap_set_bit(&prte_rml_base.failed_dmns, 5);
+    CHECK("reach: a failed destination is nobody's to deliver to",
+          0 == prte_grpcomm_xcast_reach(&dests, &wanted));
+    CHECK("reaches here: nor does it make an op come through us",
+          !prte_grpcomm_xcast_reaches_here(&dests));
+
+    PMIX_DESTRUCT(&dests);
+    PMIX_DESTRUCT(&wanted);
+    PMIX_DESTRUCT(&prte_rml_base.failed_dmns);
+    PMIX_DESTRUCT(&prte_rml_base.global_failed_dmns);
+    PMIX_DESTRUCT(&prte_rml_base.dead_dmns);
+    PMIX_DESTRUCT(&prte_rml_base.absent_dmns);
+    PMIX_DESTRUCT(&prte_rml_base.lateral_links);
+    PMIX_DESTRUCT(&prte_rml_base.revived_dmns);
+    prte_rml_base.radix = save_radix;
+    prte_process_info.num_daemons = save_ndmns;
+    PRTE_PROC_MY_NAME->rank = save_rank;
+#endif
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_xcast_reach\n");
+    }
+    return failures;
+}
+
+/*
+ * A fence is matched by its signature, and each daemon builds that
+ * signature from whatever order its PMIx server aggregated the participants
+ * in.  So the canonical set must not depend on that order, on duplicates,
+ * or on ranks listed next to a wildcard for their own nspace - two daemons
+ * that disagree here never meet in the same rollup.
+ */
+static int test_procset(void)
+{
+    int failures = 0;
+#if PRTE_TEST_GRPCOMM_INTERNALS
+    prte_grpcomm_procset_t a, b;
+    pmix_proc_t in[6], *out = NULL;
+    pmix_data_buffer_t buf;
+    size_t nout = 0, n;
+    bool same;
+
+    prte_grpcomm_procset_init(&a);
+    prte_grpcomm_procset_init(&b);
+
+    /* ranks 0-3 of one job and rank 7 of another, in two orders */
+    PMIX_LOAD_PROCID(&in[0], "ps-a", 2);
+    PMIX_LOAD_PROCID(&in[1], "ps-b", 7);
+    PMIX_LOAD_PROCID(&in[2], "ps-a", 0);
+    PMIX_LOAD_PROCID(&in[3], "ps-a", 3);
+    PMIX_LOAD_PROCID(&in[4], "ps-a", 1);
+    PMIX_LOAD_PROCID(&in[5], "ps-a", 2);
+    CHECK("procset: loads", PRTE_SUCCESS == prte_grpcomm_procset_load(&a, in, 6, true));
+    CHECK("procset: a duplicate counts once", 5 == a.nprocs);
+    CHECK("procset: consecutive ranks are one run", 2 == a.nruns && 2 == a.nns);
+    CHECK("procset: the run spans them", 0 == a.runs[1] && 4 == a.runs[2]);
+
+    PMIX_LOAD_PROCID(&in[0], "ps-b", 7);
+    PMIX_LOAD_PROCID(&in[1], "ps-a", 3);
+    PMIX_LOAD_PROCID(&in[2], "ps-a", 2);
+    PMIX_LOAD_PROCID(&in[3], "ps-a", 1);
+    PMIX_LOAD_PROCID(&in[4], "ps-a", 0);
+    CHECK("procset: loads reordered", PRTE_SUCCESS == prte_grpcomm_procset_load(&b, in, 5, true));
+    CHECK("procset: order does not matter", prte_grpcomm_procset_equal(&a, &b));
+    CHECK("procset: nor does it to the hash", a.hash == b.hash);
+
+    /* one more rank is a different set, and the hash says so */
+    PMIX_LOAD_PROCID(&in[4], "ps-a", 4);
+    prte_grpcomm_procset_load(&b, in, 5, true);
+    CHECK("procset: a different rank is a different set",
+          !prte_grpcomm_procset_equal(&a, &b) && a.hash != b.hash);
+
+    /* a wildcard swallows the ranks of its own nspace, and only those */
+    PMIX_LOAD_PROCID(&in[0], "ps-a", 5);
+    PMIX_LOAD_PROCID(&in[1], "ps-a", PMIX_RANK_WILDCARD);
+    PMIX_LOAD_PROCID(&in[2], "ps-b", 1);
+    PMIX_LOAD_PROCID(&in[3], "ps-a", 0);
+    prte_grpcomm_procset_load(&a, in, 4, true);
+    CHECK("procset: a wildcard stands for its nspace",
+          2 == a.nruns && 2 == a.nprocs && PMIX_RANK_WILDCARD == a.runs[1]);
+
+    /* in order, nothing merges but neighbours, and expansion gives back
+     * exactly what went in */
+    PMIX_LOAD_PROCID(&in[0], "ps-a", 3);
+    PMIX_LOAD_PROCID(&in[1], "ps-a", 4);
+    PMIX_LOAD_PROCID(&in[2], "ps-a", 0);
+    PMIX_LOAD_PROCID(&in[3], "ps-b", PMIX_RANK_WILDCARD);
+    PMIX_LOAD_PROCID(&in[4], "ps-a", 1);
+    CHECK("procset: loads in order", PRTE_SUCCESS == prte_grpcomm_procset_load(&a, in, 5, false));
+    CHECK("procset: in order keeps the runs apart", 4 == a.nruns && 5 == a.nprocs);
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    CHECK("procset: packs", PRTE_SUCCESS == prte_grpcomm_procset_pack(&buf, &a));
+    CHECK("procset: unpacks", PRTE_SUCCESS == prte_grpcomm_procset_unpack(&buf, &b));
+    CHECK("procset: the round trip is equal", prte_grpcomm_procset_equal(&a, &b));
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    CHECK("procset: expands", PRTE_SUCCESS == prte_grpcomm_procset_expand(&b, &out, &nout));
+    same = (5 == nout);
+    for (n = 0; same && n < nout; n++) {
+        same = PMIX_CHECK_PROCID(&in[n], &out[n]) && in[n].rank == out[n].rank;
+    }
+    CHECK("procset: expansion gives back the procs in order", same);
+    PMIX_PROC_FREE(out, nout);
+
+    /* the order-keeping pair the group signature uses */
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    CHECK("procset: pack_procs", PRTE_SUCCESS == prte_grpcomm_pack_procs(&buf, in, 5));
+    out = NULL;
+    nout = 0;
+    CHECK("procset: unpack_procs", PRTE_SUCCESS == prte_grpcomm_unpack_procs(&buf, &out, &nout));
+    CHECK("procset: unpack_procs count", 5 == nout && NULL != out);
+    if (5 == nout) {
+        CHECK("procset: unpack_procs order",
+              4 == out[1].rank && PMIX_RANK_WILDCARD == out[3].rank);
+    }
+    PMIX_PROC_FREE(out, nout);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    /* a run that names an nspace the set does not carry is refused */
+    prte_grpcomm_procset_load(&a, in, 2, true);
+    a.runs[0] = 9;
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    prte_grpcomm_procset_pack(&buf, &a);
+    CHECK("procset: a corrupt run is refused",
+          PRTE_SUCCESS != prte_grpcomm_procset_unpack(&buf, &b) && 0 == b.nprocs);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    prte_grpcomm_procset_free(&a);
+    prte_grpcomm_procset_free(&b);
+#endif
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_procset\n");
+    }
+    return failures;
+}
+
+/*
+ * Before a collective moves it has to know which daemons host its
+ * participants, and a large construct used to spend seconds on that.  The
+ * answer must still be exact: one entry per daemon however many of its
+ * procs take part, and the whole-job answer reused only while the map it
+ * was built from is unchanged.
+ */
+static int test_dmns_resolve(void)
+{
+    int failures = 0;
+#if PRTE_TEST_GRPCOMM_INTERNALS
+    prte_grpcomm_dmns_t res;
+    prte_job_t *jdata;
+    prte_job_map_t *map;
+    prte_node_t *node;
+    prte_proc_t *proc, *dmn;
+    pmix_rank_t *dmns = NULL, r;
+    pmix_bitmap_t *cached;
+    size_t ndmns = 0;
+    int32_t save_daemons;
+
+    if (NULL == prte_job_data) {
+        prte_job_data = PMIX_NEW(pmix_pointer_array_t);
+        pmix_pointer_array_init(prte_job_data, 8, INT_MAX, 8);
+    }
+    save_daemons = prte_process_info.num_daemons;
+    prte_process_info.num_daemons = 3;
+
+    /* six procs, two to a node, on daemons 0-2 */
+    jdata = PMIX_NEW(prte_job_t);
+    PMIX_LOAD_NSPACE(jdata->nspace, "dmns-job");
+    prte_set_job_data_object(jdata);
+    map = PMIX_NEW(prte_job_map_t);
+    jdata->map = map;
+    for (r = 0; r < 3; r++) {
+        node = PMIX_NEW(prte_node_t);
+        dmn = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&dmn->name, PRTE_PROC_MY_NAME->nspace, r);
+        node->daemon = dmn;
+        pmix_pointer_array_add(map->nodes, node);
+        map->num_nodes++;
+    }
+    for (r = 0; r < 6; r++) {
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, jdata->nspace, r);
+        proc->node = (prte_node_t *) pmix_pointer_array_get_item(map->nodes, r / 2);
+        pmix_pointer_array_set_item(jdata->procs, r, proc);
+    }
+
+    prte_grpcomm_dmns_init(&res, false);
+    CHECK("dmns: a run resolves", PRTE_SUCCESS == prte_grpcomm_dmns_add(&res, "dmns-job", 0, 6));
+    prte_grpcomm_dmns_finish(&res, &dmns, &ndmns);
+    CHECK("dmns: one entry per daemon", 3 == ndmns && NULL != dmns);
+    if (3 == ndmns) {
+        CHECK("dmns: in rank order", 0 == dmns[0] && 1 == dmns[1] && 2 == dmns[2]);
+    }
+    free(dmns);
+
+    prte_grpcomm_dmns_init(&res, false);
+    prte_grpcomm_dmns_add(&res, "dmns-job", 2, 2);
+    prte_grpcomm_dmns_finish(&res, &dmns, &ndmns);
+    CHECK("dmns: ranks sharing a node share its daemon", 1 == ndmns && 1 == dmns[0]);
+    free(dmns);
+
+    /* the wildcard builds the map's cache, and the next one uses it */
+    CHECK("dmns: no cache before anyone asks", NULL == map->daemons);
+    prte_grpcomm_dmns_init(&res, false);
+    prte_grpcomm_dmns_add(&res, "dmns-job", PMIX_RANK_WILDCARD, 1);
+    prte_grpcomm_dmns_finish(&res, &dmns, &ndmns);
+    CHECK("dmns: a wildcard is every daemon hosting the job", 3 == ndmns);
+    free(dmns);
+    cached = map->daemons;
+    CHECK("dmns: and is cached on the map", NULL != cached);
+    prte_grpcomm_dmns_init(&res, false);
+    prte_grpcomm_dmns_add(&res, "dmns-job", PMIX_RANK_WILDCARD, 1);
+    prte_grpcomm_dmns_finish(&res, &dmns, &ndmns);
+    CHECK("dmns: the cache gives the same answer", 3 == ndmns);
+    CHECK("dmns: and is not rebuilt", cached == map->daemons);
+    free(dmns);
+    prte_job_map_daemons_stale(map);
+    CHECK("dmns: a node leaving drops the cache", NULL == map->daemons);
+
+    /* a job nobody has heard of is an error, as it always was */
+    prte_grpcomm_dmns_init(&res, false);
+    CHECK("dmns: an unknown job is refused",
+          PRTE_ERR_NOT_FOUND == prte_grpcomm_dmns_add(&res, "dmns-nosuchjob", 0, 1));
+    prte_grpcomm_dmns_finish(&res, &dmns, &ndmns);
+    CHECK("dmns: and resolves to nobody", 0 == ndmns && NULL == dmns);
+
+    prte_process_info.num_daemons = save_daemons;
+#endif
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_dmns_resolve\n");
+    }
+    return failures;
+}
+
 int main(void)
 {
     int rc, failures = 0;
@@ -881,6 +1214,9 @@ int main(void)
     failures += test_fence_tracker();
     failures += test_fence_fault_handler();
     failures += test_recovery_epoch();
+    failures += test_xcast_reach();
+    failures += test_procset();
+    failures += test_dmns_resolve();
 
     PMIx_server_finalize();
     prte_finalize();
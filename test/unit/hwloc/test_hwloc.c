@@ -82,6 +82,10 @@
  *    counters to NUMA nodes and hwloc 2.x does not carry them in the depth
  *    hierarchy.
  *
+ *  - a topology named by hwloc_use_topo_file describes some other shape,
+ *    so it must never be written into the node's topology cache, where the
+ *    next daemon start would take it for this machine.
+ *
  * What is deliberately NOT here: prte_hwloc_base_get_topology() (senses the
  * real machine), prte_hwloc_print() against a machine wide enough to reach
  * its cpuset buffer, and anything needing a populated prte_node_pool. Those
@@ -94,8 +98,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/stat.h>
 
 #include "constants.h"
 #include "types.h"
@@ -107,6 +113,7 @@
 #include "src/runtime/runtime.h"
 #include "src/util/attr.h"
 #include "src/util/pmix_argv.h"
+#include "src/util/pmix_printf.h"
 #include "src/util/proc_info.h"
 
 #define CHECK(label, cond)                                              \
@@ -1038,7 +1045,8 @@ static int test_topo_file(void)
     int failures = 0;
     const struct hwloc_topology_support *support;
     char path[] = "/tmp/prte_test_topoXXXXXX";
-    char *saved_file;
+    char cachedir[] = "/tmp/prte_test_topocacheXXXXXX";
+    char *saved_file, *saved_cache;
     hwloc_topology_t saved_topo;
     int fd, rc;
     size_t len;
@@ -1065,8 +1073,20 @@ static int test_topo_file(void)
     prte_hwloc_base_topo_file = path;
     prte_hwloc_topology = NULL;
 
+    /* with a cache configured too: a unique name that does not exist yet,
+     * which the cache would have to create */
+    saved_cache = prte_hwloc_base_topo_cache;
+    if (NULL != mkdtemp(cachedir)) {
+        rmdir(cachedir);
+        prte_hwloc_base_topo_cache = cachedir;
+    }
+
     rc = prte_hwloc_base_get_topology();
     CHECK("a topology file loads", PRTE_SUCCESS == rc);
+    if (prte_hwloc_base_topo_cache == cachedir) {
+        CHECK("a topology file is never cached", 0 != access(cachedir, F_OK));
+    }
+    prte_hwloc_base_topo_cache = saved_cache;
     if (PRTE_SUCCESS == rc && NULL != prte_hwloc_topology) {
         CHECK("the loaded topology has the file's packages",
               2 == prte_hwloc_base_get_nbobjs_by_type(prte_hwloc_topology,
@@ -1104,6 +1124,141 @@ static int test_topo_file(void)
     return failures;
 }
 
+/* The one entry in a topology cache directory, or NULL - with its inode,
+ * which changes whenever the entry is rewritten (it is renamed into place) */
+static char *topo_cache_entry(const char *dir, ino_t *ino)
+{
+    DIR *d;
+    struct dirent *ent;
+    struct stat st;
+    char *path = NULL;
+    int n = 0;
+
+    if (NULL == (d = opendir(dir))) {
+        return NULL;
+    }
+    while (NULL != (ent = readdir(d))) {
+        if ('.' == ent->d_name[0]) {
+            continue;
+        }
+        ++n;
+        free(path);
+        pmix_asprintf(&path, "%s/%s", dir, ent->d_name);
+    }
+    closedir(d);
+    if (1 != n || 0 != stat(path, &st)) {
+        free(path);
+        return NULL;
+    }
+    *ino = st.st_ino;
+    return path;
+}
+
+static void topo_drop(hwloc_topology_t topo)
+{
+    if (NULL != topo) {
+        prte_hwloc_base_release_userdata(topo);
+        hwloc_topology_destroy(topo);
+    }
+}
+
+/* hwloc_topo_cache: the first get_topology() discovers and saves an entry,
+ * the next one loads that entry back instead of discovering, and the two
+ * describe the same machine - the loaded one still as this very machine,
+ * so binding keeps working. hwloc_topo_cache_refresh rewrites it. */
+static int test_topo_cache(void)
+{
+    int failures = 0;
+    char cachedir[] = "/tmp/prte_test_topocacheXXXXXX";
+    char *saved_file, *saved_cache, *entry, *again;
+    bool saved_refresh;
+    hwloc_topology_t saved_topo, discovered, loaded = NULL;
+    const struct hwloc_topology_support *support;
+    ino_t ino = 0, ino2 = 0;
+    int rc;
+
+    if (NULL == mkdtemp(cachedir)) {
+        fprintf(stderr, "SKIP test_topo_cache: could not create a temp dir\n");
+        return 0;
+    }
+    saved_file = prte_hwloc_base_topo_file;
+    saved_topo = prte_hwloc_topology;
+    saved_cache = prte_hwloc_base_topo_cache;
+    saved_refresh = prte_hwloc_base_topo_cache_refresh;
+    prte_hwloc_base_topo_file = NULL;
+    prte_hwloc_base_topo_cache = cachedir;
+    prte_hwloc_base_topo_cache_refresh = false;
+
+    /* save */
+    prte_hwloc_topology = NULL;
+    rc = prte_hwloc_base_get_topology();
+    discovered = prte_hwloc_topology;
+    if (PRTE_SUCCESS != rc || NULL == discovered) {
+        fprintf(stderr, "SKIP test_topo_cache: no topology to discover here\n");
+        goto done;
+    }
+    entry = topo_cache_entry(cachedir, &ino);
+    CHECK("discovery saves one cache entry", NULL != entry);
+    if (NULL == entry) {
+        goto done;
+    }
+
+    /* load: the entry is used as it is, not rediscovered and rewritten */
+    prte_hwloc_topology = NULL;
+    rc = prte_hwloc_base_get_topology();
+    loaded = prte_hwloc_topology;
+    CHECK("the cached topology loads", PRTE_SUCCESS == rc && NULL != loaded);
+    again = topo_cache_entry(cachedir, &ino2);
+    CHECK("the cached entry is read, not rewritten",
+          NULL != again && 0 == strcmp(entry, again) && ino == ino2);
+    free(again);
+    if (NULL != loaded) {
+        CHECK("the cached topology has the same PUs",
+              hwloc_get_nbobjs_by_type(discovered, HWLOC_OBJ_PU)
+                  == hwloc_get_nbobjs_by_type(loaded, HWLOC_OBJ_PU));
+        CHECK("the cached topology has the same cores",
+              hwloc_get_nbobjs_by_type(discovered, HWLOC_OBJ_CORE)
+                  == hwloc_get_nbobjs_by_type(loaded, HWLOC_OBJ_CORE));
+        CHECK("the cached topology has the same cpus",
+              hwloc_bitmap_isequal(hwloc_topology_get_topology_cpuset(discovered),
+                                   hwloc_topology_get_topology_cpuset(loaded)));
+        CHECK("the cached topology is this machine's",
+              hwloc_topology_is_thissystem(loaded));
+        support = hwloc_topology_get_support(loaded);
+        CHECK("the cached topology keeps the binding support",
+              NULL != support &&
+                  support->cpubind->set_thisproc_cpubind ==
+                      hwloc_topology_get_support(discovered)->cpubind->set_thisproc_cpubind);
+    }
+
+    /* refresh: rediscovered, and the entry rewritten in place */
+    prte_hwloc_base_topo_cache_refresh = true;
+    prte_hwloc_topology = NULL;
+    rc = prte_hwloc_base_get_topology();
+    CHECK("a refresh rediscovers", PRTE_SUCCESS == rc && NULL != prte_hwloc_topology);
+    topo_drop(prte_hwloc_topology);
+    again = topo_cache_entry(cachedir, &ino2);
+    CHECK("a refresh rewrites the entry",
+          NULL != again && 0 == strcmp(entry, again) && ino != ino2);
+    free(again);
+
+    unlink(entry);
+    free(entry);
+
+done:
+    topo_drop(discovered);
+    topo_drop(loaded);
+    rmdir(cachedir);
+    prte_hwloc_base_topo_file = saved_file;
+    prte_hwloc_topology = saved_topo;
+    prte_hwloc_base_topo_cache = saved_cache;
+    prte_hwloc_base_topo_cache_refresh = saved_refresh;
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_topo_cache\n");
+    }
+    return failures;
+}
+
 /* ------------------------------------------------------------------ */
 /* the default-binding chooser                                        */
 /* ------------------------------------------------------------------ */
@@ -1657,6 +1812,7 @@ int main(void)
     failures += test_index_basis();
     failures += test_print_binding();
     failures += test_topo_file();
+    failures += test_topo_cache();
     failures += test_default_binding();
     failures += test_binding_policy();
     failures += test_userdata();
@@ -207,6 +207,7 @@ static int test_daemon_cmd_uniqueness(void)
         PRTE_DAEMON_ABORT_PROCS_CALLED, PRTE_DAEMON_DVM_ADD_PROCS,
         PRTE_DAEMON_GET_STACK_TRACES, PRTE_DAEMON_GET_MEMPROFILE,
         PRTE_DAEMON_DVM_CLEANUP_JOB_CMD, PRTE_DAEMON_SHRINK_CMD,
+        PRTE_DAEMON_ADD_PROCS_BATCH,
     };
     size_t i, j, n = sizeof(cmds) / sizeof(cmds[0]);
 
@@ -274,6 +275,8 @@ static int test_classes(void)
     CHECK("spawn wdir NULL", NULL == cd->wdir);
     CHECK("spawn argv NULL", NULL == cd->argv);
     CHECK("spawn env NULL", NULL == cd->env);
+    CHECK("spawn env_template NULL", NULL == cd->env_template);
+    CHECK("spawn env not shared", !cd->env_shared);
     CHECK("spawn bind_cpuset NULL", NULL == cd->bind_cpuset);
     CHECK("spawn bind_fatal false", !cd->bind_fatal);
     CHECK("spawn do_membind false", !cd->do_membind);
@@ -474,6 +477,72 @@ static int test_process_envars(void)
     return failures;
 }
 
+/*
+ * Shared environment templates.  The template must be a private copy (the
+ * app's env is rebuilt on the next launch while children may still be
+ * waiting to fork), a composed envp must be the template followed by the
+ * overlay in that order, and an overlay that names a variable the template
+ * already sets must be refused so the child is set up the long way - the
+ * name comparison must stop at the '=', or PATH would match PATHEXT.
+ * Releasing the caddy must free the overlay but not the template strings.
+ */
+static int test_env_template(void)
+{
+    int failures = 0;
+    prte_odls_env_template_t *tmpl;
+    prte_odls_spawn_caddy_t *cd;
+    char **env, **overlay;
+    const char *v;
+
+    env = PMIx_Argv_split("PATH=/bin HOME=/home/u Z=last A=first", ' ');
+    tmpl = prte_odls_base_env_template(env);
+    CHECK("template built", NULL != tmpl);
+    if (NULL == tmpl) {
+        PMIx_Argv_free(env);
+        return failures;
+    }
+    PMIx_Argv_free(env);
+    CHECK("template count", 4 == tmpl->count);
+    CHECK("template keeps order", 0 == strcmp(tmpl->envp[0], "PATH=/bin")
+                                      && 0 == strcmp(tmpl->envp[3], "A=first"));
+    CHECK("template terminated", NULL == tmpl->envp[4]);
+    CHECK("byname sorted", 0 == strcmp(tmpl->byname[0], "A=first")
+                               && 0 == strcmp(tmpl->byname[3], "Z=last"));
+
+    /* a non-colliding overlay is appended after the shared entries */
+    cd = PMIX_NEW(prte_odls_spawn_caddy_t);
+    PMIX_RETAIN(tmpl);
+    cd->env_template = tmpl;
+    overlay = PMIx_Argv_split("PMIX_RANK=3 PATHEXT=.EXE", ' ');
+    CHECK("compose accepted", prte_odls_base_env_compose(cd, overlay));
+    CHECK("compose shared", cd->env_shared);
+    CHECK("compose shares template strings", cd->env[0] == tmpl->envp[0]);
+    CHECK("compose appends overlay", cd->env[4] == overlay[0] && cd->env[5] == overlay[1]);
+    CHECK("compose terminated", NULL == cd->env[6]);
+    v = envget(cd->env, "HOME");
+    CHECK("template value visible", NULL != v && 0 == strcmp(v, "/home/u"));
+    PMIX_RELEASE(cd);
+
+    /* an overlay that sets a template variable is refused untouched */
+    cd = PMIX_NEW(prte_odls_spawn_caddy_t);
+    PMIX_RETAIN(tmpl);
+    cd->env_template = tmpl;
+    overlay = PMIx_Argv_split("PMIX_RANK=3 HOME=/elsewhere", ' ');
+    CHECK("collision refused", !prte_odls_base_env_compose(cd, overlay));
+    CHECK("collision leaves env unset", NULL == cd->env && !cd->env_shared);
+    PMIx_Argv_free(overlay);
+    PMIX_RELEASE(cd);
+
+    /* the template outlives the caddies that shared it */
+    CHECK("template intact", 0 == strcmp(tmpl->envp[1], "HOME=/home/u"));
+    PMIX_RELEASE(tmpl);
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_env_template\n");
+    }
+    return failures;
+}
+
 /*
  * The child->parent pipe protocol.  The child half runs in the
  * async-signal-safe window between fork() and execve(), so the only thing
@@ -833,6 +902,7 @@ int main(void)
     failures += test_classes();
     failures += test_attribute_order();
     failures += test_process_envars();
+    failures += test_env_template();
     failures += test_child_pipe_protocol();
     failures += test_signal_skips_dead_procs();
     failures += test_mempolicy();
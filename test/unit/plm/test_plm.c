@@ -47,6 +47,17 @@
  *
  *   6. prte_plm_base_set_hnp_name / prte_plm_base_create_jobid: the DVM
  *      base nspace and the monotonic "base@N" job nspaces derived from it.
+ *
+ *   7. The launch window the ssh launcher steers its agent concurrency
+ *      with: slow start, the congestion cut and its once-per-window limit,
+ *      and the [1, ceiling] clamp.
+ *
+ *   8. prte_plm_base_batch_hold: which jobs it parks. Only a job that is
+ *      one of a batch spawn may be held - anything else must go straight
+ *      to the daemons - and a zero window turns holding off altogether.
+ *      A held batch goes out as one PRTE_DAEMON_ADD_PROCS_BATCH broadcast
+ *      carrying every member's launch message, once the last member is in
+ *      or the window runs out - whichever comes first.
  */
 
 #include "prte_config.h"
@@ -55,6 +66,7 @@
 #include <string.h>
 
 #include "constants.h"
+#include "src/event/event-internal.h"
 #include "src/mca/base/pmix_base.h"
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/runtime.h"
@@ -139,7 +151,8 @@ static int test_state_code_uniqueness(void)
         PRTE_JOB_STATE_LAUNCH_APPS, PRTE_JOB_STATE_SEND_LAUNCH_MSG, PRTE_JOB_STATE_RUNNING,
         PRTE_JOB_STATE_SUSPENDED, PRTE_JOB_STATE_REGISTERED, PRTE_JOB_STATE_WAITING_FOR_DAEMONS,
         PRTE_JOB_STATE_LOCAL_LAUNCH_COMPLETE, PRTE_JOB_STATE_READY_FOR_DEBUG,
-        PRTE_JOB_STATE_STARTED, PRTE_JOB_STATE_UNTERMINATED, PRTE_JOB_STATE_TERMINATED,
+        PRTE_JOB_STATE_STARTED, PRTE_JOB_STATE_QUEUED, PRTE_JOB_STATE_UNTERMINATED,
+        PRTE_JOB_STATE_TERMINATED,
         PRTE_JOB_STATE_ALL_JOBS_COMPLETE, PRTE_JOB_STATE_DAEMONS_TERMINATED,
         PRTE_JOB_STATE_NOTIFY_COMPLETED, PRTE_JOB_STATE_NOTIFIED, PRTE_JOB_STATE_ERROR,
         PRTE_JOB_STATE_KILLED_BY_CMD, PRTE_JOB_STATE_ABORTED, PRTE_JOB_STATE_FAILED_TO_START,
@@ -180,7 +193,8 @@ static int test_state_code_uniqueness(void)
     };
     int32_t cmds[] = {
         PRTE_PLM_LAUNCH_JOB_CMD, PRTE_PLM_UPDATE_PROC_STATE, PRTE_PLM_REGISTERED_CMD,
-        PRTE_PLM_TOOL_ATTACHED_CMD, PRTE_PLM_READY_FOR_DEBUG_CMD, PRTE_PLM_LOCAL_LAUNCH_COMP_CMD
+        PRTE_PLM_TOOL_ATTACHED_CMD, PRTE_PLM_READY_FOR_DEBUG_CMD, PRTE_PLM_LOCAL_LAUNCH_COMP_CMD,
+        PRTE_PLM_TOOL_DEPARTED_CMD, PRTE_PLM_LAUNCH_BATCH_CMD
     };
     struct {
         const char *name;
@@ -211,6 +225,7 @@ static int test_state_code_uniqueness(void)
      * "still running?" and "abnormal?" by comparing against them */
     CHECK("job running states below UNTERMINATED",
           PRTE_JOB_STATE_STARTED < PRTE_JOB_STATE_UNTERMINATED &&
+          PRTE_JOB_STATE_QUEUED < PRTE_JOB_STATE_UNTERMINATED &&
           PRTE_JOB_STATE_RUNNING < PRTE_JOB_STATE_UNTERMINATED &&
           PRTE_JOB_STATE_READY_FOR_DEBUG < PRTE_JOB_STATE_UNTERMINATED);
     CHECK("job TERMINATED above UNTERMINATED",
@@ -375,6 +390,237 @@ static int test_wrap_args(void)
     return failures;
 }
 
+/*
+ * The launch window grows by one per completion while latency stays near the
+ * best seen, halves once the smoothed latency passes twice that - but not
+ * again until a window's worth of launches has completed - and then grows
+ * by one per window.
+ */
+static int test_launch_window(void)
+{
+    int failures = 0;
+    prte_plm_base_launch_window_t w;
+    int i;
+
+    prte_plm_base_launch_window_init(&w, 0, 8);
+    CHECK("initial window is at least 1", 1 == w.window);
+    prte_plm_base_launch_window_init(&w, 100, 8);
+    CHECK("initial window is at most the ceiling", 8 == w.window);
+
+    /* slow start: +1 per completion */
+    prte_plm_base_launch_window_init(&w, 2, 64);
+    for (i = 0; i < 4; i++) {
+        prte_plm_base_launch_window_sample(&w, 1000);
+    }
+    CHECK("slow start grows per completion", 6 == w.window && w.slow_start);
+
+    /* latency climbs: the first slow sample only brings the average to 2x */
+    prte_plm_base_launch_window_sample(&w, 5000);
+    CHECK("2x the base is not yet congestion", 7 == w.window);
+    prte_plm_base_launch_window_sample(&w, 5000);
+    CHECK("no cut before a window of completions", 7 == w.window);
+    prte_plm_base_launch_window_sample(&w, 5000);
+    CHECK("congestion halves the window", 3 == w.window && !w.slow_start);
+    CHECK("peak is remembered", 7 == w.peak);
+    prte_plm_base_launch_window_sample(&w, 5000);
+    CHECK("at most one cut per window", 3 == w.window);
+    CHECK("worst latency is kept", 5000 == w.max_us && 8 == w.nsamples);
+
+    /* congestion avoidance: +1 per window of completions */
+    prte_plm_base_launch_window_init(&w, 4, 64);
+    w.slow_start = false;
+    for (i = 0; i < 3; i++) {
+        prte_plm_base_launch_window_sample(&w, 1000);
+    }
+    CHECK("avoidance waits for a full window", 4 == w.window);
+    prte_plm_base_launch_window_sample(&w, 1000);
+    CHECK("avoidance grows by one per window", 5 == w.window);
+
+    prte_plm_base_launch_window_init(&w, 1, 3);
+    for (i = 0; i < 10; i++) {
+        prte_plm_base_launch_window_sample(&w, 1000);
+    }
+    CHECK("window never passes the ceiling", 3 == w.window);
+
+    prte_plm_base_launch_window_init(&w, 1, 64);
+    w.slow_start = false;
+    prte_plm_base_launch_window_sample(&w, 1000);
+    for (i = 0; i < 10; i++) {
+        prte_plm_base_launch_window_sample(&w, 100000);
+    }
+    CHECK("window never drops below one", 1 == w.window);
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_launch_window\n");
+    }
+    return failures;
+}
+
+/* What the batch sender was handed, in place of the xcast: the tag, and
+ * the command, job count and each launch message's one string unpacked
+ * from the payload */
+#define BATCH_MAX_JOBS 4
+static int batch_sends = 0;
+static prte_rml_tag_t batch_tag = PRTE_RML_TAG_INVALID;
+static prte_daemon_cmd_flag_t batch_cmd = 0;
+static int32_t batch_njobs = 0;
+static char *batch_names[BATCH_MAX_JOBS];
+
+static int recording_batch_send(prte_rml_tag_t tag, pmix_data_buffer_t *msg)
+{
+    pmix_data_buffer_t copy, job;
+    pmix_byte_object_t bo;
+    int32_t n;
+    int cnt;
+
+    batch_sends++;
+    batch_tag = tag;
+    batch_njobs = -1;
+    PMIX_DATA_BUFFER_CONSTRUCT(&copy);
+    if (PMIX_SUCCESS != PMIx_Data_copy_payload(&copy, msg)) {
+        PMIX_DATA_BUFFER_DESTRUCT(&copy);
+        return PRTE_SUCCESS;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, &copy, &batch_cmd, &cnt, PMIX_UINT8)) {
+        PMIX_DATA_BUFFER_DESTRUCT(&copy);
+        return PRTE_SUCCESS;
+    }
+    cnt = 1;
+    if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, &copy, &batch_njobs, &cnt, PMIX_INT32)) {
+        batch_njobs = -1;
+    }
+    for (n = 0; n < batch_njobs && n < BATCH_MAX_JOBS; n++) {
+        free(batch_names[n]);
+        batch_names[n] = NULL;
+        cnt = 1;
+        if (PMIX_SUCCESS != PMIx_Data_unpack(NULL, &copy, &bo, &cnt, PMIX_BYTE_OBJECT)) {
+            break;
+        }
+        PMIX_DATA_BUFFER_CONSTRUCT(&job);
+        if (PMIX_SUCCESS == PMIx_Data_load(&job, &bo)) {
+            cnt = 1;
+            (void) PMIx_Data_unpack(NULL, &job, &batch_names[n], &cnt, PMIX_STRING);
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&job);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&copy);
+    return PRTE_SUCCESS;
+}
+
+/* a member of batch "room" of bsize jobs, its launch message holding just
+ * its name */
+static prte_job_t *batch_job(const char *name, uint32_t bsize, int room)
+{
+    prte_job_t *jdata;
+    char *str = (char *) name;
+
+    jdata = PMIX_NEW(prte_job_t);
+    PMIX_LOAD_NSPACE(jdata->nspace, name);
+    PMIX_LOAD_PROCID(&jdata->originator, "plm-batch-requestor", 0);
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_BATCH_SIZE, PRTE_ATTR_GLOBAL,
+                       &bsize, PMIX_UINT32);
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_ROOM_NUM, PRTE_ATTR_GLOBAL,
+                       &room, PMIX_INT);
+    (void) PMIx_Data_pack(NULL, &jdata->launch_msg, &str, 1, PMIX_STRING);
+    return jdata;
+}
+
+static int test_batch_hold(void)
+{
+    int failures = 0;
+    prte_job_t *jdata, *first, *second;
+    prte_plm_base_batch_send_fn_t send = prte_plm_base_batch_send;
+    prte_event_base_t *base = prte_event_base;
+    uint32_t bsize;
+    int room = 3, window, n;
+
+    window = prte_plm_globals.batch_window;
+    prte_plm_globals.batch_window = 100;
+    prte_plm_base_batch_send = recording_batch_send;
+    /* a held batch arms its window on the main base */
+    if (NULL == prte_event_base) {
+        prte_event_base = prte_event_base_create();
+    }
+
+    jdata = PMIX_NEW(prte_job_t);
+    CHECK("a job outside any batch is not held", !prte_plm_base_batch_hold(jdata));
+
+    bsize = 1;
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_BATCH_SIZE, PRTE_ATTR_GLOBAL,
+                       &bsize, PMIX_UINT32);
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_ROOM_NUM, PRTE_ATTR_GLOBAL,
+                       &room, PMIX_INT);
+    CHECK("a batch of one is not held", !prte_plm_base_batch_hold(jdata));
+
+    bsize = 4;
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_BATCH_SIZE, PRTE_ATTR_GLOBAL,
+                       &bsize, PMIX_UINT32);
+    prte_plm_globals.batch_window = 0;
+    CHECK("a zero window holds nothing", !prte_plm_base_batch_hold(jdata));
+    CHECK("nothing was left pending", 0 == pmix_list_get_size(&prte_plm_globals.batches));
+    PMIX_RELEASE(jdata);
+    CHECK("nothing was sent", 0 == batch_sends);
+
+    /* === a batch of two: the first is held, the second sends both === */
+    prte_plm_globals.batch_window = 100;
+    first = batch_job("plm-batch-a", 2, 5);
+    second = batch_job("plm-batch-b", 2, 5);
+    CHECK("the first of two is held", prte_plm_base_batch_hold(first));
+    CHECK("and waits for the other", 0 == batch_sends);
+    CHECK("in a batch of its own", 1 == pmix_list_get_size(&prte_plm_globals.batches));
+    CHECK("the second of two is held", prte_plm_base_batch_hold(second));
+    CHECK("a complete batch goes out once", 1 == batch_sends);
+    CHECK("as a launch", PRTE_RML_TAG_DAEMON_LAUNCH == batch_tag);
+    CHECK("of the batch command", PRTE_DAEMON_ADD_PROCS_BATCH == batch_cmd);
+    CHECK("carrying both jobs", 2 == batch_njobs);
+    CHECK("the first job's message first",
+          NULL != batch_names[0] && 0 == strcmp("plm-batch-a", batch_names[0]));
+    CHECK("the second job's message second",
+          NULL != batch_names[1] && 0 == strcmp("plm-batch-b", batch_names[1]));
+    CHECK("the batch is gone", 0 == pmix_list_get_size(&prte_plm_globals.batches));
+    CHECK("the messages were handed over",
+          0 == first->launch_msg.bytes_used && 0 == second->launch_msg.bytes_used);
+    CHECK("each job counts us as reported",
+          1 == first->num_daemons_reported && 1 == second->num_daemons_reported);
+    PMIX_RELEASE(first);
+    PMIX_RELEASE(second);
+
+    /* === a member that never arrives: the window sends the rest === */
+    prte_plm_globals.batch_window = 10;
+    first = batch_job("plm-batch-c", 3, 6);
+    CHECK("the first of three is held", prte_plm_base_batch_hold(first));
+    CHECK("and waits for the others", 1 == batch_sends);
+    /* each pass blocks until something fires - the window, if nothing else */
+    for (n = 0; 1 == batch_sends && n < 100; n++) {
+        prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
+    }
+    CHECK("the window sends what it has", 2 == batch_sends);
+    CHECK("still as the batch command",
+          PRTE_RML_TAG_DAEMON_LAUNCH == batch_tag && PRTE_DAEMON_ADD_PROCS_BATCH == batch_cmd);
+    CHECK("carrying the one job held", 1 == batch_njobs);
+    CHECK("its message",
+          NULL != batch_names[0] && 0 == strcmp("plm-batch-c", batch_names[0]));
+    CHECK("the expired batch is gone", 0 == pmix_list_get_size(&prte_plm_globals.batches));
+    PMIX_RELEASE(first);
+
+    for (n = 0; n < BATCH_MAX_JOBS; n++) {
+        free(batch_names[n]);
+        batch_names[n] = NULL;
+    }
+    if (base != prte_event_base) {
+        prte_event_base_free(prte_event_base);
+        prte_event_base = base;
+    }
+    prte_plm_base_batch_send = send;
+    prte_plm_globals.batch_window = window;
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_batch_hold\n");
+    }
+    return failures;
+}
+
 /*
  * setup_prted_cmd splits the launch agent and returns the index of the
  * "prted" word, which is what lets ssh separate a wrapper prefix
@@ -992,6 +1238,8 @@ int main(void)
     failures += test_append_basic_args();
     failures += test_naming();
     failures += test_state_update_wire();
+    failures += test_launch_window();
+    failures += test_batch_hold();
     /* leaves the global job/node pools populated, so run it last */
     failures += test_setup_vm();
 
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Tests hot-job replay (rmaps_base_hot.c).
+ *
+ * A recorded map is only worth replaying if it is the map the mapper would
+ * have produced, so the two halves are checked against each other: a map is
+ * recorded, the DVM goes idle, and the replay into a fresh job has to come
+ * back with the same procs on the same nodes with the same ranks and
+ * bindings, and leave the nodes' cpus as the original map left them.  The
+ * other half is refusal - a replay on a DVM that is not the one the map was
+ * made on (another recovery epoch, another daemon count, a node whose cpus
+ * have changed, or a pool that is not idle) must leave the job untouched so
+ * the mapper runs as it always did.
+ *
+ * No mapper, topology or DVM is involved: the nodes are built by hand and
+ * placed in the node pool, which is all record and replay look at.
+ */
+
+#include "prte_config.h"
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "constants.h"
+#include "src/grpcomm/grpcomm_internal.h"
+#include "src/hwloc/hwloc-internal.h"
+#include "src/mca/plm/plm_types.h"
+#include "src/mca/rmaps/base/base.h"
+#include "src/runtime/prte_globals.h"
+#include "src/util/pmix_printf.h"
+#include "src/util/proc_info.h"
+
+int test_hot(void);
+
+#define CHECK(label, cond)                                              \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            fprintf(stderr, "FAIL [%s]: %s\n", label, #cond);           \
+            failures++;                                                 \
+        }                                                               \
+    } while (0)
+
+#define HOT_NNODES 2
+#define HOT_NPER   2
+
+/* the cpus of the i'th proc on a node: two apiece from cpu 0 up */
+static const char *hot_cpus[HOT_NPER] = {"0-1", "2-3"};
+
+static prte_job_t *new_job(const char *nspace)
+{
+    prte_job_t *jdata;
+    prte_app_context_t *app;
+
+    jdata = PMIX_NEW(prte_job_t);
+    PMIX_LOAD_NSPACE(jdata->nspace, nspace);
+    jdata->map = PMIX_NEW(prte_job_map_t);
+    app = PMIX_NEW(prte_app_context_t);
+    app->app = strdup("hostname");
+    app->idx = pmix_pointer_array_add(jdata->apps, app);
+    jdata->num_apps = 1;
+    return jdata;
+}
+
+/* lay the job out by hand as a mapper would leave it: HOT_NPER procs on
+ * each node, ranked by slot, each bound to its own pair of cpus, and the
+ * bound cpus gone from the node's available set */
+static void map_job(prte_job_t *jdata, prte_node_t **nodes, hwloc_cpuset_t post)
+{
+    prte_app_context_t *app;
+    prte_proc_t *proc;
+    pmix_rank_t r;
+    int n;
+
+    for (n = 0; n < HOT_NNODES; n++) {
+        PMIX_RETAIN(nodes[n]);
+        pmix_pointer_array_add(jdata->map->nodes, nodes[n]);
+        jdata->map->num_nodes++;
+        hwloc_bitmap_copy(nodes[n]->jobcache, nodes[n]->available);
+    }
+    for (r = 0; r < HOT_NNODES * HOT_NPER; r++) {
+        n = r / HOT_NPER;
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, jdata->nspace, r);
+        proc->app_idx = 0;
+        proc->node = nodes[n];
+        proc->local_rank = r % HOT_NPER;
+        proc->node_rank = r % HOT_NPER;
+        proc->app_rank = r;
+        proc->cpuset = strdup(hot_cpus[r % HOT_NPER]);
+        pmix_pointer_array_add(nodes[n]->procs, proc);
+        nodes[n]->num_procs++;
+        nodes[n]->slots_inuse++;
+        PMIX_RETAIN(proc);
+        pmix_pointer_array_set_item(jdata->procs, r, proc);
+    }
+    jdata->num_procs = HOT_NNODES * HOT_NPER;
+    app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, 0);
+    app->num_procs = jdata->num_procs;
+    for (n = 0; n < HOT_NNODES; n++) {
+        hwloc_bitmap_copy(nodes[n]->available, post);
+    }
+}
+
+/* the job has finished: its procs leave the nodes and the cpus come back */
+static void idle_nodes(prte_node_t **nodes, hwloc_cpuset_t pre)
+{
+    prte_proc_t *proc;
+    int n, i;
+
+    for (n = 0; n < HOT_NNODES; n++) {
+        for (i = 0; i < nodes[n]->procs->size; i++) {
+            proc = (prte_proc_t *) pmix_pointer_array_get_item(nodes[n]->procs, i);
+            if (NULL != proc) {
+                pmix_pointer_array_set_item(nodes[n]->procs, i, NULL);
+                PMIX_RELEASE(proc);
+            }
+        }
+        nodes[n]->num_procs = 0;
+        nodes[n]->slots_inuse = 0;
+        hwloc_bitmap_copy(nodes[n]->available, pre);
+    }
+}
+
+/* a refused replay hands back no mapper and leaves the job as it was */
+static int refused(const char *label, pmix_byte_object_t *key)
+{
+    int failures = 0;
+    prte_job_t *jdata;
+    const char *mapper;
+
+    jdata = new_job("hotrefused");
+    mapper = prte_rmaps_base_hot_replay(jdata, key);
+    CHECK(label, NULL == mapper);
+    CHECK(label, 0 == jdata->num_procs);
+    CHECK(label, 0 == jdata->map->num_nodes);
+    PMIX_RELEASE(jdata);
+    return failures;
+}
+
+int test_hot(void)
+{
+    int failures = 0;
+    prte_node_t *nodes[HOT_NNODES];
+    prte_job_t *jdata;
+    prte_proc_t *proc;
+    prte_node_t *node;
+    prte_app_context_t *app;
+    pmix_list_item_t *item;
+    hwloc_cpuset_t pre, post;
+    pmix_byte_object_t key, other;
+    const char *mapper;
+    bool made_pool = false;
+    pmix_rank_t ndaemons;
+    int hot_jobs, n;
+    pmix_rank_t r;
+    char kbytes[] = "hot-key", obytes[] = "other-key";
+
+    if (NULL == prte_node_pool) {
+        prte_node_pool = PMIX_NEW(pmix_pointer_array_t);
+        pmix_pointer_array_init(prte_node_pool, 8, INT_MAX, 8);
+        made_pool = true;
+    }
+    ndaemons = prte_process_info.num_daemons;
+    prte_process_info.num_daemons = HOT_NNODES + 1;
+    hot_jobs = prte_rmaps_base.hot_jobs;
+    prte_rmaps_base.hot_jobs = 8;
+
+    pre = hwloc_bitmap_alloc();
+    hwloc_bitmap_set_range(pre, 0, 7);
+    post = hwloc_bitmap_alloc();
+    hwloc_bitmap_set_range(post, 4, 7);
+    for (n = 0; n < HOT_NNODES; n++) {
+        nodes[n] = PMIX_NEW(prte_node_t);
+        pmix_asprintf(&nodes[n]->name, "hotnode%d", n);
+        nodes[n]->index = pmix_pointer_array_add(prte_node_pool, nodes[n]);
+        nodes[n]->state = PRTE_NODE_STATE_UP;
+        nodes[n]->slots = HOT_NPER;
+        nodes[n]->available = hwloc_bitmap_dup(pre);
+        nodes[n]->jobcache = hwloc_bitmap_alloc();
+    }
+    key.bytes = kbytes;
+    key.size = sizeof(kbytes);
+    other.bytes = obytes;
+    other.size = sizeof(obytes);
+
+    /* === record a map made on an otherwise idle DVM === */
+    jdata = new_job("hotfirst");
+    map_job(jdata, nodes, post);
+    prte_rmaps_base_hot_record(jdata, &key, "round_robin");
+    CHECK("record: shape kept", 1 == pmix_list_get_size(&prte_rmaps_base.hot_shapes));
+    PMIX_RELEASE(jdata);
+    idle_nodes(nodes, pre);
+
+    /* === replay rebuilds the same procs, ranks and cpusets === */
+    jdata = new_job("hotsecond");
+    mapper = prte_rmaps_base_hot_replay(jdata, &key);
+    CHECK("replay: mapper", NULL != mapper && 0 == strcmp("round_robin", mapper));
+    CHECK("replay: nprocs", HOT_NNODES * HOT_NPER == jdata->num_procs);
+    CHECK("replay: nnodes", HOT_NNODES == jdata->map->num_nodes);
+    app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, 0);
+    CHECK("replay: app nprocs", HOT_NNODES * HOT_NPER == app->num_procs);
+    for (r = 0; r < HOT_NNODES * HOT_NPER; r++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, r);
+        CHECK("replay: proc present", NULL != proc);
+        if (NULL == proc) {
+            continue;
+        }
+        CHECK("replay: rank", r == proc->name.rank);
+        CHECK("replay: nspace", PMIX_CHECK_NSPACE(jdata->nspace, proc->name.nspace));
+        CHECK("replay: node", nodes[r / HOT_NPER] == proc->node);
+        CHECK("replay: local rank", (r % HOT_NPER) == proc->local_rank);
+        CHECK("replay: node rank", (r % HOT_NPER) == proc->node_rank);
+        CHECK("replay: app rank", r == proc->app_rank);
+        CHECK("replay: cpuset", NULL != proc->cpuset &&
+                                0 == strcmp(hot_cpus[r % HOT_NPER], proc->cpuset));
+    }
+    for (n = 0; n < HOT_NNODES; n++) {
+        node = nodes[n];
+        CHECK("replay: node mapped",
+              node == pmix_pointer_array_get_item(jdata->map->nodes, n));
+        CHECK("replay: slots in use", HOT_NPER == node->slots_inuse);
+        CHECK("replay: available as mapped", hwloc_bitmap_isequal(node->available, post));
+        CHECK("replay: jobcache as mapped", hwloc_bitmap_isequal(node->jobcache, pre));
+    }
+
+    /* === and nothing is replayed onto a busy DVM === */
+    failures += refused("busy", &key);
+    PMIX_RELEASE(jdata);
+    idle_nodes(nodes, pre);
+
+    /* === a key that was never recorded === */
+    failures += refused("other key", &other);
+
+    /* === another recovery epoch === */
+    prte_grpcomm_globals.recovery_epoch++;
+    failures += refused("epoch", &key);
+    prte_grpcomm_globals.recovery_epoch--;
+
+    /* === another daemon count === */
+    prte_process_info.num_daemons++;
+    failures += refused("daemons", &key);
+    prte_process_info.num_daemons--;
+
+    /* === a node whose cpus are not those the map was made on === */
+    hwloc_bitmap_clr(nodes[1]->available, 7);
+    failures += refused("available", &key);
+    hwloc_bitmap_set(nodes[1]->available, 7);
+
+    /* === a node gone down === */
+    nodes[0]->state = PRTE_NODE_STATE_DOWN;
+    failures += refused("node down", &key);
+    nodes[0]->state = PRTE_NODE_STATE_UP;
+
+    /* with everything back as it was, the shape is good again */
+    jdata = new_job("hotthird");
+    mapper = prte_rmaps_base_hot_replay(jdata, &key);
+    CHECK("restored: replayed", NULL != mapper);
+    CHECK("restored: nprocs", HOT_NNODES * HOT_NPER == jdata->num_procs);
+    PMIX_RELEASE(jdata);
+    idle_nodes(nodes, pre);
+
+    while (NULL != (item = pmix_list_remove_first(&prte_rmaps_base.hot_shapes))) {
+        PMIX_RELEASE(item);
+    }
+    for (n = 0; n < HOT_NNODES; n++) {
+        pmix_pointer_array_set_item(prte_node_pool, nodes[n]->index, NULL);
+        PMIX_RELEASE(nodes[n]);
+    }
+    if (made_pool) {
+        PMIX_RELEASE(prte_node_pool);
+        prte_node_pool = NULL;
+    }
+    hwloc_bitmap_free(pre);
+    hwloc_bitmap_free(post);
+    prte_process_info.num_daemons = ndaemons;
+    prte_rmaps_base.hot_jobs = hot_jobs;
+
+    if (0 == failures) {
+        fprintf(stdout, "  PASS test_hot\n");
+    }
+    return failures;
+}
@@ -34,6 +34,7 @@ extern int test_ppr(void);
 extern int test_seq(void);
 extern int test_rank_file(void);
 extern int test_devices(bool pmix_up);
+extern int test_hot(void);
 
 /* shared with the mapper tests in this directory */
 prte_rmaps_base_module_t *test_rmaps_module(const char *name);
@@ -114,6 +115,7 @@ int main(void)
     failures += test_seq();
     failures += test_rank_file();
     failures += test_devices(pmix_up);
+    failures += test_hot();
 
     /* Order matters, and getting it wrong is a segfault rather than a
      * leak.  In an --enable-mca-dso build PRRTE's components are shared
@@ -49,9 +49,12 @@
 #include "prte_config.h"
 #include "constants.h"
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #ifdef HAVE_NETINET_IN_H
 #    include <netinet/in.h>
 #endif
@@ -61,21 +64,29 @@
 #ifdef HAVE_NET_IF_H
 #    include <net/if.h>
 #endif
+#ifdef HAVE_SYS_UN_H
+#    include <sys/un.h>
+#endif
 
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/prte_worker_pool.h"
 #include "src/runtime/runtime.h"
+#include "src/util/name_fns.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_if.h"
+#include "src/util/pmix_printf.h"
 
 #include "src/pmix/pmix-internal.h"
 #include "src/rml/rml.h"
 #include "src/rml/oob/oob.h"
 #include "src/rml/oob/oob_tcp.h"
 #include "src/rml/oob/oob_tcp_hdr.h"
+#include "src/rml/oob/oob_tcp_common.h"
 #include "src/rml/oob/oob_tcp_connection.h"
+#include "src/rml/oob/oob_tcp_listener.h"
 #include "src/rml/oob/oob_tcp_peer.h"
 #include "src/rml/oob/oob_tcp_sendrecv.h"
+#include "src/rml/rml_stats.h"
 
 #define CHECK(label, cond)                                    \
     do {                                                      \
@@ -345,6 +356,90 @@ static int test_subnet_resolves_and_dedupes(void)
     return failures;
 }
 
+/*
+ * A chained payload is sent as the concatenation of its pieces, and the
+ * pieces are taken, not copied: the buffer a segment came from is left
+ * empty, and what the segment holds is only what had not been unpacked from
+ * it.  flatten() is the concatenation the wire carries, so check against it.
+ * Needs PMIx up, so it runs inside test_payload_outlives_sends.
+ */
+static int test_payload_chain(void)
+{
+    int failures = 0;
+    prte_rml_payload_t *payload;
+    pmix_data_buffer_t *hdr, *msg, *flat;
+    pmix_byte_object_t bo;
+    static const char head[] = "chain-head";
+    static const char body[] = "chain-body-after-the-read-header";
+    uint32_t stamp = 7, got;
+    int32_t cnt;
+    char *base;
+    size_t rest;
+    int rc;
+
+    payload = PMIX_NEW(prte_rml_payload_t);
+    CHECK("chain: a payload starts with no segments", 0 == payload->nsegs);
+    PMIX_DATA_BUFFER_CREATE(hdr);
+    bo.size = sizeof(head);
+    bo.bytes = malloc(bo.size);
+    memcpy(bo.bytes, head, bo.size);
+    rc = PMIx_Data_load(hdr, &bo);
+    CHECK("chain: header loads", PMIX_SUCCESS == rc);
+    payload->dbuf = hdr;
+
+    /* a received message whose header has been read */
+    PMIX_DATA_BUFFER_CREATE(msg);
+    rc = PMIx_Data_pack(NULL, msg, &stamp, 1, PMIX_UINT32);
+    CHECK("chain: stamp packs", PMIX_SUCCESS == rc);
+    bo.bytes = (char *) body;
+    bo.size = sizeof(body);
+    rc = PMIx_Data_pack(NULL, msg, &bo, 1, PMIX_BYTE_OBJECT);
+    CHECK("chain: body packs", PMIX_SUCCESS == rc);
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, msg, &got, &cnt, PMIX_UINT32);
+    CHECK("chain: stamp unpacks", PMIX_SUCCESS == rc && stamp == got);
+    base = msg->base_ptr;
+    rest = msg->bytes_used - (size_t) (msg->unpack_ptr - msg->base_ptr);
+
+    rc = prte_rml_payload_take(payload, msg);
+    CHECK("chain: take succeeds", PRTE_SUCCESS == rc);
+    CHECK("chain: the source is left empty",
+          NULL == msg->base_ptr && 0 == msg->bytes_used);
+    CHECK("chain: the bytes moved rather than copied",
+          1 == payload->nsegs && base == payload->segs[0]->base_ptr);
+    CHECK("chain: the size is the header and the unread rest",
+          sizeof(head) + rest == prte_rml_payload_size(payload));
+    PMIX_DATA_BUFFER_RELEASE(msg);
+
+    PMIX_DATA_BUFFER_CREATE(flat);
+    rc = prte_rml_payload_flatten(payload, flat);
+    CHECK("chain: flattens", PRTE_SUCCESS == rc);
+    CHECK("chain: flat is as long as the chain",
+          prte_rml_payload_size(payload) == flat->bytes_used);
+    CHECK("chain: the header comes first",
+          0 == memcmp(flat->base_ptr, head, sizeof(head)));
+    /* what follows is what a receiver unpacks where the stamp left off */
+    flat->unpack_ptr += sizeof(head);
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, flat, &bo, &cnt, PMIX_BYTE_OBJECT);
+    CHECK("chain: the segment follows intact",
+          PMIX_SUCCESS == rc && sizeof(body) == bo.size
+              && 0 == memcmp(bo.bytes, body, sizeof(body)));
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    }
+    PMIX_DATA_BUFFER_RELEASE(flat);
+
+    rc = prte_rml_payload_take(payload, NULL);
+    CHECK("chain: nothing to take is refused", PRTE_ERR_BAD_PARAM == rc);
+    PMIX_RELEASE(payload);
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_payload_chain\n");
+    }
+    return failures;
+}
+
 /*
  * A shared payload outlives the sends that transmit it.
  *
@@ -420,6 +515,8 @@ static int test_payload_outlives_sends(void)
     CHECK("a refused send takes no reference", 1 == payload->super.obj_reference_count);
     PMIX_RELEASE(payload);
 
+    failures += test_payload_chain();
+
     PMIx_server_finalize();
 
     if (0 == failures) {
@@ -607,6 +704,450 @@ static int test_wire_header(void)
     return failures;
 }
 
+/* A handshake is read as it arrives, not waited for.
+ *
+ * A connector that sends its IDENT a few bytes at a time used to hold the
+ * receiving thread in a read loop until the rest turned up, and with it every
+ * other connection on that base.  prte_oob_tcp_peer_recv_connect_ack now
+ * takes what is there, says PRTE_ERR_WOULD_BLOCK, and carries on from the
+ * same place on the next call.  A PROBE exercises the reads without needing
+ * a peer table: the header and the nspace, dribbled in, and the reply that
+ * comes back once they are complete.  A connector that gives up part way
+ * through is disposed of rather than waited on.
+ */
+static int test_handshake_resumes(void)
+{
+    int failures = 0;
+    int sv[2], rc;
+    prte_oob_tcp_hdr_t snd, rcv, out;
+    prte_oob_tcp_handshake_t hs;
+    char wire[sizeof(prte_oob_tcp_hdr_t)];
+    size_t len;
+    const char *ns = "prterun-somenode-12345@0";
+
+    PMIX_LOAD_NSPACE(PRTE_PROC_MY_NAME->nspace, ns);
+    PRTE_PROC_MY_NAME->rank = 0;
+
+    memset(&snd, 0, sizeof(snd));
+    snd.origin = 4;
+    snd.dst = 0;
+    snd.type = MCA_OOB_TCP_PROBE;
+    PRTE_OOB_TCP_HDR_LOAD_NSPACE(&snd, ns);
+    len = PRTE_OOB_TCP_HDR_LEN(&snd);
+    MCA_OOB_TCP_HDR_HTON(&snd);
+    memcpy(wire, &snd, len);
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        fprintf(stdout, "SKIPPED test_handshake_resumes: no socketpair\n");
+        return 0;
+    }
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL, 0) | O_NONBLOCK);
+    memset(&hs, 0, sizeof(hs));
+    prte_oob_tcp_handshake_start(&hs);
+
+    CHECK("nothing sent yet", PRTE_ERR_WOULD_BLOCK
+          == prte_oob_tcp_peer_recv_connect_ack(NULL, sv[0], &hs, &out));
+
+    CHECK("part of the fixed header written", 5 == write(sv[1], wire, 5));
+    rc = prte_oob_tcp_peer_recv_connect_ack(NULL, sv[0], &hs, &out);
+    CHECK("a partial header waits for the rest", PRTE_ERR_WOULD_BLOCK == rc);
+    CHECK("and keeps what it read", PRTE_OOB_TCP_HS_HDR == hs.phase && 5 == hs.got);
+
+    CHECK("the rest of the header and some nspace written",
+          (ssize_t) (PRTE_OOB_TCP_HDR_FIXED + 3 - 5)
+          == write(sv[1], wire + 5, PRTE_OOB_TCP_HDR_FIXED + 3 - 5));
+    rc = prte_oob_tcp_peer_recv_connect_ack(NULL, sv[0], &hs, &out);
+    CHECK("a partial nspace waits for the rest", PRTE_ERR_WOULD_BLOCK == rc);
+    CHECK("with the header behind it", PRTE_OOB_TCP_HS_NSPACE == hs.phase && 3 == hs.got);
+
+    CHECK("the rest of the nspace written",
+          (ssize_t) (len - PRTE_OOB_TCP_HDR_FIXED - 3)
+          == write(sv[1], wire + PRTE_OOB_TCP_HDR_FIXED + 3, len - PRTE_OOB_TCP_HDR_FIXED - 3));
+    rc = prte_oob_tcp_peer_recv_connect_ack(NULL, sv[0], &hs, &out);
+    CHECK("the completed probe is answered", PRTE_SUCCESS == rc);
+    CHECK("the probe header came back whole",
+          MCA_OOB_TCP_PROBE == out.type && 4 == out.origin && 0 == strcmp(out.nspace, ns));
+
+    memset(&rcv, 0, sizeof(rcv));
+    CHECK("a reply was sent",
+          (ssize_t) PRTE_OOB_TCP_HDR_FIXED == read(sv[1], &rcv, PRTE_OOB_TCP_HDR_FIXED));
+    MCA_OOB_TCP_HDR_NTOH(&rcv);
+    CHECK("the reply is a probe addressed to the prober",
+          MCA_OOB_TCP_PROBE == rcv.type && 4 == rcv.dst);
+    close(sv[1]);
+
+    /* a connector that leaves part way through */
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        fprintf(stdout, "SKIPPED test_handshake_resumes: no socketpair\n");
+        return failures;
+    }
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL, 0) | O_NONBLOCK);
+    prte_oob_tcp_handshake_start(&hs);
+    CHECK("a fragment written", 3 == write(sv[1], wire, 3));
+    CHECK("the fragment waits", PRTE_ERR_WOULD_BLOCK
+          == prte_oob_tcp_peer_recv_connect_ack(NULL, sv[0], &hs, &out));
+    close(sv[1]);
+    CHECK("a connector that closed part way is given up on", PRTE_ERR_UNREACH
+          == prte_oob_tcp_peer_recv_connect_ack(NULL, sv[0], &hs, &out));
+    prte_oob_tcp_handshake_reset(&hs);
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_handshake_resumes\n");
+    }
+    return failures;
+}
+
+/* A bulk message longer than a segment goes out a segment at a time, and a
+ * control message queued behind it goes out between two of its segments
+ * rather than after the whole of it.
+ *
+ * Both are queued through prte_oob_tcp_queue_msg, so the lane each takes is
+ * the one the tag picks, and the send handler is driven by hand in place of
+ * the send event.  They are relays (data with no RML message) so that
+ * completing them needs no progress thread.  What comes out of the socket is
+ * read frame by frame: the slices are SEG until the last, which is SEG_LAST;
+ * the control message sits between two of them whole; and the slices put
+ * back together give the bytes that went in.  The slices before the last are
+ * then fed to a receiving peer, which has to reassemble them in bulk_recv -
+ * the last is left out, as completing it would deliver to the RML.
+ */
+static int read_full(int fd, void *buf, size_t len)
+{
+    ssize_t n;
+    size_t got = 0;
+
+    while (got < len) {
+        n = read(fd, (char *) buf + got, len - got);
+        if (n <= 0) {
+            return -1;
+        }
+        got += n;
+    }
+    return 0;
+}
+
+static prte_oob_tcp_send_t *queued_relay(prte_oob_tcp_peer_t *peer, prte_rml_tag_t tag,
+                                         uint32_t seq, size_t len, char fill)
+{
+    prte_oob_tcp_send_t *snd;
+    size_t n;
+
+    snd = PMIX_NEW(prte_oob_tcp_send_t);
+    snd->hdr.origin = 0;
+    snd->hdr.dst = peer->name.rank;
+    snd->hdr.tag = tag;
+    snd->hdr.seq_num = seq;
+    snd->hdr.nbytes = len;
+    snd->hdr.type = MCA_OOB_TCP_USER;
+    MCA_OOB_TCP_HDR_HTON(&snd->hdr);
+    snd->data = (char *) malloc(len);
+    for (n = 0; n < len; n++) {
+        snd->data[n] = (char) (fill + n % 251);
+    }
+    snd->peer = (struct prte_oob_tcp_peer_t *) peer;
+    snd->activate = false;
+    prte_oob_tcp_queue_msg(-1, 0, snd);
+    return snd;
+}
+
+#define SEG_TEST_SEGMENT 1024
+#define SEG_TEST_BULK    (3 * SEG_TEST_SEGMENT + 928)
+#define SEG_TEST_CTL     16
+
+static int test_segments_interleave(void)
+{
+    int failures = 0;
+    int sv[2], rv[2], n, nframes, ctl_at = -1;
+    int saved_segment = prte_oob_base.segment_size;
+    bool saved_ctl = prte_oob_base.control_tags[PRTE_RML_TAG_DAEMON_DIED];
+    bool saved_bulk = prte_oob_base.control_tags[PRTE_RML_TAG_XCAST];
+    prte_oob_tcp_peer_t *peer, *rpeer;
+    prte_oob_tcp_send_t *bulk, *ctl;
+    prte_oob_tcp_hdr_t frames[8], wire[8];
+    char *bodies[8] = {NULL};
+    char *expect, *got;
+    size_t off;
+
+    PMIX_LOAD_NSPACE(PRTE_PROC_MY_NAME->nspace, "prterun-somenode-12345@0");
+    PRTE_PROC_MY_NAME->rank = 0;
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        fprintf(stdout, "SKIPPED test_segments_interleave: no socketpair\n");
+        return 0;
+    }
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, rv)) {
+        close(sv[0]);
+        close(sv[1]);
+        fprintf(stdout, "SKIPPED test_segments_interleave: no socketpair\n");
+        return 0;
+    }
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL, 0) | O_NONBLOCK);
+    fcntl(rv[0], F_SETFL, fcntl(rv[0], F_GETFL, 0) | O_NONBLOCK);
+
+    prte_oob_base.segment_size = SEG_TEST_SEGMENT;
+    prte_oob_base.control_tags[PRTE_RML_TAG_DAEMON_DIED] = true;
+    prte_oob_base.control_tags[PRTE_RML_TAG_XCAST] = false;
+
+    peer = PMIX_NEW(prte_oob_tcp_peer_t);
+    PMIX_LOAD_PROCID(&peer->name, PRTE_PROC_MY_NAME->nspace, 1);
+    peer->sd = sv[0];
+    /* queued while the handshake is still going, so that nothing arms the
+     * send event - the calls below stand in for it */
+    peer->state = MCA_OOB_TCP_CONNECT_ACK;
+
+    bulk = queued_relay(peer, PRTE_RML_TAG_XCAST, 1, SEG_TEST_BULK, 'a');
+    CHECK("the bulk message is on deck", peer->send_msg == bulk);
+    CHECK("and is sent in segments", bulk->segmented && !bulk->control);
+
+    peer->state = MCA_OOB_TCP_CONNECTED;
+    prte_oob_tcp_send_handler(sv[0], 0, peer);
+    CHECK("the first segment went out", SEG_TEST_SEGMENT == bulk->seg_off);
+    CHECK("and the message stays on deck", peer->send_msg == bulk);
+
+    peer->state = MCA_OOB_TCP_CONNECT_ACK;
+    ctl = queued_relay(peer, PRTE_RML_TAG_DAEMON_DIED, 2, SEG_TEST_CTL, 'A');
+    peer->state = MCA_OOB_TCP_CONNECTED;
+    CHECK("the control message takes the control lane",
+          ctl->control && !ctl->segmented && 1 == pmix_list_get_size(&peer->ctl_queue));
+
+    prte_oob_tcp_send_handler(sv[0], 0, peer);
+    CHECK("the bulk message stands aside after its next segment",
+          peer->bulk_msg == bulk && 2 * SEG_TEST_SEGMENT == bulk->seg_off);
+    CHECK("for the control message", peer->send_msg == ctl);
+
+    /* the control message goes whole, then the rest of the bulk one */
+    for (n = 0; n < 8 && NULL != peer->send_msg; n++) {
+        prte_oob_tcp_send_handler(sv[0], 0, peer);
+    }
+    CHECK("everything was sent", NULL == peer->send_msg && NULL == peer->bulk_msg);
+
+    /* now read what went out */
+    expect = (char *) malloc(SEG_TEST_BULK);
+    got = (char *) malloc(SEG_TEST_BULK);
+    for (off = 0; off < SEG_TEST_BULK; off++) {
+        expect[off] = (char) ('a' + off % 251);
+    }
+    off = 0;
+    for (nframes = 0; nframes < 8; nframes++) {
+        if (0 != read_full(sv[1], &wire[nframes], PRTE_OOB_TCP_HDR_FIXED)) {
+            break;
+        }
+        frames[nframes] = wire[nframes];
+        MCA_OOB_TCP_HDR_NTOH(&frames[nframes]);
+        if (0 != frames[nframes].nslen || SEG_TEST_BULK < frames[nframes].nbytes) {
+            CHECK("a frame header makes sense", false);
+            break;
+        }
+        bodies[nframes] = (char *) malloc(frames[nframes].nbytes + 1);
+        if (0 != read_full(sv[1], bodies[nframes], frames[nframes].nbytes)) {
+            CHECK("a frame body was read whole", false);
+            break;
+        }
+        if (PRTE_RML_TAG_DAEMON_DIED == frames[nframes].tag) {
+            ctl_at = nframes;
+        } else if (off + frames[nframes].nbytes <= SEG_TEST_BULK) {
+            memcpy(got + off, bodies[nframes], frames[nframes].nbytes);
+            off += frames[nframes].nbytes;
+        }
+        if (MCA_OOB_TCP_SEG_LAST == frames[nframes].type) {
+            nframes++;
+            break;
+        }
+    }
+
+    CHECK("four slices and the control message", 5 == nframes);
+    CHECK("the control message came between two slices", 2 == ctl_at);
+    if (5 == nframes && 2 == ctl_at) {
+        CHECK("as a whole message",
+              MCA_OOB_TCP_USER == frames[2].type && SEG_TEST_CTL == frames[2].nbytes
+              && 2 == frames[2].seq_num);
+        CHECK("intact", 'A' == bodies[2][0] && 'A' + SEG_TEST_CTL - 1 == bodies[2][SEG_TEST_CTL - 1]);
+        CHECK("the slices before the last are SEG",
+              MCA_OOB_TCP_SEG == frames[0].type && MCA_OOB_TCP_SEG == frames[1].type
+              && MCA_OOB_TCP_SEG == frames[3].type);
+        CHECK("and the last is SEG_LAST", MCA_OOB_TCP_SEG_LAST == frames[4].type);
+        CHECK("each full slice is a segment long",
+              SEG_TEST_SEGMENT == frames[0].nbytes && SEG_TEST_SEGMENT == frames[1].nbytes
+              && SEG_TEST_SEGMENT == frames[3].nbytes);
+        CHECK("the last carries the rest", 928 == frames[4].nbytes);
+        CHECK("every slice names the whole message",
+              PRTE_RML_TAG_XCAST == frames[0].tag && 1 == frames[0].seq_num
+              && PRTE_RML_TAG_XCAST == frames[4].tag && 1 == frames[4].seq_num
+              && 1 == frames[3].dst);
+    }
+    CHECK("the slices put back together are the message",
+          SEG_TEST_BULK == off && 0 == memcmp(got, expect, SEG_TEST_BULK));
+
+    /* the receiving side puts the slices back together as they come */
+    rpeer = PMIX_NEW(prte_oob_tcp_peer_t);
+    PMIX_LOAD_PROCID(&rpeer->name, PRTE_PROC_MY_NAME->nspace, 1);
+    rpeer->sd = rv[0];
+    rpeer->state = MCA_OOB_TCP_CONNECTED;
+    if (5 == nframes && 2 == ctl_at) {
+        int slices[3] = {0, 1, 3};
+
+        for (n = 0; n < 3; n++) {
+            int k = slices[n];
+
+            CHECK("a slice was written",
+                  (ssize_t) PRTE_OOB_TCP_HDR_FIXED
+                  == write(rv[1], &wire[k], PRTE_OOB_TCP_HDR_FIXED)
+                  && (ssize_t) frames[k].nbytes == write(rv[1], bodies[k], frames[k].nbytes));
+            prte_oob_tcp_recv_handler(rv[0], 0, rpeer);
+            CHECK("the slice was taken whole", NULL == rpeer->recv_msg);
+        }
+        CHECK("the message is being put back together", NULL != rpeer->bulk_recv);
+        if (NULL != rpeer->bulk_recv) {
+            CHECK("under the message's own header",
+                  PRTE_RML_TAG_XCAST == rpeer->bulk_recv->hdr.tag
+                  && 1 == rpeer->bulk_recv->hdr.seq_num
+                  && MCA_OOB_TCP_USER == rpeer->bulk_recv->hdr.type);
+            CHECK("with every slice so far, in order",
+                  3 * SEG_TEST_SEGMENT == rpeer->bulk_recv->hdr.nbytes
+                  && 0 == memcmp(rpeer->bulk_recv->data, expect, 3 * SEG_TEST_SEGMENT));
+        }
+    }
+    PMIX_RELEASE(rpeer);
+    close(rv[1]);
+
+    for (n = 0; n < 8; n++) {
+        free(bodies[n]);
+    }
+    free(expect);
+    free(got);
+    PMIX_RELEASE(peer);
+    close(sv[1]);
+    prte_oob_base.segment_size = saved_segment;
+    prte_oob_base.control_tags[PRTE_RML_TAG_DAEMON_DIED] = saved_ctl;
+    prte_oob_base.control_tags[PRTE_RML_TAG_XCAST] = saved_bulk;
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_segments_interleave\n");
+    }
+    return failures;
+}
+
+/* Our own IDENT is written as the socket will take it, not in one shot.
+ *
+ * A socket that cannot take the whole of it used to be a failed connection.
+ * Now what does not fit waits in peer->hs for the write event, under the
+ * handshake's deadline, and an accepted connection is not CONNECTED - so no
+ * message can be written ahead of the rest of the IDENT - until it is all
+ * out.  The socket is filled first so that the ack cannot go at all; the
+ * send handler is then driven by hand in place of the write event, once
+ * while the socket is still full and once after it has been drained.  A
+ * write that stopped part way resumes from the byte it stopped at.
+ */
+static int test_handshake_send_resumes(void)
+{
+    int failures = 0;
+    int sv[2], timeout = prte_oob_base.handshake_timeout;
+    size_t junk = 0, ver = strlen(prte_version_string) + 1;
+    ssize_t n;
+    prte_event_base_t *base = prte_event_base;
+    prte_oob_tcp_peer_t *peer;
+    prte_oob_tcp_hdr_t hdr;
+    char fill[1024], *body;
+    uint16_t ack_flag;
+
+    PMIX_LOAD_NSPACE(PRTE_PROC_MY_NAME->nspace, "prterun-somenode-12345@0");
+    PRTE_PROC_MY_NAME->rank = 0;
+
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        fprintf(stdout, "SKIPPED test_handshake_send_resumes: no socketpair\n");
+        return 0;
+    }
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL, 0) | O_NONBLOCK);
+    memset(fill, 'x', sizeof(fill));
+    while (0 < (n = write(sv[0], fill, sizeof(fill)))) {
+        junk += n;
+    }
+    /* the handshake's events need a base to be added to, and this bare
+     * test process has never made one */
+    if (NULL == base) {
+        prte_event_base = prte_event_base_create();
+    }
+    prte_oob_base.handshake_timeout = 30;
+
+    peer = PMIX_NEW(prte_oob_tcp_peer_t);
+    PMIX_LOAD_PROCID(&peer->name, PRTE_PROC_MY_NAME->nspace, 3);
+    peer->evbase = prte_event_base;
+    peer->sd = sv[0];
+    peer->state = MCA_OOB_TCP_ACCEPTING;
+
+    CHECK("an accept whose ack cannot go yet is not refused", prte_oob_tcp_peer_accept(peer));
+    CHECK("it waits to send the ack", MCA_OOB_TCP_ACCEPTING == peer->state
+                                      && NULL != peer->hs.out && 0 == peer->hs.sent);
+    CHECK("on the write event", peer->send_ev_active);
+    CHECK("under the handshake's deadline", 0 != peer->hs.deadline && peer->timer_ev_active);
+
+    prte_oob_tcp_send_handler(sv[0], 0, peer);
+    CHECK("a socket that is still full is waited on",
+          MCA_OOB_TCP_ACCEPTING == peer->state && NULL != peer->hs.out && peer->send_ev_active);
+
+    /* make room, and let the write event fire */
+    while (0 < junk) {
+        n = read(sv[1], fill, junk < sizeof(fill) ? junk : sizeof(fill));
+        if (n <= 0) {
+            break;
+        }
+        junk -= n;
+    }
+    prte_oob_tcp_send_handler(sv[0], 0, peer);
+    CHECK("the rest of the ack went out", NULL == peer->hs.out);
+    CHECK("and the connection is up", MCA_OOB_TCP_CONNECTED == peer->state);
+    CHECK("with the handshake's deadline done with", !peer->timer_ev_active);
+
+    memset(&hdr, 0, sizeof(hdr));
+    CHECK("an IDENT header arrived", 0 == read_full(sv[1], &hdr, PRTE_OOB_TCP_HDR_FIXED));
+    MCA_OOB_TCP_HDR_NTOH(&hdr);
+    CHECK("it is our IDENT for the peer",
+          MCA_OOB_TCP_IDENT == hdr.type && 0 == hdr.origin && 3 == hdr.dst);
+    CHECK("carrying the ack flag and our version", sizeof(ack_flag) + ver == hdr.nbytes);
+    body = (char *) malloc(hdr.nslen + hdr.nbytes);
+    CHECK("the rest of it arrived", 0 == read_full(sv[1], body, hdr.nslen + hdr.nbytes));
+    memcpy(&ack_flag, body + hdr.nslen, sizeof(ack_flag));
+    CHECK("it is an ack", 1 == ntohs(ack_flag));
+    CHECK("with our version",
+          0 == strcmp(body + hdr.nslen + sizeof(ack_flag), prte_version_string));
+    free(body);
+    PMIX_RELEASE(peer);
+    close(sv[1]);
+
+    /* a write that stopped part way goes on from where it stopped */
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        fprintf(stdout, "SKIPPED test_handshake_send_resumes: no socketpair\n");
+        goto done;
+    }
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL, 0) | O_NONBLOCK);
+    peer = PMIX_NEW(prte_oob_tcp_peer_t);
+    PMIX_LOAD_PROCID(&peer->name, PRTE_PROC_MY_NAME->nspace, 3);
+    peer->sd = sv[0];
+    peer->state = MCA_OOB_TCP_CONNECT_ACK;
+    peer->hs.out = strdup("0123456789");
+    peer->hs.outlen = 10;
+    peer->hs.sent = 4;
+    prte_oob_tcp_peer_send_handshake(peer);
+    CHECK("the partial write finished", NULL == peer->hs.out);
+    CHECK("and the answer is still awaited", MCA_OOB_TCP_CONNECT_ACK == peer->state);
+    memset(fill, 0, sizeof(fill));
+    CHECK("only what had not gone was sent",
+          0 == read_full(sv[1], fill, 6) && 0 == memcmp(fill, "456789", 6));
+    PMIX_RELEASE(peer);
+    close(sv[1]);
+
+done:
+    prte_oob_base.handshake_timeout = timeout;
+    if (NULL == base) {
+        prte_event_base_free(prte_event_base);
+        prte_event_base = NULL;
+    }
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_handshake_send_resumes\n");
+    }
+    return failures;
+}
+
 /* Giving up on a peer must not take its queued messages with it.
  *
  * A send handed to the OOB is owed a callback: PRTE_RML_SEND_COMPLETE is how
@@ -697,6 +1238,316 @@ static int test_queued_sends_complete_on_close(void)
     return failures;
 }
 
+/*
+ * A peer on this host is reached through its unix-domain socket.
+ *
+ * Our contact info names the host as prte_oob_tcp_set_uds_host() has it, and
+ * a peer's "uds://<host>:<path>" entry is only taken up by a process that
+ * finds its own name there - anyone else would be handed a path in somebody
+ * else's session directory.  A malformed entry, a path too long for a
+ * sockaddr_un, or a process that cannot name its own host leaves the peer to
+ * its TCP addresses.
+ */
+static prte_oob_tcp_peer_t *uds_peer(pmix_rank_t rank, const char *entries)
+{
+    pmix_proc_t name;
+    prte_oob_tcp_peer_t *peer;
+    char *nm = NULL, *uri = NULL;
+
+    PMIX_LOAD_PROCID(&name, PRTE_PROC_MY_NAME->nspace, rank);
+    if (PRTE_SUCCESS != prte_util_convert_process_name_to_string(&nm, &name)) {
+        return NULL;
+    }
+    pmix_asprintf(&uri, "%s;%s", nm, entries);
+    free(nm);
+    peer = prte_oob_base_process_uri(uri);
+    free(uri);
+    return peer;
+}
+
+static void uds_peer_drop(prte_oob_tcp_peer_t *peer)
+{
+    if (NULL != peer) {
+        pmix_list_remove_item(&prte_oob_base.peers, &peer->super);
+        PMIX_RELEASE(peer);
+    }
+}
+
+static int test_uds_uri(void)
+{
+    int failures = 0;
+    prte_oob_tcp_peer_t *peer;
+    struct sockaddr_un *un;
+    char *host, *entry = NULL, longpath[sizeof(un->sun_path) + 8];
+    char self[PRTE_MAXHOSTNAMELEN];
+    const char *path = "/tmp/prte-somenode@0/oob.sock";
+
+    PMIX_LOAD_NSPACE(PRTE_PROC_MY_NAME->nspace, "prterun-somenode-12345@0");
+    PRTE_PROC_MY_NAME->rank = 0;
+
+    /* the name we give this host */
+    CHECK("this host can be named", PRTE_SUCCESS == prte_oob_tcp_set_uds_host());
+    if (NULL == prte_oob_base.uds_host) {
+        fprintf(stdout, "SKIPPED test_uds_uri: cannot name this host\n");
+        return failures;
+    }
+    host = prte_oob_base.uds_host;
+    memset(self, 0, sizeof(self));
+    if (0 == gethostname(self, sizeof(self) - 1)) {
+        CHECK("it starts with what the OS calls the host",
+              0 == strncmp(host, self, strlen(self))
+              && ('\0' == host[strlen(self)] || '@' == host[strlen(self)]));
+    }
+    CHECK("and fits the field it travels in",
+          NULL == strchr(host, ':') && NULL == strchr(host, ';'));
+    CHECK("it is named once", PRTE_SUCCESS == prte_oob_tcp_set_uds_host()
+          && host == prte_oob_base.uds_host);
+
+    /* a peer on this host, with a TCP address as well */
+    pmix_asprintf(&entry, "tcp://127.0.0.1:5555:8;uds://%s:%s", host, path);
+    peer = uds_peer(7, entry);
+    free(entry);
+    CHECK("the peer was recorded", NULL != peer);
+    if (NULL != peer) {
+        CHECK("with its TCP address", 1 == pmix_list_get_size(&peer->addrs));
+        CHECK("and its unix-domain socket", NULL != peer->uds_addr);
+        if (NULL != peer->uds_addr) {
+            un = (struct sockaddr_un *) &peer->uds_addr->addr;
+            CHECK("as a unix-domain address", AF_UNIX == un->sun_family);
+            CHECK("at the path it gave", 0 == strcmp(path, un->sun_path));
+            CHECK("kept apart from the TCP ones",
+                  AF_INET == ((prte_oob_tcp_addr_t *) pmix_list_get_first(&peer->addrs))
+                                 ->addr.ss_family);
+        }
+    }
+    uds_peer_drop(peer);
+
+    /* the same path on another host is no use to us */
+    pmix_asprintf(&entry, "uds://%s-elsewhere:%s", host, path);
+    peer = uds_peer(8, entry);
+    free(entry);
+    CHECK("a peer on another host is recorded", NULL != peer);
+    CHECK("without its socket", NULL != peer && NULL == peer->uds_addr);
+    uds_peer_drop(peer);
+
+    /* a host name that only starts like ours is another host */
+    pmix_asprintf(&entry, "uds://%.*s:%s", (int) strlen(host) - 1, host, path);
+    peer = uds_peer(8, entry);
+    free(entry);
+    CHECK("a prefix of our name does not match", NULL != peer && NULL == peer->uds_addr);
+    uds_peer_drop(peer);
+
+    fprintf(stdout, "-- the next checks feed malformed contact info;"
+                    " the errors they print are expected --\n");
+    peer = uds_peer(9, "uds://no-path-here");
+    CHECK("an entry without a path is dropped", NULL != peer && NULL == peer->uds_addr);
+    uds_peer_drop(peer);
+
+    memset(longpath, 'x', sizeof(longpath) - 1);
+    longpath[0] = '/';
+    longpath[sizeof(longpath) - 1] = '\0';
+    pmix_asprintf(&entry, "uds://%s:%s", host, longpath);
+    peer = uds_peer(9, entry);
+    free(entry);
+    CHECK("a path too long for a sockaddr_un is dropped", NULL != peer && NULL == peer->uds_addr);
+    uds_peer_drop(peer);
+
+    /* not knowing our own host, we cannot tell who shares it */
+    prte_oob_base.uds_host = NULL;
+    pmix_asprintf(&entry, "uds://%s:%s", host, path);
+    peer = uds_peer(10, entry);
+    free(entry);
+    CHECK("an unnamed host takes no one's socket", NULL != peer && NULL == peer->uds_addr);
+    uds_peer_drop(peer);
+    prte_oob_base.uds_host = host;
+
+    /* our own contact info tells us nothing */
+    pmix_asprintf(&entry, "uds://%s:%s", host, path);
+    peer = uds_peer(PRTE_PROC_MY_NAME->rank, entry);
+    free(entry);
+    CHECK("our own uri is ignored", NULL == peer);
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_uds_uri\n");
+    }
+    return failures;
+}
+
+/*
+ * Connecting over the unix-domain socket either works at once or leaves the
+ * peer to TCP.  With nothing listening at the path, the connect fails, the
+ * socket is marked failed - which is what sends try_connect on to the TCP
+ * addresses, and keeps it off the socket until the next round of retries -
+ * and the peer is left with no socket and no active address.  Once something
+ * listens there, the next round connects through it.
+ */
+static int test_uds_connect_fallback(void)
+{
+    int failures = 0;
+    char dir[] = "/tmp/prte-uds-XXXXXX";
+    char *path = NULL;
+    struct sockaddr_un *un, addr;
+    prte_oob_tcp_peer_t *peer;
+    int lsd, asd;
+
+    if (NULL == mkdtemp(dir)) {
+        fprintf(stdout, "SKIPPED test_uds_connect_fallback: no temporary directory\n");
+        return 0;
+    }
+    pmix_asprintf(&path, "%s/oob.sock", dir);
+
+    peer = PMIX_NEW(prte_oob_tcp_peer_t);
+    PMIX_LOAD_PROCID(&peer->name, PRTE_PROC_MY_NAME->nspace, 12);
+    peer->sd = -1;
+    peer->uds_addr = PMIX_NEW(prte_oob_tcp_addr_t);
+    un = (struct sockaddr_un *) &peer->uds_addr->addr;
+    memset(un, 0, sizeof(peer->uds_addr->addr));
+    un->sun_family = AF_UNIX;
+    memcpy(un->sun_path, path, strlen(path));
+
+    /* nobody there */
+    CHECK("a socket nobody listens on is not connected",
+          !prte_oob_tcp_peer_connect_uds(peer));
+    CHECK("it is marked failed, so TCP is tried next",
+          MCA_OOB_TCP_FAILED == peer->uds_addr->state);
+    CHECK("and the attempt counted", 1 == peer->uds_addr->retries);
+    CHECK("no socket is left behind", 0 > peer->sd);
+    CHECK("no address is taken up", NULL == peer->active_addr);
+
+    /* somebody there - as the retry path does, clear the mark first */
+    lsd = socket(AF_UNIX, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path, strlen(path));
+    if (0 > lsd || 0 != bind(lsd, (struct sockaddr *) &addr, sizeof(addr))
+        || 0 != listen(lsd, 4)) {
+        fprintf(stdout, "SKIPPED test_uds_connect_fallback: cannot listen on %s\n", path);
+    } else {
+        peer->uds_addr->state = MCA_OOB_TCP_UNCONNECTED;
+        CHECK("a listening socket is connected", prte_oob_tcp_peer_connect_uds(peer));
+        CHECK("through the peer's socket", 0 <= peer->sd);
+        CHECK("which is now the active address", peer->active_addr == peer->uds_addr);
+        CHECK("with the attempts forgotten", 0 == peer->uds_addr->retries);
+        asd = accept(lsd, NULL, NULL);
+        CHECK("and the listener sees it", 0 <= asd);
+        if (0 <= asd) {
+            close(asd);
+        }
+    }
+    if (0 <= lsd) {
+        close(lsd);
+    }
+
+    PMIX_RELEASE(peer);
+    unlink(path);
+    rmdir(dir);
+    free(path);
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_uds_connect_fallback\n");
+    }
+    return failures;
+}
+
+/*
+ * A traffic report has to survive the trip from one daemon to the one adding
+ * them up: every count it started with, in the same column, and the dynamic
+ * tags folded into the one slot they share.  Counts are compared against a
+ * snapshot taken first, since nothing resets the counters between tests.
+ */
+static int test_traffic_report(void)
+{
+    int failures = 0;
+    prte_rml_traffic_report_t *before, *after, *merged;
+    prte_oob_tcp_peer_t *peer;
+    pmix_data_buffer_t buf;
+    pmix_data_array_t darray;
+    pmix_info_t *info;
+    uint64_t *row = NULL;
+    size_t n;
+    int rc;
+
+    peer = PMIX_NEW(prte_oob_tcp_peer_t);
+    PMIX_LOAD_PROCID(&peer->name, PRTE_PROC_MY_NAME->nspace, 4242);
+    peer->sd = -1;
+    peer->queue_hwm = 5;
+    pmix_list_append(&prte_oob_base.peers, &peer->super);
+
+    before = PMIX_NEW(prte_rml_traffic_report_t);
+    rc = prte_rml_traffic_snapshot(before);
+    CHECK("first snapshot taken", PRTE_SUCCESS == rc);
+
+    prte_rml_stats_record(PRTE_RML_TAG_DAEMON, PRTE_RML_STAT_SENT, 10);
+    prte_rml_stats_record(PRTE_RML_TAG_DAEMON, PRTE_RML_STAT_SENT, 20);
+    prte_rml_stats_record(PRTE_RML_TAG_DAEMON, PRTE_RML_STAT_RECVD, 7);
+    prte_rml_stats_record(PRTE_RML_TAG_MAX + 9, PRTE_RML_STAT_RELAYED, 3);
+    prte_rml_stats_count(&peer->traffic, PRTE_RML_STAT_SENT, 100);
+
+    after = PMIX_NEW(prte_rml_traffic_report_t);
+    rc = prte_rml_traffic_snapshot(after);
+    CHECK("second snapshot taken", PRTE_SUCCESS == rc);
+    CHECK("sent messages counted against the tag",
+          2 == after->tags[PRTE_RML_TAG_DAEMON][0] - before->tags[PRTE_RML_TAG_DAEMON][0]);
+    CHECK("and their bytes",
+          30 == after->tags[PRTE_RML_TAG_DAEMON][1] - before->tags[PRTE_RML_TAG_DAEMON][1]);
+    CHECK("received kept apart from sent",
+          7 == after->tags[PRTE_RML_TAG_DAEMON][3] - before->tags[PRTE_RML_TAG_DAEMON][3]);
+    CHECK("a dynamic tag lands in the shared slot",
+          1 == after->tags[PRTE_RML_TAG_MAX][4] - before->tags[PRTE_RML_TAG_MAX][4]);
+
+    for (n = 0; n < after->npeers; n++) {
+        if (4242 == after->peers[n * PRTE_RML_TRAFFIC_PEER_COLS + 1]) {
+            row = &after->peers[n * PRTE_RML_TRAFFIC_PEER_COLS];
+        }
+    }
+    CHECK("the peer has a row", NULL != row);
+    if (NULL != row) {
+        CHECK("reported by us", PRTE_PROC_MY_NAME->rank == row[0]);
+        CHECK("with its sent count", 1 == row[2] && 100 == row[3]);
+        CHECK("and its queue high-water mark", 5 == row[8]);
+    }
+
+    /* pack it as a remote daemon would and add it to a copy of ourselves */
+    merged = PMIX_NEW(prte_rml_traffic_report_t);
+    rc = prte_rml_traffic_snapshot(merged);
+    CHECK("third snapshot taken", PRTE_SUCCESS == rc);
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = prte_rml_traffic_pack(&buf, after);
+    CHECK("report packed", PRTE_SUCCESS == rc);
+    rc = prte_rml_traffic_unpack(&buf, merged);
+    CHECK("report unpacked", PRTE_SUCCESS == rc);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    CHECK("tag counts add up across reports",
+          2 * after->tags[PRTE_RML_TAG_DAEMON][0] == merged->tags[PRTE_RML_TAG_DAEMON][0]);
+    CHECK("the shared dynamic slot survives the trip",
+          2 * after->tags[PRTE_RML_TAG_MAX][5] == merged->tags[PRTE_RML_TAG_MAX][5]);
+    CHECK("peer rows from both reports are kept", 2 * after->npeers == merged->npeers);
+
+    rc = prte_rml_traffic_load(merged, &darray);
+    CHECK("report loaded", PRTE_SUCCESS == rc);
+    CHECK("as a list of tables", PMIX_INFO == darray.type && 2 <= darray.size);
+    if (PMIX_INFO == darray.type && 0 < darray.size) {
+        info = (pmix_info_t *) darray.array;
+        CHECK("tags first", PMIX_CHECK_KEY(&info[0], PRTE_RML_TRAFFIC_TAGS));
+        CHECK("as rows of uint64",
+              PMIX_DATA_ARRAY == info[0].value.type
+              && PMIX_UINT64 == info[0].value.data.darray->type
+              && 0 == info[0].value.data.darray->size % PRTE_RML_TRAFFIC_TAG_COLS);
+    }
+    PMIX_DATA_ARRAY_DESTRUCT(&darray);
+
+    PMIX_RELEASE(before);
+    PMIX_RELEASE(after);
+    PMIX_RELEASE(merged);
+    pmix_list_remove_item(&prte_oob_base.peers, &peer->super);
+    PMIX_RELEASE(peer);
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_traffic_report\n");
+    }
+    return failures;
+}
+
 int main(void)
 {
     int rc, failures = 0;
@@ -719,6 +1570,12 @@ int main(void)
     failures += test_peer_base_assignment();
     failures += test_queued_sends_complete_on_close();
     failures += test_wire_header();
+    failures += test_handshake_resumes();
+    failures += test_segments_interleave();
+    failures += test_handshake_send_resumes();
+    failures += test_uds_uri();
+    failures += test_uds_connect_fallback();
+    failures += test_traffic_report();
 
     prte_finalize();
 
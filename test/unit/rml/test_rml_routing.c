@@ -1034,6 +1034,58 @@ static int test_num_contributors(void)
     return failures;
 }
 
+/*
+ * is_subtree_root says whether this daemon is where a collective over a set
+ * of daemons can complete: the lowest point in the tree that every one of
+ * them reaches.  Ask it of the wrong daemon and a fence either completes
+ * twice or never.
+ */
+static int test_subtree_root(void)
+{
+    int failures = 0;
+    pmix_rank_t set[3];
+
+    /* radix 2, 7 daemons, we are rank 1: children 3 and 5 */
+    bitmaps_reset();
+    build_dvm(2, 7, 1);
+
+    set[0] = 3;
+    set[1] = 5;
+    CHECK("two children's subtrees meet here", prte_rml_is_subtree_root(set, 2));
+    CHECK("one child's subtree is that child's", !prte_rml_is_subtree_root(set, 1));
+    set[1] = 1;
+    CHECK("a participant that is us makes us the root", prte_rml_is_subtree_root(set, 2));
+    CHECK("and so does being the only one", prte_rml_is_subtree_root(&set[1], 1));
+    set[1] = 5;
+    set[2] = 4;
+    CHECK("a participant outside our subtree is not ours",
+          !prte_rml_is_subtree_root(set, 3));
+    set[2] = 0;
+    CHECK("nor is our parent", !prte_rml_is_subtree_root(&set[2], 1));
+
+    /* a failed participant does not hold the meeting point up */
+    set[2] = 4;
+    pmix_bitmap_set_bit(&prte_rml_base.failed_dmns, 4);
+    CHECK("a failed outsider drops out", prte_rml_is_subtree_root(set, 3));
+    pmix_bitmap_set_bit(&prte_rml_base.failed_dmns, 5);
+    CHECK("leaving one child's subtree", !prte_rml_is_subtree_root(set, 3));
+    CHECK("nobody living is nobody's", !prte_rml_is_subtree_root(&set[1], 2));
+
+    /* the same set seen from the root of the DVM: it all sits under child 1 */
+    bitmaps_reset();
+    build_dvm(2, 7, 0);
+    set[0] = 3;
+    set[1] = 5;
+    CHECK("the DVM root is not the meeting point of one branch",
+          !prte_rml_is_subtree_root(set, 2));
+
+    bitmaps_reset();
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_subtree_root\n");
+    }
+    return failures;
+}
+
 /*
  * The incarnation guard.  A bootstrap daemon that reboots into the same rank
  * comes back with a strictly greater boot epoch, so traffic stamped with an
@@ -1256,6 +1308,7 @@ int main(void)
     failures += test_reconcile_ancestry();
     failures += test_dead_dmns_round_trip();
     failures += test_num_contributors();
+    failures += test_subtree_root();
     failures += test_lateral_links();
     failures += test_epoch_guard();
     failures += test_purge();
@@ -59,7 +59,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <sys/wait.h>
+#if HAVE_DECL_SYS_PIDFD_OPEN
+#    include <sys/syscall.h>
+#endif
 
 #include "constants.h"
 #include "types.h"
@@ -72,7 +77,9 @@
 #include "src/rml/oob/oob.h"
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
+#include "src/runtime/prte_launch_template.h"
 #include "src/runtime/prte_progress_threads.h"
+#include "src/runtime/prte_wait.h"
 #include "src/runtime/prte_worker_pool.h"
 #include "src/runtime/runtime.h"
 #include "src/util/attr.h"
@@ -695,6 +702,10 @@ static int test_pack_roundtrip(void)
     prte_proc_t *proc;
     prte_job_map_t *saved_map;
     prte_job_pack_mode_t mode = PRTE_JOB_PACK_NO_CPUSETS;
+    prte_launch_template_t *tmpl = NULL, *again = NULL;
+    pmix_byte_object_t bo;
+    bool fresh = false;
+    uint32_t id;
     char *sval = NULL;
     int rc;
 
@@ -878,7 +889,7 @@ static int test_pack_roundtrip(void)
     /* The launch path's shape: the same job with the cpusets left out for
      * the scatter.  Everything else has to arrive exactly as before, and
      * the mode has to say so - a decoder that guessed wrong here would
-     * read the next proc's node rank as this one's cpuset. */
+     * read the first proc's device count as the cpuset array. */
     PMIX_RETAIN(saved_map);
     src->map = saved_map;
     dst = NULL;
@@ -901,6 +912,86 @@ static int test_pack_roundtrip(void)
         }
     }
     PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    /* A repeat launch: the apps are left out in favour of the launch
+     * template the receiver already holds.  The same apps to the same DVM
+     * get the same template back, and need not be sent; a different DVM or
+     * different apps get a new one that has to be. */
+    rc = prte_launch_template_select(src, 0, 4, &tmpl, &fresh);
+    CHECK("template: the first launch issues one",
+          PRTE_SUCCESS == rc && NULL != tmpl && 0 != tmpl->id && fresh);
+    id = (NULL == tmpl) ? 0 : tmpl->id;
+    rc = prte_launch_template_select(src, 0, 4, &again, &fresh);
+    CHECK("template: a repeat launch reuses it",
+          PRTE_SUCCESS == rc && NULL != again && id == again->id && !fresh);
+    rc = prte_launch_template_select(src, 0, 5, &again, &fresh);
+    CHECK("template: a changed DVM is sent a new one",
+          PRTE_SUCCESS == rc && NULL != again && id != again->id && fresh);
+    id = (NULL == again) ? 0 : again->id;
+    PMIx_Argv_append_nosize(&app->env, "HOME=/home/user");
+    rc = prte_launch_template_select(src, 0, 5, &again, &fresh);
+    CHECK("template: different apps are sent a new one",
+          PRTE_SUCCESS == rc && NULL != again && id != again->id && fresh);
+    CHECK("template: ...which replaces the session's last",
+          NULL == prte_launch_template_lookup(id));
+    id = (NULL == again) ? 0 : again->id;
+
+    prte_set_attribute(&src->attributes, PRTE_JOB_LAUNCH_TEMPLATE, PRTE_ATTR_LOCAL,
+                       &id, PMIX_UINT32);
+    dst = NULL;
+    mode = PRTE_JOB_PACK_ALL;
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    if (PRTE_SUCCESS == prte_job_pack(&buf, src,
+                                      PRTE_JOB_PACK_NO_CPUSETS | PRTE_JOB_PACK_NO_APPS)) {
+        rc = prte_job_unpack(&buf, &dst, &mode);
+        CHECK("template: a job against a template round-trips",
+              PRTE_SUCCESS == rc && NULL != dst);
+        CHECK("template: ...and says so",
+              (PRTE_JOB_PACK_NO_CPUSETS | PRTE_JOB_PACK_NO_APPS) == mode);
+        if (NULL != dst) {
+            app2 = (prte_app_context_t *) pmix_pointer_array_get_item(dst->apps, 0);
+            CHECK("template: the apps come from the template",
+                  1 == dst->num_apps && NULL != app2 && NULL != app2->app
+                      && 0 == strcmp("/bin/hostname", app2->app)
+                      && 2 == PMIx_Argv_count(app2->env));
+            proc = (prte_proc_t *) pmix_pointer_array_get_item(dst->procs, 1);
+            CHECK("template: ...and the layout is rebuilt against them",
+                  NULL != proc && 0 == proc->app_idx && 1 == proc->app_rank
+                      && PRTE_JOB_STATE_RUNNING == dst->state);
+            PMIX_RELEASE(dst);
+        }
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    /* a receiver that does not hold the template cannot read the job */
+    prte_launch_template_finalize();
+    dst = NULL;
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    if (PRTE_SUCCESS == prte_job_pack(&buf, src, PRTE_JOB_PACK_NO_APPS)) {
+        rc = prte_job_unpack(&buf, &dst, NULL);
+        CHECK("template: an unknown template is refused",
+              PRTE_ERR_NOT_FOUND == rc && NULL == dst);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    /* the daemon's side: one template per session, the last it was sent */
+    if (PRTE_SUCCESS == prte_launch_template_pack_apps(src, &bo)) {
+        prte_launch_template_store(7, 99, &bo);
+        CHECK("template: a stored template is found", NULL != prte_launch_template_lookup(99));
+        CHECK("template: store takes the bytes", NULL == bo.bytes && 0 == bo.size);
+        prte_launch_template_pack_apps(src, &bo);
+        prte_launch_template_store(7, 100, &bo);
+        CHECK("template: a later one for the session replaces it",
+              NULL == prte_launch_template_lookup(99)
+                  && NULL != prte_launch_template_lookup(100));
+        prte_launch_template_pack_apps(src, &bo);
+        prte_launch_template_store(8, 101, &bo);
+        CHECK("template: another session's is kept alongside",
+              NULL != prte_launch_template_lookup(100)
+                  && NULL != prte_launch_template_lookup(101));
+    }
+    CHECK("template: id zero is never a template", NULL == prte_launch_template_lookup(0));
+    prte_launch_template_finalize();
     PMIX_RELEASE(saved_map);
 
     PMIX_RELEASE(src);
@@ -908,6 +999,126 @@ static int test_pack_roundtrip(void)
     return failures;
 }
 
+/* The per-proc fields go as columns and the proc maps as runs of ranks, so
+ * exercise a layout that is neither one run nor one value per column: a
+ * by-node app striding across three nodes, a second app packed onto one of
+ * them, node ranks pushed up by another job, and the odd proc that differs
+ * from its neighbours. */
+static int test_pack_columns(void)
+{
+    int failures = 0;
+    pmix_data_buffer_t buf;
+    prte_node_t *nodes[3];
+    prte_proc_t *dmn, *proc;
+    prte_job_t *src, *dst = NULL;
+    prte_app_context_t *app;
+    pmix_rank_t r;
+    char name[32];
+    int n, a, rc;
+    bool ok;
+
+    reset_globals();
+
+    src = make_job("cols.job");
+    src->num_procs = 11;
+    for (a = 0; a < 2; a++) {
+        app = PMIX_NEW(prte_app_context_t);
+        app->idx = a;
+        app->app = strdup("/bin/true");
+        app->num_procs = (0 == a) ? 9 : 2;
+        app->first_rank = (0 == a) ? 0 : 9;
+        pmix_pointer_array_set_item(src->apps, a, app);
+    }
+    src->num_apps = 2;
+
+    src->map = PMIX_NEW(prte_job_map_t);
+    for (n = 0; n < 3; n++) {
+        snprintf(name, sizeof(name), "cols.node%d", n);
+        nodes[n] = make_node(name);
+        nodes[n]->index = pmix_pointer_array_add(prte_node_pool, nodes[n]);
+        dmn = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&dmn->name, "cols.dvm", n + 1);
+        nodes[n]->daemon = dmn;
+        PMIX_RETAIN(nodes[n]);
+        pmix_pointer_array_add(src->map->nodes, nodes[n]);
+    }
+    src->map->num_nodes = 3;
+
+    /* app 0 round-robin by node, then app 1 on the last node */
+    for (r = 0; r < 11; r++) {
+        n = (r < 9) ? (int) (r % 3) : 2;
+        proc = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_PROCID(&proc->name, "cols.job", r);
+        proc->app_idx = (r < 9) ? 0 : 1;
+        proc->state = (5 == r) ? PRTE_PROC_STATE_RUNNING : PRTE_PROC_STATE_INIT;
+        if (0 == r % 4) {
+            snprintf(name, sizeof(name), "%u", (unsigned) r);
+            proc->cpuset = strdup(name);
+        }
+        pmix_pointer_array_set_item(src->procs, r, proc);
+        PMIX_RETAIN(proc);
+        pmix_pointer_array_add(nodes[n]->procs, proc);
+    }
+    /* node ranks sit two above the local ranks the far end will derive,
+     * all but one */
+    for (r = 0; r < 11; r++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(src->procs, r);
+        proc->node_rank = (r < 9) ? (prte_node_rank_t) (r / 3 + 2) : (prte_node_rank_t) (r - 4);
+    }
+    proc = (prte_proc_t *) pmix_pointer_array_get_item(src->procs, 4);
+    proc->node_rank = 40;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = prte_job_pack(&buf, src, PRTE_JOB_PACK_ALL);
+    CHECK("columns: job packs", PRTE_SUCCESS == rc);
+    if (PRTE_SUCCESS == rc) {
+        rc = prte_job_unpack(&buf, &dst, NULL);
+        CHECK("columns: job unpacks", PRTE_SUCCESS == rc && NULL != dst);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    if (NULL != dst) {
+        ok = true;
+        for (r = 0; r < 11; r++) {
+            proc = (prte_proc_t *) pmix_pointer_array_get_item(dst->procs, r);
+            if (NULL == proc || proc->name.rank != r) {
+                ok = false;
+                break;
+            }
+            n = (r < 9) ? (int) (r % 3) : 2;
+            if (proc->parent != (pmix_rank_t) (n + 1)
+                || proc->app_idx != ((r < 9) ? 0 : 1)
+                || proc->app_rank != ((r < 9) ? r : r - 9)
+                || proc->local_rank != ((r < 9) ? r / 3 : r - 6)
+                || proc->node_rank != ((4 == r) ? 40 : proc->local_rank + 2)
+                || proc->state != ((5 == r) ? PRTE_PROC_STATE_RUNNING : PRTE_PROC_STATE_INIT)) {
+                ok = false;
+                break;
+            }
+            if ((0 == r % 4) != (NULL != proc->cpuset)) {
+                ok = false;
+                break;
+            }
+        }
+        CHECK("columns: every proc is rebuilt as it was packed", ok);
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(dst->procs, 8);
+        CHECK("columns: cpusets land on their own proc",
+              NULL != proc && NULL != proc->cpuset && 0 == strcmp("8", proc->cpuset));
+        PMIX_RELEASE(dst);
+    }
+
+    /* a proc the maps never placed cannot be packed for the far end */
+    src->num_procs = 12;
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    rc = prte_job_pack(&buf, src, PRTE_JOB_PACK_ALL);
+    CHECK("columns: a job short of procs is refused", PRTE_SUCCESS != rc);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    PMIX_RELEASE(src);
+    reset_globals();
+    return failures;
+}
+
 static int test_node_pack_roundtrip(void)
 {
     int failures = 0;
@@ -1702,6 +1913,154 @@ static int test_worker_pool(void)
     return failures;
 }
 
+/* ------------------------------------------------------------------ */
+/* child reaping                                                      */
+/* ------------------------------------------------------------------ */
+
+/* prte_wait keeps its registrations in two hashes - by proc and by pid -
+ * and a proc is registered before it is forked, so its pid is only indexed
+ * once it is needed.  What has to hold:
+ *
+ *  - a batch of children registered before their pids were known, and
+ *    reaped by the SIGCHLD pass (the fallback: nobody gave them a pidfd),
+ *    each come back to their own registration with their own status;
+ *  - a child nobody registered is reaped without disturbing the rest, and
+ *    a registration whose fork never happened does not hold anything up;
+ *  - the rusage of a child that exited is recorded on it;
+ *  - where pidfds exist, a watched child is reaped through its own pidfd
+ *    with the SIGCHLD handler switched off.
+ */
+static int nreaped;
+
+static void reaped(int fd, short args, void *cbdata)
+{
+    prte_wait_tracker_t *t2 = (prte_wait_tracker_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PRTE_FLAG_UNSET(t2->child, PRTE_PROC_FLAG_ALIVE);
+    ++nreaped;
+    PMIX_RELEASE(t2);
+}
+
+/* run the event base until "want" children have been reaped, or ten
+ * seconds have gone */
+static void reap_until(int want)
+{
+    time_t end = time(NULL) + 10;
+
+    while (nreaped < want && time(NULL) < end) {
+        prte_event_loop(prte_event_base, PRTE_EVLOOP_NONBLOCK);
+        usleep(1000);
+    }
+}
+
+/* a child that exits with "code" - once "hold" reads EOF, if given */
+static pid_t spawn(int code, int hold)
+{
+    pid_t pid;
+    char c;
+
+    pid = fork();
+    if (0 == pid) {
+        if (0 <= hold) {
+            while (0 < read(hold, &c, 1)) {
+                continue;
+            }
+        }
+        _exit(code);
+    }
+    return pid;
+}
+
+#define NKIDS 16
+
+static int test_wait_reaping(void)
+{
+    int failures = 0, i, status;
+    prte_proc_t *procs[NKIDS], *unforked;
+    struct timeval cpu, *cpuptr = &cpu;
+    uint64_t rss, *rssptr = &rss;
+    pid_t stray;
+
+    CHECK("wait: init", PRTE_SUCCESS == prte_wait_init());
+    nreaped = 0;
+
+    /* registered first, as the launch path does, so no pid is indexed yet */
+    for (i = 0; i < NKIDS; i++) {
+        procs[i] = PMIX_NEW(prte_proc_t);
+        PRTE_FLAG_SET(procs[i], PRTE_PROC_FLAG_ALIVE);
+        prte_wait_cb(procs[i], reaped, NULL);
+    }
+    unforked = PMIX_NEW(prte_proc_t);
+    PRTE_FLAG_SET(unforked, PRTE_PROC_FLAG_ALIVE);
+    prte_wait_cb(unforked, reaped, NULL);
+
+    stray = spawn(99, -1);
+    for (i = 0; i < NKIDS; i++) {
+        procs[i]->pid = spawn(i, -1);
+        CHECK("wait: fork", 0 < procs[i]->pid);
+    }
+    reap_until(NKIDS);
+    CHECK("wait: every registered child was reaped", NKIDS == nreaped);
+    for (i = 0; i < NKIDS; i++) {
+        status = procs[i]->exit_code;
+        CHECK("wait: each child got its own status",
+              WIFEXITED(status) && i == WEXITSTATUS(status));
+        CHECK("wait: cpu time recorded",
+              prte_get_attribute(&procs[i]->attributes, PRTE_PROC_CPU_TIME,
+                                 (void **) &cpuptr, PMIX_TIMEVAL));
+        CHECK("wait: max rss recorded",
+              prte_get_attribute(&procs[i]->attributes, PRTE_PROC_MAX_RSS,
+                                 (void **) &rssptr, PMIX_UINT64));
+        CHECK("wait: a child reaped once", !PRTE_FLAG_TEST(procs[i], PRTE_PROC_FLAG_ALIVE));
+    }
+    /* the stray most likely went to the SIGCHLD pass too */
+    (void) waitpid(stray, &status, 0);
+    CHECK("wait: the unforked registration is still pending",
+          PRTE_FLAG_TEST(unforked, PRTE_PROC_FLAG_ALIVE));
+
+#if HAVE_DECL_SYS_PIDFD_OPEN
+    {
+        int fd, hold[2];
+        prte_proc_t *watched;
+
+        /* pidfds can be missing at run time (old kernel, seccomp) even
+         * where the headers declare them */
+        fd = (int) syscall(SYS_pidfd_open, getpid(), 0);
+        if (0 <= fd && 0 == pipe(hold)) {
+            close(fd);
+            watched = PMIX_NEW(prte_proc_t);
+            PRTE_FLAG_SET(watched, PRTE_PROC_FLAG_ALIVE);
+            prte_wait_cb(watched, reaped, NULL);
+            watched->pid = spawn(7, hold[0]);
+            close(hold[0]);
+            prte_wait_watch(watched);
+            /* let the watch land before the child can go */
+            prte_event_loop(prte_event_base, PRTE_EVLOOP_NONBLOCK);
+            prte_wait_disable();
+            close(hold[1]);
+            reap_until(NKIDS + 1);
+            CHECK("wait: a watched child is reaped through its pidfd", NKIDS + 1 == nreaped);
+            CHECK("wait: the pidfd path reports the status",
+                  WIFEXITED(watched->exit_code) && 7 == WEXITSTATUS(watched->exit_code));
+            prte_wait_enable();
+            PMIX_RELEASE(watched);
+        } else if (0 <= fd) {
+            close(fd);
+        }
+    }
+#endif
+
+    prte_wait_cb_cancel(unforked);
+    prte_event_loop(prte_event_base, PRTE_EVLOOP_NONBLOCK);
+    PMIX_RELEASE(unforked);
+    for (i = 0; i < NKIDS; i++) {
+        PMIX_RELEASE(procs[i]);
+    }
+    prte_wait_finalize();
+    return failures;
+}
+
 /* ------------------------------------------------------------------ */
 
 int main(void)
@@ -1754,6 +2113,7 @@ int main(void)
     failures += test_app_copy();
     failures += test_map_copy();
     failures += test_pack_roundtrip();
+    failures += test_pack_columns();
     failures += test_node_pack_roundtrip();
     failures += test_object_lifetimes();
     failures += test_session_teardown();
@@ -1766,6 +2126,7 @@ int main(void)
     failures += test_progress_thread_cpus();
     failures += test_progress_thread_lifecycle();
     failures += test_worker_pool();
+    failures += test_wait_reaping();
     failures += test_paramfile_ordering();
 
     if (paramfile_written) {
@@ -21,6 +21,8 @@
  *  - the state->callback tables (add/set/remove and their return protocol);
  *  - the dispatcher, including the ERROR/ANY fallback rules that decide
  *    which handler an unregistered state lands on;
+ *  - the dispatch fast path under all of it - the state table, the caddy
+ *    cache and batching - which must be invisible to the handlers;
  *  - the caddy handed to every handler, which must arrive fully
  *    initialized.  PMIX_NEW does not zero its allocation, and
  *    activate_job_state used to fill in caddy->job_state only when a job
@@ -40,14 +42,17 @@
  */
 
 #include "prte_config.h"
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "constants.h"
 #include "src/event/event-internal.h"
 #include "src/mca/base/pmix_base.h"
+#include "src/mca/rmaps/rmaps_types.h"
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/runtime.h"
+#include "src/util/attr.h"
 #include "src/util/proc_info.h"
 
 #include "src/mca/state/base/base.h"
@@ -118,12 +123,14 @@ static void fresh_machines(void)
 {
     PMIX_CONSTRUCT(&prte_job_states, pmix_list_t);
     PMIX_CONSTRUCT(&prte_proc_states, pmix_list_t);
+    prte_state_base_states_changed();
 }
 
 static void drop_machines(void)
 {
     PMIX_LIST_DESTRUCT(&prte_job_states);
     PMIX_LIST_DESTRUCT(&prte_proc_states);
+    prte_state_base_states_changed();
 }
 
 /*
@@ -354,6 +361,187 @@ static int test_caddy_contract(void)
     return failures;
 }
 
+/*
+ * The dispatch fast path: the state table, the caddy cache and batching
+ * sit under every activation, and none of them may change what a handler
+ * sees.  The table is a cache of the list walk, so a change to the lists
+ * has to show through it; a caddy goes back to the cache only when the
+ * handler let go of it; and a batch runs its activations in the order they
+ * were made, with anything a handler activates running on a later pass.
+ */
+static prte_state_caddy_t *last_caddy = NULL;
+static prte_state_caddy_t *kept_caddy = NULL;
+static int order[8];
+static int norder = 0;
+
+static void pointer_recorder(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+    last_caddy = caddy;
+    ++seen_calls;
+    PMIX_RELEASE(caddy);
+}
+
+static void keeper(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    /* holds on to it past its own return, as a handler that re-queues its
+     * caddy does */
+    PMIX_ACQUIRE_OBJECT(caddy);
+    kept_caddy = caddy;
+}
+
+static void order_recorder(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+    if (norder < 8) {
+        order[norder++] = (int) caddy->proc_state;
+    }
+    /* the first one reached activates another, which must not run inside
+     * this pass */
+    if (PRTE_PROC_STATE_INIT == caddy->proc_state) {
+        prte_state_base_activate_proc_state(&caddy->name, PRTE_PROC_STATE_TERMINATED);
+    }
+    PMIX_RELEASE(caddy);
+}
+
+static int test_dispatch_fast_path(void)
+{
+    int failures = 0;
+    prte_state_caddy_t *first;
+    prte_job_t *jdata;
+    pmix_proc_t p;
+    bool batch = prte_state_base.batch;
+
+    fresh_machines();
+    PMIX_LOAD_PROCID(&p, "unit-test-nspace", 3);
+
+    /* the table follows the lists */
+    reset_observations();
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    CHECK("fast: unregistered state dropped", 0 == seen_calls);
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_RUNNING, pointer_recorder);
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    CHECK("fast: a state added later is seen", 1 == seen_calls);
+    prte_state_base_set_proc_state_callback(PRTE_PROC_STATE_RUNNING, recorder);
+    reset_observations();
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    CHECK("fast: a replaced callback is seen",
+          1 == seen_calls && PMIX_CHECK_PROCID(&p, &seen_name));
+    prte_state_base_remove_proc_state(PRTE_PROC_STATE_RUNNING);
+    reset_observations();
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    CHECK("fast: a removed state is gone", 0 == seen_calls);
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_ANY, recorder);
+    reset_observations();
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    CHECK("fast: a new fallback is seen",
+          1 == seen_calls && PRTE_PROC_STATE_RUNNING == seen_proc_state);
+    prte_state_base_remove_proc_state(PRTE_PROC_STATE_ANY);
+
+    /* one state swapped for another leaves the lists the size they were -
+     * the table must follow the change, not the size */
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_RUNNING, recorder);
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    prte_state_base_remove_proc_state(PRTE_PROC_STATE_RUNNING);
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_REGISTERED, recorder);
+    reset_observations();
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    CHECK("fast: a state swapped out at the same size is gone", 0 == seen_calls);
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_REGISTERED);
+    drain();
+    CHECK("fast: the state swapped in is seen",
+          1 == seen_calls && PRTE_PROC_STATE_REGISTERED == seen_proc_state);
+
+    /* ...and so must lists torn down and built again to the same size */
+    drop_machines();
+    fresh_machines();
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_RUNNING, recorder);
+    reset_observations();
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_REGISTERED);
+    drain();
+    CHECK("fast: rebuilt lists drop the old entries", 0 == seen_calls);
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_RUNNING);
+    drain();
+    CHECK("fast: rebuilt lists are seen",
+          1 == seen_calls && PRTE_PROC_STATE_RUNNING == seen_proc_state);
+    prte_state_base_remove_proc_state(PRTE_PROC_STATE_RUNNING);
+
+    /* a caddy the handler released is handed out again, cleaned */
+    prte_state_base_add_job_state(PRTE_JOB_STATE_INIT, pointer_recorder);
+    last_caddy = NULL;
+    prte_state_base_activate_job_state(NULL, PRTE_JOB_STATE_INIT);
+    drain();
+    first = last_caddy;
+    prte_state_base_activate_job_state(NULL, PRTE_JOB_STATE_INIT);
+    drain();
+    CHECK("fast: a released caddy is reused", NULL != first && first == last_caddy);
+
+    /* ...and gives back the job it carried */
+    jdata = PMIX_NEW(prte_job_t);
+    prte_state_base_activate_job_state(jdata, PRTE_JOB_STATE_INIT);
+    drain();
+    CHECK("fast: the reused caddy let go of its job",
+          1 == jdata->super.obj_reference_count);
+    PMIX_RELEASE(jdata);
+
+    /* a caddy the handler kept is not */
+    prte_state_base_set_job_state_callback(PRTE_JOB_STATE_INIT, keeper);
+    kept_caddy = NULL;
+    prte_state_base_activate_job_state(NULL, PRTE_JOB_STATE_INIT);
+    drain();
+    prte_state_base_set_job_state_callback(PRTE_JOB_STATE_INIT, pointer_recorder);
+    last_caddy = NULL;
+    prte_state_base_activate_job_state(NULL, PRTE_JOB_STATE_INIT);
+    drain();
+    CHECK("fast: a kept caddy is left alone",
+          NULL != kept_caddy && kept_caddy != last_caddy
+              && 1 == kept_caddy->super.obj_reference_count
+              && PRTE_JOB_STATE_INIT == kept_caddy->job_state);
+    if (NULL != kept_caddy) {
+        PMIX_RELEASE(kept_caddy);
+    }
+
+    /* batched: in order, one pass per generation */
+    prte_state_base.batch = true;
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_INIT, order_recorder);
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_REGISTERED, order_recorder);
+    prte_state_base_add_proc_state(PRTE_PROC_STATE_TERMINATED, order_recorder);
+    norder = 0;
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_INIT);
+    prte_state_base_activate_proc_state(&p, PRTE_PROC_STATE_REGISTERED);
+    prte_event_loop(prte_event_base, PRTE_EVLOOP_NONBLOCK);
+    CHECK("batch: one pass runs the batch it was given",
+          2 <= norder && PRTE_PROC_STATE_INIT == order[0]
+              && PRTE_PROC_STATE_REGISTERED == order[1]);
+    drain();
+    CHECK("batch: what a handler activated runs after",
+          3 == norder && PRTE_PROC_STATE_TERMINATED == order[2]);
+    prte_state_base.batch = batch;
+
+    drop_machines();
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_dispatch_fast_path\n");
+    }
+    return failures;
+}
+
 /*
  * prte_state_base_set_runtime_options translates a PMIX_RUNTIME_OPTIONS
  * string into per-job attributes.  It walks a comma-separated list with an
@@ -686,6 +874,171 @@ static int test_stop_in_app(void)
     return failures;
 }
 
+/*
+ * The DVM job queue (state_base_queue.c).  Its slot index has to count the
+ * nodes get_target_nodes would offer the mapper, and only those: count one
+ * too many and a queued job is started into slots the mapper then refuses,
+ * one too few and it waits for slots it already had.  Which jobs may wait
+ * at all is pinned down as well, and so is the order they wait in without
+ * backfill.  Starting a job runs the mapper, which wants a live DVM, so
+ * only the holding side is driven here.
+ */
+static prte_node_t *queue_node(prte_topology_t *topo, const char *name, int slots,
+                               int slots_max, int inuse)
+{
+    prte_node_t *node;
+
+    node = PMIX_NEW(prte_node_t);
+    node->name = strdup(name);
+    node->state = PRTE_NODE_STATE_UP;
+    node->slots = slots;
+    node->slots_max = slots_max;
+    node->slots_inuse = inuse;
+    node->topology = topo;
+    node->daemon = PMIX_NEW(prte_proc_t);
+    node->index = pmix_pointer_array_add(prte_node_pool, node);
+    return node;
+}
+
+static prte_job_t *queue_job(const char *nspace, int nprocs)
+{
+    prte_job_t *jdata;
+    prte_app_context_t *app;
+
+    jdata = PMIX_NEW(prte_job_t);
+    PMIX_LOAD_NSPACE(jdata->nspace, nspace);
+    app = PMIX_NEW(prte_app_context_t);
+    app->num_procs = nprocs;
+    pmix_pointer_array_add(jdata->apps, app);
+    jdata->num_apps = 1;
+    return jdata;
+}
+
+static void queue_submit(prte_job_t *jdata)
+{
+    prte_state_caddy_t *caddy;
+
+    caddy = prte_state_base_caddy_get();
+    PMIX_RETAIN(jdata);
+    caddy->jdata = jdata;
+    caddy->job_state = PRTE_JOB_STATE_MAP;
+    prte_state_base_queue_map(-1, PRTE_EV_WRITE, caddy);
+}
+
+static int test_job_queue(void)
+{
+    int failures = 0;
+    pmix_pointer_array_t *saved_pool = prte_node_pool;
+    bool saved_alloc = prte_hnp_is_allocated;
+    bool saved_queue = prte_state_base.job_queue;
+    bool saved_backfill = prte_state_base.queue_backfill;
+    prte_topology_t *topo;
+    prte_node_t *node;
+    prte_state_slot_index_t idx;
+    prte_job_t *jdata, *big, *small;
+    prte_app_context_t *app;
+    char host[] = "n2";
+    int32_t nprocs;
+    bool nolocal;
+    int i;
+
+    prte_node_pool = PMIX_NEW(pmix_pointer_array_t);
+    pmix_pointer_array_init(prte_node_pool, 8, INT_MAX, 8);
+    prte_hnp_is_allocated = true;
+    topo = PMIX_NEW(prte_topology_t);
+
+    /* the HNP's node, a full node, one capped below its slot count, and two
+     * the mapper would pass over */
+    (void) queue_node(topo, "n0", 4, 0, 1);
+    (void) queue_node(topo, "n1", 4, 0, 4);
+    (void) queue_node(topo, "n2", 8, 6, 2);
+    node = queue_node(topo, "n3", 4, 0, 0);
+    node->state = PRTE_NODE_STATE_DOWN;
+    node = queue_node(topo, "n4", 4, 0, 0);
+    PMIX_RELEASE(node->daemon);
+    node->daemon = NULL;
+
+    prte_state_base_slot_index(&idx);
+    CHECK("index capacity", 14 == idx.capacity);
+    CHECK("index free", 7 == idx.free);
+    CHECK("index local capacity", 4 == idx.local_capacity);
+    CHECK("index local free", 3 == idx.local_free);
+    prte_hnp_is_allocated = false;
+    prte_state_base_slot_index(&idx);
+    CHECK("index without the HNP's node", 10 == idx.capacity && 4 == idx.free &&
+                                          0 == idx.local_free);
+    prte_hnp_is_allocated = true;
+
+    /* which jobs may wait */
+    jdata = queue_job("unit-test-q1", 5);
+    CHECK("sized job may wait", prte_state_base_queue_need(jdata, &nprocs, &nolocal));
+    CHECK("sized job procs", 5 == nprocs && !nolocal);
+    app = (prte_app_context_t *) pmix_pointer_array_get_item(jdata->apps, 0);
+    prte_set_attribute(&app->attributes, PRTE_APP_DASH_HOST, PRTE_ATTR_LOCAL, host, PMIX_STRING);
+    CHECK("-host job does not wait", !prte_state_base_queue_need(jdata, &nprocs, &nolocal));
+    prte_remove_attribute(&app->attributes, PRTE_APP_DASH_HOST);
+    app->num_procs = 0;
+    CHECK("unsized job does not wait", !prte_state_base_queue_need(jdata, &nprocs, &nolocal));
+    app->num_procs = 5;
+    jdata->map = PMIX_NEW(prte_job_map_t);
+    PRTE_SET_MAPPING_DIRECTIVE(jdata->map->mapping, PRTE_MAPPING_SUBSCRIBE_GIVEN);
+    CHECK("oversubscribing job does not wait",
+          !prte_state_base_queue_need(jdata, &nprocs, &nolocal));
+    PRTE_SET_MAPPING_DIRECTIVE(jdata->map->mapping, PRTE_MAPPING_NO_OVERSUBSCRIBE);
+    PRTE_SET_MAPPING_DIRECTIVE(jdata->map->mapping, PRTE_MAPPING_NO_USE_LOCAL);
+    CHECK("no-oversubscribe job may wait", prte_state_base_queue_need(jdata, &nprocs, &nolocal));
+    CHECK("no-use-local carried", nolocal);
+    prte_set_attribute(&jdata->attributes, PRTE_JOB_DO_NOT_LAUNCH, PRTE_ATTR_LOCAL, NULL,
+                       PMIX_BOOL);
+    CHECK("do-not-launch job does not wait",
+          !prte_state_base_queue_need(jdata, &nprocs, &nolocal));
+    PMIX_RELEASE(jdata);
+
+    /* holding, in order: without backfill a job that would fit still waits
+     * behind one that does not */
+    prte_state_base.job_queue = true;
+    prte_state_base.queue_backfill = false;
+    big = queue_job("unit-test-q2", 9);
+    small = queue_job("unit-test-q3", 2);
+    queue_submit(big);
+    CHECK("job bigger than the free slots held", 1 == prte_state_base_queue_depth());
+    CHECK("held job marked queued", PRTE_JOB_STATE_QUEUED == big->state);
+    queue_submit(small);
+    CHECK("no backfill: small job waits behind it", 2 == prte_state_base_queue_depth());
+    prte_state_base_queue_kick();
+    drain();
+    CHECK("no backfill: a pass starts nothing past the head", 2 == prte_state_base_queue_depth());
+
+    /* a job that leaves while it waits is dropped at the next pass */
+    big->state = PRTE_JOB_STATE_KILLED_BY_CMD;
+    prte_set_attribute(&small->attributes, PRTE_JOB_CANCELLED, PRTE_ATTR_LOCAL, NULL, PMIX_BOOL);
+    prte_state_base_queue_kick();
+    drain();
+    CHECK("ended jobs dropped from the queue", 0 == prte_state_base_queue_depth());
+    CHECK("queue let go of its references", 1 == big->super.obj_reference_count &&
+                                            1 == small->super.obj_reference_count);
+    PMIX_RELEASE(big);
+    PMIX_RELEASE(small);
+
+    for (i = 0; i < prte_node_pool->size; i++) {
+        node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, i);
+        if (NULL != node) {
+            PMIX_RELEASE(node);
+        }
+    }
+    PMIX_RELEASE(prte_node_pool);
+    PMIX_RELEASE(topo);
+    prte_node_pool = saved_pool;
+    prte_hnp_is_allocated = saved_alloc;
+    prte_state_base.job_queue = saved_queue;
+    prte_state_base.queue_backfill = saved_backfill;
+
+    if (0 == failures) {
+        fprintf(stdout, "PASSED test_job_queue\n");
+    }
+    return failures;
+}
+
 /*
  * Component selection is role-driven: dvm answers only for the DVM master,
  * prted only for a daemon, both at priority 100.  Exactly one applies to
@@ -790,9 +1143,11 @@ int main(void)
     failures += test_job_dispatch();
     failures += test_proc_dispatch();
     failures += test_caddy_contract();
+    failures += test_dispatch_fast_path();
     failures += test_runtime_options();
     failures += test_report_child_sep_reader();
     failures += test_stop_in_app();
+    failures += test_job_queue();
     failures += test_component_selection();
 
     (void) pmix_mca_base_framework_close(&prte_state_base_framework);
@@ -57,10 +57,22 @@
  *    prte_util_get_ordered_host_list() walked the list through an item it
  *    had already released.
  *
+ *  - prte_util_nidmap_pack_update()/prte_util_nidmap_apply_update() ship
+ *    the node map as a delta against the version a daemon holds, and a full
+ *    snapshot only for the daemons that hold none. The two halves share the
+ *    version counter, so the daemon half runs in a child process fed through
+ *    a pipe, and the map it rebuilds is compared slot by slot with the
+ *    master's.
+ *
+ *  - prte_profile_startup_add()/prte_profile_startup_summary() fold every
+ *    daemon's startup phase table into one min/median/max line per phase.
+ *    Two tables packed with prte_profile_startup_pack() go in, and the
+ *    summary has to count both.
+ *
  * What is deliberately NOT here: session_dir (creates directories under
  * the real tmpdir), stacktrace (installs signal handlers), daemon_init
- * (forks), and the parts of nidmap that need a populated DVM. Those belong
- * to the live smoke test and to contrib/dockerswarm.
+ * (forks and detaches), and the parts of nidmap that need a populated DVM.
+ * Those belong to the live smoke test and to contrib/dockerswarm.
  */
 
 #include "prte_config.h"
@@ -70,12 +82,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/wait.h>
 
 #include "constants.h"
 #include "types.h"
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/mca/plm/plm_types.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
 #include "src/runtime/runtime.h"
 #include "src/util/attr.h"
@@ -84,8 +99,12 @@
 #include "src/util/error_strings.h"
 #include "src/util/hostfile/hostfile.h"
 #include "src/util/name_fns.h"
+#include "src/util/nidmap.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/proc_info.h"
+#include "src/util/prte_compress.h"
+#include "src/util/prte_profile.h"
+#include "src/util/prte_strbuf.h"
 #include "src/util/sys_limits.h"
 
 #define CHECK(label, cond)                                              \
@@ -393,6 +412,7 @@ static const state_entry_t job_states[] = {
     ST(PRTE_JOB_STATE_REPORT_PROGRESS), ST(PRTE_JOB_STATE_ALLOC_FAILED),
     ST(PRTE_JOB_STATE_MAP_FAILED),     ST(PRTE_JOB_STATE_CANNOT_LAUNCH),
     ST(PRTE_JOB_STATE_FILES_POSN_FAILED), ST(PRTE_JOB_STATE_WAITING_FOR_DAEMONS),
+    ST(PRTE_JOB_STATE_QUEUED),
     ST(PRTE_JOB_STATE_FT_CHECKPOINT),  ST(PRTE_JOB_STATE_FT_CONTINUE),
     ST(PRTE_JOB_STATE_FT_RESTART),     ST(PRTE_JOB_STATE_ANY),
 };
@@ -1129,17 +1149,492 @@ static int test_sys_limits(void)
     return failures;
 }
 
+/* ------------------------------------------------------------------ */
+/* prte_compress                                                      */
+/* ------------------------------------------------------------------ */
+
+/* Whatever codec the sender picks has to come back out byte for byte at the
+ * receiver, named by nothing but the codec ID that travels with it.  Each
+ * codec is forced in turn; one this build or this PMIx lacks must decline
+ * (PRTE_COMPRESS_NONE) rather than answer with some other codec. */
+static int test_compress(void)
+{
+    int failures = 0;
+    const char *names[] = {"deflate", "lz4", "zstd", NULL};
+    prte_compress_codec_t codecs[] = {PRTE_COMPRESS_DEFLATE, PRTE_COMPRESS_LZ4,
+                                      PRTE_COMPRESS_ZSTD};
+    char *saved = prte_compress_codecs;
+    prte_compress_codec_t codec;
+    uint8_t *in, *out, *back;
+    size_t n, len, blen, inlen = 256 * 1024;
+    int i;
+
+    /* launch-message-like: repetitive, but not one byte over and over */
+    in = (uint8_t *) malloc(inlen);
+    for (n = 0; n < inlen; n++) {
+        in[n] = (uint8_t) ("prte.node.%d:slots=%d;" [n % 21] + (n / 4096) % 3);
+    }
+
+    CHECK("codec names are distinct",
+          0 != strcmp(prte_compress_codec_name(PRTE_COMPRESS_LZ4),
+                      prte_compress_codec_name(PRTE_COMPRESS_ZSTD)));
+    CHECK("an unknown codec is named as such",
+          0 == strcmp("unknown", prte_compress_codec_name(PRTE_COMPRESS_NCODECS)));
+    CHECK("a payload below the minimum is sent raw",
+          PRTE_COMPRESS_NONE == prte_compress_choose(prte_compress_min_size - 1, 192.0));
+    CHECK("a payload that crosses no link is sent raw",
+          PRTE_COMPRESS_NONE == prte_compress_choose(inlen, 0.0));
+
+    for (i = 0; NULL != names[i]; i++) {
+        prte_compress_codecs = (char *) names[i];
+        prte_compress_finalize();
+        out = NULL;
+        codec = prte_compress(in, inlen, 192.0, &out, &len);
+        CHECK("only the allowed codec is used",
+              PRTE_COMPRESS_NONE == codec || codecs[i] == codec);
+        if (PRTE_COMPRESS_NONE == codec) {
+            continue;
+        }
+        CHECK("the payload shrank", len < inlen);
+        back = NULL;
+        CHECK("it decompresses", prte_decompress(codec, out, len, &back, &blen));
+        CHECK("to what went in", NULL != back && blen == inlen && 0 == memcmp(in, back, inlen));
+        CHECK("a truncated payload is refused",
+              PRTE_COMPRESS_DEFLATE == codec || !prte_decompress(codec, out, len / 2, &back, &blen));
+        free(back);
+        free(out);
+    }
+
+    prte_compress_codecs = "none";
+    prte_compress_finalize();
+    out = NULL;
+    CHECK("\"none\" compresses nothing",
+          PRTE_COMPRESS_NONE == prte_compress(in, inlen, 192.0, &out, &len) && NULL == out);
+    CHECK("a codec ID nobody knows is refused",
+          !prte_decompress(PRTE_COMPRESS_NCODECS, in, inlen, &back, &blen));
+
+    prte_compress_codecs = saved;
+    prte_compress_finalize();
+    free(in);
+    return failures;
+}
+
+/* ------------------------------------------------------------------ */
+/* prte_strbuf                                                        */
+/* ------------------------------------------------------------------ */
+
+/* The map and allocation reports are built in one of these, so a report
+ * far larger than the first allocation has to come out whole, and a JSON
+ * string has to survive whatever a hostname or device name can hold. */
+static int test_strbuf(void)
+{
+    int failures = 0;
+    prte_strbuf_t sb = PRTE_STRBUF_STATIC_INIT;
+    char *out, line[64];
+    size_t n, len = 0;
+    int i;
+
+    out = prte_strbuf_release(&sb);
+    CHECK("an empty buffer releases an empty string", NULL != out && '\0' == out[0]);
+    free(out);
+
+    for (i = 0; i < 20000; i++) {
+        n = (size_t) snprintf(line, sizeof(line), "\n        Process rank: %d", i);
+        prte_strbuf_printf(&sb, "\n        Process rank: %d", i);
+        len += n;
+    }
+    prte_strbuf_append(&sb, NULL);
+    CHECK("every append landed", !sb.failed && len == sb.len && strlen(sb.buf) == len);
+    CHECK("in order", NULL != strstr(sb.buf, "rank: 19998\n        Process rank: 19999")
+                      && 0 == strcmp(sb.buf + len - 5, "19999"));
+    out = prte_strbuf_release(&sb);
+    CHECK("release hands over the string and empties the buffer",
+          NULL != out && NULL == sb.buf && 0 == sb.len);
+    free(out);
+
+    prte_strbuf_json_string(&sb, "a\"b\\c\nd\te\001");
+    prte_strbuf_append(&sb, ",");
+    prte_strbuf_json_string(&sb, NULL);
+    CHECK("JSON strings are quoted and escaped",
+          0 == strcmp(sb.buf, "\"a\\\"b\\\\c\\nd\\te\\u0001\",null"));
+    prte_strbuf_free(&sb);
+    return failures;
+}
+
+/* ------------------------------------------------------------------ */
+/* nidmap updates                                                     */
+/* ------------------------------------------------------------------ */
+
+/* The master packs four updates of one DVM's node map: the first one, after
+ * the pool grew by two nodes, after it lost a node, and with nothing
+ * changed.  Node "n" sits in pool slot n with daemon vpid n. */
+#define NIDMAP_STAGES 4
+#define NIDMAP_SLOTS 6
+
+static bool nidmap_expect(int stage, int slot)
+{
+    if (0 == stage) {
+        return slot < 4;
+    }
+    /* the grow adds slots 4 and 5; the shrink then takes slot 2 out */
+    return 1 == stage || 2 != slot;
+}
+
+static pmix_rank_t nidmap_span(int stage)
+{
+    /* a shrink leaves a hole in the vpid space, not a smaller span */
+    return (0 == stage) ? 4 : 6;
+}
+
+static bool read_all(int fd, void *buf, size_t len)
+{
+    char *p = (char *) buf;
+    ssize_t n;
+
+    while (0 < len) {
+        n = read(fd, p, len);
+        if (0 >= n) {
+            return false;
+        }
+        p += n;
+        len -= (size_t) n;
+    }
+    return true;
+}
+
+/* One message down the pipe: its size, then its bytes.  An empty buffer
+ * goes as a zero size - the stages with no snapshot. */
+static bool nidmap_send(int fd, pmix_data_buffer_t *buf)
+{
+    pmix_byte_object_t bo = PMIX_BYTE_OBJECT_STATIC_INIT;
+    bool ok;
+
+    if (0 < buf->bytes_used && PMIX_SUCCESS != PMIx_Data_unload(buf, &bo)) {
+        return false;
+    }
+    ok = sizeof(bo.size) == write(fd, &bo.size, sizeof(bo.size))
+         && (0 == bo.size || (ssize_t) bo.size == write(fd, bo.bytes, bo.size));
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    return ok;
+}
+
+static bool nidmap_recv(int fd, pmix_data_buffer_t *buf)
+{
+    pmix_byte_object_t bo;
+
+    if (!read_all(fd, &bo.size, sizeof(bo.size))) {
+        return false;
+    }
+    if (0 == bo.size) {
+        return true;
+    }
+    bo.bytes = (char *) malloc(bo.size);
+    if (NULL == bo.bytes || !read_all(fd, bo.bytes, bo.size)) {
+        free(bo.bytes);
+        return false;
+    }
+    return PMIX_SUCCESS == PMIx_Data_load(buf, &bo);
+}
+
+/* The daemon: apply each snapshot and update as they come and check the pool
+ * they leave.  It is handed every snapshot, as a daemon on the path to a
+ * joiner would be, and has to leave the ones not meant for it alone. */
+static int nidmap_daemon(int fd)
+{
+    int failures = 0, stage, slot;
+    pmix_data_buffer_t buf;
+    prte_job_t *daemons;
+    prte_node_t *nd;
+    char name[32];
+
+    prte_process_info.proc_type = PRTE_PROC_DAEMON;
+    PRTE_PROC_MY_NAME->rank = 1;
+    /* a changed vpid span rebuilds the routing tree - give it the failure
+     * bitmaps the way prte_rml_open() constructs them */
+    PMIX_CONSTRUCT(&prte_rml_base.failed_dmns, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&prte_rml_base.global_failed_dmns, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&prte_rml_base.dead_dmns, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.dead_dmns, 64);
+    PMIX_CONSTRUCT(&prte_rml_base.absent_dmns, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.absent_dmns, 64);
+    PMIX_CONSTRUCT(&prte_rml_base.lateral_links, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.lateral_links, 64);
+    PMIX_CONSTRUCT(&prte_rml_base.revived_dmns, pmix_bitmap_t);
+    pmix_bitmap_init(&prte_rml_base.revived_dmns, 64);
+    prte_job_data = PMIX_NEW(pmix_pointer_array_t);
+    pmix_pointer_array_init(prte_job_data, 8, INT_MAX, 8);
+    prte_node_pool = PMIX_NEW(pmix_pointer_array_t);
+    pmix_pointer_array_init(prte_node_pool, 8, INT_MAX, 8);
+    prte_node_topologies = PMIX_NEW(pmix_pointer_array_t);
+    pmix_pointer_array_init(prte_node_topologies, 8, INT_MAX, 8);
+    pmix_pointer_array_add(prte_node_topologies, PMIX_NEW(prte_topology_t));
+    daemons = PMIX_NEW(prte_job_t);
+    PMIX_LOAD_NSPACE(daemons->nspace, PRTE_PROC_MY_NAME->nspace);
+    prte_set_job_data_object(daemons);
+
+    for (stage = 0; stage < NIDMAP_STAGES; stage++) {
+        PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+        if (!nidmap_recv(fd, &buf)) {
+            fprintf(stderr, "FAIL [nidmap: snapshot %d never arrived]\n", stage);
+            PMIX_DATA_BUFFER_DESTRUCT(&buf);
+            return failures + 1;
+        }
+        if (0 < buf.bytes_used) {
+            CHECK("nidmap: the snapshot applies",
+                  PRTE_SUCCESS == prte_util_nidmap_apply_snapshot(&buf));
+        }
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+        PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+        if (!nidmap_recv(fd, &buf)) {
+            fprintf(stderr, "FAIL [nidmap: update %d never arrived]\n", stage);
+            PMIX_DATA_BUFFER_DESTRUCT(&buf);
+            return failures + 1;
+        }
+        CHECK("nidmap: the update applies", PRTE_SUCCESS == prte_util_nidmap_apply_update(&buf));
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+        for (slot = 0; slot < NIDMAP_SLOTS + 2; slot++) {
+            nd = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, slot);
+            if (!nidmap_expect(stage, slot) || slot >= NIDMAP_SLOTS) {
+                CHECK("nidmap: a node the master dropped has no daemon here",
+                      NULL == nd || NULL == nd->daemon);
+                continue;
+            }
+            snprintf(name, sizeof(name), "nidmap-node%d", slot);
+            CHECK("nidmap: the node is in the master's slot",
+                  NULL != nd && 0 == strcmp(nd->name, name));
+            CHECK("nidmap: bound to the master's daemon",
+                  NULL != nd && NULL != nd->daemon && (pmix_rank_t) slot == nd->daemon->name.rank);
+        }
+        CHECK("nidmap: the vpid span follows the master",
+              nidmap_span(stage) == prte_process_info.num_daemons);
+    }
+    return failures;
+}
+
+static int test_nidmap_update(void)
+{
+    int failures = 0, stage, slot, status = 0, fds[2];
+    pmix_pointer_array_t pool;
+    pmix_data_buffer_t buf, snap;
+    pmix_bitmap_t joiners;
+    prte_node_t *nd;
+    pmix_nspace_t save_nspace;
+    pmix_rank_t save_ndmns = prte_process_info.num_daemons;
+    char name[32];
+    pid_t pid;
+
+    PMIX_LOAD_NSPACE(save_nspace, PRTE_PROC_MY_NAME->nspace);
+    PMIX_LOAD_NSPACE(PRTE_PROC_MY_NAME->nspace, "prte-unit-dvm");
+    if (0 != pipe(fds)) {
+        fprintf(stderr, "FAIL [nidmap: no pipe]\n");
+        return 1;
+    }
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if (0 == pid) {
+        close(fds[1]);
+        _exit(nidmap_daemon(fds[0]));
+    }
+    close(fds[0]);
+    CHECK("nidmap: the daemon forked", 0 < pid);
+
+    PMIX_CONSTRUCT(&pool, pmix_pointer_array_t);
+    pmix_pointer_array_init(&pool, 8, INT_MAX, 8);
+    for (stage = 0; 0 < pid && stage < NIDMAP_STAGES; stage++) {
+        for (slot = 0; slot < NIDMAP_SLOTS; slot++) {
+            nd = (prte_node_t *) pmix_pointer_array_get_item(&pool, slot);
+            if (nidmap_expect(stage, slot) && NULL == nd) {
+                nd = PMIX_NEW(prte_node_t);
+                snprintf(name, sizeof(name), "nidmap-node%d", slot);
+                nd->name = strdup(name);
+                nd->index = slot;
+                nd->daemon = PMIX_NEW(prte_proc_t);
+                PMIX_LOAD_PROCID(&nd->daemon->name, PRTE_PROC_MY_NAME->nspace, slot);
+                pmix_pointer_array_set_item(&pool, slot, nd);
+            } else if (!nidmap_expect(stage, slot) && NULL != nd) {
+                pmix_pointer_array_set_item(&pool, slot, NULL);
+                PMIX_RELEASE(nd);
+            }
+        }
+        prte_process_info.num_daemons = nidmap_span(stage);
+
+        PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+        PMIX_DATA_BUFFER_CONSTRUCT(&snap);
+        PMIX_CONSTRUCT(&joiners, pmix_bitmap_t);
+        CHECK("nidmap: the update packs",
+              PRTE_SUCCESS == prte_util_nidmap_pack_update(&pool, &buf, &joiners, &snap));
+        /* only the first map and the grow have daemons that hold none, and
+         * the snapshot is addressed to just those */
+        CHECK("nidmap: a snapshot only when a daemon joined",
+              (0 < snap.bytes_used) == (2 > stage));
+        CHECK("nidmap: every daemon is new to the first map",
+              0 != stage || (pmix_bitmap_is_set_bit(&joiners, 1)
+                             && pmix_bitmap_is_set_bit(&joiners, 3)));
+        CHECK("nidmap: the grow's snapshot is for the new daemons alone",
+              1 != stage || (pmix_bitmap_is_set_bit(&joiners, 4)
+                             && pmix_bitmap_is_set_bit(&joiners, 5)
+                             && !pmix_bitmap_is_set_bit(&joiners, 1)
+                             && !pmix_bitmap_is_set_bit(&joiners, 3)));
+        CHECK("nidmap: the snapshot is sent", nidmap_send(fds[1], &snap));
+        CHECK("nidmap: the update is sent", nidmap_send(fds[1], &buf));
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        PMIX_DATA_BUFFER_DESTRUCT(&snap);
+        PMIX_DESTRUCT(&joiners);
+    }
+    close(fds[1]);
+
+    if (0 < pid) {
+        CHECK("nidmap: the daemon exited", pid == waitpid(pid, &status, 0));
+        CHECK("nidmap: the daemon rebuilt the master's map", WIFEXITED(status));
+        failures += WIFEXITED(status) ? WEXITSTATUS(status) : 0;
+    }
+
+    for (slot = 0; slot < pool.size; slot++) {
+        if (NULL != (nd = (prte_node_t *) pmix_pointer_array_get_item(&pool, slot))) {
+            PMIX_RELEASE(nd);
+        }
+    }
+    PMIX_DESTRUCT(&pool);
+    prte_process_info.num_daemons = save_ndmns;
+    PMIX_LOAD_NSPACE(PRTE_PROC_MY_NAME->nspace, save_nspace);
+    return failures;
+}
+
+/* The regex a job's nspace is registered with is regenerated only when the
+ * string it describes changes: the same nodes hand back the info the memo
+ * already holds, and different ones replace it. */
+static int test_regex_memo(void)
+{
+    int failures = 0, rc;
+    prte_regex_memo_t memo = {0};
+    pmix_data_array_t darray;
+    pmix_info_t *info;
+    void *ilist;
+    char *first;
+
+    ilist = PMIx_Info_list_start();
+    first = strdup("memo-node0,memo-node1,memo-node2");
+    rc = prte_util_regex_memo_add(&memo, PMIX_NODE_MAP, first, false, ilist);
+    CHECK("memo: the first regex is generated", PRTE_SUCCESS == rc && memo.valid);
+    CHECK("memo: and kept with its input", first == memo.input);
+
+    rc = prte_util_regex_memo_add(&memo, PMIX_NODE_MAP,
+                                  strdup("memo-node0,memo-node1,memo-node2"), false, ilist);
+    CHECK("memo: the same nodes are served from the memo",
+          PRTE_SUCCESS == rc && first == memo.input);
+
+    rc = prte_util_regex_memo_add(&memo, PMIX_NODE_MAP,
+                                  strdup("memo-node0,memo-node3"), false, ilist);
+    CHECK("memo: different nodes are regenerated",
+          PRTE_SUCCESS == rc && memo.valid && 0 == strcmp("memo-node0,memo-node3", memo.input));
+
+    PMIX_INFO_LIST_CONVERT(rc, ilist, &darray);
+    CHECK("memo: every call added the map", PMIX_SUCCESS == rc && 3 == darray.size);
+    if (PMIX_SUCCESS == rc && 3 == darray.size) {
+        info = (pmix_info_t *) darray.array;
+        CHECK("memo: under the key asked for",
+              PMIX_CHECK_KEY(&info[0], PMIX_NODE_MAP) && PMIX_CHECK_KEY(&info[2], PMIX_NODE_MAP));
+        CHECK("memo: the cached map is the one first generated",
+              PMIX_EQUAL == PMIx_Value_compare(&info[0].value, &info[1].value));
+        CHECK("memo: the regenerated one is not",
+              PMIX_EQUAL != PMIx_Value_compare(&info[0].value, &info[2].value));
+        PMIX_DATA_ARRAY_DESTRUCT(&darray);
+    }
+    PMIX_INFO_LIST_RELEASE(ilist);
+
+    PMIX_INFO_DESTRUCT(&memo.info);
+    free(memo.input);
+    return failures;
+}
+
+/* Two daemons' phase tables in, one summary line per phase out, counting
+ * both daemons and naming the slower one. */
+static int test_startup_profile(void)
+{
+    int failures = 0, n, ndaemon = 0, nphase = 0;
+    pmix_data_buffer_t first, second;
+    char path[] = "/tmp/prte-startup-XXXXXX";
+    char line[512];
+    FILE *fp;
+    int fd;
+
+    fd = mkstemp(path);
+    if (0 > fd) {
+        fprintf(stderr, "FAIL [startup: no report file]\n");
+        return 1;
+    }
+    close(fd);
+    prte_profile_startup_set_report(path);
+
+    /* this process's own table stands in for both daemons' */
+    prte_profile_startup_begin();
+    prte_profile_startup_phase("unit_first");
+    prte_profile_startup_phase("unit_second");
+    PMIX_DATA_BUFFER_CONSTRUCT(&first);
+    PMIX_DATA_BUFFER_CONSTRUCT(&second);
+    CHECK("startup: the first table packs", PRTE_SUCCESS == prte_profile_startup_pack(&first));
+    CHECK("startup: the second table packs", PRTE_SUCCESS == prte_profile_startup_pack(&second));
+
+    n = prte_profile_startup_add(1, "startup-node1", &first);
+    CHECK("startup: one daemon has reported", 1 == n);
+    n = prte_profile_startup_add(2, "startup-node2", &second);
+    CHECK("startup: two daemons have reported", 2 == n);
+    prte_profile_startup_summary();
+    PMIX_DATA_BUFFER_DESTRUCT(&first);
+    PMIX_DATA_BUFFER_DESTRUCT(&second);
+    /* closes the report, and empties the tables for whoever runs next */
+    prte_profile_finalize();
+    prte_profile_startup_enabled = false;
+
+    fp = fopen(path, "r");
+    CHECK("startup: the report was written", NULL != fp);
+    while (NULL != fp && NULL != fgets(line, sizeof(line), fp)) {
+        if (NULL != strstr(line, "\"startup\":\"daemon\"")) {
+            ++ndaemon;
+            CHECK("startup: a daemon line has its phases",
+                  NULL != strstr(line, "\"unit_first\":") &&
+                      NULL != strstr(line, "\"unit_second\":"));
+        } else if (NULL != strstr(line, "\"startup\":\"phase\"")) {
+            ++nphase;
+            CHECK("startup: the summary counts both daemons",
+                  NULL != strstr(line, "\"daemons\":2,"));
+            CHECK("startup: the slowest daemon is one that reported",
+                  NULL != strstr(line, "\"max_daemon\":1}") ||
+                      NULL != strstr(line, "\"max_daemon\":2}"));
+        }
+    }
+    if (NULL != fp) {
+        fclose(fp);
+    }
+    CHECK("startup: one line per daemon", 2 == ndaemon);
+    CHECK("startup: one summary line per phase", 2 == nphase);
+    unlink(path);
+    return failures;
+}
+
 /* ------------------------------------------------------------------ */
 
 int main(void)
 {
     int rc, failures = 0;
+    pmix_status_t prc;
 
     rc = prte_init_util(PRTE_PROC_MASTER);
     if (PRTE_SUCCESS != rc) {
         fprintf(stderr, "prte_init_util failed: %d\n", rc);
         return 1;
     }
+    /* the nidmap updates go through PMIx_Data_pack, which refuses to run
+     * until PMIx itself is up.  A daemon gets there through
+     * PMIx_server_init, so do the same */
+    prc = PMIx_server_init(NULL, NULL, 0);
+    if (PMIX_SUCCESS != prc) {
+        fprintf(stderr, "PMIx_server_init failed: %s\n", PMIx_Error_string(prc));
+        return 1;
+    }
 
     /* the hostfile and dash-host parsers ask whether each name they read is
      * one of ours, and the relative-syntax paths index the node pool */
@@ -1156,7 +1651,13 @@ int main(void)
     failures += test_dash_host();
     failures += test_hostfile();
     failures += test_sys_limits();
+    failures += test_compress();
+    failures += test_strbuf();
+    failures += test_nidmap_update();
+    failures += test_regex_memo();
+    failures += test_startup_profile();
 
+    PMIx_server_finalize();
     prte_finalize();
 
     if (0 == failures) {